@@ -0,0 +1,300 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BatchProcessor.h"
+
+#include "Exceptions.h"
+#include "Assets/EntityDefinitionFileSpec.h"
+#include "Assets/EntityDefinitionManager.h"
+#include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "IO/MapFileSerializer.h"
+#include "IO/NodeWriter.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/SystemPaths.h"
+#include "Model/CollectMatchingIssuesVisitor.h"
+#include "Model/DefaultIssueGenerators.h"
+#include "Model/Entity.h"
+#include "Model/ExportFormat.h"
+#include "Model/Game.h"
+#include "Model/GameFactory.h"
+#include "Model/GameImpl.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
+#include "View/MapDocument.h"
+
+#include <kdl/parallel.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+namespace TrenchBroom {
+    namespace {
+        /**
+         * Collects the messages logged while a map is processed on a worker thread, so that they can be reported.
+         */
+        class CollectingLogger : public Logger {
+        private:
+            std::vector<BatchMessage> m_messages;
+        public:
+            std::vector<BatchMessage> releaseMessages() {
+                return std::move(m_messages);
+            }
+        private:
+            void doLog(const LogLevel level, const std::string& message) override {
+                m_messages.push_back(BatchMessage{level, message});
+            }
+
+            void doLog(const LogLevel level, const QString& message) override {
+                m_messages.push_back(BatchMessage{level, message.toStdString()});
+            }
+        };
+
+        class SetEntityDefinitions : public Model::NodeVisitor {
+        private:
+            Assets::EntityDefinitionManager& m_manager;
+        public:
+            explicit SetEntityDefinitions(Assets::EntityDefinitionManager& manager) :
+            m_manager(manager) {}
+        private:
+            void doVisit(Model::World* world) override   { handle(world); }
+            void doVisit(Model::Layer*) override         {}
+            void doVisit(Model::Group*) override         {}
+            void doVisit(Model::Entity* entity) override { handle(entity); }
+            void doVisit(Model::Brush*) override         {}
+            void handle(Model::AttributableNode* attributable) {
+                attributable->setDefinition(m_manager.definition(attributable));
+            }
+        };
+
+        struct AllIssues {
+            bool operator()(const Model::Issue*) const {
+                return true;
+            }
+        };
+
+        std::vector<IO::Path> externalSearchPaths(const IO::Path& mapPath, const Model::Game& game) {
+            std::vector<IO::Path> searchPaths;
+            searchPaths.push_back(mapPath.deleteLastComponent());
+
+            const IO::Path gamePath = game.gamePath();
+            if (!gamePath.isEmpty()) {
+                searchPaths.push_back(gamePath);
+            }
+
+            searchPaths.push_back(IO::SystemPaths::appDirectory());
+            return searchPaths;
+        }
+
+        void loadEntityDefinitions(const IO::Path& mapPath, const Model::Game& game, Model::World& world, Assets::EntityDefinitionManager& manager, Logger& logger) {
+            const auto spec = game.extractEntityDefinitionFile(world);
+            try {
+                const auto path = game.findEntityDefinitionFile(spec, externalSearchPaths(mapPath, game));
+                IO::SimpleParserStatus status(logger);
+                manager.loadDefinitions(path, game, status);
+
+                SetEntityDefinitions visitor(manager);
+                world.acceptAndRecurse(visitor);
+            } catch (const Exception& e) {
+                logger.error() << "Could not load entity definition file '" << spec.path() << "': " << e.what();
+            }
+        }
+
+        std::vector<BatchIssue> collectIssues(Model::World& world) {
+            world.validateBrushIssues();
+
+            const auto& issueGenerators = world.registeredIssueGenerators();
+            Model::CollectMatchingIssuesVisitor<AllIssues> visitor(issueGenerators);
+            world.acceptAndRecurse(visitor);
+
+            std::vector<BatchIssue> result;
+            for (const auto* issue : visitor.issues()) {
+                std::string type;
+                for (const auto* generator : issueGenerators) {
+                    if (generator->type() == issue->type()) {
+                        type = generator->description();
+                        break;
+                    }
+                }
+                result.push_back(BatchIssue{issue->lineNumber(), type, issue->description()});
+            }
+            return result;
+        }
+
+        void saveMap(Model::World& world, const Model::Game& game, const Model::MapFormat format, const IO::Path& path) {
+            IO::OpenFile open(path, true);
+            IO::writeGameComment(open.file, game.gameName(), Model::formatName(format));
+
+            IO::NodeWriter writer(world, IO::MapFileSerializer::create(format, open.file).release());
+            writer.writeMap();
+        }
+
+        QString logLevelName(const LogLevel level) {
+            switch (level) {
+                case LogLevel::Debug:
+                    return "debug";
+                case LogLevel::Info:
+                    return "info";
+                case LogLevel::Warn:
+                    return "warn";
+                case LogLevel::Error:
+                    return "error";
+            }
+            return "";
+        }
+    }
+
+    BatchProcessor::BatchProcessor(const BatchOptions& options, Logger& logger) :
+    m_options(options),
+    m_logger(logger) {}
+
+    std::vector<BatchResult> BatchProcessor::process(const std::vector<IO::Path>& mapPaths) {
+        std::vector<Job> jobs;
+        jobs.reserve(mapPaths.size());
+        for (const auto& mapPath : mapPaths) {
+            jobs.push_back(createJob(mapPath));
+        }
+
+        return kdl::vec_parallel_transform(jobs, [&](const Job& job) {
+            return processJob(job);
+        }, m_options.jobCount);
+    }
+
+    BatchProcessor::Job BatchProcessor::createJob(const IO::Path& mapPath) {
+        try {
+            auto [gameName, mapFormat] = Model::GameFactory::instance().detectGame(mapPath);
+            if (gameName.empty() || mapFormat == Model::MapFormat::Unknown) {
+                gameName = m_options.gameName;
+                mapFormat = m_options.mapFormat;
+            }
+            if (gameName.empty() || mapFormat == Model::MapFormat::Unknown) {
+                return Job{mapPath, nullptr, mapFormat, "Map has no game comment, use --game and --format to specify its game and format"};
+            }
+            return Job{mapPath, game(gameName), mapFormat, ""};
+        } catch (const Exception& e) {
+            return Job{mapPath, nullptr, Model::MapFormat::Unknown, e.what()};
+        }
+    }
+
+    std::shared_ptr<Model::Game> BatchProcessor::game(const std::string& gameName) {
+        auto it = m_games.find(gameName);
+        if (it == std::end(m_games)) {
+            auto& config = Model::GameFactory::instance().gameConfig(gameName);
+            it = m_games.emplace(gameName, std::make_shared<Model::GameImpl>(config, m_options.gamePath, m_logger)).first;
+        }
+        return it->second;
+    }
+
+    BatchResult BatchProcessor::processJob(const Job& job) const {
+        BatchResult result;
+        result.mapPath = job.mapPath;
+        result.mapFormat = job.mapFormat;
+        if (job.game == nullptr) {
+            result.error = job.error;
+            return result;
+        }
+        result.gameName = job.game->gameName();
+
+        CollectingLogger logger;
+        try {
+            // the entities refer to the definitions, so the world must be destroyed first
+            Assets::EntityDefinitionManager entityDefinitionManager;
+            const auto worldBounds = View::MapDocument::DefaultWorldBounds;
+            auto world = job.game->loadMap(job.mapFormat, worldBounds, job.mapPath, false, logger);
+
+            if (m_options.checkIssues) {
+                loadEntityDefinitions(job.mapPath, *job.game, *world, entityDefinitionManager, logger);
+                Model::registerDefaultIssueGenerators(*world, job.game, worldBounds);
+                result.issues = collectIssues(*world);
+            }
+
+            if (!m_options.objExportDirectory.isEmpty()) {
+                const auto path = m_options.objExportDirectory + IO::Path(job.mapPath.basename()).addExtension("obj");
+                job.game->exportMap(*world, Model::ExportFormat::WavefrontObj, path);
+                result.outputPaths.push_back(path);
+            }
+
+            if (!m_options.saveDirectory.isEmpty()) {
+                const auto format = m_options.saveFormat != Model::MapFormat::Unknown ? m_options.saveFormat : job.mapFormat;
+                const auto path = m_options.saveDirectory + job.mapPath.lastComponent();
+                saveMap(*world, *job.game, format, path);
+                result.outputPaths.push_back(path);
+            }
+
+            result.success = true;
+        } catch (const Exception& e) {
+            result.error = e.what();
+        }
+
+        result.messages = logger.releaseMessages();
+        return result;
+    }
+
+    QJsonDocument toJson(const std::vector<BatchResult>& results) {
+        QJsonArray maps;
+        int failedCount = 0;
+        for (const auto& result : results) {
+            QJsonObject map;
+            map["path"] = QString::fromStdString(result.mapPath.asString());
+            map["game"] = QString::fromStdString(result.gameName);
+            map["format"] = QString::fromStdString(Model::formatName(result.mapFormat));
+            map["success"] = result.success;
+            if (!result.success) {
+                map["error"] = QString::fromStdString(result.error);
+                ++failedCount;
+            }
+
+            QJsonArray outputs;
+            for (const auto& path : result.outputPaths) {
+                outputs.append(QString::fromStdString(path.asString()));
+            }
+            map["outputs"] = outputs;
+
+            QJsonArray issues;
+            for (const auto& issue : result.issues) {
+                QJsonObject object;
+                object["line"] = static_cast<qint64>(issue.lineNumber);
+                object["type"] = QString::fromStdString(issue.type);
+                object["description"] = QString::fromStdString(issue.description);
+                issues.append(object);
+            }
+            map["issues"] = issues;
+
+            QJsonArray messages;
+            for (const auto& message : result.messages) {
+                QJsonObject object;
+                object["level"] = logLevelName(message.level);
+                object["message"] = QString::fromStdString(message.message);
+                messages.append(object);
+            }
+            map["messages"] = messages;
+
+            maps.append(map);
+        }
+
+        QJsonObject root;
+        root["maps"] = maps;
+        root["failed"] = failedCount;
+        return QJsonDocument(root);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BatchProcessor
+#define TrenchBroom_BatchProcessor
+
+#include "Logger.h"
+#include "IO/Path.h"
+#include "Model/MapFormat.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class QJsonDocument;
+
+namespace TrenchBroom {
+    namespace Model {
+        class Game;
+    }
+
+    struct BatchOptions {
+        /**
+         * The game and format of maps that do not have a game comment.
+         */
+        std::string gameName;
+        Model::MapFormat mapFormat = Model::MapFormat::Unknown;
+        /**
+         * The game path is only used to find entity definitions and mods, so it may be empty.
+         */
+        IO::Path gamePath;
+
+        bool checkIssues = false;
+        /**
+         * If not empty, every map is exported as a Wavefront OBJ file into this directory.
+         */
+        IO::Path objExportDirectory;
+        /**
+         * If not empty, every map is saved into this directory, converted to the given format unless it is unknown.
+         */
+        IO::Path saveDirectory;
+        Model::MapFormat saveFormat = Model::MapFormat::Unknown;
+
+        size_t jobCount = 1u;
+    };
+
+    struct BatchMessage {
+        LogLevel level;
+        std::string message;
+    };
+
+    struct BatchIssue {
+        size_t lineNumber;
+        std::string type;
+        std::string description;
+    };
+
+    struct BatchResult {
+        IO::Path mapPath;
+        std::string gameName;
+        Model::MapFormat mapFormat = Model::MapFormat::Unknown;
+        bool success = false;
+        std::string error;
+        std::vector<BatchMessage> messages;
+        std::vector<BatchIssue> issues;
+        std::vector<IO::Path> outputPaths;
+    };
+
+    /**
+     * Loads, checks, exports and saves maps without a document, a map frame or an OpenGL context.
+     *
+     * The games are created up front on the calling thread. Afterwards, the maps are processed concurrently, each map
+     * on a single thread, with its own world and entity definitions. The games are shared between these threads, so
+     * only their const members are used.
+     */
+    class BatchProcessor {
+    private:
+        struct Job {
+            IO::Path mapPath;
+            std::shared_ptr<Model::Game> game;
+            Model::MapFormat mapFormat;
+            std::string error;
+        };
+
+        BatchOptions m_options;
+        Logger& m_logger;
+        std::map<std::string, std::shared_ptr<Model::Game>> m_games;
+    public:
+        BatchProcessor(const BatchOptions& options, Logger& logger);
+
+        /**
+         * Processes the given maps and returns one result per map, in the given order. A map that cannot be processed
+         * does not prevent the others from being processed.
+         */
+        std::vector<BatchResult> process(const std::vector<IO::Path>& mapPaths);
+    private:
+        Job createJob(const IO::Path& mapPath);
+        std::shared_ptr<Model::Game> game(const std::string& gameName);
+        BatchResult processJob(const Job& job) const;
+    };
+
+    /**
+     * Returns a JSON report of the given results.
+     */
+    QJsonDocument toJson(const std::vector<BatchResult>& results);
+}
+
+#endif /* defined(TrenchBroom_BatchProcessor) */
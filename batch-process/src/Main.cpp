@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BatchProcessor.h"
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "IO/Path.h"
+#include "Model/GameFactory.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/parallel.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QString>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace {
+        /**
+         * Logs the messages of the main thread, such as the messages of loading game configurations, to stderr, so that
+         * they do not interfere with a report written to stdout.
+         */
+        class ConsoleLogger : public Logger {
+        private:
+            void doLog(const LogLevel level, const std::string& message) override {
+                if (level != LogLevel::Debug) {
+                    std::cerr << message << "\n";
+                }
+            }
+
+            void doLog(const LogLevel level, const QString& message) override {
+                doLog(level, message.toStdString());
+            }
+        };
+
+        IO::Path absolutePath(const QString& path) {
+            return IO::Path(QFileInfo(path).absoluteFilePath().toStdString());
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    using namespace TrenchBroom;
+
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+
+    // No GUI application is created, so no OpenGL context or window is ever required.
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("TrenchBroom");
+    // Needs to be "" otherwise Qt adds this to the paths returned by QStandardPaths
+    // which would cause preferences to move from where they were with wx
+    app.setOrganizationName("");
+    app.setOrganizationDomain("com.kristianduske");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Checks, exports and converts map files without opening them in the editor.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("maps", "The map files to process.", "<map>...");
+
+    const QCommandLineOption gameOption("game", "The game of maps that have no game comment.", "name");
+    const QCommandLineOption formatOption("format", "The format of maps that have no game comment, e.g. \"Valve\".", "format");
+    const QCommandLineOption gamePathOption("game-path", "The game path to search for entity definitions and mods.", "path");
+    const QCommandLineOption checkIssuesOption("check-issues", "Report the issues of every map.");
+    const QCommandLineOption exportObjOption("export-obj", "Export every map as a Wavefront OBJ file into the given directory.", "directory");
+    const QCommandLineOption saveOption("save", "Save every map into the given directory.", "directory");
+    const QCommandLineOption saveFormatOption("save-format", "Convert the saved maps to the given format, e.g. \"Valve\".", "format");
+    const QCommandLineOption jobsOption("jobs", "The number of maps to process concurrently, defaults to the number of cores.", "count");
+    const QCommandLineOption reportOption("report", "Write the JSON report to the given file instead of stdout.", "file");
+    parser.addOptions({ gameOption, formatOption, gamePathOption, checkIssuesOption, exportObjOption, saveOption, saveFormatOption, jobsOption, reportOption });
+    parser.process(app);
+
+    const auto mapArguments = parser.positionalArguments();
+    if (mapArguments.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    BatchOptions options;
+    options.gameName = parser.value(gameOption).toStdString();
+    options.mapFormat = Model::mapFormat(parser.value(formatOption).toStdString());
+    options.checkIssues = parser.isSet(checkIssuesOption);
+    options.saveFormat = Model::mapFormat(parser.value(saveFormatOption).toStdString());
+    options.jobCount = kdl::parallel_thread_count();
+
+    if (parser.isSet(formatOption) && options.mapFormat == Model::MapFormat::Unknown) {
+        std::cerr << "Unknown map format: " << parser.value(formatOption).toStdString() << "\n";
+        return 1;
+    }
+    if (parser.isSet(saveFormatOption) && options.saveFormat == Model::MapFormat::Unknown) {
+        std::cerr << "Unknown map format: " << parser.value(saveFormatOption).toStdString() << "\n";
+        return 1;
+    }
+    if (parser.isSet(gamePathOption)) {
+        options.gamePath = absolutePath(parser.value(gamePathOption));
+    }
+    if (parser.isSet(exportObjOption)) {
+        options.objExportDirectory = absolutePath(parser.value(exportObjOption));
+    }
+    if (parser.isSet(saveOption)) {
+        options.saveDirectory = absolutePath(parser.value(saveOption));
+    }
+    if (parser.isSet(jobsOption)) {
+        bool ok = false;
+        const auto jobCount = parser.value(jobsOption).toInt(&ok);
+        if (!ok || jobCount < 1) {
+            std::cerr << "Invalid number of jobs: " << parser.value(jobsOption).toStdString() << "\n";
+            return 1;
+        }
+        options.jobCount = static_cast<size_t>(jobCount);
+    }
+
+    ConsoleLogger logger;
+    try {
+        Model::GameFactory::instance().initialize();
+    } catch (const FileSystemException& e) {
+        std::cerr << "Could not initialize game configurations: " << e.what() << "\n";
+        return 1;
+    } catch (const std::vector<std::string>& errors) {
+        // the remaining game configurations can still be used
+        for (const auto& error : errors) {
+            std::cerr << error << "\n";
+        }
+    }
+
+    std::vector<IO::Path> mapPaths;
+    for (const auto& argument : mapArguments) {
+        mapPaths.push_back(absolutePath(argument));
+    }
+
+    BatchProcessor processor(options, logger);
+    const auto results = processor.process(mapPaths);
+    const auto report = toJson(results).toJson();
+
+    if (parser.isSet(reportOption)) {
+        QFile file(parser.value(reportOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << "Could not open report file for writing: " << parser.value(reportOption).toStdString() << "\n";
+            return 1;
+        }
+        file.write(report);
+    } else {
+        std::cout.write(report.constData(), report.size());
+    }
+
+    const auto failed = std::any_of(std::begin(results), std::end(results), [](const auto& result) { return !result.success; });
+    return failed ? 1 : 0;
+}
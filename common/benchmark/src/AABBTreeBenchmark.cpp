@@ -36,6 +36,9 @@
 
 #include <vecmath/bbox.h>
 
+#include <memory>
+#include <vector>
+
 namespace TrenchBroom {
     using AABB = AABBTree<double, 3, Model::Node*>;
     using BOX = AABB::Box;
@@ -61,8 +64,26 @@ namespace TrenchBroom {
         }
     };
 
-    TEST(AABBTreeBenchmark, benchBuildTree) {
+    class TreeNodeCollector : public Model::NodeVisitor {
+    private:
+        std::vector<Model::Node*> m_nodes;
+    public:
+        const std::vector<Model::Node*>& nodes() const {
+            return m_nodes;
+        }
+    private:
+        void doVisit(Model::World*) override {}
+        void doVisit(Model::Layer*) override {}
+        void doVisit(Model::Group*) override {}
+        void doVisit(Model::Entity* entity) override {
+            m_nodes.push_back(entity);
+        }
+        void doVisit(Model::Brush* brush) override {
+            m_nodes.push_back(brush);
+        }
+    };
 
+    static std::unique_ptr<Model::World> loadBenchmarkMap() {
         const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("fixture/benchmark/AABBTree/ne_ruins.map");
         const auto file = IO::Disk::openFile(mapPath);
         auto fileReader = file->reader().buffer();
@@ -71,7 +92,11 @@ namespace TrenchBroom {
         IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
 
         const vm::bbox3 worldBounds(8192.0);
-        auto world = worldReader.read(Model::MapFormat::Standard, worldBounds, status);
+        return worldReader.read(Model::MapFormat::Standard, worldBounds, status);
+    }
+
+    TEST(AABBTreeBenchmark, benchBuildTree) {
+        auto world = loadBenchmarkMap();
 
         std::vector<AABB> trees(100);
         timeLambda([&world, &trees]() {
@@ -81,4 +106,18 @@ namespace TrenchBroom {
             }
         }, "Add objects to AABB tree");
     }
+
+    TEST(AABBTreeBenchmark, benchBulkBuildTree) {
+        auto world = loadBenchmarkMap();
+
+        TreeNodeCollector collector;
+        world->acceptAndRecurse(collector);
+
+        std::vector<AABB> trees(100);
+        timeLambda([&collector, &trees]() {
+            for (auto& tree : trees) {
+                tree.clearAndBuild(collector.nodes(), [](const auto* node) { return node->physicalBounds(); });
+            }
+        }, "Bulk build AABB tree");
+    }
 }
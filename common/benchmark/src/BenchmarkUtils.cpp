@@ -0,0 +1,223 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <sstream>
+
+namespace {
+    std::atomic<size_t> s_allocationCount(0);
+    std::atomic<size_t> s_allocatedMemory(0);
+    std::atomic<size_t> s_peakMemory(0);
+
+    // every allocation is prefixed with a header that stores its size, the header is large enough to keep the
+    // alignment guaranteed by operator new
+    constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+    void updatePeakMemory(const size_t allocatedMemory) {
+        size_t peak = s_peakMemory;
+        while (allocatedMemory > peak && !s_peakMemory.compare_exchange_weak(peak, allocatedMemory)) {}
+    }
+}
+
+// count all allocations made through the global operator new, the array forms delegate to these functions
+void* operator new(const std::size_t size) {
+    if (auto* ptr = static_cast<unsigned char*>(std::malloc(size + HeaderSize))) {
+        *reinterpret_cast<std::size_t*>(ptr) = size;
+
+        ++s_allocationCount;
+        updatePeakMemory(s_allocatedMemory += size);
+        return ptr + HeaderSize;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        auto* header = static_cast<unsigned char*>(ptr) - HeaderSize;
+        s_allocatedMemory -= *reinterpret_cast<std::size_t*>(header);
+        std::free(header);
+    }
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        namespace {
+            template <typename T>
+            T percentile(const std::vector<T>& sortedValues, const double p) {
+                assert(!sortedValues.empty());
+                const auto index = static_cast<size_t>(std::round(p * static_cast<double>(sortedValues.size() - 1u)));
+                return sortedValues[index];
+            }
+
+            std::string escape(const std::string& str) {
+                std::string result;
+                for (const char c : str) {
+                    if (c == '"' || c == '\\') {
+                        result.push_back('\\');
+                    }
+                    result.push_back(c);
+                }
+                return result;
+            }
+
+            std::string toJson(const std::string& name, const Statistics& statistics) {
+                std::stringstream str;
+                str << std::setprecision(6) << std::fixed;
+                str << "{\"name\": \"" << escape(name) << "\""
+                    << ", \"samples\": " << statistics.samples
+                    << ", \"min\": " << statistics.min
+                    << ", \"median\": " << statistics.median
+                    << ", \"p90\": " << statistics.p90
+                    << ", \"max\": " << statistics.max
+                    << ", \"allocations\": " << statistics.allocations
+                    << ", \"peakMemory\": " << statistics.peakMemory
+                    << "}";
+                return str.str();
+            }
+
+            /**
+             * Reads the median times from a file written by report. This only understands the format written by
+             * toJson, so lines that cannot be parsed are ignored.
+             */
+            std::map<std::string, double> readBaseline(const char* path) {
+                std::map<std::string, double> result;
+
+                std::ifstream file(path);
+                std::string line;
+                while (std::getline(file, line)) {
+                    static const std::string NameKey = "\"name\": \"";
+                    static const std::string MedianKey = "\"median\": ";
+
+                    const auto nameStart = line.find(NameKey);
+                    const auto medianStart = line.find(MedianKey);
+                    if (nameStart == std::string::npos || medianStart == std::string::npos) {
+                        continue;
+                    }
+
+                    std::string name;
+                    for (auto i = nameStart + NameKey.size(); i < line.size() && line[i] != '"'; ++i) {
+                        if (line[i] == '\\' && i + 1u < line.size()) {
+                            ++i;
+                        }
+                        name.push_back(line[i]);
+                    }
+
+                    result[name] = std::atof(line.c_str() + medianStart + MedianKey.size());
+                }
+
+                return result;
+            }
+
+            const std::map<std::string, double>& baseline() {
+                static const auto result = []() {
+                    const char* path = std::getenv("TB_BENCHMARK_BASELINE");
+                    return path != nullptr ? readBaseline(path) : std::map<std::string, double>();
+                }();
+                return result;
+            }
+
+            double regressionThreshold() {
+                const char* threshold = std::getenv("TB_BENCHMARK_THRESHOLD");
+                return threshold != nullptr ? std::atof(threshold) : 0.1;
+            }
+        }
+
+        size_t allocationCount() {
+            return s_allocationCount;
+        }
+
+        size_t allocatedMemory() {
+            return s_allocatedMemory;
+        }
+
+        size_t resetPeakMemory() {
+            const size_t allocatedMemory = s_allocatedMemory;
+            s_peakMemory = allocatedMemory;
+            return allocatedMemory;
+        }
+
+        size_t peakMemory() {
+            return s_peakMemory;
+        }
+
+        Statistics computeStatistics(std::vector<double> times, std::vector<size_t> allocations, std::vector<size_t> peakMemory) {
+            assert(!times.empty());
+            assert(times.size() == allocations.size());
+            assert(times.size() == peakMemory.size());
+
+            std::sort(std::begin(times), std::end(times));
+            std::sort(std::begin(allocations), std::end(allocations));
+            std::sort(std::begin(peakMemory), std::end(peakMemory));
+
+            return Statistics {
+                times.size(),
+                times.front(),
+                percentile(times, 0.5),
+                percentile(times, 0.9),
+                times.back(),
+                percentile(allocations, 0.5),
+                percentile(peakMemory, 0.5)
+            };
+        }
+
+        void report(const std::string& name, const Statistics& statistics) {
+            printf("Benchmark '%s': median %fms, p90 %fms, min %fms, max %fms, %zu allocations, %.1fKiB peak memory (%zu samples)\n",
+                name.c_str(),
+                statistics.median,
+                statistics.p90,
+                statistics.min,
+                statistics.max,
+                statistics.allocations,
+                static_cast<double>(statistics.peakMemory) / 1024.0,
+                statistics.samples);
+
+            if (const char* path = std::getenv("TB_BENCHMARK_OUTPUT")) {
+                std::ofstream file(path, std::ios::app);
+                file << toJson(name, statistics) << "\n";
+            }
+
+            const auto& baselineMedians = baseline();
+            const auto it = baselineMedians.find(name);
+            if (it != std::end(baselineMedians)) {
+                const auto baselineMedian = it->second;
+                const auto threshold = regressionThreshold();
+                EXPECT_LE(statistics.median, baselineMedian * (1.0 + threshold))
+                    << "Benchmark '" << name << "' regressed by more than " << threshold * 100.0 << "% against the baseline median of " << baselineMedian << "ms";
+            }
+        }
+    }
+}
@@ -21,7 +21,10 @@
 #define TRENCHBROOM_BENCHMARKUTILS_H
 
 #include <chrono>
+#include <cstddef>
 #include <string>
+#include <utility>
+#include <vector>
 
 #ifdef __GNUC__
 #define TB_NOINLINE __attribute__((noinline))
@@ -40,5 +43,112 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
            std::chrono::duration<double>(end - start).count() * 1000.0);
 }
 
+namespace TrenchBroom {
+    namespace Benchmark {
+        /**
+         * The statistics of the samples taken by benchmarkLambda. All times are given in milliseconds.
+         */
+        struct Statistics {
+            size_t samples;
+            double min;
+            double median;
+            double p90;
+            double max;
+            /**
+             * The median number of heap allocations per sample.
+             */
+            size_t allocations;
+            /**
+             * The median of the peak number of heap bytes allocated during a sample in addition to the bytes that
+             * were already allocated when the sample was started.
+             */
+            size_t peakMemory;
+        };
+
+        /**
+         * Returns the number of calls to the global operator new since the benchmark was started.
+         */
+        size_t allocationCount();
+
+        /**
+         * Returns the number of bytes currently allocated through the global operator new.
+         */
+        size_t allocatedMemory();
+
+        /**
+         * Resets the peak number of allocated bytes to the number of bytes that are currently allocated, and returns
+         * that number.
+         */
+        size_t resetPeakMemory();
+
+        /**
+         * Returns the peak number of allocated bytes since the last call to resetPeakMemory.
+         */
+        size_t peakMemory();
+
+        /**
+         * Computes the statistics of the given sample times, allocation counts and peak memory, which must be of the
+         * same size and not empty.
+         */
+        Statistics computeStatistics(std::vector<double> times, std::vector<size_t> allocations, std::vector<size_t> peakMemory);
+
+        /**
+         * Prints the given statistics and writes them to the file given by the environment variable
+         * TB_BENCHMARK_OUTPUT, one JSON object per line, if that variable is set.
+         *
+         * If the environment variable TB_BENCHMARK_BASELINE names a file written in that format and it contains
+         * results for a benchmark with the given name, the current test fails if the median time exceeds the median
+         * time of the baseline by more than the fraction given by TB_BENCHMARK_THRESHOLD, which defaults to 0.1.
+         */
+        void report(const std::string& name, const Statistics& statistics);
+    }
+}
+
+/**
+ * Runs the given lambda a number of times without measuring it to warm up caches, and then measures the given number
+ * of samples and reports their statistics under the given name. The given setup function is called before every run
+ * of the lambda, but it is not measured.
+ */
+template<class S, class L>
+TB_NOINLINE static TrenchBroom::Benchmark::Statistics benchmarkLambdaWithSetup(S&& setup, L&& lambda, const std::string& name, const size_t warmups = 1, const size_t samples = 10) {
+    for (size_t i = 0; i < warmups; ++i) {
+        setup();
+        lambda();
+    }
+
+    std::vector<double> times;
+    std::vector<size_t> allocations;
+    std::vector<size_t> peakMemory;
+    times.reserve(samples);
+    allocations.reserve(samples);
+    peakMemory.reserve(samples);
+
+    for (size_t i = 0; i < samples; ++i) {
+        setup();
+
+        const auto memoryBefore = TrenchBroom::Benchmark::resetPeakMemory();
+        const auto allocationsBefore = TrenchBroom::Benchmark::allocationCount();
+        const auto start = std::chrono::high_resolution_clock::now();
+        lambda();
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        times.push_back(std::chrono::duration<double>(end - start).count() * 1000.0);
+        allocations.push_back(TrenchBroom::Benchmark::allocationCount() - allocationsBefore);
+        peakMemory.push_back(TrenchBroom::Benchmark::peakMemory() - memoryBefore);
+    }
+
+    const auto statistics = TrenchBroom::Benchmark::computeStatistics(std::move(times), std::move(allocations), std::move(peakMemory));
+    TrenchBroom::Benchmark::report(name, statistics);
+    return statistics;
+}
+
+/**
+ * Runs the given lambda a number of times without measuring it to warm up caches, and then measures the given number
+ * of samples and reports their statistics under the given name.
+ */
+template<class L>
+TB_NOINLINE static TrenchBroom::Benchmark::Statistics benchmarkLambda(L&& lambda, const std::string& name, const size_t warmups = 1, const size_t samples = 10) {
+    return benchmarkLambdaWithSetup([]() {}, std::forward<L>(lambda), name, warmups, samples);
+}
 
 #endif //TRENCHBROOM_BENCHMARKUTILS_H
@@ -0,0 +1,293 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include "FloatType.h"
+#include "IO/NodeWriter.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/AssortNodesVisitor.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/CollectMatchingIssuesVisitor.h"
+#include "Model/CollectNodesVisitor.h"
+#include "Model/DuplicateBrushesIssueGenerator.h"
+#include "Model/EmptyAttributeNameIssueGenerator.h"
+#include "Model/EmptyAttributeValueIssueGenerator.h"
+#include "Model/Entity.h"
+#include "Model/InvalidTextureScaleIssueGenerator.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/MissingClassnameIssueGenerator.h"
+#include "Model/MixedBrushContentsIssueGenerator.h"
+#include "Model/NonIntegerPlanePointsIssueGenerator.h"
+#include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/Tag.h"
+#include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
+#include "Model/World.h"
+#include "Model/WorldBoundsIssueGenerator.h"
+
+#include <kdl/parallel.h>
+#include <kdl/string_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const vm::bbox3 WorldBounds(8192.0);
+        static constexpr FloatType CellSize = 64.0;
+        static constexpr size_t NumTextures = 64;
+
+        static const std::vector<std::pair<Model::MapFormat, std::string>> Formats = {
+            { Model::MapFormat::Standard, "Standard" },
+            { Model::MapFormat::Valve,    "Valve"    },
+            { Model::MapFormat::Quake2,   "Quake2"   },
+            { Model::MapFormat::Quake3,   "Quake3"   }
+        };
+
+        /**
+         * The number of brushes in each generated map, and the number of warmup runs and samples taken for each
+         * benchmark on such a map.
+         */
+        struct MapSize {
+            size_t brushCount;
+            size_t warmups;
+            size_t samples;
+        };
+
+        static const std::vector<MapSize> MapSizes = {
+            {  10'000, 1, 5 },
+            { 100'000, 0, 3 }
+        };
+
+        /**
+         * Generates a world with the given number of cuboids of varying sizes laid out in a grid, and one light
+         * entity for every 100 brushes.
+         */
+        static std::unique_ptr<Model::World> makeWorld(const Model::MapFormat format, const size_t brushCount) {
+            auto world = std::make_unique<Model::World>(format);
+            Model::BrushBuilder builder(world.get(), WorldBounds);
+
+            const auto gridSize = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(brushCount))));
+            const auto gridOrigin = vm::vec3::fill(-CellSize * static_cast<FloatType>(gridSize) / 2.0);
+
+            std::vector<Model::Node*> nodes;
+            nodes.reserve(brushCount + brushCount / 100u);
+
+            for (size_t i = 0; i < brushCount; ++i) {
+                const auto cell = vm::vec3(
+                    static_cast<FloatType>(i % gridSize),
+                    static_cast<FloatType>((i / gridSize) % gridSize),
+                    static_cast<FloatType>(i / (gridSize * gridSize)));
+                const auto min = gridOrigin + CellSize * cell;
+                const auto size = vm::vec3(
+                    static_cast<FloatType>(32u + 8u * (i % 4u)),
+                    static_cast<FloatType>(32u + 8u * ((i / 4u) % 4u)),
+                    static_cast<FloatType>(32u + 8u * ((i / 16u) % 4u)));
+
+                nodes.push_back(builder.createCuboid(vm::bbox3(min, min + size), "texture" + std::to_string(i % NumTextures)));
+
+                if (i % 100u == 0u) {
+                    auto* entity = world->createEntity();
+                    entity->addOrUpdateAttribute("classname", "light");
+                    entity->addOrUpdateAttribute("origin", kdl::str_to_string(min + size / 2.0 + vm::vec3::pos_z() * CellSize / 2.0));
+                    nodes.push_back(entity);
+                }
+            }
+
+            world->defaultLayer()->addChildren(nodes);
+            return world;
+        }
+
+        /**
+         * Returns the map file contents of a generated world, see makeWorld. The contents are generated once per
+         * format and brush count.
+         */
+        static const std::string& makeMap(const Model::MapFormat format, const size_t brushCount) {
+            static std::map<std::tuple<Model::MapFormat, size_t>, std::string> cache;
+
+            const auto key = std::make_tuple(format, brushCount);
+            auto it = cache.find(key);
+            if (it == std::end(cache)) {
+                auto world = makeWorld(format, brushCount);
+
+                std::string map;
+                NodeWriter writer(*world, map);
+                writer.writeMap();
+
+                it = cache.emplace(key, std::move(map)).first;
+            }
+            return it->second;
+        }
+
+        static std::unique_ptr<Model::World> readMap(const Model::MapFormat format, const size_t brushCount) {
+            const auto& map = makeMap(format, brushCount);
+
+            TestParserStatus status;
+            WorldReader reader(map);
+            return reader.read(format, WorldBounds, status);
+        }
+
+        static std::string benchmarkName(const std::string& stage, const std::string& formatName, const size_t brushCount) {
+            return stage + " (" + formatName + ", " + std::to_string(brushCount) + " brushes)";
+        }
+
+        /**
+         * Calls the given function for every map format and size with the corresponding benchmark name.
+         */
+        template <typename F>
+        static void forEachMap(const std::string& stage, F&& f) {
+            for (const auto& [format, formatName] : Formats) {
+                for (const auto& size : MapSizes) {
+                    f(format, size, benchmarkName(stage, formatName, size.brushCount));
+                }
+            }
+        }
+
+        static std::vector<Model::Brush*> collectBrushes(Model::World& world) {
+            Model::CollectBrushesVisitor visitor;
+            world.acceptAndRecurse(visitor);
+            return visitor.brushes();
+        }
+
+        TEST(MapLoadSaveBenchmark, readMap) {
+            forEachMap("WorldReader::read", [](const auto format, const auto& size, const auto& name) {
+                const auto& map = makeMap(format, size.brushCount);
+
+                std::unique_ptr<Model::World> world;
+                benchmarkLambdaWithSetup([&]() {
+                    // destroy the previous world outside of the measurement
+                    world.reset();
+                }, [&]() {
+                    TestParserStatus status;
+                    WorldReader reader(map);
+                    world = reader.read(format, WorldBounds, status);
+                }, name, size.warmups, size.samples);
+            });
+        }
+
+        TEST(MapLoadSaveBenchmark, rebuildNodeTree) {
+            forEachMap("World::rebuildNodeTree", [](const auto format, const auto& size, const auto& name) {
+                auto world = readMap(format, size.brushCount);
+                benchmarkLambda([&]() {
+                    world->rebuildNodeTree();
+                }, name, size.warmups, size.samples);
+            });
+        }
+
+        TEST(MapLoadSaveBenchmark, writeMap) {
+            forEachMap("NodeWriter::writeMap", [](const auto format, const auto& size, const auto& name) {
+                auto world = readMap(format, size.brushCount);
+                benchmarkLambda([&]() {
+                    std::string map;
+                    NodeWriter writer(*world, map);
+                    writer.writeMap();
+                }, name, size.warmups, size.samples);
+            });
+        }
+
+        TEST(MapLoadSaveBenchmark, rebuildBrushGeometry) {
+            forEachMap("Brush::rebuildGeometry", [](const auto format, const auto& size, const auto& name) {
+                auto world = readMap(format, size.brushCount);
+                const auto brushes = collectBrushes(*world);
+                benchmarkLambda([&]() {
+                    for (auto* brush : brushes) {
+                        brush->rebuildGeometry(WorldBounds);
+                    }
+                }, name, size.warmups, size.samples);
+            });
+        }
+
+        TEST(MapLoadSaveBenchmark, updateAllFaceTags) {
+            Model::TagManager tagManager;
+            tagManager.registerSmartTags({
+                Model::SmartTag("texture", {}, std::make_unique<Model::TextureNameTagMatcher>("texture1*")),
+                Model::SmartTag("contentflags", {}, std::make_unique<Model::ContentFlagsTagMatcher>(1)),
+                Model::SmartTag("surfaceflags", {}, std::make_unique<Model::SurfaceFlagsTagMatcher>(1))
+            });
+
+            forEachMap("updateAllFaceTags", [&](const auto format, const auto& size, const auto& name) {
+                auto world = readMap(format, size.brushCount);
+                const auto brushes = collectBrushes(*world);
+                benchmarkLambda([&]() {
+                    // same as MapDocument::updateAllFaceTags
+                    kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                        brushes[i]->initializeTags(tagManager);
+                    });
+                }, name, size.warmups, size.samples);
+            });
+        }
+
+        TEST(MapLoadSaveBenchmark, validateIssues) {
+            // the generators which do not depend on a game or on entity definitions
+            std::vector<std::unique_ptr<Model::IssueGenerator>> generators;
+            generators.push_back(std::make_unique<Model::MissingClassnameIssueGenerator>());
+            generators.push_back(std::make_unique<Model::NonIntegerPlanePointsIssueGenerator>());
+            generators.push_back(std::make_unique<Model::NonIntegerVerticesIssueGenerator>());
+            generators.push_back(std::make_unique<Model::MixedBrushContentsIssueGenerator>());
+            generators.push_back(std::make_unique<Model::DuplicateBrushesIssueGenerator>());
+            generators.push_back(std::make_unique<Model::WorldBoundsIssueGenerator>(WorldBounds));
+            generators.push_back(std::make_unique<Model::EmptyAttributeNameIssueGenerator>());
+            generators.push_back(std::make_unique<Model::EmptyAttributeValueIssueGenerator>());
+            generators.push_back(std::make_unique<Model::InvalidTextureScaleIssueGenerator>());
+
+            std::vector<Model::IssueGenerator*> generatorPtrs;
+            for (const auto& generator : generators) {
+                generatorPtrs.push_back(generator.get());
+            }
+
+            const auto all = [](const Model::Issue*) { return true; };
+
+            forEachMap("Issue validation", [&](const auto format, const auto& size, const auto& name) {
+                auto world = readMap(format, size.brushCount);
+
+                Model::CollectNodesVisitor collectNodes;
+                world->acceptAndRecurse(collectNodes);
+                const auto& nodes = collectNodes.nodes();
+
+                benchmarkLambdaWithSetup([&]() {
+                    for (const auto* node : nodes) {
+                        node->invalidateIssues();
+                    }
+                }, [&]() {
+                    world->validateBrushIssues();
+
+                    Model::CollectMatchingIssuesVisitor<decltype(all)> collectIssues(generatorPtrs, all);
+                    world->acceptAndRecurse(collectIssues);
+                }, name, size.warmups, size.samples);
+            });
+        }
+    }
+}
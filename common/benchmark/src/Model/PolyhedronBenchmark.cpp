@@ -0,0 +1,168 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include "FloatType.h"
+#include "Model/Polyhedron.h"
+#include "Model/Polyhedron3.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBuilds = 100'000;
+
+        /**
+         * Returns the planes of a prism with the given number of sides, which has sides + 2 faces.
+         */
+        static std::vector<vm::plane3> makePrism(const size_t sides) {
+            std::vector<vm::plane3> result;
+            result.emplace_back(32.0, vm::vec3::pos_z());
+            result.emplace_back(32.0, vm::vec3::neg_z());
+            for (size_t i = 0; i < sides; ++i) {
+                const auto angle = 2.0 * vm::C::pi() * static_cast<FloatType>(i) / static_cast<FloatType>(sides);
+                result.emplace_back(64.0, vm::vec3(std::cos(angle), std::sin(angle), 0.0));
+            }
+            return result;
+        }
+
+        static void benchmarkPrism(const size_t sides) {
+            const auto planes = makePrism(sides);
+            const vm::bbox3 worldBounds(8192.0);
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBuilds; ++i) {
+                    Polyhedron3 polyhedron(worldBounds);
+                    for (const auto& plane : planes) {
+                        polyhedron.clip(plane);
+                    }
+                    ASSERT_TRUE(polyhedron.closed());
+                }
+            }, "Clip " + std::to_string(NumBuilds) + " prisms with " + std::to_string(planes.size()) + " faces");
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBuilds; ++i) {
+                    Polyhedron3 polyhedron;
+                    std::vector<Polyhedron3::Face*> faces;
+                    ASSERT_TRUE(polyhedron.buildFromPlanes(planes, faces));
+                }
+            }, "Build " + std::to_string(NumBuilds) + " prisms with " + std::to_string(planes.size()) + " faces from planes");
+        }
+
+        static void benchmarkCopy(const size_t sides) {
+            const auto planes = makePrism(sides);
+
+            Polyhedron3 original;
+            std::vector<Polyhedron3::Face*> faces;
+            ASSERT_TRUE(original.buildFromPlanes(planes, faces));
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBuilds; ++i) {
+                    const Polyhedron3 copy(original);
+                    ASSERT_EQ(original.vertexCount(), copy.vertexCount());
+                }
+            }, "Copy " + std::to_string(NumBuilds) + " prisms with " + std::to_string(planes.size()) + " faces");
+        }
+
+        static void benchmarkHull(const size_t sides) {
+            const auto planes = makePrism(sides);
+
+            Polyhedron3 original;
+            std::vector<Polyhedron3::Face*> faces;
+            ASSERT_TRUE(original.buildFromPlanes(planes, faces));
+            const auto positions = original.vertexPositions();
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBuilds; ++i) {
+                    const Polyhedron3 hull(positions);
+                    ASSERT_TRUE(hull.closed());
+                }
+            }, "Build hulls of " + std::to_string(NumBuilds) + " prisms with " + std::to_string(positions.size()) + " vertices");
+        }
+
+        static void benchmarkTraversal(const size_t sides) {
+            const auto planes = makePrism(sides);
+
+            Polyhedron3 original;
+            std::vector<Polyhedron3::Face*> faces;
+            ASSERT_TRUE(original.buildFromPlanes(planes, faces));
+
+            // traverses the topology the way the brush renderer does when it collects the face vertices
+            auto sum = vm::vec3::zero();
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBuilds; ++i) {
+                    for (const auto* face : original.faces()) {
+                        for (const auto* halfEdge : face->boundary()) {
+                            sum = sum + halfEdge->origin()->position();
+                        }
+                    }
+                }
+            }, "Traverse " + std::to_string(NumBuilds) + " prisms with " + std::to_string(planes.size()) + " faces");
+            ASSERT_FALSE(vm::is_nan(sum));
+        }
+
+        TEST(PolyhedronBenchmark, buildCuboids) {
+            benchmarkPrism(4u);
+        }
+
+        TEST(PolyhedronBenchmark, buildOctagonalPrisms) {
+            benchmarkPrism(8u);
+        }
+
+        TEST(PolyhedronBenchmark, buildDodecagonalPrisms) {
+            benchmarkPrism(12u);
+        }
+
+        TEST(PolyhedronBenchmark, copyCuboids) {
+            benchmarkCopy(4u);
+        }
+
+        TEST(PolyhedronBenchmark, copyDodecagonalPrisms) {
+            benchmarkCopy(12u);
+        }
+
+        TEST(PolyhedronBenchmark, copyIcosagonalPrisms) {
+            benchmarkCopy(20u);
+        }
+
+        TEST(PolyhedronBenchmark, hullOctagonalPrisms) {
+            benchmarkHull(8u);
+        }
+
+        TEST(PolyhedronBenchmark, hullIcosagonalPrisms) {
+            benchmarkHull(20u);
+        }
+
+        TEST(PolyhedronBenchmark, traverseCuboids) {
+            benchmarkTraversal(4u);
+        }
+
+        TEST(PolyhedronBenchmark, traverseIcosagonalPrisms) {
+            benchmarkTraversal(20u);
+        }
+    }
+}
@@ -126,6 +126,36 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(brushes);
             kdl::vec_clear_and_delete(textures);
         }
+
+        TEST(BrushRendererBenchmark, benchValidateWithInvalidCaches) {
+            auto brushesTextures = makeBrushes();
+            std::vector<Model::Brush*> brushes = brushesTextures.first;
+            std::vector<Assets::Texture*> textures = brushesTextures.second;
+
+            // the caches are built in parallel during validation, so this measures both phases of validation
+            for (auto* brush : brushes) {
+                brush->invalidateVertexCache();
+            }
+
+            BrushRenderer r;
+            r.addBrushes(brushes);
+            timeLambda([&](){
+                if (!r.valid()) {
+                    r.validate();
+                }
+            }, "validate " + std::to_string(brushes.size()) + " brushes with invalid vertex caches");
+
+            // invalidating the renderer keeps the caches, so only the VBO allocation and copying phase remains
+            r.invalidate();
+            timeLambda([&](){
+                if (!r.valid()) {
+                    r.validate();
+                }
+            }, "validate " + std::to_string(brushes.size()) + " brushes with valid vertex caches");
+
+            kdl::vec_clear_and_delete(brushes);
+            kdl::vec_clear_and_delete(textures);
+        }
     }
 }
 
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include <kdl/vector_set.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    static constexpr size_t NumLookups = 1'000'000;
+
+    /**
+     * Looks up random pointers in a set of pointers of the given size, which is how sets of nodes and faces are used,
+     * and compares the time taken to a plain binary search.
+     */
+    static void benchmarkFind(const size_t size) {
+        auto values = std::vector<int>(2 * size);
+        auto set = kdl::vector_set<const int*>(size);
+        for (size_t i = 0; i < size; ++i) {
+            set.insert(&values[2 * i]);
+        }
+
+        // half of the keys are contained in the set
+        auto keys = std::vector<const int*>();
+        keys.reserve(NumLookups);
+        auto engine = std::mt19937(0u);
+        auto distribution = std::uniform_int_distribution<size_t>(0u, values.size() - 1u);
+        for (size_t i = 0; i < NumLookups; ++i) {
+            keys.push_back(&values[distribution(engine)]);
+        }
+
+        const auto& data = set.get_data();
+        const auto expected = std::count_if(std::begin(keys), std::end(keys), [&](const auto* key) {
+            return std::binary_search(std::begin(data), std::end(data), key);
+        });
+
+        benchmarkLambda([&]() {
+            size_t found = 0;
+            for (const auto* key : keys) {
+                found += set.count(key);
+            }
+            ASSERT_EQ(static_cast<size_t>(expected), found);
+        }, "kdl::vector_set::count with " + std::to_string(size) + " pointers");
+
+        benchmarkLambda([&]() {
+            size_t found = 0;
+            for (const auto* key : keys) {
+                found += std::binary_search(std::begin(data), std::end(data), key) ? 1u : 0u;
+            }
+            ASSERT_EQ(static_cast<size_t>(expected), found);
+        }, "std::binary_search with " + std::to_string(size) + " pointers");
+    }
+
+    TEST(VectorSetBenchmark, find4) {
+        benchmarkFind(4u);
+    }
+
+    TEST(VectorSetBenchmark, find16) {
+        benchmarkFind(16u);
+    }
+
+    TEST(VectorSetBenchmark, find32) {
+        benchmarkFind(32u);
+    }
+
+    TEST(VectorSetBenchmark, find64) {
+        benchmarkFind(64u);
+    }
+
+    TEST(VectorSetBenchmark, find1024) {
+        benchmarkFind(1024u);
+    }
+}
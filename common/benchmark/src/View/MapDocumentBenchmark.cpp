@@ -0,0 +1,193 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include "FloatType.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Game.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Model/TestGame.h"
+#include "Model/World.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentCommandFacade.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        static const vm::bbox3 WorldBounds(8192.0);
+        static constexpr FloatType CellSize = 64.0;
+        static constexpr FloatType BrushSize = 48.0;
+
+        static std::shared_ptr<MapDocument> makeDocument() {
+            auto document = MapDocumentCommandFacade::newMapDocument();
+            document->newDocument(Model::MapFormat::Standard, WorldBounds, std::make_shared<Model::TestGame>());
+            return document;
+        }
+
+        /**
+         * Creates the given number of cubes which are laid out in a square grid on the XY plane, centered at the
+         * origin.
+         */
+        static std::vector<Model::Brush*> makeBrushes(const MapDocument& document, const size_t count) {
+            Model::BrushBuilder builder(document.world(), document.worldBounds(), document.game()->defaultFaceAttribs());
+
+            const auto gridSize = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+            const auto gridOrigin = vm::vec3(-CellSize * static_cast<FloatType>(gridSize) / 2.0, -CellSize * static_cast<FloatType>(gridSize) / 2.0, 0.0);
+
+            std::vector<Model::Brush*> result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                const auto min = gridOrigin + CellSize * vm::vec3(static_cast<FloatType>(i % gridSize), static_cast<FloatType>(i / gridSize), 0.0);
+                result.push_back(builder.createCuboid(vm::bbox3(min, min + vm::vec3::fill(BrushSize)), "texture"));
+            }
+            return result;
+        }
+
+        static std::vector<Model::Node*> addBrushes(MapDocument& document, const std::vector<Model::Brush*>& brushes) {
+            return document.addNodes(kdl::vec_element_cast<Model::Node*>(brushes), document.currentParent());
+        }
+
+        /**
+         * Returns a document containing the given number of cubes, all of which are selected.
+         */
+        static std::shared_ptr<MapDocument> makeDocumentWithSelectedBrushes(const size_t count) {
+            auto document = makeDocument();
+            const auto nodes = addBrushes(*document, makeBrushes(*document, count));
+            document->select(nodes);
+            return document;
+        }
+
+        TEST(MapDocumentBenchmark, csgSubtract) {
+            std::shared_ptr<MapDocument> document;
+            benchmarkLambdaWithSetup([&]() {
+                document = makeDocument();
+                addBrushes(*document, makeBrushes(*document, 4096));
+
+                // a slab which cuts through the upper half of every brush
+                Model::BrushBuilder builder(document->world(), document->worldBounds(), document->game()->defaultFaceAttribs());
+                auto* subtrahend = builder.createCuboid(vm::bbox3(vm::vec3(-2048.0, -2048.0, BrushSize / 2.0), vm::vec3(2048.0, 2048.0, BrushSize * 2.0)), "texture");
+                document->addNode(subtrahend, document->currentParent());
+                document->select(subtrahend);
+            }, [&]() {
+                document->csgSubtract();
+            }, "MapDocument::csgSubtract (4096 brushes)", 1, 5);
+        }
+
+        TEST(MapDocumentBenchmark, csgConvexMerge) {
+            std::shared_ptr<MapDocument> document;
+            benchmarkLambdaWithSetup([&]() {
+                document = makeDocumentWithSelectedBrushes(4096);
+            }, [&]() {
+                document->csgConvexMerge();
+            }, "MapDocument::csgConvexMerge (4096 brushes)", 1, 5);
+        }
+
+        TEST(MapDocumentBenchmark, csgHollow) {
+            std::shared_ptr<MapDocument> document;
+            benchmarkLambdaWithSetup([&]() {
+                document = makeDocumentWithSelectedBrushes(1024);
+            }, [&]() {
+                document->csgHollow();
+            }, "MapDocument::csgHollow (1024 brushes)", 1, 5);
+        }
+
+        TEST(MapDocumentBenchmark, moveVertices) {
+            auto document = makeDocument();
+            auto originals = makeBrushes(*document, 16384);
+
+            std::vector<Model::Brush*> brushes;
+            benchmarkLambdaWithSetup([&]() {
+                kdl::vec_clear_and_delete(brushes);
+                for (const auto* original : originals) {
+                    brushes.push_back(original->clone(WorldBounds));
+                }
+            }, [&]() {
+                // pull the top corner of each cube outwards, which keeps the brush convex
+                for (auto* brush : brushes) {
+                    const auto vertex = brush->logicalBounds().max;
+                    brush->moveVertices(WorldBounds, { vertex }, vm::vec3(8.0, 8.0, 8.0));
+                }
+            }, "Brush::moveVertices (16384 brushes)", 1, 10);
+
+            kdl::vec_clear_and_delete(brushes);
+            kdl::vec_clear_and_delete(originals);
+        }
+
+        TEST(MapDocumentBenchmark, translateObjects) {
+            auto document = makeDocumentWithSelectedBrushes(16384);
+            benchmarkLambda([&]() {
+                document->translateObjects(vm::vec3(16.0, 0.0, 0.0));
+            }, "MapDocument::translateObjects (16384 brushes)", 1, 10);
+        }
+
+        TEST(MapDocumentBenchmark, rotateObjects) {
+            auto document = makeDocumentWithSelectedBrushes(16384);
+            benchmarkLambda([&]() {
+                document->rotateObjects(vm::vec3::zero(), vm::vec3::pos_z(), vm::to_radians(15.0));
+            }, "MapDocument::rotateObjects (16384 brushes)", 1, 10);
+        }
+
+        TEST(MapDocumentBenchmark, pick) {
+            auto document = makeDocument();
+            addBrushes(*document, makeBrushes(*document, 16384));
+
+            // a fixed fan of rays from above the map, so that every run hits the same brushes
+            std::vector<vm::ray3> rays;
+            for (size_t i = 0; i < 10000; ++i) {
+                const auto angle = static_cast<FloatType>(i) * 0.01;
+                const auto radius = static_cast<FloatType>(i % 100) * 40.0;
+                const auto target = vm::vec3(radius * std::cos(angle), radius * std::sin(angle), 0.0);
+                const auto origin = vm::vec3(0.0, 0.0, 4096.0);
+                rays.emplace_back(origin, vm::normalize(target - origin));
+            }
+
+            benchmarkLambda([&]() {
+                for (const auto& ray : rays) {
+                    auto pickResult = Model::PickResult::byDistance(document->editorContext());
+                    document->pick(ray, pickResult);
+                }
+            }, "MapDocument::pick (10000 rays, 16384 brushes)", 1, 10);
+        }
+
+        TEST(MapDocumentBenchmark, undoRedoTransform) {
+            auto document = makeDocumentWithSelectedBrushes(16384);
+            document->translateObjects(vm::vec3(16.0, 0.0, 0.0));
+
+            benchmarkLambda([&]() {
+                document->undoCommand();
+                document->redoCommand();
+            }, "Undo and redo TransformObjectsCommand (16384 brushes)", 1, 10);
+        }
+    }
+}
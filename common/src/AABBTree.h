@@ -26,10 +26,18 @@
 #include <vecmath/bbox.h>
 #include <vecmath/bbox_io.h>
 #include <vecmath/ray.h>
-#include <vecmath/intersection.h>
 
+#include <algorithm>
 #include <cassert>
-#include <iosfwd>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <ostream>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -37,6 +45,9 @@ namespace TrenchBroom {
 /**
  * An axis aligned bounding box tree that allows for quick ray intersection queries.
  *
+ * The nodes are stored in a contiguous vector and refer to each other by index, and unused nodes are recycled through a
+ * free list. Queries traverse the tree without recursion and without allocating memory.
+ *
  * @tparam T the floating point type
  * @tparam S the number of dimensions for vector types
  * @tparam U the node data to store in the leafs
@@ -50,520 +61,649 @@ namespace TrenchBroom {
         using FloatType = T;
         static constexpr size_t Components = S;
     private:
-        class InnerNode;
-        class LeafNode;
+        using NodeIndex = size_t;
+        static constexpr NodeIndex NoNode = std::numeric_limits<NodeIndex>::max();
 
-        class Visitor {
-        public:
-            virtual ~Visitor() = default;
+        static_assert(std::is_trivially_copyable_v<U>, "AABB tree node data must be trivially copyable");
 
-            virtual bool visit(const InnerNode* innerNode) = 0;
-            virtual void visit(const LeafNode* leaf) = 0;
+        enum class NodeType : unsigned char {
+            Inner,
+            Leaf,
+            Free
         };
 
-        template <typename I_V, typename L_V>
-        class LambdaVisitor : public Visitor {
-        private:
-            I_V m_innerNodeVisitor;
-            L_V m_leafNodeVisitor;
-        public:
-            LambdaVisitor(I_V innerNodeVisitor, L_V leafNodeVisitor) :
-                m_innerNodeVisitor(std::move(innerNodeVisitor)),
-                m_leafNodeVisitor(std::move(leafNodeVisitor)) {}
-
-            bool visit(const InnerNode* innerNode) override { return m_innerNodeVisitor(innerNode); }
-            void visit(const LeafNode* leafNode)   override { m_leafNodeVisitor(leafNode); }
+        struct Children {
+            NodeIndex left;
+            NodeIndex right;
         };
 
-#if !defined __GNUC__ || defined __clang__
         /**
-         * Deduction guide.
+         * A node of the tree. All nodes are stored in a contiguous vector and refer to each other by index.
          *
-         * Note that as of GCC 9.2, there appears to be a bug in GCC that disallows deduction guides in non-namespace scope.
-         * Luckily, GCC does not need a guide to deduce the template parameters of LambdaVisitor, but clang does!
+         * An inner node does not carry data. It's only purpose is to structure the tree. Its bounds is the smallest
+         * bounding box that contains the bounds of its children, and its height is the maximum of the heights of its
+         * children plus one.
+         *
+         * A leaf node represents actual data. It does not have any children. Its bounds equals the bounds supplied when
+         * the node was inserted into the tree, and its height is 1.
+         *
+         * A free node is an unused slot in the node vector. Free nodes are linked into a list so that they can be
+         * recycled when new nodes are added.
          */
-        template <typename I_V, typename L_V>
-        LambdaVisitor(I_V innerNodeVisitor, L_V outerNodeVisitor) -> LambdaVisitor<I_V, L_V>;
-#endif
+        struct Node {
+            Box bounds;
+            NodeIndex parent;
+            size_t height;
+            NodeType type;
+            union {
+                Children children;
+                U data;
+                NodeIndex nextFree;
+            };
+
+            Node() :
+                bounds(),
+                parent(NoNode),
+                height(0u),
+                type(NodeType::Free),
+                nextFree(NoNode) {}
+
+            bool isLeaf() const {
+                return type == NodeType::Leaf;
+            }
+        };
+    private:
+        std::vector<Node> m_nodes;
+        NodeIndex m_root;
+        NodeIndex m_freeList;
+        std::unordered_map<U, NodeIndex> m_leafForData;
+    public:
+        AABBTree() :
+            m_root(NoNode),
+            m_freeList(NoNode) {}
 
-        class Node {
-        public:
-            Box m_bounds;
-            InnerNode* m_parent;
-        protected:
-            explicit Node(const Box& bounds) :
-                m_bounds(bounds),
-                m_parent(nullptr) {}
-        public:
-            virtual ~Node() = default;
+        /**
+         * Indicates whether a node with the given data exists in this tree.
+         *
+         * @param data the data to find
+         * @return true if a node with the given data exists and false otherwise
+         */
+        bool contains(const U& data) const {
+            auto it = m_leafForData.find(data);
+            return it != m_leafForData.end();
+        }
 
-            /**
-             * Return the bounds of this node.
-             *
-             * @return the bounds
-             */
-            const Box& bounds() const {
-                return m_bounds;
+        /**
+         * Returns the bounds of the node with the given data, i.e., the bounds with which it was last inserted or
+         * updated.
+         *
+         * @param data the data to find
+         * @return the bounds of the node with the given data or an empty optional if no such node exists in this tree
+         */
+        std::optional<Box> findBounds(const U& data) const {
+            auto it = m_leafForData.find(data);
+            if (it == m_leafForData.end() || it->second == NoNode) {
+                return std::nullopt;
             }
+            return m_nodes[it->second].bounds;
+        }
 
-            /**
-             * Return the height of this node. A leaf always has a height of 1, and an inner node has a height equal to the
-             * maximum of the heights of its children plus one.
-             *
-             * @return the height
-             */
-            virtual size_t height() const = 0;
+        /**
+         * Clears this tree and rebuilds it from the given objects.
+         *
+         * Rather than inserting the objects one by one, the tree is built top-down by recursively splitting the objects
+         * using a binned surface area heuristic. This takes O(n log n) time and yields a tree of better query quality
+         * than incremental insertion.
+         *
+         * @param objects the objects to insert, a list of DataType
+         * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         *
+         * @throws NodeTreeException if the given objects contain duplicates, or if the bounds of any object contains NaN
+         */
+        template <typename DataList, typename GetBounds>
+        void clearAndBuild(const DataList& objects, GetBounds&& getBounds) {
+            clear();
 
-            /**
-             * Inserts a new node into the subtree rooted at `this`.
-             *
-             * @param bounds the bounds of the data to be inserted
-             * @param data the data to be inserted
-             * @return a pair containing the new subtree root (may be `this`, or a new node), and the newly inserted LeafNode
-             */
-            virtual std::pair<Node*, LeafNode*> insert(const Box& bounds, const U& data) = 0;
+            std::vector<BuildItem> items;
+            items.reserve(static_cast<size_t>(std::distance(std::begin(objects), std::end(objects))));
 
-            /**
-             * Accepts the given visitor.
-             *
-             * @param visitor the visitor to accept
-             */
-            virtual void accept(Visitor& visitor) const = 0;
-        public:
-            /**
-             * Appends a textual representation of this node to the given output stream.
-             *
-             * @param str the stream to append to
-             */
-            void appendTo(std::ostream& str) const {
-                appendTo(str, "  ", 0);
-            }
+            try {
+                for (const U& object : objects) {
+                    const Box bounds = getBounds(object);
+                    check(bounds);
 
-            /**
-             * Appends a textual representation of this node to the given output stream using the given indent string and
-             * the given level of indentation.
-             *
-             * @param str the stream to append to
-             * @param indent the indent string
-             * @param level the level of indentation
-             */
-            virtual void appendTo(std::ostream& str, const std::string& indent, size_t level) const = 0;
+                    if (!m_leafForData.emplace(object, NoNode).second) {
+                        throw NodeTreeException("Data already in tree");
+                    }
 
-            virtual void checkParentPointers(const Node* expectedParent) const = 0;
-        protected:
-            /**
-             * Updates the bounds of this node.
-             *
-             * @param bounds the new bounds
-             */
-            void setBounds(const Box& bounds) {
-                m_bounds = bounds;
+                    items.push_back(BuildItem{bounds, bounds.center(), object});
+                }
+            } catch (...) {
+                m_leafForData.clear();
+                throw;
             }
 
-            /**
-             * Appends a textual representation of this node's bounds to the given output stream.
-             *
-             * @param str the stream to append to
-             */
-            void appendBounds(std::ostream& str) const {
-                str << "[ ( " << m_bounds.min << " ) ( " << m_bounds.max  << " ) ]";
+            if (!items.empty()) {
+                m_nodes.reserve(2u * items.size() - 1u);
+                m_root = build(std::begin(items), std::end(items), 0u);
             }
-        };
+        }
 
         /**
-         * An inner node of an AABB tree does not carry data. It's only purpose is to structure the tree. Its bounds is
-         * the smallest bounding box that contains the bounds of its children.
+         * Insert a node with the given bounds and data into this tree.
+         *
+         * @param bounds the bounds to insert
+         * @param data the data to insert
+         *
+         * @throws NodeTreeException if a node with the given data already exists in this tree, or the bounds contains NaN
          */
-        class InnerNode : public Node {
-        private:
-            Node* m_left;
-            Node* m_right;
-            size_t m_height;
-        public:
-            InnerNode(Node* left, Node* right) :
-                Node(merge(left->bounds(), right->bounds())),
-                m_left(left),
-                m_right(right),
-                m_height(0) {
-                assert(m_left != nullptr);
-                assert(m_right != nullptr);
+        void insert(const Box& bounds, const U& data) {
+            check(bounds);
 
-                m_left->m_parent = this;
-                m_right->m_parent = this;
+            // Check that the data isn't already inserted
+            if (m_leafForData.find(data) != m_leafForData.end()) {
+                throw NodeTreeException("Data already in tree");
+            }
 
-                updateHeight();
+            if (empty()) {
+                m_root = createLeaf(bounds, data);
+                m_leafForData[data] = m_root;
+                return;
             }
 
-        private: // node removal private
-            /**
-             * Children (or grandchildren etc.) changed. Update the height and bounds.
-             * Recurses up the tree along the m_parent chain until it reaches the root.
-             *
-             * @return the new root of the tree
-             */
-            Node* updateAndReturnRoot() {
-                updateHeight();
-                updateBounds();
+            // Descend to the leaf whose subtree is increased the least by inserting a node with the given bounds.
+            NodeIndex sibling = m_root;
+            while (!m_nodes[sibling].isLeaf()) {
+                const Children& children = m_nodes[sibling].children;
+                sibling = selectLeastIncreaser(children.left, children.right, bounds);
+            }
 
-                if (this->m_parent == nullptr) {
-                    return this;
-                }
+            // Replace that leaf by a new inner node that has the leaf as its left child and the new leaf as its right
+            // child.
+            const NodeIndex parent = m_nodes[sibling].parent;
+            const NodeIndex newLeaf = createLeaf(bounds, data);
+            const NodeIndex newParent = createInner(sibling, newLeaf);
 
-                return this->m_parent->updateAndReturnRoot();
+            if (parent == NoNode) {
+                m_root = newParent;
+            } else {
+                replaceChild(parent, sibling, newParent);
+                updateAncestors(parent);
             }
 
-            /**
-             * One of our direct children is being swapped for a new node.
-             *
-             * @return the new root of the tree
-             */
-            Node* replaceChild(Node* child, Node* replacement) {
-                replacement->m_parent = this;
-
-                if (child == m_left) {
-                    m_left = replacement;
-                } else {
-                    assert(child == m_right);
-                    m_right = replacement;
-                }
+            m_leafForData[data] = newLeaf;
+        }
 
-                return updateAndReturnRoot();
+        /**
+         * Removes the node with the given data from this tree.
+         *
+         * @param data the data to remove
+         * @return true if a node with the given data was removed, and false otherwise
+         */
+        bool remove(const U& data) {
+            auto it = m_leafForData.find(data);
+            if (it == m_leafForData.end()) {
+                return false;
             }
-        public: // Node removal public
-            /**
-             * One of our direct children is being deleted. `this` will turn into a LeafNode.
-             *
-             * @param child either m_left or m_right, which is being deleted
-             * @return the new root of the tree
-             */
-            Node* handleChildDeletion(LeafNode* child) {
-                Node* replacementForThis;
-                if (child == m_left) {
-                    replacementForThis = m_right;
-                } else {
-                    assert(child == m_right);
-                    replacementForThis = m_left;
-                }
 
-                // Clear m_left/m_right so our destructor doesn't delete our children.
-                // The caller is going to delete one of them (`child`),
-                // and we will reuse the other one as the replacement for `this`.
-                m_left = nullptr;
-                m_right = nullptr;
-
-                // Special case when `this` is already the tree root
-                if (this->m_parent == nullptr) {
-                    Node* newTreeRoot = replacementForThis;
-                    newTreeRoot->m_parent = nullptr;
-                    delete this;
-                    return newTreeRoot;
-                }
+            const NodeIndex leaf = it->second;
+            assert(m_nodes[leaf].isLeaf() && m_nodes[leaf].data == data);
+            m_leafForData.erase(it);
+
+            const NodeIndex parent = m_nodes[leaf].parent;
+            freeNode(leaf);
 
-                Node* newTreeRoot = this->m_parent->replaceChild(this, replacementForThis);
-                delete this;
-                return newTreeRoot;
+            if (parent == NoNode) {
+                // the tree is now empty, so there is no need to keep the storage around
+                clear();
+                return true;
             }
 
-        public: // Node overrides
-            ~InnerNode() override {
-                delete m_left;
-                delete m_right;
+            // The parent of the removed leaf is replaced by the sibling of the removed leaf.
+            const Children& children = m_nodes[parent].children;
+            const NodeIndex sibling = children.left == leaf ? children.right : children.left;
+            const NodeIndex grandParent = m_nodes[parent].parent;
+            freeNode(parent);
+
+            m_nodes[sibling].parent = grandParent;
+            if (grandParent == NoNode) {
+                m_root = sibling;
+            } else {
+                replaceChild(grandParent, parent, sibling);
+                updateAncestors(grandParent);
             }
 
-            size_t height() const override {
-                return m_height;
+            return true;
+        }
+
+        /**
+         * Updates the node with the given data with the given new bounds.
+         *
+         * @param newBounds the new bounds of the node
+         * @param data the node data of the node to update
+         *
+         * @throws NodeTreeException if no node with the given data can be found in this tree
+         */
+        void update(const Box& newBounds, const U& data) {
+            check(newBounds);
+
+            if (!remove(data)) {
+                throw NodeTreeException("AABB node not found");
+            }
+            insert(newBounds, data);
+        }
+    private:
+        /**
+         * Returns the index of an unused node, either by recycling a free node or by appending a new node.
+         */
+        NodeIndex allocateNode() {
+            if (m_freeList != NoNode) {
+                const NodeIndex index = m_freeList;
+                m_freeList = m_nodes[index].nextFree;
+                return index;
             }
 
-            std::pair<Node*, LeafNode*> insert(const Box& bounds, const U& data) override {
-                // Select the subtree which is increased the least by inserting a node with the given bounds.
-                // Then insert the node into that subtree and update our reference to it.
-                auto*& subtree = selectLeastIncreaser(m_left, m_right, bounds);
+            m_nodes.emplace_back();
+            return m_nodes.size() - 1u;
+        }
 
-                Node* newSubtree;
-                LeafNode* insertedLeafNode;
-                std::tie(newSubtree, insertedLeafNode) = subtree->insert(bounds, data);
+        /**
+         * Marks the given node as unused and adds it to the free list.
+         */
+        void freeNode(const NodeIndex index) {
+            Node& node = m_nodes[index];
+            node.parent = NoNode;
+            node.height = 0u;
+            node.type = NodeType::Free;
+            node.nextFree = m_freeList;
+            m_freeList = index;
+        }
 
-                // Update the parent pointer
-                newSubtree->m_parent = this;
+        NodeIndex createLeaf(const Box& bounds, const U& data) {
+            const NodeIndex index = allocateNode();
 
-                // Subtree is either a reference to m_left or m_right
-                if (subtree == m_left) {
-                    m_left = newSubtree;
-                } else {
-                    assert(subtree == m_right);
-                    m_right = newSubtree;
-                }
+            Node& node = m_nodes[index];
+            node.bounds = bounds;
+            node.parent = NoNode;
+            node.height = 1u;
+            node.type = NodeType::Leaf;
+            node.data = data;
 
-                // Update our data.
-                updateBounds();
-                updateHeight();
+            return index;
+        }
 
-                return std::make_pair(this, insertedLeafNode);
-            }
+        /**
+         * Creates a new inner node with the given children, and updates the parent indices of the children. The parent
+         * index of the new node is inherited from the given left child.
+         */
+        NodeIndex createInner(const NodeIndex left, const NodeIndex right) {
+            assert(left != NoNode);
+            assert(right != NoNode);
 
-        private:
-            /**
-             * Selects one of the two given nodes such that it increases the given bounds the least.
-             *
-             * @tparam TT the type of the nodes
-             * @param node1 the first node to test
-             * @param node2 the second node to test
-             * @param bounds the bounds to test against
-             * @return node1 if it increases the given bounds volume by a smaller or equal amount than node2 would, and
-             *     node2 otherwise
-             */
-            template <typename TT>
-            static TT*& selectLeastIncreaser(TT*& node1, TT*& node2, const Box& bounds) {
-                const auto node1Contains = node1->bounds().contains(bounds);
-                const auto node2Contains = node2->bounds().contains(bounds);
-
-                if (node1Contains && !node2Contains) {
-                    return node1;
-                } else if (!node1Contains && node2Contains) {
-                    return node2;
-                } else if (!node1Contains && !node2Contains) {
-                    const auto new1 = vm::merge(node1->bounds(), bounds);
-                    const auto new2 = vm::merge(node2->bounds(), bounds);
-                    const auto vol1 = node1->bounds().volume();
-                    const auto vol2 = node2->bounds().volume();
-                    const auto diff1 = new1.volume() - vol1;
-                    const auto diff2 = new2.volume() - vol2;
-
-                    if (diff1 < diff2) {
-                        return node1;
-                    } else if (diff2 < diff1) {
-                        return node2;
-                    }
-                }
+            const NodeIndex index = allocateNode();
 
-                static auto choice = 0u;
+            Node& node = m_nodes[index];
+            node.parent = m_nodes[left].parent;
+            node.type = NodeType::Inner;
+            node.children = Children{left, right};
 
-                if (node1->height() < node2->height()) {
-                    return node1;
-                } else if (node2->height() < node1->height()) {
-                    return node2;
-                } else {
-                    if (choice++ % 2 == 0) {
-                        return node1;
-                    } else {
-                        return node2;
-                    }
-                }
-            }
+            m_nodes[left].parent = index;
+            m_nodes[right].parent = index;
 
-            void updateBounds() {
-                this->setBounds(merge(m_left->bounds(), m_right->bounds()));
+            updateNode(index);
+            return index;
+        }
+
+        /**
+         * One of the direct children of the given inner node is being swapped for a new node.
+         */
+        void replaceChild(const NodeIndex parent, const NodeIndex child, const NodeIndex replacement) {
+            Children& children = m_nodes[parent].children;
+            if (children.left == child) {
+                children.left = replacement;
+            } else {
+                assert(children.right == child);
+                children.right = replacement;
             }
+            m_nodes[replacement].parent = parent;
+        }
+
+        /**
+         * Updates the height and the bounds of the given inner node from its children.
+         */
+        void updateNode(const NodeIndex index) {
+            Node& node = m_nodes[index];
+            assert(node.type == NodeType::Inner);
 
-            void updateHeight() {
-                m_height = std::max(m_left->height(), m_right->height()) + 1;
-                assert(m_height > 0);
+            const Node& left = m_nodes[node.children.left];
+            const Node& right = m_nodes[node.children.right];
+
+            node.bounds = vm::merge(left.bounds, right.bounds);
+            node.height = std::max(left.height, right.height) + 1u;
+        }
+
+        /**
+         * Children (or grandchildren etc.) of the given node changed. Updates the height and bounds of the given node
+         * and of all of its ancestors.
+         */
+        void updateAncestors(NodeIndex index) {
+            while (index != NoNode) {
+                updateNode(index);
+                index = m_nodes[index].parent;
             }
+        }
 
-            void accept(Visitor& visitor) const override {
-                if (visitor.visit(this)) {
-                    m_left->accept(visitor);
-                    m_right->accept(visitor);
+        /**
+         * Selects one of the two given nodes such that it increases the given bounds the least.
+         *
+         * @param index1 the first node to test
+         * @param index2 the second node to test
+         * @param bounds the bounds to test against
+         * @return index1 if it increases the given bounds volume by a smaller or equal amount than index2 would, and
+         *     index2 otherwise
+         */
+        NodeIndex selectLeastIncreaser(const NodeIndex index1, const NodeIndex index2, const Box& bounds) const {
+            const Node& node1 = m_nodes[index1];
+            const Node& node2 = m_nodes[index2];
+
+            const auto node1Contains = node1.bounds.contains(bounds);
+            const auto node2Contains = node2.bounds.contains(bounds);
+
+            if (node1Contains && !node2Contains) {
+                return index1;
+            } else if (!node1Contains && node2Contains) {
+                return index2;
+            } else if (!node1Contains && !node2Contains) {
+                const auto new1 = vm::merge(node1.bounds, bounds);
+                const auto new2 = vm::merge(node2.bounds, bounds);
+                const auto vol1 = node1.bounds.volume();
+                const auto vol2 = node2.bounds.volume();
+                const auto diff1 = new1.volume() - vol1;
+                const auto diff2 = new2.volume() - vol2;
+
+                if (diff1 < diff2) {
+                    return index1;
+                } else if (diff2 < diff1) {
+                    return index2;
                 }
             }
-        public:
-            void appendTo(std::ostream& str, const std::string& indent, const size_t level) const override {
-                for (size_t i = 0; i < level; ++i)
-                    str << indent;
 
-                str << "O ";
-                this->appendBounds(str);
-                str << std::endl;
+            static auto choice = 0u;
 
-                m_left->appendTo(str, indent, level + 1);
-                m_right->appendTo(str, indent, level + 1);
+            if (node1.height < node2.height) {
+                return index1;
+            } else if (node2.height < node1.height) {
+                return index2;
+            } else {
+                if (choice++ % 2 == 0) {
+                    return index1;
+                } else {
+                    return index2;
+                }
             }
+        }
 
-            void checkParentPointers([[maybe_unused]] const Node* expectedParent) const override {
-                assert(this->m_parent == expectedParent);
-                m_left->checkParentPointers(this);
-                m_left->checkParentPointers(this);
+        /**
+         * Visits the nodes of this tree in depth first order without using a stack. The given inner node visitor
+         * returns whether the children of the visited inner node should be visited.
+         *
+         * @param visitInner a function from const Node& -> bool that is called for every visited inner node
+         * @param visitLeaf a function from const Node& -> void that is called for every visited leaf
+         */
+        template <typename I_V, typename L_V>
+        void visit(I_V&& visitInner, L_V&& visitLeaf) const {
+            NodeIndex previous = NoNode;
+            NodeIndex current = m_root;
+
+            while (current != NoNode) {
+                const Node& node = m_nodes[current];
+
+                NodeIndex next;
+                if (previous == node.parent) {
+                    // descending into this node
+                    if (node.isLeaf()) {
+                        visitLeaf(node);
+                        next = node.parent;
+                    } else if (visitInner(node)) {
+                        next = node.children.left;
+                    } else {
+                        next = node.parent;
+                    }
+                } else if (previous == node.children.left) {
+                    // ascending from the left child
+                    next = node.children.right;
+                } else {
+                    // ascending from the right child
+                    next = node.parent;
+                }
+
+                previous = current;
+                current = next;
             }
-        };
+        }
 
         /**
-         * A leaf node represents actual data. It does not have any children. Its bounds equals the bounds supplied when
-         * the node was inserted into the tree. A leaf has a height of 1 and a balance of 0.
+         * Tests a ray against a box using the slab method. The reciprocal of the ray direction and its signs are computed
+         * once per query so that testing a box requires no divisions and no branches on the ray direction.
+         *
+         * A box is intersected if the ray has a point with a non negative distance in the box, so a box that contains the
+         * ray origin is always intersected.
          */
-        class LeafNode : public Node {
+        class RayBoxTest {
         private:
-            U m_data;
+            vm::vec<T,S> m_origin;
+            vm::vec<T,S> m_invDirection;
+            bool m_negative[S];
         public:
-            LeafNode(const Box& bounds, const U& data) : Node(bounds), m_data(data) {}
-
-            /**
-             * Deletes this. Returns the new root of the tree.
-             */
-            Node* deleteThis() {
-                Node* newRoot = (this->m_parent != nullptr)
-                                ? this->m_parent->handleChildDeletion(this)
-                                : nullptr;
-                delete this;
-                return newRoot;
-            }
-
-            /**
-             * Returns the data associated with this node.
-             *
-             * @return the data associated with this node
-             */
-            U& data() {
-                return m_data;
-            }
-
-            /**
-             * Returns the data associated with this node.
-             *
-             * @return the data associated with this node
-             */
-            const U& data() const {
-                return m_data;
+            explicit RayBoxTest(const vm::ray<T,S>& ray) :
+                m_origin(ray.origin) {
+                for (size_t i = 0u; i < S; ++i) {
+                    m_invDirection[i] = static_cast<T>(1) / ray.direction[i];
+                    m_negative[i] = std::signbit(m_invDirection[i]);
+                }
             }
 
-        public: // Node overrides
-            size_t height() const override {
-                return 1;
+            bool operator()(const Box& box) const {
+                return !std::isnan(distance(box));
             }
 
             /**
-             * Returns a new inner node that has this leaf as its left child and a new leaf representing the given bounds
-             * and data as its right child.
-             *
-             * @param bounds the bounds to insert
-             * @param data the data to insert
-             * @return a pair containing the new inner node that is the root of this subtree, and the newly inserted LeafNode
+             * Returns the distance from the ray origin to the point where the ray enters the given box, or NaN if the
+             * ray does not intersect the box. The distance is 0 if the box contains the ray origin.
              */
-            std::pair<Node*, LeafNode*> insert(const Box& bounds, const U& data) override {
-                auto* newLeaf = new LeafNode(bounds, data);
-                auto* newParent = new InnerNode(this, newLeaf);
+            T distance(const Box& box) const {
+                auto tMin = static_cast<T>(0);
+                auto tMax = std::numeric_limits<T>::max();
+
+                for (size_t i = 0u; i < S; ++i) {
+                    const auto t1 = (box.min[i] - m_origin[i]) * m_invDirection[i];
+                    const auto t2 = (box.max[i] - m_origin[i]) * m_invDirection[i];
+                    const auto tNear = m_negative[i] ? t2 : t1;
+                    const auto tFar  = m_negative[i] ? t1 : t2;
+
+                    // If the ray is parallel to the slab and its origin lies on one of its planes, the products above
+                    // are NaN. The comparisons are false then, so such a slab does not restrict the distance range.
+                    if (tNear > tMin) {
+                        tMin = tNear;
+                    }
+                    if (tFar < tMax) {
+                        tMax = tFar;
+                    }
+                }
 
-                return std::make_pair(newParent, newLeaf);
+                return tMin <= tMax ? tMin : std::numeric_limits<T>::quiet_NaN();
             }
+        };
 
-            void accept(Visitor& visitor) const override {
-                visitor.visit(this);
+        static bool boxesIntersect(const Box& lhs, const Box& rhs) {
+            for (size_t i = 0u; i < S; ++i) {
+                if (lhs.max[i] < rhs.min[i] || lhs.min[i] > rhs.max[i]) {
+                    return false;
+                }
             }
+            return true;
+        }
 
-            void appendTo(std::ostream& str, const std::string& indent, const size_t level) const override {
-                for (size_t i = 0; i < level; ++i)
-                    str << indent;
-
-                str << "L ";
-                this->appendBounds(str);
-                str << ": " << m_data << std::endl;
-            }
+        /**
+         * Appends a textual representation of the given node's bounds to the given output stream.
+         */
+        static void appendBounds(std::ostream& str, const Node& node) {
+            str << "[ ( " << node.bounds.min << " ) ( " << node.bounds.max  << " ) ]";
+        }
 
-            virtual void checkParentPointers([[maybe_unused]] const Node* expectedParent) const override {
-                assert(this->m_parent == expectedParent);
-            }
+        /**
+         * An object to be added to the tree by a bulk build, together with its bounds and the center of its bounds.
+         */
+        struct BuildItem {
+            Box bounds;
+            vm::vec<T,S> center;
+            U data;
         };
-    private:
-        Node* m_root;
-        std::unordered_map<U, LeafNode*> m_leafForData;
-    public:
-        AABBTree() : m_root(nullptr) {}
 
-        ~AABBTree() {
-            clear();
-        }
+        using BuildIterator = typename std::vector<BuildItem>::iterator;
 
         /**
-         * Indicates whether a node with the given data exists in this tree.
-         *
-         * @param data the data to find
-         * @return true if a node with the given data exists and false otherwise
+         * The number of bins used to approximate the surface area heuristic when splitting a range of build items.
          */
-        bool contains(const U& data) const {
-            auto it = m_leafForData.find(data);
-            return it != m_leafForData.end();
-        }
+        static constexpr size_t BuildBinCount = 16u;
 
         /**
-         * Clears this tree and rebuilds it by inserting given objects.
-         *
-         * @param objects the objects to insert, a list of DataType
-         * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         * Beyond this depth, ranges are split at the median to guarantee that the recursion depth remains logarithmic.
          */
-        template <typename DataList, typename GetBounds>
-        void clearAndBuild(const DataList& objects, GetBounds&& getBounds) {
-            clear();
-            for (const U& object : objects) {
-                insert(getBounds(object), object);
-            }
-        }
+        static constexpr size_t MaxSAHBuildDepth = 48u;
 
         /**
-         * Insert a node with the given bounds and data into this tree.
+         * Builds a subtree for the given range of build items using a binned top-down surface area heuristic, and
+         * returns its root. The range must not be empty.
          *
-         * @param bounds the bounds to insert
-         * @param data the data to insert
+         * The leafs are registered in m_leafForData, which must already contain an entry for each item's data.
          *
-         * @throws NodeTreeException if a node with the given data already exists in this tree, or the bounds contains NaN
+         * @param first the start of the range
+         * @param last the end of the range
+         * @param depth the depth of the subtree root
+         * @return the root of the subtree
          */
-        void insert(const Box& bounds, const U& data) {
-            check(bounds);
+        NodeIndex build(BuildIterator first, BuildIterator last, const size_t depth) {
+            assert(first != last);
 
-            // Check that the data isn't already inserted
-            if (m_leafForData.find(data) != m_leafForData.end()) {
-                throw NodeTreeException("Data already in tree");
+            if (std::next(first) == last) {
+                const NodeIndex leaf = createLeaf(first->bounds, first->data);
+                m_leafForData[first->data] = leaf;
+                return leaf;
             }
 
-            if (empty()) {
-                auto* insertedLeafNode = new LeafNode(bounds, data);
-
-                m_root = insertedLeafNode;
-                m_leafForData[data] = insertedLeafNode;
-            } else {
-                LeafNode* insertedLeafNode;
-                std::tie(m_root, insertedLeafNode) = m_root->insert(bounds, data);
-
-                m_leafForData[data] = insertedLeafNode;
-            }
+            const auto mid = split(first, last, depth);
+            const NodeIndex left = build(first, mid, depth + 1u);
+            const NodeIndex right = build(mid, last, depth + 1u);
+            return createInner(left, right);
         }
 
         /**
-         * Removes the node with the given data from this tree.
+         * Partitions the given range of build items into two non empty subranges and returns the start of the second
+         * subrange.
          *
-         * @param data the data to remove
-         * @return true if a node with the given data was removed, and false otherwise
+         * The items are split along the axis where the centers of their bounds have the largest extent. The split
+         * position is chosen by binning the bounds centers and minimizing the surface area heuristic over the bin
+         * boundaries. If no useful split can be found in this way, the range is split at the median.
          */
-        bool remove(const U& data) {
-            auto it = m_leafForData.find(data);
-            if (it == m_leafForData.end()) {
-                return false;
+        static BuildIterator split(BuildIterator first, BuildIterator last, const size_t depth) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            assert(count > 1u);
+
+            auto centerBounds = Box(first->center, first->center);
+            for (auto it = std::next(first); it != last; ++it) {
+                centerBounds = vm::merge(centerBounds, Box(it->center, it->center));
             }
 
-            LeafNode* leaf = it->second;
-            assert(leaf->data() == data);
-            m_leafForData.erase(it);
+            const auto centerSize = centerBounds.size();
+            size_t axis = 0u;
+            for (size_t i = 1u; i < S; ++i) {
+                if (centerSize[i] > centerSize[axis]) {
+                    axis = i;
+                }
+            }
 
-            m_root = leaf->deleteThis();
+            if (centerSize[axis] > static_cast<T>(0) && depth < MaxSAHBuildDepth) {
+                const auto binMin = centerBounds.min[axis];
+                const auto binScale = static_cast<T>(BuildBinCount) / centerSize[axis];
+                const auto binIndex = [&](const BuildItem& item) {
+                    const auto index = static_cast<size_t>((item.center[axis] - binMin) * binScale);
+                    return std::min(index, BuildBinCount - 1u);
+                };
+
+                Box binBounds[BuildBinCount];
+                size_t binCounts[BuildBinCount] = {};
+                for (auto it = first; it != last; ++it) {
+                    const auto index = binIndex(*it);
+                    binBounds[index] = binCounts[index] == 0u ? it->bounds : vm::merge(binBounds[index], it->bounds);
+                    ++binCounts[index];
+                }
 
-            return true;
+                // sweep from the right to compute the costs of the right halves for every split position
+                T rightCosts[BuildBinCount] = {};
+                Box rightBounds;
+                size_t rightCount = 0u;
+                for (size_t i = BuildBinCount - 1u; i > 0u; --i) {
+                    if (binCounts[i] > 0u) {
+                        rightBounds = rightCount == 0u ? binBounds[i] : vm::merge(rightBounds, binBounds[i]);
+                        rightCount += binCounts[i];
+                    }
+                    rightCosts[i] = rightCount == 0u ? static_cast<T>(0) : halfArea(rightBounds) * static_cast<T>(rightCount);
+                }
+
+                // sweep from the left and pick the split position with the smallest total cost
+                auto bestCost = std::numeric_limits<T>::max();
+                size_t bestSplit = 0u;
+                Box leftBounds;
+                size_t leftCount = 0u;
+                for (size_t i = 0u; i < BuildBinCount - 1u; ++i) {
+                    if (binCounts[i] > 0u) {
+                        leftBounds = leftCount == 0u ? binBounds[i] : vm::merge(leftBounds, binBounds[i]);
+                        leftCount += binCounts[i];
+                    }
+                    if (leftCount > 0u && leftCount < count) {
+                        const auto cost = halfArea(leftBounds) * static_cast<T>(leftCount) + rightCosts[i + 1u];
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestSplit = i + 1u;
+                        }
+                    }
+                }
+
+                if (bestSplit > 0u) {
+                    const auto mid = std::partition(first, last, [&](const BuildItem& item) { return binIndex(item) < bestSplit; });
+                    if (mid != first && mid != last) {
+                        return mid;
+                    }
+                }
+            }
+
+            const auto mid = std::next(first, static_cast<std::ptrdiff_t>(count / 2u));
+            std::nth_element(first, mid, last, [&](const BuildItem& lhs, const BuildItem& rhs) {
+                return lhs.center[axis] < rhs.center[axis];
+            });
+            return mid;
         }
 
         /**
-         * Updates the node with the given data with the given new bounds.
-         *
-         * @param newBounds the new bounds of the node
-         * @param data the node data of the node to update
-         *
-         * @throws NodeTreeException if no node with the given data can be found in this tree
+         * Returns half of the surface area of the given box, which is proportional to the probability of a random ray
+         * hitting it.
          */
-        void update(const Box& newBounds, const U& data) {
-            check(newBounds);
-
-            if (!remove(data)) {
-                throw NodeTreeException("AABB node not found");
+        static T halfArea(const Box& bounds) {
+            const auto size = bounds.size();
+            if constexpr (S == 1u) {
+                return size[0];
+            } else {
+                auto result = static_cast<T>(0);
+                for (size_t i = 0u; i < S; ++i) {
+                    for (size_t j = i + 1u; j < S; ++j) {
+                        result += size[i] * size[j];
+                    }
+                }
+                return result;
             }
-            insert(newBounds, data);
         }
-    private:
+
         void check(const Box& bounds) const {
             if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max)) {
                 throw NodeTreeException("Cannot add node to AABB tree with invalid bounds");
@@ -574,10 +714,10 @@ namespace TrenchBroom {
          * Clears this node tree.
          */
         void clear() {
-            if (!empty()) {
-                delete m_root;
-                m_root = nullptr;
-            }
+            m_nodes.clear();
+            m_root = NoNode;
+            m_freeList = NoNode;
+            m_leafForData.clear();
         }
 
         /**
@@ -586,7 +726,7 @@ namespace TrenchBroom {
          * @return true if this tree is empty and false otherwise
          */
         bool empty() const {
-            return m_root == nullptr;
+            return m_root == NoNode;
         }
 
         /**
@@ -601,17 +741,26 @@ namespace TrenchBroom {
             if (empty()) {
                 return EmptyBox;
             } else {
-                return m_root->bounds();
+                return m_nodes[m_root].bounds;
             }
         }
 
+        /**
+         * Returns the number of data items in this tree.
+         *
+         * @return the number of data items
+         */
+        size_t size() const {
+            return m_leafForData.size();
+        }
+
         /**
          * Returns the height of this tree.
          *
          * @return the height of this tree
          */
         size_t height() const {
-            return empty() ? 0 : m_root->height();
+            return empty() ? 0 : m_nodes[m_root].height;
         }
 
         /**
@@ -636,23 +785,104 @@ namespace TrenchBroom {
          */
         template <typename O>
         void findIntersectors(const vm::ray<T,S>& ray, O out) const {
-            if (!empty()) {
-                LambdaVisitor visitor(
-                    [&](const InnerNode* innerNode) {
-                        return innerNode->bounds().contains(ray.origin) || !vm::is_nan(
-                            vm::intersect_ray_bbox(ray, innerNode->bounds()));
-                    },
-                    [&](const LeafNode* leaf) {
-                        if (leaf->bounds().contains(ray.origin) || !vm::is_nan(vm::intersect_ray_bbox(ray, leaf->bounds()))) {
-                            out = leaf->data();
-                            ++out;
+            const RayBoxTest intersects(ray);
+            visit(
+                [&](const Node& innerNode) {
+                    return intersects(innerNode.bounds);
+                },
+                [&](const Node& leaf) {
+                    if (intersects(leaf.bounds)) {
+                        out = leaf.data;
+                        ++out;
+                    }
+                }
+            );
+        }
+
+        /**
+         * Visits the data items whose bounding boxes intersect with the given ray in the order in which the ray enters
+         * their bounding boxes. The given visitor is called with each data item and the distance at which the ray enters
+         * its bounding box, and returns the maximum distance that is still of interest. Subtrees whose bounds the ray
+         * enters beyond that distance are skipped, and the traversal stops once no remaining box can be entered within
+         * it.
+         *
+         * This allows finding the closest of a number of objects without testing all objects along the ray.
+         *
+         * @tparam L_V the type of the visitor, a function from (const U&, T) -> T
+         * @param ray the ray to test
+         * @param visitLeaf the visitor
+         */
+        template <typename L_V>
+        void visitIntersectorsByDistance(const vm::ray<T,S>& ray, L_V&& visitLeaf) const {
+            if (empty()) {
+                return;
+            }
+
+            const RayBoxTest intersects(ray);
+            const auto rootDistance = intersects.distance(m_nodes[m_root].bounds);
+            if (std::isnan(rootDistance)) {
+                return;
+            }
+
+            using Entry = std::pair<T, NodeIndex>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+            queue.emplace(rootDistance, m_root);
+
+            auto maxDistance = std::numeric_limits<T>::max();
+            while (!queue.empty() && queue.top().first <= maxDistance) {
+                const auto [distance, index] = queue.top();
+                queue.pop();
+
+                const Node& node = m_nodes[index];
+                if (node.isLeaf()) {
+                    maxDistance = std::min(maxDistance, visitLeaf(node.data, distance));
+                } else {
+                    for (const auto childIndex : { node.children.left, node.children.right }) {
+                        const auto childDistance = intersects.distance(m_nodes[childIndex].bounds);
+                        if (!std::isnan(childDistance) && childDistance <= maxDistance) {
+                            queue.emplace(childDistance, childIndex);
                         }
                     }
-                );
-                m_root->accept(visitor);
+                }
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and retuns a list of those
+         * items.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const Box& box) const {
+            List result;
+            findIntersectors(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the given
+         * output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const Box& box, O out) const {
+            visit(
+                [&](const Node& innerNode) {
+                    return boxesIntersect(innerNode.bounds, box);
+                },
+                [&](const Node& leaf) {
+                    if (boxesIntersect(leaf.bounds, box)) {
+                        out = leaf.data;
+                        ++out;
+                    }
+                }
+            );
+        }
+
         /**
          * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
          *
@@ -675,20 +905,17 @@ namespace TrenchBroom {
          */
         template <typename O>
         void findContainers(const vm::vec<T,S>& point, O out) const {
-            if (!empty()) {
-                LambdaVisitor visitor(
-                    [&](const InnerNode* innerNode) {
-                        return innerNode->bounds().contains(point);
-                    },
-                    [&](const LeafNode* leaf) {
-                        if (leaf->bounds().contains(point)) {
-                            out = leaf->data();
-                            ++out;
-                        }
+            visit(
+                [&](const Node& innerNode) {
+                    return innerNode.bounds.contains(point);
+                },
+                [&](const Node& leaf) {
+                    if (leaf.bounds.contains(point)) {
+                        out = leaf.data;
+                        ++out;
                     }
-                );
-                m_root->accept(visitor);
-            }
+                }
+            );
         }
 
         /**
@@ -697,8 +924,36 @@ namespace TrenchBroom {
          * @param str the output stream to print to
          */
         void print(std::ostream& str) const {
-            if (!empty()) {
-                m_root->appendTo(str);
+            if (empty()) {
+                return;
+            }
+
+            static const std::string indent = "  ";
+
+            std::vector<std::pair<NodeIndex, size_t>> stack;
+            stack.emplace_back(m_root, 0u);
+
+            while (!stack.empty()) {
+                const auto [index, level] = stack.back();
+                stack.pop_back();
+
+                for (size_t i = 0; i < level; ++i) {
+                    str << indent;
+                }
+
+                const Node& node = m_nodes[index];
+                if (node.isLeaf()) {
+                    str << "L ";
+                    appendBounds(str, node);
+                    str << ": " << node.data << std::endl;
+                } else {
+                    str << "O ";
+                    appendBounds(str, node);
+                    str << std::endl;
+
+                    stack.emplace_back(node.children.right, level + 1u);
+                    stack.emplace_back(node.children.left, level + 1u);
+                }
             }
         }
     };
@@ -20,180 +20,204 @@
 #ifndef TrenchBroom_Allocator_h
 #define TrenchBroom_Allocator_h
 
+#include <algorithm>
 #include <cassert>
-#include <stack>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 // Undefine this to prevent false positives when looking for memory leaks.
 #define TB_ENABLE_ALLOCATOR 1
 
 namespace TrenchBroom {
+    /**
+     * Pooled allocator for small objects of type T. Classes opt in by inheriting from Allocator<T>.
+     *
+     * Memory is obtained from a shared arena that allocates chunks of BlocksPerChunk blocks each. Every thread keeps
+     * a cache of free blocks, so that most allocations and deallocations do not need any synchronization. A thread
+     * takes PoolSize blocks at a time from the arena when its cache runs empty, and it returns PoolSize blocks to the
+     * arena when its cache holds more than twice that many. Objects may be deallocated on a different thread than
+     * the one they were allocated on.
+     *
+     * The arena never releases its chunks, so the memory used is bounded by the peak number of live objects.
+     */
     template <class T, size_t PoolSize = 64, size_t BlocksPerChunk = 256>
     class Allocator {
     private:
-        class Chunk {
-        private:
-            unsigned char m_blocks[BlocksPerChunk * sizeof(T)];
-            unsigned char m_firstFreeBlock;
-            unsigned char m_numFreeBlocks;
-        public:
-            Chunk() :
-                m_firstFreeBlock(0),
-                m_numFreeBlocks(BlocksPerChunk - 1) {
-                for (size_t i = 0; i < BlocksPerChunk - 1; i++)
-                    m_blocks[i * sizeof(T)] = static_cast<unsigned char>(i + 1);
-            }
-
-            bool contains(const T* t) const {
-                const unsigned char* block = reinterpret_cast<const unsigned char*>(t);
-                if (block < m_blocks)
-                    return false;
-                size_t offset = static_cast<size_t>(block - m_blocks);
-                return offset < (BlocksPerChunk - 1) * sizeof(T);
-            }
+        static constexpr size_t BatchSize = std::max(PoolSize, size_t(1));
 
-            T* allocate() {
-                if (m_numFreeBlocks == 0)
-                    return nullptr;
-
-                unsigned char* block = m_blocks + m_firstFreeBlock * sizeof(T);
-                m_firstFreeBlock = *block;
-                m_numFreeBlocks--;
-                return reinterpret_cast<T*>(block);
-            }
-
-            void deallocate(T* t) {
-                assert(m_numFreeBlocks < BlocksPerChunk - 1);
-                assert(contains(t));
+        union Block {
+            Block* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
 
-                unsigned char* block = reinterpret_cast<unsigned char*>(t);
-                assert(block >= m_blocks);
-                size_t offset = static_cast<size_t>(block - m_blocks);
-                assert(offset % sizeof(T) == 0);
+        struct Chunk {
+            Block blocks[BlocksPerChunk];
+        };
 
-                size_t index = offset / sizeof(T);
-                assert(index < BlocksPerChunk);
+        /**
+         * The shared arena from which the thread caches take their blocks.
+         */
+        class Arena {
+        private:
+            std::mutex m_mutex;
+            std::vector<std::unique_ptr<Chunk>> m_chunks;
+            Block* m_freeList = nullptr;
+        public:
+            /**
+             * Removes up to count blocks from the arena and prepends them to the given list, allocating a new chunk
+             * if the arena has no free blocks. Returns the number of blocks taken.
+             */
+            size_t acquire(Block*& list, const size_t count) {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_freeList == nullptr) {
+                    allocateChunk();
+                }
 
-                *block = m_firstFreeBlock;
-                m_firstFreeBlock = static_cast<unsigned char>(index);
-                m_numFreeBlocks++;
+                size_t taken = 0;
+                while (taken < count && m_freeList != nullptr) {
+                    Block* block = m_freeList;
+                    m_freeList = block->next;
+                    block->next = list;
+                    list = block;
+                    ++taken;
+                }
+                return taken;
             }
 
-            bool empty() const {
-                return m_numFreeBlocks == BlocksPerChunk - 1;
+            /**
+             * Returns the given list of blocks to the arena. The list ends at last, whose next pointer is
+             * overwritten.
+             */
+            void release(Block* first, Block* last) {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                last->next = m_freeList;
+                m_freeList = first;
             }
 
-            bool full() const {
-                return m_numFreeBlocks == 0;
+            size_t allocatedBytes() {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                return m_chunks.size() * sizeof(Chunk);
+            }
+        private:
+            void allocateChunk() {
+                auto chunk = std::make_unique<Chunk>();
+                for (size_t i = 0; i < BlocksPerChunk; ++i) {
+                    chunk->blocks[i].next = i + 1 < BlocksPerChunk ? &chunk->blocks[i + 1] : m_freeList;
+                }
+                m_freeList = &chunk->blocks[0];
+                m_chunks.push_back(std::move(chunk));
             }
         };
 
-        using ChunkList = std::vector<Chunk*>;
-        using Pool = std::stack<T*>;
+        /**
+         * A thread's cache of free blocks. This must be trivially destructible so that it remains usable after the
+         * cache guard has been destroyed at thread exit.
+         */
+        struct Cache {
+            Block* freeList;
+            size_t size;
+            bool flushed;
+        };
 
-        static Pool& pool() {
-            static Pool p;
-            return p;
-        }
+        /**
+         * Returns the cache's blocks to the arena when its thread exits. Afterwards, the thread allocates from and
+         * deallocates to the arena directly.
+         */
+        struct CacheGuard {
+            ~CacheGuard() {
+                Cache& c = cache();
+                if (c.freeList != nullptr) {
+                    Block* last = c.freeList;
+                    while (last->next != nullptr) {
+                        last = last->next;
+                    }
+                    arena().release(c.freeList, last);
+                }
+                c.freeList = nullptr;
+                c.size = 0;
+                c.flushed = true;
+            }
+        };
 
-        static ChunkList& fullChunks() {
-            static ChunkList chunks;
-            return chunks;
+        /**
+         * The arena is intentionally leaked so that objects can still be deallocated during static destruction.
+         */
+        static Arena& arena() {
+            static Arena* a = new Arena();
+            return *a;
         }
 
-        static ChunkList& mixedChunks() {
-            static ChunkList chunks;
-            return chunks;
+        static Cache& cache() {
+            static thread_local Cache c{nullptr, 0, false};
+            return c;
         }
 
-        static ChunkList emptyChunks() {
-            static ChunkList chunks;
-            return chunks;
+        /**
+         * Must be called before the current thread's cache first receives any blocks.
+         */
+        static void ensureCacheGuard() {
+            static thread_local CacheGuard guard;
+            (void)guard;
         }
     public:
+        /**
+         * Returns the number of bytes reserved by the arena for objects of type T, including free blocks.
+         */
+        static size_t allocatedBytes() {
+            return arena().allocatedBytes();
+        }
+
 #ifdef TB_ENABLE_ALLOCATOR
         void* operator new([[maybe_unused]] size_t size) {
             assert(size == sizeof(T));
 
-            if (!pool().empty()) {
-                T* t = pool().top();
-                pool().pop();
-                return t;
+            Cache& c = cache();
+            if (c.flushed) {
+                Block* block = nullptr;
+                arena().acquire(block, 1);
+                return block;
             }
 
-            Chunk* chunk = nullptr;
-            if (mixedChunks().empty()) {
-                if (!emptyChunks().empty()) {
-                    chunk = emptyChunks().back();
-                    emptyChunks().pop_back();
-                } else {
-                    chunk = new Chunk();
-                }
-            } else {
-                chunk = mixedChunks().back();
-                mixedChunks().pop_back();
+            if (c.freeList == nullptr) {
+                ensureCacheGuard();
+                c.size += arena().acquire(c.freeList, BatchSize);
             }
 
-            assert(!chunk->full());
-            T* block = chunk->allocate();
-
-            if (chunk->full()) {
-                fullChunks().push_back(chunk);
-            } else {
-                mixedChunks().push_back(chunk);
-            }
+            Block* block = c.freeList;
+            c.freeList = block->next;
+            --c.size;
             return block;
         }
 
-        void operator delete(void* block) {
-            T* t = reinterpret_cast<T*>(block);
+        void operator delete(void* ptr) {
+            Block* block = reinterpret_cast<Block*>(ptr);
 
-            if (PoolSize > 0 && pool().size() < PoolSize) {
-                pool().push(t);
+            Cache& c = cache();
+            if (c.flushed) {
+                arena().release(block, block);
                 return;
             }
 
-            typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
-            fullIt = fullChunks().rbegin();
-            fullEnd = fullChunks().rend();
-            mixedIt = mixedChunks().rbegin();
-            mixedEnd = mixedChunks().rend();
-
-            Chunk* chunk = nullptr;
-            while (fullIt < fullEnd || mixedIt < mixedEnd) {
-                if (fullIt < fullEnd) {
-                    Chunk* fullChunk = *fullIt;
-                    if (fullChunk->contains(t)) {
-                        chunk = fullChunk;
-                        break;
-                    }
-                    ++fullIt;
-                }
-                if (mixedIt < mixedEnd) {
-                    Chunk* mixedChunk = *mixedIt;
-                    if (mixedChunk->contains(t)) {
-                        chunk = mixedChunk;
-                        break;
-                    }
-                    ++mixedIt;
-                }
+            if (c.freeList == nullptr) {
+                ensureCacheGuard();
             }
 
-            assert(chunk != nullptr);
+            block->next = c.freeList;
+            c.freeList = block;
+            ++c.size;
 
-            if (chunk->full()) {
-                fullChunks().erase((fullIt + 1).base());
-                mixedChunks().push_back(chunk);
-            }
-
-            chunk->deallocate(t);
-
-            if (chunk->empty()) {
-                mixedChunks().erase((mixedIt + 1).base());
-                if (emptyChunks().size() < 2)
-                    emptyChunks().push_back(chunk);
-                else
-                    delete chunk;
+            if (c.size > 2u * BatchSize) {
+                // hand the most recently freed blocks back to the arena and keep the rest
+                Block* first = c.freeList;
+                Block* last = first;
+                for (size_t i = 1; i < BatchSize; ++i) {
+                    last = last->next;
+                }
+                c.freeList = last->next;
+                c.size -= BatchSize;
+                arena().release(first, last);
             }
         }
 #endif
@@ -172,6 +172,10 @@ namespace TrenchBroom {
         m_bounds(bounds),
         m_modelDefinition(modelDefinition) {}
 
+        EntityDefinition* PointEntityDefinition::clone() const {
+            return new PointEntityDefinition(name(), color(), m_bounds, description(), attributeDefinitions(), m_modelDefinition);
+        }
+
         EntityDefinitionType PointEntityDefinition::type() const {
             return EntityDefinitionType::PointEntity;
         }
@@ -184,6 +188,10 @@ namespace TrenchBroom {
             return m_modelDefinition.modelSpecification(attributes);
         }
 
+        ModelSpecification PointEntityDefinition::model(const Model::EntityAttributes& attributes, std::optional<std::vector<std::string>>& referencedAttributes) const {
+            return m_modelDefinition.modelSpecification(attributes, referencedAttributes);
+        }
+
         ModelSpecification PointEntityDefinition::defaultModel() const {
             return m_modelDefinition.defaultModelSpecification();
         }
@@ -195,6 +203,10 @@ namespace TrenchBroom {
         BrushEntityDefinition::BrushEntityDefinition(const std::string& name, const Color& color, const std::string& description, const AttributeDefinitionList& attributeDefinitions) :
         EntityDefinition(name, color, description, attributeDefinitions) {}
 
+        EntityDefinition* BrushEntityDefinition::clone() const {
+            return new BrushEntityDefinition(name(), color(), description(), attributeDefinitions());
+        }
+
         EntityDefinitionType BrushEntityDefinition::type() const {
             return EntityDefinitionType::BrushEntity;
         }
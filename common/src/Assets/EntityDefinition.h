@@ -28,6 +28,7 @@
 #include <vecmath/bbox.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -63,6 +64,12 @@ namespace TrenchBroom {
         public:
             virtual ~EntityDefinition();
 
+            /**
+             * Returns a copy of this definition with its index and usage count reset. The attribute definitions are
+             * shared with this definition.
+             */
+            virtual EntityDefinition* clone() const = 0;
+
             size_t index() const;
             void setIndex(size_t index);
 
@@ -96,9 +103,11 @@ namespace TrenchBroom {
         public:
             PointEntityDefinition(const std::string& name, const Color& color, const vm::bbox3& bounds, const std::string& description, const AttributeDefinitionList& attributeDefinitions, const ModelDefinition& modelDefinition);
 
+            EntityDefinition* clone() const override;
             EntityDefinitionType type() const override;
             const vm::bbox3& bounds() const;
             ModelSpecification model(const Model::EntityAttributes& attributes) const;
+            ModelSpecification model(const Model::EntityAttributes& attributes, std::optional<std::vector<std::string>>& referencedAttributes) const;
             ModelSpecification defaultModel() const;
             const ModelDefinition& modelDefinition() const;
         };
@@ -106,6 +115,7 @@ namespace TrenchBroom {
         class BrushEntityDefinition : public EntityDefinition {
         public:
             BrushEntityDefinition(const std::string& name, const Color& color, const std::string& description, const AttributeDefinitionList& attributeDefinitions);
+            EntityDefinition* clone() const override;
             EntityDefinitionType type() const override;
         };
     }
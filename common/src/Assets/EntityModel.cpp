@@ -25,6 +25,7 @@
 #include "Renderer/PrimType.h"
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/VertexArray.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
@@ -210,20 +211,30 @@ namespace TrenchBroom {
              *
              * @param vertices the vertices
              */
-            explicit EntityModelMesh(const std::vector<EntityModelVertex>& vertices) :
-            m_vertices(vertices) {}
+            explicit EntityModelMesh(std::vector<EntityModelVertex> vertices) :
+            m_vertices(std::move(vertices)) {}
+
+            const std::vector<EntityModelVertex>& vertices() const {
+                return m_vertices;
+            }
         public:
             virtual ~EntityModelMesh() = default;
         public:
             /**
-             * Returns a renderer that renders this mesh with the given texture.
+             * Returns a renderer that renders this mesh with the given texture. The renderer uses the vertex array of
+             * this mesh in the given map, which is created if the map does not contain one yet, so that the vertices
+             * are uploaded only once, no matter how many skins the mesh is rendered with.
              *
              * @param skin the texture to use when rendering the mesh
+             * @param vertexArrays the vertex arrays by mesh
              * @return the renderer
              */
-            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(Assets::Texture* skin) {
-                const auto vertexArray = Renderer::VertexArray::ref(m_vertices);
-                return doBuildRenderer(skin, vertexArray);
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(Assets::Texture* skin, EntityModelVertexArrays& vertexArrays) const {
+                auto& vertexArray = vertexArrays[this];
+                if (vertexArray == nullptr) {
+                    vertexArray = std::make_unique<Renderer::VertexArray>(Renderer::VertexArray::ref(m_vertices));
+                }
+                return doBuildRenderer(skin, *vertexArray);
             }
         private:
             /**
@@ -233,7 +244,7 @@ namespace TrenchBroom {
              * @param vertices the vertices associated with this mesh
              * @return the renderer
              */
-            virtual std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* skin, const Renderer::VertexArray& vertices) = 0;
+            virtual std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* skin, const Renderer::VertexArray& vertices) const = 0;
         };
 
         // EntityModel::IndexedMesh
@@ -252,15 +263,15 @@ namespace TrenchBroom {
              * @param vertices the vertices
              * @param indices the indices
              */
-            EntityModelIndexedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices) :
-            EntityModelMesh(vertices),
+            EntityModelIndexedMesh(EntityModelLoadedFrame& frame, std::vector<EntityModelVertex> vertices, const EntityModelIndices& indices) :
+            EntityModelMesh(std::move(vertices)),
             m_indices(indices) {
-                m_indices.forEachPrimitive([&frame, &vertices](const Renderer::PrimType primType, const size_t index, const size_t count) {
-                    frame.addToSpacialTree(vertices, primType, index, count);
+                m_indices.forEachPrimitive([&](const Renderer::PrimType primType, const size_t index, const size_t count) {
+                    frame.addToSpacialTree(this->vertices(), primType, index, count);
                 });
-        }
+            }
         private:
-            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* skin, const Renderer::VertexArray& vertices) override {
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* skin, const Renderer::VertexArray& vertices) const override {
                 const Renderer::TexturedIndexRangeMap texturedIndices(skin, m_indices);
                 return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertices, texturedIndices);
             }
@@ -282,15 +293,15 @@ namespace TrenchBroom {
              * @param vertices the vertices
              * @param indices the per texture indices
              */
-            EntityModelTexturedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices) :
-            EntityModelMesh(vertices),
+            EntityModelTexturedMesh(EntityModelLoadedFrame& frame, std::vector<EntityModelVertex> vertices, const EntityModelTexturedIndices& indices) :
+            EntityModelMesh(std::move(vertices)),
             m_indices(indices) {
-                m_indices.forEachPrimitive([&frame, &vertices](const Assets::Texture* /* texture */, const Renderer::PrimType primType, const size_t index, const size_t count) {
-                    frame.addToSpacialTree(vertices, primType, index, count);
+                m_indices.forEachPrimitive([&](const Assets::Texture* /* texture */, const Renderer::PrimType primType, const size_t index, const size_t count) {
+                    frame.addToSpacialTree(this->vertices(), primType, index, count);
                 });
             }
         private:
-            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* /* skin */, const Renderer::VertexArray& vertices) override {
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* /* skin */, const Renderer::VertexArray& vertices) const override {
                 return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertices, m_indices);
             }
         };
@@ -316,14 +327,14 @@ namespace TrenchBroom {
             m_skins->setTextureMode(minFilter, magFilter);
         }
 
-        void EntityModelSurface::addIndexedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices) {
+        void EntityModelSurface::addIndexedMesh(EntityModelLoadedFrame& frame, std::vector<EntityModelVertex> vertices, const EntityModelIndices& indices) {
             assert(frame.index() < frameCount());
-            m_meshes[frame.index()] = std::make_unique<EntityModelIndexedMesh>(frame, vertices, indices);
+            m_meshes[frame.index()] = std::make_unique<EntityModelIndexedMesh>(frame, std::move(vertices), indices);
         }
 
-        void EntityModelSurface::addTexturedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices) {
+        void EntityModelSurface::addTexturedMesh(EntityModelLoadedFrame& frame, std::vector<EntityModelVertex> vertices, const EntityModelTexturedIndices& indices) {
             assert(frame.index() < frameCount());
-            m_meshes[frame.index()] = std::make_unique<EntityModelTexturedMesh>(frame, vertices, indices);
+            m_meshes[frame.index()] = std::make_unique<EntityModelTexturedMesh>(frame, std::move(vertices), indices);
         }
 
         void EntityModelSurface::addSkin(Assets::Texture* skin) {
@@ -351,13 +362,13 @@ namespace TrenchBroom {
             }
         }
 
-        std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildRenderer(size_t skinIndex, size_t frameIndex) {
+        std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildRenderer(size_t skinIndex, size_t frameIndex, EntityModelVertexArrays& vertexArrays) {
             if (skinIndex >= skinCount() || frameIndex >= frameCount() || m_meshes[frameIndex] == nullptr) {
                 return nullptr;
             } else {
                 const auto& textures = m_skins->textures();
                 auto* skin = textures[skinIndex];
-                return m_meshes[frameIndex]->buildRenderer(skin);
+                return m_meshes[frameIndex]->buildRenderer(skin, vertexArrays);
             }
         }
 
@@ -367,10 +378,10 @@ namespace TrenchBroom {
         m_name(name),
         m_prepared(false) {}
 
-        std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(const size_t skinIndex, const size_t frameIndex) const {
+        std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(const size_t skinIndex, const size_t frameIndex, EntityModelVertexArrays& vertexArrays) const {
             std::vector<std::unique_ptr<Renderer::TexturedIndexRangeRenderer>> renderers;
             for (const auto& surface : m_surfaces) {
-                auto renderer = surface->buildRenderer(skinIndex, frameIndex);
+                auto renderer = surface->buildRenderer(skinIndex, frameIndex, vertexArrays);
                 if (renderer != nullptr) {
                     renderers.push_back(std::move(renderer));
                 }
@@ -141,7 +141,6 @@ namespace TrenchBroom {
         class EntityModelUnloadedFrame;
 
 
-        class EntityModelMesh;
         class EntityModelIndexedMesh;
         class EntityModelTexturedMesh;
 
@@ -192,22 +191,23 @@ namespace TrenchBroom {
             void setTextureMode(int minFilter, int magFilter);
 
             /**
-             * Adds a new mesh to this surface.
+             * Adds a new mesh to this surface. The vertices are kept as they are and uploaded to the GPU from the
+             * mesh, so callers should move them in to avoid holding a second copy.
              *
              * @param frame the frame which the mesh belongs to
              * @param vertices the mesh vertices
              * @param indices the vertex indices
              */
-            void addIndexedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices);
+            void addIndexedMesh(EntityModelLoadedFrame& frame, std::vector<EntityModelVertex> vertices, const EntityModelIndices& indices);
 
             /**
-             * Adds a new multitextured mesh to this surface.
+             * Adds a new multitextured mesh to this surface. The vertices are kept as they are, see addIndexedMesh().
              *
              * @param frame the frame which the mesh belongs to
              * @param vertices the mesh vertices
              * @param indices the per texture vertex indices
              */
-            void addTexturedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices);
+            void addTexturedMesh(EntityModelLoadedFrame& frame, std::vector<EntityModelVertex> vertices, const EntityModelTexturedIndices& indices);
 
             /**
              * Adds the given texture as a skin to this surface.
@@ -246,7 +246,15 @@ namespace TrenchBroom {
              */
             Texture* skin(size_t index) const;
 
-            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(size_t skinIndex, size_t frameIndex);
+            /**
+             * Creates a renderer to render the given frame of this surface using the skin with the given index.
+             *
+             * @param skinIndex the index of the skin to use
+             * @param frameIndex the index of the frame to render
+             * @param vertexArrays the vertex arrays of the meshes that the caller has already rendered
+             * @return the renderer or null if the skin or the frame does not exist
+             */
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(size_t skinIndex, size_t frameIndex, EntityModelVertexArrays& vertexArrays);
         };
 
         /**
@@ -271,11 +279,16 @@ namespace TrenchBroom {
             /**
              * Creates a renderer to render the given frame of the model using the skin with the given index.
              *
+             * A model only holds the vertices of its meshes, since it may be shared between documents that allocate
+             * their vertex buffers separately. The vertex arrays that upload the vertices are kept by the caller in
+             * the given map, one per mesh, so that the renderers of the same frame share them regardless of the skin.
+             *
              * @param skinIndex the index of the skin to use
              * @param frameIndex the index of the frame to render
+             * @param vertexArrays the vertex arrays of the meshes that the caller has already rendered
              * @return the renderer
              */
-            std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(size_t skinIndex, size_t frameIndex) const;
+            std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(size_t skinIndex, size_t frameIndex, EntityModelVertexArrays& vertexArrays) const;
 
             /**
              * Returns the bounds of the given frame of this model.
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelCache.h"
+
+#include "Assets/EntityModel.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Assets {
+        EntityModelCache& EntityModelCache::instance() {
+            static EntityModelCache instance;
+            return instance;
+        }
+
+        EntityModelCache::EntityModelCache() :
+        m_purgeThreshold(64u) {}
+
+        std::shared_ptr<EntityModel> EntityModelCache::model(const std::string& loaderKey, const IO::Path& path) const {
+            const auto it = m_models.find(Key(loaderKey, path));
+            if (it == std::end(m_models)) {
+                return nullptr;
+            }
+            return it->second.lock();
+        }
+
+        std::shared_ptr<EntityModel> EntityModelCache::insert(const std::string& loaderKey, const IO::Path& path, std::unique_ptr<EntityModel> model) {
+            removeExpiredModels();
+
+            auto& entry = m_models[Key(loaderKey, path)];
+            if (auto existing = entry.lock()) {
+                return existing;
+            }
+
+            auto result = std::shared_ptr<EntityModel>(std::move(model));
+            entry = result;
+            return result;
+        }
+
+        void EntityModelCache::removeExpiredModels() {
+            if (m_models.size() < m_purgeThreshold) {
+                return;
+            }
+
+            for (auto it = std::begin(m_models); it != std::end(m_models); ) {
+                if (it->second.expired()) {
+                    it = m_models.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            m_purgeThreshold = std::max(size_t(64u), 2u * m_models.size());
+        }
+    }
+}
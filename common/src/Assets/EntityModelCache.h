@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_EntityModelCache
+#define TrenchBroom_EntityModelCache
+
+#include "IO/Path.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class EntityModel;
+
+        /**
+         * Shares entity models between all open documents.
+         *
+         * Models are keyed by a loader key, which identifies the game, game path and mods a document loads its
+         * models from, and by the model path. The cache only holds weak references, so a model is destroyed once no
+         * entity model manager uses it anymore. Since all OpenGL contexts share their resources, a model that has
+         * been prepared by one document can be rendered by all others.
+         *
+         * The cache must only be accessed from the main thread.
+         */
+        class EntityModelCache {
+        private:
+            using Key = std::pair<std::string, IO::Path>;
+            std::map<Key, std::weak_ptr<EntityModel>> m_models;
+            // the number of entries at which expired entries are removed
+            size_t m_purgeThreshold;
+        public:
+            static EntityModelCache& instance();
+
+            /**
+             * Returns the model with the given path that was loaded using the given loader key, or null if no such
+             * model is in use.
+             */
+            std::shared_ptr<EntityModel> model(const std::string& loaderKey, const IO::Path& path) const;
+
+            /**
+             * Adds the given model to the cache and returns a shared reference to it. If the cache already contains a
+             * model for the given key and path, that model is returned and the given model is discarded.
+             */
+            std::shared_ptr<EntityModel> insert(const std::string& loaderKey, const IO::Path& path, std::unique_ptr<EntityModel> model);
+        private:
+            EntityModelCache();
+            void removeExpiredModels();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityModelCache) */
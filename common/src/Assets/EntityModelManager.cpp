@@ -19,17 +19,66 @@
 
 #include "EntityModelManager.h"
 
+#include "Ensure.h"
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Macros.h"
+#include "Profiler.h"
 #include "Assets/EntityModel.h"
+#include "Assets/EntityModelCache.h"
 #include "Assets/ModelDefinition.h"
 #include "IO/EntityModelLoader.h"
 #include "Model/Entity.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/VertexArray.h"
+
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <utility>
+
+#include <QString>
 
 namespace TrenchBroom {
     namespace Assets {
+        namespace {
+            /**
+             * Collects the messages logged while a model is loaded on a worker thread, so that they can be logged by
+             * the calling thread afterwards.
+             */
+            class CollectingLogger : public Logger {
+            private:
+                std::vector<std::pair<LogLevel, std::string>> m_messages;
+            public:
+                std::vector<std::pair<LogLevel, std::string>> releaseMessages() {
+                    return std::move(m_messages);
+                }
+            private:
+                void doLog(const LogLevel level, const std::string& message) override {
+                    m_messages.emplace_back(level, message);
+                }
+
+                void doLog(const LogLevel level, const QString& message) override {
+                    m_messages.emplace_back(level, message.toStdString());
+                }
+            };
+
+            struct ModelLoadTask {
+                IO::Path path;
+                std::vector<size_t> frameIndices;
+                // the model if it has already been loaded
+                EntityModel* model = nullptr;
+            };
+
+            struct ModelLoadResult {
+                std::unique_ptr<EntityModel> model;
+                // set if the model is invalid and should not be loaded again
+                std::string error;
+                std::vector<std::pair<LogLevel, std::string>> messages;
+            };
+        }
+
         EntityModelManager::EntityModelManager(const int magFilter, const int minFilter, Logger& logger) :
         m_logger(logger),
         m_loader(nullptr),
@@ -43,6 +92,7 @@ namespace TrenchBroom {
 
         void EntityModelManager::clear() {
             m_renderers.clear();
+            m_vertexArrays.clear();
             m_models.clear();
             m_rendererMismatches.clear();
             m_modelMismatches.clear();
@@ -64,6 +114,10 @@ namespace TrenchBroom {
             m_loader = loader;
         }
 
+        void EntityModelManager::setCacheKey(const std::string& cacheKey) {
+            m_cacheKey = cacheKey;
+        }
+
         Renderer::TexturedRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec) const {
             auto* entityModel = safeGetModel(spec.path);
 
@@ -80,7 +134,12 @@ namespace TrenchBroom {
                 return nullptr;
             }
 
-            auto renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex);
+            // a frame that was not requested through frame() or loadModels() must be loaded before its mesh exists
+            if (spec.frameIndex < entityModel->frameCount() && !entityModel->frame(spec.frameIndex)->loaded()) {
+                loadFrame(spec, *entityModel);
+            }
+
+            auto renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex, m_vertexArrays);
             if (renderer != nullptr) {
                 const auto [pos, success] = m_renderers.insert({ spec, std::move(renderer) });
                 assert(success); unused(success);
@@ -110,6 +169,77 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelManager::loadModels(const std::vector<ModelSpecification>& specs) const {
+            ensure(m_loader != nullptr, "loader is null");
+
+            // specs are ordered by path first, so all frames of a model are adjacent
+            auto sortedSpecs = specs;
+            kdl::vec_sort_and_remove_duplicates(sortedSpecs);
+
+            auto tasks = std::vector<ModelLoadTask>();
+            for (const auto& spec : sortedSpecs) {
+                if (spec.path.isEmpty() || m_modelMismatches.count(spec.path) > 0) {
+                    continue;
+                }
+
+                if (tasks.empty() || tasks.back().path != spec.path) {
+                    auto it = m_models.find(spec.path);
+                    auto* model = it != std::end(m_models) ? it->second.get() : cachedModel(spec.path);
+                    tasks.push_back(ModelLoadTask{spec.path, {}, model});
+                }
+                tasks.back().frameIndices.push_back(spec.frameIndex);
+            }
+
+            // Every task initializes and loads the frames of a different model, so the tasks do not share any state
+            // except for the loader.
+            auto results = kdl::vec_parallel_transform(tasks, [&](const auto& task) {
+                auto result = ModelLoadResult();
+                auto logger = CollectingLogger();
+
+                auto* model = task.model;
+                if (model == nullptr) {
+                    try {
+                        result.model = m_loader->initializeModel(task.path, logger);
+                        model = result.model.get();
+                    } catch (const GameException& e) {
+                        result.error = e.what();
+                    } catch (const Exception&) {
+                        // model() will try again and report the error
+                    }
+                }
+
+                if (model != nullptr) {
+                    for (const auto frameIndex : task.frameIndices) {
+                        if (frameIndex < model->frameCount() && !model->frame(frameIndex)->loaded()) {
+                            try {
+                                m_loader->loadFrame(task.path, frameIndex, *model, logger);
+                            } catch (const Exception& e) {
+                                logger.error() << "Could not load entity model frame " << ModelSpecification(task.path, 0, frameIndex) << ": " << e.what();
+                            }
+                        }
+                    }
+                }
+
+                result.messages = logger.releaseMessages();
+                return result;
+            });
+
+            for (size_t i = 0u; i < tasks.size(); ++i) {
+                auto& result = results[i];
+                for (const auto& [level, message] : result.messages) {
+                    m_logger.log(level, message);
+                }
+
+                if (result.model != nullptr) {
+                    addModel(tasks[i].path, std::move(result.model));
+                    m_logger.debug() << "Loaded entity model " << tasks[i].path;
+                } else if (!result.error.empty()) {
+                    m_logger.error() << result.error;
+                    m_modelMismatches.insert(tasks[i].path);
+                }
+            }
+        }
+
         EntityModel* EntityModelManager::model(const IO::Path& path) const {
             if (path.isEmpty()) {
                 return nullptr;
@@ -124,13 +254,12 @@ namespace TrenchBroom {
                 return nullptr;
             }
 
-            try {
-                const auto [pos, success] = m_models.insert({ path, loadModel(path) });
-                assert(success); unused(success);
-
-                auto* model = pos->second.get();
-                m_unpreparedModels.push_back(model);
+            if (auto* model = cachedModel(path)) {
+                return model;
+            }
 
+            try {
+                auto* model = addModel(path, loadModel(path));
                 m_logger.debug() << "Loaded entity model " << path;
 
                 return model;
@@ -149,6 +278,36 @@ namespace TrenchBroom {
             }
         }
 
+        EntityModel* EntityModelManager::cachedModel(const IO::Path& path) const {
+            if (m_cacheKey.empty()) {
+                return nullptr;
+            }
+
+            auto model = EntityModelCache::instance().model(m_cacheKey, path);
+            if (model == nullptr) {
+                return nullptr;
+            }
+
+            // the model may have been prepared by another document already, in which case preparing it does nothing
+            auto* result = model.get();
+            m_models.emplace(path, std::move(model));
+            m_unpreparedModels.push_back(result);
+            return result;
+        }
+
+        EntityModel* EntityModelManager::addModel(const IO::Path& path, std::unique_ptr<EntityModel> model) const {
+            auto sharedModel = m_cacheKey.empty()
+                ? std::shared_ptr<EntityModel>(std::move(model))
+                : EntityModelCache::instance().insert(m_cacheKey, path, std::move(model));
+
+            const auto [pos, success] = m_models.emplace(path, std::move(sharedModel));
+            assert(success); unused(success);
+
+            auto* result = pos->second.get();
+            m_unpreparedModels.push_back(result);
+            return result;
+        }
+
         std::unique_ptr<EntityModel> EntityModelManager::loadModel(const IO::Path& path) const {
             ensure(m_loader != nullptr, "loader is null");
             return m_loader->initializeModel(path, m_logger);
@@ -165,6 +324,8 @@ namespace TrenchBroom {
         }
 
         void EntityModelManager::prepare(Renderer::VboManager& vboManager) {
+            TB_PROFILE_ZONE("EntityModelManager::prepare");
+
             resetTextureMode();
             prepareModels();
             prepareRenderers(vboManager);
@@ -20,12 +20,14 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Assets/EntityModel_Forward.h"
 #include "IO/Path.h"
 
 #include <kdl/vector_set.h>
 
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -51,7 +53,7 @@ namespace TrenchBroom {
 
         class EntityModelManager {
         private:
-            using ModelCache = std::map<IO::Path, std::unique_ptr<EntityModel>>;
+            using ModelCache = std::map<IO::Path, std::shared_ptr<EntityModel>>;
             using ModelMismatches = kdl::vector_set<IO::Path>;
             using ModelList = std::vector<EntityModel*>;
 
@@ -61,6 +63,8 @@ namespace TrenchBroom {
 
             Logger& m_logger;
             const IO::EntityModelLoader* m_loader;
+            // identifies the models of the current loader in the entity model cache, empty if models are not shared
+            std::string m_cacheKey;
 
             int m_minFilter;
             int m_magFilter;
@@ -70,6 +74,8 @@ namespace TrenchBroom {
             mutable ModelMismatches m_modelMismatches;
             mutable RendererCache m_renderers;
             mutable RendererMismatches m_rendererMismatches;
+            // the models may be shared with other documents, but their vertex buffers belong to this document
+            mutable EntityModelVertexArrays m_vertexArrays;
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
@@ -81,12 +87,41 @@ namespace TrenchBroom {
 
             void setTextureMode(int minFilter, int magFilter);
             void setLoader(const IO::EntityModelLoader* loader);
+
+            /**
+             * Sets the key under which the loaded models are shared with other entity model managers through the
+             * entity model cache. The key must identify everything that determines which file a model path resolves
+             * to, such as the game, the game path and the mods. If the key is empty, models are not shared.
+             *
+             * @see EntityModelCache
+             */
+            void setCacheKey(const std::string& cacheKey);
+            /**
+             * Returns the renderer for the given model specification. Renderers of the same frame share its vertices,
+             * regardless of their skin. If the frame has not been loaded yet, it is loaded first.
+             *
+             * @param spec the model specification
+             * @return the renderer or null if the model, its skin or its frame could not be loaded
+             */
             Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
             const EntityModelFrame* frame(const ModelSpecification& spec) const;
+
+            /**
+             * Loads the models and frames referenced by the given specifications that have not been loaded yet. The
+             * models are loaded on several threads, one model per task, so the loader must support that. Afterwards,
+             * calling frame() or renderer() for these specifications does not load anything.
+             *
+             * Models that fail to load are treated as if they had been requested through model().
+             *
+             * @param specs the model specifications
+             */
+            void loadModels(const std::vector<ModelSpecification>& specs) const;
         private:
             EntityModel* model(const IO::Path& path) const;
             EntityModel* safeGetModel(const IO::Path& path) const;
+            EntityModel* cachedModel(const IO::Path& path) const;
+            EntityModel* addModel(const IO::Path& path, std::unique_ptr<EntityModel> model) const;
             std::unique_ptr<EntityModel> loadModel(const IO::Path& path) const;
             void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
         public:
@@ -22,20 +22,26 @@
 
 #include "Renderer/GLVertexType.h"
 
+#include <memory>
+#include <unordered_map>
+
 namespace TrenchBroom {
     namespace Renderer {
         class IndexRangeMap;
         class TexturedIndexRangeMap;
+        class VertexArray;
     }
 
     namespace Assets {
         class EntityModel;
         class EntityModelLoadedFrame;
+        class EntityModelMesh;
         class EntityModelSurface;
 
         using EntityModelVertex = Renderer::GLVertexTypes::P3T2::Vertex;
         using EntityModelIndices = Renderer::IndexRangeMap;
         using EntityModelTexturedIndices = Renderer::TexturedIndexRangeMap;
+        using EntityModelVertexArrays = std::unordered_map<const EntityModelMesh*, std::unique_ptr<Renderer::VertexArray>>;
     }
 }
 
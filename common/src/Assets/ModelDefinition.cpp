@@ -19,9 +19,11 @@
 
 #include "ModelDefinition.h"
 
+#include "EL/ELExceptions.h"
 #include "EL/EvaluationContext.h"
 #include "EL/Types.h"
 #include "EL/Value.h"
+#include "EL/VariableStore.h"
 #include "Model/EntityAttributesVariableStore.h"
 
 #include <kdl/string_compare.h>
@@ -29,6 +31,8 @@
 #include <vecmath/scalar.h>
 
 #include <ostream>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -83,13 +87,19 @@ namespace TrenchBroom {
         }
 
         ModelDefinition::ModelDefinition() :
-        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, 0, 0)) {}
+        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, 0, 0)) {
+            updateConstantSpecification();
+        }
 
         ModelDefinition::ModelDefinition(const size_t line, const size_t column) :
-        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, line, column)) {}
+        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, line, column)) {
+            updateConstantSpecification();
+        }
 
         ModelDefinition::ModelDefinition(const EL::Expression& expression) :
-        m_expression(expression) {}
+        m_expression(expression) {
+            updateConstantSpecification();
+        }
 
         void ModelDefinition::append(const ModelDefinition& other) {
             EL::ExpressionBase::List cases;
@@ -99,20 +109,61 @@ namespace TrenchBroom {
             const size_t line = m_expression.line();
             const size_t column = m_expression.column();
             m_expression = EL::SwitchOperator::create(std::move(cases), line, column);
+            updateConstantSpecification();
         }
 
         ModelSpecification ModelDefinition::modelSpecification(const Model::EntityAttributes& attributes) const {
+            if (m_constantSpecification) {
+                return *m_constantSpecification;
+            }
+
             const Model::EntityAttributesVariableStore store(attributes);
             const EL::EvaluationContext context(store);
             return convertToModel(m_expression.evaluate(context));
         }
 
+        ModelSpecification ModelDefinition::modelSpecification(const Model::EntityAttributes& attributes, std::optional<std::vector<std::string>>& referencedAttributes) const {
+            if (m_constantSpecification) {
+                referencedAttributes = std::vector<std::string>();
+                return *m_constantSpecification;
+            }
+
+            const EL::RecordingVariableStore store{Model::EntityAttributesVariableStore(attributes)};
+            const EL::EvaluationContext context(store);
+            auto result = convertToModel(m_expression.evaluate(context));
+
+            if (store.recordedAllNames()) {
+                referencedAttributes = std::nullopt;
+            } else {
+                referencedAttributes = store.recordedNames();
+            }
+            return result;
+        }
+
         ModelSpecification ModelDefinition::defaultModelSpecification() const {
+            if (m_constantSpecification) {
+                return *m_constantSpecification;
+            }
+
             const EL::NullVariableStore store;
             const EL::EvaluationContext context(store);
             return convertToModel(m_expression.evaluate(context));
         }
 
+        void ModelDefinition::updateConstantSpecification() {
+            m_constantSpecification = std::nullopt;
+            try {
+                const EL::RecordingVariableStore store{EL::NullVariableStore()};
+                const EL::EvaluationContext context(store);
+                const auto value = m_expression.evaluate(context);
+                if (store.recordedNames().empty() && !store.recordedAllNames()) {
+                    m_constantSpecification = convertToModel(value);
+                }
+            } catch (const EL::Exception&) {
+                // evaluate the expression every time so that the error is reported to the caller
+            }
+        }
+
         ModelSpecification ModelDefinition::convertToModel(const EL::Value& value) const {
             switch (value.type()) {
                 case EL::ValueType::Map:
@@ -24,6 +24,9 @@
 #include "IO/Path.h"
 
 #include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -53,6 +56,11 @@ namespace TrenchBroom {
         class ModelDefinition {
         private:
             EL::Expression m_expression;
+            /**
+             * The result of the expression if it does not depend on any variables, in which case it need not be
+             * evaluated for every entity.
+             */
+            std::optional<ModelSpecification> m_constantSpecification;
         public:
             ModelDefinition();
             ModelDefinition(size_t line, size_t column);
@@ -70,6 +78,19 @@ namespace TrenchBroom {
              */
             ModelSpecification modelSpecification(const Model::EntityAttributes& attributes) const;
 
+            /**
+             * Evaluates the model expression like the above, and reports which entity attributes the result depends
+             * on. As long as these attributes do not change, evaluating the expression again yields the same result.
+             *
+             * @param attributes the entity attributes to use when interpolating variables
+             * @param referencedAttributes set to the names of the attributes that the expression read, or to an empty
+             * optional if the result may depend on any attribute
+             * @return the model specification
+             *
+             * @throws EL::Exception if the expression could not be evaluated
+             */
+            ModelSpecification modelSpecification(const Model::EntityAttributes& attributes, std::optional<std::vector<std::string>>& referencedAttributes) const;
+
             /**
              * Evaluates the model expresion.
              *
@@ -79,6 +100,7 @@ namespace TrenchBroom {
              */
             ModelSpecification defaultModelSpecification() const;
         private:
+            void updateConstantSpecification();
             ModelSpecification convertToModel(const EL::Value& value) const;
             IO::Path path(const EL::Value& value) const;
             size_t index(const EL::Value& value) const;
@@ -33,6 +33,18 @@ namespace TrenchBroom {
         Palette::Data::Data(std::vector<unsigned char>&& data) :
         m_data(std::move(data)) {
             ensure(!m_data.empty(), "palette is empty");
+
+            // indices beyond the end of a short palette are black
+            for (size_t index = 0; index < 256; ++index) {
+                for (size_t j = 0; j < 3; ++j) {
+                    const auto offset = index * 3 + j;
+                    const auto c = offset < m_data.size() ? m_data[offset] : static_cast<unsigned char>(0);
+                    m_opaqueRgba[index * 4 + j] = c;
+                    m_index255TransparentRgba[index * 4 + j] = c;
+                }
+                m_opaqueRgba[index * 4 + 3] = 0xFF;
+                m_index255TransparentRgba[index * 4 + 3] = index == 255 ? 0x00 : 0xFF;
+            }
         }
 
         Palette::Palette() {}
@@ -23,7 +23,8 @@
 #include "Color.h"
 #include "IO/Reader.h"
 
-#include <cassert>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -43,6 +44,13 @@ namespace TrenchBroom {
             class Data {
             private:
                 std::vector<unsigned char> m_data;
+
+                /**
+                 * The RGBA value of every palette index, once with all indices opaque and once with index 255
+                 * transparent, so that converting a pixel is a single table lookup.
+                 */
+                std::array<unsigned char, 256 * 4> m_opaqueRgba;
+                std::array<unsigned char, 256 * 4> m_index255TransparentRgba;
             public:
                 Data(std::vector<unsigned char>&& data);
 
@@ -79,34 +87,35 @@ namespace TrenchBroom {
                  */
                 template <typename ColorT>
                 bool indexedToRgba(IO::Reader& reader, const size_t pixelCount, std::vector<ColorT>& rgbaImage, const PaletteTransparency transparency, Color& averageColor) const {
-                    double avg[3];
-                    avg[0] = avg[1] = avg[2] = 0.0;
-                    bool hasTransparency = false;
+                    auto indices = std::vector<unsigned char>(pixelCount);
+                    reader.read(indices.data(), pixelCount);
+
+                    const auto& table = transparency == PaletteTransparency::Opaque ? m_opaqueRgba : m_index255TransparentRgba;
+
+                    // the average color is computed from a histogram of the indices so that the loop over the pixels
+                    // only does table lookups and integer increments
+                    std::array<size_t, 256> histogram{};
                     for (size_t i = 0; i < pixelCount; ++i) {
-                        const size_t index = reader.readSize<unsigned char>();
-                        assert(index < m_data.size());
-                        for (size_t j = 0; j < 3; ++j) {
-                            const unsigned char c = m_data[index * 3 + j];
-                            rgbaImage[i * 4 + j] = c;
-                            avg[j] += static_cast<double>(c);
+                        const size_t index = indices[i];
+                        ++histogram[index];
+                        for (size_t j = 0; j < 4; ++j) {
+                            rgbaImage[i * 4 + j] = static_cast<ColorT>(table[index * 4 + j]);
                         }
-                        switch (transparency) {
-                            case PaletteTransparency::Opaque:
-                                rgbaImage[i * 4 + 3] = 0xFF;
-                                break;
-                            case PaletteTransparency::Index255Transparent:
-                                rgbaImage[i * 4 + 3] = static_cast<ColorT>((index == 255) ? 0x00 : 0xFF);
-                                hasTransparency |= (index == 255);
-                                break;
+                    }
+
+                    uint64_t sum[3] = { 0u, 0u, 0u };
+                    for (size_t index = 0; index < 256; ++index) {
+                        for (size_t j = 0; j < 3; ++j) {
+                            sum[j] += static_cast<uint64_t>(histogram[index]) * table[index * 4 + j];
                         }
                     }
 
                     for (size_t i = 0; i < 3; ++i) {
-                        averageColor[i] = static_cast<float>(avg[i] / static_cast<double>(pixelCount) / static_cast<double>(0xFF));
+                        averageColor[i] = static_cast<float>(static_cast<double>(sum[i]) / static_cast<double>(pixelCount) / static_cast<double>(0xFF));
                     }
                     averageColor[3] = 1.0f;
 
-                    return hasTransparency;
+                    return transparency == PaletteTransparency::Index255Transparent && histogram[255] > 0u;
                 }
             };
 
@@ -24,9 +24,18 @@
 
 #include <algorithm> // for std::max
 #include <cassert>
+#include <mutex>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Assets {
+        namespace {
+            /**
+             * The usage count changes recorded on this thread, or null if usage counts are changed directly.
+             */
+            thread_local std::unordered_map<Texture*, int>* recordedUsageCountChanges = nullptr;
+        }
+
         Texture::Texture(const std::string& name, const size_t width, const size_t height, const Color& averageColor, Buffer&& buffer, const GLenum format, const TextureType type) :
         m_collection(nullptr),
         m_name(name),
@@ -37,9 +46,16 @@ namespace TrenchBroom {
         m_overridden(false),
         m_format(format),
         m_type(type),
+        m_surfaceParmMask(0),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {
+        m_textureId(0),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_compressed(false),
+        m_maxSize(0u),
+        m_uploadedBytes(0) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * bytesPerPixelForFormat(format));
@@ -56,9 +72,16 @@ namespace TrenchBroom {
         m_overridden(false),
         m_format(format),
         m_type(type),
+        m_surfaceParmMask(0),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId(0),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_compressed(false),
+        m_maxSize(0u),
+        m_uploadedBytes(0),
         m_buffers(std::move(buffers)) {
             assert(m_width > 0);
             assert(m_height > 0);
@@ -82,15 +105,51 @@ namespace TrenchBroom {
         m_overridden(false),
         m_format(format),
         m_type(type),
+        m_surfaceParmMask(0),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {}
+        m_textureId(0),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_compressed(false),
+        m_maxSize(0u),
+        m_uploadedBytes(0) {}
+
+        Texture::Texture(const std::string& name, const size_t width, const size_t height, Loader loader) :
+        m_collection(nullptr),
+        m_name(name),
+        m_width(width),
+        m_height(height),
+        m_averageColor(Color(0.0f, 0.0f, 0.0f, 1.0f)),
+        m_usageCount(0),
+        m_overridden(false),
+        m_format(GL_RGBA),
+        m_type(TextureType::Opaque),
+        m_surfaceParmMask(0),
+        m_culling(TextureCulling::CullDefault),
+        m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
+        m_textureId(0),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_compressed(false),
+        m_maxSize(0u),
+        m_uploadedBytes(0),
+        m_loader(std::move(loader)) {
+            assert(m_width > 0);
+            assert(m_height > 0);
+            assert(m_loader);
+        }
 
         Texture::~Texture() {
             if (m_collection == nullptr && m_textureId != 0) {
                 glAssert(glDeleteTextures(1, &m_textureId));
+            } else if (m_collection == nullptr && m_pendingTextureId != 0) {
+                glAssert(glDeleteTextures(1, &m_pendingTextureId));
             }
             m_textureId = 0;
+            m_pendingTextureId = 0;
         }
 
         TextureType Texture::selectTextureType(const bool masked) {
@@ -118,14 +177,17 @@ namespace TrenchBroom {
         }
 
         const Color& Texture::averageColor() const {
+            load();
             return m_averageColor;
         }
 
         bool Texture::masked() const {
+            load();
             return m_type == TextureType::Masked;
         }
     
         void Texture::setOpaque() {
+            load();
             m_type = TextureType::Opaque;
         }
     
@@ -135,6 +197,31 @@ namespace TrenchBroom {
 
         void Texture::setSurfaceParms(const std::set<std::string>& surfaceParms) {
             m_surfaceParms = surfaceParms;
+            m_surfaceParmMask = 0;
+            for (const auto& surfaceParm : m_surfaceParms) {
+                m_surfaceParmMask |= surfaceParmBit(surfaceParm);
+            }
+        }
+
+        uint64_t Texture::surfaceParmBit(const std::string& surfaceParm) {
+            // textures may be loaded concurrently
+            static std::mutex mutex;
+            static std::unordered_map<std::string, uint64_t> bits;
+
+            const std::lock_guard<std::mutex> lock(mutex);
+            const auto it = bits.find(surfaceParm);
+            if (it != std::end(bits)) {
+                return it->second;
+            }
+
+            const auto bitCount = sizeof(uint64_t) * 8u;
+            const uint64_t bit = bits.size() < bitCount ? uint64_t(1) << bits.size() : 0;
+            bits.emplace(surfaceParm, bit);
+            return bit;
+        }
+
+        uint64_t Texture::surfaceParmMask() const {
+            return m_surfaceParmMask;
         }
 
         TextureCulling Texture::culling() const {
@@ -160,6 +247,11 @@ namespace TrenchBroom {
         }
 
         void Texture::incUsageCount() {
+            if (recordedUsageCountChanges != nullptr) {
+                ++(*recordedUsageCountChanges)[this];
+                return;
+            }
+
             ++m_usageCount;
             if (m_collection != nullptr) {
                 m_collection->incUsageCount();
@@ -167,6 +259,11 @@ namespace TrenchBroom {
         }
 
         void Texture::decUsageCount() {
+            if (recordedUsageCountChanges != nullptr) {
+                --(*recordedUsageCountChanges)[this];
+                return;
+            }
+
             assert(m_usageCount > 0);
             --m_usageCount;
             if (m_collection != nullptr) {
@@ -182,60 +279,154 @@ namespace TrenchBroom {
             m_overridden = overridden;
         }
 
+        bool Texture::isLoaded() const {
+            return !m_loader;
+        }
+
         bool Texture::isPrepared() const {
+            return m_textureId != 0 || m_pendingTextureId != 0;
+        }
+
+        bool Texture::isUploaded() const {
             return m_textureId != 0;
         }
 
-        void Texture::prepare(const GLuint textureId, const int minFilter, const int magFilter) {
+        size_t Texture::uploadedBytes() const {
+            return m_uploadedBytes;
+        }
+
+        void Texture::prepare(const GLuint textureId, const int minFilter, const int magFilter, const bool compressed, const size_t maxSize) {
             assert(textureId > 0);
+            assert(!isPrepared());
+
+            // The texture data is uploaded when the texture is first activated, so that textures which are never
+            // rendered do not occupy any video memory.
+            if (!m_buffers.empty() || !isLoaded()) {
+                m_pendingTextureId = textureId;
+                m_minFilter = minFilter;
+                m_magFilter = magFilter;
+                m_compressed = compressed;
+                m_maxSize = maxSize;
+            }
+        }
+
+        void Texture::load() const {
+            if (isLoaded()) {
+                return;
+            }
+
+            auto loader = std::move(m_loader);
+            m_loader = nullptr;
+
+            auto texture = loader();
+            if (texture != nullptr && texture->width() == m_width && texture->height() == m_height && !texture->m_buffers.empty()) {
+                m_averageColor = texture->m_averageColor;
+                m_format = texture->m_format;
+                m_type = texture->m_type;
+                m_buffers = std::move(texture->m_buffers);
+            } else {
+                // the texture could not be decoded, or its file was changed after its size was read
+                m_averageColor = Color(0.0f, 0.0f, 0.0f, 1.0f);
+                m_format = GL_RGBA;
+                m_type = TextureType::Opaque;
+                m_buffers = BufferList{Buffer(4u * m_width * m_height, 0u)};
+            }
+        }
+
+        void Texture::upload() const {
+            assert(m_pendingTextureId != 0);
             assert(m_textureId == 0);
 
-            if (!m_buffers.empty()) {
-                glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
-                glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
-                glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            load();
+
+            const auto textureId = m_pendingTextureId;
+            const auto minFilter = m_minFilter;
+            const auto magFilter = m_magFilter;
+
+            glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+            glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+            glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+            glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+
+            if (m_type == TextureType::Masked) {
+                // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            } else if (m_buffers.size() == 1) {
+                // generate mipmaps if we don't have any
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
+            } else {
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
+            }
 
-                glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+            // Upload only the first mipmap for masked textures.
+            const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
 
-                if (m_type == TextureType::Masked) {
-                    // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-                } else if (m_buffers.size() == 1) {
-                    // generate mipmaps if we don't have any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
-                } else {
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
+            // Skip the mip levels that are larger than the maximum size. The texture keeps its size, so texture
+            // coordinates are unaffected, but the skipped levels do not occupy any video memory.
+            size_t baseLevel = 0u;
+            if (m_maxSize > 0u) {
+                while (baseLevel + 1u < mipmapsToUpload) {
+                    const auto mipSize = sizeAtMipLevel(m_width, m_height, baseLevel);
+                    if (std::max(mipSize.x(), mipSize.y()) <= m_maxSize) {
+                        break;
+                    }
+                    ++baseLevel;
                 }
+            }
+            if (baseLevel > 0u) {
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(baseLevel)));
+            }
 
-                // Upload only the first mipmap for masked textures.
-                const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+            // Let the driver choose a compressed format (usually S3TC / BCn) if requested; this uses a fraction of
+            // the video memory of GL_RGBA.
+            const auto internalFormat = m_compressed ? GL_COMPRESSED_RGBA : GL_RGBA;
 
-                for (size_t j = 0; j < mipmapsToUpload; ++j) {
-                    const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+            for (size_t j = baseLevel; j < mipmapsToUpload; ++j) {
+                const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
 
-                    const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
-                    glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
-                                          static_cast<GLsizei>(mipSize.x()),
-                                          static_cast<GLsizei>(mipSize.y()),
-                                          0, m_format, GL_UNSIGNED_BYTE, data));
+                const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
+                glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), internalFormat,
+                                      static_cast<GLsizei>(mipSize.x()),
+                                      static_cast<GLsizei>(mipSize.y()),
+                                      0, m_format, GL_UNSIGNED_BYTE, data));
+
+                GLint isCompressed = GL_FALSE;
+                if (m_compressed) {
+                    glAssert(glGetTexLevelParameteriv(GL_TEXTURE_2D, static_cast<GLint>(j), GL_TEXTURE_COMPRESSED, &isCompressed));
                 }
 
-                m_buffers.clear();
-                m_textureId = textureId;
+                if (isCompressed == GL_TRUE) {
+                    GLint compressedSize = 0;
+                    glAssert(glGetTexLevelParameteriv(GL_TEXTURE_2D, static_cast<GLint>(j), GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &compressedSize));
+                    m_uploadedBytes += static_cast<size_t>(compressedSize);
+                } else {
+                    // the internal format is GL_RGBA
+                    m_uploadedBytes += 4u * mipSize.x() * mipSize.y();
+                }
             }
+
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+
+            m_buffers.clear();
+            m_textureId = textureId;
+            m_pendingTextureId = 0;
         }
 
         void Texture::setMode(const int minFilter, const int magFilter) {
-            if (isPrepared()) {
+            if (m_pendingTextureId != 0) {
+                m_minFilter = minFilter;
+                m_magFilter = magFilter;
+            } else if (isUploaded()) {
                 activate();
                 if (m_type == TextureType::Masked) {
                     // Force GL_NEAREST filtering for masked textures.
@@ -250,7 +441,11 @@ namespace TrenchBroom {
         }
 
         void Texture::activate() const {
-            if (isPrepared()) {
+            if (m_pendingTextureId != 0) {
+                upload();
+            }
+
+            if (isUploaded()) {
                 glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
 
                 switch (m_culling) {
@@ -282,7 +477,7 @@ namespace TrenchBroom {
         }
 
         void Texture::deactivate() const {
-            if (isPrepared()) {
+            if (isUploaded()) {
                 if (m_blendFunc.enable != TextureBlendFunc::Enable::UseDefault) {
                     glAssert(glPopAttrib());
                 }
@@ -307,19 +502,54 @@ namespace TrenchBroom {
         }
 
         const Texture::BufferList& Texture::buffersIfUnprepared() const {
+            load();
             return m_buffers;
         }
 
         GLenum Texture::format() const {
+            load();
             return m_format;
         }
 
         TextureType Texture::type() const {
+            load();
             return m_type;
         }
 
         void Texture::setCollection(TextureCollection* collection) {
             m_collection = collection;
         }
+
+        void TextureUsageCountChanges::record(const std::function<void()>& function) {
+            struct Recording {
+                std::unordered_map<Texture*, int>* previous;
+
+                explicit Recording(std::unordered_map<Texture*, int>& changes) :
+                previous(recordedUsageCountChanges) {
+                    recordedUsageCountChanges = &changes;
+                }
+
+                ~Recording() {
+                    recordedUsageCountChanges = previous;
+                }
+            };
+
+            const Recording recording(m_changes);
+            function();
+        }
+
+        void TextureUsageCountChanges::apply() {
+            assert(recordedUsageCountChanges == nullptr);
+
+            for (const auto& [texture, change] : m_changes) {
+                for (int i = 0; i < change; ++i) {
+                    texture->incUsageCount();
+                }
+                for (int i = 0; i > change; --i) {
+                    texture->decUsageCount();
+                }
+            }
+            m_changes.clear();
+        }
     }
 }
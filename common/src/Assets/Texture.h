@@ -25,8 +25,12 @@
 
 #include <vecmath/forward.h>
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -71,6 +75,12 @@ namespace TrenchBroom {
         };
 
         class Texture {
+        public:
+            /**
+             * Decodes the pixels of a texture whose size is already known. Returns null if the texture cannot be
+             * decoded.
+             */
+            using Loader = std::function<std::unique_ptr<Texture>()>;
         private:
             using Buffer = std::vector<unsigned char>;
             using BufferList = std::vector<Buffer>;
@@ -80,16 +90,18 @@ namespace TrenchBroom {
 
             size_t m_width;
             size_t m_height;
-            Color m_averageColor;
+            mutable Color m_averageColor;
 
             size_t m_usageCount;
             bool m_overridden;
 
-            GLenum m_format;
-            TextureType m_type;
+            mutable GLenum m_format;
+            mutable TextureType m_type;
 
             // Quake 3 surface parameters; move these to materials when we add proper support for those.
             std::set<std::string> m_surfaceParms;
+            // the bits of the surface parameters, see surfaceParmBit()
+            uint64_t m_surfaceParmMask;
 
             // Quake 3 surface culling; move to materials
             TextureCulling m_culling;
@@ -98,11 +110,25 @@ namespace TrenchBroom {
             TextureBlendFunc m_blendFunc;
 
             mutable GLuint m_textureId;
+            // the texture ID assigned by prepare() while the texture data has not been uploaded yet
+            mutable GLuint m_pendingTextureId;
+            mutable int m_minFilter;
+            mutable int m_magFilter;
+            mutable bool m_compressed;
+            mutable size_t m_maxSize;
+            mutable size_t m_uploadedBytes;
             mutable BufferList m_buffers;
+            // decodes the pixels when they are first needed; null once the texture has been loaded
+            mutable Loader m_loader;
         public:
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, Buffer&& buffer, GLenum format, TextureType type);
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, BufferList&& buffers, GLenum format, TextureType type);
             Texture(const std::string& name, size_t width, size_t height, GLenum format = GL_RGB, TextureType type = TextureType::Opaque);
+            /**
+             * Creates a texture of the given size whose pixels are decoded by the given loader when they are first
+             * needed, i.e. when the texture is uploaded or when its average color, type or format is requested.
+             */
+            Texture(const std::string& name, size_t width, size_t height, Loader loader);
             ~Texture();
 
             static TextureType selectTextureType(bool masked);
@@ -121,6 +147,19 @@ namespace TrenchBroom {
             const std::set<std::string>& surfaceParms() const;
             void setSurfaceParms(const std::set<std::string>& surfaceParms);
 
+            /**
+             * Returns the bit that represents the given surface parameter in the masks returned by surfaceParmMask().
+             * Bits are assigned to surface parameters in the order in which they are first requested. Once all 64 bits
+             * are taken, 0 is returned for new surface parameters, and callers must check surfaceParms() instead.
+             */
+            static uint64_t surfaceParmBit(const std::string& surfaceParm);
+
+            /**
+             * Returns the bits of all surface parameters of this texture, so that a surface parameter can be checked with
+             * a single mask test instead of a lookup by name.
+             */
+            uint64_t surfaceParmMask() const;
+
             TextureCulling culling() const;
             void setCulling(TextureCulling culling);
 
@@ -133,16 +172,42 @@ namespace TrenchBroom {
             bool overridden() const;
             void setOverridden(bool overridden);
 
+            /**
+             * Indicates whether the pixels of this texture have been decoded. This is only false for textures that
+             * were created with a loader and have not been used yet.
+             */
+            bool isLoaded() const;
+
             bool isPrepared() const;
-            void prepare(GLuint textureId, int minFilter, int magFilter);
+            /**
+             * Assigns the given texture ID to this texture. The texture data is not uploaded until the texture is
+             * activated for the first time.
+             *
+             * If compressed is true, the driver is asked to store the texture in a compressed internal format. If
+             * maxSize is not 0, the mip levels whose width or height exceed it are not uploaded, provided that the
+             * texture has a smaller mip level.
+             */
+            void prepare(GLuint textureId, int minFilter, int magFilter, bool compressed = false, size_t maxSize = 0u);
             void setMode(int minFilter, int magFilter);
 
+            /**
+             * Indicates whether the texture data has been uploaded to video memory.
+             */
+            bool isUploaded() const;
+            /**
+             * Returns the number of bytes of video memory used by this texture, or 0 if it has not been uploaded.
+             */
+            size_t uploadedBytes() const;
+
             void activate() const;
             void deactivate() const;
+        private:
+            void load() const;
+            void upload() const;
         public: // exposed for tests only
             /**
              * Returns the texture data in the format returned by format().
-             * Once prepare() is called, this will be an empty vector.
+             * Once the texture has been uploaded, this will be an empty vector.
              */
             const BufferList& buffersIfUnprepared() const;
             /**
@@ -154,6 +219,29 @@ namespace TrenchBroom {
             void setCollection(TextureCollection* collection);
             friend class TextureCollection;
         };
+
+        /**
+         * Collects changes to texture usage counts so that they can be applied later.
+         *
+         * The usage counts are shared by all faces that use a texture, and changing them notifies the observers of the
+         * texture's collection, so they must only be changed on the main thread. Code that creates, copies or deletes
+         * faces on worker threads must run through record() and call apply() on the main thread afterwards.
+         */
+        class TextureUsageCountChanges {
+        private:
+            std::unordered_map<Texture*, int> m_changes;
+        public:
+            /**
+             * Calls the given function and records the usage count changes that it makes on the calling thread
+             * instead of applying them.
+             */
+            void record(const std::function<void()>& function);
+
+            /**
+             * Applies the recorded changes and forgets them. Must be called on the main thread.
+             */
+            void apply();
+        };
     }
 }
 
@@ -26,6 +26,7 @@
 #include <FreeImage.h>
 
 #include <algorithm> // for std::max
+#include <cassert>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -63,6 +64,49 @@ namespace TrenchBroom {
             }
         }
 
+        size_t mipLevelCount(const size_t width, const size_t height) {
+            size_t levels = 1u;
+            for (auto size = std::max(width, height); size > 1u; size >>= 1u) {
+                ++levels;
+            }
+            return levels;
+        }
+
+        void generateMips(TextureBufferList& buffers, const size_t width, const size_t height, const GLenum format) {
+            assert(!buffers.empty());
+
+            const auto bytesPerPixel = bytesPerPixelForFormat(format);
+            setMipBufferSize(buffers, mipLevelCount(width, height), width, height, format);
+
+            for (size_t level = 1u; level < buffers.size(); ++level) {
+                const auto srcSize = sizeAtMipLevel(width, height, level - 1u);
+                const auto dstSize = sizeAtMipLevel(width, height, level);
+                const auto& src = buffers[level - 1u];
+                auto& dst = buffers[level];
+
+                // if a source dimension is 1, both samples along that axis are taken from the same row or column
+                const auto dx = srcSize.x() > 1u ? 1u : 0u;
+                const auto dy = srcSize.y() > 1u ? 1u : 0u;
+
+                for (size_t y = 0u; y < dstSize.y(); ++y) {
+                    const auto row0 = (2u * y) * srcSize.x();
+                    const auto row1 = (2u * y + dy) * srcSize.x();
+                    for (size_t x = 0u; x < dstSize.x(); ++x) {
+                        const auto col0 = 2u * x;
+                        const auto col1 = 2u * x + dx;
+                        for (size_t c = 0u; c < bytesPerPixel; ++c) {
+                            const auto sum =
+                                static_cast<unsigned int>(src[(row0 + col0) * bytesPerPixel + c]) +
+                                static_cast<unsigned int>(src[(row0 + col1) * bytesPerPixel + c]) +
+                                static_cast<unsigned int>(src[(row1 + col0) * bytesPerPixel + c]) +
+                                static_cast<unsigned int>(src[(row1 + col1) * bytesPerPixel + c]);
+                            dst[(y * dstSize.x() + x) * bytesPerPixel + c] = static_cast<unsigned char>((sum + 2u) / 4u);
+                        }
+                    }
+                }
+            }
+        }
+
         void resizeMips(TextureBufferList& buffers, const vm::vec2s& oldSize, const vm::vec2s& newSize) {
             if (oldSize == newSize)
                 return;
@@ -34,6 +34,13 @@ namespace TrenchBroom {
         vm::vec2s sizeAtMipLevel(size_t width, size_t height, size_t level);
         size_t bytesPerPixelForFormat(GLenum format);
         void setMipBufferSize(TextureBufferList& buffers, size_t mipLevels, size_t width, size_t height, GLenum format);
+        size_t mipLevelCount(size_t width, size_t height);
+
+        /**
+         * Replaces all but the first buffer of the given list with a complete mip chain computed by averaging 2x2 blocks
+         * of the previous level. The first buffer must contain the image data of the given size and format.
+         */
+        void generateMips(TextureBufferList& buffers, size_t width, size_t height, GLenum format);
 
         void resizeMips(TextureBufferList& buffers, const vm::vec2s& oldSize, const vm::vec2s& newSize);
     }
@@ -25,6 +25,7 @@
 #include <kdl/vector_utils.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -80,6 +81,14 @@ namespace TrenchBroom {
             return m_path;
         }
 
+        const std::vector<IO::Path>& TextureCollection::sourcePaths() const {
+            return m_sourcePaths;
+        }
+
+        void TextureCollection::setSourcePaths(std::vector<IO::Path> sourcePaths) {
+            m_sourcePaths = std::move(sourcePaths);
+        }
+
         std::string TextureCollection::name() const {
             if (m_path.isEmpty())
                 return "";
@@ -119,7 +128,7 @@ namespace TrenchBroom {
             return !m_textureIds.empty();
         }
 
-        void TextureCollection::prepare(const int minFilter, const int magFilter) {
+        void TextureCollection::prepare(const int minFilter, const int magFilter, const bool compressed, const size_t maxSize) {
             assert(!prepared());
 
             m_textureIds.resize(textureCount());
@@ -128,7 +137,7 @@ namespace TrenchBroom {
 
             for (size_t i = 0; i < textureCount(); ++i) {
                 Texture* texture = m_textures[i];
-                texture->prepare(m_textureIds[i], minFilter, magFilter);
+                texture->prepare(m_textureIds[i], minFilter, magFilter, compressed, maxSize);
             }
         }
 
@@ -37,6 +37,7 @@ namespace TrenchBroom {
 
             bool m_loaded;
             IO::Path m_path;
+            std::vector<IO::Path> m_sourcePaths;
             std::vector<Texture*> m_textures;
 
             size_t m_usageCount;
@@ -58,6 +59,14 @@ namespace TrenchBroom {
 
             bool loaded() const;
             const IO::Path& path() const;
+
+            /**
+             * Returns the absolute paths of the files and directories on disk from which this collection was loaded.
+             * If any of these change, the collection must be loaded again.
+             */
+            const std::vector<IO::Path>& sourcePaths() const;
+            void setSourcePaths(std::vector<IO::Path> sourcePaths);
+
             std::string name() const;
             size_t textureCount() const;
             const std::vector<Texture*>& textures() const;
@@ -67,7 +76,7 @@ namespace TrenchBroom {
             size_t usageCount() const;
 
             bool prepared() const;
-            void prepare(int minFilter, int magFilter);
+            void prepare(int minFilter, int magFilter, bool compressed = false, size_t maxSize = 0u);
             void setTextureMode(int minFilter, int magFilter);
         private:
             void incUsageCount();
@@ -26,7 +26,6 @@
 #include "IO/TextureLoader.h"
 
 #include <kdl/map_utils.h>
-#include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
@@ -59,7 +58,9 @@ namespace TrenchBroom {
         m_logger(logger),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_compressTextures(false),
+        m_maxTextureSize(0u) {}
 
         TextureManager::~TextureManager() {
             clear();
@@ -122,6 +123,33 @@ namespace TrenchBroom {
             m_logger.debug() << "Added texture collection " << collection->path();
         }
 
+        std::vector<TextureCollection*> TextureManager::collectionsLoadedFrom(const std::vector<IO::Path>& sourcePaths) const {
+            auto result = std::vector<TextureCollection*>();
+            for (auto* collection : m_collections) {
+                const auto& collectionSourcePaths = collection->sourcePaths();
+                const auto loadedFrom = std::any_of(std::begin(sourcePaths), std::end(sourcePaths), [&](const auto& path) {
+                    return kdl::vec_contains(collectionSourcePaths, path);
+                });
+                if (loadedFrom) {
+                    result.push_back(collection);
+                }
+            }
+            return result;
+        }
+
+        void TextureManager::unloadTextureCollections(const std::vector<TextureCollection*>& collections) {
+            for (auto* collection : collections) {
+                if (kdl::vec_contains(m_collections, collection)) {
+                    kdl::vec_erase(m_collections, collection);
+                    kdl::vec_erase(m_toPrepare, collection);
+                    m_toRemove.push_back(collection);
+
+                    m_logger.debug() << "Removed texture collection " << collection->path();
+                }
+            }
+            updateTextures();
+        }
+
         void TextureManager::clear() {
             kdl::vec_clear_and_delete(m_collections);
             kdl::vec_clear_and_delete(m_toRemove);
@@ -139,6 +167,14 @@ namespace TrenchBroom {
             m_resetTextureMode = true;
         }
 
+        void TextureManager::setCompressTextures(const bool compressTextures) {
+            m_compressTextures = compressTextures;
+        }
+
+        void TextureManager::setMaxTextureSize(const size_t maxTextureSize) {
+            m_maxTextureSize = maxTextureSize;
+        }
+
         void TextureManager::commitChanges() {
             resetTextureMode();
             prepare();
@@ -146,7 +182,7 @@ namespace TrenchBroom {
         }
 
         Texture* TextureManager::texture(const std::string& name) const {
-            auto it = m_texturesByName.find(kdl::str_to_lower(name));
+            auto it = m_texturesByName.find(name);
             if (it == std::end(m_texturesByName)) {
                 return nullptr;
             } else {
@@ -158,6 +194,20 @@ namespace TrenchBroom {
             return m_textures;
         }
 
+        TextureManager::Stats TextureManager::stats() const {
+            Stats result;
+            for (const auto* collection : m_collections) {
+                for (const auto* texture : collection->textures()) {
+                    ++result.textureCount;
+                    if (texture->isUploaded()) {
+                        ++result.uploadedCount;
+                        result.uploadedBytes += texture->uploadedBytes();
+                    }
+                }
+            }
+            return result;
+        }
+
         const std::vector<TextureCollection*>& TextureManager::collections() const {
             return m_collections;
         }
@@ -180,7 +230,7 @@ namespace TrenchBroom {
 
         void TextureManager::prepare() {
             std::for_each(std::begin(m_toPrepare), std::end(m_toPrepare),
-                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter); });
+                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter, m_compressTextures, m_maxTextureSize); });
             m_toPrepare.clear();
         }
 
@@ -190,7 +240,7 @@ namespace TrenchBroom {
 
             for (auto* collection : m_collections) {
                 for (auto* texture : collection->textures()) {
-                    const auto key = kdl::str_to_lower(texture->name());
+                    const auto& key = texture->name();
                     texture->setOverridden(false);
 
                     auto mIt = m_texturesByName.find(key);
@@ -22,6 +22,8 @@
 
 #include "Notifier.h"
 
+#include <kdl/string_compare.h>
+
 #include <map>
 #include <string>
 #include <vector>
@@ -42,7 +44,11 @@ namespace TrenchBroom {
         private:
             using TextureCollectionMap = std::map<IO::Path, TextureCollection*>;
             using TextureCollectionMapEntry = std::pair<IO::Path, TextureCollection*>;
-            using TextureMap = std::map<std::string, Texture*>;
+            /**
+             * Texture names are compared case insensitively, so looking up a texture does not need to create a lower
+             * case copy of its name.
+             */
+            using TextureMap = std::map<std::string, Texture*, kdl::ci::string_less>;
 
             Logger& m_logger;
 
@@ -57,7 +63,15 @@ namespace TrenchBroom {
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
+            bool m_compressTextures;
+            size_t m_maxTextureSize;
         public:
+            struct Stats {
+                size_t textureCount = 0;
+                size_t uploadedCount = 0;
+                size_t uploadedBytes = 0;
+            };
+
             Notifier<> usageCountDidChange;
         public:
             TextureManager(int magFilter, int minFilter, Logger& logger);
@@ -69,15 +83,45 @@ namespace TrenchBroom {
             TextureCollectionMap collectionMap() const;
             void addTextureCollection(Assets::TextureCollection* collection);
         public:
+            /**
+             * Returns the texture collections that were loaded from any of the given files or directories on disk.
+             *
+             * @see TextureCollection::sourcePaths()
+             */
+            std::vector<TextureCollection*> collectionsLoadedFrom(const std::vector<IO::Path>& sourcePaths) const;
+
+            /**
+             * Removes the given texture collections, so that they are loaded again by the next call to
+             * setTextureCollections, while all other collections are kept. The textures of the given collections
+             * must not be in use anymore.
+             */
+            void unloadTextureCollections(const std::vector<TextureCollection*>& collections);
+
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+            /**
+             * Sets whether textures are stored in a compressed format in video memory. This takes effect for
+             * texture collections that have not been prepared yet.
+             */
+            void setCompressTextures(bool compressTextures);
+            /**
+             * Sets the maximum width and height of the textures in video memory, or 0 for no limit. Larger textures
+             * are uploaded starting at their first mip level that fits. This takes effect for texture collections that
+             * have not been prepared yet.
+             */
+            void setMaxTextureSize(size_t maxTextureSize);
             void commitChanges();
 
             Texture* texture(const std::string& name) const;
             const std::vector<Texture*>& textures() const;
             const std::vector<TextureCollection*>& collections() const;
             const std::vector<std::string> collectionNames() const;
+
+            /**
+             * Returns how many of the managed textures have been uploaded and how much video memory they occupy.
+             */
+            Stats stats() const;
         private:
             void resetTextureMode();
             void prepare();
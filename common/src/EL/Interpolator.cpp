@@ -24,22 +24,31 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace EL {
         Interpolator::Interpolator(const std::string& str) :
-        ELParser(ELParser::Mode::Lenient, str) {}
-
-        std::string Interpolator::interpolate(const EvaluationContext& context) {
-            std::stringstream result;
+        ELParser(ELParser::Mode::Lenient, str) {
             while (!m_tokenizer.eof()) {
-                m_tokenizer.appendUntil("${", result);
+                std::stringstream text;
+                m_tokenizer.appendUntil("${", text);
+                m_texts.push_back(text.str());
                 if (!m_tokenizer.eof()) {
-                    Expression expression = parse();
-                    result << expression.evaluate(context).convertTo(EL::ValueType::String).stringValue();
+                    m_expressions.push_back(parse());
                     expect(IO::ELToken::CBrace, m_tokenizer.nextToken());
                 }
             }
+        }
+
+        std::string Interpolator::interpolate(const EvaluationContext& context) const {
+            std::stringstream result;
+            for (size_t i = 0; i < m_texts.size(); ++i) {
+                result << m_texts[i];
+                if (i < m_expressions.size()) {
+                    result << m_expressions[i].evaluate(context).convertTo(EL::ValueType::String).stringValue();
+                }
+            }
 
             return result.str();
         }
@@ -21,17 +21,29 @@
 #define Interpolator_h
 
 #include "EL/EL_Forward.h"
+#include "EL/Expression.h"
 #include "IO/ELParser.h"
 
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace EL {
+        /**
+         * Parses a string with embedded expressions once, so that it can be interpolated repeatedly with different
+         * evaluation contexts without being parsed again.
+         */
         class Interpolator : private IO::ELParser {
+        private:
+            /**
+             * The text between the expressions. The expression at index i follows the text at index i.
+             */
+            std::vector<std::string> m_texts;
+            std::vector<Expression> m_expressions;
         public:
             explicit Interpolator(const std::string& str);
 
-            std::string interpolate(const EvaluationContext& context);
+            std::string interpolate(const EvaluationContext& context) const;
         };
 
         std::string interpolate(const std::string& str, const EvaluationContext& context);
@@ -484,13 +484,28 @@ namespace TrenchBroom {
         void UndefinedValueHolder::appendToStream(std::ostream& str, const bool /* multiline */, const std::string& /* indent */) const { str << "undefined"; }
 
 
+        namespace {
+            // Value holders are immutable, so the holders of the most common values are shared to avoid allocating
+            // a new one for the result of every comparison or logical operation.
+            std::shared_ptr<ValueHolder> booleanHolder(const BooleanType value) {
+                static const auto trueHolder = std::shared_ptr<ValueHolder>(new BooleanValueHolder(true));
+                static const auto falseHolder = std::shared_ptr<ValueHolder>(new BooleanValueHolder(false));
+                return value ? trueHolder : falseHolder;
+            }
+
+            std::shared_ptr<ValueHolder> nullHolder() {
+                static const auto holder = std::shared_ptr<ValueHolder>(new NullValueHolder());
+                return holder;
+            }
+        }
+
         const Value Value::Null = Value(new NullValueHolder(), 0, 0);
         const Value Value::Undefined = Value(new UndefinedValueHolder(), 0, 0);
 
         Value::Value(ValueHolder* holder, const size_t line, const size_t column)      : m_value(holder), m_line(line), m_column(column) {}
 
-        Value::Value(const BooleanType& value, const size_t line, const size_t column) : m_value(new BooleanValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const BooleanType& value)                                         : m_value(new BooleanValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const BooleanType& value, const size_t line, const size_t column) : m_value(booleanHolder(value)), m_line(line), m_column(column) {}
+        Value::Value(const BooleanType& value)                                         : m_value(booleanHolder(value)), m_line(0), m_column(0) {}
 
         Value::Value(const StringType& value, const size_t line, const size_t column)  : m_value(new StringValueHolder(value)), m_line(line), m_column(column) {}
         Value::Value(const StringType& value)                                          : m_value(new StringValueHolder(value)), m_line(0), m_column(0) {}
@@ -521,7 +536,7 @@ namespace TrenchBroom {
 
         Value::Value(const Value& other, const size_t line, const size_t column)       : m_value(other.m_value), m_line(line), m_column(column) {}
 
-        Value::Value()                                                                 : m_value(new NullValueHolder()), m_line(0), m_column(0) {}
+        Value::Value()                                                                 : m_value(nullHolder()), m_line(0), m_column(0) {}
 
         Value Value::ref(const StringType& value, const size_t line, const size_t column) {
             return Value(new StringReferenceHolder(value), line, column);
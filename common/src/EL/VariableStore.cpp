@@ -24,6 +24,7 @@
 
 #include <kdl/map_utils.h>
 
+#include <algorithm>
 #include <string>
 
 namespace TrenchBroom {
@@ -112,5 +113,52 @@ namespace TrenchBroom {
 
         void NullVariableStore::doDeclare(const std::string& /* name */, const Value& /* value */) {}
         void NullVariableStore::doAssign(const std::string& /* name */, const Value& /* value */) {}
+
+        RecordingVariableStore::RecordingVariableStore(const VariableStore& store) :
+        m_store(store.clone()),
+        m_record(std::make_shared<Record>()) {}
+
+        RecordingVariableStore::RecordingVariableStore(const RecordingVariableStore& other) :
+        VariableStore(other),
+        m_store(other.m_store->clone()),
+        m_record(other.m_record) {}
+
+        const std::vector<std::string>& RecordingVariableStore::recordedNames() const {
+            return m_record->names;
+        }
+
+        bool RecordingVariableStore::recordedAllNames() const {
+            return m_record->allNames;
+        }
+
+        VariableStore* RecordingVariableStore::doClone() const {
+            return new RecordingVariableStore(*this);
+        }
+
+        size_t RecordingVariableStore::doGetSize() const {
+            m_record->allNames = true;
+            return m_store->size();
+        }
+
+        Value RecordingVariableStore::doGetValue(const std::string& name) const {
+            auto& names = m_record->names;
+            if (std::find(std::begin(names), std::end(names), name) == std::end(names)) {
+                names.push_back(name);
+            }
+            return m_store->value(name);
+        }
+
+        std::vector<std::string> RecordingVariableStore::doGetNames() const {
+            m_record->allNames = true;
+            return m_store->names();
+        }
+
+        void RecordingVariableStore::doDeclare(const std::string& name, const Value& value) {
+            m_store->declare(name, value);
+        }
+
+        void RecordingVariableStore::doAssign(const std::string& name, const Value& value) {
+            m_store->assign(name, value);
+        }
     }
 }
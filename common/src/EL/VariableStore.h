@@ -23,6 +23,7 @@
 #include "EL/Value.h" // required by VariableTable::Table declaration
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -80,6 +81,46 @@ namespace TrenchBroom {
             void doDeclare(const std::string& name, const Value& value) override;
             void doAssign(const std::string& name, const Value& value) override;
         };
+
+        /**
+         * Forwards to another variable store and records the names of the variables that are looked up, so that a
+         * caller can tell which variables the result of an evaluation depends on. Since an evaluation context clones
+         * its store, all copies of a recording store share the same record.
+         */
+        class RecordingVariableStore : public VariableStore {
+        private:
+            struct Record {
+                std::vector<std::string> names;
+                bool allNames = false;
+            };
+
+            std::unique_ptr<VariableStore> m_store;
+            std::shared_ptr<Record> m_record;
+        public:
+            explicit RecordingVariableStore(const VariableStore& store);
+            RecordingVariableStore(const RecordingVariableStore& other);
+
+            RecordingVariableStore& operator=(const RecordingVariableStore& other) = delete;
+
+            /**
+             * Returns the names of the variables that were looked up, without duplicates and in the order in which
+             * they were first looked up.
+             */
+            const std::vector<std::string>& recordedNames() const;
+
+            /**
+             * Indicates whether the size of this store or the names of all of its variables were queried, in which
+             * case the result of the evaluation may depend on any variable.
+             */
+            bool recordedAllNames() const;
+        private:
+            VariableStore* doClone() const override;
+            size_t doGetSize() const override;
+            Value doGetValue(const std::string& name) const override;
+            std::vector<std::string> doGetNames() const override;
+            void doDeclare(const std::string& name, const Value& value) override;
+            void doAssign(const std::string& name, const Value& value) override;
+        };
     }
 }
 
@@ -24,14 +24,18 @@
 #include "IO/Path.h"
 #include "IO/SystemPaths.h"
 
+#include <kdl/thread_pool.h>
+
 #include <cassert>
 #include <string>
+#include <utility>
 
 #include <QString>
 
 namespace TrenchBroom {
     FileLogger::FileLogger(const IO::Path& filePath) :
-    m_file(nullptr) {
+    m_file(nullptr),
+    m_writeScheduled(false) {
         const auto fixedPath = IO::Disk::fixPath(filePath);
         IO::Disk::ensureDirectoryExists(fixedPath.deleteLastComponent());
         m_file = fopen(fixedPath.asString().c_str(), "w");
@@ -39,6 +43,9 @@ namespace TrenchBroom {
     }
 
     FileLogger::~FileLogger() {
+        // the logger is a static instance, which is destroyed after the thread pool, so no write task is running
+        writePendingMessages();
+
         if (m_file != nullptr) {
             fclose(m_file);
             m_file = nullptr;
@@ -52,13 +59,45 @@ namespace TrenchBroom {
 
     void FileLogger::doLog(const LogLevel /* level */, const std::string& message) {
         assert(m_file != nullptr);
-        if (m_file != nullptr) {
-            std::fprintf(m_file, "%s\n", message.c_str());
-            std::fflush(m_file);
+        auto scheduleWrite = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingMessages.push_back(message);
+            scheduleWrite = !m_writeScheduled;
+            m_writeScheduled = true;
+        }
+
+        // a write task that was still queued when the thread pool was destroyed is discarded, so the messages are
+        // written right away whenever there is no thread pool
+        if (auto* pool = kdl::default_thread_pool()) {
+            if (scheduleWrite) {
+                pool->submit([this]() { writePendingMessages(); }, kdl::task_priority::background);
+            }
+        } else {
+            writePendingMessages();
         }
     }
 
     void FileLogger::doLog(const LogLevel level, const QString& message) {
         log(level, message.toStdString());
     }
+
+    void FileLogger::writePendingMessages() {
+        // the file lock is held while the messages are taken so that they are written in the order they were logged
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+
+        std::vector<std::string> messages;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::swap(messages, m_pendingMessages);
+            m_writeScheduled = false;
+        }
+
+        if (m_file != nullptr && !messages.empty()) {
+            for (const auto& message : messages) {
+                std::fprintf(m_file, "%s\n", message.c_str());
+            }
+            std::fflush(m_file);
+        }
+    }
 }
@@ -23,7 +23,10 @@
 #include "Macros.h"
 #include "Logger.h"
 
+#include <cstdio>
+#include <mutex>
 #include <string>
+#include <vector>
 
 class QString;
 
@@ -32,9 +35,20 @@ namespace TrenchBroom {
         class Path;
     }
 
+    /**
+     * Writes log messages to a file. The messages are written by a background task on the default thread pool so that
+     * logging never waits for the disk. If no default thread pool is set, e.g. while the application starts up or shuts
+     * down, the messages are written right away. Pending messages are written when the logger is destroyed.
+     */
     class FileLogger : public Logger {
     private:
         FILE* m_file;
+
+        // guards m_file, acquired before m_mutex
+        std::mutex m_fileMutex;
+        std::mutex m_mutex;
+        std::vector<std::string> m_pendingMessages;
+        bool m_writeScheduled;
     public:
         explicit FileLogger(const IO::Path& filePath);
         ~FileLogger() override;
@@ -44,6 +58,8 @@ namespace TrenchBroom {
         void doLog(LogLevel level, const std::string& message) override;
         void doLog(LogLevel level, const QString& message) override;
 
+        void writePendingMessages();
+
         deleteCopyAndMove(FileLogger)
     };
 }
@@ -537,7 +537,7 @@ namespace TrenchBroom {
                 }
 
             }
-            surface.addTexturedMesh(frame, builder.vertices(), builder.indices());
+            surface.addTexturedMesh(frame, std::move(builder.vertices()), builder.indices());
 
             return model;
         }
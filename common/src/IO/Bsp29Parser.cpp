@@ -60,8 +60,9 @@ namespace TrenchBroom {
             static const size_t FaceRest              = 0x8;
 
             static const size_t TexInfoSize           = 0x28;
-            static const size_t TexInfoRest           = 0x4;
 
+            static const size_t VertexSize            = 0xC;
+            static const size_t EdgeSize              = 0x4;
             static const size_t FaceEdgeSize          = 0x4;
             static const size_t ModelSize             = 0x40;
             // static const size_t ModelOrigin           = 0x18;
@@ -111,45 +112,28 @@ namespace TrenchBroom {
                 throw AssetException("Unsupported BSP model version: " + std::to_string(version));
             }
 
-            reader.seekFromBegin(BspLayout::DirTexturesAddress);
-            /* const auto textureOffset = */ reader.readSize<int32_t>();
-            /* const auto textureLength = */ reader.readSize<int32_t>();
-
-            reader.seekFromBegin(BspLayout::DirTexInfosAddress);
-            const auto textureInfoOffset = reader.readSize<int32_t>();
-            const auto textureInfoLength = reader.readSize<int32_t>();
-            const auto textureInfoCount  = textureInfoLength / BspLayout::TexInfoSize;
-
-            reader.seekFromBegin(BspLayout::DirVerticesAddress);
-            const auto vertexOffset = reader.readSize<int32_t>();
-            const auto vertexLength = reader.readSize<int32_t>();
-            const auto vertexCount = vertexLength / (3 * sizeof(float));
-
-            reader.seekFromBegin(BspLayout::DirEdgesAddress);
-            const auto edgeInfoOffset = reader.readSize<int32_t>();
-            const auto edgeInfoLength = reader.readSize<int32_t>();
-            const auto edgeInfoCount = edgeInfoLength / (2 * sizeof(uint16_t));
-
-            reader.seekFromBegin(BspLayout::DirFacesAddress);
-            const auto faceInfoOffset = reader.readSize<int32_t>();
-            const auto faceInfoLength = reader.readSize<int32_t>();
-            const auto faceInfoCount = faceInfoLength / BspLayout::FaceSize;
-
-            reader.seekFromBegin(BspLayout::DirFaceEdgesAddress);
-            const auto faceEdgesOffset = reader.readSize<int32_t>();
-            const auto faceEdgesLength = reader.readSize<int32_t>();
-            const auto faceEdgesCount = faceEdgesLength / BspLayout::FaceEdgeSize;
-
-            reader.seekFromBegin(BspLayout::DirModelAddress);
-            const auto modelsOffset = reader.readSize<int32_t>();
-
-            const auto textureInfos = parseTextureInfos(reader.subReaderFromBegin(textureInfoOffset), textureInfoCount);
-            const auto vertices = parseVertices(reader.subReaderFromBegin(vertexOffset), vertexCount);
-            const auto edgeInfos = parseEdgeInfos(reader.subReaderFromBegin(edgeInfoOffset), edgeInfoCount);
-            const auto faceInfos = parseFaceInfos(reader.subReaderFromBegin(faceInfoOffset), faceInfoCount);
-            const auto faceEdges = parseFaceEdges(reader.subReaderFromBegin(faceEdgesOffset), faceEdgesCount);
+            // A BSP file usually contains a whole map, but an entity only references one of its models. Instead of
+            // parsing the lumps completely, only the entries that belong to the faces of the requested model are read.
+            auto textureInfoReader = lumpReader(reader, BspLayout::DirTexInfosAddress);
+            auto vertexReader = lumpReader(reader, BspLayout::DirVerticesAddress);
+            auto edgeInfoReader = lumpReader(reader, BspLayout::DirEdgesAddress);
+            auto faceInfoReader = lumpReader(reader, BspLayout::DirFacesAddress);
+            auto faceEdgeReader = lumpReader(reader, BspLayout::DirFaceEdgesAddress);
+            auto modelReader = lumpReader(reader, BspLayout::DirModelAddress);
+
+            modelReader.seekFromBegin(frameIndex * BspLayout::ModelSize + BspLayout::ModelFaceIndex);
+            const auto modelFaceIndex = modelReader.readSize<int32_t>();
+            const auto modelFaceCount = modelReader.readSize<int32_t>();
+
+            const auto faceInfos = parseFaceInfos(faceInfoReader, modelFaceIndex, modelFaceCount);
+            parseFrame(frameIndex, model, faceInfos, textureInfoReader, vertexReader, edgeInfoReader, faceEdgeReader);
+        }
 
-            parseFrame(reader.subReaderFromBegin(modelsOffset + frameIndex * BspLayout::ModelSize, BspLayout::ModelSize), frameIndex, model, textureInfos, vertices, edgeInfos, faceInfos, faceEdges);
+        Reader Bsp29Parser::lumpReader(Reader& reader, const size_t directoryAddress) {
+            reader.seekFromBegin(directoryAddress);
+            const auto offset = reader.readSize<int32_t>();
+            const auto length = reader.readSize<int32_t>();
+            return reader.subReaderFromBegin(offset, length);
         }
 
         std::vector<Assets::Texture*> Bsp29Parser::parseTextures(Reader reader, Logger& logger) {
@@ -184,39 +168,23 @@ namespace TrenchBroom {
             return result;
         }
 
-        Bsp29Parser::TextureInfoList Bsp29Parser::parseTextureInfos(Reader reader, const size_t textureInfoCount) {
-            TextureInfoList result(textureInfoCount);
-            for (size_t i = 0; i < textureInfoCount; ++i) {
-                result[i].sAxis = reader.readVec<float, 3>();
-                result[i].sOffset = reader.readFloat<float>();
-                result[i].tAxis = reader.readVec<float, 3>();
-                result[i].tOffset = reader.readFloat<float>();
-                result[i].textureIndex = reader.readSize<uint32_t>();
-                reader.seekForward(BspLayout::TexInfoRest);
-            }
-            return result;
-        }
+        Bsp29Parser::TextureInfo Bsp29Parser::readTextureInfo(Reader& reader, const size_t textureInfoIndex) {
+            reader.seekFromBegin(textureInfoIndex * BspLayout::TexInfoSize);
 
-        std::vector<vm::vec3f> Bsp29Parser::parseVertices(Reader reader, const size_t vertexCount) {
-            std::vector<vm::vec3f> result(vertexCount);
-            for (size_t i = 0; i < vertexCount; ++i) {
-                result[i] = reader.readVec<float, 3>();
-            }
+            TextureInfo result;
+            result.sAxis = reader.readVec<float, 3>();
+            result.sOffset = reader.readFloat<float>();
+            result.tAxis = reader.readVec<float, 3>();
+            result.tOffset = reader.readFloat<float>();
+            result.textureIndex = reader.readSize<uint32_t>();
             return result;
         }
 
-        Bsp29Parser::EdgeInfoList Bsp29Parser::parseEdgeInfos(Reader reader, const size_t edgeInfoCount) {
-            EdgeInfoList result(edgeInfoCount);
-            for (size_t i = 0; i < edgeInfoCount; ++i) {
-                result[i].vertexIndex1 = reader.readSize<uint16_t>();
-                result[i].vertexIndex2 = reader.readSize<uint16_t>();
-            }
-            return result;
-        }
+        Bsp29Parser::FaceInfoList Bsp29Parser::parseFaceInfos(Reader& reader, const size_t firstFaceIndex, const size_t faceCount) {
+            reader.seekFromBegin(firstFaceIndex * BspLayout::FaceSize);
 
-        Bsp29Parser::FaceInfoList Bsp29Parser::parseFaceInfos(Reader reader, const size_t faceInfoCount) {
-            FaceInfoList result(faceInfoCount);
-            for (size_t i = 0; i < faceInfoCount; ++i) {
+            FaceInfoList result(faceCount);
+            for (size_t i = 0; i < faceCount; ++i) {
                 reader.seekForward(BspLayout::FaceEdgeIndex);
                 result[i].edgeIndex = reader.readSize<int32_t>();
                 result[i].edgeCount = reader.readSize<uint16_t>();
@@ -226,29 +194,36 @@ namespace TrenchBroom {
             return result;
         }
 
-        Bsp29Parser::FaceEdgeIndexList Bsp29Parser::parseFaceEdges(Reader reader, const size_t faceEdgeCount) {
-            FaceEdgeIndexList result(faceEdgeCount);
-            for (size_t i = 0; i < faceEdgeCount; ++i) {
-                result[i] = reader.readInt<int32_t>();
+        vm::vec3f Bsp29Parser::readFaceVertex(Reader& vertexReader, Reader& edgeInfoReader, Reader& faceEdgeReader, const size_t faceEdgeIndex) {
+            faceEdgeReader.seekFromBegin(faceEdgeIndex * BspLayout::FaceEdgeSize);
+            const auto edgeIndex = faceEdgeReader.readInt<int32_t>();
+
+            // the second vertex of an edge is used if the edge is reversed
+            if (edgeIndex < 0) {
+                edgeInfoReader.seekFromBegin(static_cast<size_t>(-edgeIndex) * BspLayout::EdgeSize + sizeof(uint16_t));
+            } else {
+                edgeInfoReader.seekFromBegin(static_cast<size_t>(edgeIndex) * BspLayout::EdgeSize);
             }
-            return result;
+            const auto vertexIndex = edgeInfoReader.readSize<uint16_t>();
+
+            vertexReader.seekFromBegin(vertexIndex * BspLayout::VertexSize);
+            return vertexReader.readVec<float, 3>();
         }
 
-        void Bsp29Parser::parseFrame(Reader reader, const size_t frameIndex, Assets::EntityModel& model, const TextureInfoList& textureInfos, const std::vector<vm::vec3f>& vertices, const EdgeInfoList& edgeInfos, const FaceInfoList& faceInfos, const FaceEdgeIndexList& faceEdges) {
+        void Bsp29Parser::parseFrame(const size_t frameIndex, Assets::EntityModel& model, const FaceInfoList& faceInfos, Reader& textureInfoReader, Reader& vertexReader, Reader& edgeInfoReader, Reader& faceEdgeReader) {
             using Vertex = Assets::EntityModelVertex;
             using VertexList = std::vector<Vertex>;
 
             auto& surface = model.surface(0);
 
-            reader.seekForward(BspLayout::ModelFaceIndex);
-            const auto modelFaceIndex = reader.readSize<int32_t>();
-            const auto modelFaceCount = reader.readSize<int32_t>();
+            auto textureInfos = TextureInfoList();
+            textureInfos.reserve(faceInfos.size());
+
             size_t totalVertexCount = 0;
             Renderer::TexturedIndexRangeMap::Size size;
 
-            for (size_t i = 0; i < modelFaceCount; ++i) {
-                const auto& faceInfo = faceInfos[modelFaceIndex + i];
-                const auto& textureInfo = textureInfos[faceInfo.textureInfoIndex];
+            for (const auto& faceInfo : faceInfos) {
+                const auto& textureInfo = textureInfos.emplace_back(readTextureInfo(textureInfoReader, faceInfo.textureInfoIndex));
                 auto* skin = surface.skin(textureInfo.textureIndex);
                 if (skin != nullptr) {
                     const auto faceVertexCount = faceInfo.edgeCount;
@@ -260,9 +235,9 @@ namespace TrenchBroom {
             vm::bbox3f::builder bounds;
 
             Renderer::TexturedIndexRangeMapBuilder<Vertex::Type> builder(totalVertexCount, size);
-            for (size_t i = 0; i < modelFaceCount; ++i) {
-                const auto& faceInfo = faceInfos[modelFaceIndex + i];
-                const auto& textureInfo = textureInfos[faceInfo.textureInfoIndex];
+            for (size_t i = 0; i < faceInfos.size(); ++i) {
+                const auto& faceInfo = faceInfos[i];
+                const auto& textureInfo = textureInfos[i];
                 auto* skin = surface.skin(textureInfo.textureIndex);
                 if (skin != nullptr) {
                     const auto faceVertexCount = faceInfo.edgeCount;
@@ -270,15 +245,7 @@ namespace TrenchBroom {
                     VertexList faceVertices;
                     faceVertices.reserve(faceVertexCount);
                     for (size_t k = 0; k < faceVertexCount; ++k) {
-                        const int faceEdgeIndex = faceEdges[faceInfo.edgeIndex + k];
-                        size_t vertexIndex;
-                        if (faceEdgeIndex < 0) {
-                            vertexIndex = edgeInfos[static_cast<size_t>(-faceEdgeIndex)].vertexIndex2;
-                        } else {
-                            vertexIndex = edgeInfos[static_cast<size_t>(faceEdgeIndex)].vertexIndex1;
-                        }
-
-                        const auto& position = vertices[vertexIndex];
+                        const auto position = readFaceVertex(vertexReader, edgeInfoReader, faceEdgeReader, faceInfo.edgeIndex + k);
                         const auto texCoords = textureCoords(position, textureInfo, skin);
 
                         bounds.add(position);
@@ -294,7 +261,7 @@ namespace TrenchBroom {
             frameName << m_name << "_" << frameIndex;
 
             auto& frame = model.loadFrame(frameIndex, frameName.str(), bounds.bounds());
-            surface.addTexturedMesh(frame, builder.vertices(), builder.indices());
+            surface.addTexturedMesh(frame, std::move(builder.vertices()), builder.indices());
 
         }
 
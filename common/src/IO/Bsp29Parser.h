@@ -51,11 +51,6 @@ namespace TrenchBroom {
             };
             using TextureInfoList = std::vector<TextureInfo>;
 
-            struct EdgeInfo {
-                size_t vertexIndex1, vertexIndex2;
-            };
-            using EdgeInfoList = std::vector<EdgeInfo>;
-
             struct FaceInfo {
                 size_t edgeIndex;
                 size_t edgeCount;
@@ -63,8 +58,6 @@ namespace TrenchBroom {
             };
             using FaceInfoList = std::vector<FaceInfo>;
 
-            using FaceEdgeIndexList = std::vector<int>;
-
             std::string m_name;
             const char* m_begin;
             const char* m_end;
@@ -76,14 +69,14 @@ namespace TrenchBroom {
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
 
+            static Reader lumpReader(Reader& reader, size_t directoryAddress);
+
             std::vector<Assets::Texture*> parseTextures(Reader reader, Logger& logger);
-            TextureInfoList parseTextureInfos(Reader reader, size_t textureInfoCount);
-            std::vector<vm::vec3f> parseVertices(Reader reader, size_t vertexCount);
-            EdgeInfoList parseEdgeInfos(Reader reader, size_t edgeInfoCount);
-            FaceInfoList parseFaceInfos(Reader reader, size_t faceInfoCount);
-            FaceEdgeIndexList parseFaceEdges(Reader reader, size_t faceEdgeCount);
+            TextureInfo readTextureInfo(Reader& reader, size_t textureInfoIndex);
+            FaceInfoList parseFaceInfos(Reader& reader, size_t firstFaceIndex, size_t faceCount);
+            vm::vec3f readFaceVertex(Reader& vertexReader, Reader& edgeInfoReader, Reader& faceEdgeReader, size_t faceEdgeIndex);
 
-            void parseFrame(Reader reader, size_t frameIndex, Assets::EntityModel& model, const TextureInfoList& textureInfos, const std::vector<vm::vec3f>& vertices, const EdgeInfoList& edgeInfos, const FaceInfoList& faceInfos, const FaceEdgeIndexList& faceEdges);
+            void parseFrame(size_t frameIndex, Assets::EntityModel& model, const FaceInfoList& faceInfos, Reader& textureInfoReader, Reader& vertexReader, Reader& edgeInfoReader, Reader& faceEdgeReader);
             vm::vec2f textureCoords(const vm::vec3f& vertex, const TextureInfo& textureInfo, const Assets::Texture* texture) const;
         };
     }
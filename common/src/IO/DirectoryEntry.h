@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_DirectoryEntry
+#define TrenchBroom_DirectoryEntry
+
+#include "IO/Path.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * An item found when listing the contents of a directory.
+         */
+        struct DirectoryEntry {
+            /**
+             * The path of the item, relative to the listed directory.
+             */
+            Path path;
+
+            /**
+             * Whether the item is a directory.
+             */
+            bool directory;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_DirectoryEntry) */
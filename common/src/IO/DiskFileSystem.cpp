@@ -64,6 +64,10 @@ namespace TrenchBroom {
             return Disk::getDirectoryContents(doMakeAbsolute(path));
         }
 
+        std::vector<DirectoryEntry> DiskFileSystem::doGetDirectoryEntries(const Path& path, const bool recurse) const {
+            return Disk::getDirectoryEntries(doMakeAbsolute(path), recurse);
+        }
+
         std::shared_ptr<File> DiskFileSystem::doOpenFile(const Path& path) const {
             return Disk::openFile(doMakeAbsolute(path));
         }
@@ -46,6 +46,7 @@ namespace TrenchBroom {
             bool doFileExists(const Path& path) const override;
 
             std::vector<Path> doGetDirectoryContents(const Path& path) const override;
+            std::vector<DirectoryEntry> doGetDirectoryEntries(const Path& path, bool recurse) const override;
             std::shared_ptr<File> doOpenFile(const Path& path) const override;
         };
 
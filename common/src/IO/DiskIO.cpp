@@ -24,10 +24,13 @@
 #include "IO/FileMatcher.h"
 #include "IO/PathQt.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
+#include <kdl/vector_utils.h>
 
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include <QDir>
 #include <QFileInfo>
@@ -132,13 +135,59 @@ namespace TrenchBroom {
                 return result;
             }
 
+            static std::vector<DirectoryEntry> readDirectory(const Path& fixedPath, const Path& relativePath) {
+                QDir dir(pathAsQString(fixedPath));
+                dir.setFilter(QDir::NoDotAndDotDot | QDir::AllEntries);
+
+                std::vector<DirectoryEntry> result;
+                for (const QFileInfo& entry : dir.entryInfoList()) {
+                    result.push_back(DirectoryEntry{ relativePath + pathFromQString(entry.fileName()), entry.isDir() });
+                }
+                return result;
+            }
+
+            std::vector<DirectoryEntry> getDirectoryEntries(const Path& path, const bool recurse) {
+                const Path fixedPath = fixPath(path);
+                if (!QDir(pathAsQString(fixedPath)).exists()) {
+                    throw FileSystemException("Cannot open directory: '" + fixedPath.asString() + "'");
+                }
+
+                auto result = readDirectory(fixedPath, Path());
+                if (recurse) {
+                    // list the directory tree level by level, reading the directories of each level in parallel
+                    auto levelBegin = size_t(0);
+                    while (levelBegin < result.size()) {
+                        std::vector<Path> directories;
+                        for (size_t i = levelBegin; i < result.size(); ++i) {
+                            if (result[i].directory) {
+                                directories.push_back(result[i].path);
+                            }
+                        }
+                        levelBegin = result.size();
+
+                        const auto contents = kdl::vec_parallel_transform(directories, [&](const Path& directory) {
+                            return readDirectory(fixedPath + directory, directory);
+                        });
+                        for (const auto& entries : contents) {
+                            kdl::vec_append(result, entries);
+                        }
+                    }
+                }
+                return result;
+            }
+
             std::shared_ptr<File> openFile(const Path& path) {
                 const Path fixedPath = fixPath(path);
                 if (!fileExists(fixedPath)) {
                     throw FileNotFoundException(fixedPath.asString());
                 }
 
-                return std::make_shared<CFile>(fixedPath);
+                try {
+                    return std::make_shared<MappedFile>(fixedPath);
+                } catch (const FileSystemException&) {
+                    // not every file can be mapped into memory, so fall back to reading it using the C API
+                    return std::make_shared<CFile>(fixedPath);
+                }
             }
 
             std::string readFile(const Path& path) {
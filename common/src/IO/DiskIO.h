@@ -20,10 +20,12 @@
 #ifndef DiskIO_h
 #define DiskIO_h
 
+#include "IO/DirectoryEntry.h"
 #include "IO/Path.h"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -42,14 +44,26 @@ namespace TrenchBroom {
             std::string readFile(const Path& path);
             Path getCurrentWorkingDir();
 
+            /**
+             * Lists the items in the directory at the given path, optionally including the items in all of its sub
+             * directories. The type of each item is taken from the directory listing itself, and sub directories are
+             * listed in parallel.
+             *
+             * @param path the path of the directory to list
+             * @param recurse whether to list the contents of sub directories, too
+             * @return the items found, with paths relative to the given path
+             *
+             * @throw FileSystemException if the given path does not denote a directory
+             */
+            std::vector<DirectoryEntry> getDirectoryEntries(const Path& path, bool recurse);
+
             template <class M>
             void doFindItems(const Path& searchPath, const M& matcher, const bool recurse, std::vector<Path>& result) {
-                for (const Path& itemPath : getDirectoryContents(searchPath)) {
-                    const bool directory = directoryExists(searchPath + itemPath);
-                    if (directory && recurse)
-                        doFindItems(searchPath + itemPath, matcher, recurse, result);
-                    if (matcher(searchPath + itemPath, directory))
-                        result.push_back(searchPath + itemPath);
+                for (const auto& entry : getDirectoryEntries(searchPath, recurse)) {
+                    const auto itemPath = searchPath + entry.path;
+                    if (matcher(itemPath, entry.directory)) {
+                        result.push_back(itemPath);
+                    }
                 }
             }
 
@@ -178,6 +178,10 @@ namespace TrenchBroom {
             }
         };
 
+        const std::vector<Path>& FgdParser::includedFiles() const {
+            return m_includedFiles;
+        }
+
         void FgdParser::pushIncludePath(const Path& path) {
             ensure(path.isAbsolute(), "include path must be absolute");
             assert(!isRecursiveInclude(path));
@@ -720,6 +724,7 @@ namespace TrenchBroom {
                 status.debug(m_tokenizer.line(), "Resolved '" + path.asString() + "' to '" + filePath.asString() + "'");
 
                 if (!isRecursiveInclude(filePath)) {
+                    m_includedFiles.push_back(filePath);
                     const PushIncludePath pushIncludePath(this, filePath);
                     auto reader = file->reader().buffer();
                     m_tokenizer.replaceState(std::begin(reader), std::end(reader));
@@ -75,6 +75,7 @@ namespace TrenchBroom {
             Color m_defaultEntityColor;
 
             std::vector<Path> m_paths;
+            std::vector<Path> m_includedFiles;
             std::shared_ptr<FileSystem> m_fs;
 
             FgdTokenizer m_tokenizer;
@@ -83,6 +84,12 @@ namespace TrenchBroom {
             FgdParser(const char* begin, const char* end, const Color& defaultEntityColor, const Path& path);
             FgdParser(const std::string& str, const Color& defaultEntityColor, const Path& path);
             FgdParser(const std::string& str, const Color& defaultEntityColor);
+
+            /**
+             * Returns the absolute paths of all files that were included while parsing, in the order in which they
+             * were parsed.
+             */
+            const std::vector<Path>& includedFiles() const;
         private:
             class PushIncludePath;
             void pushIncludePath(const Path& path);
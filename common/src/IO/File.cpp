@@ -22,6 +22,15 @@
 #include "Exceptions.h"
 #include "IO/IOUtils.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace TrenchBroom {
     namespace IO {
         File::File(const Path& path) :
@@ -90,6 +99,107 @@ namespace TrenchBroom {
             return m_file;
         }
 
+#ifdef _WIN32
+        MappedFile::MappedFile(const Path& path) :
+        File(path),
+        m_begin(nullptr),
+        m_end(nullptr) {
+            const auto pathStr = path.asString();
+            HANDLE fileHandle = CreateFileA(pathStr.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (fileHandle == INVALID_HANDLE_VALUE) {
+                throw FileSystemException("Cannot open file " + pathStr);
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(fileHandle, &fileSize)) {
+                CloseHandle(fileHandle);
+                throw FileSystemException("Cannot get size of file " + pathStr);
+            }
+
+            // empty files cannot be mapped
+            if (fileSize.QuadPart > 0) {
+                // the view keeps the mapping alive, so both handles can be closed once the view is created
+                HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(fileHandle);
+                if (mappingHandle == nullptr) {
+                    throw FileSystemException("Cannot map file " + pathStr);
+                }
+
+                const auto* view = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mappingHandle);
+                if (view == nullptr) {
+                    throw FileSystemException("Cannot map file " + pathStr);
+                }
+
+                m_begin = view;
+                m_end = view + static_cast<size_t>(fileSize.QuadPart);
+            } else {
+                CloseHandle(fileHandle);
+            }
+        }
+
+        MappedFile::~MappedFile() {
+            if (m_begin != nullptr) {
+                UnmapViewOfFile(m_begin);
+            }
+        }
+#else
+        MappedFile::MappedFile(const Path& path) :
+        File(path),
+        m_begin(nullptr),
+        m_end(nullptr) {
+            const auto pathStr = path.asString();
+            const int fd = open(pathStr.c_str(), O_RDONLY);
+            if (fd == -1) {
+                throw FileSystemException("Cannot open file " + pathStr);
+            }
+
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) == -1) {
+                close(fd);
+                throw FileSystemException("Cannot get size of file " + pathStr);
+            }
+
+            // empty files cannot be mapped
+            const auto fileSize = static_cast<size_t>(fileStat.st_size);
+            if (fileSize > 0) {
+                void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED) {
+                    close(fd);
+                    throw FileSystemException("Cannot map file " + pathStr);
+                }
+
+                m_begin = static_cast<const char*>(addr);
+                m_end = m_begin + fileSize;
+            }
+
+            // the mapping remains valid after the file descriptor is closed
+            close(fd);
+        }
+
+        MappedFile::~MappedFile() {
+            if (m_begin != nullptr) {
+                munmap(const_cast<char*>(m_begin), size());
+            }
+        }
+#endif
+
+        Reader MappedFile::reader() const {
+            return Reader::from(m_begin, m_end);
+        }
+
+        size_t MappedFile::size() const {
+            return static_cast<size_t>(m_end - m_begin);
+        }
+
+        const char* MappedFile::begin() const {
+            return m_begin;
+        }
+
+        const char* MappedFile::end() const {
+            return m_end;
+        }
+
         FileView::FileView(const Path& path, std::shared_ptr<File> file, const size_t offset, const size_t length) :
         File(path),
         m_file(std::move(file)),
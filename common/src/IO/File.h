@@ -134,6 +134,43 @@ namespace TrenchBroom {
             std::FILE* file() const;
         };
 
+        /**
+         * A file that is backed by a physical file on the disk which is mapped into memory. The file is mapped in the
+         * constructor and unmapped in the destructor. Readers created for this file read directly from the mapped
+         * memory, so the file's contents are paged in on demand and never copied into a separate buffer.
+         */
+        class MappedFile : public File {
+        private:
+            const char* m_begin;
+            const char* m_end;
+        public:
+            /**
+             * Creates a new file with the given path and maps the file into memory.
+             *
+             * @param path the path of the file
+             *
+             * @throw FileSystemException if the file cannot be opened or mapped
+             */
+            explicit MappedFile(const Path& path);
+            ~MappedFile() override;
+
+            MappedFile(const MappedFile& other) = delete;
+            MappedFile& operator=(const MappedFile& other) = delete;
+
+            Reader reader() const override;
+            size_t size() const override;
+
+            /**
+             * Returns the beginning of the mapped memory region.
+             */
+            const char* begin() const;
+
+            /**
+             * Returns the end of the mapped memory region.
+             */
+            const char* end() const;
+        };
+
         /**
          * A file that is backed by a portion of a physical file.
          */
@@ -24,6 +24,7 @@
 
 #include <kdl/vector_utils.h>
 
+#include <cassert>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,11 @@ namespace TrenchBroom {
             return std::move(m_next);
         }
 
+        void FileSystem::setNext(std::shared_ptr<FileSystem> next) {
+            assert(m_next == nullptr);
+            m_next = std::move(next);
+        }
+
         bool FileSystem::canMakeAbsolute(const Path& path) const {
             return !path.isAbsolute();
         }
@@ -193,6 +199,27 @@ namespace TrenchBroom {
             throw FileSystemException("Cannot make absolute path of '" + path.asString() + "'");
         }
 
+        std::vector<DirectoryEntry> FileSystem::doGetDirectoryEntries(const Path& path, const bool recurse) const {
+            std::vector<DirectoryEntry> result;
+
+            std::vector<Path> directories = { Path() };
+            while (!directories.empty()) {
+                const auto directory = directories.back();
+                directories.pop_back();
+
+                for (const auto& itemPath : doGetDirectoryContents(path + directory)) {
+                    const auto entryPath = directory + itemPath;
+                    const auto isDirectory = doDirectoryExists(path + entryPath);
+                    if (isDirectory && recurse) {
+                        directories.push_back(entryPath);
+                    }
+                    result.push_back(DirectoryEntry{ entryPath, isDirectory });
+                }
+            }
+
+            return result;
+        }
+
         WritableFileSystem::WritableFileSystem() = default;
         WritableFileSystem::~WritableFileSystem() = default;
 
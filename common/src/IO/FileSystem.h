@@ -22,6 +22,7 @@
 
 #include "Exceptions.h"
 #include "Macros.h"
+#include "IO/DirectoryEntry.h"
 #include "IO/Path.h"
 
 #include <kdl/vector_utils.h>
@@ -56,6 +57,14 @@ namespace TrenchBroom {
             const FileSystem& next() const;
             std::shared_ptr<FileSystem> releaseNext();
 
+            /**
+             * Sets the next filesystem in the search path. This allows creating filesystems independently, e.g. in
+             * parallel, and chaining them afterwards.
+             *
+             * @param next the next filesystem, this filesystem must not have a next filesystem yet
+             */
+            void setNext(std::shared_ptr<FileSystem> next);
+
             bool canMakeAbsolute(const Path& path) const;
             Path makeAbsolute(const Path& path) const;
 
@@ -188,13 +197,10 @@ namespace TrenchBroom {
             template <class M>
             void doFindItems(const Path& searchPath, const M& matcher, const bool recurse, std::vector<Path>& result) const {
                 if (doDirectoryExists(searchPath)) {
-                    for (const auto& itemPath : doGetDirectoryContents(searchPath)) {
-                        const auto directory = doDirectoryExists(searchPath + itemPath);
-                        if (directory && recurse) {
-                            doFindItems(searchPath + itemPath, matcher, recurse, result);
-                        }
-                        if (matcher(searchPath + itemPath, directory)) {
-                            result.push_back(searchPath + itemPath);
+                    for (const auto& entry : doGetDirectoryEntries(searchPath, recurse)) {
+                        const auto itemPath = searchPath + entry.path;
+                        if (matcher(itemPath, entry.directory)) {
+                            result.push_back(itemPath);
                         }
                     }
                 }
@@ -208,6 +214,19 @@ namespace TrenchBroom {
 
             virtual std::vector<Path> doGetDirectoryContents(const Path& path) const = 0;
 
+            /**
+             * Lists the items in the given directory of this file system, optionally including the items in all of its
+             * sub directories. The returned paths are relative to the given directory.
+             *
+             * The default implementation lists each directory using doGetDirectoryContents and determines the type of
+             * each item using doDirectoryExists.
+             *
+             * @param path the path of an existing directory
+             * @param recurse whether to list the contents of sub directories, too
+             * @return the items found
+             */
+            virtual std::vector<DirectoryEntry> doGetDirectoryEntries(const Path& path, bool recurse) const;
+
             virtual std::shared_ptr<File> doOpenFile(const Path& path) const = 0;
         };
 
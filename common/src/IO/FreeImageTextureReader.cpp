@@ -27,11 +27,18 @@
 #include "Assets/TextureBuffer.h"
 #include "IO/File.h"
 #include "IO/ImageLoaderImpl.h"
+#include "IO/Path.h"
+#include "IO/TextureCache.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
 
 namespace TrenchBroom {
     namespace IO {
-        FreeImageTextureReader::FreeImageTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger) :
-        TextureReader(nameStrategy, fs, logger) {}
+        FreeImageTextureReader::FreeImageTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger, std::shared_ptr<const TextureCache> cache) :
+        TextureReader(nameStrategy, fs, logger),
+        m_cache(std::move(cache)) {}
 
         /**
          * The byte order of a 32bpp FIBITMAP is defined by the macros FI_RGBA_RED,
@@ -63,25 +70,71 @@ namespace TrenchBroom {
 
             const unsigned char* const data = buffer.data();
             const std::size_t bufferSize = buffer.size();
+            const std::size_t numPixels = bufferSize / 4;
+            if (numPixels == 0) {
+                return Color();
+            }
 
-            Color average;
+            // sum up the channels as integers, which is exact and much cheaper than accumulating float colors for
+            // large images
+            uint64_t sum[4] = { 0, 0, 0, 0 };
             for (std::size_t i = 0; i < bufferSize; i += 4) {
-                average = average + Color(data[i], data[i+1], data[i+2], data[i+3]);
+                sum[0] += data[i];
+                sum[1] += data[i+1];
+                sum[2] += data[i+2];
+                sum[3] += data[i+3];
             }
-            const std::size_t numPixels = bufferSize / 4;
-            average = average / static_cast<float>(numPixels);
 
-            return average;
+            const auto divisor = static_cast<float>(numPixels) * 255.0f;
+            return Color(static_cast<float>(sum[0]) / divisor, static_cast<float>(sum[1]) / divisor,
+                         static_cast<float>(sum[2]) / divisor, static_cast<float>(sum[3]) / divisor);
+        }
+
+        /**
+         * Copies the pixels of the given 24 or 32 bit image into the given buffer, top row first, expanding 24 bit
+         * pixels to 32 bits. This saves converting the image to a temporary 32 bit bitmap and copying that.
+         */
+        static void copyPixels(FIBITMAP* image, const size_t width, const size_t height, const size_t bytesPerPixel, unsigned char* outBytes) {
+            assert(bytesPerPixel == 3 || bytesPerPixel == 4);
+
+            const auto outBytesPerRow = width * 4;
+            for (size_t y = 0; y < height; ++y) {
+                // FreeImage stores the bottom row first
+                const auto* inRow = FreeImage_GetScanLine(image, static_cast<int>(height - y - 1));
+                auto* outRow = outBytes + y * outBytesPerRow;
+
+                if (bytesPerPixel == 4) {
+                    std::memcpy(outRow, inRow, outBytesPerRow);
+                } else {
+                    for (size_t x = 0; x < width; ++x) {
+                        const auto* inPixel = inRow + x * 3;
+                        auto* outPixel = outRow + x * 4;
+                        outPixel[FI_RGBA_RED]   = inPixel[FI_RGBA_RED];
+                        outPixel[FI_RGBA_GREEN] = inPixel[FI_RGBA_GREEN];
+                        outPixel[FI_RGBA_BLUE]  = inPixel[FI_RGBA_BLUE];
+                        outPixel[FI_RGBA_ALPHA] = 0xFF;
+                    }
+                }
+            }
         }
 
         Assets::Texture* FreeImageTextureReader::doReadTexture(std::shared_ptr<File> file) const {
             auto reader = file->reader().buffer();
 
-            InitFreeImage::initialize();
-
             const auto& path            = file->path();
             const auto* begin           = reader.begin();
             const auto* end             = reader.end();
+
+            const auto cacheEntryPath = m_cache != nullptr ? m_cache->entryPath(begin, end) : Path();
+            if (m_cache != nullptr) {
+                auto* cachedTexture = m_cache->readTexture(cacheEntryPath, textureName(path));
+                if (cachedTexture != nullptr) {
+                    return cachedTexture;
+                }
+            }
+
+            InitFreeImage::initialize();
+
             const auto  imageSize       = static_cast<size_t>(end - begin);
                   auto* imageBegin      = reinterpret_cast<BYTE*>(const_cast<char*>(begin));
                   auto* imageMemory     = FreeImage_OpenMemory(imageBegin, static_cast<DWORD>(imageSize));
@@ -97,12 +150,11 @@ namespace TrenchBroom {
             const auto imageHeight     = static_cast<size_t>(FreeImage_GetHeight(image));
 
             if (!checkTextureDimensions(imageWidth, imageHeight)) {
+                FreeImage_Unload(image);
                 FreeImage_CloseMemory(imageMemory);
                 throw AssetException("Invalid texture dimensions");
             }
 
-            const auto imageColourType = FreeImage_GetColorType(image);
-
             // This is supposed to indicate whether any pixels are transparent (alpha < 100%)
             const auto masked = FreeImage_IsTransparent(image);
 
@@ -111,20 +163,24 @@ namespace TrenchBroom {
             Assets::TextureBufferList buffers(mipCount);
             Assets::setMipBufferSize(buffers, mipCount, imageWidth, imageHeight, format);
 
-            const auto inputBytesPerPixel = FreeImage_GetLine(image) / FreeImage_GetWidth(image);
-            if (imageColourType != FIC_RGBALPHA || inputBytesPerPixel != 4) {
+            // 24 and 32 bit images are copied directly, all others are converted to 32 bits first
+            const auto isBitmap = FreeImage_GetImageType(image) == FIT_BITMAP;
+            const auto inputBitsPerPixel = FreeImage_GetBPP(image);
+            if (!isBitmap || (inputBitsPerPixel != 24 && inputBitsPerPixel != 32)) {
                 FIBITMAP* tempImage = FreeImage_ConvertTo32Bits(image);
                 FreeImage_Unload(image);
                 image = tempImage;
             }
 
-            const auto bytesPerPixel = FreeImage_GetLine(image) / FreeImage_GetWidth(image);
-            ensure(bytesPerPixel == 4, "expected to have converted image to 32-bit");
+            if (image == nullptr) {
+                FreeImage_CloseMemory(imageMemory);
+                throw AssetException("FreeImage could not convert image data");
+            }
 
-                  auto* outBytes = buffers.at(0).data();
-            const auto  outBytesPerRow = static_cast<int>(imageWidth * 4);
+            const auto bytesPerPixel = static_cast<size_t>(FreeImage_GetBPP(image)) / 8u;
+            ensure(bytesPerPixel == 3 || bytesPerPixel == 4, "expected a 24 or 32 bit image");
 
-            FreeImage_ConvertToRawBits(outBytes, image, outBytesPerRow, 32, FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK, TRUE);
+            copyPixels(image, imageWidth, imageHeight, bytesPerPixel, buffers.at(0).data());
 
             FreeImage_Unload(image);
             FreeImage_CloseMemory(imageMemory);
@@ -132,7 +188,51 @@ namespace TrenchBroom {
             const auto textureType = Assets::Texture::selectTextureType(masked);
             const Color averageColor = getAverageColor(buffers.at(0), format);
 
+            // Masked textures are uploaded without mipmaps. For all others, compute the mip chain here so that it is
+            // done on the loader thread and stored in the texture cache instead of being generated by the driver.
+            if (textureType != Assets::TextureType::Masked) {
+                Assets::generateMips(buffers, imageWidth, imageHeight, format);
+            }
+
+            if (m_cache != nullptr) {
+                m_cache->writeTexture(cacheEntryPath, imageWidth, imageHeight, averageColor, buffers, format, textureType);
+            }
+
             return new Assets::Texture(textureName(path), imageWidth, imageHeight, averageColor, std::move(buffers), format, textureType);
         }
+
+        std::optional<TextureReader::TextureHeader> FreeImageTextureReader::doReadTextureHeader(std::shared_ptr<File> file) const {
+            auto reader = file->reader().buffer();
+
+            const auto* begin = reader.begin();
+            const auto* end   = reader.end();
+
+            InitFreeImage::initialize();
+
+            const auto  imageSize   = static_cast<size_t>(end - begin);
+                  auto* imageBegin  = reinterpret_cast<BYTE*>(const_cast<char*>(begin));
+                  auto* imageMemory = FreeImage_OpenMemory(imageBegin, static_cast<DWORD>(imageSize));
+            const auto  imageFormat = FreeImage_GetFileTypeFromMemory(imageMemory);
+
+            // not every plugin can load an image header without decoding the pixels
+            if (imageFormat == FIF_UNKNOWN || !FreeImage_FIFSupportsNoPixels(imageFormat)) {
+                FreeImage_CloseMemory(imageMemory);
+                return std::nullopt;
+            }
+
+            auto* image = FreeImage_LoadFromMemory(imageFormat, imageMemory, FIF_LOAD_NOPIXELS);
+            if (image == nullptr) {
+                FreeImage_CloseMemory(imageMemory);
+                throw AssetException("FreeImage could not load image header");
+            }
+
+            const auto imageWidth  = static_cast<size_t>(FreeImage_GetWidth(image));
+            const auto imageHeight = static_cast<size_t>(FreeImage_GetHeight(image));
+
+            FreeImage_Unload(image);
+            FreeImage_CloseMemory(imageMemory);
+
+            return TextureHeader{textureName(file->path()), imageWidth, imageHeight};
+        }
     }
 }
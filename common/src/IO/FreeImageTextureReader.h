@@ -31,12 +31,20 @@ namespace TrenchBroom {
     namespace IO {
         class File;
         class FileSystem;
+        class TextureCache;
 
         class FreeImageTextureReader : public TextureReader {
+        private:
+            std::shared_ptr<const TextureCache> m_cache;
         public:
-            explicit FreeImageTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger);
+            /**
+             * Creates a new reader. If a texture cache is given, decoded images are stored in and read from that
+             * cache.
+             */
+            explicit FreeImageTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger, std::shared_ptr<const TextureCache> cache = nullptr);
         private:
             Assets::Texture* doReadTexture(std::shared_ptr<File> file) const override;
+            std::optional<TextureHeader> doReadTextureHeader(std::shared_ptr<File> file) const override;
         };
     }
 }
@@ -103,5 +103,10 @@ namespace TrenchBroom {
             std::fprintf(stream, "// Game: %s\n", gameName.c_str());
             std::fprintf(stream, "// Format: %s\n", mapFormat.c_str());
         }
+
+        void writeGameComment(std::string& output, const std::string& gameName, const std::string& mapFormat) {
+            output.append("// Game: ").append(gameName).append("\n");
+            output.append("// Format: ").append(mapFormat).append("\n");
+        }
     }
 }
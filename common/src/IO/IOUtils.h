@@ -47,6 +47,7 @@ namespace TrenchBroom {
         std::string readInfoComment(std::istream& stream, const std::string& name);
 
         void writeGameComment(FILE* stream, const std::string& gameName, const std::string& mapFormat);
+        void writeGameComment(std::string& output, const std::string& gameName, const std::string& mapFormat);
     }
 }
 
@@ -143,6 +143,18 @@ namespace TrenchBroom {
             return contents;
         }
 
+        void ImageFileSystemBase::Directory::index(const Path& path, std::unordered_map<std::string, const FileEntry*>& files, std::unordered_map<std::string, const Directory*>& directories) const {
+            directories[path.makeLowerCase().asString("/")] = this;
+
+            for (const auto& entry : m_files) {
+                files[(path + entry.first).makeLowerCase().asString("/")] = entry.second.get();
+            }
+
+            for (const auto& entry : m_directories) {
+                entry.second->index(path + entry.first, files, directories);
+            }
+        }
+
         ImageFileSystemBase::Directory& ImageFileSystemBase::Directory::findOrCreateDirectory(const Path& path) {
             if (path.isEmpty()) {
                 return *this;
@@ -170,37 +182,50 @@ namespace TrenchBroom {
             } catch (const std::exception& e) {
                 throw FileSystemException("Could not initialize image file system '" + m_path.asString() + "': " + e.what());
             }
+
+            m_fileIndex.clear();
+            m_directoryIndex.clear();
+            m_root.index(Path(), m_fileIndex, m_directoryIndex);
         }
 
         void ImageFileSystemBase::reload() {
+            m_fileIndex.clear();
+            m_directoryIndex.clear();
             m_root = Directory(Path());
             initialize();
         }
 
         bool ImageFileSystemBase::doDirectoryExists(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.directoryExists(searchPath);
+            return m_directoryIndex.count(indexKey(path)) > 0u;
         }
 
         bool ImageFileSystemBase::doFileExists(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.fileExists(searchPath);
+            return m_fileIndex.count(indexKey(path)) > 0u;
         }
 
         std::vector<Path> ImageFileSystemBase::doGetDirectoryContents(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            const auto& directory = m_root.findDirectory(path);
-            return directory.contents();
+            const auto it = m_directoryIndex.find(indexKey(path));
+            if (it == std::end(m_directoryIndex)) {
+                throw FileSystemException("Path does not exist: '" + path.asString() + "'");
+            }
+            return it->second->contents();
         }
 
         std::shared_ptr<File> ImageFileSystemBase::doOpenFile(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.findFile(path).open();
+            const auto it = m_fileIndex.find(indexKey(path));
+            if (it == std::end(m_fileIndex)) {
+                throw FileSystemException("File not found: '" + path.asString() + "'");
+            }
+            return it->second->open();
+        }
+
+        std::string ImageFileSystemBase::indexKey(const Path& path) {
+            return path.makeLowerCase().makeCanonical().asString("/");
         }
 
         ImageFileSystem::ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path) :
         ImageFileSystemBase(std::move(next), path),
-        m_file(std::make_shared<CFile>(path)) {
+        m_file(std::make_shared<MappedFile>(path)) {
             ensure(m_path.isAbsolute(), "path must be absolute");
         }
     }
@@ -27,10 +27,13 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace TrenchBroom {
     namespace IO {
-        class CFile;
+        class MappedFile;
         class File;
 
         class ImageFileSystemBase : public FileSystem {
@@ -85,12 +88,26 @@ namespace TrenchBroom {
                 const Directory& findDirectory(const Path& path) const;
                 const FileEntry& findFile(const Path& path) const;
                 std::vector<Path> contents() const;
+
+                /**
+                 * Adds the lower case paths of this directory and of all files and directories below it to the given
+                 * indices.
+                 */
+                void index(const Path& path, std::unordered_map<std::string, const FileEntry*>& files, std::unordered_map<std::string, const Directory*>& directories) const;
             private:
                 Directory& findOrCreateDirectory(const Path& path);
             };
         protected:
             Path m_path;
             Directory m_root;
+        private:
+            /**
+             * Map the lower case canonical path of every file and directory to its entry, so that a lookup is a single
+             * hash lookup instead of a search through the directory tree. They are rebuilt whenever the directory tree
+             * is read.
+             */
+            std::unordered_map<std::string, const FileEntry*> m_fileIndex;
+            std::unordered_map<std::string, const Directory*> m_directoryIndex;
         protected:
             ImageFileSystemBase(std::shared_ptr<FileSystem> next, const Path& path);
         public:
@@ -108,13 +125,15 @@ namespace TrenchBroom {
 
             std::vector<Path> doGetDirectoryContents(const Path& path) const override;
             std::shared_ptr<File> doOpenFile(const Path& path) const override;
+
+            static std::string indexKey(const Path& path);
         private:
             virtual void doReadDirectory() = 0;
         };
 
         class ImageFileSystem : public ImageFileSystemBase {
         protected:
-            std::shared_ptr<CFile> m_file;
+            std::shared_ptr<MappedFile> m_file;
         protected:
             ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path);
         };
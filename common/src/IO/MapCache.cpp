@@ -0,0 +1,333 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "Exceptions.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/EntityAttributes.h"
+
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace {
+            const char Magic[] = { 'T', 'B', 'M', 'C' };
+            const uint32_t Version = 1u;
+
+            /**
+             * The size of the header, which consists of the magic number, the version, the map format, and the size
+             * and hash of the map file.
+             */
+            const size_t HeaderSize = sizeof(Magic) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+
+            enum class Record : uint8_t {
+                FormatSet = 1,
+                BeginEntity = 2,
+                EndEntity = 3,
+                BeginBrush = 4,
+                EndBrush = 5,
+                BrushFace = 6,
+                End = 7
+            };
+        }
+
+        namespace MapCache {
+            Path cachePath(const Path& mapPath) {
+                return mapPath.addExtension("tbcache");
+            }
+
+            uint64_t hash(const char* begin, const char* end) {
+                // 64 bit FNV-1a
+                auto result = uint64_t(14695981039346656037ull);
+                for (const auto* c = begin; c != end; ++c) {
+                    result ^= static_cast<uint64_t>(static_cast<unsigned char>(*c));
+                    result *= uint64_t(1099511628211ull);
+                }
+                return result;
+            }
+        }
+
+        MapCacheWriter::MapCacheWriter(const Model::MapFormat format, const char* sourceBegin, const char* sourceEnd) {
+            m_buffer.append(Magic, sizeof(Magic));
+            writeValue(Version);
+            writeValue(static_cast<uint32_t>(format));
+            writeValue(static_cast<uint64_t>(sourceEnd - sourceBegin));
+            writeValue(MapCache::hash(sourceBegin, sourceEnd));
+        }
+
+        void MapCacheWriter::formatSet(const Model::MapFormat format) {
+            writeValue(Record::FormatSet);
+            writeValue(static_cast<uint32_t>(format));
+        }
+
+        void MapCacheWriter::beginEntity(const size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes) {
+            writeValue(Record::BeginEntity);
+            writeValue(static_cast<uint64_t>(line));
+            writeValue(static_cast<uint32_t>(attributes.size()));
+            for (const auto& attribute : attributes) {
+                writeString(attribute.name());
+                writeString(attribute.value());
+            }
+            writeExtraAttributes(extraAttributes);
+        }
+
+        void MapCacheWriter::endEntity(const size_t startLine, const size_t lineCount) {
+            writeValue(Record::EndEntity);
+            writeValue(static_cast<uint64_t>(startLine));
+            writeValue(static_cast<uint64_t>(lineCount));
+        }
+
+        void MapCacheWriter::beginBrush(const size_t line) {
+            writeValue(Record::BeginBrush);
+            writeValue(static_cast<uint64_t>(line));
+        }
+
+        void MapCacheWriter::endBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes) {
+            writeValue(Record::EndBrush);
+            writeValue(static_cast<uint64_t>(startLine));
+            writeValue(static_cast<uint64_t>(lineCount));
+            writeExtraAttributes(extraAttributes);
+        }
+
+        void MapCacheWriter::brushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY) {
+            writeValue(Record::BrushFace);
+            writeValue(static_cast<uint64_t>(line));
+            writeVec(point1);
+            writeVec(point2);
+            writeVec(point3);
+            writeVec(texAxisX);
+            writeVec(texAxisY);
+
+            writeString(attribs.textureName());
+            writeValue(attribs.xOffset());
+            writeValue(attribs.yOffset());
+            writeValue(attribs.rotation());
+            writeValue(attribs.xScale());
+            writeValue(attribs.yScale());
+            writeValue(static_cast<int32_t>(attribs.surfaceContents()));
+            writeValue(static_cast<int32_t>(attribs.surfaceFlags()));
+            writeValue(attribs.surfaceValue());
+
+            const auto& color = attribs.color();
+            writeValue(color.r());
+            writeValue(color.g());
+            writeValue(color.b());
+            writeValue(color.a());
+        }
+
+        void MapCacheWriter::write(const Path& path) const {
+            // write to a temporary file first so that a partially written cache is never picked up
+            const auto tempPath = path.addExtension("tmp");
+            {
+                std::ofstream stream(tempPath.asString().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!stream.is_open()) {
+                    throw FileSystemException("Cannot open file: " + tempPath.asString());
+                }
+
+                const auto end = Record::End;
+                stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+                stream.write(reinterpret_cast<const char*>(&end), sizeof(end));
+                if (!stream) {
+                    throw FileSystemException("Cannot write file: " + tempPath.asString());
+                }
+            }
+
+            std::remove(path.asString().c_str());
+            if (std::rename(tempPath.asString().c_str(), path.asString().c_str()) != 0) {
+                std::remove(tempPath.asString().c_str());
+                throw FileSystemException("Cannot write file: " + path.asString());
+            }
+        }
+
+        void MapCacheWriter::writeExtraAttributes(const ExtraAttributes& extraAttributes) {
+            writeValue(static_cast<uint32_t>(extraAttributes.size()));
+            for (const auto& [name, attribute] : extraAttributes) {
+                writeValue(static_cast<uint8_t>(attribute.type()));
+                writeString(name);
+                writeString(attribute.strValue());
+                writeValue(static_cast<uint64_t>(attribute.line()));
+                writeValue(static_cast<uint64_t>(attribute.column()));
+            }
+        }
+
+        template <typename T>
+        void MapCacheWriter::writeValue(const T value) {
+            m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void MapCacheWriter::writeString(const std::string& str) {
+            writeValue(static_cast<uint32_t>(str.size()));
+            m_buffer.append(str);
+        }
+
+        void MapCacheWriter::writeVec(const vm::vec3& vec) {
+            writeValue(static_cast<double>(vec.x()));
+            writeValue(static_cast<double>(vec.y()));
+            writeValue(static_cast<double>(vec.z()));
+        }
+
+        namespace {
+            std::string readString(Reader& reader) {
+                const auto size = reader.readSize<uint32_t>();
+                auto result = std::string(size, '\0');
+                reader.read(result.data(), size);
+                return result;
+            }
+
+            vm::vec3 readVec(Reader& reader) {
+                const auto x = reader.readDouble<double>();
+                const auto y = reader.readDouble<double>();
+                const auto z = reader.readDouble<double>();
+                return vm::vec3(x, y, z);
+            }
+
+            template <typename ExtraAttributes>
+            ExtraAttributes readExtraAttributes(Reader& reader) {
+                using ExtraAttribute = typename ExtraAttributes::mapped_type;
+
+                auto result = ExtraAttributes();
+                const auto count = reader.readSize<uint32_t>();
+                for (size_t i = 0; i < count; ++i) {
+                    const auto type = static_cast<typename ExtraAttribute::Type>(reader.readInt<uint8_t>());
+                    auto name = readString(reader);
+                    auto value = readString(reader);
+                    const auto line = reader.readSize<uint64_t>();
+                    const auto column = reader.readSize<uint64_t>();
+                    result.insert(std::make_pair(name, ExtraAttribute(type, name, value, line, column)));
+                }
+                return result;
+            }
+        }
+
+        MapCacheReader::MapCacheReader(const char* begin, const char* end) :
+        m_begin(begin),
+        m_end(end) {}
+
+        bool MapCacheReader::matches(const Model::MapFormat format, const char* sourceBegin, const char* sourceEnd) const {
+            const auto size = static_cast<size_t>(m_end - m_begin);
+            if (size < HeaderSize + sizeof(Record) || std::memcmp(m_begin, Magic, sizeof(Magic)) != 0) {
+                return false;
+            }
+
+            // a truncated cache file would be missing the end record
+            if (*(m_end - 1) != static_cast<char>(Record::End)) {
+                return false;
+            }
+
+            auto reader = Reader::from(m_begin + sizeof(Magic), m_end);
+            if (reader.readUnsignedInt<uint32_t>() != Version ||
+                reader.readUnsignedInt<uint32_t>() != static_cast<uint32_t>(format) ||
+                reader.readSize<uint64_t>() != static_cast<size_t>(sourceEnd - sourceBegin)) {
+                return false;
+            }
+
+            return reader.read<uint64_t, uint64_t>() == MapCache::hash(sourceBegin, sourceEnd);
+        }
+
+        void MapCacheReader::read(MapParser& parser, ParserStatus& status) const {
+            try {
+                auto reader = Reader::from(m_begin + HeaderSize, m_end);
+                while (true) {
+                    const auto record = static_cast<Record>(reader.readUnsignedChar<uint8_t>());
+                    switch (record) {
+                        case Record::FormatSet:
+                            parser.formatSet(static_cast<Model::MapFormat>(reader.readUnsignedInt<uint32_t>()));
+                            break;
+                        case Record::BeginEntity: {
+                            const auto line = reader.readSize<uint64_t>();
+                            const auto count = reader.readSize<uint32_t>();
+
+                            auto attributes = std::vector<Model::EntityAttribute>();
+                            attributes.reserve(count);
+                            for (size_t i = 0; i < count; ++i) {
+                                auto name = readString(reader);
+                                auto value = readString(reader);
+                                attributes.push_back(Model::EntityAttribute(name, value, nullptr));
+                            }
+
+                            const auto extraAttributes = readExtraAttributes<ExtraAttributes>(reader);
+                            parser.beginEntity(line, attributes, extraAttributes, status);
+                            break;
+                        }
+                        case Record::EndEntity: {
+                            const auto startLine = reader.readSize<uint64_t>();
+                            const auto lineCount = reader.readSize<uint64_t>();
+                            parser.endEntity(startLine, lineCount, status);
+                            break;
+                        }
+                        case Record::BeginBrush:
+                            parser.beginBrush(reader.readSize<uint64_t>(), status);
+                            break;
+                        case Record::EndBrush: {
+                            const auto startLine = reader.readSize<uint64_t>();
+                            const auto lineCount = reader.readSize<uint64_t>();
+                            const auto extraAttributes = readExtraAttributes<ExtraAttributes>(reader);
+                            parser.endBrush(startLine, lineCount, extraAttributes, status);
+                            break;
+                        }
+                        case Record::BrushFace: {
+                            const auto line = reader.readSize<uint64_t>();
+                            const auto point1 = readVec(reader);
+                            const auto point2 = readVec(reader);
+                            const auto point3 = readVec(reader);
+                            const auto texAxisX = readVec(reader);
+                            const auto texAxisY = readVec(reader);
+
+                            auto attribs = Model::BrushFaceAttributes(readString(reader));
+                            attribs.setXOffset(reader.readFloat<float>());
+                            attribs.setYOffset(reader.readFloat<float>());
+                            attribs.setRotation(reader.readFloat<float>());
+                            attribs.setXScale(reader.readFloat<float>());
+                            attribs.setYScale(reader.readFloat<float>());
+                            attribs.setSurfaceContents(reader.readInt<int32_t>());
+                            attribs.setSurfaceFlags(reader.readInt<int32_t>());
+                            attribs.setSurfaceValue(reader.readFloat<float>());
+
+                            const auto r = reader.readFloat<float>();
+                            const auto g = reader.readFloat<float>();
+                            const auto b = reader.readFloat<float>();
+                            const auto a = reader.readFloat<float>();
+                            attribs.setColor(Color(r, g, b, a));
+
+                            parser.brushFace(line, point1, point2, point3, attribs, texAxisX, texAxisY, status);
+                            break;
+                        }
+                        case Record::End:
+                            return;
+                        default:
+                            throw ParserException("Invalid map cache record");
+                    }
+                }
+            } catch (const ReaderException& e) {
+                throw ParserException(std::string("Corrupt map cache: ") + e.what());
+            }
+        }
+    }
+}
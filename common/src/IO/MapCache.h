@@ -0,0 +1,148 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapCache
+#define TrenchBroom_MapCache
+
+#include "FloatType.h"
+#include "IO/MapParser.h"
+#include "Model/MapFormat.h"
+
+#include <vecmath/forward.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushFaceAttributes;
+        class EntityAttribute;
+    }
+
+    namespace IO {
+        class ParserStatus;
+        class Path;
+
+        /**
+         * A map cache is a binary file that is stored next to a map file. It records the events that a map parser
+         * emitted while parsing the map file, so that the map can be loaded again by replaying these events instead of
+         * tokenizing and parsing the text.
+         *
+         * Every map cache stores the map format and the size and hash of the map file it was created from. A map cache
+         * is only used if all of these match the map file being loaded.
+         */
+        namespace MapCache {
+            /**
+             * Returns the path of the map cache file for the map file with the given path.
+             */
+            Path cachePath(const Path& mapPath);
+
+            /**
+             * Computes the hash of the given map file contents that is stored in a map cache.
+             */
+            uint64_t hash(const char* begin, const char* end);
+        }
+
+        /**
+         * Records the events emitted by a map parser and writes them to a map cache file.
+         *
+         * @see MapParser::setCacheWriter
+         */
+        class MapCacheWriter {
+        private:
+            using ExtraAttributes = MapParser::ExtraAttributes;
+            std::string m_buffer;
+        public:
+            /**
+             * Creates a new map cache writer for the map file with the given format and contents.
+             *
+             * @param format the map format
+             * @param sourceBegin the beginning of the map file contents
+             * @param sourceEnd the end of the map file contents
+             */
+            MapCacheWriter(Model::MapFormat format, const char* sourceBegin, const char* sourceEnd);
+
+            void formatSet(Model::MapFormat format);
+            void beginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes);
+            void endEntity(size_t startLine, size_t lineCount);
+            void beginBrush(size_t line);
+            void endBrush(size_t startLine, size_t lineCount, const ExtraAttributes& extraAttributes);
+            void brushFace(size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY);
+
+            /**
+             * Writes the recorded events to the map cache file with the given path, replacing any existing file.
+             *
+             * @param path the path of the map cache file
+             *
+             * @throw FileSystemException if the file cannot be written
+             */
+            void write(const Path& path) const;
+        private:
+            void writeExtraAttributes(const ExtraAttributes& extraAttributes);
+
+            template <typename T>
+            void writeValue(T value);
+            void writeString(const std::string& str);
+            void writeVec(const vm::vec3& vec);
+        };
+
+        /**
+         * Replays the events stored in a map cache file to a map parser.
+         */
+        class MapCacheReader {
+        private:
+            using ExtraAttributes = MapParser::ExtraAttributes;
+            const char* m_begin;
+            const char* m_end;
+        public:
+            /**
+             * Creates a new map cache reader for the given map cache file contents. The given memory must remain valid
+             * for the lifetime of this reader.
+             *
+             * @param begin the beginning of the map cache file contents
+             * @param end the end of the map cache file contents
+             */
+            MapCacheReader(const char* begin, const char* end);
+
+            /**
+             * Indicates whether the map cache is valid and was created from a map file with the given format and
+             * contents.
+             *
+             * @param format the map format
+             * @param sourceBegin the beginning of the map file contents
+             * @param sourceEnd the end of the map file contents
+             * @return true if the map cache can be used in place of the given map file contents
+             */
+            bool matches(Model::MapFormat format, const char* sourceBegin, const char* sourceEnd) const;
+
+            /**
+             * Replays the events stored in the map cache to the given parser.
+             *
+             * @param parser the parser to pass the events to
+             * @param status the parser status
+             *
+             * @throw ParserException if the map cache is corrupt
+             */
+            void read(MapParser& parser, ParserStatus& status) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapCache) */
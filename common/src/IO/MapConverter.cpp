@@ -0,0 +1,157 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapConverter.h"
+
+#include "Exceptions.h"
+#include "IO/MapFileSerializer.h"
+#include "Model/BrushFace.h"
+#include "Model/EntityAttributes.h"
+#include "Model/ModelFactoryImpl.h"
+
+#include <kdl/parallel.h>
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace {
+            bool hasParallelTexCoords(const Model::MapFormat format) {
+                return format == Model::MapFormat::Valve || format == Model::MapFormat::Quake2_Valve;
+            }
+        }
+
+        MapConverter::MapConverter(const char* begin, const char* end, const Model::MapFormat targetFormat, FILE* stream) :
+        StandardMapParser(begin, end),
+        m_targetFormat(targetFormat),
+        m_stream(stream),
+        m_output(nullptr),
+        m_formatter(MapFileSerializer::create(targetFormat, m_formatterOutput)),
+        m_entityNo(0u),
+        m_brushNo(0u) {}
+
+        MapConverter::MapConverter(const std::string& str, const Model::MapFormat targetFormat, std::string& output) :
+        StandardMapParser(str),
+        m_targetFormat(targetFormat),
+        m_stream(nullptr),
+        m_output(&output),
+        m_formatter(MapFileSerializer::create(targetFormat, m_formatterOutput)),
+        m_entityNo(0u),
+        m_brushNo(0u) {}
+
+        MapConverter::~MapConverter() = default;
+
+        bool MapConverter::canConvert(const Model::MapFormat sourceFormat, const Model::MapFormat targetFormat) {
+            if (sourceFormat == Model::MapFormat::Unknown || targetFormat == Model::MapFormat::Unknown) {
+                return false;
+            }
+            return !hasParallelTexCoords(sourceFormat) || hasParallelTexCoords(targetFormat);
+        }
+
+        void MapConverter::convert(const Model::MapFormat sourceFormat, ParserStatus& status) {
+            parseEntities(sourceFormat != Model::MapFormat::Unknown ? sourceFormat : detectFormat(), status);
+            flushBrushes();
+        }
+
+        void MapConverter::onFormatSet(const Model::MapFormat format) {
+            if (!canConvert(format, m_targetFormat)) {
+                throw FileFormatException("Cannot convert map from " + Model::formatName(format) + " to " + Model::formatName(m_targetFormat) + " format without losing texture alignment");
+            }
+            m_factory = std::make_unique<Model::ModelFactoryImpl>(format);
+        }
+
+        void MapConverter::onBeginEntity(const size_t /* line */, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& /* extraAttributes */, ParserStatus& /* status */) {
+            m_brushNo = 0u;
+
+            std::string buffer = "// entity " + std::to_string(m_entityNo) + "\n{\n";
+            for (const auto& attribute : attributes) {
+                m_formatter->formatEntityAttribute(buffer, attribute);
+            }
+            write(buffer);
+        }
+
+        void MapConverter::onEndEntity(const size_t /* startLine */, const size_t /* lineCount */, ParserStatus& /* status */) {
+            flushBrushes();
+            write("}\n");
+            ++m_entityNo;
+        }
+
+        void MapConverter::onBeginBrush(const size_t /* line */, ParserStatus& /* status */) {
+            m_pendingBrushes.push_back(PendingBrush{ m_brushNo, {} });
+        }
+
+        void MapConverter::onEndBrush(const size_t /* startLine */, const size_t /* lineCount */, const ExtraAttributes& /* extraAttributes */, ParserStatus& /* status */) {
+            ++m_brushNo;
+
+            // bounds the memory used for entities with many brushes, such as worldspawn
+            static const size_t MaxPendingBrushes = 4096u;
+            if (m_pendingBrushes.size() >= MaxPendingBrushes) {
+                flushBrushes();
+            }
+        }
+
+        void MapConverter::onBrushFace(const size_t /* line */, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& /* status */) {
+            assert(!m_pendingBrushes.empty());
+            m_pendingBrushes.back().faces.push_back(PendingFace{ point1, point2, point3, attribs, texAxisX, texAxisY });
+        }
+
+        void MapConverter::flushBrushes() {
+            if (m_pendingBrushes.empty()) {
+                return;
+            }
+
+            // consecutive brushes are converted into the same chunk so that small brushes are not converted one at a time
+            static const size_t BrushesPerChunk = 64u;
+            const auto chunkCount = (m_pendingBrushes.size() + BrushesPerChunk - 1u) / BrushesPerChunk;
+
+            auto chunks = std::vector<std::string>(chunkCount);
+            kdl::parallel_for(chunkCount, [&](const size_t chunkIndex) {
+                const auto first = chunkIndex * BrushesPerChunk;
+                const auto last = std::min(first + BrushesPerChunk, m_pendingBrushes.size());
+                for (size_t i = first; i < last; ++i) {
+                    writeBrush(chunks[chunkIndex], m_pendingBrushes[i]);
+                }
+            });
+
+            for (const auto& chunk : chunks) {
+                write(chunk);
+            }
+
+            m_pendingBrushes.clear();
+        }
+
+        void MapConverter::writeBrush(std::string& buffer, const PendingBrush& brush) const {
+            buffer.append("// brush " + std::to_string(brush.brushNo) + "\n{\n");
+            for (const auto& pendingFace : brush.faces) {
+                // the face's texture axes are computed in the source format and written in the target format
+                const auto face = std::unique_ptr<Model::BrushFace>(m_factory->createFace(pendingFace.point1, pendingFace.point2, pendingFace.point3, pendingFace.attribs, pendingFace.texAxisX, pendingFace.texAxisY));
+                m_formatter->formatBrushFace(buffer, face.get());
+            }
+            buffer.append("}\n");
+        }
+
+        void MapConverter::write(const std::string& buffer) {
+            if (m_stream != nullptr) {
+                std::fwrite(buffer.data(), 1u, buffer.size(), m_stream);
+            } else {
+                m_output->append(buffer);
+            }
+        }
+    }
+}
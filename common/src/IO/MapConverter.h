@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapConverter
+#define TrenchBroom_MapConverter
+
+#include "FloatType.h"
+#include "IO/StandardMapParser.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/MapFormat.h"
+
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class ModelFactory;
+    }
+
+    namespace IO {
+        class MapFileSerializer;
+        class ParserStatus;
+
+        /**
+         * Converts a map file to another map format without building a world.
+         *
+         * The entities are written as soon as they have been parsed. The faces of consecutive brushes are collected
+         * and then converted and formatted in parallel, so the converter never holds more than a bounded number of
+         * brushes, and it never computes any brush geometry.
+         *
+         * Layers, groups and all other entities are written as they appear in the input, so the output contains the
+         * same entities in the same order. Comments in the input are not preserved, and the caller is responsible for
+         * writing a game comment.
+         */
+        class MapConverter : public StandardMapParser {
+        private:
+            struct PendingFace {
+                vm::vec3 point1;
+                vm::vec3 point2;
+                vm::vec3 point3;
+                Model::BrushFaceAttributes attribs;
+                vm::vec3 texAxisX;
+                vm::vec3 texAxisY;
+            };
+
+            struct PendingBrush {
+                size_t brushNo;
+                std::vector<PendingFace> faces;
+            };
+
+            Model::MapFormat m_targetFormat;
+            FILE* m_stream;
+            std::string* m_output;
+            // only used to format faces and attributes, never written to
+            std::string m_formatterOutput;
+            std::unique_ptr<MapFileSerializer> m_formatter;
+            // creates the faces in the source format, which the formatter then writes in the target format
+            std::unique_ptr<Model::ModelFactory> m_factory;
+            std::vector<PendingBrush> m_pendingBrushes;
+            size_t m_entityNo;
+            size_t m_brushNo;
+        public:
+            /**
+             * Creates a converter that reads the map between the given pointers and writes it to the given file in the
+             * given format.
+             */
+            MapConverter(const char* begin, const char* end, Model::MapFormat targetFormat, FILE* stream);
+
+            /**
+             * Creates a converter that reads the given map and appends it to the given string in the given format.
+             */
+            MapConverter(const std::string& str, Model::MapFormat targetFormat, std::string& output);
+
+            ~MapConverter() override;
+
+            /**
+             * Indicates whether a map in the given source format can be converted to the given target format without
+             * losing its texture alignment. Maps with paraxial texture coordinates can be converted to formats with
+             * parallel texture coordinates, but not vice versa.
+             */
+            static bool canConvert(Model::MapFormat sourceFormat, Model::MapFormat targetFormat);
+
+            /**
+             * Converts the map. If the given source format is unknown, it is detected from the input.
+             *
+             * @throw FileFormatException if the map cannot be converted to the target format
+             * @throw ParserException if the map cannot be parsed
+             */
+            void convert(Model::MapFormat sourceFormat, ParserStatus& status);
+        private:
+            void onFormatSet(Model::MapFormat format) override;
+            void onBeginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) override;
+            void onEndEntity(size_t startLine, size_t lineCount, ParserStatus& status) override;
+            void onBeginBrush(size_t line, ParserStatus& status) override;
+            void onEndBrush(size_t startLine, size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) override;
+            void onBrushFace(size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) override;
+
+            void flushBrushes();
+            void writeBrush(std::string& buffer, const PendingBrush& brush) const;
+            void write(const std::string& buffer);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapConverter) */
@@ -26,92 +26,91 @@
 #include "Model/BrushFace.h"
 #include "Model/EntityAttributes.h"
 
+#include <kdl/parallel.h>
+#include <kdl/string_format.h>
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
 #include <memory>
-#include <sstream>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
         class QuakeFileSerializer : public MapFileSerializer {
-        private:
-            std::string FacePointFormat;
-            std::string TextureInfoFormat;
-            std::string ValveTextureInfoFormat;
         public:
             explicit QuakeFileSerializer(FILE* stream) :
-            MapFileSerializer(stream),
-            FacePointFormat(getFacePointFormat()),
-            TextureInfoFormat(" %s %.6g %.6g %.6g %.6g %.6g"),
-            ValveTextureInfoFormat(" %s [ %.6g %.6g %.6g %.6g ] [ %.6g %.6g %.6g %.6g ] %.6g %.6g %.6g") {}
-        private:
-            static std::string getFacePointFormat() {
-                std::stringstream str;
-                str <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g )";
-                return str.str();
-            }
+            MapFileSerializer(stream) {}
+
+            explicit QuakeFileSerializer(std::string& output) :
+            MapFileSerializer(output) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
+            size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
+                format(buffer, "\n");
                 return 1;
             }
         protected:
-            void writeFacePoints(FILE* stream, Model::BrushFace* face) {
+            void writeFacePoints(std::string& buffer, Model::BrushFace* face) const {
                 const Model::BrushFace::Points& points = face->points();
 
-                std::fprintf(stream, FacePointFormat.c_str(),
-                             points[0].x(),
-                             points[0].y(),
-                             points[0].z(),
-                             points[1].x(),
-                             points[1].y(),
-                             points[1].z(),
-                             points[2].x(),
-                             points[2].y(),
-                             points[2].z());
+                for (size_t i = 0u; i < 3u; ++i) {
+                    if (i > 0u) {
+                        buffer.append(" ");
+                    }
+                    buffer.append("( ");
+                    kdl::str_append_general(buffer, points[i].x(), FloatPrecision);
+                    buffer.append(" ");
+                    kdl::str_append_general(buffer, points[i].y(), FloatPrecision);
+                    buffer.append(" ");
+                    kdl::str_append_general(buffer, points[i].z(), FloatPrecision);
+                    buffer.append(" )");
+                }
             }
 
-            void writeTextureInfo(FILE* stream, Model::BrushFace* face) {
+            void writeTextureInfo(std::string& buffer, Model::BrushFace* face) const {
                 const std::string& textureName = face->textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face->textureName();
-                std::fprintf(stream, TextureInfoFormat.c_str(),
-                             textureName.c_str(),
-                             static_cast<double>(face->xOffset()),
-                             static_cast<double>(face->yOffset()),
-                             static_cast<double>(face->rotation()),
-                             static_cast<double>(face->xScale()),
-                             static_cast<double>(face->yScale()));
+                buffer.append(" ");
+                buffer.append(textureName);
+                writeTextureValue(buffer, static_cast<double>(face->xOffset()));
+                writeTextureValue(buffer, static_cast<double>(face->yOffset()));
+                writeTextureValue(buffer, static_cast<double>(face->rotation()));
+                writeTextureValue(buffer, static_cast<double>(face->xScale()));
+                writeTextureValue(buffer, static_cast<double>(face->yScale()));
             }
 
-            void writeValveTextureInfo(FILE* stream, Model::BrushFace* face) {
+            void writeValveTextureInfo(std::string& buffer, Model::BrushFace* face) const {
                 const std::string& textureName = face->textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face->textureName();
                 const vm::vec3 xAxis = face->textureXAxis();
                 const vm::vec3 yAxis = face->textureYAxis();
 
-                std::fprintf(stream, ValveTextureInfoFormat.c_str(),
-                             textureName.c_str(),
-
-                             xAxis.x(),
-                             xAxis.y(),
-                             xAxis.z(),
-                             static_cast<double>(face->xOffset()),
-
-                             yAxis.x(),
-                             yAxis.y(),
-                             yAxis.z(),
-                             static_cast<double>(face->yOffset()),
-
-                             static_cast<double>(face->rotation()),
-                             static_cast<double>(face->xScale()),
-                             static_cast<double>(face->yScale()));
+                buffer.append(" ");
+                buffer.append(textureName);
+
+                buffer.append(" [");
+                writeTextureValue(buffer, xAxis.x());
+                writeTextureValue(buffer, xAxis.y());
+                writeTextureValue(buffer, xAxis.z());
+                writeTextureValue(buffer, static_cast<double>(face->xOffset()));
+                buffer.append(" ] [");
+                writeTextureValue(buffer, yAxis.x());
+                writeTextureValue(buffer, yAxis.y());
+                writeTextureValue(buffer, yAxis.z());
+                writeTextureValue(buffer, static_cast<double>(face->yOffset()));
+                buffer.append(" ]");
+
+                writeTextureValue(buffer, static_cast<double>(face->rotation()));
+                writeTextureValue(buffer, static_cast<double>(face->xScale()));
+                writeTextureValue(buffer, static_cast<double>(face->yScale()));
+            }
+        private:
+            /**
+             * Appends a space and the given value with six significant digits, like printf's "%.6g".
+             */
+            static void writeTextureValue(std::string& buffer, const double value) {
+                buffer.append(" ");
+                kdl::str_append_general(buffer, value, 6);
             }
         };
 
@@ -122,21 +121,25 @@ namespace TrenchBroom {
             explicit Quake2FileSerializer(FILE* stream) :
             QuakeFileSerializer(stream),
             SurfaceAttributesFormat(" %d %d %.6g") {}
+
+            explicit Quake2FileSerializer(std::string& output) :
+            QuakeFileSerializer(output),
+            SurfaceAttributesFormat(" %d %d %.6g") {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
 
                 // Neverball's "mapc" doesn't like it if surface attributes aren't present.
                 // This suggests the Radiants always output these, so it's probably a compatibility danger.
-                writeSurfaceAttributes(stream, face);
+                writeSurfaceAttributes(buffer, face);
 
-                std::fprintf(stream, "\n");
+                format(buffer, "\n");
                 return 1;
             }
         protected:
-            void writeSurfaceAttributes(FILE* stream, Model::BrushFace* face) {
-                std::fprintf(stream, SurfaceAttributesFormat.c_str(),
+            void writeSurfaceAttributes(std::string& buffer, Model::BrushFace* face) const {
+                format(buffer, SurfaceAttributesFormat.c_str(),
                              face->surfaceContents(),
                              face->surfaceFlags(),
                              static_cast<double>(face->surfaceValue()));
@@ -147,13 +150,16 @@ namespace TrenchBroom {
         public:
             explicit Quake2ValveFileSerializer(FILE* stream) :
             Quake2FileSerializer(stream) {}
+
+            explicit Quake2ValveFileSerializer(std::string& output) :
+            Quake2FileSerializer(output) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                writeSurfaceAttributes(stream, face);
+            size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const override {
+                writeFacePoints(buffer, face);
+                writeValveTextureInfo(buffer, face);
+                writeSurfaceAttributes(buffer, face);
 
-                std::fprintf(stream, "\n");
+                format(buffer, "\n");
                 return 1;
             }
         };
@@ -165,24 +171,28 @@ namespace TrenchBroom {
             explicit DaikatanaFileSerializer(FILE* stream) :
             Quake2FileSerializer(stream),
             SurfaceColorFormat(" %d %d %d") {}
+
+            explicit DaikatanaFileSerializer(std::string& output) :
+            Quake2FileSerializer(output),
+            SurfaceColorFormat(" %d %d %d") {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
 
                 if (face->hasSurfaceAttributes() || face->hasColor()) {
-                    writeSurfaceAttributes(stream, face);
+                    writeSurfaceAttributes(buffer, face);
                 }
                 if (face->hasColor()) {
-                    writeSurfaceColor(stream, face);
+                    writeSurfaceColor(buffer, face);
                 }
 
-                std::fprintf(stream, "\n");
+                format(buffer, "\n");
                 return 1;
             }
         protected:
-            void writeSurfaceColor(FILE* stream, Model::BrushFace* face) {
-                std::fprintf(stream, SurfaceColorFormat.c_str(),
+            void writeSurfaceColor(std::string& buffer, Model::BrushFace* face) const {
+                format(buffer, SurfaceColorFormat.c_str(),
                              static_cast<int>(face->color().r()),
                              static_cast<int>(face->color().g()),
                              static_cast<int>(face->color().b()));
@@ -193,11 +203,14 @@ namespace TrenchBroom {
         public:
             explicit Hexen2FileSerializer(FILE* stream):
             QuakeFileSerializer(stream) {}
+
+            explicit Hexen2FileSerializer(std::string& output):
+            QuakeFileSerializer(output) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, " 0\n"); // extra value written here
+            size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
+                format(buffer, " 0\n"); // extra value written here
                 return 1;
             }
         };
@@ -206,86 +219,197 @@ namespace TrenchBroom {
         public:
             explicit ValveFileSerializer(FILE* stream) :
             QuakeFileSerializer(stream) {}
+
+            explicit ValveFileSerializer(std::string& output) :
+            QuakeFileSerializer(output) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
+            size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const override {
+                writeFacePoints(buffer, face);
+                writeValveTextureInfo(buffer, face);
+                format(buffer, "\n");
                 return 1;
             }
         };
 
-        std::unique_ptr<NodeSerializer> MapFileSerializer::create(const Model::MapFormat format, FILE* stream) {
+        /**
+         * Creates the serializer for the given format. The output is either a FILE* or a std::string&, and is passed
+         * on to the serializer's constructor.
+         */
+        template <typename Output>
+        static std::unique_ptr<MapFileSerializer> createSerializer(const Model::MapFormat format, Output& output) {
             switch (format) {
                 case Model::MapFormat::Standard:
-                    return std::make_unique<QuakeFileSerializer>(stream);
+                    return std::make_unique<QuakeFileSerializer>(output);
                 case Model::MapFormat::Quake2:
                     // TODO 2427: Implement Quake3 serializers and use them
                 case Model::MapFormat::Quake3:
                 case Model::MapFormat::Quake3_Legacy:
-                    return std::make_unique<Quake2FileSerializer>(stream);
+                    return std::make_unique<Quake2FileSerializer>(output);
                 case Model::MapFormat::Quake2_Valve:
-                    return std::make_unique<Quake2ValveFileSerializer>(stream);
+                    return std::make_unique<Quake2ValveFileSerializer>(output);
                 case Model::MapFormat::Daikatana:
-                    return std::make_unique<DaikatanaFileSerializer>(stream);
+                    return std::make_unique<DaikatanaFileSerializer>(output);
                 case Model::MapFormat::Valve:
-                    return std::make_unique<ValveFileSerializer>(stream);
+                    return std::make_unique<ValveFileSerializer>(output);
                 case Model::MapFormat::Hexen2:
-                    return std::make_unique<Hexen2FileSerializer>(stream);
+                    return std::make_unique<Hexen2FileSerializer>(output);
                 case Model::MapFormat::Unknown:
                     throw FileFormatException("Unknown map file format");
                 switchDefault()
             }
         }
 
+        std::unique_ptr<MapFileSerializer> MapFileSerializer::create(const Model::MapFormat format, FILE* stream) {
+            return createSerializer(format, stream);
+        }
+
+        std::unique_ptr<MapFileSerializer> MapFileSerializer::create(const Model::MapFormat format, std::string& output) {
+            return createSerializer(format, output);
+        }
+
         MapFileSerializer::MapFileSerializer(FILE* stream) :
         m_line(1),
-        m_stream(stream) {
+        m_stream(stream),
+        m_output(nullptr),
+        m_inBrush(false) {
             ensure(m_stream != nullptr, "stream is null");
         }
 
+        MapFileSerializer::MapFileSerializer(std::string& output) :
+        m_line(1),
+        m_stream(nullptr),
+        m_output(&output),
+        m_inBrush(false) {}
+
+        template <typename... Args>
+        void MapFileSerializer::print(const char* fmt, Args... args) {
+            std::string buffer;
+            format(buffer, fmt, args...);
+            write(buffer);
+        }
+
+        size_t MapFileSerializer::formatBrushFace(std::string& buffer, Model::BrushFace* face) const {
+            return doWriteBrushFace(buffer, face);
+        }
+
+        void MapFileSerializer::formatEntityAttribute(std::string& buffer, const Model::EntityAttribute& attribute) const {
+            format(buffer, "\"%s\" \"%s\"\n",
+                   escapeEntityAttribute(attribute.name()).c_str(),
+                   escapeEntityAttribute(attribute.value()).c_str());
+        }
+
         void MapFileSerializer::doBeginFile() {}
-        void MapFileSerializer::doEndFile() {}
+
+        void MapFileSerializer::doEndFile() {
+            flushBrushes();
+        }
 
         void MapFileSerializer::doBeginEntity(const Model::Node* /* node */) {
-            std::fprintf(m_stream, "// entity %u\n", entityNo());
+            flushBrushes();
+            print("// entity %u\n", entityNo());
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
+            print("{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndEntity(Model::Node* node) {
-            std::fprintf(m_stream, "}\n");
+            flushBrushes();
+            print("}\n");
             ++m_line;
             setFilePosition(node);
         }
 
         void MapFileSerializer::doEntityAttribute(const Model::EntityAttribute& attribute) {
-            std::fprintf(m_stream, "\"%s\" \"%s\"\n",
-                         escapeEntityAttribute( attribute.name()).c_str(),
-                         escapeEntityAttribute(attribute.value()).c_str());
+            flushBrushes();
+            std::string buffer;
+            formatEntityAttribute(buffer, attribute);
+            write(buffer);
             ++m_line;
         }
 
         void MapFileSerializer::doBeginBrush(const Model::Brush* /* brush */) {
-            std::fprintf(m_stream, "// brush %u\n", brushNo());
-            ++m_line;
-            m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
-            ++m_line;
+            m_pendingBrushes.push_back(PendingBrush{ nullptr, brushNo(), {}, {} });
+            m_inBrush = true;
         }
 
         void MapFileSerializer::doEndBrush(Model::Brush* brush) {
-            std::fprintf(m_stream, "}\n");
-            ++m_line;
-            setFilePosition(brush);
+            assert(m_inBrush);
+            m_pendingBrushes.back().brush = brush;
+            m_inBrush = false;
         }
 
         void MapFileSerializer::doBrushFace(Model::BrushFace* face) {
-            const size_t lines = doWriteBrushFace(m_stream, face);
-            face->setFilePosition(m_line, lines);
-            m_line += lines;
+            if (m_inBrush) {
+                m_pendingBrushes.back().faces.push_back(face);
+            } else {
+                std::string buffer;
+                const size_t lines = doWriteBrushFace(buffer, face);
+                write(buffer);
+                face->setFilePosition(m_line, lines);
+                m_line += lines;
+            }
+        }
+
+        void MapFileSerializer::flushBrushes() {
+            if (m_pendingBrushes.empty()) {
+                return;
+            }
+
+            // consecutive brushes are formatted into the same chunk so that small brushes are not formatted one at a time
+            static const size_t BrushesPerChunk = 64u;
+            const auto chunkCount = (m_pendingBrushes.size() + BrushesPerChunk - 1u) / BrushesPerChunk;
+
+            auto chunks = std::vector<std::string>(chunkCount);
+            kdl::parallel_for(chunkCount, [&](const size_t chunkIndex) {
+                const auto first = chunkIndex * BrushesPerChunk;
+                const auto last = std::min(first + BrushesPerChunk, m_pendingBrushes.size());
+                for (size_t i = first; i < last; ++i) {
+                    writeBrush(chunks[chunkIndex], m_pendingBrushes[i]);
+                }
+            });
+
+            for (const auto& chunk : chunks) {
+                write(chunk);
+            }
+
+            // the file positions must be set in order since they depend on the lines of all preceding brushes
+            for (auto& pendingBrush : m_pendingBrushes) {
+                ++m_line; // brush comment
+                const auto start = m_line;
+                ++m_line; // opening brace
+
+                for (size_t i = 0u; i < pendingBrush.faces.size(); ++i) {
+                    const auto lines = pendingBrush.faceLines[i];
+                    pendingBrush.faces[i]->setFilePosition(m_line, lines);
+                    m_line += lines;
+                }
+
+                ++m_line; // closing brace
+                pendingBrush.brush->setFilePosition(start, m_line - start);
+            }
+
+            m_pendingBrushes.clear();
+        }
+
+        void MapFileSerializer::writeBrush(std::string& buffer, PendingBrush& brush) const {
+            format(buffer, "// brush %u\n", brush.brushNo);
+            format(buffer, "{\n");
+
+            brush.faceLines.reserve(brush.faces.size());
+            for (auto* face : brush.faces) {
+                brush.faceLines.push_back(doWriteBrushFace(buffer, face));
+            }
+
+            format(buffer, "}\n");
+        }
+
+        void MapFileSerializer::write(const std::string& buffer) {
+            if (m_stream != nullptr) {
+                std::fwrite(buffer.data(), 1u, buffer.size(), m_stream);
+            } else {
+                m_output->append(buffer);
+            }
         }
 
         void MapFileSerializer::setFilePosition(Model::Node* node) {
@@ -299,5 +423,30 @@ namespace TrenchBroom {
             m_startLineStack.pop_back();
             return result;
         }
+
+        void MapFileSerializer::format(std::string& buffer, const char* fmt, ...) {
+            std::va_list args;
+            va_start(args, fmt);
+
+            std::va_list argsCopy;
+            va_copy(argsCopy, args);
+            char stackBuffer[256];
+            const auto length = std::vsnprintf(stackBuffer, sizeof(stackBuffer), fmt, argsCopy);
+            va_end(argsCopy);
+
+            if (length > 0) {
+                const auto size = static_cast<size_t>(length);
+                if (size < sizeof(stackBuffer)) {
+                    buffer.append(stackBuffer, size);
+                } else {
+                    const auto offset = buffer.size();
+                    buffer.resize(offset + size + 1u);
+                    std::vsnprintf(&buffer[offset], size + 1u, fmt, args);
+                    buffer.resize(offset + size);
+                }
+            }
+
+            va_end(args);
+        }
     }
 }
@@ -25,6 +25,7 @@
 
 #include <cstdio> // for FILE*
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -36,16 +37,51 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        /**
+         * Writes map files using C style formatting, either to a file or to a string.
+         *
+         * The brushes of an entity are not written immediately. Instead, they are collected until the entity ends and
+         * are then formatted into chunks in parallel. The chunks are written to the file in order, so the output is the
+         * same as if the brushes had been written one after another.
+         */
         class MapFileSerializer : public NodeSerializer {
         private:
+            struct PendingBrush {
+                Model::Brush* brush;
+                ObjectNo brushNo;
+                std::vector<Model::BrushFace*> faces;
+                std::vector<size_t> faceLines;
+            };
+
             using LineStack = std::vector<size_t>;
             LineStack m_startLineStack;
             size_t m_line;
             FILE* m_stream;
+            std::string* m_output;
+            std::vector<PendingBrush> m_pendingBrushes;
+            bool m_inBrush;
         public:
-            static std::unique_ptr<NodeSerializer> create(Model::MapFormat format, FILE* stream);
+            static std::unique_ptr<MapFileSerializer> create(Model::MapFormat format, FILE* stream);
+            /**
+             * Creates a serializer that appends the map to the given string instead of writing it to a file. The output
+             * is the same as if it had been written to a file.
+             */
+            static std::unique_ptr<MapFileSerializer> create(Model::MapFormat format, std::string& output);
+
+            /**
+             * Appends the given face to the given buffer in the format of this serializer and returns the number of
+             * lines that were appended. The face need not belong to a brush. This function may be called concurrently
+             * from multiple threads.
+             */
+            size_t formatBrushFace(std::string& buffer, Model::BrushFace* face) const;
+
+            /**
+             * Appends the given entity attribute to the given buffer in the format of this serializer.
+             */
+            void formatEntityAttribute(std::string& buffer, const Model::EntityAttribute& attribute) const;
         protected:
             explicit MapFileSerializer(FILE* file);
+            explicit MapFileSerializer(std::string& output);
         private:
             void doBeginFile() override;
             void doEndFile() override;
@@ -57,10 +93,22 @@ namespace TrenchBroom {
             void doEndBrush(Model::Brush* brush) override;
             void doBrushFace(Model::BrushFace* face) override;
         private:
+            void flushBrushes();
+            void writeBrush(std::string& buffer, PendingBrush& brush) const;
+            void write(const std::string& buffer);
+            template <typename... Args>
+            void print(const char* fmt, Args... args);
+
             void setFilePosition(Model::Node* node);
             size_t startLine();
+        protected:
+            static void format(std::string& buffer, const char* fmt, ...);
         private:
-            virtual size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) = 0;
+            /**
+             * Appends the given face to the given buffer and returns the number of lines that were appended. This
+             * function may be called concurrently from multiple threads.
+             */
+            virtual size_t doWriteBrushFace(std::string& buffer, Model::BrushFace* face) const = 0;
         };
     }
 }
@@ -20,6 +20,7 @@
 #include "MapParser.h"
 
 #include "Exceptions.h"
+#include "IO/MapCache.h"
 #include "Model/EntityAttributes.h"
 
 #include <list>
@@ -45,34 +46,67 @@ namespace TrenchBroom {
             return m_value;
         }
 
+        size_t MapParser::ExtraAttribute::line() const {
+            return m_line;
+        }
+
+        size_t MapParser::ExtraAttribute::column() const {
+            return m_column;
+        }
+
         void MapParser::ExtraAttribute::assertType(const Type expected) const {
             if (expected != m_type)
                 throw ParserException(m_line, m_column, "Invalid extra property type");
         }
 
+        MapParser::MapParser() :
+        m_cacheWriter(nullptr) {}
+
         MapParser::~MapParser() = default;
 
+        void MapParser::setCacheWriter(MapCacheWriter* cacheWriter) {
+            m_cacheWriter = cacheWriter;
+        }
+
         void MapParser::formatSet(const Model::MapFormat format) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->formatSet(format);
+            }
             onFormatSet(format);
         }
 
         void MapParser::beginEntity(const size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->beginEntity(line, attributes, extraAttributes);
+            }
             onBeginEntity(line, attributes, extraAttributes, status);
         }
 
         void MapParser::endEntity(const size_t startLine, const size_t lineCount, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->endEntity(startLine, lineCount);
+            }
             onEndEntity(startLine, lineCount, status);
         }
 
         void MapParser::beginBrush(const size_t line, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->beginBrush(line);
+            }
             onBeginBrush(line, status);
         }
 
         void MapParser::endBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->endBrush(startLine, lineCount, extraAttributes);
+            }
             onEndBrush(startLine, lineCount, extraAttributes, status);
         }
 
         void MapParser::brushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->brushFace(line, point1, point2, point3, attribs, texAxisX, texAxisY);
+            }
             onBrushFace(line, point1, point2, point3, attribs, texAxisX, texAxisY, status);
         }
     }
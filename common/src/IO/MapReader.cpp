@@ -19,6 +19,7 @@
 
 #include "MapReader.h"
 
+#include "IO/MapCache.h"
 #include "IO/ParserStatus.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
@@ -29,6 +30,7 @@
 #include "Model/ModelFactory.h"
 
 #include <kdl/map_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
@@ -67,27 +69,42 @@ namespace TrenchBroom {
         StandardMapParser(begin, end),
         m_factory(nullptr),
         m_brushParent(nullptr),
-        m_currentNode(nullptr) {}
+        m_currentNode(nullptr),
+        m_readingBrush(false) {}
 
         MapReader::MapReader(const std::string& str) :
         StandardMapParser(str),
         m_factory(nullptr),
         m_brushParent(nullptr),
-        m_currentNode(nullptr) {}
+        m_currentNode(nullptr),
+        m_readingBrush(false) {}
 
         MapReader::~MapReader() {
+            clearDeferredNodes();
             kdl::vec_clear_and_delete(m_faces);
         }
 
         void MapReader::readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
+            clearDeferredNodes();
             parseEntities(format, status);
+            createDeferredNodes(status);
+            resolveNodes(status);
+        }
+
+        void MapReader::readCachedEntities(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status) {
+            m_worldBounds = worldBounds;
+            clearDeferredNodes();
+            cache.read(*this, status);
+            createDeferredNodes(status);
             resolveNodes(status);
         }
 
         void MapReader::readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
+            clearDeferredNodes();
             parseBrushes(format, status);
+            createDeferredNodes(status);
         }
 
         void MapReader::readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
@@ -127,17 +144,24 @@ namespace TrenchBroom {
         }
 
         void MapReader::onBeginBrush(const size_t /* line */, ParserStatus& /* status */) {
-            assert(m_faces.empty());
+            assert(m_brushFaces.empty());
+            m_readingBrush = true;
         }
 
         void MapReader::onEndBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
+            m_readingBrush = false;
             createBrush(startLine, lineCount, extraAttributes, status);
         }
 
         void MapReader::onBrushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) {
-            Model::BrushFace* face = m_factory->createFace(point1, point2, point3, attribs, texAxisX, texAxisY);
-            face->setFilePosition(line, 1);
-            onBrushFace(face, status);
+            if (m_readingBrush) {
+                // The faces of a brush are created together with its geometry, see createDeferredNodes.
+                m_brushFaces.push_back(DeferredFace{line, point1, point2, point3, attribs, texAxisX, texAxisY});
+            } else {
+                Model::BrushFace* face = m_factory->createFace(point1, point2, point3, attribs, texAxisX, texAxisY);
+                face->setFilePosition(line, 1);
+                onBrushFace(face, status);
+            }
         }
 
         void MapReader::createLayer(const size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) {
@@ -222,19 +246,11 @@ namespace TrenchBroom {
             m_brushParent = entity;
         }
 
-        void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
-            try {
-                Model::Brush* brush = m_factory->createBrush(m_worldBounds, m_faces);
-                setFilePosition(brush, startLine, lineCount);
-                setExtraAttributes(brush, extraAttributes);
-
-                onBrush(m_brushParent, brush, status);
-                m_faces.clear();
-            } catch (GeometryException& e) {
-                status.error(startLine, kdl::str_to_string("Skipping brush: ", e.what()));
-                m_faces.clear(); // the faces will have been deleted by the brush's constructor
-            }
-
+        void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& /* status */) {
+            // The brush faces and geometry are built once parsing is complete, see createDeferredNodes.
+            m_deferredNodes.push_back(DeferredNode{m_brushParent, nullptr, m_deferredBrushes.size()});
+            m_deferredBrushes.push_back(DeferredBrush{std::move(m_brushFaces), startLine, lineCount, extraAttributes});
+            m_brushFaces.clear();
         }
 
         MapReader::ParentInfo::Type MapReader::storeNode(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, ParserStatus& status) {
@@ -246,7 +262,7 @@ namespace TrenchBroom {
                     Model::Layer* layer = kdl::map_find_or_default(m_layers, layerId,
                         static_cast<Model::Layer*>(nullptr));
                     if (layer != nullptr)
-                        onNode(layer, node, status);
+                        deferNode(layer, node);
                     else
                         m_unresolvedNodes.push_back(std::make_pair(node, ParentInfo::layer(layerId)));
                     return ParentInfo::Type_Layer;
@@ -262,7 +278,7 @@ namespace TrenchBroom {
                         Model::Group* group = kdl::map_find_or_default(m_groups, groupId,
                             static_cast<Model::Group*>(nullptr));
                         if (group != nullptr)
-                            onNode(group, node, status);
+                            deferNode(group, node);
                         else
                             m_unresolvedNodes.push_back(std::make_pair(node, ParentInfo::group(groupId)));
                         return ParentInfo::Type_Group;
@@ -272,7 +288,7 @@ namespace TrenchBroom {
                 }
             }
 
-            onNode(nullptr, node, status);
+            deferNode(nullptr, node);
             return ParentInfo::Type_None;
         }
 
@@ -290,6 +306,81 @@ namespace TrenchBroom {
             }
         }
 
+        void MapReader::deferNode(Model::Node* parent, Model::Node* node) {
+            m_deferredNodes.push_back(DeferredNode{parent, node, 0u});
+        }
+
+        /**
+         * Builds the geometry of all deferred brushes and then passes the deferred nodes and brushes to the subclass in
+         * the order in which they were parsed, so that the resulting node tree does not depend on the order in which the
+         * brushes were built.
+         *
+         * The geometry of each brush is independent of all other brushes, so the brushes are built in parallel. Building
+         * the geometry also validates it, and the number of invalid brushes is reported once all brushes were built.
+         */
+        void MapReader::createDeferredNodes(ParserStatus& status) {
+            using BrushResult = std::pair<Model::Brush*, std::string>;
+
+            const auto brushResults = kdl::vec_parallel_transform(m_deferredBrushes, [&](const DeferredBrush& deferredBrush) {
+                auto faces = std::vector<Model::BrushFace*>();
+                faces.reserve(deferredBrush.faces.size());
+                try {
+                    for (const auto& deferredFace : deferredBrush.faces) {
+                        auto* face = m_factory->createFace(deferredFace.point1, deferredFace.point2, deferredFace.point3, deferredFace.attribs, deferredFace.texAxisX, deferredFace.texAxisY);
+                        face->setFilePosition(deferredFace.line, 1);
+                        faces.push_back(face);
+                    }
+                } catch (const GeometryException& e) {
+                    kdl::vec_clear_and_delete(faces);
+                    return BrushResult(nullptr, e.what());
+                }
+
+                try {
+                    return BrushResult(m_factory->createBrush(m_worldBounds, faces), "");
+                } catch (const GeometryException& e) {
+                    // the faces will have been deleted by the brush's constructor
+                    return BrushResult(nullptr, e.what());
+                }
+            });
+
+            size_t skippedBrushCount = 0u;
+            for (const auto& deferredNode : m_deferredNodes) {
+                if (deferredNode.node != nullptr) {
+                    onNode(deferredNode.parent, deferredNode.node, status);
+                } else {
+                    const auto& deferredBrush = m_deferredBrushes[deferredNode.brushIndex];
+                    const auto& [brush, error] = brushResults[deferredNode.brushIndex];
+                    if (brush != nullptr) {
+                        setFilePosition(brush, deferredBrush.startLine, deferredBrush.lineCount);
+                        setExtraAttributes(brush, deferredBrush.extraAttributes);
+                        onBrush(deferredNode.parent, brush, status);
+                    } else {
+                        status.error(deferredBrush.startLine, kdl::str_to_string("Skipping brush: ", error));
+                        ++skippedBrushCount;
+                    }
+                }
+            }
+
+            // the individual errors are easily lost among the other messages of a large map
+            if (skippedBrushCount > 0u) {
+                status.warn(kdl::str_to_string("Skipped ", skippedBrushCount, " invalid ", kdl::str_plural(skippedBrushCount, "brush", "brushes"), " while loading"));
+            }
+
+            m_deferredNodes.clear();
+            m_deferredBrushes.clear();
+        }
+
+        void MapReader::clearDeferredNodes() {
+            for (const auto& deferredNode : m_deferredNodes) {
+                delete deferredNode.node;
+            }
+            m_deferredNodes.clear();
+
+            m_deferredBrushes.clear();
+            m_brushFaces.clear();
+            m_readingBrush = false;
+        }
+
         void MapReader::resolveNodes(ParserStatus& status) {
             for (const auto& entry : m_unresolvedNodes) {
                 Model::Node* node = entry.first;
@@ -22,10 +22,12 @@
 
 #include "FloatType.h"
 #include "IO/StandardMapParser.h"
+#include "Model/BrushFaceAttributes.h"
 #include "Model/IdType.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
+#include <vecmath/vec.h>
 
 #include <map>
 #include <string>
@@ -44,6 +46,7 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        class MapCacheReader;
         class ParserStatus;
 
         class MapReader : public StandardMapParser {
@@ -82,21 +85,60 @@ namespace TrenchBroom {
             using NodeParentPair = std::pair<Model::Node*, ParentInfo>;
             using NodeParentList = std::vector<NodeParentPair>;
 
+            /**
+             * A brush face that has been parsed, but not created yet.
+             */
+            struct DeferredFace {
+                size_t line;
+                vm::vec3 point1;
+                vm::vec3 point2;
+                vm::vec3 point3;
+                Model::BrushFaceAttributes attribs;
+                vm::vec3 texAxisX;
+                vm::vec3 texAxisY;
+            };
+
+            /**
+             * A brush that has been parsed, but whose faces and geometry have not been built yet.
+             */
+            struct DeferredBrush {
+                std::vector<DeferredFace> faces;
+                size_t startLine;
+                size_t lineCount;
+                ExtraAttributes extraAttributes;
+            };
+
+            /**
+             * A node that will be passed to onNode or onBrush once parsing is complete. If node is null, then the node is
+             * the brush built from the deferred brush with the given index.
+             */
+            struct DeferredNode {
+                Model::Node* parent;
+                Model::Node* node;
+                size_t brushIndex;
+            };
+
             vm::bbox3 m_worldBounds;
             Model::ModelFactory* m_factory;
 
             Model::Node* m_brushParent;
             Model::Node* m_currentNode;
+            bool m_readingBrush;
+            std::vector<DeferredFace> m_brushFaces;
             std::vector<Model::BrushFace*> m_faces;
 
             LayerMap m_layers;
             GroupMap m_groups;
             NodeParentList m_unresolvedNodes;
+
+            std::vector<DeferredBrush> m_deferredBrushes;
+            std::vector<DeferredNode> m_deferredNodes;
         protected:
             MapReader(const char* begin, const char* end);
             explicit MapReader(const std::string& str);
 
             void readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
+            void readCachedEntities(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status);
             void readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
             void readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
         public:
@@ -117,6 +159,10 @@ namespace TrenchBroom {
             ParentInfo::Type storeNode(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, ParserStatus& status);
             void stripParentAttributes(Model::AttributableNode* attributable, ParentInfo::Type parentType);
 
+            void deferNode(Model::Node* parent, Model::Node* node);
+            void createDeferredNodes(ParserStatus& status);
+            void clearDeferredNodes();
+
             void resolveNodes(ParserStatus& status);
             Model::Node* resolveParent(const ParentInfo& parentInfo) const;
 
@@ -24,9 +24,11 @@
 #include "Model/BrushFace.h"
 #include "Model/EntityAttributes.h"
 
+#include <kdl/string_format.h>
+
 #include <memory>
 #include <ostream>
-#include <sstream>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
@@ -45,7 +47,6 @@ namespace TrenchBroom {
             void writeFacePoints(std::ostream& stream, Model::BrushFace* face) {
                 const Model::BrushFace::Points& points = face->points();
 
-                stream.precision(FloatPrecision);
                 stream << "( " <<
                 ftos(points[0].x(), FloatPrecision) << " " <<
                 ftos(points[0].y(), FloatPrecision) << " " <<
@@ -73,23 +74,29 @@ namespace TrenchBroom {
                 const vm::vec3& xAxis = face->textureXAxis();
                 const vm::vec3& yAxis = face->textureYAxis();
 
-                stream.precision(6);
                 stream <<
                 textureName     << " " <<
                 "[ " <<
-                xAxis.x() << " " <<
-                xAxis.y() << " " <<
-                xAxis.z() << " " <<
-                face->xOffset()   <<
+                gtos(xAxis.x()) << " " <<
+                gtos(xAxis.y()) << " " <<
+                gtos(xAxis.z()) << " " <<
+                gtos(face->xOffset())   <<
                 " ] [ " <<
-                yAxis.x() << " " <<
-                yAxis.y() << " " <<
-                yAxis.z() << " " <<
-                face->yOffset()   <<
+                gtos(yAxis.x()) << " " <<
+                gtos(yAxis.y()) << " " <<
+                gtos(yAxis.z()) << " " <<
+                gtos(face->yOffset())   <<
                 " ] " <<
-                face->rotation() << " " <<
-                face->xScale()   << " " <<
-                face->yScale();
+                gtos(face->rotation()) << " " <<
+                gtos(face->xScale())   << " " <<
+                gtos(face->yScale());
+            }
+
+            /**
+             * Formats the given value with six significant digits, like the default formatting of std::ostream.
+             */
+            static std::string gtos(const double v) {
+                return kdl::str_format_general(v, 6);
             }
         };
 
@@ -216,26 +223,12 @@ namespace TrenchBroom {
 
         MapStreamSerializer::~MapStreamSerializer() = default;
 
-        template <typename T, typename P>
-        std::string ftos_helper(const T v, const P precision) {
-            std::ostringstream strout;
-            strout.precision(static_cast<std::streamsize>(precision));
-            strout << std::fixed  << v;
-
-            std::string str = strout.str() ;
-            size_t end = str.find_last_not_of('0');
-            if (str[end] == '.') {
-                --end;
-            }
-            return str.erase(end + 1);
-        }
-
         std::string MapStreamSerializer::ftos(const float v, const int precision) {
-            return ftos_helper(v, precision);
+            return kdl::str_format_fixed(static_cast<double>(v), precision);
         }
 
         std::string MapStreamSerializer::ftos(const double v, const int precision) {
-            return ftos_helper(v, precision);
+            return kdl::str_format_fixed(v, precision);
         }
 
         void MapStreamSerializer::doBeginFile() {}
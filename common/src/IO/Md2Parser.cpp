@@ -382,7 +382,7 @@ namespace TrenchBroom {
             }
 
             auto& modelFrame = model.loadFrame(frameIndex, frame.name, bounds.bounds());
-            surface.addIndexedMesh(modelFrame, builder.vertices(), builder.indices());
+            surface.addIndexedMesh(modelFrame, std::move(builder.vertices()), builder.indices());
         }
 
         std::vector<Assets::EntityModelVertex> Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const {
@@ -200,13 +200,13 @@ namespace TrenchBroom {
         }
 
         std::vector<Md3Parser::Md3Triangle> Md3Parser::parseTriangles(Reader reader, const size_t triangleCount) {
+            std::vector<size_t> indices;
+            reader.readArray<int32_t, size_t>(indices, 3u * triangleCount);
+
             std::vector<Md3Triangle> result;
             result.reserve(triangleCount);
             for (size_t i = 0; i < triangleCount; ++i) {
-                const auto i1 = reader.readSize<int32_t>();
-                const auto i2 = reader.readSize<int32_t>();
-                const auto i3 = reader.readSize<int32_t>();
-                result.push_back(Md3Triangle {i1, i2, i3});
+                result.push_back(Md3Triangle {indices[3u * i + 0u], indices[3u * i + 1u], indices[3u * i + 2u]});
             }
             return result;
         }
@@ -236,12 +236,13 @@ namespace TrenchBroom {
         }
 
         std::vector<vm::vec2f> Md3Parser::parseTexCoords(Reader reader, const size_t vertexCount) {
+            std::vector<float> coords;
+            reader.readArray<float, float>(coords, 2u * vertexCount);
+
             std::vector<vm::vec2f> result;
             result.reserve(vertexCount);
             for (size_t i = 0; i < vertexCount; ++i) {
-                const auto s = reader.readFloat<float>();
-                const auto t = reader.readFloat<float>();
-                result.emplace_back(s, t);
+                result.emplace_back(coords[2u * i + 0u], coords[2u * i + 1u]);
             }
             return result;
         }
@@ -276,7 +277,6 @@ namespace TrenchBroom {
         void Md3Parser::buildFrameSurface(Assets::EntityModelLoadedFrame& frame, Assets::EntityModelSurface& surface, const std::vector<Md3Parser::Md3Triangle>& triangles, const std::vector<Assets::EntityModelVertex>& vertices) {
             using Vertex = Assets::EntityModelVertex;
 
-            const auto rangeMap = Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0, 3 * triangles.size());
             std::vector<Vertex> frameVertices;
             frameVertices.reserve(3 * triangles.size());
 
@@ -296,7 +296,9 @@ namespace TrenchBroom {
                 frameVertices.push_back(v3);
             }
 
-            surface.addIndexedMesh(frame, frameVertices, rangeMap);
+            // skipped triangles must not be part of the index range
+            const auto rangeMap = Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0, frameVertices.size());
+            surface.addIndexedMesh(frame, std::move(frameVertices), rangeMap);
         }
     }
 }
@@ -393,7 +393,7 @@ namespace TrenchBroom {
             }
 
             auto& modelFrame = model.loadFrame(frameIndex, frame.name, bounds.bounds());
-            surface.addIndexedMesh(modelFrame, builder.vertices(), builder.indices());
+            surface.addIndexedMesh(modelFrame, std::move(builder.vertices()), builder.indices());
         }
 
         std::vector<Assets::EntityModelVertex> MdxParser::getVertices(const MdxFrame& frame, const MdxMeshVertexList& meshVertices) const {
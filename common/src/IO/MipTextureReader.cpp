@@ -62,7 +62,6 @@ namespace TrenchBroom {
             static const size_t MipLevels = 4;
 
             Color averageColor;
-            Assets::TextureBufferList buffers(MipLevels);
             size_t offset[MipLevels];
 
             ensure(!file->path().isEmpty(), "MipTextureReader::doReadTexture requires a path");
@@ -92,14 +91,17 @@ namespace TrenchBroom {
                                          ? Assets::PaletteTransparency::Index255Transparent
                                          : Assets::PaletteTransparency::Opaque;
 
-                Assets::setMipBufferSize(buffers, MipLevels, width, height, GL_RGBA);
+                // only the first mip level of masked textures is uploaded, so the others are not decoded
+                const auto decodedMipLevels = transparent == Assets::PaletteTransparency::Index255Transparent ? 1u : MipLevels;
+                Assets::TextureBufferList buffers(decodedMipLevels);
+                Assets::setMipBufferSize(buffers, decodedMipLevels, width, height, GL_RGBA);
                 auto palette = doGetPalette(reader, offset, width, height);
 
                 if (!palette.initialized()) {
                     throw AssetException("Palette is not initialized");
                 }
 
-                for (size_t i = 0; i < MipLevels; ++i) {
+                for (size_t i = 0; i < decodedMipLevels; ++i) {
                     reader.seekFromBegin(offset[i]);
                     const size_t size = mipSize(width, height, i);
 
@@ -118,5 +120,22 @@ namespace TrenchBroom {
                 throw AssetException(e.what());
             }
         }
+
+        std::optional<TextureReader::TextureHeader> MipTextureReader::doReadTextureHeader(std::shared_ptr<File> file) const {
+            ensure(!file->path().isEmpty(), "MipTextureReader::doReadTextureHeader requires a path");
+
+            const auto path = file->path();
+            const auto basename = path.lastComponent().deleteExtension().asString();
+            try {
+                auto reader = file->reader().buffer();
+                reader.readString(MipLayout::TextureNameLength);
+
+                const auto width = reader.readSize<int32_t>();
+                const auto height = reader.readSize<int32_t>();
+                return TextureHeader{textureName(basename, path), width, height};
+            } catch (const ReaderException& e) {
+                throw AssetException(e.what());
+            }
+        }
     }
 }
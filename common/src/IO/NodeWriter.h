@@ -25,6 +25,7 @@
 #include <cstdio> // FILE*
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -49,6 +50,11 @@ namespace TrenchBroom {
         public:
             NodeWriter(Model::World& world, FILE* stream);
             NodeWriter(Model::World& world, std::ostream& stream);
+            /**
+             * Creates a writer that appends to the given string. The output is the same as if it had been written to a
+             * file.
+             */
+            NodeWriter(Model::World& world, std::string& output);
             NodeWriter(Model::World& world, NodeSerializer* serializer);
 
             void writeMap();
@@ -190,7 +190,7 @@ namespace TrenchBroom {
                 builder.addPolygon(surface.skin(face.m_material), vertices);
             }
             // }
-            surface.addTexturedMesh(frame, builder.vertices(), builder.indices());
+            surface.addTexturedMesh(frame, std::move(builder.vertices()), builder.indices());
             return model;
         }
 
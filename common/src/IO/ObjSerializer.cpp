@@ -26,7 +26,11 @@
 #include "Model/BrushGeometry.h"
 #include "Model/Polyhedron.h"
 
+#include <kdl/string_format.h>
+
+#include <cstdio>
 #include <set>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
@@ -82,24 +86,40 @@ namespace TrenchBroom {
 
         void ObjFileSerializer::writeVertices() {
             std::fprintf(m_stream, "# vertices\n");
-            for (const vm::vec3& elem : m_vertices.list())
-                std::fprintf(m_stream, "v %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+            std::string line;
+            for (const vm::vec3& elem : m_vertices.list()) {
+                // no idea why I have to switch Y and Z
+                writeLine(line, "v", { elem.x(), elem.z(), -elem.y() });
+            }
         }
 
         void ObjFileSerializer::writeTexCoords() {
             std::fprintf(m_stream, "# texture coordinates\n");
+            std::string line;
             for (const vm::vec2f& elem : m_texCoords.list()) {
                 // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
                 // (see: https://github.com/kduske/TrenchBroom/issues/2851 )
-                std::fprintf(m_stream, "vt %.17g %.17g\n", static_cast<double>(elem.x()), static_cast<double>(-elem.y()));
+                writeLine(line, "vt", { static_cast<double>(elem.x()), static_cast<double>(-elem.y()) });
             }
         }
 
         void ObjFileSerializer::writeNormals() {
             std::fprintf(m_stream, "# face normals\n");
+            std::string line;
             for (const vm::vec3& elem : m_normals.list()) {
-                std::fprintf(m_stream, "vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+                // no idea why I have to switch Y and Z
+                writeLine(line, "vn", { elem.x(), elem.z(), -elem.y() });
+            }
+        }
+
+        void ObjFileSerializer::writeLine(std::string& line, const char* keyword, const std::initializer_list<double> values) {
+            line.assign(keyword);
+            for (const double value : values) {
+                line.append(" ");
+                kdl::str_append_general(line, value, FloatPrecision);
             }
+            line.append("\n");
+            std::fwrite(line.data(), 1u, line.size(), m_stream);
         }
 
         void ObjFileSerializer::writeObjects() {
@@ -140,7 +160,7 @@ namespace TrenchBroom {
         }
 
         void ObjFileSerializer::doEndBrush(Model::Brush* /* brush */) {
-            m_objects.push_back(m_currentObject);
+            m_objects.push_back(std::move(m_currentObject));
             m_currentObject.faces.clear();
         }
 
@@ -161,7 +181,7 @@ namespace TrenchBroom {
                 indexedVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
             }
 
-            m_currentObject.faces.push_back(Face(indexedVertices, face->textureName()));
+            m_currentObject.faces.push_back(Face(std::move(indexedVertices), face->textureName()));
         }
     }
 }
@@ -28,8 +28,10 @@
 #include <vecmath/forward.h>
 
 #include <cstdio>
-#include <map>
+#include <initializer_list>
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -48,7 +50,19 @@ namespace TrenchBroom {
             public:
                 using List = std::vector<V>;
             private:
-                using Map = std::map<V, size_t>;
+                struct Hash {
+                    size_t operator()(const V& v) const {
+                        std::hash<typename V::type> hash;
+
+                        size_t result = 0;
+                        for (size_t i = 0; i < V::size; ++i) {
+                            result = result * 31u + hash(v[i]);
+                        }
+                        return result;
+                    }
+                };
+
+                using Map = std::unordered_map<V, size_t, Hash>;
                 Map m_map;
                 List m_list;
             public:
@@ -127,6 +141,7 @@ namespace TrenchBroom {
             void writeVertices();
             void writeTexCoords();
             void writeNormals();
+            void writeLine(std::string& line, const char* keyword, std::initializer_list<double> values);
             void writeObjects();
             void writeFaces(const FaceList& faces);
 
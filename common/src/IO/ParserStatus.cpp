@@ -29,13 +29,19 @@ namespace TrenchBroom {
     namespace IO {
         ParserStatus::ParserStatus(Logger& logger, const std::string& prefix) :
         m_logger(logger),
-        m_prefix(prefix) {}
+        m_prefix(prefix),
+        m_lastProgress(-1.0) {}
 
         ParserStatus::~ParserStatus() {}
 
         void ParserStatus::progress(const double progress) {
             assert(progress >= 0.0 && progress <= 1.0);
-            doProgress(progress);
+
+            static const double ProgressStep = 0.01;
+            if (progress >= m_lastProgress + ProgressStep || progress < m_lastProgress || (progress == 1.0 && m_lastProgress < 1.0)) {
+                m_lastProgress = progress;
+                doProgress(progress);
+            }
         }
 
         void ParserStatus::debug(const size_t line, const size_t column, const std::string& str) {
@@ -31,11 +31,20 @@ namespace TrenchBroom {
         private:
             Logger& m_logger;
             std::string m_prefix;
+            /**
+             * The progress that was last passed to doProgress(), used to throttle progress reports.
+             */
+            double m_lastProgress;
         protected:
             explicit ParserStatus(Logger& logger, const std::string& prefix);
         public:
             virtual ~ParserStatus();
         public:
+            /**
+             * Reports the given progress. Since implementations may forward the progress to the UI, it is only passed
+             * on if it advanced by at least one percent since the last report, if parsing is done, or if it decreased
+             * because the status is reused for another file.
+             */
             void progress(double progress);
 
             void debug(size_t line, size_t column, const std::string& str);
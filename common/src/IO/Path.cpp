@@ -25,8 +25,8 @@
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
-#include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <iterator>
 #include <ostream>
 #include <string>
@@ -37,15 +37,19 @@ namespace TrenchBroom {
             return std::string_view("/\\");
         }
 
-        Path::Path(bool absolute, const std::vector<std::string>& components) :
-        m_components(components),
+        Path::Path(const bool absolute, std::string path) :
+        m_path(std::move(path)),
+        m_absolute(absolute) {}
+
+        Path::Path(const bool absolute, const std::vector<std::string>& components) :
+        m_path(kdl::str_join(components, "/")),
         m_absolute(absolute) {}
 
         Path::Path(const std::string& path) {
             const auto trimmed = kdl::str_trim(path);
-            m_components = kdl::str_split(trimmed, separators());
+            m_path = kdl::str_join(kdl::str_split(trimmed, separators()), "/");
 #ifdef _WIN32
-            m_absolute = (hasDriveSpec(m_components) ||
+            m_absolute = (hasDriveSpec(firstComponentView()) ||
                           (!trimmed.empty() && trimmed[0] == '/') ||
                           (!trimmed.empty() && trimmed[0] == '\\'));
 #else
@@ -57,9 +61,18 @@ namespace TrenchBroom {
             if (rhs.isAbsolute()) {
                 throw PathException("Cannot concatenate absolute path");
             }
-            auto components = m_components;
-            components.insert(std::end(components), std::begin(rhs.m_components), std::end(rhs.m_components));
-            return Path(m_absolute, components);
+            if (m_path.empty()) {
+                return Path(m_absolute, rhs.m_path);
+            } else if (rhs.m_path.empty()) {
+                return *this;
+            }
+
+            auto path = std::string();
+            path.reserve(m_path.size() + 1u + rhs.m_path.size());
+            path.append(m_path);
+            path.push_back('/');
+            path.append(rhs.m_path);
+            return Path(m_absolute, std::move(path));
         }
 
         int Path::compare(const Path& rhs, const bool caseSensitive) const {
@@ -69,13 +82,11 @@ namespace TrenchBroom {
                 return 1;
             }
 
-            const auto& rcomps = rhs.m_components;
-
-            size_t i = 0;
-            const auto max = m_components.size() < rcomps.size() ? m_components.size() : rcomps.size();
-            while (i < max) {
-                const auto& mcomp = m_components[i];
-                const auto& rcomp = rcomps[i];
+            auto myOffset = size_t(0);
+            auto rhsOffset = size_t(0);
+            while (myOffset < m_path.size() && rhsOffset < rhs.m_path.size()) {
+                const auto mcomp = nextComponent(m_path, myOffset);
+                const auto rcomp = nextComponent(rhs.m_path, rhsOffset);
                 const auto result = caseSensitive ? kdl::cs::str_compare(mcomp, rcomp) : kdl::ci::str_compare(mcomp,
                     rcomp);
                 if (result < 0) {
@@ -83,11 +94,13 @@ namespace TrenchBroom {
                 } else if (result > 0) {
                     return 1;
                 }
-                ++i;
             }
-            if (m_components.size() < rcomps.size()) {
+
+            const auto myDone = myOffset >= m_path.size();
+            const auto rhsDone = rhsOffset >= rhs.m_path.size();
+            if (myDone && !rhsDone) {
                 return -1;
-            } else if (m_components.size() > rcomps.size()) {
+            } else if (!myDone && rhsDone) {
                 return 1;
             } else {
                 return 0;
@@ -95,7 +108,7 @@ namespace TrenchBroom {
         }
 
         bool Path::operator==(const Path& rhs) const {
-            return compare(rhs) == 0;
+            return m_absolute == rhs.m_absolute && m_path == rhs.m_path;
         }
 
         bool Path::operator!= (const Path& rhs) const {
@@ -111,21 +124,31 @@ namespace TrenchBroom {
         }
 
         std::string Path::asString(const std::string_view separator) const {
-            if (m_absolute) {
+            auto result = std::string();
+            if (m_absolute
 #ifdef _WIN32
-                if (hasDriveSpec(m_components)) {
-                    return kdl::str_join(m_components, separator);
-                } else {
-                    return std::string(separator) + kdl::str_join(m_components, separator);
-                }
-#else
-                return std::string(separator) + kdl::str_join(m_components, separator);
+                && !hasDriveSpec(firstComponentView())
 #endif
+                ) {
+                result.reserve(separator.size() + m_path.size());
+                result.append(separator);
+            } else {
+                result.reserve(m_path.size());
             }
-            return kdl::str_join(m_components, separator);
-        }
-
 
+            if (separator == "/") {
+                result.append(m_path);
+            } else {
+                for (const auto c : m_path) {
+                    if (c == '/') {
+                        result.append(separator);
+                    } else {
+                        result.push_back(c);
+                    }
+                }
+            }
+            return result;
+        }
 
         std::vector<std::string> Path::asStrings(const std::vector<Path>& paths, const std::string_view separator) {
             auto result = std::vector<std::string>();
@@ -146,11 +169,14 @@ namespace TrenchBroom {
         }
 
         size_t Path::length() const {
-            return m_components.size();
+            if (m_path.empty()) {
+                return 0u;
+            }
+            return static_cast<size_t>(std::count(std::begin(m_path), std::end(m_path), '/')) + 1u;
         }
 
         bool Path::isEmpty() const {
-            return !m_absolute && m_components.empty();
+            return !m_absolute && m_path.empty();
         }
 
         Path Path::firstComponent() const {
@@ -159,12 +185,12 @@ namespace TrenchBroom {
             }
 
             if (!m_absolute) {
-                return Path(m_components.front());
+                return Path(std::string(firstComponentView()));
             }
 
 #ifdef _WIN32
-            if (hasDriveSpec(m_components)) {
-                return Path(m_components.front());
+            if (hasDriveSpec(firstComponentView())) {
+                return Path(std::string(firstComponentView()));
             }
 
             return Path("\\");
@@ -177,30 +203,22 @@ namespace TrenchBroom {
             if (isEmpty()) {
                 throw PathException("Cannot delete first component of empty path");
             }
-            if (!m_absolute) {
-                auto components = std::vector<std::string>();
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components) + 1, std::end(m_components));
-                return Path(false, components);
-            }
+            if (!m_absolute
 #ifdef _WIN32
-            if (!m_components.empty() && hasDriveSpec(m_components[0])) {
-                std::vector<std::string> components;
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components) + 1, std::end(m_components));
-                return Path(false, components);
-            }
-            return Path(false, m_components);
-#else
-            return Path(false, m_components);
+                || hasDriveSpec(firstComponentView())
 #endif
+                ) {
+                const auto offset = componentOffset(1u);
+                return Path(false, offset < m_path.size() ? m_path.substr(offset) : std::string());
+            }
+            return Path(false, m_path);
         }
 
         Path Path::lastComponent() const {
             if (isEmpty())
                 throw PathException("Cannot return last component of empty path");
-            if (!m_components.empty()) {
-                return Path(m_components.back());
+            if (!m_path.empty()) {
+                return Path(std::string(lastComponentView()));
             } else {
                 return Path("");
             }
@@ -211,13 +229,11 @@ namespace TrenchBroom {
                 throw PathException("Cannot delete last component of empty path");
             }
 
-            if (!m_components.empty()) {
-                auto components = std::vector<std::string>();
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components), std::end(m_components) - 1);
-                return Path(m_absolute, components);
+            const auto separator = m_path.rfind('/');
+            if (separator == std::string::npos) {
+                return Path(m_absolute, std::string());
             } else {
-                return Path(m_absolute, m_components);
+                return Path(m_absolute, m_path.substr(0u, separator));
             }
         }
 
@@ -226,11 +242,11 @@ namespace TrenchBroom {
         }
 
         Path Path::suffix(const size_t count) const {
-            return subPath(m_components.size() - count, count);
+            return subPath(length() - count, count);
         }
 
         Path Path::subPath(const size_t index, const size_t count) const {
-            if (index + count > m_components.size()) {
+            if (index + count > length()) {
                 throw PathException("Sub path out of bounds");
             }
 
@@ -238,16 +254,21 @@ namespace TrenchBroom {
                 return Path("");
             }
 
-            auto newComponents = std::vector<std::string>();
-            newComponents.reserve(count);
-            for (size_t i = 0u; i < count; ++i) {
-                newComponents.push_back(m_components[index + i]);
-            }
-            return Path(m_absolute && index == 0, newComponents);
+            const auto first = componentOffset(index);
+            const auto last = componentOffset(index + count);
+            // the last offset points past the separator that follows the last component of the sub path
+            return Path(m_absolute && index == 0, m_path.substr(first, last - first - 1u));
         }
 
-        const std::vector<std::string>& Path::components() const {
-            return m_components;
+        std::vector<std::string> Path::components() const {
+            auto result = std::vector<std::string>();
+            result.reserve(length());
+
+            auto offset = size_t(0);
+            while (offset < m_path.size()) {
+                result.emplace_back(nextComponent(m_path, offset));
+            }
+            return result;
         }
 
         std::string Path::filename() const {
@@ -255,11 +276,7 @@ namespace TrenchBroom {
                 throw PathException("Cannot get filename of empty path");
             }
 
-            if (m_components.empty()) {
-                return "";
-            } else {
-                return m_components.back();
-            }
+            return std::string(lastComponentView());
         }
 
         std::string Path::basename() const {
@@ -267,12 +284,12 @@ namespace TrenchBroom {
                 throw PathException("Cannot get basename of empty path");
             }
 
-            const auto filename = this->filename();
+            const auto filename = lastComponentView();
             const auto dotIndex = filename.rfind('.');
             if (dotIndex == std::string::npos) {
-                return filename;
+                return std::string(filename);
             } else {
-                return filename.substr(0, dotIndex);
+                return std::string(filename.substr(0, dotIndex));
             }
         }
 
@@ -281,12 +298,12 @@ namespace TrenchBroom {
                 throw PathException("Cannot get extension of empty path");
             }
 
-            const auto filename = this->filename();
+            const auto filename = lastComponentView();
             const auto dotIndex = filename.rfind('.');
             if (dotIndex == std::string::npos) {
                 return "";
             } else {
-                return filename.substr(dotIndex + 1);
+                return std::string(filename.substr(dotIndex + 1));
             }
         }
 
@@ -358,17 +375,15 @@ namespace TrenchBroom {
                 throw PathException("Cannot add extension to empty path");
             }
 
-            auto components = m_components;
-            if (components.empty()
+            auto path = m_path;
 #ifdef _WIN32
-                || hasDriveSpec(m_components.back())
-#endif
-                ) {
-                components.push_back("." + extension);
-            } else {
-                components.back() += "." + extension;
+            if (!path.empty() && hasDriveSpec(lastComponentView())) {
+                path.push_back('/');
             }
-            return Path(m_absolute, components);
+#endif
+            path.push_back('.');
+            path.append(extension);
+            return Path(m_absolute, std::move(path));
         }
 
         Path Path::replaceExtension(const std::string& extension) const {
@@ -391,9 +406,9 @@ namespace TrenchBroom {
                     isAbsolute() && absolutePath.isAbsolute()
 #ifdef _WIN32
                     &&
-                    !m_components.empty() && !absolutePath.m_components.empty()
+                    !m_path.empty() && !absolutePath.m_path.empty()
                     &&
-                    m_components[0] == absolutePath.m_components[0]
+                    firstComponentView() == absolutePath.firstComponentView()
 #endif
             );
         }
@@ -420,13 +435,13 @@ namespace TrenchBroom {
             }
 
 #ifdef _WIN32
-            if (m_components.empty()) {
+            if (m_path.empty()) {
                 throw PathException("Cannot make relative path from an reference path with no drive spec");
             }
 
-            return Path(false, kdl::vec_slice_suffix(m_components, m_components.size() - 1u));
+            return deleteFirstComponent();
 #else
-            return Path(false, m_components);
+            return Path(false, m_path);
 #endif
 
 
@@ -450,19 +465,19 @@ namespace TrenchBroom {
             }
 
 #ifdef _WIN32
-            if (m_components.empty()) {
+            if (m_path.empty()) {
                 throw PathException("Cannot make relative path from an reference path with no drive spec");
             }
-            if (absolutePath.m_components.empty()) {
+            if (absolutePath.m_path.empty()) {
                 throw PathException("Cannot make relative path with sub path with no drive spec");
             }
-            if (m_components[0] != absolutePath.m_components[0]) {
+            if (firstComponentView() != absolutePath.firstComponentView()) {
                 throw PathException("Cannot make relative path if reference path has different drive spec");
             }
 #endif
 
-            const auto myResolved = resolvePath(true, m_components);
-            const auto theirResolved = resolvePath(true, absolutePath.m_components);
+            const auto myResolved = resolvePath(true, components());
+            const auto theirResolved = resolvePath(true, absolutePath.components());
 
             // cross off all common prefixes
             size_t p = 0;
@@ -486,16 +501,11 @@ namespace TrenchBroom {
         }
 
         Path Path::makeCanonical() const {
-            return Path(m_absolute, resolvePath(m_absolute, m_components));
+            return Path(m_absolute, resolvePath(m_absolute, components()));
         }
 
         Path Path::makeLowerCase() const {
-            auto lcComponents = std::vector<std::string>();
-            lcComponents.reserve(m_components.size());
-            for (const auto& component : m_components) {
-                lcComponents.push_back(kdl::str_to_lower(component));
-            }
-            return Path(m_absolute, lcComponents);
+            return Path(m_absolute, kdl::str_to_lower(m_path));
         }
 
         std::vector<Path> Path::makeAbsoluteAndCanonical(const std::vector<Path>& paths, const Path& relativePath) {
@@ -507,22 +517,30 @@ namespace TrenchBroom {
             return result;
         }
 
-#ifdef _WIN32
-        bool Path::hasDriveSpec(const std::vector<std::string>& components) {
-            if (components.empty()) {
-                return false;
+        std::string_view Path::firstComponentView() const {
+            auto offset = size_t(0);
+            return nextComponent(m_path, offset);
+        }
+
+        std::string_view Path::lastComponentView() const {
+            const auto separator = m_path.rfind('/');
+            if (separator == std::string::npos) {
+                return m_path;
             } else {
-                return hasDriveSpec(components[0]);
+                return std::string_view(m_path).substr(separator + 1u);
             }
         }
-#else
-        bool Path::hasDriveSpec(const std::vector<std::string>& /* components */) {
-            return false;
+
+        size_t Path::componentOffset(const size_t index) const {
+            auto offset = size_t(0);
+            for (size_t i = 0u; i < index && offset < m_path.size(); ++i) {
+                nextComponent(m_path, offset);
+            }
+            return offset;
         }
-#endif
 
 #ifdef _WIN32
-        bool Path::hasDriveSpec(const std::string& component) {
+        bool Path::hasDriveSpec(const std::string_view component) {
             if (component.size() <= 1) {
                 return false;
             } else {
@@ -530,7 +548,7 @@ namespace TrenchBroom {
             }
         }
 #else
-        bool Path::hasDriveSpec(const std::string& /* component */) {
+        bool Path::hasDriveSpec(const std::string_view /* component */) {
             return false;
         }
 #endif
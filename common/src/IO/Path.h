@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_Path
 #define TrenchBroom_Path
 
+#include <algorithm>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -43,14 +44,29 @@ namespace TrenchBroom {
                 StringLess m_less;
             public:
                 bool operator()(const Path& lhs, const Path& rhs) const {
-                    return std::lexicographical_compare(std::begin(lhs.m_components), std::end(lhs.m_components),
-                                                        std::begin(rhs.m_components), std::end(rhs.m_components), m_less);
+                    auto lhsOffset = size_t(0);
+                    auto rhsOffset = size_t(0);
+                    while (lhsOffset < lhs.m_path.size() && rhsOffset < rhs.m_path.size()) {
+                        const auto lhsComponent = nextComponent(lhs.m_path, lhsOffset);
+                        const auto rhsComponent = nextComponent(rhs.m_path, rhsOffset);
+                        if (m_less(lhsComponent, rhsComponent)) {
+                            return true;
+                        } else if (m_less(rhsComponent, lhsComponent)) {
+                            return false;
+                        }
+                    }
+                    return lhsOffset >= lhs.m_path.size() && rhsOffset < rhs.m_path.size();
                 }
             };
         private:
-            std::vector<std::string> m_components;
+            /**
+             * The components of this path, joined by '/' regardless of the platform. Storing the components in a single
+             * string avoids one allocation per component, and short paths do not allocate at all.
+             */
+            std::string m_path;
             bool m_absolute;
 
+            Path(bool absolute, std::string path);
             Path(bool absolute, const std::vector<std::string>& components);
         public:
             explicit Path(const std::string& path = "");
@@ -75,7 +91,7 @@ namespace TrenchBroom {
             Path prefix(size_t count) const;
             Path suffix(size_t count) const;
             Path subPath(size_t index, size_t count) const;
-            const std::vector<std::string>& components() const;
+            std::vector<std::string> components() const;
 
             std::string filename() const;
             std::string basename() const;
@@ -113,8 +129,22 @@ namespace TrenchBroom {
 
             static std::vector<Path> makeAbsoluteAndCanonical(const std::vector<Path>& paths, const Path& relativePath);
         private:
-            static bool hasDriveSpec(const std::vector<std::string>& components);
-            static bool hasDriveSpec(const std::string& component);
+            /**
+             * Returns the component of the given joined path that starts at the given offset, and advances the offset
+             * to the start of the next component. The offset exceeds the size of the path after the last component.
+             */
+            static std::string_view nextComponent(const std::string_view path, size_t& offset) {
+                const auto end = std::min(path.find('/', offset), path.size());
+                const auto result = path.substr(offset, end - offset);
+                offset = end + 1u;
+                return result;
+            }
+
+            std::string_view firstComponentView() const;
+            std::string_view lastComponentView() const;
+            size_t componentOffset(size_t index) const;
+
+            static bool hasDriveSpec(std::string_view component);
             std::vector<std::string> resolvePath(bool absolute, const std::vector<std::string>& components) const;
         };
 
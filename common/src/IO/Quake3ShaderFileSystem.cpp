@@ -23,13 +23,17 @@
 #include "Assets/Quake3Shader.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
+#include "IO/ParserStatus.h"
 #include "IO/Quake3ShaderParser.h"
-#include "IO/SimpleParserStatus.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -49,21 +53,76 @@ namespace TrenchBroom {
             }
         }
 
+        namespace {
+            /**
+             * Collects the messages of a parser so that they can be logged after parsing, since the logger must not
+             * be used by the worker threads.
+             */
+            class CollectingParserStatus : public ParserStatus {
+            private:
+                NullLogger m_nullLogger;
+                std::vector<std::pair<LogLevel, std::string>> m_messages;
+            public:
+                explicit CollectingParserStatus(const std::string& prefix) :
+                ParserStatus(m_nullLogger, prefix) {}
+
+                std::vector<std::pair<LogLevel, std::string>> releaseMessages() {
+                    return std::move(m_messages);
+                }
+            private:
+                void doProgress(const double /* progress */) override {}
+
+                void doLog(const LogLevel level, const std::string& str) override {
+                    m_messages.emplace_back(level, str);
+                }
+            };
+
+            struct ShaderFileResult {
+                std::vector<Assets::Quake3Shader> shaders;
+                std::vector<std::pair<LogLevel, std::string>> messages;
+                std::string error;
+            };
+        }
+
         std::vector<Assets::Quake3Shader> Quake3ShaderFileSystem::loadShaders() const {
             auto result = std::vector<Assets::Quake3Shader>();
 
             if (next().directoryExists(m_shaderSearchPath)) {
                 const auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
+
+                auto files = std::vector<std::shared_ptr<File>>();
+                files.reserve(paths.size());
                 for (const auto& path : paths) {
-                    const auto file = next().openFile(path);
+                    files.push_back(next().openFile(path));
+                }
+
+                // The shader files are independent of each other, so they are parsed in parallel. The results are
+                // collected in the order of the files so that later shaders still override earlier ones.
+                auto fileResults = kdl::vec_parallel_transform(files, [](const auto& file) {
+                    auto fileResult = ShaderFileResult();
                     auto bufferedReader = file->reader().buffer();
 
+                    CollectingParserStatus status(file->path().asString());
                     try {
                         Quake3ShaderParser parser(std::begin(bufferedReader), std::end(bufferedReader));
-                        SimpleParserStatus status(m_logger, file->path().asString());
-                        kdl::vec_append(result, parser.parse(status));
+                        fileResult.shaders = parser.parse(status);
                     } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        fileResult.error = e.what();
+                    }
+                    fileResult.messages = status.releaseMessages();
+                    return fileResult;
+                });
+
+                for (size_t i = 0u; i < fileResults.size(); ++i) {
+                    auto& fileResult = fileResults[i];
+                    for (const auto& [level, message] : fileResult.messages) {
+                        m_logger.log(level, message);
+                    }
+
+                    if (fileResult.error.empty()) {
+                        kdl::vec_append(result, fileResult.shaders);
+                    } else {
+                        m_logger.warn() << "Skipping malformed shader file " << paths[i] << ": " << fileResult.error;
                     }
                 }
             }
@@ -89,24 +148,36 @@ namespace TrenchBroom {
 
         void Quake3ShaderFileSystem::linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders) {
             m_logger.debug() << "Linking textures...";
+
+            // Index the shaders by path so that each texture finds its shader with a single lookup. If several shaders
+            // have the same path, the first one is linked to the texture.
+            auto shadersByPath = std::unordered_map<std::string, size_t>();
+            for (size_t i = 0u; i < shaders.size(); ++i) {
+                shadersByPath.emplace(shaders[i].shaderPath.asString("/"), i);
+            }
+
+            // The paths of the shaders linked so far; like the file names in this file system, they are compared
+            // case insensitively.
+            auto linkedPaths = std::unordered_set<std::string>();
+            auto linkedShaders = std::vector<bool>(shaders.size(), false);
+
             for (const auto& texture : textures) {
                 const auto shaderPath = texture.deleteExtension();
 
                 // Only link a shader if it has not been linked yet.
-                if (!fileExists(shaderPath)) {
-                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader){
-                        return shaderPath == shader.shaderPath;
-                    });
+                if (linkedPaths.insert(shaderPath.makeLowerCase().asString("/")).second) {
+                    const auto shaderIt = shadersByPath.find(shaderPath.asString("/"));
 
-                    if (shaderIt != std::end(shaders)) {
+                    if (shaderIt != std::end(shadersByPath)) {
                         // Found a matching shader.
-                        auto& shader = *shaderIt;
+                        const auto& shader = shaders[shaderIt->second];
 
                         auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
                         m_root.addFile(shaderPath, shaderFile);
 
-                        // Remove the shader so that we don't revisit it when linking standalone shaders.
-                        shaders.erase(shaderIt);
+                        // Mark the shader so that we don't revisit it when linking standalone shaders.
+                        linkedShaders[shaderIt->second] = true;
+                        shadersByPath.erase(shaderIt);
                     } else {
                         // No matching shader found, generate one.
                         auto shader = Assets::Quake3Shader();
@@ -118,6 +189,14 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            auto unlinkedShaders = std::vector<Assets::Quake3Shader>();
+            for (size_t i = 0u; i < shaders.size(); ++i) {
+                if (!linkedShaders[i]) {
+                    unlinkedShaders.push_back(std::move(shaders[i]));
+                }
+            }
+            shaders = std::move(unlinkedShaders);
         }
 
         void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders) {
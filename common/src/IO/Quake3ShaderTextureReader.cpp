@@ -85,8 +85,13 @@ namespace TrenchBroom {
                 throw AssetException("Image file '" + imagePath.asString() + "' does not exist");
             }
 
+            // the error is reported by the caller, which also loads the default texture if necessary
             FreeImageTextureReader imageReader(StaticNameStrategy(name), m_fs, m_logger);
-            return imageReader.readTexture(m_fs.openFile(imagePath));
+            auto* texture = imageReader.tryReadTexture(m_fs.openFile(imagePath));
+            if (texture == nullptr) {
+                throw AssetException("Could not read image file '" + imagePath.asString() + "'");
+            }
+            return texture;
         }
 
         Path Quake3ShaderTextureReader::findTexturePath(const Assets::Quake3Shader& shader) const {
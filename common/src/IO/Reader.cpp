@@ -117,7 +117,9 @@ namespace TrenchBroom {
         }
 
         std::tuple<const char*, const char*, std::unique_ptr<char[]>> Reader::FileSource::doBuffer() const {
-            std::fseek(m_file, static_cast<long>(m_offset), SEEK_SET);
+            if (std::fseek(m_file, static_cast<long>(m_offset), SEEK_SET) != 0) {
+                throwError("fseek failed");
+            }
 
             auto buffer = std::make_unique<char[]>(m_length);
             const auto read = std::fread(buffer.get(), 1, m_length, m_file);
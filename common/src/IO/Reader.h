@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -314,6 +315,10 @@ namespace TrenchBroom {
              * Buffers the contents of this reader's source if necessary and returns a buffered reader that manages
              * the buffered data and allows access to it.
              *
+             * If this reader reads from memory, e.g. from a mapped file or from a memory buffer, then the returned
+             * reader is a view of that memory, and no data is copied. The contents are only copied if this reader
+             * reads from a C file.
+             *
              * @return the buffered data
              *
              * @throw ReaderException if reading the data from the underlying reader source fails
@@ -480,13 +485,39 @@ namespace TrenchBroom {
 
             template <typename R, size_t S, typename T=R>
             vm::vec<T,S> readVec() {
+                // all components are read at once
+                T values[S];
+                read(reinterpret_cast<char*>(values), sizeof(values));
+
                 vm::vec<T,S> result;
                 for (size_t i = 0; i < S; ++i) {
-                    result[i] = read<T, R>();
+                    result[i] = static_cast<T>(static_cast<R>(values[i]));
                 }
                 return result;
             }
 
+            /**
+             * Reads the given number of values of the given type T, converts them to the given type R and appends them
+             * to the given vector. All values are read at once, which is much faster than reading them one by one.
+             *
+             * @tparam T the type of the values to read
+             * @tparam R the type of the values to convert to
+             * @param result the vector to append the values to
+             * @param n the number of values to read
+             *
+             * @throw ReaderException if reading fails
+             */
+            template <typename T, typename R>
+            void readArray(std::vector<R>& result, const size_t n) {
+                std::vector<T> values(n);
+                read(reinterpret_cast<char*>(values.data()), n * sizeof(T));
+
+                result.reserve(result.size() + n);
+                for (const auto& value : values) {
+                    result.push_back(static_cast<R>(value));
+                }
+            }
+
             /**
              * Reads values of the given type T, converts them to the given type R and stores them in the given
              * collection. The collection must support push_back.
@@ -44,7 +44,7 @@ namespace TrenchBroom {
     namespace IO {
         std::unique_ptr<Assets::Texture> loadDefaultTexture(const FileSystem& fs, Logger& logger, const std::string& name) {
             // recursion guard
-            static bool executing = false;
+            thread_local bool executing = false;
             if (!executing) {
                 const kdl::set_temp set_executing(executing);
                 
@@ -24,6 +24,7 @@
 #include "Model/EntityAttributes.h"
 
 #include <kdl/invoke.h>
+#include <kdl/string_utils.h>
 #include <kdl/vector_set.h>
 
 #include <vecmath/plane.h>
@@ -132,6 +133,165 @@ namespace TrenchBroom {
             return Token(QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column());
         }
 
+        namespace {
+            bool isBlank(const char c) {
+                return c == ' ' || c == '\t';
+            }
+
+            bool isDigit(const char c) {
+                return c >= '0' && c <= '9';
+            }
+
+            bool isNumberDelim(const char* c, const char* end) {
+                return c == end || *c == ' ' || *c == '\t' || *c == '\n' || *c == '\r' || *c == ')';
+            }
+
+            const char* skipBlanks(const char* c, const char* end) {
+                while (c != end && isBlank(*c)) {
+                    ++c;
+                }
+                return c;
+            }
+
+            const char* skipDigits(const char* c, const char* end) {
+                while (c != end && isDigit(*c)) {
+                    ++c;
+                }
+                return c;
+            }
+
+            /**
+             * Scans a number starting at c. Accepts exactly what Tokenizer::readDecimal accepts and converts it in the
+             * same way as Token::toFloat, but returns nullptr if the number cannot be converted so that the caller can
+             * fall back to the generic parser, which handles such errors.
+             */
+            const char* scanNumber(const char* c, const char* end, double& value) {
+                const auto* begin = c;
+                if (c == end || (*c != '+' && *c != '-' && *c != '.' && !isDigit(*c))) {
+                    return nullptr;
+                }
+
+                if (*c != '.') {
+                    c = skipDigits(c + 1, end);
+                }
+                if (c != end && *c == '.') {
+                    c = skipDigits(c + 1, end);
+                }
+                if (c != end && *c == 'e') {
+                    ++c;
+                    if (c != end && (*c == '+' || *c == '-' || isDigit(*c))) {
+                        c = skipDigits(c + 1, end);
+                    }
+                }
+
+                if (!isNumberDelim(c, end)) {
+                    return nullptr;
+                }
+
+                const auto result = kdl::str_to_double(begin, c);
+                if (!result) {
+                    return nullptr;
+                }
+
+                value = *result;
+                return c;
+            }
+
+            const char* scanNumbers(const char* c, const char* end, double* values, const size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    c = skipBlanks(c, end);
+                    c = scanNumber(c, end, values[i]);
+                    if (c == nullptr) {
+                        return nullptr;
+                    }
+                }
+                return c;
+            }
+
+            /**
+             * Scans the given number of values enclosed by the given delimiters, such as `( x y z )`.
+             */
+            const char* scanDelimitedNumbers(const char* c, const char* end, const char open, const char close, double* values, const size_t count) {
+                c = skipBlanks(c, end);
+                if (c == end || *c != open) {
+                    return nullptr;
+                }
+
+                c = scanNumbers(c + 1, end, values, count);
+                if (c == nullptr) {
+                    return nullptr;
+                }
+
+                c = skipBlanks(c, end);
+                if (c == end || *c != close) {
+                    return nullptr;
+                }
+                return c + 1;
+            }
+
+            const char* scanFacePoints(const char* c, const char* end, std::array<double, 9>& points) {
+                for (size_t i = 0; i < 3; ++i) {
+                    c = scanDelimitedNumbers(c, end, '(', ')', &points[3 * i], 3);
+                    if (c == nullptr) {
+                        return nullptr;
+                    }
+                }
+                return c;
+            }
+        }
+
+        const char* QuakeMapTokenizer::scanTextureName(const char* c, const char* end, std::string_view& textureName) const {
+            c = skipBlanks(c, end);
+            const auto* textureBegin = c;
+            while (c != end && !isAnyOf(*c, Whitespace())) {
+                ++c;
+            }
+            if (c == textureBegin || *textureBegin == '"') {
+                return nullptr;
+            }
+            textureName = std::string_view(textureBegin, static_cast<size_t>(c - textureBegin));
+            return c;
+        }
+
+        std::optional<StandardFace> QuakeMapTokenizer::readStandardFace() {
+            discardWhile(Whitespace());
+
+            const auto* begin = curPos();
+            const auto* end = endPos();
+            const auto* c = begin;
+
+            auto face = StandardFace();
+            if ((c = scanFacePoints(c, end, face.points)) == nullptr ||
+                (c = scanTextureName(c, end, face.textureName)) == nullptr ||
+                (c = scanNumbers(c, end, face.attributes.data(), face.attributes.size())) == nullptr) {
+                return std::nullopt;
+            }
+
+            // advance the tokenizer state to keep track of lines and columns
+            advance(static_cast<size_t>(c - begin));
+            return face;
+        }
+
+        std::optional<ValveFace> QuakeMapTokenizer::readValveFace() {
+            discardWhile(Whitespace());
+
+            const auto* begin = curPos();
+            const auto* end = endPos();
+            const auto* c = begin;
+
+            auto face = ValveFace();
+            if ((c = scanFacePoints(c, end, face.points)) == nullptr ||
+                (c = scanTextureName(c, end, face.textureName)) == nullptr ||
+                (c = scanDelimitedNumbers(c, end, '[', ']', &face.axes[0], 4)) == nullptr ||
+                (c = scanDelimitedNumbers(c, end, '[', ']', &face.axes[4], 4)) == nullptr ||
+                (c = scanNumbers(c, end, face.attributes.data(), face.attributes.size())) == nullptr) {
+                return std::nullopt;
+            }
+
+            advance(static_cast<size_t>(c - begin));
+            return face;
+        }
+
         const std::string StandardMapParser::BrushPrimitiveId = "brushDef";
         const std::string StandardMapParser::PatchId = "patchDef2";
 
@@ -437,15 +597,7 @@ namespace TrenchBroom {
         void StandardMapParser::parseQuakeFace(ParserStatus& status) {
             const auto line = m_tokenizer.line();
 
-            const auto [p1, p2, p3] = parseFacePoints(status);
-            const auto textureName = parseTextureName(status);
-
-            auto attribs = Model::BrushFaceAttributes(textureName);
-            attribs.setXOffset(parseFloat());
-            attribs.setYOffset(parseFloat());
-            attribs.setRotation(parseFloat());
-            attribs.setXScale(parseFloat());
-            attribs.setYScale(parseFloat());
+            auto [p1, p2, p3, attribs] = parseStandardFace(status);
 
             if (checkFacePoints(status, p1, p2, p3, line)) {
                 brushFace(line, p1, p2, p3, attribs, vm::vec3::zero(), vm::vec3::zero(), status);
@@ -455,15 +607,7 @@ namespace TrenchBroom {
         void StandardMapParser::parseQuake2Face(ParserStatus& status) {
             const auto line = m_tokenizer.line();
 
-            const auto [p1, p2, p3] = parseFacePoints(status);
-            const auto textureName = parseTextureName(status);
-
-            auto attribs = Model::BrushFaceAttributes(textureName);
-            attribs.setXOffset(parseFloat());
-            attribs.setYOffset(parseFloat());
-            attribs.setRotation(parseFloat());
-            attribs.setXScale(parseFloat());
-            attribs.setYScale(parseFloat());
+            auto [p1, p2, p3, attribs] = parseStandardFace(status);
 
             // Quake 2 extra info is optional
             if (!check(QuakeMapToken::OParenthesis | QuakeMapToken::CBrace | QuakeMapToken::Eof, m_tokenizer.peekToken())) {
@@ -480,17 +624,7 @@ namespace TrenchBroom {
         void StandardMapParser::parseQuake2ValveFace(ParserStatus& status) {
             const auto line = m_tokenizer.line();
 
-            const auto [p1, p2, p3] = parseFacePoints(status);
-            const auto textureName = parseTextureName(status);
-
-            const auto [texX, xOffset, texY, yOffset] = parseValveTextureAxes(status);
-
-            auto attribs = Model::BrushFaceAttributes(textureName);
-            attribs.setXOffset(xOffset);
-            attribs.setYOffset(yOffset);
-            attribs.setRotation(parseFloat());
-            attribs.setXScale(parseFloat());
-            attribs.setYScale(parseFloat());
+            auto [p1, p2, p3, attribs, texX, texY] = parseValveFormatFace(status);
 
             // Quake 2 extra info is optional
             if (!check(QuakeMapToken::OParenthesis | QuakeMapToken::CBrace | QuakeMapToken::Eof, m_tokenizer.peekToken())) {
@@ -507,15 +641,7 @@ namespace TrenchBroom {
         void StandardMapParser::parseHexen2Face(ParserStatus& status) {
             const auto line = m_tokenizer.line();
 
-            const auto [p1, p2, p3] = parseFacePoints(status);
-            const auto textureName = parseTextureName(status);
-
-            auto attribs = Model::BrushFaceAttributes(textureName);
-            attribs.setXOffset(parseFloat());
-            attribs.setYOffset(parseFloat());
-            attribs.setRotation(parseFloat());
-            attribs.setXScale(parseFloat());
-            attribs.setYScale(parseFloat());
+            auto [p1, p2, p3, attribs] = parseStandardFace(status);
 
             // Hexen 2 extra info is optional
             if (!check(QuakeMapToken::OParenthesis | QuakeMapToken::CBrace | QuakeMapToken::Eof, m_tokenizer.peekToken())) {
@@ -530,15 +656,7 @@ namespace TrenchBroom {
         void StandardMapParser::parseDaikatanaFace(ParserStatus& status) {
             const auto line = m_tokenizer.line();
 
-            const auto [p1, p2, p3] = parseFacePoints(status);
-            const auto textureName = parseTextureName(status);
-
-            auto attribs = Model::BrushFaceAttributes(textureName);
-            attribs.setXOffset(parseFloat());
-            attribs.setYOffset(parseFloat());
-            attribs.setRotation(parseFloat());
-            attribs.setXScale(parseFloat());
-            attribs.setYScale(parseFloat());
+            auto [p1, p2, p3, attribs] = parseStandardFace(status);
 
             // Daikatana extra info is optional
             if (check(QuakeMapToken::Integer, m_tokenizer.peekToken())) {
@@ -561,17 +679,7 @@ namespace TrenchBroom {
         void StandardMapParser::parseValveFace(ParserStatus& status) {
             const auto line = m_tokenizer.line();
 
-            const auto [p1, p2, p3] = parseFacePoints(status);
-            const auto textureName = parseTextureName(status);
-
-            const auto [texX, xOffset, texY, yOffset] = parseValveTextureAxes(status);
-
-            auto attribs = Model::BrushFaceAttributes(textureName);
-            attribs.setXOffset(xOffset);
-            attribs.setYOffset(yOffset);
-            attribs.setRotation(parseFloat());
-            attribs.setXScale(parseFloat());
-            attribs.setYScale(parseFloat());
+            const auto [p1, p2, p3, attribs, texX, texY] = parseValveFormatFace(status);
 
             if (checkFacePoints(status, p1, p2, p3, line)) {
                 brushFace(line, p1, p2, p3, attribs, texX, texY, status);
@@ -588,10 +696,8 @@ namespace TrenchBroom {
             /* const auto [texX, texY] = */ parsePrimitiveTextureAxes(status);
             expect(QuakeMapToken::CParenthesis, m_tokenizer.nextToken());
 
-            const auto textureName = parseTextureName(status);
-
             // TODO 2427: what to set for offset, rotation, scale?!
-            auto attribs = Model::BrushFaceAttributes(textureName);
+            auto attribs = Model::BrushFaceAttributes(parseTextureName(status));
 
             // Quake 2 extra info is optional
             if (!check(QuakeMapToken::OParenthesis | QuakeMapToken::CBrace | QuakeMapToken::Eof, m_tokenizer.peekToken())) {
@@ -660,6 +766,70 @@ namespace TrenchBroom {
             status.warn(startLine, "Skipping patch: currently not supported");
         }
 
+        std::tuple<vm::vec3, vm::vec3, vm::vec3, Model::BrushFaceAttributes> StandardMapParser::parseStandardFace(ParserStatus& status) {
+            if (const auto face = m_tokenizer.readStandardFace()) {
+                const auto& points = face->points;
+                const auto p1 = correct(vm::vec3(points[0], points[1], points[2]));
+                const auto p2 = correct(vm::vec3(points[3], points[4], points[5]));
+                const auto p3 = correct(vm::vec3(points[6], points[7], points[8]));
+
+                const auto& values = face->attributes;
+                auto attribs = Model::BrushFaceAttributes(textureName(face->textureName));
+                attribs.setXOffset(static_cast<float>(values[0]));
+                attribs.setYOffset(static_cast<float>(values[1]));
+                attribs.setRotation(static_cast<float>(values[2]));
+                attribs.setXScale(static_cast<float>(values[3]));
+                attribs.setYScale(static_cast<float>(values[4]));
+
+                return std::make_tuple(p1, p2, p3, std::move(attribs));
+            }
+
+            const auto [p1, p2, p3] = parseFacePoints(status);
+            auto attribs = Model::BrushFaceAttributes(parseTextureName(status));
+            attribs.setXOffset(parseFloat());
+            attribs.setYOffset(parseFloat());
+            attribs.setRotation(parseFloat());
+            attribs.setXScale(parseFloat());
+            attribs.setYScale(parseFloat());
+
+            return std::make_tuple(p1, p2, p3, std::move(attribs));
+        }
+
+        std::tuple<vm::vec3, vm::vec3, vm::vec3, Model::BrushFaceAttributes, vm::vec3, vm::vec3> StandardMapParser::parseValveFormatFace(ParserStatus& status) {
+            if (const auto face = m_tokenizer.readValveFace()) {
+                const auto& points = face->points;
+                const auto p1 = correct(vm::vec3(points[0], points[1], points[2]));
+                const auto p2 = correct(vm::vec3(points[3], points[4], points[5]));
+                const auto p3 = correct(vm::vec3(points[6], points[7], points[8]));
+
+                const auto& axes = face->axes;
+                const auto texX = vm::vec3(axes[0], axes[1], axes[2]);
+                const auto texY = vm::vec3(axes[4], axes[5], axes[6]);
+
+                const auto& values = face->attributes;
+                auto attribs = Model::BrushFaceAttributes(textureName(face->textureName));
+                attribs.setXOffset(static_cast<float>(axes[3]));
+                attribs.setYOffset(static_cast<float>(axes[7]));
+                attribs.setRotation(static_cast<float>(values[0]));
+                attribs.setXScale(static_cast<float>(values[1]));
+                attribs.setYScale(static_cast<float>(values[2]));
+
+                return std::make_tuple(p1, p2, p3, std::move(attribs), texX, texY);
+            }
+
+            const auto [p1, p2, p3] = parseFacePoints(status);
+            auto attribs = Model::BrushFaceAttributes(parseTextureName(status));
+
+            const auto [texX, xOffset, texY, yOffset] = parseValveTextureAxes(status);
+            attribs.setXOffset(xOffset);
+            attribs.setYOffset(yOffset);
+            attribs.setRotation(parseFloat());
+            attribs.setXScale(parseFloat());
+            attribs.setYScale(parseFloat());
+
+            return std::make_tuple(p1, p2, p3, std::move(attribs), texX, texY);
+        }
+
         std::tuple<vm::vec3, vm::vec3, vm::vec3> StandardMapParser::parseFacePoints(ParserStatus& /* status */) {
             const auto p1 = correct(parseFloatVector(QuakeMapToken::OParenthesis, QuakeMapToken::CParenthesis));
             const auto p2 = correct(parseFloatVector(QuakeMapToken::OParenthesis, QuakeMapToken::CParenthesis));
@@ -676,6 +846,13 @@ namespace TrenchBroom {
             return textureName;
         }
 
+        std::string StandardMapParser::textureName(const std::string_view name) {
+            if (name == Model::BrushFaceAttributes::NoTextureName) {
+                return "";
+            }
+            return std::string(name);
+        }
+
         std::tuple<vm::vec3, float, vm::vec3, float> StandardMapParser::parseValveTextureAxes(ParserStatus& /* status */) {
             const auto firstAxis = parseFloatVector<4>(QuakeMapToken::OBracket, QuakeMapToken::CBracket);
             const auto texS = firstAxis.xyz();
@@ -30,7 +30,10 @@
 
 #include <vecmath/forward.h>
 
+#include <array>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -55,6 +58,26 @@ namespace TrenchBroom {
             static const Type Number        = Integer | Decimal;
         }
 
+        /**
+         * A face that was read by QuakeMapTokenizer::readStandardFace. The texture name refers to the tokenizer's
+         * input.
+         */
+        struct StandardFace {
+            std::array<double, 9> points;
+            std::string_view textureName;
+            std::array<double, 5> attributes; // x offset, y offset, rotation, x scale, y scale
+        };
+
+        /**
+         * A face that was read by QuakeMapTokenizer::readValveFace. The texture name refers to the tokenizer's input.
+         */
+        struct ValveFace {
+            std::array<double, 9> points;
+            std::string_view textureName;
+            std::array<double, 8> axes; // x axis and x offset, y axis and y offset
+            std::array<double, 3> attributes; // rotation, x scale, y scale
+        };
+
         class QuakeMapTokenizer : public Tokenizer<QuakeMapToken::Type> {
         private:
             static const std::string& NumberDelim();
@@ -64,7 +87,30 @@ namespace TrenchBroom {
             explicit QuakeMapTokenizer(const std::string& str);
 
             void setSkipEol(bool skipEol);
+
+            /**
+             * Reads a face of the form `( x y z ) ( x y z ) ( x y z ) TEXTURE xOffset yOffset rotation xScale yScale`
+             * directly from the input without emitting any tokens. This is a fast path for the most common face
+             * layout. The elements of the face must be on one line and separated by spaces or tabs only, and the
+             * texture name must not be quoted.
+             *
+             * If the input does not match, an empty optional is returned and the tokenizer is left at the beginning of
+             * the face so that the caller can fall back to the generic token based parser.
+             *
+             * @return the face or an empty optional if the input does not match the expected layout
+             */
+            std::optional<StandardFace> readStandardFace();
+
+            /**
+             * Reads a face of the form
+             * `( x y z ) ( x y z ) ( x y z ) TEXTURE [ ux uy uz xOffset ] [ vx vy vz yOffset ] rotation xScale yScale`
+             * directly from the input without emitting any tokens, with the same restrictions as readStandardFace().
+             *
+             * @return the face or an empty optional if the input does not match the expected layout
+             */
+            std::optional<ValveFace> readValveFace();
         private:
+            const char* scanTextureName(const char* c, const char* end, std::string_view& textureName) const;
             Token emitToken() override;
         };
 
@@ -113,8 +159,11 @@ namespace TrenchBroom {
 
             void parsePatch(ParserStatus& status, size_t startLine);
 
+            std::tuple<vm::vec3, vm::vec3, vm::vec3, Model::BrushFaceAttributes> parseStandardFace(ParserStatus& status);
+            std::tuple<vm::vec3, vm::vec3, vm::vec3, Model::BrushFaceAttributes, vm::vec3, vm::vec3> parseValveFormatFace(ParserStatus& status);
             std::tuple<vm::vec3, vm::vec3, vm::vec3> parseFacePoints(ParserStatus& status);
             std::string parseTextureName(ParserStatus& status);
+            static std::string textureName(std::string_view name);
             std::tuple<vm::vec3, float, vm::vec3, float> parseValveTextureAxes(ParserStatus& status);
             std::tuple<vm::vec3, vm::vec3> parsePrimitiveTextureAxes(ParserStatus& status);
 
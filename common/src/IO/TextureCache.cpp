@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureCache.h"
+
+#include "Color.h"
+#include "Exceptions.h"
+#include "Assets/Texture.h"
+#include "IO/DiskIO.h"
+#include "IO/MapCache.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace {
+            const char Magic[] = { 'T', 'B', 'T', 'C' };
+            const uint32_t Version = 1u;
+
+            template <typename T>
+            void writeValue(std::ostream& stream, const T value) {
+                stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+        }
+
+        TextureCache::TextureCache(const Path& directory) :
+        m_directory(directory) {
+            try {
+                Disk::ensureDirectoryExists(m_directory);
+            } catch (const FileSystemException&) {
+                // writing the entries will fail, and so the cache is just never used
+            }
+        }
+
+        Path TextureCache::entryPath(const char* begin, const char* end) const {
+            std::stringstream name;
+            name << std::hex << MapCache::hash(begin, end) << "-" << std::dec << (end - begin) << ".tbtex";
+            return m_directory + Path(name.str());
+        }
+
+        Assets::Texture* TextureCache::readTexture(const Path& entryPath, const std::string& name) const {
+            std::ifstream stream(entryPath.asString().c_str(), std::ios::in | std::ios::binary);
+            if (!stream.is_open()) {
+                return nullptr;
+            }
+
+            const auto contents = std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            if (contents.size() < sizeof(Magic) || std::memcmp(contents.data(), Magic, sizeof(Magic)) != 0) {
+                return nullptr;
+            }
+
+            try {
+                auto reader = Reader::from(contents.data() + sizeof(Magic), contents.data() + contents.size());
+                if (reader.readUnsignedInt<uint32_t>() != Version) {
+                    return nullptr;
+                }
+
+                const auto width = reader.readSize<uint32_t>();
+                const auto height = reader.readSize<uint32_t>();
+                const auto format = static_cast<GLenum>(reader.readUnsignedInt<uint32_t>());
+                const auto type = static_cast<Assets::TextureType>(reader.readUnsignedInt<uint32_t>());
+
+                const auto r = reader.readFloat<float>();
+                const auto g = reader.readFloat<float>();
+                const auto b = reader.readFloat<float>();
+                const auto a = reader.readFloat<float>();
+
+                const auto mipCount = reader.readSize<uint32_t>();
+                if (width == 0u || height == 0u || mipCount == 0u) {
+                    return nullptr;
+                }
+
+                auto buffers = Assets::TextureBufferList(mipCount);
+                Assets::setMipBufferSize(buffers, mipCount, width, height, format);
+                for (auto& buffer : buffers) {
+                    if (reader.readSize<uint64_t>() != buffer.size()) {
+                        return nullptr;
+                    }
+                    reader.read(buffer.data(), buffer.size());
+                }
+
+                return new Assets::Texture(name, width, height, Color(r, g, b, a), std::move(buffers), format, type);
+            } catch (const ReaderException&) {
+                return nullptr;
+            }
+        }
+
+        void TextureCache::writeTexture(const Path& entryPath, const size_t width, const size_t height, const Color& averageColor, const Assets::TextureBufferList& buffers, const GLenum format, const Assets::TextureType type) const {
+            // another thread may be writing the same entry, so every thread uses its own temporary file
+            std::stringstream tempExtension;
+            tempExtension << "tmp" << std::hash<std::thread::id>()(std::this_thread::get_id());
+            const auto tempPath = entryPath.addExtension(tempExtension.str());
+            {
+                std::ofstream stream(tempPath.asString().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!stream.is_open()) {
+                    return;
+                }
+
+                stream.write(Magic, sizeof(Magic));
+                writeValue(stream, Version);
+                writeValue(stream, static_cast<uint32_t>(width));
+                writeValue(stream, static_cast<uint32_t>(height));
+                writeValue(stream, static_cast<uint32_t>(format));
+                writeValue(stream, static_cast<uint32_t>(type));
+                writeValue(stream, averageColor.r());
+                writeValue(stream, averageColor.g());
+                writeValue(stream, averageColor.b());
+                writeValue(stream, averageColor.a());
+                writeValue(stream, static_cast<uint32_t>(buffers.size()));
+                for (const auto& buffer : buffers) {
+                    writeValue(stream, static_cast<uint64_t>(buffer.size()));
+                    stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                }
+
+                if (!stream) {
+                    stream.close();
+                    std::remove(tempPath.asString().c_str());
+                    return;
+                }
+            }
+
+            std::remove(entryPath.asString().c_str());
+            if (std::rename(tempPath.asString().c_str(), entryPath.asString().c_str()) != 0) {
+                std::remove(tempPath.asString().c_str());
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureCache
+#define TrenchBroom_TextureCache
+
+#include "Assets/TextureBuffer.h"
+#include "IO/Path.h"
+#include "Renderer/GL.h"
+
+#include <string>
+
+namespace TrenchBroom {
+    class Color;
+
+    namespace Assets {
+        class Texture;
+        enum class TextureType;
+    }
+
+    namespace IO {
+        /**
+         * A texture cache is a directory that stores the decoded contents of image files, so that an image file which
+         * has been decoded before can be loaded again without decoding it.
+         *
+         * Every entry is a file named after the size and the hash of the contents of the image file it was created
+         * from, so an entry can only be found for an identical image file and never becomes stale. Entries are
+         * written to a temporary file first and then renamed, so that several threads can use the same cache.
+         */
+        class TextureCache {
+        private:
+            Path m_directory;
+        public:
+            /**
+             * Creates a texture cache that stores its entries in the given directory, which is created if it does not
+             * exist.
+             *
+             * @param directory the cache directory
+             */
+            explicit TextureCache(const Path& directory);
+
+            /**
+             * Returns the path of the cache entry for the image file with the given contents.
+             *
+             * @param begin the beginning of the image file contents
+             * @param end the end of the image file contents
+             * @return the path of the cache entry
+             */
+            Path entryPath(const char* begin, const char* end) const;
+
+            /**
+             * Reads the texture stored in the cache entry with the given path.
+             *
+             * @param entryPath the path of the cache entry
+             * @param name the name of the texture
+             * @return an Assets::Texture object allocated with new, or null if the entry does not exist or is invalid
+             */
+            Assets::Texture* readTexture(const Path& entryPath, const std::string& name) const;
+
+            /**
+             * Writes the given decoded texture to the cache entry with the given path. Failing to write the entry is
+             * not an error, since the image is then just decoded again when it is loaded the next time.
+             */
+            void writeTexture(const Path& entryPath, size_t width, size_t height, const Color& averageColor, const Assets::TextureBufferList& buffers, GLenum format, Assets::TextureType type) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureCache) */
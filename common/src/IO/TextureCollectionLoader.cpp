@@ -20,6 +20,7 @@
 #include "TextureCollectionLoader.h"
 
 #include "Logger.h"
+#include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
@@ -28,6 +29,10 @@
 #include "IO/TextureReader.h"
 #include "IO/WadFileSystem.h"
 
+#include <kdl/parallel.h>
+#include <kdl/string_compare.h>
+#include <kdl/vector_utils.h>
+
 #include <memory>
 #include <vector>
 
@@ -39,16 +44,50 @@ namespace TrenchBroom {
 
         TextureCollectionLoader::~TextureCollectionLoader() = default;
 
-        std::unique_ptr<Assets::TextureCollection> TextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) {
+        std::unique_ptr<Assets::TextureCollection> TextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader) {
             auto collection = std::make_unique<Assets::TextureCollection>(path);
 
-            for (const auto& file : doFindTextures(path, textureExtensions)) {
+            const auto foundFiles = doFindTextures(path, textureExtensions);
+            collection->setSourcePaths(doFindSourcePaths(path, foundFiles));
+
+            FileList files;
+            for (const auto& file : foundFiles) {
                 const auto name = file->path().lastComponent().deleteExtension().asString();
-                if (shouldExclude(name)) {
-                    continue;
+                if (!shouldExclude(name)) {
+                    files.push_back(file);
+                }
+            }
+
+            // Only read the names and sizes of the textures if possible, their pixels are decoded when they are first
+            // needed. This is always done on the main thread, where errors can be logged.
+            const auto headers = kdl::vec_parallel_transform(files, [&](const auto& file) {
+                return textureReader->tryReadTextureHeader(file);
+            });
+
+            FileList filesToDecode;
+            for (size_t i = 0u; i < files.size(); ++i) {
+                if (!headers[i]) {
+                    filesToDecode.push_back(files[i]);
+                }
+            }
+
+            // Decode the remaining textures in parallel. The GL resources are only created later when the collection
+            // is prepared. The textures that cannot be read are read again serially so that the errors are logged and
+            // the default texture is loaded on this thread.
+            const auto textures = kdl::vec_parallel_transform(filesToDecode, [&](const auto& file) {
+                return textureReader->tryReadTexture(file);
+            });
+
+            for (size_t i = 0u, j = 0u; i < files.size(); ++i) {
+                if (const auto& header = headers[i]) {
+                    collection->addTexture(new Assets::Texture(header->name, header->width, header->height, [textureReader, file = files[i]]() {
+                        return std::unique_ptr<Assets::Texture>(textureReader->readTexture(file));
+                    }));
+                } else {
+                    auto* texture = textures[j] != nullptr ? textures[j] : textureReader->readTexture(filesToDecode[j]);
+                    collection->addTexture(texture);
+                    ++j;
                 }
-                auto* texture = textureReader.readTexture(file);
-                collection->addTexture(texture);
             }
 
             return collection;
@@ -63,6 +102,19 @@ namespace TrenchBroom {
             return false;
         }
 
+        std::vector<Path> TextureCollectionLoader::doFindSourcePaths(const Path& /* path */, const FileList& files) const {
+            auto result = std::vector<Path>();
+            for (const auto& file : files) {
+                const auto& filePath = file->path();
+                if (filePath.isAbsolute()) {
+                    result.push_back(filePath);
+                    result.push_back(filePath.deleteLastComponent());
+                }
+            }
+            kdl::vec_sort_and_remove_duplicates(result);
+            return result;
+        }
+
         FileTextureCollectionLoader::FileTextureCollectionLoader(Logger& logger, const std::vector<IO::Path>& searchPaths, const std::vector<std::string>& exclusions) :
         TextureCollectionLoader(logger, exclusions),
         m_searchPaths(searchPaths) {}
@@ -86,6 +138,14 @@ namespace TrenchBroom {
             return result;
         }
 
+        std::vector<Path> FileTextureCollectionLoader::doFindSourcePaths(const Path& path, const FileList& /* files */) const {
+            const auto wadPath = Disk::resolvePath(m_searchPaths, path);
+            if (wadPath.isEmpty()) {
+                return {};
+            }
+            return { wadPath };
+        }
+
         DirectoryTextureCollectionLoader::DirectoryTextureCollectionLoader(Logger& logger, const FileSystem& gameFS, const std::vector<std::string>& exclusions) :
         TextureCollectionLoader(logger, exclusions),
         m_gameFS(gameFS) {}
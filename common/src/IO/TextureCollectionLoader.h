@@ -23,7 +23,6 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <string>
 
 namespace TrenchBroom {
     class Logger;
@@ -49,10 +48,23 @@ namespace TrenchBroom {
         public:
             virtual ~TextureCollectionLoader();
         public:
-            std::unique_ptr<Assets::TextureCollection> loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader);
+            /**
+             * Loads the textures of the collection at the given path. If the given reader can read the size of a
+             * texture without decoding it, the texture's pixels are decoded when they are first needed; the texture
+             * keeps a reference to the reader for that purpose. All other textures are decoded right away.
+             */
+            std::unique_ptr<Assets::TextureCollection> loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader);
         private:
             bool shouldExclude(const std::string& textureName);
             virtual FileList doFindTextures(const Path& path, const std::vector<std::string>& extensions) = 0;
+
+            /**
+             * Returns the absolute paths of the files and directories on disk from which the collection at the given
+             * path was loaded. The default implementation returns the given files and the directories that contain them
+             * if the files are read directly from disk. The directories are needed to notice added and removed files,
+             * and the files are needed to notice files that are edited in place, since a directory does not change then.
+             */
+            virtual std::vector<Path> doFindSourcePaths(const Path& path, const FileList& files) const;
         };
 
         class FileTextureCollectionLoader : public TextureCollectionLoader {
@@ -62,6 +74,7 @@ namespace TrenchBroom {
             FileTextureCollectionLoader(Logger& logger, const std::vector<Path>& searchPaths, const std::vector<std::string>& exclusions);
         private:
             FileList doFindTextures(const Path& path, const std::vector<std::string>& extensions) override;
+            std::vector<Path> doFindSourcePaths(const Path& path, const FileList& files) const override;
         };
 
         class DirectoryTextureCollectionLoader : public TextureCollectionLoader {
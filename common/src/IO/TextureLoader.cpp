@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Logger.h"
+#include "Profiler.h"
 #include "Assets/Palette.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
@@ -29,6 +30,7 @@
 #include "IO/HlMipTextureReader.h"
 #include "IO/IdMipTextureReader.h"
 #include "IO/Quake3ShaderTextureReader.h"
+#include "IO/TextureCache.h"
 #include "IO/TextureCollectionLoader.h"
 #include "IO/WalTextureReader.h"
 #include "IO/Path.h"
@@ -39,9 +41,10 @@
 
 namespace TrenchBroom {
     namespace IO {
-        TextureLoader::TextureLoader(const FileSystem& gameFS, const std::vector<IO::Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger) :
+        TextureLoader::TextureLoader(const FileSystem& gameFS, const std::vector<IO::Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger, const Path& textureCacheDirectory) :
         m_textureExtensions(getTextureExtensions(textureConfig)),
-        m_textureReader(createTextureReader(gameFS, textureConfig, logger)),
+        m_textureCache(createTextureCache(textureConfig, textureCacheDirectory)),
+        m_textureReader(createTextureReader(gameFS, textureConfig, logger, m_textureCache)),
         m_textureCollectionLoader(createTextureCollectionLoader(gameFS, fileSearchPaths, textureConfig, logger)) {
             ensure(m_textureReader != nullptr, "textureReader is null");
             ensure(m_textureCollectionLoader != nullptr, "textureCollectionLoader is null");
@@ -53,22 +56,30 @@ namespace TrenchBroom {
             return textureConfig.format.extensions;
         }
 
-        std::unique_ptr<TextureReader> TextureLoader::createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger) {
+        std::shared_ptr<TextureCache> TextureLoader::createTextureCache(const Model::TextureConfig& textureConfig, const Path& textureCacheDirectory) {
+            // only decoding image files is expensive enough to be worth caching
+            if (textureCacheDirectory.isEmpty() || textureConfig.format.format != "image") {
+                return nullptr;
+            }
+            return std::make_shared<TextureCache>(textureCacheDirectory);
+        }
+
+        std::shared_ptr<TextureReader> TextureLoader::createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache) {
             if (textureConfig.format.format == "idmip") {
                 TextureReader::PathSuffixNameStrategy nameStrategy(1, true);
-                return std::make_unique<IdMipTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
+                return std::make_shared<IdMipTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
             } else if (textureConfig.format.format == "hlmip") {
                 TextureReader::PathSuffixNameStrategy nameStrategy(1, true);
-                return std::make_unique<HlMipTextureReader>(nameStrategy, gameFS, logger);
+                return std::make_shared<HlMipTextureReader>(nameStrategy, gameFS, logger);
             } else if (textureConfig.format.format == "wal") {
                 TextureReader::PathSuffixNameStrategy nameStrategy(2, true);
-                return std::make_unique<WalTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
+                return std::make_shared<WalTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
             } else if (textureConfig.format.format == "image") {
                 TextureReader::PathSuffixNameStrategy nameStrategy(2, true);
-                return std::make_unique<FreeImageTextureReader>(nameStrategy, gameFS, logger);
+                return std::make_shared<FreeImageTextureReader>(nameStrategy, gameFS, logger, std::move(textureCache));
             } else if (textureConfig.format.format == "q3shader") {
                 TextureReader::PathSuffixNameStrategy nameStrategy(2, true);
-                return std::make_unique<Quake3ShaderTextureReader>(nameStrategy, gameFS, logger);
+                return std::make_shared<Quake3ShaderTextureReader>(nameStrategy, gameFS, logger);
             } else {
                 throw GameException("Unknown texture format '" + textureConfig.format.format + "'");
             }
@@ -103,10 +114,12 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<Assets::TextureCollection> TextureLoader::loadTextureCollection(const Path& path) {
-            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
+            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, m_textureReader);
         }
 
         void TextureLoader::loadTextures(const std::vector<Path>& paths, Assets::TextureManager& textureManager) {
+            TB_PROFILE_ZONE("TextureLoader::loadTextures");
+
             textureManager.setTextureCollections(paths, *this);
         }
     }
@@ -21,6 +21,7 @@
 #define TextureLoader_h
 
 #include "Macros.h"
+#include "IO/Path.h"
 
 #include <memory>
 #include <string>
@@ -41,21 +42,30 @@ namespace TrenchBroom {
 
     namespace IO {
         class FileSystem;
-        class Path;
+        class TextureCache;
         class TextureCollectionLoader;
         class TextureReader;
 
         class TextureLoader {
         private:
             std::vector<std::string> m_textureExtensions;
-            std::unique_ptr<TextureReader> m_textureReader;
+            std::shared_ptr<TextureCache> m_textureCache;
+            // shared with the textures whose pixels are decoded on demand
+            std::shared_ptr<TextureReader> m_textureReader;
             std::unique_ptr<TextureCollectionLoader> m_textureCollectionLoader;
         public:
-            TextureLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger);
+            /**
+             * Creates a new texture loader. If a texture cache directory is given, decoded image files are stored in
+             * and read from a texture cache in that directory.
+             *
+             * @see TextureCache
+             */
+            TextureLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger, const Path& textureCacheDirectory = Path());
             ~TextureLoader();
         private:
             static std::vector<std::string> getTextureExtensions(const Model::TextureConfig& textureConfig);
-            static std::unique_ptr<TextureReader> createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger);
+            static std::shared_ptr<TextureCache> createTextureCache(const Model::TextureConfig& textureConfig, const Path& textureCacheDirectory);
+            static std::shared_ptr<TextureReader> createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache);
             static Assets::Palette loadPalette(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger);
             static std::unique_ptr<TextureCollectionLoader> createTextureCollectionLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger);
         public:
@@ -96,6 +96,30 @@ namespace TrenchBroom {
             }
         }
 
+        Assets::Texture* TextureReader::tryReadTexture(std::shared_ptr<File> file) const {
+            try {
+                return doReadTexture(file);
+            } catch (const AssetException&) {
+                return nullptr;
+            }
+        }
+
+        std::optional<TextureReader::TextureHeader> TextureReader::tryReadTextureHeader(std::shared_ptr<File> file) const {
+            try {
+                auto header = doReadTextureHeader(file);
+                if (header && (header->width == 0u || header->height == 0u || !checkTextureDimensions(header->width, header->height))) {
+                    return std::nullopt;
+                }
+                return header;
+            } catch (const AssetException&) {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<TextureReader::TextureHeader> TextureReader::doReadTextureHeader(std::shared_ptr<File> /* file */) const {
+            return std::nullopt;
+        }
+
         std::string TextureReader::textureName(const std::string& textureName, const Path& path) const {
             return m_nameStrategy->textureName(textureName, path);
         }
@@ -23,6 +23,7 @@
 #include "Macros.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace TrenchBroom {
@@ -39,6 +40,15 @@ namespace TrenchBroom {
 
         class TextureReader {
         public:
+            /**
+             * The name and size of a texture, as read from its file without decoding its pixels.
+             */
+            struct TextureHeader {
+                std::string name;
+                size_t width;
+                size_t height;
+            };
+
             class NameStrategy {
             protected:
                 NameStrategy();
@@ -107,6 +117,26 @@ namespace TrenchBroom {
              * @return an Assets::Texture object allocated with new
              */
             Assets::Texture* readTexture(std::shared_ptr<File> file) const;
+
+            /**
+             * Loads a texture from the given file and returns it, or returns null if an error occurs while loading the
+             * texture. Unlike readTexture, this neither logs the error nor loads the default texture, so it may be
+             * called from several threads at once.
+             *
+             * @param file the file containing the texture
+             * @return an Assets::Texture object allocated with new or null
+             */
+            Assets::Texture* tryReadTexture(std::shared_ptr<File> file) const;
+
+            /**
+             * Reads the name and size of the texture in the given file without decoding its pixels. Returns an empty
+             * optional if this reader cannot do that for the given file, or if an error occurs. Like tryReadTexture,
+             * this may be called from several threads at once.
+             *
+             * @param file the file containing the texture
+             * @return the texture header, if any
+             */
+            std::optional<TextureHeader> tryReadTextureHeader(std::shared_ptr<File> file) const;
         protected:
             std::string textureName(const std::string& textureName, const Path& path) const;
             std::string textureName(const Path& path) const;
@@ -119,6 +149,16 @@ namespace TrenchBroom {
              * @return an Assets::Texture object allocated with new
              */
             virtual Assets::Texture* doReadTexture(std::shared_ptr<File> file) const = 0;
+
+            /**
+             * Reads the name and size of a texture. The name must be the same as the name of the texture returned by
+             * doReadTexture for the same file. May throw AssetException. The default implementation returns an empty
+             * optional, meaning that textures read by this reader are always decoded right away.
+             *
+             * @param file the file containing the texture
+             * @return the texture header, if any
+             */
+            virtual std::optional<TextureHeader> doReadTextureHeader(std::shared_ptr<File> file) const;
         protected:
             static bool checkTextureDimensions(size_t width, size_t height);
         public:
@@ -20,6 +20,7 @@
 #include "WalTextureReader.h"
 
 #include "Ensure.h"
+#include "Exceptions.h"
 #include "Assets/Texture.h"
 #include "IO/File.h"
 #include "IO/Reader.h"
@@ -57,11 +58,39 @@ namespace TrenchBroom {
             }
         }
 
+        std::optional<TextureReader::TextureHeader> WalTextureReader::doReadTextureHeader(std::shared_ptr<File> file) const {
+            const auto& path = file->path();
+            auto reader = file->reader().buffer();
+
+            try {
+                const char version = reader.readChar<char>();
+                if (version == 3) {
+                    // Daikatana WAL files have a one byte version, the name and three bytes of garbage before the size
+                    const auto name = reader.readString(WalLayout::TextureNameLength);
+                    reader.seekForward(3);
+                    const auto width = reader.readSize<uint32_t>();
+                    const auto height = reader.readSize<uint32_t>();
+                    return TextureHeader{textureName(name, path), width, height};
+                } else if (!m_palette.initialized()) {
+                    // the texture would be created without any pixels
+                    return std::nullopt;
+                } else {
+                    reader.seekFromBegin(0);
+                    const auto name = reader.readString(WalLayout::TextureNameLength);
+                    const auto width = reader.readSize<uint32_t>();
+                    const auto height = reader.readSize<uint32_t>();
+                    return TextureHeader{textureName(name, path), width, height};
+                }
+            } catch (const ReaderException& e) {
+                throw AssetException(e.what());
+            }
+        }
+
         Assets::Texture* WalTextureReader::readQ2Wal(Reader& reader, const Path& path) const {
             static const size_t MaxMipLevels = 4;
-            static Color averageColor;
-            static Assets::TextureBufferList buffers(MaxMipLevels);
-            static size_t offsets[MaxMipLevels];
+            Color averageColor;
+            Assets::TextureBufferList buffers(MaxMipLevels);
+            size_t offsets[MaxMipLevels];
 
             const std::string name = reader.readString(WalLayout::TextureNameLength);
             const size_t width = reader.readSize<uint32_t>();
@@ -83,9 +112,9 @@ namespace TrenchBroom {
 
         Assets::Texture* WalTextureReader::readDkWal(Reader& reader, const Path& path) const {
             static const size_t MaxMipLevels = 9;
-            static Color averageColor;
-            static Assets::TextureBufferList buffers(MaxMipLevels);
-            static size_t offsets[MaxMipLevels];
+            Color averageColor;
+            Assets::TextureBufferList buffers(MaxMipLevels);
+            size_t offsets[MaxMipLevels];
 
             const char version = reader.readChar<char>();
             ensure(version == 3, "Unknown WAL texture version");
@@ -129,7 +158,7 @@ namespace TrenchBroom {
         }
 
         bool WalTextureReader::readMips(const Assets::Palette& palette, const size_t mipLevels, const size_t offsets[], const size_t width, const size_t height, Reader& reader, Assets::TextureBufferList& buffers, Color& averageColor, const Assets::PaletteTransparency transparency) {
-            static Color tempColor;
+            Color tempColor;
 
             auto hasTransparency = false;
             for (size_t i = 0; i < mipLevels; ++i) {
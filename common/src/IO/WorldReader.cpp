@@ -19,6 +19,8 @@
 
 #include "WorldReader.h"
 
+#include "Exceptions.h"
+#include "Profiler.h"
 #include "IO/ParserStatus.h"
 #include "Model/Brush.h"
 #include "Model/EntityAttributes.h"
@@ -38,15 +40,33 @@ namespace TrenchBroom {
         MapReader(str) {}
 
         std::unique_ptr<Model::World> WorldReader::read(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
+            TB_PROFILE_ZONE("WorldReader::read");
+
             readEntities(format, worldBounds, status);
             m_world->rebuildNodeTree();
             m_world->enableNodeTreeUpdates();
+            m_world->resumeAttributeIndexUpdates();
             return std::move(m_world);
         }
 
+        std::unique_ptr<Model::World> WorldReader::readCached(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status) {
+            TB_PROFILE_ZONE("WorldReader::readCached");
+
+            WorldReader reader(nullptr, nullptr);
+            reader.readCachedEntities(cache, worldBounds, status);
+            if (reader.m_world == nullptr) {
+                throw ParserException("Corrupt map cache: missing map format");
+            }
+            reader.m_world->rebuildNodeTree();
+            reader.m_world->enableNodeTreeUpdates();
+            reader.m_world->resumeAttributeIndexUpdates();
+            return std::move(reader.m_world);
+        }
+
         Model::ModelFactory& WorldReader::initialize(const Model::MapFormat format) {
             m_world = std::make_unique<Model::World>(format);
             m_world->disableNodeTreeUpdates();
+            m_world->deferAttributeIndexUpdates();
             return *m_world;
         }
 
@@ -32,6 +32,7 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        class MapCacheReader;
         class ParserStatus;
 
         class WorldReader : public MapReader {
@@ -41,6 +42,18 @@ namespace TrenchBroom {
             explicit WorldReader(const std::string& str);
 
             std::unique_ptr<Model::World> read(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
+
+            /**
+             * Reads the world by replaying the events stored in the given map cache instead of parsing text.
+             *
+             * @param cache the map cache to read from
+             * @param worldBounds the world bounds
+             * @param status the parser status
+             * @return the world
+             *
+             * @throw ParserException if the map cache is corrupt
+             */
+            static std::unique_ptr<Model::World> readCached(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status);
         private: // implement MapReader interface
             Model::ModelFactory& initialize(Model::MapFormat format) override;
             Model::Node* onWorldspawn(const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) override;
@@ -21,7 +21,10 @@
 
 #include "IO/File.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -69,15 +72,21 @@ namespace TrenchBroom {
         void ZipFileSystem::doReadDirectory() {
             mz_zip_zero_struct(&m_archive);
 
-            if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE) {
-                throw FileSystemException("Error calling mz_zip_reader_init_cfile");
+            if (mz_zip_reader_init_mem(&m_archive, m_file->begin(), m_file->size(), 0) != MZ_TRUE) {
+                throw FileSystemException("Error calling mz_zip_reader_init_mem");
             }
 
             const mz_uint numFiles = mz_zip_reader_get_num_files(&m_archive);
             for (mz_uint i = 0; i < numFiles; ++i) {
                 if (!mz_zip_reader_is_file_a_directory(&m_archive, i)) {
                     const auto path = Path(filename(i));
-                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i));
+                    if (const auto dataRange = storedDataRange(i)) {
+                        const auto [dataOffset, dataSize] = *dataRange;
+                        auto file = std::make_shared<FileView>(path, m_file, dataOffset, dataSize);
+                        m_root.addFile(path, std::make_unique<SimpleFileEntry>(std::move(file)));
+                    } else {
+                        m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i));
+                    }
                 }
             }
 
@@ -87,6 +96,48 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Returns the offset and size of the data of the file with the given index within the archive if the file is stored
+         * without compression, so that it can be accessed in place. Returns an empty optional if the file must be
+         * extracted by miniz.
+         */
+        std::optional<std::pair<size_t, size_t>> ZipFileSystem::storedDataRange(const mz_uint fileIndex) {
+            static const uint32_t LocalHeaderSignature = 0x04034b50;
+            static const size_t LocalHeaderSize = 30;
+
+            mz_zip_archive_file_stat stat;
+            if (!mz_zip_reader_file_stat(&m_archive, fileIndex, &stat) ||
+                stat.m_method != 0 ||
+                stat.m_is_encrypted ||
+                !stat.m_is_supported ||
+                stat.m_comp_size != stat.m_uncomp_size) {
+                return std::nullopt;
+            }
+
+            try {
+                // the local header may have a different extra field than the central directory entry
+                auto reader = m_file->reader();
+                reader.seekFromBegin(static_cast<size_t>(stat.m_local_header_ofs));
+                if (reader.readUnsignedInt<uint32_t>() != LocalHeaderSignature) {
+                    return std::nullopt;
+                }
+
+                reader.seekFromBegin(static_cast<size_t>(stat.m_local_header_ofs) + 26u);
+                const auto nameLength = reader.readSize<uint16_t>();
+                const auto extraLength = reader.readSize<uint16_t>();
+
+                const auto dataOffset = static_cast<size_t>(stat.m_local_header_ofs) + LocalHeaderSize + nameLength + extraLength;
+                const auto dataSize = static_cast<size_t>(stat.m_uncomp_size);
+                if (dataOffset > m_file->size() || dataSize > m_file->size() - dataOffset) {
+                    return std::nullopt;
+                }
+
+                return std::make_pair(dataOffset, dataSize);
+            } catch (const ReaderException&) {
+                return std::nullopt;
+            }
+        }
+
         /**
          * Helper to get the filename of a file in the zip archive
          */
@@ -23,6 +23,8 @@
 #include "IO/ImageFileSystem.h"
 
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include <miniz/miniz.h>
 
@@ -51,6 +53,7 @@ namespace TrenchBroom {
         private:
             void doReadDirectory() override;
         private:
+            std::optional<std::pair<size_t, size_t>> storedDataRange(mz_uint fileIndex);
             std::string filename(mz_uint fileIndex);
         };
     }
@@ -26,12 +26,50 @@
 #include <kdl/compact_trie.h>
 #include <kdl/vector_utils.h>
 
-#include <list>
+#include <algorithm>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Model {
+        namespace {
+            std::string nameValueKey(const std::string& name, const std::string& value) {
+                // attribute names cannot contain NUL characters, so the key is unique
+                auto key = name;
+                key.push_back('\0');
+                key.append(value);
+                return key;
+            }
+
+            template <typename M>
+            void insertNode(M& map, const std::string& key, AttributableNode* attributable) {
+                map[key].push_back(attributable);
+            }
+
+            template <typename M>
+            bool removeNode(M& map, const std::string& key, AttributableNode* attributable) {
+                const auto it = map.find(key);
+                if (it != std::end(map)) {
+                    auto& nodes = it->second;
+                    const auto nodeIt = std::find(std::begin(nodes), std::end(nodes), attributable);
+                    if (nodeIt != std::end(nodes)) {
+                        nodes.erase(nodeIt);
+                        if (nodes.empty()) {
+                            map.erase(it);
+                        }
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            template <typename M>
+            std::vector<AttributableNode*> findNodes(const M& map, const std::string& key) {
+                const auto it = map.find(key);
+                return it != std::end(map) ? it->second : std::vector<AttributableNode*>{};
+            }
+        }
+
         AttributableNodeIndexQuery AttributableNodeIndexQuery::exact(const std::string& pattern) {
             return AttributableNodeIndexQuery(Type_Exact, pattern);
         }
@@ -48,22 +86,31 @@ namespace TrenchBroom {
             return AttributableNodeIndexQuery(Type_Any);
         }
 
-        std::set<AttributableNode*> AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
-            std::set<AttributableNode*> result;
+        AttributableNodeIndexQuery::Type AttributableNodeIndexQuery::type() const {
+            return m_type;
+        }
+
+        const std::string& AttributableNodeIndexQuery::pattern() const {
+            return m_pattern;
+        }
+
+        std::vector<AttributableNode*> AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
+            std::vector<AttributableNode*> result;
             switch (m_type) {
                 case Type_Exact:
-                    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
+                    index.find_matches(m_pattern, std::back_inserter(result));
                     break;
                 case Type_Prefix:
-                    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
+                    index.find_matches(m_pattern + "*", std::back_inserter(result));
                     break;
                 case Type_Numbered:
-                    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
+                    index.find_matches(m_pattern + "%*", std::back_inserter(result));
                     break;
                 case Type_Any:
                     break;
                 switchDefault()
             }
+            kdl::vec_sort_and_remove_duplicates(result);
             return result;
         }
 
@@ -100,8 +147,7 @@ namespace TrenchBroom {
         m_pattern(pattern) {}
 
         AttributableNodeIndex::AttributableNodeIndex() :
-        m_nameIndex(std::make_unique<AttributableNodeStringIndex>()),
-        m_valueIndex(std::make_unique<AttributableNodeStringIndex>()) {}
+        m_nameIndex(std::make_unique<AttributableNodeStringIndex>()) {}
 
         AttributableNodeIndex::~AttributableNodeIndex() = default;
 
@@ -117,35 +163,68 @@ namespace TrenchBroom {
 
         void AttributableNodeIndex::addAttribute(AttributableNode* attributable, const std::string& name, const std::string& value) {
             m_nameIndex->insert(name, attributable);
-            m_valueIndex->insert(value, attributable);
+            insertNode(m_valueIndex, value, attributable);
+            insertNode(m_nameValueIndex, nameValueKey(name, value), attributable);
         }
 
-        void AttributableNodeIndex::removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value) {
+        bool AttributableNodeIndex::removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value) {
             m_nameIndex->remove(name, attributable);
-            m_valueIndex->remove(value, attributable);
+            removeNode(m_valueIndex, value, attributable);
+            return removeNode(m_nameValueIndex, nameValueKey(name, value), attributable);
         }
 
-        std::vector<AttributableNode*> AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const std::string& value) const {
-            const std::set<AttributableNode*> nameResult = nameQuery.execute(*m_nameIndex);
-
-            std::set<AttributableNode*> valueResult;
-            m_valueIndex->find_matches(value, std::inserter(valueResult, std::end(valueResult)));
-            if (nameResult.empty() || valueResult.empty()) {
-                return {};
+        void AttributableNodeIndex::addAttributes(std::vector<Entry> entries) {
+            std::sort(std::begin(entries), std::end(entries), [](const Entry& lhs, const Entry& rhs) {
+                const int cmp = lhs.name.compare(rhs.name);
+                return cmp != 0 ? cmp < 0 : lhs.value < rhs.value;
+            });
+
+            auto it = std::begin(entries);
+            const auto end = std::end(entries);
+            while (it != end) {
+                const std::string& name = it->name;
+                const std::string& value = it->value;
+                const auto groupEnd = std::find_if(std::next(it), end, [&](const Entry& entry) {
+                    return entry.name != name || entry.value != value;
+                });
+
+                auto& valueNodes = m_valueIndex[value];
+                auto& nameValueNodes = m_nameValueIndex[nameValueKey(name, value)];
+                const auto groupSize = static_cast<size_t>(std::distance(it, groupEnd));
+                valueNodes.reserve(valueNodes.size() + groupSize);
+                nameValueNodes.reserve(nameValueNodes.size() + groupSize);
+
+                // consecutive insertions of the same name traverse the same path in the trie
+                for (; it != groupEnd; ++it) {
+                    m_nameIndex->insert(name, it->attributable);
+                    valueNodes.push_back(it->attributable);
+                    nameValueNodes.push_back(it->attributable);
+                }
             }
+        }
 
-            std::vector<AttributableNode*> result = kdl::set_intersection(nameResult, valueResult);
-
-            auto it = std::begin(result);
-            while (it != std::end(result)) {
-                const AttributableNode* node = *it;
-                if (!nameQuery.execute(node, value))
-                    it = result.erase(it);
-                else
-                    ++it;
+        std::vector<AttributableNode*> AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const std::string& value) const {
+            switch (nameQuery.type()) {
+                case AttributableNodeIndexQuery::Type_Exact: {
+                    auto result = findNodes(m_nameValueIndex, nameValueKey(nameQuery.pattern(), value));
+                    kdl::vec_sort_and_remove_duplicates(result);
+                    return result;
+                }
+                case AttributableNodeIndexQuery::Type_Prefix:
+                case AttributableNodeIndexQuery::Type_Numbered: {
+                    // there are usually far fewer nodes with a given value than nodes with a matching name, so the
+                    // nodes with the value are checked against the name query directly
+                    auto result = findNodes(m_valueIndex, value);
+                    result.erase(std::remove_if(std::begin(result), std::end(result), [&](const AttributableNode* node) {
+                        return !nameQuery.execute(node, value);
+                    }), std::end(result));
+                    kdl::vec_sort_and_remove_duplicates(result);
+                    return result;
+                }
+                case AttributableNodeIndexQuery::Type_Any:
+                    return {};
+                switchDefault()
             }
-
-            return result;
         }
 
         std::vector<std::string> AttributableNodeIndex::allNames() const {
@@ -157,7 +236,7 @@ namespace TrenchBroom {
         std::vector<std::string> AttributableNodeIndex::allValuesForNames(const AttributableNodeIndexQuery& keyQuery) const {
             std::vector<std::string> result;
 
-            const std::set<AttributableNode*> nameResult = keyQuery.execute(*m_nameIndex);
+            const std::vector<AttributableNode*> nameResult = keyQuery.execute(*m_nameIndex);
             for (const auto node : nameResult) {
                 const auto matchingAttributes = keyQuery.execute(node);
                 for (const auto& attribute : matchingAttributes) {
@@ -23,8 +23,8 @@
 #include <kdl/compact_trie_forward.h>
 
 #include <memory>
-#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -51,7 +51,14 @@ namespace TrenchBroom {
             static AttributableNodeIndexQuery numbered(const std::string& pattern);
             static AttributableNodeIndexQuery any();
 
-            std::set<AttributableNode*> execute(const AttributableNodeStringIndex& index) const;
+            Type type() const;
+            const std::string& pattern() const;
+
+            /**
+             * Returns the nodes in the given index whose keys match this query, sorted by address and without
+             * duplicates.
+             */
+            std::vector<AttributableNode*> execute(const AttributableNodeStringIndex& index) const;
             bool execute(const AttributableNode* node, const std::string& value) const;
             std::vector<Model::EntityAttribute> execute(const AttributableNode* node) const;
         private:
@@ -59,9 +66,29 @@ namespace TrenchBroom {
         };
 
         class AttributableNodeIndex {
+        public:
+            /**
+             * An attribute of a node which is to be added to the index.
+             */
+            struct Entry {
+                AttributableNode* attributable;
+                std::string name;
+                std::string value;
+            };
         private:
+            using AttributableNodeMap = std::unordered_map<std::string, std::vector<AttributableNode*>>;
+
             std::unique_ptr<AttributableNodeStringIndex> m_nameIndex;
-            std::unique_ptr<AttributableNodeStringIndex> m_valueIndex;
+            /**
+             * Values are only ever looked up exactly, so they are hashed rather than stored in a trie.
+             */
+            AttributableNodeMap m_valueIndex;
+            /**
+             * Maps the combination of an attribute name and value to the nodes having that attribute, so that exact
+             * lookups such as finding all nodes with a given targetname don't have to intersect the nodes having the
+             * name with the nodes having the value.
+             */
+            AttributableNodeMap m_nameValueIndex;
         public:
             AttributableNodeIndex();
             ~AttributableNodeIndex();
@@ -70,7 +97,20 @@ namespace TrenchBroom {
             void removeAttributableNode(AttributableNode* attributable);
 
             void addAttribute(AttributableNode* attributable, const std::string& name, const std::string& value);
-            void removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value);
+
+            /**
+             * Removes the given attribute of the given node from the index.
+             *
+             * @return true if the attribute was found in the index and false otherwise
+             */
+            bool removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value);
+
+            /**
+             * Adds the given attributes to the index. This is faster than adding each attribute individually because
+             * the entries are sorted first, so that the nodes having the same name and value are added with a single
+             * lookup.
+             */
+            void addAttributes(std::vector<Entry> entries);
 
             std::vector<AttributableNode*> findAttributableNodes(const AttributableNodeIndexQuery& keyQuery, const std::string& value) const;
             std::vector<std::string> allNames() const;
@@ -19,6 +19,7 @@
 
 #include "Brush.h"
 
+#include "Assets/Texture.h"
 #include "Exceptions.h"
 #include "FloatType.h"
 #include "Polyhedron.h"
@@ -26,6 +27,7 @@
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/BrushSnapshot.h"
+#include "Model/CompactBrushGeometry.h"
 #include "Model/Entity.h"
 #include "Model/FindContainerVisitor.h"
 #include "Model/FindGroupVisitor.h"
@@ -39,6 +41,7 @@
 #include "Model/World.h"
 #include "Renderer/BrushRendererBrushCache.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/intersection.h>
@@ -52,6 +55,7 @@
 
 #include <algorithm> // for std::remove
 #include <iterator>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -118,22 +122,32 @@ namespace TrenchBroom {
 
         class Brush::AddFacesToGeometry {
         private:
+            /**
+             * Brushes with at most this many faces are built directly from their face planes instead of by clipping.
+             */
+            static constexpr size_t MaxFacesToBuildDirectly = 16u;
+
             BrushGeometry& m_geometry;
             bool m_brushEmpty;
             bool m_brushValid;
         public:
-            AddFacesToGeometry(BrushGeometry& geometry, std::vector<BrushFace*> facesToAdd) :
+            AddFacesToGeometry(BrushGeometry& geometry, std::vector<BrushFace*> facesToAdd, const vm::bbox3& worldBounds) :
             m_geometry(geometry),
             m_brushEmpty(false),
             m_brushValid(true) {
+                assert(m_geometry.empty());
+
                 // sort the faces by the weight of their plane normals like QBSP does
                 Model::BrushFace::sortFaces(facesToAdd);
 
-                for (auto it = std::begin(facesToAdd), end = std::end(facesToAdd); it != end && !m_brushEmpty; ++it) {
-                    auto* brushFace = *it;
-                    AddFaceToGeometryCallback addCallback(brushFace);
-                    const auto result = m_geometry.clip(brushFace->boundary(), addCallback);
-                    m_brushEmpty = result.empty();
+                if (!buildDirectly(facesToAdd, worldBounds)) {
+                    m_geometry = BrushGeometry(worldBounds.expand(1.0));
+                    for (auto it = std::begin(facesToAdd), end = std::end(facesToAdd); it != end && !m_brushEmpty; ++it) {
+                        auto* brushFace = *it;
+                        AddFaceToGeometryCallback addCallback(brushFace);
+                        const auto result = m_geometry.clip(brushFace->boundary(), addCallback);
+                        m_brushEmpty = result.empty();
+                    }
                 }
                 if (!m_brushEmpty && m_brushValid) {
                     m_geometry.correctVertexPositions();
@@ -150,6 +164,40 @@ namespace TrenchBroom {
             bool brushValid() const {
                 return m_brushValid;
             }
+        private:
+            /**
+             * Builds the geometry from the face planes if the brush has few faces and is closed and within the world
+             * bounds. Otherwise, the geometry is left empty so that it can be built by clipping, which also handles
+             * brushes that are not fully specified.
+             */
+            bool buildDirectly(const std::vector<BrushFace*>& facesToAdd, const vm::bbox3& worldBounds) {
+                if (facesToAdd.size() > MaxFacesToBuildDirectly) {
+                    return false;
+                }
+
+                std::vector<vm::plane3> planes;
+                planes.reserve(facesToAdd.size());
+                for (const auto* brushFace : facesToAdd) {
+                    planes.push_back(brushFace->boundary());
+                }
+
+                std::vector<BrushFaceGeometry*> faceGeometries;
+                if (!m_geometry.buildFromPlanes(planes, faceGeometries)) {
+                    return false;
+                }
+
+                if (!worldBounds.expand(1.0).contains(m_geometry.bounds())) {
+                    m_geometry.clear();
+                    return false;
+                }
+
+                for (size_t i = 0u; i < facesToAdd.size(); ++i) {
+                    if (faceGeometries[i] != nullptr) {
+                        facesToAdd[i]->setGeometry(faceGeometries[i]);
+                    }
+                }
+                return true;
+            }
         };
 
         class Brush::MoveVerticesCallback : public BrushGeometry::Callback {
@@ -286,10 +334,25 @@ namespace TrenchBroom {
             }
         };
 
-        class Brush::QueryCallback : public BrushGeometry::Callback {
-        public:
-            vm::plane3 getPlane(const BrushFaceGeometry* face) const override {
-                return face->payload()->boundary();
+        /**
+         * A vertex move that was checked by doCanMoveVertices, along with the result of the check.
+         */
+        struct Brush::CachedVertexMove {
+            vm::bbox3 worldBounds;
+            std::vector<vm::vec3> vertexPositions; // sorted and without duplicates
+            vm::vec3 delta;
+            bool allowVertexRemoval;
+            CanMoveVerticesResult result;
+
+            CachedVertexMove(const vm::bbox3& i_worldBounds, std::vector<vm::vec3> i_vertexPositions, const vm::vec3& i_delta, const bool i_allowVertexRemoval, CanMoveVerticesResult&& i_result) :
+            worldBounds(i_worldBounds),
+            vertexPositions(std::move(i_vertexPositions)),
+            delta(i_delta),
+            allowVertexRemoval(i_allowVertexRemoval),
+            result(std::move(i_result)) {}
+
+            bool matches(const vm::bbox3& i_worldBounds, const std::vector<vm::vec3>& i_vertexPositions, const vm::vec3& i_delta) const {
+                return worldBounds == i_worldBounds && delta == i_delta && vertexPositions == i_vertexPositions;
             }
         };
 
@@ -306,6 +369,14 @@ namespace TrenchBroom {
             }
         }
 
+        Brush::Brush(std::unique_ptr<BrushGeometry> geometry) :
+        m_geometry(geometry.release()),
+        m_transparent(false),
+        m_brushRendererBrushCache(std::make_unique<Renderer::BrushRendererBrushCache>()) {
+            assert(fullySpecified());
+            updateFacesFromGeometry(m_geometry->bounds(), *m_geometry);
+        }
+
         Brush::~Brush() {
             cleanup();
         }
@@ -682,16 +753,7 @@ namespace TrenchBroom {
         }
 
         bool Brush::containsPoint(const vm::vec3& point) const {
-            if (!logicalBounds().contains(point)) {
-                return false;
-            } else {
-                for (const auto* face : m_faces) {
-                    if (face->boundary().point_status(point) == vm::plane_status::above) {
-                        return false;
-                    }
-                }
-                return true;
-            }
+            return compactGeometry().containsPoint(point);
         }
 
         std::vector<BrushFace*> Brush::incidentFaces(const BrushVertex* vertex) const {
@@ -785,34 +847,36 @@ namespace TrenchBroom {
             doSetNewGeometry(worldBounds, matcher, newGeometry);
         }
 
-        bool Brush::canSnapVertices(const vm::bbox3& /* worldBounds */, const FloatType snapToF) {
-            BrushGeometry newGeometry;
+        static vm::vec3 snapVertex(const vm::vec3& position, const FloatType snapTo) {
+            return snapTo * round(position / snapTo);
+        }
 
+        BrushGeometry Brush::snappedGeometry(const FloatType snapToF) const {
+            ensure(m_geometry != nullptr, "geometry is null");
+
+            BrushGeometry result;
             for (const auto* vertex : m_geometry->vertices()) {
-                const auto& origin = vertex->position();
-                const auto destination = snapToF * round(origin / snapToF);
-                newGeometry.addPoint(destination);
+                result.addPoint(snapVertex(vertex->position(), snapToF));
             }
+            return result;
+        }
 
-            return newGeometry.polyhedron();
+        bool Brush::canSnapVertices(const vm::bbox3& /* worldBounds */, const FloatType snapToF) const {
+            return snappedGeometry(snapToF).polyhedron();
         }
 
         void Brush::snapVertices(const vm::bbox3& worldBounds, const FloatType snapToF, const bool uvLock) {
-            ensure(m_geometry != nullptr, "geometry is null");
-
-            BrushGeometry newGeometry;
+            snapVertices(worldBounds, snapToF, snappedGeometry(snapToF), uvLock);
+        }
 
-            for (const auto* vertex : m_geometry->vertices()) {
-                const auto& origin = vertex->position();
-                const auto destination = snapToF * round(origin / snapToF);
-                newGeometry.addPoint(destination);
-            }
+        void Brush::snapVertices(const vm::bbox3& worldBounds, const FloatType snapToF, const BrushGeometry& newGeometry, const bool uvLock) {
+            ensure(m_geometry != nullptr, "geometry is null");
 
             using VecMap = std::map<vm::vec3,vm::vec3>;
             VecMap vertexMapping;
             for (const auto* vertex : m_geometry->vertices()) {
                 const auto& origin = vertex->position();
-                const auto destination = snapToF * round(origin / snapToF);
+                const auto destination = snapVertex(origin, snapToF);
                 if (newGeometry.hasVertex(destination)) {
                     vertexMapping.insert(std::make_pair(origin, destination));
                 }
@@ -830,7 +894,7 @@ namespace TrenchBroom {
             vm::segment3::get_vertices(
                 std::begin(edgePositions), std::end(edgePositions),
                 std::back_inserter(vertexPositions));
-            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
+            const auto& result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
 
             if (!result.success) {
                 return false;
@@ -873,7 +937,7 @@ namespace TrenchBroom {
 
             std::vector<vm::vec3> vertexPositions;
             vm::polygon3::get_vertices(std::begin(facePositions), std::end(facePositions), std::back_inserter(vertexPositions));
-            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
+            const auto& result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
 
             if (!result.success) {
                 return false;
@@ -948,7 +1012,19 @@ namespace TrenchBroom {
          If `allowVertexRemoval` is true, vertices can be moved inside a remaining polyhedron.
 
          */
-        Brush::CanMoveVerticesResult Brush::doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, const bool allowVertexRemoval) const {
+        const Brush::CanMoveVerticesResult& Brush::doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const bool allowVertexRemoval) const {
+            auto sortedPositions = vertexPositions;
+            kdl::vec_sort_and_remove_duplicates(sortedPositions);
+            if (m_cachedVertexMove == nullptr ||
+                m_cachedVertexMove->allowVertexRemoval != allowVertexRemoval ||
+                !m_cachedVertexMove->matches(worldBounds, sortedPositions, delta)) {
+                auto result = computeCanMoveVertices(worldBounds, vertexPositions, delta, allowVertexRemoval);
+                m_cachedVertexMove = std::make_unique<CachedVertexMove>(worldBounds, std::move(sortedPositions), delta, allowVertexRemoval, std::move(result));
+            }
+            return m_cachedVertexMove->result;
+        }
+
+        Brush::CanMoveVerticesResult Brush::computeCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, const bool allowVertexRemoval) const {
             // Should never occur, takes care of the first row.
             if (vertexPositions.empty() || vm::is_zero(delta, vm::C::almost_zero())) {
                 return CanMoveVerticesResult::rejectVertexMove();
@@ -1038,12 +1114,23 @@ namespace TrenchBroom {
             BrushGeometry newGeometry;
             const auto vertexSet = std::set<vm::vec3>(std::begin(vertexPositions), std::end(vertexPositions));
 
-            for (auto* vertex : m_geometry->vertices()) {
-                const auto& position = vertex->position();
-                if (vertexSet.count(position)) {
-                    newGeometry.addPoint(position + delta);
-                } else {
-                    newGeometry.addPoint(position);
+            // The geometry resulting from a checked move does not depend on whether vertex removal was allowed, so it can
+            // be taken from the cache regardless. It must be taken out of the cache because setting the new geometry
+            // invalidates the cache.
+            const auto sortedPositions = std::vector<vm::vec3>(std::begin(vertexSet), std::end(vertexSet));
+            if (m_cachedVertexMove != nullptr &&
+                m_cachedVertexMove->result.success &&
+                m_cachedVertexMove->matches(worldBounds, sortedPositions, delta)) {
+                newGeometry = std::move(*m_cachedVertexMove->result.geometry);
+                m_cachedVertexMove.reset();
+            } else {
+                for (auto* vertex : m_geometry->vertices()) {
+                    const auto& position = vertex->position();
+                    if (vertexSet.count(position)) {
+                        newGeometry.addPoint(position + delta);
+                    } else {
+                        newGeometry.addPoint(position);
+                    }
                 }
             }
 
@@ -1283,9 +1370,9 @@ namespace TrenchBroom {
         void Brush::buildGeometry(const vm::bbox3& worldBounds) {
             assert(m_geometry == nullptr);
 
-            m_geometry = new BrushGeometry(worldBounds.expand(1.0));
+            m_geometry = new BrushGeometry();
 
-            AddFacesToGeometry addFacesToGeometry(*m_geometry, m_faces);
+            AddFacesToGeometry addFacesToGeometry(*m_geometry, m_faces, worldBounds);
             updateFacesFromGeometry(worldBounds, *m_geometry);
 
             if (addFacesToGeometry.brushEmpty()) {
@@ -1306,6 +1393,8 @@ namespace TrenchBroom {
             }
             delete m_geometry;
             m_geometry = nullptr;
+            m_compactGeometry.reset();
+            m_cachedVertexMove.reset();
         }
 
         bool Brush::checkGeometry() const {
@@ -1331,10 +1420,26 @@ namespace TrenchBroom {
         }
 
         void Brush::findIntegerPlanePoints(const vm::bbox3& worldBounds) {
+            setIntegerPlanePoints(worldBounds, computeIntegerPlanePoints());
+        }
+
+        std::vector<BrushFace::IntegerPlanePoints> Brush::computeIntegerPlanePoints() const {
+            std::vector<BrushFace::IntegerPlanePoints> result;
+            result.reserve(m_faces.size());
+
+            for (const auto* face : m_faces) {
+                result.push_back(face->computeIntegerPlanePoints());
+            }
+            return result;
+        }
+
+        void Brush::setIntegerPlanePoints(const vm::bbox3& worldBounds, const std::vector<BrushFace::IntegerPlanePoints>& points) {
+            ensure(points.size() == m_faces.size(), "one set of plane points per face");
+
             const NotifyNodeChange nodeChange(this);
 
-            for (auto* face : m_faces) {
-                face->findIntegerPlanePoints();
+            for (size_t i = 0; i < m_faces.size(); ++i) {
+                m_faces[i]->setIntegerPlanePoints(points[i]);
             }
             rebuildGeometry(worldBounds);
         }
@@ -1354,6 +1459,24 @@ namespace TrenchBroom {
         }
 
         Node* Brush::doClone(const vm::bbox3& worldBounds) const {
+            // Rebuilding the geometry from the cloned faces would yield the same geometry unless the brush exceeds the
+            // given world bounds, so it is copied instead, which is much cheaper than clipping it out of a cube again.
+            if (worldBounds.contains(m_geometry->bounds())) {
+                auto geometry = std::make_unique<BrushGeometry>(*m_geometry);
+
+                // the copy has the same faces in the same order, but without their payloads
+                auto copyIt = std::begin(geometry->faces());
+                for (const auto* original : m_geometry->faces()) {
+                    auto* faceClone = original->payload()->clone();
+                    faceClone->setGeometry(*copyIt);
+                    ++copyIt;
+                }
+
+                auto* brush = new Brush(std::move(geometry));
+                cloneAttributes(brush);
+                return brush;
+            }
+
             std::vector<BrushFace*> faceClones;
             faceClones.reserve(m_faces.size());
 
@@ -1418,17 +1541,8 @@ namespace TrenchBroom {
         Brush::BrushFaceHit::BrushFaceHit(BrushFace* i_face, const FloatType i_distance) : face(i_face), distance(i_distance) {}
 
         Brush::BrushFaceHit Brush::findFaceHit(const vm::ray3& ray) const {
-            if (vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds()))) {
-                return BrushFaceHit();
-            }
-
-            for (auto* face : m_faces) {
-                const auto distance = face->intersectWithRay(ray);
-                if (!vm::is_nan(distance)) {
-                    return BrushFaceHit(face, distance);
-                }
-            }
-            return BrushFaceHit();
+            const auto [face, distance] = compactGeometry().pickFace(ray);
+            return face != nullptr ? BrushFaceHit(face, distance) : BrushFaceHit();
         }
 
         Node* Brush::doGetContainer() const {
@@ -1456,7 +1570,102 @@ namespace TrenchBroom {
                 face->transform(transformation, lockTextures);
             }
 
-            rebuildGeometry(worldBounds);
+            if (canTransformGeometry(transformation, worldBounds)) {
+                const auto oldBounds = physicalBounds();
+                transformGeometry(transformation);
+                nodePhysicalBoundsDidChange(oldBounds);
+            } else {
+                rebuildGeometry(worldBounds);
+            }
+        }
+
+        static bool isRigidTransformation(const vm::mat4x4& transformation) {
+            constexpr auto epsilon = vm::constants<FloatType>::almost_zero();
+            for (size_t i = 0u; i < 3u; ++i) {
+                if (!vm::is_zero(transformation[i][3], epsilon)) {
+                    return false;
+                }
+            }
+            if (!vm::is_equal(transformation[3][3], 1.0, epsilon)) {
+                return false;
+            }
+
+            // the columns of the linear part must be orthonormal and form a right handed system
+            const auto x = transformation[0].xyz();
+            const auto y = transformation[1].xyz();
+            const auto z = transformation[2].xyz();
+            return vm::is_equal(vm::dot(x, x), 1.0, epsilon)
+                && vm::is_equal(vm::dot(y, y), 1.0, epsilon)
+                && vm::is_equal(vm::dot(z, z), 1.0, epsilon)
+                && vm::is_zero(vm::dot(x, y), epsilon)
+                && vm::is_zero(vm::dot(x, z), epsilon)
+                && vm::is_zero(vm::dot(y, z), epsilon)
+                && vm::dot(vm::cross(x, y), z) > 0.0;
+        }
+
+        bool Brush::canTransformGeometry(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const {
+            return isRigidTransformation(transformation) && worldBounds.contains(m_geometry->bounds().transform(transformation));
+        }
+
+        void Brush::transformGeometry(const vm::mat4x4& transformation) {
+            // the faces keep their geometry, and their points have already been transformed
+            m_geometry->transform(transformation);
+            for (auto* face : m_faces) {
+                face->resetTexCoordSystemCache();
+            }
+            invalidateVertexCache();
+        }
+
+        void Brush::transformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) {
+            std::vector<std::unique_ptr<NotifyNodeChange>> nodeChanges;
+            std::vector<vm::bbox3> oldBounds;
+            nodeChanges.reserve(brushes.size());
+            oldBounds.reserve(brushes.size());
+
+            for (auto* brush : brushes) {
+                nodeChanges.push_back(std::make_unique<NotifyNodeChange>(brush));
+                oldBounds.push_back(brush->physicalBounds());
+            }
+
+            // this does the same as doTransform and rebuildGeometry, but only touches the brush's own faces and
+            // geometry, so the brushes can be processed independently; rebuilding the geometry clones and deletes
+            // faces, which changes the usage counts of their textures, so these changes are recorded and applied
+            // afterwards
+            std::vector<Assets::TextureUsageCountChanges> usageCountChanges(brushes.size());
+            std::vector<char> transformed(brushes.size(), 0);
+
+            const auto finish = [&]() {
+                for (auto& changes : usageCountChanges) {
+                    changes.apply();
+                }
+                for (size_t i = 0u; i < brushes.size(); ++i) {
+                    if (transformed[i]) {
+                        brushes[i]->nodePhysicalBoundsDidChange(oldBounds[i]);
+                    }
+                }
+            };
+
+            try {
+                kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                    usageCountChanges[i].record([&]() {
+                        auto* brush = brushes[i];
+                        for (auto* face : brush->m_faces) {
+                            face->transform(transformation, lockTextures);
+                        }
+                        if (brush->canTransformGeometry(transformation, worldBounds)) {
+                            brush->transformGeometry(transformation);
+                        } else {
+                            brush->deleteGeometry();
+                            brush->buildGeometry(worldBounds);
+                        }
+                        transformed[i] = 1;
+                    });
+                });
+            } catch (...) {
+                finish();
+                throw;
+            }
+            finish();
         }
 
         class Brush::Contains : public ConstNodeVisitor, public NodeQuery<bool> {
@@ -1487,7 +1696,11 @@ namespace TrenchBroom {
             }
 
             bool contains(const Brush* brush) const {
-                return m_this->m_geometry->contains(*brush->m_geometry);
+                // reject before the compact geometries are created
+                if (!m_this->logicalBounds().contains(brush->logicalBounds())) {
+                    return false;
+                }
+                return m_this->compactGeometry().contains(brush->compactGeometry());
             }
         };
 
@@ -1516,7 +1729,11 @@ namespace TrenchBroom {
             }
 
             bool intersects(const Brush* brush) {
-                return m_this->m_geometry->intersects(*brush->m_geometry, QueryCallback());
+                // reject before the compact geometries are created
+                if (!m_this->logicalBounds().intersects(brush->logicalBounds())) {
+                    return false;
+                }
+                return m_this->compactGeometry().intersects(brush->compactGeometry());
             }
         };
 
@@ -1529,12 +1746,22 @@ namespace TrenchBroom {
 
         void Brush::invalidateVertexCache() {
             m_brushRendererBrushCache->invalidateVertexCache();
+            m_compactGeometry.reset();
+            m_cachedVertexMove.reset();
         }
 
         Renderer::BrushRendererBrushCache& Brush::brushRendererBrushCache() const {
             return *m_brushRendererBrushCache;
         }
 
+        const CompactBrushGeometry& Brush::compactGeometry() const {
+            ensure(m_geometry != nullptr, "geometry is null");
+            if (m_compactGeometry == nullptr) {
+                m_compactGeometry = std::make_unique<CompactBrushGeometry>(*m_geometry);
+            }
+            return *m_compactGeometry;
+        }
+
         void Brush::initializeTags(TagManager& tagManager) {
             Taggable::initializeTags(tagManager);
             for (auto* face : m_faces) {
@@ -30,6 +30,7 @@
 
 #include <vecmath/forward.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -40,6 +41,7 @@ namespace TrenchBroom {
     }
 
     namespace Model {
+        class CompactBrushGeometry;
         class ModelFactory;
         template <typename P> class PolyhedronMatcher;
 
@@ -56,7 +58,7 @@ namespace TrenchBroom {
             class AddFacesToGeometry;
             class MoveVerticesCallback;
             using RemoveVertexCallback = MoveVerticesCallback;
-            class QueryCallback;
+            struct CachedVertexMove;
         public:
             using VertexList = BrushVertexList;
             using EdgeList = BrushEdgeList;
@@ -66,10 +68,19 @@ namespace TrenchBroom {
 
             mutable bool m_transparent;
             mutable std::unique_ptr<Renderer::BrushRendererBrushCache> m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
+            mutable std::unique_ptr<CompactBrushGeometry> m_compactGeometry; // lazily created, reset when the vertex cache is invalidated
+            mutable std::unique_ptr<CachedVertexMove> m_cachedVertexMove; // the last checked vertex move, reset when the vertex cache is invalidated
         public:
             Brush(const vm::bbox3& worldBounds, const std::vector<BrushFace*>& faces);
             ~Brush() override;
         private:
+            /**
+             * Creates a brush from the given geometry. Every face of the geometry must have a brush face as its
+             * payload which does not belong to a brush yet. The brush takes ownership of the geometry and of the brush
+             * faces.
+             */
+            explicit Brush(std::unique_ptr<BrushGeometry> geometry);
+
             void cleanup();
         public:
             Brush* clone(const vm::bbox3& worldBounds) const;
@@ -168,8 +179,19 @@ namespace TrenchBroom {
             bool canRemoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions) const;
             void removeVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions);
 
-            bool canSnapVertices(const vm::bbox3& worldBounds, FloatType snapTo);
+            /**
+             * Returns the convex hull of the vertices of this brush after snapping them to the given grid size. The brush
+             * can be snapped if the result is a polyhedron.
+             */
+            BrushGeometry snappedGeometry(FloatType snapTo) const;
+            bool canSnapVertices(const vm::bbox3& worldBounds, FloatType snapTo) const;
             void snapVertices(const vm::bbox3& worldBounds, FloatType snapTo, bool uvLock = false);
+            /**
+             * Snaps the vertices of this brush to the given grid size, where the given geometry must have been returned
+             * by snappedGeometry() for the same grid size. This allows building the snapped geometry of many brushes in
+             * parallel before applying it.
+             */
+            void snapVertices(const vm::bbox3& worldBounds, FloatType snapTo, const BrushGeometry& snappedGeometry, bool uvLock = false);
 
             // edge operations
             bool canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const;
@@ -190,7 +212,13 @@ namespace TrenchBroom {
                 static CanMoveVerticesResult acceptVertexMove(BrushGeometry&& result);
             };
 
-            CanMoveVerticesResult doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, bool allowVertexRemoval) const;
+            /**
+             * Checks whether the given vertices can be moved by the given delta. The result of the last check is cached
+             * along with the resulting geometry, so that checking the same move again, or performing it afterwards,
+             * does not build the resulting geometry again.
+             */
+            const CanMoveVerticesResult& doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool allowVertexRemoval) const;
+            CanMoveVerticesResult computeCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, bool allowVertexRemoval) const;
             void doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool lockTexture);
             /**
              * Tries to find 3 vertices in `left` and `right` that are related according to the PolyhedronMatcher, and
@@ -235,6 +263,19 @@ namespace TrenchBroom {
 
             // transformation
             bool canTransform(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const;
+
+            /**
+             * Transforms the given brushes. The faces and geometries of the brushes are transformed and rebuilt in
+             * parallel, while the brushes' parents are notified of the changes on the calling thread.
+             *
+             * Precondition: every given brush can be transformed
+             *
+             * @param brushes the brushes to transform, must not contain duplicates
+             * @param transformation the transformation to apply
+             * @param lockTextures whether textures should be locked
+             * @param worldBounds the world bounds
+             */
+            static void transformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, bool lockTextures, const vm::bbox3& worldBounds);
         private:
             /**
              * Final step of CSG subtraction; takes the geometry that is the result of the subtraction, and turns it
@@ -257,9 +298,30 @@ namespace TrenchBroom {
         private:
             void buildGeometry(const vm::bbox3& worldBounds);
             void deleteGeometry();
+
+            /**
+             * Indicates whether the geometry of this brush can be transformed directly by the given transformation
+             * instead of being rebuilt from the transformed faces. This is the case if the transformation is rigid, so
+             * that the topology of the brush cannot change, and if the transformed brush remains within the given
+             * world bounds, so that it would not be clipped.
+             */
+            bool canTransformGeometry(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const;
+            void transformGeometry(const vm::mat4x4& transformation);
             bool checkGeometry() const;
         public:
             void findIntegerPlanePoints(const vm::bbox3& worldBounds);
+
+            /**
+             * Finds integer plane points for every face of this brush without modifying it, in the order of the faces.
+             * This can be done concurrently for different brushes.
+             */
+            std::vector<std::array<vm::vec3, 3>> computeIntegerPlanePoints() const;
+
+            /**
+             * Sets the given plane points, which were previously computed by computeIntegerPlanePoints, and rebuilds
+             * the geometry.
+             */
+            void setIntegerPlanePoints(const vm::bbox3& worldBounds, const std::vector<std::array<vm::vec3, 3>>& points);
         private: // implement Node interface
             const std::string& doGetName() const override;
             const vm::bbox3& doGetLogicalBounds() const override;
@@ -309,6 +371,12 @@ namespace TrenchBroom {
              */
             void invalidateVertexCache();
             Renderer::BrushRendererBrushCache& brushRendererBrushCache() const;
+        private:
+            /**
+             * Returns a flat copy of this brush's geometry for read only queries, creating it if necessary.
+             */
+            const CompactBrushGeometry& compactGeometry() const;
+        public:
         private: // implement Taggable interface
         public:
             void initializeTags(TagManager& tagManager) override;
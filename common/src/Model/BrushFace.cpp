@@ -546,8 +546,18 @@ namespace TrenchBroom {
         }
 
         void BrushFace::findIntegerPlanePoints() {
-            PlanePointFinder::findPoints(m_boundary, m_points, 3);
-            setPoints(m_points[0], m_points[1], m_points[2]);
+            setIntegerPlanePoints(computeIntegerPlanePoints());
+        }
+
+        BrushFace::IntegerPlanePoints BrushFace::computeIntegerPlanePoints() const {
+            // the finder starts from the current points, and keeps those that are already integral
+            BrushFace::Points points = { m_points[0], m_points[1], m_points[2] };
+            PlanePointFinder::findPoints(m_boundary, points, 3);
+            return IntegerPlanePoints{ points[0], points[1], points[2] };
+        }
+
+        void BrushFace::setIntegerPlanePoints(const IntegerPlanePoints& points) {
+            setPoints(points[0], points[1], points[2]);
         }
 
         vm::mat4x4 BrushFace::projectToBoundaryMatrix() const {
@@ -659,6 +669,10 @@ namespace TrenchBroom {
             return m_texCoordSystem->getTexCoords(point, m_attribs);
         }
 
+        void BrushFace::textureCoords(const std::vector<vm::vec3>& points, std::vector<vm::vec2f>& result) const {
+            m_texCoordSystem->getTexCoords(points, m_attribs, result);
+        }
+
         FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const {
             ensure(m_geometry != nullptr, "geometry is null");
 
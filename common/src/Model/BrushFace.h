@@ -32,6 +32,7 @@
 #include <vecmath/plane.h>
 #include <vecmath/util.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -62,6 +63,7 @@ namespace TrenchBroom {
              * 0-----------2
              */
             using Points = vm::vec3[3];
+            using IntegerPlanePoints = std::array<vm::vec3, 3>;
         private:
             /**
              * For use in VertexList transformation below.
@@ -180,6 +182,17 @@ namespace TrenchBroom {
             void snapPlanePointsToInteger();
             void findIntegerPlanePoints();
 
+            /**
+             * Finds integer plane points for this face without modifying it. The search is expensive, but it only
+             * reads this face, so it can be done concurrently for different faces.
+             */
+            IntegerPlanePoints computeIntegerPlanePoints() const;
+
+            /**
+             * Sets the given plane points, which were previously computed by computeIntegerPlanePoints.
+             */
+            void setIntegerPlanePoints(const IntegerPlanePoints& points);
+
             vm::mat4x4 projectToBoundaryMatrix() const;
             vm::mat4x4 toTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, bool project) const;
             vm::mat4x4 fromTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, bool project) const;
@@ -206,6 +219,12 @@ namespace TrenchBroom {
 
             vm::vec2f textureCoords(const vm::vec3& point) const;
 
+            /**
+             * Computes the texture coordinates of all given points at once and stores them in the given vector,
+             * replacing its contents.
+             */
+            void textureCoords(const std::vector<vm::vec3>& points, std::vector<vm::vec2f>& result) const;
+
             FloatType intersectWithRay(const vm::ray3& ray) const;
         private:
             void setPoints(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2);
@@ -22,14 +22,27 @@
 
 #include <vecmath/vec.h>
 
+#include <mutex>
 #include <string>
+#include <unordered_set>
 
 namespace TrenchBroom {
     namespace Model {
+        namespace {
+            const std::string* internTextureName(const std::string& textureName) {
+                // texture names are never removed, but there are only few of them
+                static std::mutex mutex;
+                static std::unordered_set<std::string> textureNames;
+
+                const std::lock_guard<std::mutex> lock(mutex);
+                return &*textureNames.insert(textureName).first;
+            }
+        }
+
         const std::string BrushFaceAttributes::NoTextureName = "__TB_empty";
 
-        BrushFaceAttributes::BrushFaceAttributes(const std::string& textureName) :
-        m_textureName(textureName),
+        BrushFaceAttributes::BrushFaceAttributes(std::string textureName) :
+        m_textureName(internTextureName(textureName)),
         m_texture(nullptr),
         m_offset(vm::vec2f::zero()),
         m_scale(vm::vec2f(1.0f, 1.0f)),
@@ -54,7 +67,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceAttributes::BrushFaceAttributes(const std::string& textureName, const BrushFaceAttributes& other) :
-        m_textureName(textureName),
+        m_textureName(internTextureName(textureName)),
         m_texture(nullptr),
         m_offset(other.m_offset),
         m_scale(other.m_scale),
@@ -102,7 +115,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceAttributes BrushFaceAttributes::takeSnapshot() const {
-            BrushFaceAttributes result(m_textureName);
+            BrushFaceAttributes result(*m_textureName);
             result.m_offset = m_offset;
             result.m_scale = m_scale;
             result.m_rotation = m_rotation;
@@ -114,7 +127,7 @@ namespace TrenchBroom {
         }
 
         const std::string& BrushFaceAttributes::textureName() const {
-            return m_textureName;
+            return *m_textureName;
         }
 
         Assets::Texture* BrushFaceAttributes::texture() const {
@@ -181,7 +194,9 @@ namespace TrenchBroom {
             m_texture = texture;
             if (m_texture != nullptr) {
                 m_texture->incUsageCount();
-                m_textureName = m_texture->name();
+                if (*m_textureName != m_texture->name()) {
+                    m_textureName = internTextureName(m_texture->name());
+                }
             }
         }
 
@@ -190,7 +205,7 @@ namespace TrenchBroom {
                 m_texture->decUsageCount();
             }
             m_texture = nullptr;
-            m_textureName = BrushFaceAttributes::NoTextureName;
+            m_textureName = internTextureName(BrushFaceAttributes::NoTextureName);
         }
 
         bool BrushFaceAttributes::valid() const {
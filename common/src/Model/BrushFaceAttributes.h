@@ -36,7 +36,11 @@ namespace TrenchBroom {
         public:
             static const std::string NoTextureName;
         private:
-            std::string m_textureName;
+            /**
+             * Points to a copy of the texture name that is shared by all attributes with the same texture name. Most
+             * faces of a map use one of only a few textures, so this saves a string per face.
+             */
+            const std::string* m_textureName;
             Assets::Texture* m_texture;
 
             vm::vec2f m_offset;
@@ -49,7 +53,7 @@ namespace TrenchBroom {
 
             Color m_color;
         public:
-            BrushFaceAttributes(const std::string& textureName);
+            BrushFaceAttributes(std::string textureName);
             BrushFaceAttributes(const BrushFaceAttributes& other);
             BrushFaceAttributes(const std::string& textureName, const BrushFaceAttributes& other);
             ~BrushFaceAttributes();
@@ -19,11 +19,20 @@
 
 #include "BrushFacePredicates.h"
 
+#include "Model/BrushFace.h"
+
 namespace TrenchBroom {
     namespace Model {
         namespace BrushFacePredicates {
             bool True::operator()(const BrushFace* /* face */) const  { return true;  }
             bool False::operator()(const BrushFace* /* face */) const { return false; }
+
+            HasTexture::HasTexture(const Assets::Texture* texture) :
+            m_texture(texture) {}
+
+            bool HasTexture::operator()(const BrushFace* face) const {
+                return face->texture() == m_texture;
+            }
         }
     }
 }
@@ -21,6 +21,10 @@
 #define TrenchBroom_BrushFacePredicates
 
 namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
     namespace Model {
         class BrushFace;
 
@@ -33,6 +37,18 @@ namespace TrenchBroom {
                 bool operator()(const BrushFace* face) const;
             };
 
+            /**
+             * Matches the faces which have the given texture. The texture is compared by identity, so this is cheaper
+             * than comparing texture names.
+             */
+            class HasTexture {
+            private:
+                const Assets::Texture* m_texture;
+            public:
+                explicit HasTexture(const Assets::Texture* texture);
+                bool operator()(const BrushFace* face) const;
+            };
+
             template <typename P>
             class Not {
             private:
@@ -38,5 +38,9 @@ namespace TrenchBroom {
                 face->restoreTexCoordSystemSnapshot(*m_coordSystemSnapshot);
             }
         }
+
+        size_t BrushFaceSnapshot::memoryUsage() const {
+            return sizeof(BrushFaceSnapshot) + m_attribs.textureName().capacity();
+        }
     }
 }
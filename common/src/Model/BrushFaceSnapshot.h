@@ -23,6 +23,7 @@
 #include "Model/BrushFaceAttributes.h"
 #include "Model/BrushFaceReference.h"
 
+#include <cstddef>
 #include <memory>
 
 namespace TrenchBroom {
@@ -41,6 +42,11 @@ namespace TrenchBroom {
             ~BrushFaceSnapshot();
 
             void restore();
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memoryUsage() const;
         };
     }
 }
@@ -47,5 +47,13 @@ namespace TrenchBroom {
             m_brush->setFaces(worldBounds, m_faces);
             m_faces.clear();
         }
+
+        size_t BrushSnapshot::doGetMemoryUsage() const {
+            size_t result = sizeof(BrushSnapshot) + m_faces.capacity() * sizeof(BrushFace*);
+            for (const BrushFace* face : m_faces) {
+                result += sizeof(BrushFace) + face->attribs().textureName().capacity();
+            }
+            return result;
+        }
     }
 }
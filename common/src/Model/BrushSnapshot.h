@@ -39,6 +39,7 @@ namespace TrenchBroom {
         private:
             void takeSnapshot(Brush* brush);
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemoryUsage() const override;
         };
     }
 }
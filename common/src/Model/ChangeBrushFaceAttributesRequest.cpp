@@ -20,6 +20,9 @@
 #include "ChangeBrushFaceAttributesRequest.h"
 #include "Macros.h"
 #include "Model/BrushFace.h"
+#include "Model/ModelUtils.h"
+
+#include <kdl/parallel.h>
 
 #include <cassert>
 #include <string>
@@ -239,6 +242,8 @@ namespace TrenchBroom {
 
         bool ChangeBrushFaceAttributesRequest::evaluate(const std::vector<BrushFace*>& faces) const {
             auto result = false;
+
+            // changing the textures changes their usage counts, which are shared by all faces
             for (BrushFace* face : faces) {
                 switch (m_textureOp) {
                     case TextureOp_Set:
@@ -251,28 +256,42 @@ namespace TrenchBroom {
                         break;
                     switchDefault();
                 }
+            }
 
-                result |= face->setXOffset(evaluateValueOp(face->xOffset(), m_xOffset, m_xOffsetOp));
-                result |= face->setYOffset(evaluateValueOp(face->yOffset(), m_yOffset, m_yOffsetOp));
-                result |= face->setRotation(evaluateValueOp(face->rotation(), m_rotation, m_rotationOp));
-                result |= face->setXScale(evaluateValueOp(face->xScale(), m_xScale, m_xScaleOp));
-                result |= face->setYScale(evaluateValueOp(face->yScale(), m_yScale, m_yScaleOp));
-                result |= face->setSurfaceFlags(evaluateFlagOp(face->surfaceFlags(), m_surfaceFlags, m_surfaceFlagsOp));
-                result |= face->setSurfaceContents(evaluateFlagOp(face->surfaceContents(), m_contentFlags, m_contentFlagsOp));
-                result |= face->setSurfaceValue(evaluateValueOp(face->surfaceValue(), m_surfaceValue, m_surfaceValueOp));
-                result |= face->setColor(evaluateValueOp(face->color(), m_colorValue, m_colorValueOp));
-
-                switch (m_axisOp) {
-                    case AxisOp_Reset:
-                        face->resetTextureAxes();
-                        result |= true;
-                        break;
-                    case AxisOp_None:
-                    case AxisOp_ToParaxial:
-                    case AxisOp_ToParallel:
-                        break;
-                    switchDefault()
+            // the remaining attributes only affect the faces and their brushes, so the faces are changed in parallel,
+            // with the faces of each brush being changed together
+            const auto groups = groupFacesByBrush(faces);
+            std::vector<char> groupResults(groups.size(), false);
+            kdl::parallel_for(groups.size(), [&](const size_t i) {
+                auto groupResult = false;
+                for (BrushFace* face : groups[i]) {
+                    groupResult |= face->setXOffset(evaluateValueOp(face->xOffset(), m_xOffset, m_xOffsetOp));
+                    groupResult |= face->setYOffset(evaluateValueOp(face->yOffset(), m_yOffset, m_yOffsetOp));
+                    groupResult |= face->setRotation(evaluateValueOp(face->rotation(), m_rotation, m_rotationOp));
+                    groupResult |= face->setXScale(evaluateValueOp(face->xScale(), m_xScale, m_xScaleOp));
+                    groupResult |= face->setYScale(evaluateValueOp(face->yScale(), m_yScale, m_yScaleOp));
+                    groupResult |= face->setSurfaceFlags(evaluateFlagOp(face->surfaceFlags(), m_surfaceFlags, m_surfaceFlagsOp));
+                    groupResult |= face->setSurfaceContents(evaluateFlagOp(face->surfaceContents(), m_contentFlags, m_contentFlagsOp));
+                    groupResult |= face->setSurfaceValue(evaluateValueOp(face->surfaceValue(), m_surfaceValue, m_surfaceValueOp));
+                    groupResult |= face->setColor(evaluateValueOp(face->color(), m_colorValue, m_colorValueOp));
+
+                    switch (m_axisOp) {
+                        case AxisOp_Reset:
+                            face->resetTextureAxes();
+                            groupResult |= true;
+                            break;
+                        case AxisOp_None:
+                        case AxisOp_ToParaxial:
+                        case AxisOp_ToParallel:
+                            break;
+                        switchDefault()
+                    }
                 }
+                groupResults[i] = groupResult;
+            });
+
+            for (const auto groupResult : groupResults) {
+                result |= (groupResult != 0);
             }
             return result;
         }
@@ -29,6 +29,7 @@
 
 #include <kdl/vector_set.h>
 
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -114,6 +115,47 @@ namespace TrenchBroom {
             return result.release_data();
         }
 
+        /**
+         * Visits the given candidate nodes and their ancestors up to and including the given root node as
+         * `root->acceptAndRecurse(visitor)` would, except that subtrees which do not contain any candidates are
+         * skipped. Each node is visited at most once and only after its ancestors. If the visitor stops the recursion
+         * at some node, then the nodes below it are not visited.
+         *
+         * This is used to restrict a visitor to the candidates returned by a node tree query while still matching
+         * the groups and entities which contain them.
+         */
+        template <typename V>
+        void acceptCandidatesAndAncestors(Node* root, const std::vector<Node*>& candidates, V& visitor) {
+            // maps every visited node to whether the visitor stopped the recursion at that node
+            std::unordered_map<Node*, bool> visited;
+
+            std::vector<Node*> path;
+            for (auto* candidate : candidates) {
+                path.clear();
+                for (auto* node = candidate; node != nullptr && node != root; node = node->parent()) {
+                    path.push_back(node);
+                }
+                path.push_back(root);
+
+                for (auto it = path.rbegin(); it != path.rend() && !visitor.cancelled(); ++it) {
+                    auto* node = *it;
+                    const auto visitedIt = visited.find(node);
+                    if (visitedIt != std::end(visited)) {
+                        if (visitedIt->second) {
+                            break;
+                        }
+                    } else {
+                        node->accept(visitor);
+                        const auto stopped = visitor.recursionStopped();
+                        visited.emplace(node, stopped);
+                        if (stopped) {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
     }
 }
 
@@ -0,0 +1,244 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompactBrushGeometry.h"
+
+#include "Polyhedron.h"
+#include "Model/BrushFace.h"
+
+#include <vecmath/intersection.h>
+#include <vecmath/scalar.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Model {
+        CompactBrushGeometry::CompactBrushGeometry(const BrushGeometry& geometry) :
+        m_bounds(geometry.bounds()) {
+            assert(geometry.polyhedron());
+
+            m_vertices.reserve(geometry.vertexCount());
+            for (const auto* vertex : geometry.vertices()) {
+                m_vertices.push_back(vertex->position());
+            }
+
+            for (const auto* edge : geometry.edges()) {
+                const auto direction = vm::normalize(edge->secondVertex()->position() - edge->firstVertex()->position());
+                const auto isParallel = [&](const vm::vec3& other) { return vm::is_zero(vm::cross(direction, other), vm::C::almost_zero()); };
+                if (std::none_of(std::begin(m_edgeDirections), std::end(m_edgeDirections), isParallel)) {
+                    m_edgeDirections.push_back(direction);
+                }
+            }
+
+            m_faces.reserve(geometry.faceCount());
+            m_facePlanes.reserve(geometry.faceCount());
+            m_faceOffsets.reserve(geometry.faceCount() + 1u);
+            m_faceVertices.reserve(2u * geometry.edgeCount());
+            m_planeNormalX.reserve(geometry.faceCount());
+            m_planeNormalY.reserve(geometry.faceCount());
+            m_planeNormalZ.reserve(geometry.faceCount());
+            m_planeDistance.reserve(geometry.faceCount());
+            for (const auto* faceGeometry : geometry.faces()) {
+                auto* face = faceGeometry->payload();
+                assert(face != nullptr);
+
+                m_faces.push_back(face);
+                m_facePlanes.push_back(face->boundary());
+                m_planeNormalX.push_back(face->boundary().normal.x());
+                m_planeNormalY.push_back(face->boundary().normal.y());
+                m_planeNormalZ.push_back(face->boundary().normal.z());
+                m_planeDistance.push_back(face->boundary().distance);
+                m_faceOffsets.push_back(m_faceVertices.size());
+                for (const auto* halfEdge : faceGeometry->boundary()) {
+                    m_faceVertices.push_back(halfEdge->origin()->position());
+                }
+            }
+            m_faceOffsets.push_back(m_faceVertices.size());
+        }
+
+        const vm::bbox3& CompactBrushGeometry::bounds() const {
+            return m_bounds;
+        }
+
+        bool CompactBrushGeometry::containsPoint(const vm::vec3& point) const {
+            if (!m_bounds.contains(point)) {
+                return false;
+            }
+
+            for (const auto& plane : m_facePlanes) {
+                if (plane.point_status(point) == vm::plane_status::above) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool CompactBrushGeometry::contains(const CompactBrushGeometry& other) const {
+            if (!m_bounds.contains(other.m_bounds)) {
+                return false;
+            }
+
+            for (const auto& plane : m_facePlanes) {
+                for (const auto& vertex : other.m_vertices) {
+                    if (plane.point_status(vertex) == vm::plane_status::above) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool CompactBrushGeometry::intersects(const CompactBrushGeometry& other) const {
+            if (!m_bounds.intersects(other.m_bounds)) {
+                return false;
+            }
+
+            // separating axis theorem, see Polyhedron::polyhedronIntersectsPolyhedron
+            if (separate(other) || other.separate(*this)) {
+                return false;
+            }
+
+            for (const auto& lhsDirection : m_edgeDirections) {
+                for (const auto& rhsDirection : other.m_edgeDirections) {
+                    const auto axis = vm::cross(lhsDirection, rhsDirection);
+                    if (!vm::is_zero(axis, vm::C::almost_zero()) && separate(other, vm::normalize(axis))) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        std::pair<BrushFace*, FloatType> CompactBrushGeometry::pickFace(const vm::ray3& ray) const {
+            if (vm::is_nan(vm::intersect_ray_bbox(ray, m_bounds))) {
+                return { nullptr, vm::nan<FloatType>() };
+            }
+
+            const auto ox = ray.origin.x(), oy = ray.origin.y(), oz = ray.origin.z();
+            const auto dx = ray.direction.x(), dy = ray.direction.y(), dz = ray.direction.z();
+            const auto faceCount = m_faces.size();
+
+            // The ray is below a plane where t * cos > dist, with cos being the cosine of the angle between the ray
+            // direction and the plane normal and dist being the distance of the ray origin above the plane. The ray
+            // enters the brush at the largest t of the planes it meets from the front and leaves at the smallest t of
+            // the planes it meets from the back. This loop has no branches so that it can be vectorized.
+            auto enter = -std::numeric_limits<FloatType>::max();
+            auto exit = std::numeric_limits<FloatType>::max();
+            auto parallelAbove = false;
+            for (size_t i = 0; i < faceCount; ++i) {
+                const auto cos = m_planeNormalX[i] * dx + m_planeNormalY[i] * dy + m_planeNormalZ[i] * dz;
+                const auto dist = m_planeNormalX[i] * ox + m_planeNormalY[i] * oy + m_planeNormalZ[i] * oz - m_planeDistance[i];
+                const auto t = -dist / cos;
+                enter = cos < FloatType(0.0) ? std::max(enter, t) : enter;
+                exit = cos > FloatType(0.0) ? std::min(exit, t) : exit;
+                parallelAbove = parallelAbove || (cos == FloatType(0.0) && dist > FloatType(0.0));
+            }
+
+            // Only rays that pass close to an edge or a vertex need to be tested against the individual faces.
+            const auto epsilon = vm::C::almost_zero();
+            if (parallelAbove || enter > exit + epsilon || exit < -epsilon || enter < -epsilon) {
+                return { nullptr, vm::nan<FloatType>() };
+            }
+
+            // the hit face is one of the faces whose plane the ray meets at the entry point
+            for (size_t i = 0; i < faceCount; ++i) {
+                const auto cos = m_planeNormalX[i] * dx + m_planeNormalY[i] * dy + m_planeNormalZ[i] * dz;
+                const auto dist = m_planeNormalX[i] * ox + m_planeNormalY[i] * oy + m_planeNormalZ[i] * oz - m_planeDistance[i];
+                if (cos < FloatType(0.0) && std::abs(-dist / cos - enter) <= epsilon) {
+                    const auto distance = intersectFaceWithRay(i, ray);
+                    if (!vm::is_nan(distance)) {
+                        return { m_faces[i], distance };
+                    }
+                }
+            }
+
+            // the ray passes close to an edge or numerical errors made the entry point inaccurate
+            for (size_t i = 0; i < faceCount; ++i) {
+                const auto distance = intersectFaceWithRay(i, ray);
+                if (!vm::is_nan(distance)) {
+                    return { m_faces[i], distance };
+                }
+            }
+            return { nullptr, vm::nan<FloatType>() };
+        }
+
+        FloatType CompactBrushGeometry::intersectFaceWithRay(const size_t index, const vm::ray3& ray) const {
+            const auto& plane = m_facePlanes[index];
+            if (vm::dot(plane.normal, ray.direction) >= FloatType(0.0)) {
+                return vm::nan<FloatType>();
+            }
+
+            const auto begin = std::next(std::begin(m_faceVertices), static_cast<std::ptrdiff_t>(m_faceOffsets[index]));
+            const auto end = std::next(std::begin(m_faceVertices), static_cast<std::ptrdiff_t>(m_faceOffsets[index + 1u]));
+            return vm::intersect_ray_polygon(ray, plane, begin, end);
+        }
+
+        bool CompactBrushGeometry::separate(const CompactBrushGeometry& other) const {
+            for (const auto& plane : m_facePlanes) {
+                if (pointStatus(plane, other.m_vertices) == vm::plane_status::above) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool CompactBrushGeometry::separate(const CompactBrushGeometry& other, const vm::vec3& axis) const {
+            // the geometries are separated if their projections onto the axis overlap by at most the point status
+            // epsilon, which is how the face planes treat touching geometries, too
+            const auto epsilon = vm::C::point_status_epsilon();
+            const auto [lhsMin, lhsMax] = project(axis, m_vertices);
+            const auto [rhsMin, rhsMax] = project(axis, other.m_vertices);
+            return rhsMin >= lhsMax - epsilon || lhsMin >= rhsMax - epsilon;
+        }
+
+        std::pair<FloatType, FloatType> CompactBrushGeometry::project(const vm::vec3& axis, const std::vector<vm::vec3>& vertices) {
+            auto min = std::numeric_limits<FloatType>::max();
+            auto max = -std::numeric_limits<FloatType>::max();
+            for (const auto& vertex : vertices) {
+                const auto distance = vm::dot(axis, vertex);
+                min = std::min(min, distance);
+                max = std::max(max, distance);
+            }
+            return { min, max };
+        }
+
+        vm::plane_status CompactBrushGeometry::pointStatus(const vm::plane3& plane, const std::vector<vm::vec3>& vertices) {
+            size_t above = 0u;
+            size_t below = 0u;
+            for (const auto& vertex : vertices) {
+                const auto status = plane.point_status(vertex);
+                if (status == vm::plane_status::above) {
+                    ++above;
+                } else if (status == vm::plane_status::below) {
+                    ++below;
+                }
+                if (above > 0u && below > 0u) {
+                    return vm::plane_status::inside;
+                }
+            }
+            return above > 0u ? vm::plane_status::above : vm::plane_status::below;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_CompactBrushGeometry_h
+#define TrenchBroom_CompactBrushGeometry_h
+
+#include "FloatType.h"
+#include "Model/BrushGeometry.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushFace;
+
+        /**
+         * An immutable copy of a brush's geometry that is stored in flat arrays. Read only queries such as picking and
+         * point containment run on this representation because they would otherwise follow the pointers of the half
+         * edge structure of the brush geometry.
+         *
+         * The face planes are taken from the brush faces rather than computed from the face vertices.
+         */
+        class CompactBrushGeometry {
+        private:
+            vm::bbox3 m_bounds;
+            std::vector<vm::vec3> m_vertices;
+
+            /**
+             * The normalized directions of the edges. Parallel edges share a single direction, so a cuboid has only
+             * three edge directions. The cross products of these directions are the edge axes of the separating axis
+             * test.
+             */
+            std::vector<vm::vec3> m_edgeDirections;
+
+            std::vector<BrushFace*> m_faces;
+            std::vector<vm::plane3> m_facePlanes;
+
+            /**
+             * The components of the face planes, stored separately so that the compiler can vectorize the loop that
+             * intersects a ray with all planes.
+             */
+            std::vector<FloatType> m_planeNormalX;
+            std::vector<FloatType> m_planeNormalY;
+            std::vector<FloatType> m_planeNormalZ;
+            std::vector<FloatType> m_planeDistance;
+
+            /**
+             * The positions of the boundary vertices of each face; face i occupies the range
+             * [m_faceOffsets[i], m_faceOffsets[i + 1]).
+             */
+            std::vector<vm::vec3> m_faceVertices;
+            std::vector<size_t> m_faceOffsets;
+        public:
+            /**
+             * Creates a compact copy of the given geometry, which must be a polyhedron whose faces all have a brush
+             * face as their payload.
+             */
+            explicit CompactBrushGeometry(const BrushGeometry& geometry);
+
+            const vm::bbox3& bounds() const;
+
+            bool containsPoint(const vm::vec3& point) const;
+
+            /**
+             * Checks whether this geometry contains all vertices of the given geometry.
+             */
+            bool contains(const CompactBrushGeometry& other) const;
+
+            /**
+             * Checks whether this geometry intersects the given geometry using the separating axis theorem. The face
+             * normals of both geometries are tested first since they separate most disjoint brushes, and the cross
+             * products of their edge directions are only tested afterwards.
+             *
+             * Geometries which only touch each other are not considered to intersect.
+             */
+            bool intersects(const CompactBrushGeometry& other) const;
+
+            /**
+             * Returns the first face hit by the given ray and the distance of the hit point from the ray origin, or a
+             * null face and NaN if the ray does not hit any face from the front.
+             *
+             * The ray is intersected with all face planes at once by computing the interval in which it is below all
+             * planes. The face whose plane bounds that interval from the front is then tested against the ray
+             * exactly. The faces are only tested one by one if that test fails, which can happen if the ray passes
+             * through an edge or a vertex.
+             */
+            std::pair<BrushFace*, FloatType> pickFace(const vm::ray3& ray) const;
+        private:
+            FloatType intersectFaceWithRay(size_t index, const vm::ray3& ray) const;
+            bool separate(const CompactBrushGeometry& other) const;
+            bool separate(const CompactBrushGeometry& other, const vm::vec3& axis) const;
+            static std::pair<FloatType, FloatType> project(const vm::vec3& axis, const std::vector<vm::vec3>& vertices);
+            static vm::plane_status pointStatus(const vm::plane3& plane, const std::vector<vm::vec3>& vertices);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DefaultIssueGenerators.h"
+
+#include "Model/AttributeNameWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/AttributeValueWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/DuplicateBrushesIssueGenerator.h"
+#include "Model/EmptyAttributeNameIssueGenerator.h"
+#include "Model/EmptyAttributeValueIssueGenerator.h"
+#include "Model/EmptyBrushEntityIssueGenerator.h"
+#include "Model/EmptyGroupIssueGenerator.h"
+#include "Model/Game.h"
+#include "Model/InvalidTextureScaleIssueGenerator.h"
+#include "Model/LinkSourceIssueGenerator.h"
+#include "Model/LinkTargetIssueGenerator.h"
+#include "Model/LongAttributeNameIssueGenerator.h"
+#include "Model/LongAttributeValueIssueGenerator.h"
+#include "Model/MissingClassnameIssueGenerator.h"
+#include "Model/MissingDefinitionIssueGenerator.h"
+#include "Model/MissingModIssueGenerator.h"
+#include "Model/MixedBrushContentsIssueGenerator.h"
+#include "Model/NonIntegerPlanePointsIssueGenerator.h"
+#include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/PointEntityWithBrushesIssueGenerator.h"
+#include "Model/World.h"
+#include "Model/WorldBoundsIssueGenerator.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        void registerDefaultIssueGenerators(World& world, std::shared_ptr<Game> game, const vm::bbox3& worldBounds) {
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            world.registerIssueGenerator(new MissingDefinitionIssueGenerator());
+            world.registerIssueGenerator(new MissingModIssueGenerator(game));
+            world.registerIssueGenerator(new EmptyGroupIssueGenerator());
+            world.registerIssueGenerator(new EmptyBrushEntityIssueGenerator());
+            world.registerIssueGenerator(new PointEntityWithBrushesIssueGenerator());
+            world.registerIssueGenerator(new LinkSourceIssueGenerator());
+            world.registerIssueGenerator(new LinkTargetIssueGenerator());
+            world.registerIssueGenerator(new NonIntegerPlanePointsIssueGenerator());
+            world.registerIssueGenerator(new NonIntegerVerticesIssueGenerator());
+            world.registerIssueGenerator(new MixedBrushContentsIssueGenerator());
+            world.registerIssueGenerator(new DuplicateBrushesIssueGenerator());
+            world.registerIssueGenerator(new WorldBoundsIssueGenerator(worldBounds));
+            world.registerIssueGenerator(new EmptyAttributeNameIssueGenerator());
+            world.registerIssueGenerator(new EmptyAttributeValueIssueGenerator());
+            world.registerIssueGenerator(new LongAttributeNameIssueGenerator(game->maxPropertyLength()));
+            world.registerIssueGenerator(new LongAttributeValueIssueGenerator(game->maxPropertyLength()));
+            world.registerIssueGenerator(new AttributeNameWithDoubleQuotationMarksIssueGenerator());
+            world.registerIssueGenerator(new AttributeValueWithDoubleQuotationMarksIssueGenerator());
+            world.registerIssueGenerator(new InvalidTextureScaleIssueGenerator());
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_DefaultIssueGenerators
+#define TrenchBroom_DefaultIssueGenerators
+
+#include "FloatType.h"
+
+#include <vecmath/forward.h>
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        class Game;
+        class World;
+
+        /**
+         * Registers the issue generators that check every map with the given world.
+         *
+         * @param world the world to register the issue generators with
+         * @param game the game that the world belongs to
+         * @param worldBounds the world bounds
+         */
+        void registerDefaultIssueGenerators(World& world, std::shared_ptr<Game> game, const vm::bbox3& worldBounds);
+    }
+}
+
+#endif /* defined(TrenchBroom_DefaultIssueGenerators) */
@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DuplicateBrushesIssueGenerator.h"
+
+#include "Model/AssortNodesVisitor.h"
+#include "Model/Brush.h"
+#include "Model/Issue.h"
+#include "Model/World.h"
+
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class DuplicateBrushesIssueGenerator::DuplicateBrushesIssue : public Issue {
+        public:
+            static const IssueType Type;
+        public:
+            explicit DuplicateBrushesIssue(Brush* brush) :
+            Issue(brush) {}
+
+            IssueType doGetType() const override {
+                return Type;
+            }
+
+            std::string doGetDescription() const override {
+                return "Brush has the same shape as another brush";
+            }
+        };
+
+        const IssueType DuplicateBrushesIssueGenerator::DuplicateBrushesIssue::Type = Issue::freeType();
+
+        DuplicateBrushesIssueGenerator::DuplicateBrushesIssueGenerator() :
+        IssueGenerator(DuplicateBrushesIssue::Type, "Duplicate brushes") {}
+
+        bool DuplicateBrushesIssueGenerator::doInspectsNeighbours() const {
+            return true;
+        }
+
+        void DuplicateBrushesIssueGenerator::doGenerate(Brush* brush, IssueList& issues) const {
+            World* world = this->world();
+            if (world == nullptr) {
+                return;
+            }
+
+            const std::vector<Node*> candidates = world->findNodesIntersecting(brush->physicalBounds());
+            CollectBrushesVisitor visitor;
+            Node::accept(std::begin(candidates), std::end(candidates), visitor);
+
+            const std::vector<vm::vec3> positions = brush->vertexPositions();
+            for (const Brush* other : visitor.brushes()) {
+                if (other != brush &&
+                    other->vertexCount() == brush->vertexCount() &&
+                    other->hasVertices(positions, vm::C::almost_zero())) {
+                    issues.push_back(new DuplicateBrushesIssue(brush));
+                    return;
+                }
+            }
+        }
+    }
+}
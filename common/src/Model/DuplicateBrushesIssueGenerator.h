@@ -0,0 +1,43 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_DuplicateBrushesIssueGenerator
+#define TrenchBroom_DuplicateBrushesIssueGenerator
+
+#include "Model/IssueGenerator.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Finds brushes that have the same shape as another brush. The other brushes are looked up in the node tree of
+         * the world this generator is registered with, so only brushes with intersecting bounds are compared.
+         */
+        class DuplicateBrushesIssueGenerator : public IssueGenerator {
+        private:
+            class DuplicateBrushesIssue;
+        public:
+            DuplicateBrushesIssueGenerator();
+        private:
+            bool doInspectsNeighbours() const override;
+            void doGenerate(Brush* brush, IssueList& issues) const override;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_DuplicateBrushesIssueGenerator) */
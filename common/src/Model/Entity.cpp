@@ -45,6 +45,10 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -52,6 +56,13 @@ namespace TrenchBroom {
         const HitType::Type Entity::EntityHit = HitType::freeType();
         const vm::bbox3 Entity::DefaultBounds(8.0);
 
+        struct Entity::CachedModelSpecification {
+            const Assets::EntityDefinition* definition;
+            // the values of the attributes that the model expression read, or nullopt for attributes that were unset
+            std::vector<std::pair<std::string, std::optional<std::string>>> attributes;
+            Assets::ModelSpecification specification;
+        };
+
         Entity::Entity() :
         AttributableNode(),
         Object(),
@@ -60,6 +71,8 @@ namespace TrenchBroom {
             cacheAttributes();
         }
 
+        Entity::~Entity() = default;
+
         bool Entity::brushEntity() const {
             return hasChildren();
         }
@@ -136,10 +149,38 @@ namespace TrenchBroom {
         Assets::ModelSpecification Entity::modelSpecification() const {
             if (!hasPointEntityDefinition()) {
                 return Assets::ModelSpecification();
-            } else {
-                auto* pointDefinition = static_cast<Assets::PointEntityDefinition*>(m_definition);
-                return pointDefinition->model(m_attributes);
             }
+
+            // The model expression is evaluated by the renderer for every visible entity, but it usually depends on
+            // few attributes, if any. Reuse the last result unless one of these attributes has changed.
+            if (m_cachedModelSpecification != nullptr && m_cachedModelSpecification->definition == m_definition) {
+                const auto upToDate = std::all_of(std::begin(m_cachedModelSpecification->attributes), std::end(m_cachedModelSpecification->attributes), [&](const auto& nameAndValue) {
+                    const auto& [name, value] = nameAndValue;
+                    const auto* currentValue = m_attributes.attribute(name);
+                    return value ? (currentValue != nullptr && *currentValue == *value) : currentValue == nullptr;
+                });
+                if (upToDate) {
+                    return m_cachedModelSpecification->specification;
+                }
+            }
+            m_cachedModelSpecification.reset();
+
+            auto* pointDefinition = static_cast<Assets::PointEntityDefinition*>(m_definition);
+            auto referencedAttributes = std::optional<std::vector<std::string>>();
+            auto specification = pointDefinition->model(m_attributes, referencedAttributes);
+
+            if (referencedAttributes) {
+                auto cached = std::make_unique<CachedModelSpecification>();
+                cached->definition = m_definition;
+                cached->specification = specification;
+                for (const auto& name : *referencedAttributes) {
+                    const auto* value = m_attributes.attribute(name);
+                    cached->attributes.emplace_back(name, value != nullptr ? std::optional<std::string>(*value) : std::nullopt);
+                }
+                m_cachedModelSpecification = std::move(cached);
+            }
+
+            return specification;
         }
 
         const vm::bbox3& Entity::modelBounds() const {
@@ -231,7 +272,7 @@ namespace TrenchBroom {
             invalidateBounds();
         }
 
-        void Entity::doChildPhysicalBoundsDidChange() {
+        void Entity::doChildPhysicalBoundsDidChange(Node* /* node */, const vm::bbox3& /* oldBounds */) {
             const vm::bbox3 myOldBounds = physicalBounds();
             invalidateBounds();
             if (physicalBounds() != myOldBounds) {
@@ -307,6 +348,12 @@ namespace TrenchBroom {
         }
 
         void Entity::doAttributesDidChange(const vm::bbox3& oldBounds) {
+            // The entity definitions are unset before they are deleted. Forget the cached model specification then, so
+            // that it cannot be mistaken for the result of a new definition allocated at the same address.
+            if (m_cachedModelSpecification != nullptr && m_cachedModelSpecification->definition != m_definition) {
+                m_cachedModelSpecification.reset();
+            }
+
             // update m_cachedOrigin and m_cachedRotation. Must be done first because nodePhysicalBoundsDidChange() might
             // call origin()
             cacheAttributes();
@@ -31,6 +31,7 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,8 +56,16 @@ namespace TrenchBroom {
             mutable vm::mat4x4 m_cachedRotation;
 
             const Assets::EntityModelFrame* m_modelFrame;
+
+            /**
+             * The model specification computed by the most recent call to modelSpecification(), together with the
+             * values of the attributes it was computed from.
+             */
+            struct CachedModelSpecification;
+            mutable std::unique_ptr<CachedModelSpecification> m_cachedModelSpecification;
         public:
             Entity();
+            ~Entity() override;
 
             bool brushEntity() const;
             bool pointEntity() const;
@@ -97,7 +106,7 @@ namespace TrenchBroom {
             void doChildWasRemoved(Node* node) override;
 
             void doNodePhysicalBoundsDidChange() override;
-            void doChildPhysicalBoundsDidChange() override;
+            void doChildPhysicalBoundsDidChange(Node* node, const vm::bbox3& oldBounds) override;
 
             bool doSelectable() const override;
 
@@ -23,8 +23,10 @@
 #include "Model/EntityAttributeSnapshot.h"
 
 #include <kdl/string_compare.h>
-#include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <cassert>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -177,23 +179,50 @@ namespace TrenchBroom {
 
         void EntityAttributes::setAttributes(const std::vector<EntityAttribute>& attributes) {
             m_attributes.clear();
+            m_nameIndex.clear();
+
+            // sort the positions of the given attributes by name, keeping the first of several attributes with the
+            // same name
+            std::vector<size_t> sorted(attributes.size());
+            std::iota(std::begin(sorted), std::end(sorted), 0u);
+            std::stable_sort(std::begin(sorted), std::end(sorted), [&](const size_t lhs, const size_t rhs) {
+                return attributes[lhs].name() < attributes[rhs].name();
+            });
+
+            std::vector<bool> duplicate(attributes.size(), false);
+            for (size_t i = 1u; i < sorted.size(); ++i) {
+                if (attributes[sorted[i]].name() == attributes[sorted[i - 1u]].name()) {
+                    duplicate[sorted[i]] = true;
+                }
+            }
 
             // ensure that there are no duplicate names
-            kdl::vector_set<std::string> names(attributes.size());
-            for (const auto& attribute : attributes) {
-                if (names.insert(attribute.name()).second) {
-                    m_attributes.push_back(attribute);
+            std::vector<size_t> newIndex(attributes.size());
+            m_attributes.reserve(attributes.size());
+            for (size_t i = 0u; i < attributes.size(); ++i) {
+                if (!duplicate[i]) {
+                    newIndex[i] = m_attributes.size();
+                    m_attributes.push_back(attributes[i]);
+                }
+            }
+
+            m_nameIndex.reserve(m_attributes.size());
+            for (const auto i : sorted) {
+                if (!duplicate[i]) {
+                    m_nameIndex.push_back(newIndex[i]);
                 }
             }
         }
 
         const EntityAttribute& EntityAttributes::addOrUpdateAttribute(const std::string& name, const std::string& value, const Assets::AttributeDefinition* definition) {
-            auto it = findAttribute(name);
-            if (it != std::end(m_attributes)) {
-                assert(it->definition() == definition);
-                it->setValue(value);
-                return *it;
+            const auto indexIt = findNameIndex(name);
+            if (indexIt != std::end(m_nameIndex) && m_attributes[*indexIt].name() == name) {
+                auto& attribute = m_attributes[*indexIt];
+                assert(attribute.definition() == definition);
+                attribute.setValue(value);
+                return attribute;
             } else {
+                m_nameIndex.insert(indexIt, m_attributes.size());
                 m_attributes.push_back(EntityAttribute(name, value, definition));
                 return m_attributes.back();
             }
@@ -210,9 +239,18 @@ namespace TrenchBroom {
         }
 
         void EntityAttributes::removeAttribute(const std::string& name) {
-            auto it = findAttribute(name);
-            if (it != std::end(m_attributes)) {
-                m_attributes.erase(it);
+            const auto indexIt = findNameIndex(name);
+            if (indexIt != std::end(m_nameIndex) && m_attributes[*indexIt].name() == name) {
+                const auto index = *indexIt;
+                m_nameIndex.erase(indexIt);
+                m_attributes.erase(std::next(std::begin(m_attributes), static_cast<std::ptrdiff_t>(index)));
+
+                // the attributes after the removed one have moved to the front by one
+                for (auto& i : m_nameIndex) {
+                    if (i > index) {
+                        --i;
+                    }
+                }
             }
         }
 
@@ -229,12 +267,8 @@ namespace TrenchBroom {
         }
 
         bool EntityAttributes::hasAttribute(const std::string& name, const std::string& value) const {
-            for (const auto& attribute : m_attributes) {
-                if (attribute.hasNameAndValue(name, value)) {
-                    return true;
-                }
-            }
-            return false;
+            const auto it = findAttribute(name);
+            return it != std::end(m_attributes) && it->hasValue(value);
         }
 
         bool EntityAttributes::hasAttributeWithPrefix(const std::string& prefix, const std::string& value) const {
@@ -256,10 +290,9 @@ namespace TrenchBroom {
         }
 
         EntityAttributeSnapshot EntityAttributes::snapshot(const std::string& name) const {
-            for (const auto& attribute : m_attributes) {
-                if (attribute.hasName(name)) {
-                    return EntityAttributeSnapshot(attribute.name(), attribute.value());
-                }
+            const auto it = findAttribute(name);
+            if (it != std::end(m_attributes)) {
+                return EntityAttributeSnapshot(it->name(), it->value());
             }
             return EntityAttributeSnapshot(name);
         }
@@ -285,10 +318,9 @@ namespace TrenchBroom {
 
         std::vector<EntityAttribute> EntityAttributes::attributeWithName(const std::string& name) const {
             std::vector<EntityAttribute> result;
-            for (const auto& attribute : m_attributes) {
-                if (attribute.hasName(name)) {
-                    result.push_back(attribute);
-                }
+            const auto it = findAttribute(name);
+            if (it != std::end(m_attributes)) {
+                result.push_back(*it);
             }
             return result;
         }
@@ -314,21 +346,25 @@ namespace TrenchBroom {
         }
 
         std::vector<EntityAttribute>::const_iterator EntityAttributes::findAttribute(const std::string& name) const {
-            for (auto it = std::begin(m_attributes), end = std::end(m_attributes); it != end; ++it) {
-                if (it->hasName(name)) {
-                    return it;
-                }
+            const auto indexIt = findNameIndex(name);
+            if (indexIt != std::end(m_nameIndex) && m_attributes[*indexIt].name() == name) {
+                return std::next(std::begin(m_attributes), static_cast<std::ptrdiff_t>(*indexIt));
             }
             return std::end(m_attributes);
         }
 
         std::vector<EntityAttribute>::iterator EntityAttributes::findAttribute(const std::string& name) {
-            for (auto it = std::begin(m_attributes), end = std::end(m_attributes); it != end; ++it) {
-                if (it->hasName(name)) {
-                    return it;
-                }
+            const auto indexIt = findNameIndex(name);
+            if (indexIt != std::end(m_nameIndex) && m_attributes[*indexIt].name() == name) {
+                return std::next(std::begin(m_attributes), static_cast<std::ptrdiff_t>(*indexIt));
             }
             return std::end(m_attributes);
         }
+
+        std::vector<size_t>::const_iterator EntityAttributes::findNameIndex(const std::string& name) const {
+            return std::lower_bound(std::begin(m_nameIndex), std::end(m_nameIndex), name, [&](const size_t index, const std::string& n) {
+                return m_attributes[index].name() < n;
+            });
+        }
     }
 }
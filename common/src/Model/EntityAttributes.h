@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_EntityProperties
 #define TrenchBroom_EntityProperties
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -101,9 +102,18 @@ namespace TrenchBroom {
         bool isWorldspawn(const std::string& classname, const std::vector<EntityAttribute>& attributes);
         const std::string& findAttribute(const std::vector<EntityAttribute>& attributes, const std::string& name, const std::string& defaultValue = AttributeValues::DefaultValue);
 
+        /**
+         * The attributes of an entity. The attributes are kept in the order in which they were added, and additionally,
+         * the positions of the attributes are kept sorted by name, so that an attribute can be found by its name with
+         * a binary search.
+         */
         class EntityAttributes {
         private:
             std::vector<EntityAttribute> m_attributes;
+            /**
+             * The indices of the attributes in m_attributes, ordered by the attribute names.
+             */
+            std::vector<size_t> m_nameIndex;
         public:
             const std::vector<EntityAttribute>& attributes() const;
             void setAttributes(const std::vector<EntityAttribute>& attributes);
@@ -129,6 +139,11 @@ namespace TrenchBroom {
         private:
             std::vector<EntityAttribute>::const_iterator findAttribute(const std::string& name) const;
             std::vector<EntityAttribute>::iterator findAttribute(const std::string& name);
+
+            /**
+             * Returns the position in the name index at which an attribute with the given name is or would be stored.
+             */
+            std::vector<size_t>::const_iterator findNameIndex(const std::string& name) const;
         };
     }
 }
@@ -69,14 +69,18 @@ namespace TrenchBroom {
             return doNewMap(format, worldBounds, logger);
         }
 
-        std::unique_ptr<World> Game::loadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const {
-            return doLoadMap(format, worldBounds, path, logger);
+        std::unique_ptr<World> Game::loadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, const bool useMapCache, Logger& logger) const {
+            return doLoadMap(format, worldBounds, path, useMapCache, logger);
         }
 
         void Game::writeMap(World& world, const IO::Path& path) const {
             doWriteMap(world, path);
         }
 
+        std::string Game::serializeMap(World& world) const {
+            return doSerializeMap(world);
+        }
+
         void Game::exportMap(World& world, const Model::ExportFormat format, const IO::Path& path) const {
             doExportMap(world, format, path);
         }
@@ -101,8 +105,8 @@ namespace TrenchBroom {
             return doTexturePackageType();
         }
 
-        void Game::loadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const {
-            doLoadTextureCollections(node, documentPath, textureManager, logger);
+        void Game::loadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, const bool useTextureCache, Logger& logger) const {
+            doLoadTextureCollections(node, documentPath, textureManager, useTextureCache, logger);
         }
 
         bool Game::isTextureCollection(const IO::Path& path) const {
@@ -73,8 +73,18 @@ namespace TrenchBroom {
             const std::vector<SmartTag>& smartTags() const;
         public: // loading and writing map files
             std::unique_ptr<World> newMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const;
-            std::unique_ptr<World> loadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const;
+            /**
+             * Loads the map file with the given path. If useMapCache is true, the map is loaded from its map cache if
+             * the cache matches the map file, and otherwise a new map cache is recorded while the map file is parsed.
+             *
+             * @see IO::MapCache
+             */
+            std::unique_ptr<World> loadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const;
             void writeMap(World& world, const IO::Path& path) const;
+            /**
+             * Returns the contents of the map file that writeMap would write for the given world.
+             */
+            std::string serializeMap(World& world) const;
             void exportMap(World& world, Model::ExportFormat format, const IO::Path& path) const;
         public: // parsing and serializing objects
             std::vector<Node*> parseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const;
@@ -84,7 +94,13 @@ namespace TrenchBroom {
             void writeBrushFacesToStream(World& world, const std::vector<BrushFace*>& faces, std::ostream& stream) const;
         public: // texture collection handling
             TexturePackageType texturePackageType() const;
-            void loadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const;
+            /**
+             * Loads the texture collections referenced by the given node. If useTextureCache is true, decoded image
+             * files are stored in and read from the texture cache in the user data directory.
+             *
+             * @see IO::TextureCache
+             */
+            void loadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, bool useTextureCache, Logger& logger) const;
             bool isTextureCollection(const IO::Path& path) const;
             std::vector<IO::Path> findTextureCollections() const;
             std::vector<IO::Path> extractTextureCollections(const AttributableNode& node) const;
@@ -116,8 +132,9 @@ namespace TrenchBroom {
             virtual const std::vector<SmartTag>& doSmartTags() const = 0;
 
             virtual std::unique_ptr<World> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const = 0;
-            virtual std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const = 0;
+            virtual std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const = 0;
             virtual void doWriteMap(World& world, const IO::Path& path) const = 0;
+            virtual std::string doSerializeMap(World& world) const = 0;
             virtual void doExportMap(World& world, Model::ExportFormat format, const IO::Path& path) const = 0;
 
             virtual std::vector<Node*> doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const = 0;
@@ -126,7 +143,7 @@ namespace TrenchBroom {
             virtual void doWriteBrushFacesToStream(World& world, const std::vector<BrushFace*>& faces, std::ostream& stream) const = 0;
 
             virtual TexturePackageType doTexturePackageType() const = 0;
-            virtual void doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const = 0;
+            virtual void doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, bool useTextureCache, Logger& logger) const = 0;
             virtual bool doIsTextureCollection(const IO::Path& path) const = 0;
             virtual std::vector<IO::Path> doFindTextureCollections() const = 0;
             virtual std::vector<IO::Path> doExtractTextureCollections(const AttributableNode& node) const = 0;
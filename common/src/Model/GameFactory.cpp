@@ -21,6 +21,7 @@
 
 #include "Exceptions.h"
 #include "PreferenceManager.h"
+#include "Profiler.h"
 #include "RecoverableExceptions.h"
 #include "IO/CompilationConfigParser.h"
 #include "IO/CompilationConfigWriter.h"
@@ -38,6 +39,7 @@
 #include "Model/GameImpl.h"
 
 #include <kdl/collection_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_utils.h>
 
@@ -126,7 +128,13 @@ namespace TrenchBroom {
             if (cIt == std::end(m_configs)) {
                 throw GameException("Unknown game: " + name);
             }
-            return cIt->second;
+
+            auto& config = cIt->second;
+            if (m_unloadedProfiles.count(name) > 0) {
+                loadProfiles(config);
+                m_unloadedProfiles.erase(name);
+            }
+            return config;
         }
 
         const GameConfig& GameFactory::gameConfig(const std::string& name) const {
@@ -183,46 +191,59 @@ namespace TrenchBroom {
         }
 
         void GameFactory::loadGameConfigs() {
-            std::vector<std::string> errors;
+            TB_PROFILE_ZONE("GameFactory::loadGameConfigs");
 
             const auto configFiles = m_configFS->findItemsRecursively(IO::Path(""), IO::FileNameMatcher("GameConfig.cfg"));
-            for (const auto& configFilePath : configFiles) {
+            const auto count = configFiles.size();
+
+            std::vector<std::shared_ptr<IO::File>> files(count);
+            std::vector<IO::Path> absolutePaths(count);
+            std::vector<GameConfig> configs(count);
+            std::vector<std::string> errors(count);
+
+            // the file system is not safe to use from multiple threads, so we only parse the files in parallel
+            for (size_t i = 0; i < count; ++i) {
                 try {
-                loadGameConfig(configFilePath);
+                    files[i] = m_configFS->openFile(configFiles[i]);
+                    absolutePaths[i] = m_configFS->makeAbsolute(configFiles[i]);
                 } catch (const std::exception& e) {
-                    errors.push_back(kdl::str_to_string("Could not load game configuration file ", configFilePath, ": ", e.what()));
+                    errors[i] = kdl::str_to_string("Could not load game configuration file ", configFiles[i], ": ", e.what());
                 }
             }
 
-            kdl::sort(m_names, kdl::cs::string_less());
+            kdl::parallel_for(count, [&](const size_t i) {
+                if (files[i] != nullptr) {
+                    try {
+                        auto reader = files[i]->reader().buffer();
+                        IO::GameConfigParser parser(std::begin(reader), std::end(reader), absolutePaths[i]);
+                        configs[i] = parser.parse();
+                    } catch (const std::exception& e) {
+                        errors[i] = kdl::str_to_string("Could not load game configuration file ", configFiles[i], ": ", e.what());
+                    }
+                }
+            });
 
-            if (!errors.empty()) {
-                throw errors;
+            std::vector<std::string> allErrors;
+            for (size_t i = 0; i < count; ++i) {
+                if (errors[i].empty()) {
+                    addGameConfig(std::move(configs[i]));
+                } else {
+                    allErrors.push_back(std::move(errors[i]));
+                }
             }
-        }
 
-        void GameFactory::loadGameConfig(const IO::Path& path) {
-            try {
-                doLoadGameConfig(path);
-            } catch (const RecoverableException& e) {
-                e.recover();
-                doLoadGameConfig(path);
+            kdl::sort(m_names, kdl::cs::string_less());
+
+            if (!allErrors.empty()) {
+                throw allErrors;
             }
         }
 
-        void GameFactory::doLoadGameConfig(const IO::Path& path) {
-            const auto configFile = m_configFS->openFile(path);
-            const auto absolutePath = m_configFS->makeAbsolute(path);
-            auto reader = configFile->reader().buffer();
-            IO::GameConfigParser parser(std::begin(reader), std::end(reader), absolutePath);
-            GameConfig config = parser.parse();
-
-            loadCompilationConfig(config);
-            loadGameEngineConfig(config);
-
+        void GameFactory::addGameConfig(GameConfig config) {
             const auto configName = config.name();
             m_configs.emplace(std::make_pair(configName, std::move(config)));
             m_names.push_back(configName);
+            m_unloadedProfiles.insert(configName);
 
             const auto gamePathPrefPath = IO::Path("Games") + IO::Path(configName) + IO::Path("Path");
             m_gamePaths.insert(std::make_pair(configName, Preference<IO::Path>(gamePathPrefPath, IO::Path())));
@@ -231,6 +252,20 @@ namespace TrenchBroom {
             m_defaultEngines.insert(std::make_pair(configName, Preference<IO::Path>(defaultEnginePrefPath, IO::Path())));
         }
 
+        void GameFactory::loadProfiles(GameConfig& gameConfig) {
+            try {
+                doLoadProfiles(gameConfig);
+            } catch (const RecoverableException& e) {
+                e.recover();
+                doLoadProfiles(gameConfig);
+            }
+        }
+
+        void GameFactory::doLoadProfiles(GameConfig& gameConfig) {
+            loadCompilationConfig(gameConfig);
+            loadGameEngineConfig(gameConfig);
+        }
+
         void GameFactory::loadCompilationConfig(GameConfig& gameConfig) {
             const auto path = IO::Path(gameConfig.name()) + IO::Path("CompilationProfiles.cfg");
             try {
@@ -261,8 +296,11 @@ namespace TrenchBroom {
 
         void GameFactory::writeCompilationConfigs() {
             for (const auto& entry : m_configs) {
-                const auto& gameConfig = entry.second;
-                writeCompilationConfig(gameConfig);
+                // profiles which were never loaded cannot have been changed
+                if (m_unloadedProfiles.count(entry.first) == 0) {
+                    const auto& gameConfig = entry.second;
+                    writeCompilationConfig(gameConfig);
+                }
             }
         }
 
@@ -277,8 +315,11 @@ namespace TrenchBroom {
 
         void GameFactory::writeGameEngineConfigs() {
             for (const auto& entry : m_configs) {
-                const auto& gameConfig = entry.second;
-                writeGameEngineConfig(gameConfig);
+                // profiles which were never loaded cannot have been changed
+                if (m_unloadedProfiles.count(entry.first) == 0) {
+                    const auto& gameConfig = entry.second;
+                    writeGameEngineConfig(gameConfig);
+                }
             }
         }
 
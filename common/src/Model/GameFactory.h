@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,10 @@ namespace TrenchBroom {
 
             std::vector<std::string> m_names;
             ConfigMap m_configs;
+            /**
+             * The names of the games whose compilation and game engine profiles have not been loaded yet.
+             */
+            std::set<std::string> m_unloadedProfiles;
             mutable GamePathMap m_gamePaths;
             mutable GamePathMap m_defaultEngines;
         public:
@@ -59,6 +64,9 @@ namespace TrenchBroom {
              * Initializes the game factory, must be called once when the application starts. Initialization comprises
              * building a file system to find the builtin and user-provided game configurations and loading them.
              *
+             * The game configurations are parsed in parallel. The compilation and game engine profiles of a game are
+             * only loaded when its configuration is first accessed for modification, e.g. when a game is created.
+             *
              * If the file system cannot be built, a FileSystemException is thrown. Since this is a fatal error, the
              * caller should inform the user of the error and terminate the application.
              *
@@ -90,7 +98,21 @@ namespace TrenchBroom {
             bool setGamePath(const std::string& gameName, const IO::Path& gamePath);
             bool isGamePathPreference(const std::string& gameName, const IO::Path& prefPath) const;
 
+            /**
+             * Returns the configuration of the game with the given name, and loads its compilation and game engine
+             * profiles if they have not been loaded yet.
+             *
+             * @throw GameException if no config with the given name exists
+             */
             GameConfig& gameConfig(const std::string& gameName);
+
+            /**
+             * Returns the configuration of the game with the given name. The compilation and game engine profiles of
+             * the returned configuration may not have been loaded yet, so only its remaining information should be
+             * accessed.
+             *
+             * @throw GameException if no config with the given name exists
+             */
             const GameConfig& gameConfig(const std::string& gameName) const;
 
             std::pair<std::string, MapFormat> detectGame(const IO::Path& path) const;
@@ -98,8 +120,9 @@ namespace TrenchBroom {
             GameFactory();
             void initializeFileSystem();
             void loadGameConfigs();
-            void loadGameConfig(const IO::Path& path);
-            void doLoadGameConfig(const IO::Path& path);
+            void addGameConfig(GameConfig config);
+            void loadProfiles(GameConfig& gameConfig);
+            void doLoadProfiles(GameConfig& gameConfig);
             void loadCompilationConfig(GameConfig& gameConfig);
             void loadGameEngineConfig(GameConfig& gameConfig);
 
@@ -108,8 +131,6 @@ namespace TrenchBroom {
 
             void writeGameEngineConfigs();
             void writeGameEngineConfig(const GameConfig& gameConfig);
-
-
         };
     }
 }
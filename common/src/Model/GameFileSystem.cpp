@@ -31,10 +31,13 @@
 #include "IO/ZipFileSystem.h"
 #include "Model/GameConfig.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
 #include <memory>
+#include <string>
+#include <utility>
 
 namespace TrenchBroom {
     namespace Model {
@@ -111,25 +114,42 @@ namespace TrenchBroom {
                 auto packages = diskFS.findItems(IO::Path(""), IO::FileExtensionMatcher(packageExtensions));
                 kdl::vec_sort(packages, IO::Path::Less<kdl::ci::string_less>());
 
-                for (const auto& packagePath : packages) {
+                // Reading the directory of a package does not depend on the other packages, so the packages are
+                // opened in parallel and chained in order afterwards.
+                using PackageResult = std::pair<std::shared_ptr<IO::FileSystem>, std::string>;
+                auto results = kdl::vec_parallel_transform(packages, [&](const IO::Path& packagePath) {
                     try {
-                        if (kdl::ci::str_is_equal(packageFormat, "idpak")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::IdPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        } else if (kdl::ci::str_is_equal(packageFormat, "dkpak")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::DkPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::ZipFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        }
+                        return PackageResult(openPackage(packageFormat, diskFS.makeAbsolute(packagePath)), "");
                     } catch (const std::exception& e) {
-                        logger.error() << e.what();
+                        return PackageResult(nullptr, e.what());
+                    }
+                });
+
+                for (size_t i = 0; i < packages.size(); ++i) {
+                    auto& [package, error] = results[i];
+                    if (package != nullptr) {
+                        logger.info() << "Adding file system package " << packages[i];
+                        package->setNext(std::move(m_next));
+                        m_next = std::move(package);
+                    } else if (!error.empty()) {
+                        logger.error() << error;
                     }
                 }
             }
         }
 
+        std::shared_ptr<IO::FileSystem> GameFileSystem::openPackage(const std::string& packageFormat, const IO::Path& path) {
+            if (kdl::ci::str_is_equal(packageFormat, "idpak")) {
+                return std::make_shared<IO::IdPakFileSystem>(path);
+            } else if (kdl::ci::str_is_equal(packageFormat, "dkpak")) {
+                return std::make_shared<IO::DkPakFileSystem>(path);
+            } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
+                return std::make_shared<IO::ZipFileSystem>(path);
+            } else {
+                return nullptr;
+            }
+        }
+
         void GameFileSystem::addShaderFileSystem(const GameConfig& config, Logger& logger) {
             // To support Quake 3 shaders, we add a shader file system that loads the shaders
             // and makes them available as virtual files.
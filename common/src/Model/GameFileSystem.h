@@ -23,6 +23,7 @@
 #include "IO/FileSystem.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -49,6 +50,7 @@ namespace TrenchBroom {
             void addShaderFileSystem(const GameConfig& config, Logger& logger);
             void addFileSystemPath(const IO::Path& path, Logger& logger);
             void addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, Logger& logger);
+            static std::shared_ptr<IO::FileSystem> openPackage(const std::string& packageFormat, const IO::Path& path);
         private:
             bool doDirectoryExists(const IO::Path& path) const override;
             bool doFileExists(const IO::Path& path) const override;
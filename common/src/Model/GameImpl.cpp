@@ -24,6 +24,7 @@
 #include "Macros.h"
 #include "Assets/Palette.h"
 #include "Assets/EntityModel.h"
+#include "Assets/EntityDefinition.h"
 #include "Assets/EntityDefinitionFileSpec.h"
 #include "IO/AseParser.h"
 #include "IO/BrushFaceReader.h"
@@ -37,6 +38,7 @@
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/IOUtils.h"
+#include "IO/MapCache.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
@@ -45,6 +47,8 @@
 #include "IO/NodeWriter.h"
 #include "IO/ObjParser.h"
 #include "IO/ObjSerializer.h"
+#include "IO/ParserStatus.h"
+#include "IO/PathQt.h"
 #include "IO/WorldReader.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
@@ -62,17 +66,82 @@
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <QSaveFile>
+
 namespace TrenchBroom {
     namespace Model {
+        namespace {
+            void logMessage(IO::ParserStatus& status, const LogLevel level, const std::string& str) {
+                switch (level) {
+                    case LogLevel::Debug:
+                        status.debug(str);
+                        break;
+                    case LogLevel::Info:
+                        status.info(str);
+                        break;
+                    case LogLevel::Warn:
+                        status.warn(str);
+                        break;
+                    case LogLevel::Error:
+                        status.error(str);
+                        break;
+                    switchDefault()
+                }
+            }
+
+            /**
+             * Forwards the messages of a parser to another parser status and records them, so that they can be
+             * logged again when the parse result is reused.
+             */
+            class RecordingParserStatus : public IO::ParserStatus {
+            private:
+                NullLogger m_nullLogger;
+                IO::ParserStatus& m_target;
+                std::vector<std::pair<LogLevel, std::string>> m_messages;
+            public:
+                explicit RecordingParserStatus(IO::ParserStatus& target) :
+                ParserStatus(m_nullLogger, ""),
+                m_target(target) {}
+
+                std::vector<std::pair<LogLevel, std::string>> releaseMessages() {
+                    return std::move(m_messages);
+                }
+            private:
+                void doProgress(const double progress) override {
+                    m_target.progress(progress);
+                }
+
+                void doLog(const LogLevel level, const std::string& str) override {
+                    m_messages.emplace_back(level, str);
+                    logMessage(m_target, level, str);
+                }
+            };
+
+            std::optional<std::pair<size_t, uint64_t>> fileSizeAndHash(const IO::Path& path) {
+                try {
+                    const auto file = IO::Disk::openFile(path);
+                    auto reader = file->reader().buffer();
+                    return std::make_pair(file->size(), IO::MapCache::hash(std::begin(reader), std::end(reader)));
+                } catch (const Exception&) {
+                    return std::nullopt;
+                }
+            }
+        }
+
         GameImpl::GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger) :
         m_config(config),
         m_gamePath(gamePath) {
             initializeFileSystem(logger);
         }
 
+        GameImpl::~GameImpl() = default;
+
         void GameImpl::initializeFileSystem(Logger& logger) {
             m_fs.initialize(m_config, m_gamePath, m_additionalSearchPaths, logger);
         }
@@ -125,7 +194,7 @@ namespace TrenchBroom {
         std::unique_ptr<World> GameImpl::doNewMap(const MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const {
             const auto initialMapFilePath = m_config.findInitialMap(formatName(format));
             if (!initialMapFilePath.isEmpty() && IO::Disk::fileExists(initialMapFilePath)) {
-                return doLoadMap(format, worldBounds, initialMapFilePath, logger);
+                return doLoadMap(format, worldBounds, initialMapFilePath, false, logger);
             } else {
                 auto world = std::make_unique<World>(format);
 
@@ -141,22 +210,68 @@ namespace TrenchBroom {
             }
         }
 
-        std::unique_ptr<World> GameImpl::doLoadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const {
+        std::unique_ptr<World> GameImpl::doLoadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, const bool useMapCache, Logger& logger) const {
             IO::SimpleParserStatus parserStatus(logger);
             auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
             auto fileReader = file->reader().buffer();
+            if (!useMapCache) {
+                IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+                return worldReader.read(format, worldBounds, parserStatus);
+            }
+
+            const auto cachePath = IO::MapCache::cachePath(file->path());
+            if (IO::Disk::fileExists(cachePath)) {
+                try {
+                    const auto cacheFile = IO::Disk::openFile(cachePath);
+                    const auto cacheReader = cacheFile->reader().buffer();
+                    const auto cache = IO::MapCacheReader(std::begin(cacheReader), std::end(cacheReader));
+                    if (cache.matches(format, std::begin(fileReader), std::end(fileReader))) {
+                        return IO::WorldReader::readCached(cache, worldBounds, parserStatus);
+                    }
+                } catch (const Exception& e) {
+                    logger.warn() << "Ignoring map cache " << cachePath << ": " << e.what();
+                }
+            }
+
             IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
-            return worldReader.read(format, worldBounds, parserStatus);
+            auto cacheWriter = IO::MapCacheWriter(format, std::begin(fileReader), std::end(fileReader));
+            worldReader.setCacheWriter(&cacheWriter);
+            auto world = worldReader.read(format, worldBounds, parserStatus);
+
+            try {
+                cacheWriter.write(cachePath);
+            } catch (const FileSystemException& e) {
+                logger.warn() << "Could not write map cache " << cachePath << ": " << e.what();
+            }
+
+            return world;
         }
 
         void GameImpl::doWriteMap(World& world, const IO::Path& path) const {
+            // the map is serialized in memory and written in one go, which is much faster on network drives than many
+            // small writes; the file is replaced atomically so that a failed save does not destroy the previous file
+            const auto contents = doSerializeMap(world);
+
+            QSaveFile file(IO::pathAsQString(path));
+            if (!file.open(QIODevice::WriteOnly)) {
+                throw FileSystemException("Cannot open file: " + path.asString());
+            }
+
+            const auto size = static_cast<qint64>(contents.size());
+            if (file.write(contents.data(), size) != size || !file.commit()) {
+                throw FileSystemException("Cannot write file: " + path.asString());
+            }
+        }
+
+        std::string GameImpl::doSerializeMap(World& world) const {
             const auto mapFormatName = formatName(world.format());
 
-            IO::OpenFile open(path, true);
-            IO::writeGameComment(open.file, gameName(), mapFormatName);
+            std::string result;
+            IO::writeGameComment(result, gameName(), mapFormatName);
 
-            IO::NodeWriter writer(world, open.file);
+            IO::NodeWriter writer(world, result);
             writer.writeMap();
+            return result;
         }
 
         void GameImpl::doExportMap(World& world, const Model::ExportFormat format, const IO::Path& path) const {
@@ -202,11 +317,12 @@ namespace TrenchBroom {
             }
         }
 
-        void GameImpl::doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const {
+        void GameImpl::doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, const bool useTextureCache, Logger& logger) const {
             const auto paths = extractTextureCollections(node);
 
             const auto fileSearchPaths = textureCollectionSearchPaths(documentPath);
-            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger);
+            const auto textureCacheDirectory = useTextureCache ? IO::SystemPaths::userDataDirectory() + IO::Path("TextureCache") : IO::Path();
+            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger, textureCacheDirectory);
             textureLoader.loadTextures(paths, textureManager);
         }
 
@@ -291,6 +407,49 @@ namespace TrenchBroom {
         }
 
         std::vector<Assets::EntityDefinition*> GameImpl::doLoadEntityDefinitions(IO::ParserStatus& status, const IO::Path& path) const {
+            // Definition files are loaded again whenever the definition file of a document is changed, undone or
+            // reloaded. If none of the files that went into a previous result have changed, that result is reused.
+            auto it = m_entityDefinitionCache.find(path);
+            if (it != std::end(m_entityDefinitionCache)) {
+                const auto& cached = it->second;
+                const auto upToDate = std::all_of(std::begin(cached.files), std::end(cached.files), [](const auto& info) {
+                    const auto sizeAndHash = fileSizeAndHash(info.path);
+                    return sizeAndHash && sizeAndHash->first == info.size && sizeAndHash->second == info.hash;
+                });
+
+                if (upToDate) {
+                    for (const auto& [level, message] : cached.messages) {
+                        logMessage(status, level, message);
+                    }
+                    return kdl::vec_transform(cached.definitions, [](const auto& definition) { return definition->clone(); });
+                }
+                m_entityDefinitionCache.erase(it);
+            }
+
+            auto recordingStatus = RecordingParserStatus(status);
+            auto parsedFiles = std::vector<IO::Path>();
+            auto definitions = parseEntityDefinitions(recordingStatus, path, parsedFiles);
+
+            auto cached = CachedEntityDefinitions();
+            for (const auto& parsedFile : parsedFiles) {
+                const auto sizeAndHash = fileSizeAndHash(parsedFile);
+                if (!sizeAndHash) {
+                    // cannot validate the result later, so don't cache it
+                    return definitions;
+                }
+                cached.files.push_back(CachedFileInfo{ parsedFile, sizeAndHash->first, sizeAndHash->second });
+            }
+
+            cached.definitions = kdl::vec_transform(definitions, [](const auto* definition) {
+                return std::unique_ptr<Assets::EntityDefinition>(definition->clone());
+            });
+            cached.messages = recordingStatus.releaseMessages();
+            m_entityDefinitionCache.emplace(path, std::move(cached));
+
+            return definitions;
+        }
+
+        std::vector<Assets::EntityDefinition*> GameImpl::parseEntityDefinitions(IO::ParserStatus& status, const IO::Path& path, std::vector<IO::Path>& parsedFiles) const {
             const auto extension = path.extension();
             const auto& defaultColor = m_config.entityConfig().defaultColor;
 
@@ -298,16 +457,22 @@ namespace TrenchBroom {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
                 IO::FgdParser parser(std::begin(reader), std::end(reader), defaultColor, file->path());
-                return parser.parseDefinitions(status);
+                auto definitions = parser.parseDefinitions(status);
+
+                parsedFiles.push_back(file->path());
+                kdl::vec_append(parsedFiles, parser.includedFiles());
+                return definitions;
             } else if (kdl::ci::str_is_equal("def", extension)) {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
                 IO::DefParser parser(std::begin(reader), std::end(reader), defaultColor);
+                parsedFiles.push_back(file->path());
                 return parser.parseDefinitions(status);
             } else if (kdl::ci::str_is_equal("ent", extension)) {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
                 IO::EntParser parser(std::begin(reader), std::end(reader), defaultColor);
+                parsedFiles.push_back(file->path());
                 return parser.parseDefinitions(status);
             } else {
                 throw GameException("Unknown entity definition format: '" + path.asString() + "'");
@@ -21,18 +21,23 @@
 #define TrenchBroom_GameImpl
 
 #include "FloatType.h"
+#include "Logger.h"
 #include "IO/Path.h"
 #include "Model/Game.h"
 #include "Model/GameFileSystem.h"
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
     class Logger;
 
     namespace Assets {
+        class EntityDefinition;
         class Palette;
     }
 
@@ -43,8 +48,30 @@ namespace TrenchBroom {
             GameFileSystem m_fs;
             IO::Path m_gamePath;
             std::vector<IO::Path> m_additionalSearchPaths;
+
+            /**
+             * The size and content hash of a file that contributed to a cached entity definition file.
+             */
+            struct CachedFileInfo {
+                IO::Path path;
+                size_t size;
+                uint64_t hash;
+            };
+
+            /**
+             * The definitions parsed from an entity definition file together with the messages that the parser
+             * emitted. The entry is valid as long as none of the files it was parsed from have changed.
+             */
+            struct CachedEntityDefinitions {
+                std::vector<CachedFileInfo> files;
+                std::vector<std::unique_ptr<Assets::EntityDefinition>> definitions;
+                std::vector<std::pair<LogLevel, std::string>> messages;
+            };
+
+            mutable std::map<IO::Path, CachedEntityDefinitions> m_entityDefinitionCache;
         public:
             GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger);
+            ~GameImpl() override;
         private:
             void initializeFileSystem(Logger& logger);
         private:
@@ -61,8 +88,9 @@ namespace TrenchBroom {
             const std::vector<SmartTag>& doSmartTags() const override;
 
             std::unique_ptr<World> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const override;
-            std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const override;
+            std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const override;
             void doWriteMap(World& world, const IO::Path& path) const override;
+            std::string doSerializeMap(World& world) const override;
             void doExportMap(World& world, Model::ExportFormat format, const IO::Path& path) const override;
 
             std::vector<Node*> doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const override;
@@ -72,7 +100,7 @@ namespace TrenchBroom {
             void doWriteBrushFacesToStream(World& world, const std::vector<BrushFace*>& faces, std::ostream& stream) const override;
 
             TexturePackageType doTexturePackageType() const override;
-            void doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const override;
+            void doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, bool useTextureCache, Logger& logger) const override;
             std::vector<IO::Path> textureCollectionSearchPaths(const IO::Path& documentPath) const;
 
             bool doIsTextureCollection(const IO::Path& path) const override;
@@ -83,6 +111,7 @@ namespace TrenchBroom {
 
             bool doIsEntityDefinitionFile(const IO::Path& path) const override;
             std::vector<Assets::EntityDefinition*> doLoadEntityDefinitions(IO::ParserStatus& status, const IO::Path& path) const override;
+            std::vector<Assets::EntityDefinition*> parseEntityDefinitions(IO::ParserStatus& status, const IO::Path& path, std::vector<IO::Path>& parsedFiles) const;
             std::vector<Assets::EntityDefinitionFileSpec> doAllEntityDefinitionFiles() const override;
             Assets::EntityDefinitionFileSpec doExtractEntityDefinitionFile(const AttributableNode& node) const override;
             Assets::EntityDefinitionFileSpec defaultEntityDefinitionFile() const;
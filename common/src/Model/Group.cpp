@@ -153,21 +153,40 @@ namespace TrenchBroom {
             return false;
         }
 
-        void Group::doChildWasAdded(Node* /* node */) {
-            nodePhysicalBoundsDidChange(physicalBounds());
-        }
-
-        void Group::doChildWasRemoved(Node* /* node */) {
-            nodePhysicalBoundsDidChange(physicalBounds());
+        /*
+         The bounds are maintained incrementally because groups can contain thousands of nodes. Adding a child can only
+         grow the bounds, and changing or removing a child can only shrink them if the child's old bounds touched them.
+         Since the logical bounds are contained in the physical bounds, it suffices to check the child's physical bounds
+         against our logical bounds.
+         */
+
+        void Group::doChildWasAdded(Node* node) {
+            const vm::bbox3 myOldBounds = physicalBounds();
+            if (childCount() == 1u) {
+                // the bounds of an empty group are not related to its children
+                invalidateBounds();
+            } else {
+                mergeBounds(node);
+            }
+            nodePhysicalBoundsDidChange(myOldBounds);
         }
 
-        void Group::doNodePhysicalBoundsDidChange() {
-            invalidateBounds();
+        void Group::doChildWasRemoved(Node* node) {
+            const vm::bbox3 myOldBounds = physicalBounds();
+            if (!m_logicalBounds.encloses(node->physicalBounds())) {
+                invalidateBounds();
+            }
+            nodePhysicalBoundsDidChange(myOldBounds);
         }
 
-        void Group::doChildPhysicalBoundsDidChange() {
+        void Group::doChildPhysicalBoundsDidChange(Node* node, const vm::bbox3& oldBounds) {
             const vm::bbox3 myOldBounds = physicalBounds();
-            invalidateBounds();
+            if (m_logicalBounds.encloses(oldBounds)) {
+                mergeBounds(node);
+            } else {
+                invalidateBounds();
+            }
+
             if (physicalBounds() != myOldBounds) {
                 nodePhysicalBoundsDidChange(myOldBounds);
             }
@@ -249,6 +268,12 @@ namespace TrenchBroom {
             m_boundsValid = false;
         }
 
+        void Group::mergeBounds(const Node* node) {
+            assert(m_boundsValid);
+            m_logicalBounds = vm::merge(m_logicalBounds, node->logicalBounds());
+            m_physicalBounds = vm::merge(m_physicalBounds, node->physicalBounds());
+        }
+
         void Group::validateBounds() const {
             ComputeNodeBoundsVisitor visitor(BoundsType::Logical, vm::bbox3(0.0));
             iterate(visitor);
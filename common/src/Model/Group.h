@@ -77,8 +77,7 @@ namespace TrenchBroom {
             void doChildWasAdded(Node* node) override;
             void doChildWasRemoved(Node* node) override;
 
-            void doNodePhysicalBoundsDidChange() override;
-            void doChildPhysicalBoundsDidChange() override;
+            void doChildPhysicalBoundsDidChange(Node* node, const vm::bbox3& oldBounds) override;
 
             bool doSelectable() const override;
 
@@ -98,6 +97,7 @@ namespace TrenchBroom {
             bool doIntersects(const Node* node) const override;
         private:
             void invalidateBounds();
+            void mergeBounds(const Node* node);
             void validateBounds() const;
         private: // implement Taggable interface
             void doAcceptTagVisitor(TagVisitor& visitor) override;
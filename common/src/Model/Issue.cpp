@@ -27,6 +27,7 @@
 
 #include <kdl/vector_utils.h>
 
+#include <atomic>
 #include <string>
 
 namespace TrenchBroom {
@@ -91,7 +92,8 @@ namespace TrenchBroom {
         }
 
         size_t Issue::nextSeqId() {
-            static size_t seqId = 0;
+            // issues may be created concurrently, see World::validateBrushIssues
+            static std::atomic<size_t> seqId(0);
             return seqId++;
         }
 
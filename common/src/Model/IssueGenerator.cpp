@@ -47,6 +47,14 @@ namespace TrenchBroom {
             return m_quickFixes;
         }
 
+        bool IssueGenerator::inspectsNeighbours() const {
+            return doInspectsNeighbours();
+        }
+
+        void IssueGenerator::setWorld(World* world) {
+            m_world = world;
+        }
+
         void IssueGenerator::generate(World* world, IssueList& issues) const {
             doGenerate(world, issues);
         }
@@ -69,7 +77,8 @@ namespace TrenchBroom {
 
         IssueGenerator::IssueGenerator(const IssueType type, const std::string& description) :
         m_type(type),
-        m_description(description) {}
+        m_description(description),
+        m_world(nullptr) {}
 
         void IssueGenerator::addQuickFix(IssueQuickFix* quickFix) {
             ensure(quickFix != nullptr, "quickFix is null");
@@ -77,6 +86,14 @@ namespace TrenchBroom {
             m_quickFixes.push_back(quickFix);
         }
 
+        World* IssueGenerator::world() const {
+            return m_world;
+        }
+
+        bool IssueGenerator::doInspectsNeighbours() const {
+            return false;
+        }
+
         void IssueGenerator::doGenerate(World* world,      IssueList& issues) const { doGenerate(static_cast<AttributableNode*>(world), issues); }
         void IssueGenerator::doGenerate(Layer*,            IssueList&) const        {}
         void IssueGenerator::doGenerate(Group*,            IssueList&) const        {}
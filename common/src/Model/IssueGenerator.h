@@ -44,6 +44,7 @@ namespace TrenchBroom {
             IssueType m_type;
             std::string m_description;
             IssueQuickFixList m_quickFixes;
+            World* m_world;
         public:
             virtual ~IssueGenerator();
 
@@ -51,6 +52,17 @@ namespace TrenchBroom {
             const std::string& description() const;
             const IssueQuickFixList& quickFixes() const;
 
+            /**
+             * Indicates whether the issues generated for a node also depend on the nodes around it. If so, the world
+             * invalidates the issues of all nodes near a node that is added, removed or whose bounds change.
+             */
+            bool inspectsNeighbours() const;
+
+            /**
+             * Sets the world this generator is registered with. Only to be called by the world.
+             */
+            void setWorld(World* world);
+
             void generate(World* world,   IssueList& issues) const;
             void generate(Layer* layer,   IssueList& issues) const;
             void generate(Group* group,   IssueList& issues) const;
@@ -59,7 +71,17 @@ namespace TrenchBroom {
         protected:
             IssueGenerator(IssueType type, const std::string& description);
             void addQuickFix(IssueQuickFix* quickFix);
+
+            /**
+             * Returns the world this generator is registered with, or null if it isn't registered with a world.
+             *
+             * Generators which relate a node to other nodes should use the world's attributable node index and node
+             * tree to find the relevant nodes rather than visiting the entire map for every node.
+             */
+            World* world() const;
         private:
+            virtual bool doInspectsNeighbours() const;
+
             virtual void doGenerate(World* world,           IssueList& issues) const;
             virtual void doGenerate(Layer* layer,           IssueList& issues) const;
             virtual void doGenerate(Group* group,           IssueList& issues) const;
@@ -20,6 +20,8 @@
 #include "IssueQuickFix.h"
 
 #include "Model/Issue.h"
+#include "Model/MapFacade.h"
+#include "Model/Node.h"
 
 #include <cassert>
 #include <string>
@@ -33,6 +35,34 @@ namespace TrenchBroom {
 
         IssueQuickFix::~IssueQuickFix() {}
 
+        IssueType IssueQuickFix::issueType() const {
+            return m_issueType;
+        }
+
+        void IssueQuickFix::applyToNodes(MapFacade* facade, const std::vector<Node*>& nodes, const std::function<void()>& apply) {
+            std::vector<Node*> selectable;
+            bool unselectable = false;
+            for (Node* node : nodes) {
+                if (node->selectable()) {
+                    selectable.push_back(node);
+                } else {
+                    unselectable = true;
+                }
+            }
+
+            if (!selectable.empty()) {
+                facade->deselectAll();
+                facade->select(selectable);
+                apply();
+            }
+
+            if (unselectable) {
+                // if nothing is selected, attribute changes affect the world
+                facade->deselectAll();
+                apply();
+            }
+        }
+
         const std::string& IssueQuickFix::description() const {
             return m_description;
         }
@@ -22,6 +22,7 @@
 
 #include "Model/IssueType.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,7 @@ namespace TrenchBroom {
     namespace Model {
         class Issue;
         class MapFacade;
+        class Node;
 
         class IssueQuickFix {
         private:
@@ -36,6 +38,15 @@ namespace TrenchBroom {
             std::string m_description;
         protected:
             IssueQuickFix(IssueType issueType, const std::string& description);
+
+            IssueType issueType() const;
+
+            /**
+             * Selects the given nodes and calls the given function, so that a single command can change all of them.
+             * Nodes that cannot be selected, i.e. the world, are changed by calling the function once more with nothing
+             * selected.
+             */
+            static void applyToNodes(MapFacade* facade, const std::vector<Node*>& nodes, const std::function<void()>& apply);
         public:
             virtual ~IssueQuickFix();
 
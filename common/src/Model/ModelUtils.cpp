@@ -20,10 +20,13 @@
 #include "ModelUtils.h"
 
 #include "Ensure.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
 #include "Model/CollectNodesVisitor.h"
 
 #include <kdl/vector_utils.h>
 
+#include <map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -69,5 +72,25 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        std::vector<std::vector<BrushFace*>> groupFacesByBrush(const std::vector<BrushFace*>& faces) {
+            std::vector<std::vector<BrushFace*>> result;
+            std::map<const Brush*, size_t> groupIndices;
+
+            for (BrushFace* face : faces) {
+                const Brush* brush = face->brush();
+                if (brush == nullptr) {
+                    result.push_back({ face });
+                } else {
+                    const auto [it, inserted] = groupIndices.emplace(brush, result.size());
+                    if (inserted) {
+                        result.emplace_back();
+                    }
+                    result[it->second].push_back(face);
+                }
+            }
+
+            return result;
+        }
     }
 }
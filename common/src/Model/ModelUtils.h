@@ -28,6 +28,7 @@
 
 namespace TrenchBroom {
     namespace Model {
+        class BrushFace;
         class Node;
 
         std::vector<Node*> collectParents(const std::vector<Node*>& nodes);
@@ -43,6 +44,15 @@ namespace TrenchBroom {
         std::vector<Node*> collectChildren(const std::map<Node*, std::vector<Node*>>& nodes);
         std::vector<Node*> collectDescendants(const std::vector<Node*>& nodes);
         std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>& nodes);
+
+        /**
+         * Groups the given faces by the brushes they belong to, keeping the order in which the brushes first appear.
+         * Faces that don't belong to a brush are put into a group of their own.
+         *
+         * Changing a face also changes its brush, so faces of different groups can be changed concurrently, but the
+         * faces of one group must be changed on the same thread.
+         */
+        std::vector<std::vector<BrushFace*>> groupFacesByBrush(const std::vector<BrushFace*>& faces);
     }
 }
 
@@ -19,13 +19,16 @@
 
 #include "Node.h"
 
+#include "Assets/Texture.h"
 #include "Ensure.h"
 #include "Macros.h"
 #include "Model/Issue.h"
 #include "Model/IssueGenerator.h"
 #include "Model/LockState.h"
+#include "Model/NodeVisitor.h"
 #include "Model/VisibilityState.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox.h>
@@ -33,6 +36,7 @@
 #include <cassert>
 #include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -45,6 +49,8 @@ namespace TrenchBroom {
         m_descendantSelectionCount(0),
         m_visibilityState(VisibilityState::Visibility_Inherited),
         m_lockState(LockState::Lock_Inherited),
+        m_visible(true),
+        m_editable(true),
         m_lineNumber(0),
         m_lineCount(0),
         m_issuesValid(false),
@@ -91,10 +97,48 @@ namespace TrenchBroom {
             return clones;
         }
 
+        namespace {
+            /**
+             * Cloning a brush copies its faces, which updates the usage counts of their textures. These changes are
+             * recorded and applied afterwards. Cloning an entity updates the usage counts of its definition and
+             * model, so only brushes can be cloned concurrently.
+             */
+            class CanCloneConcurrently : public ConstNodeVisitor, public NodeQuery<bool> {
+            private:
+                void doVisit(const World*) override  { setResult(false); }
+                void doVisit(const Layer*) override  { setResult(false); }
+                void doVisit(const Group*) override  { setResult(false); }
+                void doVisit(const Entity*) override { setResult(false); }
+                void doVisit(const Brush*) override  { setResult(true);  }
+            };
+        }
+
         std::vector<Node*> Node::cloneRecursively(const vm::bbox3& worldBounds, const std::vector<Node*>& nodes) {
-            std::vector<Node*> clones;
-            clones.reserve(nodes.size());
-            cloneRecursively(worldBounds, std::begin(nodes), std::end(nodes), std::back_inserter(clones));
+            std::vector<Node*> clones(nodes.size(), nullptr);
+            std::vector<size_t> concurrentIndices;
+
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                CanCloneConcurrently query;
+                nodes[i]->accept(query);
+                if (query.result()) {
+                    concurrentIndices.push_back(i);
+                } else {
+                    clones[i] = nodes[i]->cloneRecursively(worldBounds);
+                }
+            }
+
+            std::vector<Assets::TextureUsageCountChanges> usageCountChanges(concurrentIndices.size());
+            kdl::parallel_for(concurrentIndices.size(), [&](const size_t i) {
+                const size_t index = concurrentIndices[i];
+                usageCountChanges[i].record([&]() {
+                    clones[index] = nodes[index]->cloneRecursively(worldBounds);
+                });
+            });
+
+            for (auto& changes : usageCountChanges) {
+                changes.apply();
+            }
+
             return clones;
         }
 
@@ -302,6 +346,7 @@ namespace TrenchBroom {
 
             parentWillChange();
             m_parent = parent;
+            updateVisibleAndEditable();
             parentDidChange();
         }
 
@@ -387,13 +432,7 @@ namespace TrenchBroom {
         }
 
         void Node::childPhysicalBoundsDidChange(Node* node, const vm::bbox3& oldBounds) {
-            const vm::bbox3 myOldBounds = physicalBounds();
-            if (!myOldBounds.encloses(oldBounds) && !myOldBounds.encloses(node->physicalBounds())) {
-                // Our bounds will change only if the child's bounds potentially contributed to our own bounds.
-                nodePhysicalBoundsDidChange(myOldBounds);
-            }
-
-            doChildPhysicalBoundsDidChange();
+            doChildPhysicalBoundsDidChange(node, oldBounds);
             descendantPhysicalBoundsDidChange(node, oldBounds, 1);
         }
 
@@ -504,15 +543,7 @@ namespace TrenchBroom {
         }
 
         bool Node::visible() const {
-            switch (m_visibilityState) {
-                case VisibilityState::Visibility_Inherited:
-                    return m_parent == nullptr || m_parent->visible();
-                case VisibilityState::Visibility_Hidden:
-                    return false;
-                case VisibilityState::Visibility_Shown:
-                    return true;
-                switchDefault()
-            }
+            return m_visible;
         }
 
         bool Node::shown() const {
@@ -530,6 +561,10 @@ namespace TrenchBroom {
         bool Node::setVisibilityState(const VisibilityState visibility) {
             if (visibility != m_visibilityState) {
                 m_visibilityState = visibility;
+                updateVisibleAndEditable();
+                if (m_parent != nullptr) {
+                    m_parent->descendantVisibilityStateDidChange(this);
+                }
                 return true;
             }
             return false;
@@ -542,15 +577,7 @@ namespace TrenchBroom {
         }
 
         bool Node::editable() const {
-            switch (m_lockState) {
-                case LockState::Lock_Inherited:
-                    return m_parent == nullptr || m_parent->editable();
-                case LockState::Lock_Locked:
-                    return false;
-                case LockState::Lock_Unlocked:
-                    return true;
-                switchDefault()
-            }
+            return m_editable;
         }
 
         bool Node::locked() const {
@@ -564,10 +591,56 @@ namespace TrenchBroom {
         bool Node::setLockState(const LockState lockState) {
             if (lockState != m_lockState) {
                 m_lockState = lockState;
+                updateVisibleAndEditable();
                 return true;
             }
             return false;
+        }
+
+        void Node::updateVisibleAndEditable() {
+            bool visible = true;
+            switch (m_visibilityState) {
+                case VisibilityState::Visibility_Inherited:
+                    visible = m_parent == nullptr || m_parent->visible();
+                    break;
+                case VisibilityState::Visibility_Hidden:
+                    visible = false;
+                    break;
+                case VisibilityState::Visibility_Shown:
+                    visible = true;
+                    break;
+                switchDefault()
+            }
+
+            bool editable = true;
+            switch (m_lockState) {
+                case LockState::Lock_Inherited:
+                    editable = m_parent == nullptr || m_parent->editable();
+                    break;
+                case LockState::Lock_Locked:
+                    editable = false;
+                    break;
+                case LockState::Lock_Unlocked:
+                    editable = true;
+                    break;
+                switchDefault()
+            }
 
+            // the children's states only depend on their own states and on this node's effective states
+            if (visible != m_visible || editable != m_editable) {
+                m_visible = visible;
+                m_editable = editable;
+                for (auto* child : m_children) {
+                    child->updateVisibleAndEditable();
+                }
+            }
+        }
+
+        void Node::descendantVisibilityStateDidChange(Node* node) {
+            doDescendantVisibilityStateDidChange(node);
+            if (shouldPropagateDescendantEvents() && m_parent != nullptr) {
+                m_parent->descendantVisibilityStateDidChange(node);
+            }
         }
 
         void Node::pick(const vm::ray3& ray, PickResult& pickResult) {
@@ -610,10 +683,17 @@ namespace TrenchBroom {
 
         void Node::validateIssues(const std::vector<IssueGenerator*>& issueGenerators) {
             if (!m_issuesValid) {
+                // generators that inspect neighbouring nodes may cause this node's issues to be invalidated while they
+                // run, so the new issues are only stored once all generators have finished, and the node is marked
+                // valid beforehand so that such an invalidation is not lost and the issues are generated again
+                m_issuesValid = true;
+
+                std::vector<Issue*> issues;
                 for (const auto* generator : issueGenerators) {
-                    doGenerateIssues(generator, m_issues);
+                    doGenerateIssues(generator, issues);
                 }
-                m_issuesValid = true;
+                clearIssues();
+                m_issues = std::move(issues);
             }
         }
 
@@ -669,8 +749,15 @@ namespace TrenchBroom {
         void Node::doAncestorDidChange() {}
 
         void Node::doNodePhysicalBoundsDidChange() {}
-        void Node::doChildPhysicalBoundsDidChange() {}
+        void Node::doChildPhysicalBoundsDidChange(Node* node, const vm::bbox3& oldBounds) {
+            const vm::bbox3 myOldBounds = physicalBounds();
+            if (!myOldBounds.encloses(oldBounds) && !myOldBounds.encloses(node->physicalBounds())) {
+                // Our bounds will change only if the child's bounds potentially contributed to our own bounds.
+                nodePhysicalBoundsDidChange(myOldBounds);
+            }
+        }
         void Node::doDescendantPhysicalBoundsDidChange(Node* /* node */) {}
+        void Node::doDescendantVisibilityStateDidChange(Node* /* node */) {}
 
         void Node::doChildWillChange(Node* /* node */) {}
         void Node::doChildDidChange(Node* /* node */) {}
@@ -54,6 +54,14 @@ namespace TrenchBroom {
             VisibilityState m_visibilityState;
             LockState m_lockState;
 
+            /**
+             * The effective visibility and lock state of this node, i.e., with inherited states resolved. These are
+             * updated for the whole subtree whenever they change, so that querying them does not have to walk up the
+             * hierarchy.
+             */
+            bool m_visible;
+            bool m_editable;
+
             size_t m_lineNumber;
             size_t m_lineCount;
 
@@ -87,11 +95,16 @@ namespace TrenchBroom {
             Node* clone(const vm::bbox3& worldBounds) const;
             Node* cloneRecursively(const vm::bbox3& worldBounds) const;
             NodeSnapshot* takeSnapshot();
+
+            /**
+             * Returns recursive clones of the given nodes in the same order. Brushes are cloned in parallel, while all
+             * other nodes are cloned on the calling thread.
+             */
+            static std::vector<Node*> cloneRecursively(const vm::bbox3& worldBounds, const std::vector<Node*>& nodes);
         protected:
             void cloneAttributes(Node* node) const;
 
             static std::vector<Node*> clone(const vm::bbox3& worldBounds, const std::vector<Node*>& nodes);
-            static std::vector<Node*> cloneRecursively(const vm::bbox3& worldBounds, const std::vector<Node*>& nodes);
 
             template <typename I, typename O>
             static void clone(const vm::bbox3& worldBounds, I cur, I end, O result) {
@@ -271,6 +284,9 @@ namespace TrenchBroom {
             bool locked() const;
             LockState lockState() const;
             bool setLockState(LockState lockState);
+        private:
+            void updateVisibleAndEditable();
+            void descendantVisibilityStateDidChange(Node* node);
         public: // picking
             void pick(const vm::ray3& ray, PickResult& result);
             void findNodesContaining(const vm::vec3& point, std::vector<Node*>& result);
@@ -285,8 +301,8 @@ namespace TrenchBroom {
             void setIssueHidden(IssueType type, bool hidden);
         public: // should only be called from this and from the world
             void invalidateIssues() const;
-        private:
             void validateIssues(const std::vector<IssueGenerator*>& issueGenerators);
+        private:
             void clearIssues() const;
         public: // visitors
             template <class V>
@@ -456,8 +472,20 @@ namespace TrenchBroom {
             virtual void doAncestorDidChange();
 
             virtual void doNodePhysicalBoundsDidChange();
-            virtual void doChildPhysicalBoundsDidChange();
+            /**
+             * Called when the physical bounds of the given child have changed. The default implementation notifies this
+             * node's parent if the child's old or new bounds may have contributed to this node's bounds.
+             *
+             * @param node the child whose bounds have changed
+             * @param oldBounds the child's previous physical bounds
+             */
+            virtual void doChildPhysicalBoundsDidChange(Node* node, const vm::bbox3& oldBounds);
             virtual void doDescendantPhysicalBoundsDidChange(Node* node);
+            /**
+             * Called when the visibility state of the given descendant has been set. The effective visibility of the
+             * descendant's own descendants may have changed, too.
+             */
+            virtual void doDescendantVisibilityStateDidChange(Node* node);
 
             virtual void doChildWillChange(Node* node);
             virtual void doChildDidChange(Node* node);
@@ -28,10 +28,20 @@
 #include "Model/NodeVisitor.h"
 
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Model {
+        namespace {
+            template <typename T>
+            void eraseNodes(std::vector<T*>& nodes, const std::unordered_set<const Node*>& nodesToErase) {
+                nodes.erase(std::remove_if(std::begin(nodes), std::end(nodes), [&](const T* node) {
+                    return nodesToErase.count(node) > 0u;
+                }), std::end(nodes));
+            }
+        }
+
         class NodeCollection::AddNode : public NodeVisitor {
         private:
             NodeCollection& m_collection;
@@ -187,8 +197,13 @@ namespace TrenchBroom {
         }
 
         void NodeCollection::removeNodes(const std::vector<Node*>& nodes) {
-            RemoveNode visitor(*this);
-            Node::accept(std::begin(nodes), std::end(nodes), visitor);
+            // removing the nodes one by one would take quadratic time, e.g. when deselecting most of a large selection
+            const auto nodesToErase = std::unordered_set<const Node*>(std::begin(nodes), std::end(nodes));
+            eraseNodes(m_nodes, nodesToErase);
+            eraseNodes(m_layers, nodesToErase);
+            eraseNodes(m_groups, nodesToErase);
+            eraseNodes(m_entities, nodesToErase);
+            eraseNodes(m_brushes, nodesToErase);
         }
 
         void NodeCollection::removeNode(Node* node) {
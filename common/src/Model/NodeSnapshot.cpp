@@ -26,5 +26,9 @@ namespace TrenchBroom {
         void NodeSnapshot::restore(const vm::bbox3& worldBounds) {
             doRestore(worldBounds);
         }
+
+        size_t NodeSnapshot::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
     }
 }
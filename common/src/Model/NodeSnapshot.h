@@ -22,14 +22,22 @@
 
 #include "FloatType.h"
 
+#include <cstddef>
+
 namespace TrenchBroom {
     namespace Model {
         class NodeSnapshot {
         public:
             virtual ~NodeSnapshot();
             void restore(const vm::bbox3& worldBounds);
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memoryUsage() const;
         private:
             virtual void doRestore(const vm::bbox3& worldBounds) = 0;
+            virtual size_t doGetMemoryUsage() const = 0;
         };
     }
 }
@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_NodeTraversal
+#define TrenchBroom_NodeTraversal
+
+#include "Model/Brush.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/Node.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
+
+#include <type_traits>
+
+namespace TrenchBroom {
+    namespace Model {
+        namespace detail {
+            /**
+             * Dispatches a node to the given function if it has type T. If T is Node, every node is dispatched. The
+             * function returns false to stop the traversal.
+             */
+            template <typename T, typename L>
+            class VisitNodeOfType : public NodeVisitor {
+            private:
+                L& m_lambda;
+                bool m_continue;
+            public:
+                explicit VisitNodeOfType(L& lambda) :
+                m_lambda(lambda),
+                m_continue(true) {}
+
+                bool shouldContinue() const {
+                    return m_continue;
+                }
+            private:
+                void doVisit(World* world) override   { dispatch(world);  }
+                void doVisit(Layer* layer) override   { dispatch(layer);  }
+                void doVisit(Group* group) override   { dispatch(group);  }
+                void doVisit(Entity* entity) override { dispatch(entity); }
+                void doVisit(Brush* brush) override   { dispatch(brush);  }
+
+                template <typename N>
+                void dispatch(N* node) {
+                    if constexpr (std::is_same_v<T, Node> || std::is_same_v<T, N>) {
+                        m_continue = m_lambda(static_cast<T*>(node));
+                    }
+                }
+            };
+
+            template <typename V, typename D>
+            bool traverse(Node* node, V& visitor, const D& descend) {
+                node->accept(visitor);
+                if (!visitor.shouldContinue()) {
+                    return false;
+                }
+                if (descend(node)) {
+                    for (auto* child : node->children()) {
+                        if (!traverse(child, visitor, descend)) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+        }
+
+        /**
+         * Calls the given function for the given node and each of its descendants of type T in depth first order. T
+         * is one of World, Layer, Group, Entity or Brush, or Node to visit nodes of every type. Unlike the visitor
+         * classes, this does not collect the nodes, so the caller decides where they go, e.g. into a preallocated
+         * vector or directly into an algorithm.
+         *
+         * @tparam T the type of the nodes to pass to the function
+         * @param node the root of the subtree to traverse
+         * @param lambda a function that accepts a T* and returns false to stop the traversal and true to continue
+         * @return false if the traversal was stopped by the function and true otherwise
+         */
+        template <typename T, typename L>
+        bool forEachNodeOfType(Node* node, L lambda) {
+            detail::VisitNodeOfType<T, L> visitor(lambda);
+            return detail::traverse(node, visitor, [](const Node*) { return true; });
+        }
+
+        /**
+         * Like forEachNodeOfType, but only calls the given function for selected nodes. Subtrees which do not contain
+         * any selected nodes are skipped entirely, so the cost depends on the size of the selection rather than on the
+         * size of the subtree.
+         */
+        template <typename T, typename L>
+        bool forEachSelectedNodeOfType(Node* node, L lambda) {
+            auto selected = [&](T* n) {
+                return !n->selected() || lambda(n);
+            };
+            detail::VisitNodeOfType<T, decltype(selected)> visitor(selected);
+            return detail::traverse(node, visitor, [](const Node* n) { return n->descendantSelectionCount() > 0u; });
+        }
+
+        /**
+         * Writes the selected nodes of type T in the given node ranges and their subtrees to the given output iterator.
+         *
+         * @return the output iterator past the last written node
+         */
+        template <typename T, typename I, typename O>
+        O collectSelectedNodesOfType(I cur, I end, O out) {
+            for (; cur != end; ++cur) {
+                forEachSelectedNodeOfType<T>(*cur, [&](T* node) {
+                    *out++ = node;
+                    return true;
+                });
+            }
+            return out;
+        }
+    }
+}
+
+#endif /* defined(TrenchBroom_NodeTraversal) */
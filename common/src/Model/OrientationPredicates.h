@@ -0,0 +1,209 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_OrientationPredicates_h
+#define TrenchBroom_OrientationPredicates_h
+
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Exact arithmetic on floating point expansions as described by Shewchuk in "Adaptive Precision Floating-Point
+         * Arithmetic and Fast Robust Geometric Predicates". An expansion represents a number as the exact sum of its
+         * nonoverlapping components, which are sorted by increasing magnitude.
+         */
+        namespace ExactArithmetic {
+            template <typename T>
+            using Expansion = std::vector<T>;
+
+            /**
+             * Computes the exact sum of a and b as the expansion (low, high).
+             */
+            template <typename T>
+            void twoSum(const T a, const T b, T& high, T& low) {
+                high = a + b;
+                const T bVirtual = high - a;
+                const T aVirtual = high - bVirtual;
+                low = (a - aVirtual) + (b - bVirtual);
+            }
+
+            /**
+             * Computes the exact product of a and b as the expansion (low, high).
+             */
+            template <typename T>
+            void twoProduct(const T a, const T b, T& high, T& low) {
+                high = a * b;
+                low = std::fma(a, b, -high);
+            }
+
+            /**
+             * Returns the exact difference of a and b.
+             */
+            template <typename T>
+            Expansion<T> difference(const T a, const T b) {
+                T high, low;
+                twoSum(a, -b, high, low);
+                return { low, high };
+            }
+
+            /**
+             * Returns the exact sum of the given expansions.
+             */
+            template <typename T>
+            Expansion<T> sum(const Expansion<T>& e, const Expansion<T>& f) {
+                auto result = e;
+                for (const T b : f) {
+                    // grow the result by b
+                    T q = b;
+                    for (T& component : result) {
+                        T high, low;
+                        twoSum(q, component, high, low);
+                        component = low;
+                        q = high;
+                    }
+                    result.push_back(q);
+                }
+                return result;
+            }
+
+            /**
+             * Returns the exact product of the given expansion and the given value.
+             */
+            template <typename T>
+            Expansion<T> scale(const Expansion<T>& e, const T b) {
+                auto result = Expansion<T>();
+                if (e.empty()) {
+                    return result;
+                }
+                result.reserve(2u * e.size());
+
+                T q, low;
+                twoProduct(e.front(), b, q, low);
+                result.push_back(low);
+
+                for (size_t i = 1u; i < e.size(); ++i) {
+                    T productHigh, productLow;
+                    twoProduct(e[i], b, productHigh, productLow);
+
+                    T sumHigh, sumLow;
+                    twoSum(q, productLow, sumHigh, sumLow);
+                    result.push_back(sumLow);
+
+                    // productHigh dominates sumHigh, so this sum is computed exactly by fast two sum
+                    q = productHigh + sumHigh;
+                    result.push_back(sumHigh - (q - productHigh));
+                }
+
+                result.push_back(q);
+                return result;
+            }
+
+            /**
+             * Returns the exact product of the given expansions.
+             */
+            template <typename T>
+            Expansion<T> product(const Expansion<T>& e, const Expansion<T>& f) {
+                auto result = Expansion<T>();
+                for (const T b : f) {
+                    result = sum(result, scale(e, b));
+                }
+                return result;
+            }
+
+            /**
+             * Returns the sign of the given expansion, which is the sign of its largest nonzero component.
+             */
+            template <typename T>
+            int sign(const Expansion<T>& e) {
+                for (auto it = e.rbegin(), end = e.rend(); it != end; ++it) {
+                    if (*it > T(0)) {
+                        return 1;
+                    } else if (*it < T(0)) {
+                        return -1;
+                    }
+                }
+                return 0;
+            }
+        }
+
+        /**
+         * Determines on which side of the plane through a, b and c the point d lies, where the plane normal is
+         * cross(b - a, c - a).
+         *
+         * The result is exact: 1 if d is above the plane, -1 if it is below the plane, and 0 if the four points are
+         * coplanar or a, b and c are colinear. The determinant is first evaluated in floating point and accepted if it
+         * exceeds a bound on its rounding error, which is the case unless the points are nearly coplanar. Only then is
+         * it evaluated again with exact arithmetic.
+         *
+         * Overflow and underflow of intermediate results are not handled, which does not matter for coordinates
+         * within any reasonable world bounds.
+         */
+        template <typename T>
+        int orientation(const vm::vec<T,3>& a, const vm::vec<T,3>& b, const vm::vec<T,3>& c, const vm::vec<T,3>& d) {
+            const T ux = d[0] - a[0], uy = d[1] - a[1], uz = d[2] - a[2];
+            const T vx = b[0] - a[0], vy = b[1] - a[1], vz = b[2] - a[2];
+            const T wx = c[0] - a[0], wy = c[1] - a[1], wz = c[2] - a[2];
+
+            const T vywz = vy * wz, vzwy = vz * wy;
+            const T vzwx = vz * wx, vxwz = vx * wz;
+            const T vxwy = vx * wy, vywx = vy * wx;
+
+            const T det = ux * (vywz - vzwy) + uy * (vzwx - vxwz) + uz * (vxwy - vywx);
+            const T permanent =
+                (std::abs(vywz) + std::abs(vzwy)) * std::abs(ux) +
+                (std::abs(vzwx) + std::abs(vxwz)) * std::abs(uy) +
+                (std::abs(vxwy) + std::abs(vywx)) * std::abs(uz);
+
+            // Shewchuk's error bound for orient3d, which also bounds the rounding error of the differences above
+            constexpr T epsilon = std::numeric_limits<T>::epsilon() / T(2);
+            constexpr T errorBound = (T(7) + T(56) * epsilon) * epsilon;
+            if (det > errorBound * permanent) {
+                return 1;
+            } else if (-det > errorBound * permanent) {
+                return -1;
+            }
+
+            using namespace ExactArithmetic;
+            const auto eux = difference(d[0], a[0]), euy = difference(d[1], a[1]), euz = difference(d[2], a[2]);
+            const auto evx = difference(b[0], a[0]), evy = difference(b[1], a[1]), evz = difference(b[2], a[2]);
+            const auto ewx = difference(c[0], a[0]), ewy = difference(c[1], a[1]), ewz = difference(c[2], a[2]);
+
+            const auto negate = [](Expansion<T> e) {
+                for (T& component : e) {
+                    component = -component;
+                }
+                return e;
+            };
+
+            const auto crossX = sum(product(evy, ewz), negate(product(evz, ewy)));
+            const auto crossY = sum(product(evz, ewx), negate(product(evx, ewz)));
+            const auto crossZ = sum(product(evx, ewy), negate(product(evy, ewx)));
+
+            const auto exactDet = sum(sum(product(eux, crossX), product(euy, crossY)), product(euz, crossZ));
+            return sign(exactDet);
+        }
+    }
+}
+
+#endif
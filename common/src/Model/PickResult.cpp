@@ -48,14 +48,40 @@ namespace TrenchBroom {
 
         PickResult::~PickResult() = default;
 
-        PickResult PickResult::byDistance(const EditorContext& editorContext) {
-            return PickResult(editorContext, std::make_shared<CombineCompareHits>(
+        static std::shared_ptr<CompareHits> compareByDistance() {
+            static const auto compare = std::make_shared<CombineCompareHits>(
                 std::make_unique<CompareHitsByDistance>(),
-                std::make_unique<CompareHitsByType>()));
+                std::make_unique<CompareHitsByType>());
+            return compare;
+        }
+
+        static std::shared_ptr<CompareHits> compareBySize(const vm::axis::type axis) {
+            static const std::shared_ptr<CompareHits> compare[] = {
+                std::make_shared<CompareHitsBySize>(vm::axis::x),
+                std::make_shared<CompareHitsBySize>(vm::axis::y),
+                std::make_shared<CompareHitsBySize>(vm::axis::z)
+            };
+            return compare[axis];
+        }
+
+        PickResult PickResult::byDistance(const EditorContext& editorContext) {
+            return PickResult(editorContext, compareByDistance());
         }
 
         PickResult PickResult::bySize(const EditorContext& editorContext, const vm::axis::type axis) {
-            return PickResult(editorContext, std::make_shared<CompareHitsBySize>(axis));
+            return PickResult(editorContext, compareBySize(axis));
+        }
+
+        void PickResult::resetByDistance(const EditorContext& editorContext) {
+            m_editorContext = &editorContext;
+            m_compare = compareByDistance();
+            m_hits.clear();
+        }
+
+        void PickResult::resetBySize(const EditorContext& editorContext, const vm::axis::type axis) {
+            m_editorContext = &editorContext;
+            m_compare = compareBySize(axis);
+            m_hits.clear();
         }
 
         bool PickResult::empty() const {
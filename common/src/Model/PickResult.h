@@ -51,6 +51,14 @@ namespace TrenchBroom {
             static PickResult byDistance(const EditorContext& editorContext);
             static PickResult bySize(const EditorContext& editorContext, vm::axis::type axis);
 
+            /**
+             * Clears this pick result and reconfigures it with the given editor context and hit order. The storage for
+             * the hits is retained, so a pick result that is reset and refilled repeatedly does not allocate memory once
+             * it has grown to the typical number of hits.
+             */
+            void resetByDistance(const EditorContext& editorContext);
+            void resetBySize(const EditorContext& editorContext, vm::axis::type axis);
+
             bool empty() const;
             size_t size() const;
 
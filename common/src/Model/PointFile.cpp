@@ -19,12 +19,15 @@
 
 #include "PointFile.h"
 
+#include "IO/File.h"
 #include "IO/Path.h"
 
 #include <vecmath/vec.h>
-#include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdlib>
 #include <fstream>
 #include <string>
 
@@ -83,29 +86,76 @@ namespace TrenchBroom {
             --m_current;
         }
 
+        namespace {
+            /**
+             * Parses the next number of the given line, which must be terminated by a non-numeric character.
+             */
+            bool parseFloat(const char*& cur, const char* end, float& result) {
+                while (cur != end && (*cur == ' ' || *cur == '\t')) {
+                    ++cur;
+                }
+
+                // the line is not null terminated, so the number has to be copied to be converted
+                std::array<char, 64> buffer;
+                size_t length = 0;
+                while (cur != end && *cur != ' ' && *cur != '\t' && length < buffer.size() - 1) {
+                    buffer[length++] = *cur++;
+                }
+                buffer[length] = '\0';
+
+                char* parsedEnd = nullptr;
+                result = std::strtof(buffer.data(), &parsedEnd);
+                return length > 0 && parsedEnd == buffer.data() + length;
+            }
+
+            /**
+             * Parses one point per line directly from the given file contents. Lines that do not contain a point,
+             * such as an empty line at the end of the file, are skipped.
+             */
+            std::vector<vm::vec3f> parsePoints(const char* begin, const char* end) {
+                std::vector<vm::vec3f> result;
+
+                const char* cur = begin;
+                while (cur != end) {
+                    const char* lineEnd = std::find(cur, end, '\n');
+                    const char* contentEnd = lineEnd;
+                    while (contentEnd != cur && *(contentEnd - 1) == '\r') {
+                        --contentEnd;
+                    }
+
+                    vm::vec3f point;
+                    if (parseFloat(cur, contentEnd, point[0]) &&
+                        parseFloat(cur, contentEnd, point[1]) &&
+                        parseFloat(cur, contentEnd, point[2])) {
+                        result.push_back(point);
+                    }
+
+                    cur = lineEnd != end ? lineEnd + 1 : end;
+                }
+
+                return result;
+            }
+        }
+
         void PointFile::load(const IO::Path& path) {
             static const float Threshold = vm::to_radians(15.0f);
 
-            std::fstream stream(path.asString().c_str(), std::ios::in);
-            assert(stream.is_open());
+            const IO::MappedFile file(path);
+            const std::vector<vm::vec3f> parsedPoints = parsePoints(file.begin(), file.end());
 
             std::vector<vm::vec3f> points;
 
-            if (!stream.eof()) {
-                std::string line;
-                std::getline(stream, line);
-                points.push_back(vm::parse<float, 3>(line));
+            if (!parsedPoints.empty()) {
+                points.push_back(parsedPoints.front());
                 vm::vec3f lastPoint = points.back();
 
-                if (!stream.eof()) {
-                    std::getline(stream, line);
-                    vm::vec3f curPoint = vm::parse<float, 3>(line);
+                if (parsedPoints.size() > 1) {
+                    vm::vec3f curPoint = parsedPoints[1];
                     vm::vec3f refDir = normalize(curPoint - lastPoint);
 
-                    while (!stream.eof()) {
+                    for (size_t i = 2; i < parsedPoints.size(); ++i) {
                         lastPoint = curPoint;
-                        std::getline(stream, line);
-                        curPoint = vm::parse<float, 3>(line);
+                        curPoint = parsedPoints[i];
 
                         const vm::vec3f dir = normalize(curPoint - lastPoint);
                         if (std::acos(dot(dir, refDir)) > Threshold) {
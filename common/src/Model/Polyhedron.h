@@ -31,12 +31,56 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <atomic>
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <unordered_map>
 #include <vector>
 
+#ifndef TB_POLYHEDRON_CHECK_LEVEL
+#define TB_POLYHEDRON_CHECK_LEVEL 2
+#endif
+
 namespace TrenchBroom {
     namespace Model {
+        /**
+         * The invariant checks that a polyhedron asserts after it was modified, i.e., after clipping it or adding a
+         * point. These checks only run if assertions are enabled.
+         */
+        enum class PolyhedronCheckLevel {
+            /**
+             * No checks are performed.
+             */
+            None = 0,
+            /**
+             * Only checks that take linear time in the size of the polyhedron are performed.
+             */
+            Cheap = 1,
+            /**
+             * All checks are performed, some of which take quadratic time in the size of the polyhedron.
+             */
+            Full = 2
+        };
+
+        /**
+         * Controls the invariant checks that are asserted by all polyhedra at run time. The default level can be set at
+         * compile time by defining TB_POLYHEDRON_CHECK_LEVEL as 0, 1 or 2.
+         *
+         * The settings should be changed before any polyhedra are built, since polyhedra may be modified concurrently.
+         */
+        struct PolyhedronChecks {
+            static inline PolyhedronCheckLevel level = static_cast<PolyhedronCheckLevel>(TB_POLYHEDRON_CHECK_LEVEL);
+            /**
+             * Only one of every `interval` modifications is checked. An interval of 0 or 1 checks every modification.
+             */
+            static inline std::size_t interval = 1u;
+            /**
+             * Counts the modifications to sample the ones that are checked.
+             */
+            static inline std::atomic<std::size_t> counter{0u};
+        };
+
         /* ====================== Implementation in Polyhedron_Vertex.h ====================== */
 
         /**
@@ -852,6 +896,11 @@ namespace TrenchBroom {
              * Computes the position of the given point in relation to the plane on which this face lies. This plane
              * is determined by the position of the origin of the first half edge of this face and the face normal.
              *
+             * If the given epsilon is zero, the position is determined exactly in relation to the plane through the
+             * vertices which determine the face normal, see orientation() in OrientationPredicates.h. This is robust
+             * even for large coordinates, but it is costlier than the epsilon based check if the point is very close
+             * to the plane.
+             *
              * @param point the point to check
              * @param epsilon the epsilon value to use for the position check
              * @return the relative position of the given point
@@ -1183,6 +1232,13 @@ namespace TrenchBroom {
              * Returns true if this polyhedron is not equal to the given polyhedron.
              */
             bool operator!=(const Polyhedron& other) const;
+        public: // memory accounting
+            /**
+             * Returns the number of bytes reserved by the pooled allocators for the vertices, edges, half edges and
+             * faces of all polyhedra of this type. The pools never shrink, so this reflects the peak number of
+             * elements rather than the number of elements currently in use.
+             */
+            static size_t allocatedMemory();
         public: // Accessors
             /**
              * Returns the number of vertices of this polyhedron.
@@ -1444,6 +1500,17 @@ namespace TrenchBroom {
              */
             void correctVertexPositions(const size_t decimals = 0, const T epsilon = vm::constants<T>::correct_epsilon());
 
+            /**
+             * Transforms the position of every vertex by the given matrix without changing the topology of this
+             * polyhedron. This is only valid for affine transformations that preserve orientation, because any other
+             * transformation would turn the faces inside out or make them non-planar.
+             *
+             * Updates the bounds of this polyhedron afterwards.
+             *
+             * @param transformation the transformation to apply
+             */
+            void transform(const vm::mat<T,4,4>& transformation);
+
             /**
              * Heals short edges by removing all edges shorter than the given minimum length. If removing an edge leads
              * to degenerate faces, these degenerate faces are removed, too.
@@ -1517,6 +1584,11 @@ namespace TrenchBroom {
             Edge* mergeNeighbours(HalfEdge* borderFirst, Edge* validEdge, Callback& callback);
 
             /* ====================== Implementation in Polyhedron_ConvexHull.h ====================== */
+        private:
+            /**
+             * Large point sets are added in Quickhull order using conflict lists; see addPointsWithConflictLists.
+             */
+            static constexpr const size_t MinPointsForConflictLists = 64u;
         public: // Convex hull; adding and removing points
             /**
              * Adds the given points to this polyhedron. The effect of adding the given points to a polyhedron is that
@@ -1557,6 +1629,27 @@ namespace TrenchBroom {
              * @param callback the callback to inform of lifecycle events
              */
             template <typename I> void addPoints(I cur, I end, Callback& callback);
+
+            class ConflictCallback;
+            using ConflictMap = std::unordered_map<Face*, std::vector<vm::vec<T,3>>>;
+
+            /**
+             * Adds the given points like Quickhull does. Once this polyhedron is three dimensional, every remaining
+             * point is assigned to the conflict list of a face that it is above, and points that are not above any face
+             * are discarded. Then the point furthest above its face is added repeatedly. The points in the conflict
+             * lists of the faces removed by adding a point are only tested against the faces created or changed by
+             * adding it. Points inside the growing hull are thereby discarded without testing them against every face.
+             *
+             * @param points the points to add
+             * @param callback the callback to inform of lifecycle events
+             */
+            void addPointsWithConflictLists(const std::vector<vm::vec<T,3>>& points, Callback& callback);
+
+            /**
+             * Returns the first of the given faces that the given point is above, or null if there is no such face.
+             */
+            template <typename C>
+            static Face* findConflictFace(const vm::vec<T,3>& position, const C& faces, const Callback& callback);
         public:
             /**
              * Adds the given point to this polyhedron. The effect of adding the given point to a polyhedron is that the
@@ -1913,6 +2006,26 @@ namespace TrenchBroom {
              */
             ClipResult clip(const vm::plane<T,3>& plane, Callback& callback);
 
+            /**
+             * Builds this polyhedron as the intersection of the half spaces below the given planes without clipping.
+             *
+             * The vertices are computed by intersecting every triple of planes and discarding the intersection points
+             * that are above any of the planes. Then every plane that contains at least three vertices becomes a face,
+             * and the faces are connected into the half edge structure in one pass. If several planes contain the same
+             * vertices, only the first of them becomes a face.
+             *
+             * This is much faster than clipping a large polyhedron with each plane if the number of planes is small,
+             * but the number of plane triples grows cubically with the number of planes.
+             *
+             * This polyhedron must be empty when this function is called. If the given planes do not bound a closed,
+             * non-degenerate polyhedron, this function returns false and this polyhedron remains empty.
+             *
+             * @param planes the planes to intersect
+             * @param faces receives the face created for each plane, or null if a plane does not contribute a face
+             * @return true if the polyhedron could be built and false otherwise
+             */
+            bool buildFromPlanes(const std::vector<vm::plane<T,3>>& planes, std::vector<Face*>& faces);
+
         private:
             /**
              * Checks whether this polyhedron is intersected by the given plane. Returns either of the following results.
@@ -2177,7 +2290,12 @@ namespace TrenchBroom {
 
             /* ====================== Implementation in Polyhedron_Checks.h ====================== */
         private: // invariants and checks
+            /**
+             * Checks the invariant according to the settings in PolyhedronChecks. Returns true if the check was skipped.
+             */
+            bool checkSampledInvariant() const;
             bool checkInvariant() const;
+            bool checkCheapInvariant() const;
             bool checkEulerCharacteristic() const;
             bool checkOverlappingFaces() const;
             bool checkFaceBoundaries() const;
@@ -21,6 +21,21 @@
 
 namespace TrenchBroom {
     namespace Model {
+        template <typename T, typename FP, typename VP>
+        bool Polyhedron<T,FP,VP>::checkSampledInvariant() const {
+            const PolyhedronCheckLevel level = PolyhedronChecks::level;
+            if (level == PolyhedronCheckLevel::None) {
+                return true;
+            }
+
+            const std::size_t interval = PolyhedronChecks::interval;
+            if (interval > 1u && PolyhedronChecks::counter++ % interval != 0u) {
+                return true;
+            }
+
+            return level == PolyhedronCheckLevel::Full ? checkInvariant() : checkCheapInvariant();
+        }
+
         template <typename T, typename FP, typename VP>
         bool Polyhedron<T,FP,VP>::checkInvariant() const {
             /*
@@ -50,6 +65,16 @@ namespace TrenchBroom {
             return true;
         }
 
+        template <typename T, typename FP, typename VP>
+        bool Polyhedron<T,FP,VP>::checkCheapInvariant() const {
+            // these checks don't search the vertex, edge and face lists and thus take linear time
+            if (!checkEulerCharacteristic())
+                return false;
+            if (!checkNoDegenerateFaces())
+                return false;
+            return true;
+        }
+
         template <typename T, typename FP, typename VP>
         bool Polyhedron<T,FP,VP>::checkEulerCharacteristic() const {
             if (!polyhedron())
@@ -29,6 +29,13 @@
 #include <vecmath/plane.h>
 #include <vecmath/scalar.h>
 #include <vecmath/util.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -73,7 +80,7 @@ namespace TrenchBroom {
                 sealWithSinglePolygon(seam, callback);
                 updateBounds();
 
-                assert(checkInvariant());
+                assert(checkSampledInvariant());
 
                 return ClipResult(ClipResult::Type_ClipSuccess);
             } catch (const NoSeamException&) {
@@ -103,6 +110,163 @@ namespace TrenchBroom {
             }
         }
 
+        template <typename T, typename FP, typename VP>
+        bool Polyhedron<T,FP,VP>::buildFromPlanes(const std::vector<vm::plane<T,3>>& planes, std::vector<Face*>& faces) {
+            assert(empty());
+
+            const auto epsilon = vm::constants<T>::point_status_epsilon();
+            const auto planeCount = planes.size();
+
+            faces.assign(planeCount, nullptr);
+            if (planeCount < 4u) {
+                return false;
+            }
+
+            // find the vertices at the intersections of three planes which are not above any plane
+            std::vector<vm::vec<T,3>> positions;
+            for (size_t i = 0u; i < planeCount; ++i) {
+                for (size_t j = i + 1u; j < planeCount; ++j) {
+                    const auto nij = vm::cross(planes[i].normal, planes[j].normal);
+                    for (size_t k = j + 1u; k < planeCount; ++k) {
+                        const auto det = vm::dot(planes[k].normal, nij);
+                        if (std::abs(det) < vm::constants<T>::almost_zero()) {
+                            continue;
+                        }
+
+                        const auto position = (
+                            vm::cross(planes[j].normal, planes[k].normal) * planes[i].distance +
+                            vm::cross(planes[k].normal, planes[i].normal) * planes[j].distance +
+                            nij * planes[k].distance) / det;
+
+                        const auto inside = std::all_of(std::begin(planes), std::end(planes), [&](const auto& plane) {
+                            return plane.point_distance(position) <= epsilon;
+                        });
+                        if (!inside) {
+                            continue;
+                        }
+
+                        const auto duplicate = std::any_of(std::begin(positions), std::end(positions), [&](const auto& p) {
+                            return vm::squared_distance(p, position) <= epsilon * epsilon;
+                        });
+                        if (!duplicate) {
+                            positions.push_back(position);
+                        }
+                    }
+                }
+            }
+
+            if (positions.size() < 4u) {
+                return false;
+            }
+
+            // collect the vertices on each plane and sort them counter clockwise when viewed from above the plane
+            std::vector<std::vector<size_t>> boundaries(planeCount);
+            for (size_t i = 0u; i < planeCount; ++i) {
+                const auto& plane = planes[i];
+
+                auto& boundary = boundaries[i];
+                vm::vec<T,3> center = vm::vec<T,3>::zero();
+                for (size_t v = 0u; v < positions.size(); ++v) {
+                    if (std::abs(plane.point_distance(positions[v])) <= epsilon) {
+                        boundary.push_back(v);
+                        center = center + positions[v];
+                    }
+                }
+
+                if (boundary.size() < 3u) {
+                    boundary.clear();
+                    continue;
+                }
+
+                center = center / static_cast<T>(boundary.size());
+                const auto u = vm::normalize(positions[boundary.front()] - center);
+                const auto w = vm::cross(plane.normal, u);
+
+                std::vector<std::pair<T, size_t>> angles;
+                angles.reserve(boundary.size());
+                for (const auto v : boundary) {
+                    const auto d = positions[v] - center;
+                    angles.emplace_back(std::atan2(vm::dot(d, w), vm::dot(d, u)), v);
+                }
+                std::sort(std::begin(angles), std::end(angles));
+
+                for (size_t v = 0u; v < angles.size(); ++v) {
+                    boundary[v] = angles[v].second;
+                }
+
+                // a plane that coincides with an earlier plane does not become a face
+                for (size_t j = 0u; j < i; ++j) {
+                    auto lhs = boundaries[j];
+                    auto rhs = boundary;
+                    std::sort(std::begin(lhs), std::end(lhs));
+                    std::sort(std::begin(rhs), std::end(rhs));
+                    if (lhs == rhs) {
+                        boundary.clear();
+                        break;
+                    }
+                }
+            }
+
+            std::vector<Vertex*> vertices;
+            vertices.reserve(positions.size());
+            for (const auto& position : positions) {
+                auto* vertex = new Vertex(position);
+                m_vertices.push_back(vertex);
+                vertices.push_back(vertex);
+            }
+
+            // create the faces and connect their half edges by matching origin and destination
+            std::map<std::pair<size_t, size_t>, HalfEdge*> halfEdges;
+            auto valid = true;
+            size_t faceCount = 0u;
+            for (size_t i = 0u; i < planeCount && valid; ++i) {
+                const auto& boundary = boundaries[i];
+                if (boundary.empty()) {
+                    continue;
+                }
+
+                HalfEdgeList faceBoundary;
+                for (size_t v = 0u; v < boundary.size() && valid; ++v) {
+                    const auto origin = boundary[v];
+                    const auto destination = boundary[(v + 1u) % boundary.size()];
+
+                    auto* halfEdge = new HalfEdge(vertices[origin]);
+                    faceBoundary.push_back(halfEdge);
+                    valid = halfEdges.emplace(std::make_pair(origin, destination), halfEdge).second;
+                }
+
+                auto* face = new Face(std::move(faceBoundary));
+                m_faces.push_back(face);
+                faces[i] = face;
+                ++faceCount;
+            }
+
+            size_t edgeCount = 0u;
+            for (auto it = std::begin(halfEdges), end = std::end(halfEdges); it != end && valid; ++it) {
+                const auto [origin, destination] = it->first;
+                if (origin < destination) {
+                    const auto twin = halfEdges.find(std::make_pair(destination, origin));
+                    if (twin == std::end(halfEdges)) {
+                        valid = false;
+                    } else {
+                        m_edges.push_back(new Edge(it->second, twin->second));
+                        ++edgeCount;
+                    }
+                }
+            }
+
+            // every half edge must have been paired, and the result must satisfy Euler's formula
+            valid = valid && 2u * edgeCount == halfEdges.size() && positions.size() + faceCount == edgeCount + 2u;
+            if (!valid) {
+                clear();
+                faces.assign(planeCount, nullptr);
+                return false;
+            }
+
+            updateBounds();
+            return true;
+        }
+
         template <typename T, typename FP, typename VP>
         typename Polyhedron<T,FP,VP>::ClipResult Polyhedron<T,FP,VP>::checkIntersects(const vm::plane<T,3>& plane) const {
             std::size_t above = 0u;
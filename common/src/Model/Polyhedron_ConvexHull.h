@@ -30,7 +30,10 @@
 #include <vecmath/constants.h>
 #include <vecmath/util.h>
 
+#include <algorithm>
+#include <iterator>
 #include <list>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -49,16 +52,163 @@ namespace TrenchBroom {
         template <typename T, typename FP, typename VP> template <typename I>
         void Polyhedron<T,FP,VP>::addPoints(I cur, I end) {
             Callback c;
-            while (cur != end) {
-                addPoint(*cur++, c);
-            }
+            addPoints(cur, end, c);
         }
 
         template <typename T, typename FP, typename VP> template <typename I>
         void Polyhedron<T,FP,VP>::addPoints(I cur, I end, Callback& callback) {
-            while (cur != end) {
-                addPoint(*cur++, callback);
+            const std::vector<vm::vec<T,3>> points(cur, end);
+            if (points.size() >= MinPointsForConflictLists) {
+                addPointsWithConflictLists(points, callback);
+            } else {
+                for (const auto& point : points) {
+                    addPoint(point, callback);
+                }
+            }
+        }
+
+        /**
+         * Forwards all events to another callback and maintains the conflict lists while a point is added. The conflict
+         * lists of deleted faces are collected as orphans, and the faces that were created or changed are recorded so
+         * that the orphans can be reassigned to them.
+         */
+        template <typename T, typename FP, typename VP>
+        class Polyhedron<T,FP,VP>::ConflictCallback : public Callback {
+        private:
+            Callback& m_callback;
+            ConflictMap& m_conflicts;
+            std::vector<vm::vec<T,3>> m_orphans;
+            std::vector<Face*> m_changedFaces;
+        public:
+            ConflictCallback(Callback& callback, ConflictMap& conflicts) :
+            m_callback(callback),
+            m_conflicts(conflicts) {}
+
+            const std::vector<vm::vec<T,3>>& orphans() const {
+                return m_orphans;
+            }
+
+            const std::vector<Face*>& changedFaces() const {
+                return m_changedFaces;
+            }
+
+            void vertexWasCreated(Vertex* vertex) override {
+                m_callback.vertexWasCreated(vertex);
+            }
+
+            void vertexWillBeDeleted(Vertex* vertex) override {
+                m_callback.vertexWillBeDeleted(vertex);
+            }
+
+            void vertexWasAdded(Vertex* vertex) override {
+                m_callback.vertexWasAdded(vertex);
+            }
+
+            void vertexWillBeRemoved(Vertex* vertex) override {
+                m_callback.vertexWillBeRemoved(vertex);
+            }
+
+            vm::plane<T,3> getPlane(const Face* face) const override {
+                return m_callback.getPlane(face);
+            }
+
+            void faceWasCreated(Face* face) override {
+                m_changedFaces.push_back(face);
+                m_callback.faceWasCreated(face);
+            }
+
+            void faceWillBeDeleted(Face* face) override {
+                removeFace(face);
+                m_callback.faceWillBeDeleted(face);
+            }
+
+            void faceDidChange(Face* face) override {
+                m_changedFaces.push_back(face);
+                m_callback.faceDidChange(face);
+            }
+
+            void faceWasFlipped(Face* face) override {
+                m_changedFaces.push_back(face);
+                m_callback.faceWasFlipped(face);
             }
+
+            void faceWasSplit(Face* original, Face* clone) override {
+                m_changedFaces.push_back(original);
+                m_changedFaces.push_back(clone);
+                m_callback.faceWasSplit(original, clone);
+            }
+
+            void facesWillBeMerged(Face* remaining, Face* toDelete) override {
+                m_changedFaces.push_back(remaining);
+                removeFace(toDelete);
+                m_callback.facesWillBeMerged(remaining, toDelete);
+            }
+        private:
+            /**
+             * Must be called before the given face is deleted, since its address may be reused by a new face.
+             */
+            void removeFace(Face* face) {
+                m_changedFaces.erase(std::remove(std::begin(m_changedFaces), std::end(m_changedFaces), face), std::end(m_changedFaces));
+
+                const auto it = m_conflicts.find(face);
+                if (it != std::end(m_conflicts)) {
+                    m_orphans.insert(std::end(m_orphans), std::begin(it->second), std::end(it->second));
+                    m_conflicts.erase(it);
+                }
+            }
+        };
+
+        template <typename T, typename FP, typename VP>
+        void Polyhedron<T,FP,VP>::addPointsWithConflictLists(const std::vector<vm::vec<T,3>>& points, Callback& callback) {
+            auto it = std::begin(points);
+            auto end = std::end(points);
+            while (it != end && !polyhedron()) {
+                addPoint(*it++, callback);
+            }
+
+            ConflictMap conflicts;
+            for (; it != end; ++it) {
+                if (auto* face = findConflictFace(*it, m_faces, callback)) {
+                    conflicts[face].push_back(*it);
+                }
+            }
+
+            while (!conflicts.empty()) {
+                const auto conflict = std::begin(conflicts);
+                const auto plane = callback.getPlane(conflict->first);
+
+                // add the point that is furthest above the face, which is a vertex of the final hull
+                auto& conflictList = conflict->second;
+                const auto furthest = std::max_element(std::begin(conflictList), std::end(conflictList), [&](const auto& lhs, const auto& rhs) {
+                    return plane.point_distance(lhs) < plane.point_distance(rhs);
+                });
+                const auto position = *furthest;
+                *furthest = conflictList.back();
+                conflictList.pop_back();
+                if (conflictList.empty()) {
+                    conflicts.erase(conflict);
+                }
+
+                ConflictCallback conflictCallback(callback, conflicts);
+                addPoint(position, conflictCallback);
+
+                // a point that was above a removed face is either above one of the new faces or inside the hull
+                for (const auto& orphan : conflictCallback.orphans()) {
+                    if (auto* face = findConflictFace(orphan, conflictCallback.changedFaces(), callback)) {
+                        conflicts[face].push_back(orphan);
+                    }
+                }
+            }
+        }
+
+        template <typename T, typename FP, typename VP> template <typename C>
+        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::findConflictFace(const vm::vec<T,3>& position, const C& faces, const Callback& callback) {
+            for (auto* face : faces) {
+                if (callback.getPlane(face).point_status(position) == vm::plane_status::above) {
+                    return face;
+                }
+            }
+            return nullptr;
         }
 
         template <typename T, typename FP, typename VP>
@@ -69,7 +219,7 @@ namespace TrenchBroom {
 
         template <typename T, typename FP, typename VP>
         typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addPoint(const vm::vec<T,3>& position, Callback& callback) {
-            assert(checkInvariant());
+            assert(checkSampledInvariant());
             Vertex* result = nullptr;
             switch (vertexCount()) {
                 case 0:
@@ -91,7 +241,7 @@ namespace TrenchBroom {
                     }
                     break;
             }
-            assert(checkInvariant());
+            assert(checkSampledInvariant());
             if (result != nullptr) {
                 callback.vertexWasAdded(result);
             }
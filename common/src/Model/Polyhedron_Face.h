@@ -23,6 +23,7 @@
 #include "Macros.h"
 
 #include "Polyhedron.h"
+#include "Model/OrientationPredicates.h"
 
 #include <vecmath/vec.h>
 #include <vecmath/ray.h>
@@ -246,6 +247,26 @@ m_link(this)
 
         template <typename T, typename FP, typename VP>
         vm::plane_status Polyhedron_Face<T,FP,VP>::pointStatus(const vm::vec<T,3>& point, const T epsilon) const {
+            if (epsilon == static_cast<T>(0.0)) {
+                // use the same vertices as normal() does to determine the plane
+                for (const HalfEdge* halfEdge : m_boundary) {
+                    const auto& p1 = halfEdge->origin()->position();
+                    const auto& p2 = halfEdge->next()->origin()->position();
+                    const auto& p3 = halfEdge->next()->next()->origin()->position();
+                    if (!vm::is_zero(vm::cross(p2 - p1, p3 - p1), vm::constants<T>::almost_zero())) {
+                        const auto result = orientation(p1, p2, p3, point);
+                        if (result > 0) {
+                            return vm::plane_status::above;
+                        } else if (result < 0) {
+                            return vm::plane_status::below;
+                        } else {
+                            return vm::plane_status::inside;
+                        }
+                    }
+                }
+                return vm::plane_status::inside;
+            }
+
             const auto norm = normal();
             const auto distance = vm::dot(point - origin(), norm);
             if (distance > epsilon) {
@@ -27,8 +27,11 @@
 #include <kdl/vector_utils.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <functional>
 #include <limits>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -55,6 +58,10 @@ namespace TrenchBroom {
          * Using this relation over the vertices, the matcher will find the best matching face from the left polyhedron for
          * each face of the right polyhedron. If multiple faces of the left polyhedron have a maximal matching score, the
          * matcher selects a face such that its normal is closest to the normal of the right face.
+         *
+         * To avoid comparing every face of the right polyhedron against every face of the left polyhedron, the matcher
+         * indexes the left faces by a hash of their vertex positions so that unchanged faces are found by a single lookup,
+         * and it only scores those left faces that are incident to a vertex related to a vertex of the right face.
          */
         template <typename P>
         class PolyhedronMatcher {
@@ -68,25 +75,35 @@ namespace TrenchBroom {
             using VMap = std::map<V,V>;
 
             using VertexRelation = kdl::binary_relation<Vertex*, Vertex*>;
+            using FaceIndex = std::unordered_map<Face*, size_t>;
+            using FacesByPositions = std::unordered_multimap<size_t, Face*>;
 
             const P& m_left;
             const P& m_right;
             const VertexRelation m_vertexRelation;
+            const FaceIndex m_leftFaceIndex;
+            const FacesByPositions m_leftFacesByPositions;
         public:
             PolyhedronMatcher(const P& left, const P& right) :
                 m_left(left),
                 m_right(right),
-                m_vertexRelation(buildVertexRelation(m_left, m_right)) {}
+                m_vertexRelation(buildVertexRelation(m_left, m_right)),
+                m_leftFaceIndex(buildFaceIndex(m_left)),
+                m_leftFacesByPositions(buildFacesByPositions(m_left)) {}
 
             PolyhedronMatcher(const P& left, const P& right, const std::vector<V>& vertices, const V& delta) :
                 m_left(left),
                 m_right(right),
-                m_vertexRelation(buildVertexRelation(m_left, m_right, vertices, delta)) {}
+                m_vertexRelation(buildVertexRelation(m_left, m_right, vertices, delta)),
+                m_leftFaceIndex(buildFaceIndex(m_left)),
+                m_leftFacesByPositions(buildFacesByPositions(m_left)) {}
 
             PolyhedronMatcher(const P& left, const P& right, const VMap& vertexMap) :
                 m_left(left),
                 m_right(right),
-                m_vertexRelation(buildVertexRelation(m_left, m_right, vertexMap)) {}
+                m_vertexRelation(buildVertexRelation(m_left, m_right, vertexMap)),
+                m_leftFaceIndex(buildFaceIndex(m_left)),
+                m_leftFacesByPositions(buildFacesByPositions(m_left)) {}
         public:
             /**
              * Apply the given callback function to each pair of matching faces. The algorithm iterates over all faces of the
@@ -119,6 +136,12 @@ namespace TrenchBroom {
              * @return a best matching face of the left polyhedron
              */
             Face* findBestMatchingLeftFace(Face* rightFace) const {
+                // exit early if the right face is unchanged
+                auto* identicalFace = findIdenticalLeftFace(rightFace);
+                if (identicalFace != nullptr) {
+                    return identicalFace;
+                }
+
                 const auto matchingFaces = findMatchingLeftFaces(rightFace);
                 ensure(!matchingFaces.empty(), "No matching face found");
 
@@ -142,31 +165,82 @@ namespace TrenchBroom {
                 return result;
             }
 
+            /**
+             * Find a face of the left polyhedron that has exactly the same vertex positions as the given face of the right
+             * polyhedron.
+             *
+             * @param rightFace the face of the right polyhedron
+             * @return the identical face of the left polyhedron or nullptr if there is no such face
+             */
+            Face* findIdenticalLeftFace(Face* rightFace) const {
+                const auto positions = rightFace->vertexPositions();
+                const auto range = m_leftFacesByPositions.equal_range(hashPositions(positions));
+                for (auto it = range.first; it != range.second; ++it) {
+                    auto* leftFace = it->second;
+                    if (leftFace->hasVertexPositions(positions)) {
+                        return leftFace;
+                    }
+                }
+                return nullptr;
+            }
+
             /**
              * Find all faces of the left polyhedron that have a maximal matching score with the given face of the right
              * polyhedron.
              *
+             * Only faces incident to a left vertex that is related to a vertex of the given face can have a non-zero score,
+             * so the scores are accumulated by visiting the faces incident to those vertices. If no face has a non-zero
+             * score, all faces of the left polyhedron are returned. The returned faces are ordered as in the left
+             * polyhedron.
+             *
              * @param rightFace the face of the right polyhedron
              * @return the matching faces of the left polyhedron
              */
             MatchingFaces findMatchingLeftFaces(Face* rightFace) const {
-                MatchingFaces result;
+                std::unordered_map<Face*, size_t> matchScores;
                 size_t bestMatchScore = 0;
 
-                auto* firstLeftFace = m_left.faces().front();
-                auto* currentLeftFace = firstLeftFace;
+                auto* firstRightEdge = rightFace->boundary().front();
+                auto* currentRightEdge = firstRightEdge;
                 do {
-                    const auto matchScore = computeMatchScore(currentLeftFace, rightFace);
-                    if (matchScore > bestMatchScore) {
-                        result.clear();
-                        result.push_back(currentLeftFace);
-                        bestMatchScore = matchScore;
-                    } else if (matchScore == bestMatchScore) {
+                    auto* rightVertex = currentRightEdge->origin();
+                    const auto leftVertices = m_vertexRelation.left_range(rightVertex);
+                    for (auto it = leftVertices.first; it != leftVertices.second; ++it) {
+                        auto* leftVertex = *it;
+
+                        // every leaving half edge belongs to a different incident face
+                        auto* firstLeftEdge = leftVertex->leaving();
+                        auto* currentLeftEdge = firstLeftEdge;
+                        do {
+                            const auto matchScore = ++matchScores[currentLeftEdge->face()];
+                            bestMatchScore = std::max(bestMatchScore, matchScore);
+                            currentLeftEdge = currentLeftEdge->nextIncident();
+                        } while (currentLeftEdge != firstLeftEdge);
+                    }
+                    currentRightEdge = currentRightEdge->next();
+                } while (currentRightEdge != firstRightEdge);
+
+                MatchingFaces result;
+                if (bestMatchScore == 0) {
+                    auto* firstLeftFace = m_left.faces().front();
+                    auto* currentLeftFace = firstLeftFace;
+                    do {
                         result.push_back(currentLeftFace);
+                        currentLeftFace = currentLeftFace->next();
+                    } while (currentLeftFace != firstLeftFace);
+                    return result;
+                }
+
+                for (const auto& entry : matchScores) {
+                    if (entry.second == bestMatchScore) {
+                        result.push_back(entry.first);
                     }
-                    currentLeftFace = currentLeftFace->next();
-                } while (currentLeftFace != firstLeftFace);
+                }
 
+                // keep the order of the left polyhedron so that ties are broken deterministically
+                std::sort(std::begin(result), std::end(result), [&](Face* lhs, Face* rhs) {
+                    return m_leftFaceIndex.at(lhs) < m_leftFaceIndex.at(rhs);
+                });
                 return result;
             }
         public:
@@ -204,25 +278,60 @@ namespace TrenchBroom {
             }
         private:
             /**
-             * Computes the matching score between the given left and right faces the data stored in the vertex relation.
-             *
-             * The matching score between the given faces is the number of all pairs of a vertex of the given left face
-             * and a vertex of the given right face which are also in the vertex relation, unless the faces are identical.
-             * In that case, this function returns a perfect match score.
+             * Computes an order independent hash of the given vertex positions.
              *
-             * @param leftFace a face of the left polyhedron
-             * @param rightFace a face of the right polyhedron
-             * @return the matching score
+             * @param positions the vertex positions
+             * @return the hash value
              */
-            size_t computeMatchScore(Face* leftFace, Face* rightFace) const {
-                if (leftFace->vertexCount() == rightFace->vertexCount() && leftFace->hasVertexPositions(rightFace->vertexPositions())) {
-                    return std::numeric_limits<size_t>::max();
-                }
+            static size_t hashPositions(const std::vector<V>& positions) {
+                using T = typename P::FloatType;
+                std::hash<T> hash;
 
                 size_t result = 0;
-                visitMatchingVertexPairs(leftFace, rightFace, [&result](Vertex* /* leftVertex */, Vertex* /* rightVertex */){
-                    ++result;
-                });
+                for (const auto& position : positions) {
+                    size_t positionHash = hash(position.x());
+                    positionHash = positionHash * 31u + hash(position.y());
+                    positionHash = positionHash * 31u + hash(position.z());
+                    result += positionHash;
+                }
+                return result;
+            }
+
+            /**
+             * Maps each face of the given polyhedron to its position in the face list.
+             *
+             * @param polyhedron the polyhedron
+             * @return the face index
+             */
+            static FaceIndex buildFaceIndex(const P& polyhedron) {
+                FaceIndex result;
+
+                auto* firstFace = polyhedron.faces().front();
+                auto* currentFace = firstFace;
+                do {
+                    result.emplace(currentFace, result.size());
+                    currentFace = currentFace->next();
+                } while (currentFace != firstFace);
+
+                return result;
+            }
+
+            /**
+             * Indexes the faces of the given polyhedron by a hash of their vertex positions.
+             *
+             * @param polyhedron the polyhedron
+             * @return the faces of the given polyhedron indexed by the hashes of their vertex positions
+             */
+            static FacesByPositions buildFacesByPositions(const P& polyhedron) {
+                FacesByPositions result;
+
+                auto* firstFace = polyhedron.faces().front();
+                auto* currentFace = firstFace;
+                do {
+                    result.emplace(hashPositions(currentFace->vertexPositions()), currentFace);
+                    currentFace = currentFace->next();
+                } while (currentFace != firstFace);
+
                 return result;
             }
         private:
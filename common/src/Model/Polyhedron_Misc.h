@@ -26,11 +26,15 @@
 #include <vecmath/ray.h>
 #include <vecmath/plane.h>
 #include <vecmath/bbox.h>
+#include <vecmath/mat.h>
 #include <vecmath/scalar.h>
 #include <vecmath/util.h>
 
-#include <unordered_map>
+#include <algorithm>
+#include <functional>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -107,6 +111,11 @@ namespace TrenchBroom {
             updateBounds();
         }
 
+        template <typename T, typename FP, typename VP>
+        size_t Polyhedron<T,FP,VP>::allocatedMemory() {
+            return Vertex::allocatedBytes() + Edge::allocatedBytes() + HalfEdge::allocatedBytes() + Face::allocatedBytes();
+        }
+
         template <typename T, typename FP, typename VP>
         Polyhedron<T,FP,VP>::Polyhedron(std::initializer_list<vm::vec<T,3>> positions) {
             addPoints(std::begin(positions), std::end(positions));
@@ -264,25 +273,58 @@ namespace TrenchBroom {
 
         /**
          * Copies a polyhedron.
+         *
+         * The copied vertices and half edges are found by looking up their originals in flat tables that are sized for
+         * the entire topology up front and sorted once. This avoids the per-element heap allocations and hashing of
+         * node based maps, which dominated the cost of copying the small polyhedra that make up brush geometry.
          */
         template <typename T, typename FP, typename VP>
         class Polyhedron<T,FP,VP>::Copy {
         private:
-            using VertexMap = std::unordered_map<const Vertex*, Vertex*>;
-            using VertexMapEntry = typename VertexMap::value_type;
+            /**
+             * Maps elements of the original to their copies. The entries must be sorted by calling sort() before any
+             * lookups are done.
+             */
+            template <typename E>
+            class CopyTable {
+            private:
+                using Entry = std::pair<const E*, E*>;
+                std::vector<Entry> m_entries;
+            public:
+                void reserve(const size_t size) {
+                    m_entries.reserve(size);
+                }
 
-            using HalfEdgeMap = std::unordered_map<const HalfEdge*, HalfEdge*>;
-            using HalfEdgeMapEntry = typename HalfEdgeMap::value_type;
+                void insert(const E* original, E* copy) {
+                    m_entries.emplace_back(original, copy);
+                }
+
+                void sort() {
+                    std::sort(std::begin(m_entries), std::end(m_entries), [](const Entry& lhs, const Entry& rhs) {
+                        return std::less<const E*>()(lhs.first, rhs.first);
+                    });
+                }
+
+                E* find(const E* original) const {
+                    const auto it = std::lower_bound(std::begin(m_entries), std::end(m_entries), original, [](const Entry& entry, const E* key) {
+                        return std::less<const E*>()(entry.first, key);
+                    });
+                    if (it == std::end(m_entries) || it->first != original) {
+                        return nullptr;
+                    }
+                    return it->second;
+                }
+            };
 
             /**
              * Maps the vertices of the original to their copies.
              */
-            VertexMap m_vertexMap;
+            CopyTable<Vertex> m_vertexTable;
 
             /**
              * Maps the half edges of the original to their copies.
              */
-            HalfEdgeMap m_halfEdgeMap;
+            CopyTable<HalfEdge> m_halfEdgeTable;
 
             /**
              * The copied vertices.
@@ -315,25 +357,28 @@ namespace TrenchBroom {
             Copy(const FaceList& originalFaces, const EdgeList& originalEdges, const VertexList& originalVertices, Polyhedron& destination) :
                 m_destination(destination) {
                 copyVertices(originalVertices);
-                copyFaces(originalFaces);
+                copyFaces(originalFaces, originalEdges.size());
                 copyEdges(originalEdges);
                 swapContents();
             }
         private:
             void copyVertices(const VertexList& originalVertices) {
+                m_vertexTable.reserve(originalVertices.size());
                 for (const Vertex* currentVertex : originalVertices) {
                     Vertex* copy = new Vertex(currentVertex->position());
-                    assert(m_vertexMap.count(currentVertex) == 0u);
-                    m_vertexMap.insert(std::make_pair(currentVertex, copy));
+                    m_vertexTable.insert(currentVertex, copy);
                     m_vertices.push_back(copy);
-                    currentVertex = currentVertex->next();
                 }
+                m_vertexTable.sort();
             }
 
-            void copyFaces(const FaceList& originalFaces) {
+            void copyFaces(const FaceList& originalFaces, const size_t edgeCount) {
+                // every edge has at most two half edges, each of which belongs to a face
+                m_halfEdgeTable.reserve(2u * edgeCount);
                 for (const Face* currentFace : originalFaces) {
                     copyFace(currentFace);
                 }
+                m_halfEdgeTable.sort();
             }
 
             void copyFace(const Face* originalFace) {
@@ -348,19 +393,15 @@ namespace TrenchBroom {
             }
 
             HalfEdge* copyHalfEdge(const HalfEdge* original) {
-                const Vertex* originalOrigin = original->origin();
-
-                Vertex* myOrigin = findVertex(originalOrigin);
-                HalfEdge* copy = new HalfEdge(myOrigin);
-                assert(m_halfEdgeMap.count(original) == 0u);
-                m_halfEdgeMap.insert(std::make_pair(original, copy));
+                HalfEdge* copy = new HalfEdge(findVertex(original->origin()));
+                m_halfEdgeTable.insert(original, copy);
                 return copy;
             }
 
-            Vertex* findVertex(const Vertex* original) {
-                typename VertexMap::iterator it = m_vertexMap.find(original);
-                assert(it != std::end(m_vertexMap));
-                return it->second;
+            Vertex* findVertex(const Vertex* original) const {
+                Vertex* copy = m_vertexTable.find(original);
+                assert(copy != nullptr);
+                return copy;
             }
 
             void copyEdges(const EdgeList& originalEdges) {
@@ -380,16 +421,12 @@ namespace TrenchBroom {
             }
 
             HalfEdge* findOrCopyHalfEdge(const HalfEdge* original) {
-                auto it = m_halfEdgeMap.find(original);
-                if (it == std::end(m_halfEdgeMap)) {
-                    const Vertex* originalOrigin = original->origin();
-                    Vertex* myOrigin = findVertex(originalOrigin);
-                    HalfEdge* copy = new HalfEdge(myOrigin);
-                    m_halfEdgeMap.insert(std::make_pair(original, copy));
-                    return copy;
-                } else {
-                    return it->second;
+                HalfEdge* copy = m_halfEdgeTable.find(original);
+                if (copy == nullptr) {
+                    // the half edge does not belong to any face, so it cannot be shared by another edge
+                    copy = new HalfEdge(findVertex(original->origin()));
                 }
+                return copy;
             }
 
             void swapContents() {
@@ -713,6 +750,14 @@ namespace TrenchBroom {
             updateBounds();
         }
 
+        template <typename T, typename FP, typename VP>
+        void Polyhedron<T,FP,VP>::transform(const vm::mat<T,4,4>& transformation) {
+            for (auto* vertex : m_vertices) {
+                vertex->setPosition(transformation * vertex->position());
+            }
+            updateBounds();
+        }
+
         template <typename T, typename FP, typename VP>
         bool Polyhedron<T,FP,VP>::healEdges(const T minLength) {
             Callback callback;
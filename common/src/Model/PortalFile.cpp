@@ -20,17 +20,22 @@
 #include "PortalFile.h"
 
 #include "Exceptions.h"
+#include "IO/File.h"
 #include "IO/Path.h"
 
 #include <kdl/string_format.h>
-#include <kdl/string_utils.h>
 
 #include <vecmath/forward.h>
 #include <vecmath/polygon.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <utility>
 
 namespace TrenchBroom {
     namespace Model {
@@ -50,63 +55,146 @@ namespace TrenchBroom {
             return m_portals;
         }
 
+        namespace {
+            /**
+             * Reads the lines and the numbers of a portal file directly from its contents, without copying every line
+             * and every number into a separate string.
+             */
+            class PortalFileReader {
+            private:
+                const char* m_cur;
+                const char* m_end;
+            public:
+                PortalFileReader(const char* begin, const char* end) :
+                m_cur(begin),
+                m_end(end) {}
+
+                bool eof() const {
+                    return m_cur == m_end;
+                }
+
+                /**
+                 * Returns the next line without its line terminator.
+                 */
+                std::pair<const char*, const char*> readLine() {
+                    const char* lineBegin = m_cur;
+                    while (m_cur != m_end && *m_cur != '\n') {
+                        ++m_cur;
+                    }
+                    const char* lineEnd = m_cur;
+                    if (m_cur != m_end) {
+                        ++m_cur;
+                    }
+                    while (lineEnd != lineBegin && *(lineEnd - 1) == '\r') {
+                        --lineEnd;
+                    }
+                    return { lineBegin, lineEnd };
+                }
+
+                std::string readLineString() {
+                    const auto [lineBegin, lineEnd] = readLine();
+                    return std::string(lineBegin, lineEnd);
+                }
+            };
+
+            bool isDelimiter(const char c) {
+                return c == '(' || c == ')' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+            }
+
+            /**
+             * Returns the next token of the given line, which is empty if there are no more tokens.
+             */
+            std::pair<const char*, const char*> nextToken(const char*& cur, const char* end) {
+                while (cur != end && isDelimiter(*cur)) {
+                    ++cur;
+                }
+                const char* tokenBegin = cur;
+                while (cur != end && !isDelimiter(*cur)) {
+                    ++cur;
+                }
+                return { tokenBegin, cur };
+            }
+
+            template <typename T, typename F>
+            T parseToken(const std::pair<const char*, const char*>& token, F convert) {
+                // the token is not null terminated, so it has to be copied to be converted
+                std::array<char, 64> buffer;
+                const auto length = static_cast<size_t>(token.second - token.first);
+                if (length == 0 || length >= buffer.size()) {
+                    throw FileFormatException("Error reading portal");
+                }
+                std::copy(token.first, token.second, std::begin(buffer));
+                buffer[length] = '\0';
+
+                char* parsedEnd = nullptr;
+                const auto result = convert(buffer.data(), &parsedEnd);
+                if (parsedEnd == buffer.data()) {
+                    throw FileFormatException("Error reading portal");
+                }
+                return static_cast<T>(result);
+            }
+        }
+
         void PortalFile::load(const IO::Path& path) {
-            std::fstream stream(path.asString(), std::ios::in);
-            if (!stream.good()) {
+            std::unique_ptr<IO::MappedFile> file;
+            try {
+                file = std::make_unique<IO::MappedFile>(path);
+            } catch (const FileSystemException&) {
                 throw FileFormatException("Couldn't open file");
             }
 
-            std::string line;
+            PortalFileReader reader(file->begin(), file->end());
             int numPortals;
 
             // read header
-            std::getline(stream, line);
-            const std::string formatCode = kdl::str_trim(line); // trim off any trailing \r
+            const std::string formatCode = kdl::str_trim(reader.readLineString()); // trim off any trailing whitespace
 
             if (formatCode == "PRT1") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
+                reader.readLine(); // number of leafs (ignored)
+                numPortals = std::stoi(reader.readLineString()); // number of portals
             } else if (formatCode == "PRT2") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
+                reader.readLine(); // number of leafs (ignored)
+                reader.readLine(); // number of clusters (ignored)
+                numPortals = std::stoi(reader.readLineString()); // number of portals
             } else if (formatCode == "PRT1-AM") {
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
-                std::getline(stream, line); // number of leafs (ignored)
+                reader.readLine(); // number of clusters (ignored)
+                numPortals = std::stoi(reader.readLineString()); // number of portals
+                reader.readLine(); // number of leafs (ignored)
             } else {
                 throw FileFormatException("Unknown portal format: " + formatCode);
             }
 
-            if (!stream.good()) {
+            if (reader.eof()) {
                 throw FileFormatException("Error reading header");
             }
 
+            const auto toInt = [](const char* str, char** strEnd) { return std::strtol(str, strEnd, 10); };
+            const auto toFloat = [](const char* str, char** strEnd) { return std::strtof(str, strEnd); };
+
             // read portals
+            m_portals.reserve(static_cast<size_t>(std::max(numPortals, 0)));
+            std::vector<vm::vec3f> verts;
             for (int i = 0; i < numPortals; ++i) {
-                std::getline(stream, line);
-                const auto components = kdl::str_split(line, "() \n\t\r");
-
-                if (!stream.good() || components.size() < 3) {
+                if (reader.eof()) {
                     throw FileFormatException("Error reading portal");
                 }
 
-                std::vector<vm::vec3f> verts;
-                size_t ptr = 3;
-                const int numPoints = std::stoi(components.at(0));
-                for (int j = 0; j < numPoints; ++j) {
-                    if (ptr + 2 >= components.size()) {
+                auto [cur, lineEnd] = reader.readLine();
+                const int numPoints = parseToken<int>(nextToken(cur, lineEnd), toInt);
+
+                // skip the leaf or cluster indices
+                for (size_t j = 0; j < 2; ++j) {
+                    if (const auto token = nextToken(cur, lineEnd); token.first == token.second) {
                         throw FileFormatException("Error reading portal");
                     }
+                }
 
-                    const vm::vec3f vert(std::stof(components.at(ptr)),
-                                     std::stof(components.at(ptr+1)),
-                                     std::stof(components.at(ptr+2)));
-                    verts.push_back(vert);
-                    ptr += 3;
+                verts.clear();
+                for (int j = 0; j < numPoints; ++j) {
+                    const auto x = parseToken<float>(nextToken(cur, lineEnd), toFloat);
+                    const auto y = parseToken<float>(nextToken(cur, lineEnd), toFloat);
+                    const auto z = parseToken<float>(nextToken(cur, lineEnd), toFloat);
+                    verts.emplace_back(x, y, z);
                 }
 
                 m_portals.push_back(vm::polygon3f(verts));
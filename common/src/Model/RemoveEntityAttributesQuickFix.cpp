@@ -23,22 +23,33 @@
 #include "Model/MapFacade.h"
 #include "Model/PushSelection.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         RemoveEntityAttributesQuickFix::RemoveEntityAttributesQuickFix(const IssueType issueType) :
         IssueQuickFix(issueType, "Delete properties") {}
 
-        void RemoveEntityAttributesQuickFix::doApply(MapFacade* facade, const Issue* issue) const {
+        void RemoveEntityAttributesQuickFix::doApply(MapFacade* facade, const std::vector<Issue*>& issues) const {
             const PushSelection push(facade);
 
-            const AttributeIssue* attrIssue = static_cast<const AttributeIssue*>(issue);
-
-            // If world node is affected, the selection will fail, but if nothing is selected,
-            // the removeAttribute call will correctly affect worldspawn either way.
-
-            facade->deselectAll();
-            facade->select(issue->node());
-            facade->removeAttribute(attrIssue->attributeName());
+            // remove each attribute from all affected nodes at once instead of selecting every node on its own
+            std::map<std::string, std::vector<Node*>> nodesByAttributeName;
+            for (const Issue* issue : issues) {
+                if (issue->type() == issueType()) {
+                    const auto* attrIssue = static_cast<const AttributeIssue*>(issue);
+                    nodesByAttributeName[attrIssue->attributeName()].push_back(issue->node());
+                }
+            }
+
+            for (const auto& entry : nodesByAttributeName) {
+                const auto& name = entry.first;
+                applyToNodes(facade, entry.second, [&]() {
+                    facade->removeAttribute(name);
+                });
+            }
         }
     }
 }
@@ -28,7 +28,7 @@ namespace TrenchBroom {
         public:
             explicit RemoveEntityAttributesQuickFix(IssueType issueType);
         private:
-            void doApply(MapFacade* facade, const Issue* issue) const override;
+            void doApply(MapFacade* facade, const std::vector<Issue*>& issues) const override;
         };
     }
 }
@@ -43,16 +43,24 @@ namespace TrenchBroom {
                 snapshot->restore();
         }
 
+        size_t Snapshot::memoryUsage() const {
+            return m_memoryUsage;
+        }
+
         void Snapshot::takeSnapshot(Node* node) {
             NodeSnapshot* snapshot = node->takeSnapshot();
-            if (snapshot != nullptr)
+            if (snapshot != nullptr) {
                 m_nodeSnapshots.push_back(snapshot);
+                m_memoryUsage += sizeof(NodeSnapshot*) + snapshot->memoryUsage();
+            }
         }
 
         void Snapshot::takeSnapshot(BrushFace* face) {
             BrushFaceSnapshot* snapshot = face->takeSnapshot();
-            if (snapshot != nullptr)
+            if (snapshot != nullptr) {
                 m_brushFaceSnapshots.push_back(snapshot);
+                m_memoryUsage += sizeof(BrushFaceSnapshot*) + snapshot->memoryUsage();
+            }
         }
     }
 }
@@ -22,6 +22,7 @@
 
 #include "FloatType.h"
 
+#include <cstddef>
 #include <vector>
 
 namespace TrenchBroom {
@@ -35,9 +36,11 @@ namespace TrenchBroom {
         private:
             std::vector<NodeSnapshot*> m_nodeSnapshots;
             std::vector<BrushFaceSnapshot*> m_brushFaceSnapshots;
+            size_t m_memoryUsage;
         public:
             template <typename I>
-            Snapshot(I cur, I end) {
+            Snapshot(I cur, I end) :
+            m_memoryUsage(sizeof(Snapshot)) {
                 while (cur != end) {
                     takeSnapshot(*cur);
                     ++cur;
@@ -48,6 +51,12 @@ namespace TrenchBroom {
 
             void restoreNodes(const vm::bbox3& worldBounds);
             void restoreBrushFaces();
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot. The estimate is computed when the
+             * snapshot is taken.
+             */
+            size_t memoryUsage() const;
         private:
             void takeSnapshot(Node* node);
             void takeSnapshot(BrushFace* face);
@@ -36,6 +36,8 @@
 #include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -119,6 +121,25 @@ namespace TrenchBroom {
         }
 
         bool TextureNameTagMatcher::matchesTextureName(std::string_view textureName) const {
+            {
+                std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+                const auto it = m_cache.find(textureName);
+                if (it != std::end(m_cache)) {
+                    return it->second;
+                }
+            }
+
+            const auto result = matchesTextureNameUncached(textureName);
+
+            std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+            if (m_cache.find(textureName) == std::end(m_cache)) {
+                const auto& cachedName = m_cachedNames.emplace_back(textureName);
+                m_cache.emplace(cachedName, result);
+            }
+            return result;
+        }
+
+        bool TextureNameTagMatcher::matchesTextureNameUncached(std::string_view textureName) const {
             const auto pos = textureName.find_last_of('/');
             if (pos != std::string::npos) {
                 textureName = textureName.substr(pos + 1);
@@ -128,7 +149,8 @@ namespace TrenchBroom {
         }
 
         SurfaceParmTagMatcher::SurfaceParmTagMatcher(const std::string& parameter) :
-        m_parameter(parameter) {}
+        m_parameter(parameter),
+        m_parameterBit(Assets::Texture::surfaceParmBit(m_parameter)) {}
 
         std::unique_ptr<TagMatcher> SurfaceParmTagMatcher::clone() const {
             return std::make_unique<SurfaceParmTagMatcher>(m_parameter);
@@ -137,13 +159,13 @@ namespace TrenchBroom {
         bool SurfaceParmTagMatcher::matches(const Taggable& taggable) const {
             BrushFaceMatchVisitor visitor([this](const BrushFace& face) {
                 const auto* texture = face.texture();
-                if (texture != nullptr) {
-                    const auto& surfaceParms = texture->surfaceParms();
-                    if (surfaceParms.count(m_parameter) > 0) {
-                        return true;
-                    }
+                if (texture == nullptr) {
+                    return false;
+                } else if (m_parameterBit != 0) {
+                    return (texture->surfaceParmMask() & m_parameterBit) != 0;
+                } else {
+                    return texture->surfaceParms().count(m_parameter) > 0;
                 }
-                return false;
             });
 
             taggable.accept(visitor);
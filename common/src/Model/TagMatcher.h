@@ -23,10 +23,14 @@
 #include "Model/Tag.h"
 #include "Model/TagVisitor.h"
 
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -71,6 +75,18 @@ namespace TrenchBroom {
         class TextureNameTagMatcher : public TagMatcher {
         private:
             std::string m_pattern;
+
+            /**
+             * Caches whether the pattern matches a texture name. A map usually uses few distinct textures on many
+             * faces, so the glob pattern only needs to be evaluated once per texture name. Faces may be tagged
+             * concurrently, hence the mutex.
+             *
+             * The cache is keyed by views of the names in m_cachedNames so that looking up a name does not need to copy
+             * it. A deque never moves its elements when growing, so the views stay valid.
+             */
+            mutable std::shared_mutex m_cacheMutex;
+            mutable std::deque<std::string> m_cachedNames;
+            mutable std::unordered_map<std::string_view, bool> m_cache;
         public:
             explicit TextureNameTagMatcher(const std::string& pattern);
             std::unique_ptr<TagMatcher> clone() const override;
@@ -80,11 +96,14 @@ namespace TrenchBroom {
             bool canEnable() const override;
         private:
             bool matchesTextureName(std::string_view textureName) const;
+            bool matchesTextureNameUncached(std::string_view textureName) const;
         };
 
         class SurfaceParmTagMatcher : public TagMatcher {
         private:
             std::string m_parameter;
+            // the bit of the parameter in the surface parameter masks of textures, or 0 if it has no bit
+            uint64_t m_parameterBit;
         public:
             explicit SurfaceParmTagMatcher(const std::string& parameter);
             std::unique_ptr<TagMatcher> clone() const override;
@@ -76,6 +76,20 @@ namespace TrenchBroom {
             return doGetTexCoords(point, attribs);
         }
 
+        void TexCoordSystem::getTexCoords(const std::vector<vm::vec3>& points, const BrushFaceAttributes& attribs, std::vector<vm::vec2f>& result) const {
+            // this must compute the same values as doGetTexCoords in the subclasses, see computeTexCoords
+            const vm::vec3 xAxis = safeScaleAxis(getXAxis(), attribs.scale().x());
+            const vm::vec3 yAxis = safeScaleAxis(getYAxis(), attribs.scale().y());
+            const vm::vec2f offset = attribs.offset();
+            const vm::vec2f textureSize = attribs.textureSize();
+
+            result.resize(points.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                const vm::vec2f texCoords(dot(points[i], xAxis), dot(points[i], yAxis));
+                result[i] = (texCoords + offset) / textureSize;
+            }
+        }
+
         void TexCoordSystem::setRotation(const vm::vec3& normal, const float oldAngle, const float newAngle) {
             doSetRotation(normal, oldAngle, newAngle);
         }
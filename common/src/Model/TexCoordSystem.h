@@ -26,6 +26,7 @@
 #include <vecmath/vec.h>
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -71,6 +72,13 @@ namespace TrenchBroom {
 
             vm::vec2f getTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs) const;
 
+            /**
+             * Computes the texture coordinates of all given points and stores them in the given vector, replacing
+             * its contents. The scaled texture axes and the offset are computed once for all points, which makes this
+             * considerably cheaper than computing the texture coordinates of every point individually.
+             */
+            void getTexCoords(const std::vector<vm::vec3>& points, const BrushFaceAttributes& attribs, std::vector<vm::vec2f>& result) const;
+
             void setRotation(const vm::vec3& normal, float oldAngle, float newAngle);
             void transform(const vm::plane3& oldBoundary, const vm::plane3& newBoundary, const vm::mat4x4& transformation, BrushFaceAttributes& attribs, bool lockTexture, const vm::vec3& invariant);
             void updateNormal(const vm::vec3& oldNormal, const vm::vec3& newNormal, const BrushFaceAttributes& attribs, const WrapStyle style);
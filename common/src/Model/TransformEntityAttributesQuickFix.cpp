@@ -23,7 +23,10 @@
 #include "Model/MapFacade.h"
 #include "Model/PushSelection.h"
 
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -32,28 +35,34 @@ namespace TrenchBroom {
         m_nameTransform(nameTransform),
         m_valueTransform(valueTransform) {}
 
-        void TransformEntityAttributesQuickFix::doApply(MapFacade* facade, const Issue* issue) const {
+        void TransformEntityAttributesQuickFix::doApply(MapFacade* facade, const std::vector<Issue*>& issues) const {
             const PushSelection push(facade);
 
-            const auto* attrIssue = static_cast<const AttributeIssue*>(issue);
-            const auto& oldName = attrIssue->attributeName();
-            const auto& oldValue = attrIssue->attributeValue();
-            const auto newName = m_nameTransform(oldName);
-            const auto newValue = m_valueTransform(oldValue);
-
-            // If world node is affected, the selection will fail, but if nothing is selected,
-            // the removeAttribute call will correctly affect worldspawn either way.
-
-            facade->deselectAll();
-            facade->select(issue->node());
-
-            if (newName.empty()) {
-                facade->removeAttribute(attrIssue->attributeName());
-            } else {
-                if (newName != oldName)
-                    facade->renameAttribute(oldName, newName);
-                if (newValue != oldValue)
-                    facade->setAttribute(newName, newValue);
+            // transform each distinct attribute on all affected nodes at once instead of selecting every node on its own
+            std::map<std::pair<std::string, std::string>, std::vector<Node*>> nodesByAttribute;
+            for (const Issue* issue : issues) {
+                if (issue->type() == issueType()) {
+                    const auto* attrIssue = static_cast<const AttributeIssue*>(issue);
+                    nodesByAttribute[{ attrIssue->attributeName(), attrIssue->attributeValue() }].push_back(issue->node());
+                }
+            }
+
+            for (const auto& entry : nodesByAttribute) {
+                const auto& oldName = entry.first.first;
+                const auto& oldValue = entry.first.second;
+                const auto newName = m_nameTransform(oldName);
+                const auto newValue = m_valueTransform(oldValue);
+
+                applyToNodes(facade, entry.second, [&]() {
+                    if (newName.empty()) {
+                        facade->removeAttribute(oldName);
+                    } else {
+                        if (newName != oldName)
+                            facade->renameAttribute(oldName, newName);
+                        if (newValue != oldValue)
+                            facade->setAttribute(newName, newValue);
+                    }
+                });
             }
         }
     }
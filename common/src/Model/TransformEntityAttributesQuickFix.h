@@ -37,7 +37,7 @@ namespace TrenchBroom {
         public:
             TransformEntityAttributesQuickFix(const IssueType issueType, const std::string& description, const NameTransform& nameTransform, const ValueTransform& valueTransform);
         private:
-            void doApply(MapFacade* facade, const Issue* issue) const override;
+            void doApply(MapFacade* facade, const std::vector<Issue*>& issues) const override;
         };
     }
 }
@@ -21,20 +21,31 @@
 
 #include "AABBTree.h"
 #include "Ensure.h"
+#include "Profiler.h"
 #include "Model/AssortNodesVisitor.h"
 #include "Model/AttributableNodeIndex.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/CollectNodesWithDescendantSelectionCountVisitor.h"
+#include "Model/Entity.h"
+#include "Model/FindLayerVisitor.h"
+#include "Model/Hit.h"
+#include "Model/HitFilter.h"
 #include "Model/IssueGenerator.h"
 #include "Model/IssueGeneratorRegistry.h"
+#include "Model/Layer.h"
 #include "Model/ModelFactoryImpl.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox_io.h>
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -45,9 +56,11 @@ namespace TrenchBroom {
         m_factory(std::make_unique<ModelFactoryImpl>(mapFormat)),
         m_defaultLayer(nullptr),
         m_attributableIndex(std::make_unique<AttributableNodeIndex>()),
+        m_deferAttributeIndexUpdatesCount(0u),
         m_issueGeneratorRegistry(std::make_unique<IssueGeneratorRegistry>()),
-        m_nodeTree(std::make_unique<NodeTree>()),
-        m_updateNodeTree(true) {
+        m_updateNodeTree(true),
+        m_deferNodeTreeUpdatesCount(0u),
+        m_invalidateNeighbourIssues(false) {
             addOrUpdateAttribute(AttributeNames::Classname, AttributeValues::WorldspawnClassname);
             createDefaultLayer();
         }
@@ -78,9 +91,28 @@ namespace TrenchBroom {
         }
 
         const AttributableNodeIndex& World::attributableNodeIndex() const {
+            flushDeferredAttributeIndexUpdates();
             return *m_attributableIndex;
         }
 
+        void World::deferAttributeIndexUpdates() {
+            ++m_deferAttributeIndexUpdatesCount;
+        }
+
+        void World::resumeAttributeIndexUpdates() {
+            assert(m_deferAttributeIndexUpdatesCount > 0u);
+            if (m_deferAttributeIndexUpdatesCount > 0u && --m_deferAttributeIndexUpdatesCount == 0u) {
+                flushDeferredAttributeIndexUpdates();
+            }
+        }
+
+        void World::flushDeferredAttributeIndexUpdates() const {
+            if (!m_deferredAttributeIndexAdditions.empty()) {
+                m_attributableIndex->addAttributes(std::move(m_deferredAttributeIndexAdditions));
+                m_deferredAttributeIndexAdditions.clear();
+            }
+        }
+
         const std::vector<IssueGenerator*>& World::registeredIssueGenerators() const {
             return m_issueGeneratorRegistry->registeredGenerators();
         }
@@ -91,43 +123,96 @@ namespace TrenchBroom {
 
         void World::registerIssueGenerator(IssueGenerator* issueGenerator) {
             m_issueGeneratorRegistry->registerGenerator(issueGenerator);
+            issueGenerator->setWorld(this);
+            m_invalidateNeighbourIssues |= issueGenerator->inspectsNeighbours();
             invalidateAllIssues();
         }
 
         void World::unregisterAllIssueGenerators() {
             m_issueGeneratorRegistry->unregisterAllGenerators();
+            m_invalidateNeighbourIssues = false;
             invalidateAllIssues();
         }
 
+        void World::validateBrushIssues() {
+            TB_PROFILE_ZONE("World::validateBrushIssues");
+
+            // generators may query the node tree concurrently, so it must not be modified while they run
+            flushDeferredNodeTreeUpdates();
+
+            CollectBrushesVisitor visitor;
+            acceptAndRecurse(visitor);
+
+            const auto& issueGenerators = registeredIssueGenerators();
+            const auto& brushes = visitor.brushes();
+            kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                brushes[i]->validateIssues(issueGenerators);
+            });
+        }
+
+        class World::FindVisibleNode : public ConstNodeVisitor, public NodeQuery<bool> {
+        public:
+            FindVisibleNode() :
+            NodeQuery(false) {}
+        private:
+            void doVisit(const World* world) override   { check(world);  }
+            void doVisit(const Layer* layer) override   { check(layer);  }
+            void doVisit(const Group* group) override   { check(group);  }
+            void doVisit(const Entity* entity) override { check(entity); }
+            void doVisit(const Brush* brush) override   { check(brush);  }
+
+            void check(const Node* node) {
+                if (node->visible()) {
+                    setResult(true);
+                    cancel();
+                }
+            }
+        };
+
+        bool World::isLayerHidden(const Layer* layer) const {
+            auto it = m_hiddenLayers.find(layer);
+            if (it == std::end(m_hiddenLayers)) {
+                FindVisibleNode visitor;
+                layer->acceptAndRecurse(visitor);
+                it = m_hiddenLayers.emplace(layer, !visitor.hasResult()).first;
+            }
+            return it->second;
+        }
+
+        void World::invalidateHiddenLayer(const Node* node) {
+            m_hiddenLayers.erase(findLayer(const_cast<Node*>(node)));
+        }
+
         class World::AddNodeToNodeTree : public NodeVisitor {
         private:
-            NodeTree& m_nodeTree;
+            World& m_world;
         public:
-            explicit AddNodeToNodeTree(NodeTree& nodeTree) :
-            m_nodeTree(nodeTree) {}
+            explicit AddNodeToNodeTree(World& world) :
+            m_world(world) {}
         private:
             void doVisit(World*) override         {}
             void doVisit(Layer*) override         {}
             void doVisit(Group*) override         {}
-            void doVisit(Entity* entity) override { m_nodeTree.insert(entity->physicalBounds(), entity); }
-            void doVisit(Brush* brush) override   { m_nodeTree.insert(brush->physicalBounds(), brush); }
+            void doVisit(Entity* entity) override { m_world.nodeTree(entity->layer()).insert(entity->physicalBounds(), entity); }
+            void doVisit(Brush* brush) override   { m_world.nodeTree(brush->layer()).insert(brush->physicalBounds(), brush); }
         };
 
         class World::RemoveNodeFromNodeTree : public NodeVisitor {
         private:
-            NodeTree& m_nodeTree;
+            World& m_world;
         public:
-            explicit RemoveNodeFromNodeTree(NodeTree& nodeTree) :
-            m_nodeTree(nodeTree) {}
+            explicit RemoveNodeFromNodeTree(World& world) :
+            m_world(world) {}
         private:
             void doVisit(World*) override         {}
             void doVisit(Layer*) override         {}
             void doVisit(Group*) override         {}
-            void doVisit(Entity* entity) override { doRemove(entity, entity->physicalBounds()); }
-            void doVisit(Brush* brush) override   { doRemove(brush, brush->physicalBounds()); }
+            void doVisit(Entity* entity) override { doRemove(entity, entity->layer(), entity->physicalBounds()); }
+            void doVisit(Brush* brush) override   { doRemove(brush, brush->layer(), brush->physicalBounds()); }
 
-            void doRemove(Node* node, const vm::bbox3& bounds) {
-                if (!m_nodeTree.remove(node)) {
+            void doRemove(Node* node, const Layer* layer, const vm::bbox3& bounds) {
+                m_world.m_deferredNodeTreeUpdates.erase(node);
+                if (!m_world.nodeTree(layer).remove(node)) {
                     auto str = std::stringstream();
                     str << "Node not found with bounds " << bounds << ": " << node;
                     throw NodeTreeException(str.str());
@@ -137,18 +222,55 @@ namespace TrenchBroom {
 
         class World::UpdateNodeInNodeTree : public NodeVisitor {
         private:
-            NodeTree& m_nodeTree;
+            World& m_world;
         public:
-            explicit UpdateNodeInNodeTree(NodeTree& nodeTree) :
-            m_nodeTree(nodeTree) {}
+            explicit UpdateNodeInNodeTree(World& world) :
+            m_world(world) {}
         private:
             void doVisit(World*) override         {}
             void doVisit(Layer*) override         {}
             void doVisit(Group*) override         {}
-            void doVisit(Entity* entity) override { m_nodeTree.update(entity->physicalBounds(), entity); }
-            void doVisit(Brush* brush) override   { m_nodeTree.update(brush->physicalBounds(), brush); }
+            void doVisit(Entity* entity) override { m_world.nodeTree(entity->layer()).update(entity->physicalBounds(), entity); }
+            void doVisit(Brush* brush) override   { m_world.nodeTree(brush->layer()).update(brush->physicalBounds(), brush); }
         };
 
+        World::NodeTree& World::nodeTree(const Layer* layer) {
+            auto& nodeTree = m_nodeTrees[layer];
+            if (nodeTree == nullptr) {
+                nodeTree = std::make_unique<NodeTree>();
+            }
+            return *nodeTree;
+        }
+
+        void World::removeEmptyNodeTrees() {
+            for (auto it = std::begin(m_nodeTrees); it != std::end(m_nodeTrees);) {
+                if (it->second->empty()) {
+                    it = m_nodeTrees.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        size_t World::nodeTreeSize() const {
+            size_t result = 0u;
+            for (const auto& entry : m_nodeTrees) {
+                result += entry.second->size();
+            }
+            return result;
+        }
+
+        std::vector<const World::NodeTree*> World::nodeTrees() const {
+            std::vector<const NodeTree*> result;
+            for (const auto* layer : allLayers()) {
+                const auto it = m_nodeTrees.find(layer);
+                if (it != std::end(m_nodeTrees)) {
+                    result.push_back(it->second.get());
+                }
+            }
+            return result;
+        }
+
         class World::MatchTreeNodes {
         public:
             bool operator()(const Model::Node* node) const   { return node->shouldAddToSpacialIndex(); }
@@ -165,10 +287,86 @@ namespace TrenchBroom {
         void World::rebuildNodeTree() {
             using CollectTreeNodes = CollectMatchingNodesVisitor<MatchTreeNodes>;
 
-            CollectTreeNodes collect;
-            acceptAndRecurse(collect);
+            m_nodeTrees.clear();
+            for (auto* layer : allLayers()) {
+                CollectTreeNodes collect;
+                layer->recurse(collect);
+
+                if (!collect.nodes().empty()) {
+                    nodeTree(layer).clearAndBuild(collect.nodes(), [](const auto* node){ return node->physicalBounds(); });
+                }
+            }
+            m_deferredNodeTreeUpdates.clear();
+        }
+
+        void World::deferNodeTreeUpdates() {
+            ++m_deferNodeTreeUpdatesCount;
+        }
 
-            m_nodeTree->clearAndBuild(collect.nodes(), [](const auto* node){ return node->physicalBounds(); });
+        void World::resumeNodeTreeUpdates() {
+            assert(m_deferNodeTreeUpdatesCount > 0u);
+            if (m_deferNodeTreeUpdatesCount > 0u && --m_deferNodeTreeUpdatesCount == 0u) {
+                flushDeferredNodeTreeUpdates();
+            }
+        }
+
+        void World::flushDeferredNodeTreeUpdates() {
+            if (m_deferredNodeTreeUpdates.empty()) {
+                return;
+            }
+
+            for (auto* node : m_deferredNodeTreeUpdates) {
+                invalidateNeighbourIssues(node);
+            }
+
+            if (4u * m_deferredNodeTreeUpdates.size() >= nodeTreeSize()) {
+                rebuildNodeTree();
+            } else {
+                UpdateNodeInNodeTree visitor(*this);
+                for (auto* node : m_deferredNodeTreeUpdates) {
+                    node->accept(visitor);
+                }
+                m_deferredNodeTreeUpdates.clear();
+            }
+        }
+
+        std::vector<Node*> World::findNodesIntersecting(const vm::bbox3& bounds) {
+            flushDeferredNodeTreeUpdates();
+
+            std::vector<Node*> result;
+            for (const auto* nodeTree : nodeTrees()) {
+                nodeTree->findIntersectors(bounds, std::back_inserter(result));
+            }
+            return result;
+        }
+
+        void World::pickClosest(const vm::ray3& ray, const HitFilter& filter, PickResult& pickResult) {
+            flushDeferredNodeTreeUpdates();
+
+            // a node's hits always lie within its bounds, so no node whose bounds the ray enters beyond the closest
+            // matching hit can yield a closer one
+            PickResult nodeHits;
+            Hit closest = Hit::NoHit;
+            for (const auto& entry : m_nodeTrees) {
+                if (isLayerHidden(entry.first)) {
+                    continue;
+                }
+
+                entry.second->visitIntersectorsByDistance(ray, [&](Node* node, const FloatType /* distance */) {
+                    nodeHits.clear();
+                    node->pick(ray, nodeHits);
+                    for (const auto& hit : nodeHits.all()) {
+                        if (filter.matches(hit) && (!closest.isMatch() || hit.distance() < closest.distance())) {
+                            closest = hit;
+                        }
+                    }
+                    return closest.isMatch() ? closest.distance() : std::numeric_limits<FloatType>::max();
+                });
+            }
+
+            if (closest.isMatch()) {
+                pickResult.addHit(closest);
+            }
         }
 
         class World::InvalidateAllIssuesVisitor : public NodeVisitor {
@@ -187,6 +385,29 @@ namespace TrenchBroom {
             acceptAndRecurse(visitor);
         }
 
+        void World::invalidateNeighbourIssues(const vm::bbox3& bounds) {
+            if (m_invalidateNeighbourIssues) {
+                for (const auto& entry : m_nodeTrees) {
+                    for (auto* node : entry.second->findIntersectors(bounds)) {
+                        node->invalidateIssues();
+                    }
+                }
+            }
+        }
+
+        void World::invalidateNeighbourIssues(Node* node) {
+            // the node tree still has the node's previous bounds if they changed since it was last updated
+            if (m_invalidateNeighbourIssues) {
+                const auto it = m_nodeTrees.find(findLayer(node));
+                if (it != std::end(m_nodeTrees)) {
+                    if (const auto oldBounds = it->second->findBounds(node)) {
+                        invalidateNeighbourIssues(*oldBounds);
+                    }
+                }
+                invalidateNeighbourIssues(node->physicalBounds());
+            }
+        }
+
         const vm::bbox3& World::doGetLogicalBounds() const {
             // TODO: this should probably return the world bounds, as it does in Layer::doGetLogicalBounds
             static const vm::bbox3 bounds;
@@ -269,39 +490,61 @@ namespace TrenchBroom {
             // NOTE: `node` is just the root of a subtree that is being connected to this World.
             // In some cases, (e.g. if `node` is a Group), `node` will not be added to the spatial index, but some of its descendants may be.
             // We need to recursively search the `node` being connected and add it or any descendants that need to be added.
+            invalidateHiddenLayer(node);
             if (m_updateNodeTree) {
-                AddNodeToNodeTree visitor(*m_nodeTree);
+                AddNodeToNodeTree visitor(*this);
                 node->acceptAndRecurse(visitor);
+                invalidateNeighbourIssues(node->physicalBounds());
             }
         }
 
         void World::doDescendantWillBeRemoved(Node* node, const size_t /* depth */) {
+            invalidateHiddenLayer(node);
             if (m_updateNodeTree) {
-                RemoveNodeFromNodeTree visitor(*m_nodeTree);
+                invalidateNeighbourIssues(node->physicalBounds());
+                RemoveNodeFromNodeTree visitor(*this);
                 node->acceptAndRecurse(visitor);
+                removeEmptyNodeTrees();
             }
         }
 
         void World::doDescendantPhysicalBoundsDidChange(Node* node) {
             if (m_updateNodeTree) {
-                UpdateNodeInNodeTree visitor(*m_nodeTree);
-                node->accept(visitor);
+                if (m_deferNodeTreeUpdatesCount > 0u) {
+                    m_deferredNodeTreeUpdates.insert(node);
+                } else {
+                    invalidateNeighbourIssues(node);
+                    UpdateNodeInNodeTree visitor(*this);
+                    node->accept(visitor);
+                }
             }
         }
 
+        void World::doDescendantVisibilityStateDidChange(Node* node) {
+            invalidateHiddenLayer(node);
+        }
+
         bool World::doSelectable() const {
             return false;
         }
 
         void World::doPick(const vm::ray3& ray, PickResult& pickResult) {
-            for (auto* node : m_nodeTree->findIntersectors(ray)) {
-                node->pick(ray, pickResult);
+            flushDeferredNodeTreeUpdates();
+            for (const auto& entry : m_nodeTrees) {
+                if (!isLayerHidden(entry.first)) {
+                    for (auto* node : entry.second->findIntersectors(ray)) {
+                        node->pick(ray, pickResult);
+                    }
+                }
             }
         }
 
         void World::doFindNodesContaining(const vm::vec3& point, std::vector<Node*>& result) {
-            for (auto* node : m_nodeTree->findContainers(point)) {
-                node->findNodesContaining(point, result);
+            flushDeferredNodeTreeUpdates();
+            for (const auto* nodeTree : nodeTrees()) {
+                for (auto* node : nodeTree->findContainers(point)) {
+                    node->findNodesContaining(point, result);
+                }
             }
         }
 
@@ -318,21 +561,37 @@ namespace TrenchBroom {
         }
 
         void World::doFindAttributableNodesWithAttribute(const std::string& name, const std::string& value, std::vector<Model::AttributableNode*>& result) const {
+            flushDeferredAttributeIndexUpdates();
             kdl::vec_append(result,
                 m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::exact(name), value));
         }
 
         void World::doFindAttributableNodesWithNumberedAttribute(const std::string& prefix, const std::string& value, std::vector<Model::AttributableNode*>& result) const {
+            flushDeferredAttributeIndexUpdates();
             kdl::vec_append(result,
                 m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::numbered(prefix), value));
         }
 
         void World::doAddToIndex(AttributableNode* attributable, const std::string& name, const std::string& value) {
-            m_attributableIndex->addAttribute(attributable, name, value);
+            if (m_deferAttributeIndexUpdatesCount > 0u) {
+                m_deferredAttributeIndexAdditions.push_back({attributable, name, value});
+            } else {
+                m_attributableIndex->addAttribute(attributable, name, value);
+            }
         }
 
         void World::doRemoveFromIndex(AttributableNode* attributable, const std::string& name, const std::string& value) {
-            m_attributableIndex->removeAttribute(attributable, name, value);
+            if (!m_attributableIndex->removeAttribute(attributable, name, value)) {
+                // the attribute is not in the index yet, so it must have been added while updates were deferred; it
+                // was most likely added recently, so the collected attributes are searched from the back
+                auto& additions = m_deferredAttributeIndexAdditions;
+                const auto it = std::find_if(std::rbegin(additions), std::rend(additions), [&](const auto& entry) {
+                    return entry.attributable == attributable && entry.name == name && entry.value == value;
+                });
+                if (it != std::rend(additions)) {
+                    additions.erase(std::next(it).base());
+                }
+            }
         }
 
         void World::doAttributesDidChange(const vm::bbox3& /* oldBounds */) {}
@@ -23,19 +23,22 @@
 #include "FloatType.h"
 #include "Macros.h"
 #include "Model/AttributableNode.h"
+#include "Model/AttributableNodeIndex.h"
 #include "Model/MapFormat.h"
 #include "Model/ModelFactory.h"
 #include "Model/Node.h"
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     template <typename T, size_t S, typename U> class AABBTree;
 
     namespace Model {
-        class AttributableNodeIndex;
+        class HitFilter;
         class IssueGeneratorRegistry;
         class IssueQuickFix;
         class PickResult;
@@ -45,11 +48,29 @@ namespace TrenchBroom {
             std::unique_ptr<ModelFactory> m_factory;
             Layer* m_defaultLayer;
             std::unique_ptr<AttributableNodeIndex> m_attributableIndex;
+            size_t m_deferAttributeIndexUpdatesCount;
+            /**
+             * The attributes which were added while attribute index updates were deferred. This is mutable because
+             * queries must add these attributes to the index before they look anything up.
+             */
+            mutable std::vector<AttributableNodeIndex::Entry> m_deferredAttributeIndexAdditions;
             std::unique_ptr<IssueGeneratorRegistry> m_issueGeneratorRegistry;
 
             using NodeTree = AABBTree<FloatType, 3, Node*>;
-            std::unique_ptr<NodeTree> m_nodeTree;
+            /**
+             * Every layer has its own node tree so that queries can skip entire layers. The trees are created when
+             * the first node of a layer is added and removed when they become empty.
+             */
+            std::unordered_map<const Layer*, std::unique_ptr<NodeTree>> m_nodeTrees;
+            /**
+             * Caches whether a layer and all of its descendants are hidden, see isLayerHidden().
+             */
+            mutable std::unordered_map<const Layer*, bool> m_hiddenLayers;
             bool m_updateNodeTree;
+            size_t m_deferNodeTreeUpdatesCount;
+            std::unordered_set<Node*> m_deferredNodeTreeUpdates;
+
+            bool m_invalidateNeighbourIssues;
         public:
             World(MapFormat mapFormat);
             ~World() override;
@@ -61,24 +82,115 @@ namespace TrenchBroom {
             void createDefaultLayer();
         public: // index
             const AttributableNodeIndex& attributableNodeIndex() const;
+
+            /**
+             * Starts collecting the attributes which are added to the attribute index instead of adding them
+             * immediately, so that they can be added in bulk. Calls to this function can be nested, and each call must
+             * be matched by a call to resumeAttributeIndexUpdates().
+             *
+             * Queries of the attribute index remain correct while updates are deferred, but every query adds the
+             * collected attributes to the index first.
+             */
+            void deferAttributeIndexUpdates();
+
+            /**
+             * Ends one level of deferral. When the outermost level ends, the collected attributes are added to the
+             * attribute index.
+             */
+            void resumeAttributeIndexUpdates();
+        private:
+            void flushDeferredAttributeIndexUpdates() const;
         public: // selection
             // issue generator registration
             const std::vector<IssueGenerator*>& registeredIssueGenerators() const;
             std::vector<IssueQuickFix*> quickFixes(IssueType issueTypes) const;
             void registerIssueGenerator(IssueGenerator* issueGenerator);
             void unregisterAllIssueGenerators();
+
+            /**
+             * Generates the issues of all brushes whose issues are out of date, distributing the brushes over
+             * several threads. Brush issue generators only inspect the brush they are given, so brushes can be
+             * validated independently of each other. All other nodes are validated lazily when their issues are
+             * requested.
+             */
+            void validateBrushIssues();
+        public: // layer visibility
+            /**
+             * Indicates whether the given layer and all of its descendants are hidden. Since a node can be shown
+             * explicitly even if its layer is hidden, it does not suffice to check the layer's own visibility. The
+             * result is cached until the visibility state of a node in the layer changes or nodes are added to or
+             * removed from the layer.
+             */
+            bool isLayerHidden(const Layer* layer) const;
+        private:
+            class FindVisibleNode;
+            void invalidateHiddenLayer(const Node* node);
         private:
             class AddNodeToNodeTree;
             class RemoveNodeFromNodeTree;
             class UpdateNodeInNodeTree;
+
+            NodeTree& nodeTree(const Layer* layer);
+            void removeEmptyNodeTrees();
+            size_t nodeTreeSize() const;
+
+            /**
+             * Returns the node trees of all layers in layer order.
+             */
+            std::vector<const NodeTree*> nodeTrees() const;
         public: // node tree bulk updating
             class MatchTreeNodes;
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+
+            /**
+             * Starts collecting the nodes whose physical bounds change instead of updating the node tree immediately.
+             * Calls to this function can be nested, and each call must be matched by a call to
+             * resumeNodeTreeUpdates().
+             */
+            void deferNodeTreeUpdates();
+
+            /**
+             * Ends one level of deferral. When the outermost level ends, the node tree is updated for all nodes whose
+             * physical bounds changed in the meantime.
+             */
+            void resumeNodeTreeUpdates();
+        public: // node tree queries
+            /**
+             * Returns the nodes in the node tree whose physical bounds intersect the given bounds. Only brushes and
+             * entities are stored in the node tree, so the returned nodes are candidates for a more precise test and
+             * never include any groups or layers.
+             */
+            std::vector<Node*> findNodesIntersecting(const vm::bbox3& bounds);
+
+            /**
+             * Picks only the closest hit that matches the given filter and adds it to the given pick result. The node
+             * trees are traversed in the order in which the ray enters the bounds of the nodes, and the traversal stops
+             * as soon as no remaining node can be hit closer than the best hit found so far. Layers whose nodes are all
+             * hidden are skipped entirely, as they are by pick().
+             *
+             * Use this instead of pick() if only the first hit of a certain kind is of interest.
+             */
+            void pickClosest(const vm::ray3& ray, const HitFilter& filter, PickResult& pickResult);
+        private:
+            /**
+             * Updates the node tree for all nodes whose bounds changed while updates were deferred. If many nodes are
+             * affected, the node tree is rebuilt entirely since that is faster than updating every node individually.
+             *
+             * This is called before the node tree is queried, so queries always see the current node bounds.
+             */
+            void flushDeferredNodeTreeUpdates();
         private:
             class InvalidateAllIssuesVisitor;
             void invalidateAllIssues();
+
+            /**
+             * Invalidates the issues of all nodes in the node tree whose physical bounds intersect the given bounds,
+             * but only if a registered issue generator inspects neighbouring nodes.
+             */
+            void invalidateNeighbourIssues(const vm::bbox3& bounds);
+            void invalidateNeighbourIssues(Node* node);
         private: // implement Node interface
             const vm::bbox3& doGetLogicalBounds() const override;
             const vm::bbox3& doGetPhysicalBounds() const override;
@@ -92,6 +204,7 @@ namespace TrenchBroom {
             void doDescendantWasAdded(Node* node, size_t depth) override;
             void doDescendantWillBeRemoved(Node* node, size_t depth) override;
             void doDescendantPhysicalBoundsDidChange(Node* node) override;
+            void doDescendantVisibilityStateDidChange(Node* node) override;
 
             bool doSelectable() const override;
             void doPick(const vm::ray3& ray, PickResult& pickResult) override;
@@ -22,8 +22,12 @@
 
 #include <kdl/set_temp.h>
 
+#include <atomic>
 #include <cassert>
 #include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -361,6 +365,131 @@ namespace TrenchBroom {
             notify(a...);
         }
     };
+
+    /**
+     * A notifier that can additionally be notified from any thread. Such notifications are posted into a lock-free
+     * queue and delivered to the observers in a batch when dispatch() is called on the thread that owns the notifier,
+     * which is usually the UI thread. Synchronous notification via notify() remains available on the owning thread and
+     * does not touch the queue.
+     *
+     * To have posted notifications delivered, set a wakeup function that schedules a call to dispatch() on the owning
+     * thread, e.g. by means of a queued invocation. The wakeup function is called on the posting thread, and only when
+     * a notification is posted into an empty queue, so that a burst of notifications results in a single dispatch.
+     *
+     * The arguments of posted notifications are copied, so reference arguments need not outlive the call to post().
+     *
+     * @tparam A the observer callback type parameter types
+     */
+    template <typename... A>
+    class QueuedNotifier : public Notifier<A...> {
+    private:
+        struct Entry {
+            std::tuple<std::decay_t<A>...> args;
+            Entry* next;
+
+            explicit Entry(A... a) :
+            args(a...),
+            next(nullptr) {}
+        };
+
+        class BaseWakeup {
+        public:
+            virtual ~BaseWakeup() = default;
+            virtual void apply() = 0;
+        };
+
+        template <typename T>
+        class Wakeup : public BaseWakeup {
+        private:
+            T m_func;
+        public:
+            explicit Wakeup(T&& func) : m_func(std::move(func)) {}
+
+            void apply() override {
+                m_func();
+            }
+        };
+
+        /**
+         * The most recently posted entry; entries are linked from newest to oldest.
+         */
+        std::atomic<Entry*> m_pending;
+        std::unique_ptr<BaseWakeup> m_wakeup;
+    public:
+        QueuedNotifier() :
+        m_pending(nullptr) {}
+
+        ~QueuedNotifier() {
+            deleteEntries(m_pending.exchange(nullptr));
+        }
+
+        /**
+         * Sets the function that is called when a notification is posted into an empty queue. This must be called
+         * before any notifications are posted.
+         *
+         * @tparam F the type of the function, a function from () -> void
+         * @param wakeup the wakeup function
+         */
+        template <typename F>
+        void setWakeup(F wakeup) {
+            m_wakeup = std::make_unique<Wakeup<F>>(std::move(wakeup));
+        }
+
+        /**
+         * Queues a notification with the given arguments. This function may be called from any thread.
+         *
+         * @param a the arguments to pass to the observers
+         */
+        void post(A... a) {
+            auto* entry = new Entry(a...);
+            entry->next = m_pending.load(std::memory_order_relaxed);
+            while (!m_pending.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed));
+
+            if (entry->next == nullptr && m_wakeup != nullptr) {
+                m_wakeup->apply();
+            }
+        }
+
+        /**
+         * Delivers all queued notifications to the observers in the order in which they were posted. Must be called on
+         * the thread that owns this notifier. Notifications posted by observers during dispatch are delivered by the
+         * next call to this function.
+         *
+         * @return the number of delivered notifications
+         */
+        size_t dispatch() {
+            // take all entries at once and reverse them into posting order
+            Entry* newest = m_pending.exchange(nullptr, std::memory_order_acquire);
+            Entry* oldest = nullptr;
+            while (newest != nullptr) {
+                Entry* next = newest->next;
+                newest->next = oldest;
+                oldest = newest;
+                newest = next;
+            }
+
+            size_t count = 0u;
+            try {
+                while (oldest != nullptr) {
+                    std::unique_ptr<Entry> entry(oldest);
+                    oldest = entry->next;
+                    std::apply([&](const auto&... args) { this->notify(args...); }, entry->args);
+                    ++count;
+                }
+            } catch (...) {
+                deleteEntries(oldest);
+                throw;
+            }
+            return count;
+        }
+    private:
+        static void deleteEntries(Entry* entry) {
+            while (entry != nullptr) {
+                std::unique_ptr<Entry> current(entry);
+                entry = current->next;
+            }
+        }
+    };
 }
 
 #endif
@@ -268,8 +268,13 @@ namespace TrenchBroom {
         }
     }
 
+    bool PreferenceManager::isMainThread() {
+        thread_local const bool result = qApp->thread() == QThread::currentThread();
+        return result;
+    }
+
     PreferenceManager& PreferenceManager::instance() {
-        ensure(qApp->thread() == QThread::currentThread(), "PreferenceManager can only be used on the main thread");
+        ensure(isMainThread(), "PreferenceManager can only be used on the main thread");
 
         static PreferenceManager prefs;
         return prefs;
@@ -517,8 +522,8 @@ namespace TrenchBroom {
             return false;
         }
 
-        const std::vector<std::string>& pathComps = path.components();
-        const std::vector<std::string>& globComps = glob.components();
+        const std::vector<std::string> pathComps = path.components();
+        const std::vector<std::string> globComps = glob.components();
 
         for (size_t i = 0; i < globLen; ++i) {
             if (globComps[i] == "*") {
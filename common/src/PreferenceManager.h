@@ -104,6 +104,12 @@ namespace TrenchBroom {
         QFileSystemWatcher* m_fileSystemWatcher;
 
         void markAsUnsaved(PreferenceBase* preference);
+
+        /**
+         * Returns whether the calling thread is the main thread. Preferences are read on hot paths such as rendering,
+         * so the result is computed only once per thread.
+         */
+        static bool isMainThread();
     public:
         static PreferenceManager& instance();
 
@@ -139,7 +145,7 @@ namespace TrenchBroom {
          */
         template <typename T>
         const T& get(Preference<T>& preference) {
-            ensure(qApp->thread() == QThread::currentThread(), "PreferenceManager can only be used on the main thread");
+            ensure(isMainThread(), "PreferenceManager can only be used on the main thread");
 
             // Only load from disk the first time it's accessed
             if (!preference.valid()) {
@@ -154,7 +160,7 @@ namespace TrenchBroom {
          */
         template <typename T>
         bool set(Preference<T>& preference, const T& value) {
-            ensure(qApp->thread() == QThread::currentThread(), "PreferenceManager can only be used on the main thread");
+            ensure(isMainThread(), "PreferenceManager can only be used on the main thread");
 
             const T previousValue = get(preference);
             if (previousValue == value) {
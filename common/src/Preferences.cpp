@@ -38,6 +38,14 @@ namespace TrenchBroom {
         Preference<Color> PointFileColor(IO::Path("Renderer/Colors/Point file"), Color(0.0f, 1.0f, 0.0f, 1.0f));
         Preference<Color> PortalFileBorderColor(IO::Path("Renderer/Colors/Portal file border"), Color(1.0f, 1.0f, 1.0f, 0.5f));
         Preference<Color> PortalFileFillColor(IO::Path("Renderer/Colors/Portal file fill"), Color(1.0f, 0.4f, 0.4f, 0.2f));
+        Preference<bool>  UseMultiDraw(IO::Path("Renderer/Use multi draw"), true);
+        Preference<bool>  CompactBrushVertices(IO::Path("Renderer/Compact brush vertices"), false);
+        Preference<bool>  UsePrimitiveRestart(IO::Path("Renderer/Use primitive restart"), true);
+        Preference<bool>  OcclusionCulling(IO::Path("Renderer/Occlusion culling"), false);
+        Preference<bool>  OcclusionCullingConservative(IO::Path("Renderer/Occlusion culling conservative"), true);
+        Preference<float> EntityModelMaxDistance(IO::Path("Renderer/Entity model max distance"), 0.0f);
+        Preference<float> MinBrushEdgeSize2D(IO::Path("Renderer/Minimum brush edge size in 2D views"), 0.5f);
+        Preference<bool>  ShowProfiler(IO::Path("Renderer/Show profiler"), false);
 
         Preference<Color>& axisColor(vm::axis::type axis) {
             switch (axis) {
@@ -120,9 +128,15 @@ namespace TrenchBroom {
 
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
+        Preference<bool> CompressTextures(IO::Path("Renderer/Compress textures"), false);
+        // 0 means that textures are uploaded in their full size
+        Preference<int> MaxTextureSize(IO::Path("Renderer/Maximum texture size"), 0);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
+        Preference<bool> UseMapCache(IO::Path("Editor/Use map cache"), false);
+        Preference<bool> UseTextureCache(IO::Path("Editor/Use texture cache"), false);
+        Preference<int> UndoMemoryLimit(IO::Path("Editor/Undo memory limit"), 1024); // in MiB, 0 means no limit
 
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
@@ -194,6 +208,14 @@ namespace TrenchBroom {
                 &PointFileColor,
                 &PortalFileBorderColor,
                 &PortalFileFillColor,
+                &UseMultiDraw,
+                &CompactBrushVertices,
+                &UsePrimitiveRestart,
+                &OcclusionCulling,
+                &OcclusionCullingConservative,
+                &EntityModelMaxDistance,
+                &MinBrushEdgeSize2D,
+                &ShowProfiler,
                 &CompassBackgroundColor,
                 &CompassBackgroundOutlineColor,
                 &CompassAxisOutlineColor,
@@ -247,8 +269,13 @@ namespace TrenchBroom {
                 &GridColor2D,
                 &TextureMinFilter,
                 &TextureMagFilter,
+                &CompressTextures,
+                &MaxTextureSize,
                 &TextureLock,
                 &UVLock,
+                &UseMapCache,
+                &UseTextureCache,
+                &UndoMemoryLimit,
                 &RendererFontPath(),
                 &RendererFontSize,
                 &BrowserFontSize,
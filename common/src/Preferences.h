@@ -44,6 +44,14 @@ namespace TrenchBroom {
         extern Preference<Color> PointFileColor;
         extern Preference<Color> PortalFileBorderColor;
         extern Preference<Color> PortalFileFillColor;
+        extern Preference<bool>  UseMultiDraw;
+        extern Preference<bool>  CompactBrushVertices;
+        extern Preference<bool>  UsePrimitiveRestart;
+        extern Preference<bool>  OcclusionCulling;
+        extern Preference<bool>  OcclusionCullingConservative;
+        extern Preference<float> EntityModelMaxDistance;
+        extern Preference<float> MinBrushEdgeSize2D;
+        extern Preference<bool>  ShowProfiler;
 
         Preference<Color>& axisColor(vm::axis::type axis);
 
@@ -116,9 +124,14 @@ namespace TrenchBroom {
 
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
+        extern Preference<bool> CompressTextures;
+        extern Preference<int> MaxTextureSize;
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
+        extern Preference<bool> UseMapCache;
+        extern Preference<bool> UseTextureCache;
+        extern Preference<int> UndoMemoryLimit;
 
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
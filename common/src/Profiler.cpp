@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profiler.h"
+
+#include <functional>
+#include <thread>
+
+namespace TrenchBroom {
+    const std::size_t Profiler::Capacity = 1u << 16;
+
+    Profiler::Zone::Zone(const char* name) :
+    m_name(name),
+    m_start(Clock::now()) {}
+
+    Profiler::Zone::~Zone() {
+        Profiler::instance().record(m_name, m_start, Clock::now());
+    }
+
+    Profiler& Profiler::instance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler::Profiler() :
+    m_epoch(Clock::now()),
+    m_next(0) {
+        m_events.reserve(Capacity);
+    }
+
+    void Profiler::record(const char* name, const Clock::time_point start, const Clock::time_point end, const Track track) {
+        const auto startMicros = micros(start);
+        const auto durationMicros = micros(end) - startMicros;
+        const auto threadId = track == Track::Gpu ? 0u : std::hash<std::thread::id>()(std::this_thread::get_id());
+        const auto event = Event{ name, startMicros, durationMicros, threadId, track };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.size() < Capacity) {
+            m_events.push_back(event);
+        } else {
+            m_events[m_next] = event;
+        }
+        m_next = (m_next + 1u) % Capacity;
+    }
+
+    void Profiler::clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.clear();
+        m_next = 0;
+    }
+
+    void Profiler::writeChromeTrace(std::ostream& stream) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // if the buffer is full, the oldest event is the one that will be overwritten next
+        const auto first = m_events.size() < Capacity ? 0u : m_next;
+
+        stream << "{\"traceEvents\":[";
+        for (std::size_t i = 0; i < m_events.size(); ++i) {
+            const auto& event = m_events[(first + i) % m_events.size()];
+            if (i > 0u) {
+                stream << ",";
+            }
+
+            // GPU events are placed in a separate process so that they appear as their own track
+            stream << "\n{\"name\":\"" << event.name << "\",\"ph\":\"X\""
+                   << ",\"ts\":" << event.startMicros
+                   << ",\"dur\":" << event.durationMicros
+                   << ",\"pid\":" << (event.track == Track::Gpu ? 2 : 1)
+                   << ",\"tid\":" << event.threadId << "}";
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    std::int64_t Profiler::micros(const Clock::time_point time) const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - m_epoch).count();
+    }
+}
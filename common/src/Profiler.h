@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_Profiler
+#define TrenchBroom_Profiler
+
+#include "Macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * Records named time intervals, called zones, from any thread into a ring buffer of fixed size, so that the most
+     * recent events can be written as a Chrome trace file, which can be loaded into chrome://tracing, Perfetto or
+     * Tracy's trace importer. Nested zones on the same thread are shown as a hierarchy by these tools.
+     *
+     * Zones are placed with the TB_PROFILE_ZONE macro, which expands to nothing unless TB_ENABLE_PROFILER is
+     * defined, so they cost nothing in regular builds. The frame profiler forwards its events here as well.
+     */
+    class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Track {
+            Cpu,
+            Gpu
+        };
+
+        /**
+         * Records the time spent in the enclosing scope under the given name. The name must be a string literal or
+         * otherwise outlive the profiler.
+         */
+        class Zone {
+        private:
+            const char* m_name;
+            Clock::time_point m_start;
+        public:
+            explicit Zone(const char* name);
+            ~Zone();
+
+            deleteCopyAndMove(Zone)
+        };
+    private:
+        struct Event {
+            const char* name;
+            std::int64_t startMicros;
+            std::int64_t durationMicros;
+            std::size_t threadId;
+            Track track;
+        };
+
+        static const std::size_t Capacity;
+
+        mutable std::mutex m_mutex;
+        Clock::time_point m_epoch;
+        std::vector<Event> m_events;
+        std::size_t m_next;
+    public:
+        static Profiler& instance();
+
+        /**
+         * Records an event with the given name that started and ended at the given times. If the buffer is full, the
+         * oldest event is overwritten.
+         */
+        void record(const char* name, Clock::time_point start, Clock::time_point end, Track track = Track::Cpu);
+
+        /**
+         * Discards all recorded events.
+         */
+        void clear();
+
+        /**
+         * Writes the recorded events in the Chrome trace event format to the given stream, oldest first.
+         */
+        void writeChromeTrace(std::ostream& stream) const;
+    private:
+        Profiler();
+
+        std::int64_t micros(Clock::time_point time) const;
+
+        deleteCopyAndMove(Profiler)
+    };
+}
+
+#ifdef TB_ENABLE_PROFILER
+#define TB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define TB_PROFILE_CONCAT(a, b) TB_PROFILE_CONCAT_IMPL(a, b)
+#define TB_PROFILE_ZONE(name) const ::TrenchBroom::Profiler::Zone TB_PROFILE_CONCAT(profilerZone, __LINE__)(name)
+#else
+#define TB_PROFILE_ZONE(name)
+#endif
+
+#endif /* defined(TrenchBroom_Profiler) */
@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_PROJECTEDGRID_H
+#define TRENCHBROOM_PROJECTEDGRID_H
+
+#include "FloatType.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * Indexes values by a position in 3D space, projected onto each of the three coordinate planes. This allows finding
+     * all values whose positions lie within a rectangle on one of these planes, such as the area covered by a lasso in
+     * an orthographic view that looks along a coordinate axis, without looking at every value.
+     *
+     * Each projection is divided into square cells of the given size. The non-empty cells are stored in an ordered map,
+     * so a query only visits the cells which overlap the query rectangle and contain values, and the cost of a query
+     * depends on the number of values found rather than on the number of values in the grid.
+     *
+     * @tparam T the type of the values, must be equality comparable
+     */
+    template <typename T>
+    class ProjectedGrid {
+    private:
+        using CellKey = std::pair<std::int64_t, std::int64_t>;
+        using Cell = std::vector<T>;
+        using CellMap = std::map<CellKey, Cell>;
+
+        FloatType m_cellSize;
+
+        /**
+         * One map of cells for each axis, where the grid at index i ignores the i-th coordinate of the positions.
+         */
+        std::array<CellMap, 3> m_grids;
+    public:
+        explicit ProjectedGrid(const FloatType cellSize = 64.0) :
+        m_cellSize(cellSize) {
+            assert(m_cellSize > 0.0);
+        }
+
+        /**
+         * Adds the given value at the given position. Values with non-finite positions are not added.
+         */
+        void insert(const vm::vec3& position, const T& value) {
+            if (!isFinite(position)) {
+                return;
+            }
+
+            for (size_t axis = 0; axis < 3; ++axis) {
+                m_grids[axis][cellKey(axis, position)].push_back(value);
+            }
+        }
+
+        /**
+         * Removes the given value, which must have been added at the given position. If the value was added more than
+         * once, only one of its occurrences is removed.
+         */
+        void remove(const vm::vec3& position, const T& value) {
+            if (!isFinite(position)) {
+                return;
+            }
+
+            for (size_t axis = 0; axis < 3; ++axis) {
+                auto& grid = m_grids[axis];
+                const auto cellIt = grid.find(cellKey(axis, position));
+                if (cellIt != std::end(grid)) {
+                    Cell& cell = cellIt->second;
+                    const auto valueIt = std::find(std::begin(cell), std::end(cell), value);
+                    if (valueIt != std::end(cell)) {
+                        *valueIt = std::move(cell.back());
+                        cell.pop_back();
+                    }
+                    if (cell.empty()) {
+                        grid.erase(cellIt);
+                    }
+                }
+            }
+        }
+
+        void clear() {
+            for (auto& grid : m_grids) {
+                grid.clear();
+            }
+        }
+
+        /**
+         * Finds the values in all cells of the grid for the given axis which overlap the given bounds. The coordinates
+         * of the bounds on the given axis are ignored.
+         *
+         * The cells may contain values whose positions are slightly outside of the given bounds, so the caller must
+         * test the values it is interested in.
+         *
+         * @tparam O the type of the output iterator
+         * @param axis the axis along which the positions are projected
+         * @param bounds the bounds to look up
+         * @param out the output iterator to which the values are written
+         */
+        template <typename O>
+        void find(const size_t axis, const vm::bbox3& bounds, O out) const {
+            assert(axis < 3);
+
+            const auto& grid = m_grids[axis];
+            const CellKey min = cellKey(axis, bounds.min);
+            const CellKey max = cellKey(axis, bounds.max);
+
+            auto it = grid.lower_bound(min);
+            while (it != std::end(grid) && it->first.first <= max.first) {
+                const CellKey& key = it->first;
+                if (key.second < min.second) {
+                    // skip ahead to the first cell of this row that overlaps the bounds
+                    it = grid.lower_bound(CellKey(key.first, min.second));
+                } else if (key.second > max.second) {
+                    // skip ahead to the next row
+                    it = grid.lower_bound(CellKey(key.first + 1, min.second));
+                } else {
+                    for (const T& value : it->second) {
+                        out++ = value;
+                    }
+                    ++it;
+                }
+            }
+        }
+    private:
+        CellKey cellKey(const size_t axis, const vm::vec3& position) const {
+            const size_t first = axis == 0 ? 1 : 0;
+            const size_t second = axis == 2 ? 1 : 2;
+            return CellKey(cellIndex(position[first]), cellIndex(position[second]));
+        }
+
+        std::int64_t cellIndex(const FloatType coordinate) const {
+            // clamp to a range that can be represented exactly so that huge query bounds do not overflow
+            static const auto limit = static_cast<FloatType>(std::numeric_limits<int>::max());
+            return static_cast<std::int64_t>(std::clamp(std::floor(coordinate / m_cellSize), -limit, limit));
+        }
+
+        static bool isFinite(const vm::vec3& position) {
+            return std::isfinite(position.x()) && std::isfinite(position.y()) && std::isfinite(position.z());
+        }
+    };
+}
+
+#endif //TRENCHBROOM_PROJECTEDGRID_H
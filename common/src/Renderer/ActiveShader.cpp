@@ -25,12 +25,21 @@ namespace TrenchBroom {
     namespace Renderer {
 
         ActiveShader::ActiveShader(ShaderManager& shaderManager, const ShaderConfig& shaderConfig) :
-            m_program(shaderManager.program(shaderConfig)) {
-            m_program.activate();
+            m_shaderManager(shaderManager),
+            m_program(shaderManager.program(shaderConfig)),
+            m_activated(false) {
+            if (m_shaderManager.currentProgram() != &m_program) {
+                m_program.activate();
+                m_shaderManager.setCurrentProgram(&m_program);
+                m_activated = true;
+            }
         }
 
         ActiveShader::~ActiveShader() {
-            m_program.deactivate();
+            if (m_activated && m_shaderManager.currentProgram() == &m_program) {
+                m_program.deactivate();
+                m_shaderManager.setCurrentProgram(nullptr);
+            }
         }
     }
 }
@@ -29,9 +29,16 @@ namespace TrenchBroom {
         class ShaderConfig;
         class ShaderManager;
 
+        /**
+         * Uses a shader program for the lifetime of this object. If the program is already in use, e.g. because
+         * an enclosing scope activated it, no GL calls are made, and the program remains in use when this object is
+         * destroyed.
+         */
         class ActiveShader {
         private:
+            ShaderManager& m_shaderManager;
             ShaderProgram& m_program;
+            bool m_activated;
         public:
             ActiveShader(ShaderManager& shaderManager, const ShaderConfig& shaderConfig);
             ~ActiveShader();
@@ -421,6 +421,86 @@ namespace TrenchBroom {
             return false;
         }
 
+        AllocationTracker::Index AllocationTracker::compact(const Index budget, const BlockMovedCallback& blockMoved) {
+            checkInvariants();
+
+            Index moved = 0;
+            Block* block = m_leftmostBlock;
+            while (block != nullptr && moved < budget) {
+                Block* right = block->right;
+                if (!block->free || right == nullptr) {
+                    block = right;
+                    continue;
+                }
+
+                // adjacent free blocks are always merged, so right must be a used block
+                assert(!right->free);
+
+                // swap the free block and the used block to its right, this keeps the free block in its bin list
+                // because its size is unchanged
+                const Index oldPos = right->pos;
+                right->pos = block->pos;
+                block->pos = right->pos + right->size;
+
+                Block* left = block->left;
+                Block* next = right->right;
+
+                right->left = left;
+                right->right = block;
+                block->left = right;
+                block->right = next;
+
+                if (left == nullptr) {
+                    assert(m_leftmostBlock == block);
+                    m_leftmostBlock = right;
+                } else {
+                    left->right = right;
+                }
+
+                if (next == nullptr) {
+                    assert(m_rightmostBlock == right);
+                    m_rightmostBlock = block;
+                } else {
+                    next->left = block;
+                }
+
+                // merge the free block with the next one if possible
+                if (next != nullptr && next->free) {
+                    unlinkFromBinList(block);
+                    unlinkFromBinList(next);
+
+                    block->size += next->size;
+                    block->right = next->right;
+                    if (next->right == nullptr) {
+                        m_rightmostBlock = block;
+                    } else {
+                        next->right->left = block;
+                    }
+
+                    recycle(next);
+                    linkToBinList(block);
+                }
+
+                blockMoved(right, oldPos);
+                moved += right->size;
+            }
+
+            checkInvariants();
+            return moved;
+        }
+
+        AllocationTracker::FragmentationStats AllocationTracker::fragmentationStats() const {
+            FragmentationStats stats{0, 0, 0, largestPossibleAllocation()};
+            for (const Block* bin : m_freeBlockSizeBins) {
+                for (const Block* block = bin; block != nullptr; block = block->nextOfSameSize) {
+                    stats.freeSize += block->size;
+                    ++stats.freeBlockCount;
+                }
+            }
+            stats.usedSize = m_capacity - stats.freeSize;
+            return stats;
+        }
+
 // Testing / debugging
 
         std::vector<AllocationTracker::Range> AllocationTracker::freeBlocks() const {
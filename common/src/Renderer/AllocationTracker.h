@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_AllocationTracker
 #define TrenchBroom_AllocationTracker
 
+#include <functional>
 #include <vector>
 
 namespace TrenchBroom {
@@ -104,6 +105,20 @@ namespace TrenchBroom {
             Block* obtainBlock();
 
         public:
+            struct FragmentationStats {
+                Index usedSize;
+                Index freeSize;
+                size_t freeBlockCount;
+                Index largestFreeBlock;
+            };
+
+            /**
+             * Called by compact() after a used block was moved. The block's pos is already updated, and the caller is
+             * expected to move `block->size` elements from `oldPos` to `block->pos`. The ranges may overlap, but the
+             * new position is always less than the old position.
+             */
+            using BlockMovedCallback = std::function<void(const Block* block, Index oldPos)>;
+
             explicit AllocationTracker(Index initial_capacity);
             AllocationTracker();
             ~AllocationTracker();
@@ -126,6 +141,19 @@ namespace TrenchBroom {
              */
             bool hasAllocations() const;
 
+            /**
+             * Moves used blocks towards the start of the managed range into the free blocks preceding them, so that
+             * the free space accumulates at the end. The relative order of the used blocks is preserved, and the
+             * Block objects stay valid, only their pos changes.
+             *
+             * Stops once at least `budget` elements were moved or there is nothing left to compact, so repeated calls
+             * can spread the work over time.
+             *
+             * @return the number of elements that were moved
+             */
+            Index compact(Index budget, const BlockMovedCallback& blockMoved);
+            FragmentationStats fragmentationStats() const;
+
             // Testing / debugging
 
             class Range {
@@ -28,9 +28,18 @@
 #include "Model/TagAttribute.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/Camera.h"
+#include "Renderer/FrameProfiler.h"
 #include "Renderer/RenderContext.h"
 
+#include <kdl/parallel.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <vector>
 
@@ -119,7 +128,9 @@ namespace TrenchBroom {
         m_showOccludedEdges(false),
         m_forceTransparent(false),
         m_transparencyAlpha(1.0f),
-        m_showHiddenBrushes(false) {
+        m_showHiddenBrushes(false),
+        m_occlusionCulling(false),
+        m_primitiveRestart(false) {
             clear();
         }
 
@@ -150,16 +161,28 @@ namespace TrenchBroom {
         }
 
         void BrushRenderer::invalidate() {
+            // switching the vertex format requires removing all vertices, otherwise they can be reused
+            const auto compactVertices = pref(Preferences::CompactBrushVertices);
+            const auto switchVertexFormat = std::any_of(std::begin(m_chunks), std::end(m_chunks), [&](const auto& entry) {
+                return entry.second->vertexArray->compactVertices() != compactVertices;
+            });
+
             for (auto& brush : m_allBrushes) {
                 // this will also invalidate already invalid brushes, which
                 // is unnecessary
-                removeBrushFromVbo(brush);
+                if (switchVertexFormat) {
+                    removeBrushFromVbo(brush);
+                } else {
+                    removeBrushIndicesFromVbo(brush);
+                }
             }
             m_invalidBrushes = m_allBrushes;
 
             assert(m_brushInfo.empty());
-            assert(m_transparentFaces->empty());
-            assert(m_opaqueFaces->empty());
+            assert(!switchVertexFormat || m_chunks.empty());
+
+            // all face indices were removed, so they can be encoded differently from now on
+            m_primitiveRestart = usePrimitiveRestart();
         }
 
         void BrushRenderer::invalidateBrushes(const std::vector<Model::Brush*>& brushes) {
@@ -183,17 +206,13 @@ namespace TrenchBroom {
 
         void BrushRenderer::clear() {
             m_brushInfo.clear();
+            m_retainedVertices.clear();
             m_allBrushes.clear();
             m_invalidBrushes.clear();
+            m_chunks.clear();
+            m_occlusionCuller.clear();
 
-            m_vertexArray = std::make_shared<BrushVertexArray>();
-            m_edgeIndices = std::make_shared<BrushIndexArray>();
-            m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
-            m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
-
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            m_primitiveRestart = usePrimitiveRestart();
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -249,6 +268,10 @@ namespace TrenchBroom {
             }
         }
 
+        void BrushRenderer::setOcclusionCulling(const bool occlusionCulling) {
+            m_occlusionCulling = occlusionCulling;
+        }
+
         void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             renderOpaque(renderContext, renderBatch);
             renderTransparent(renderContext, renderBatch);
@@ -257,48 +280,96 @@ namespace TrenchBroom {
         void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_allBrushes.empty()) {
                 if (!valid()) {
-                    validate();
+                    validateIncrementally();
                 }
-                if (renderContext.showFaces()) {
-                    renderOpaqueFaces(renderBatch);
+
+                // while the renderer is partially validated, some vertex blocks are only retained for brushes that
+                // have no indices yet, so compacting is deferred until all brushes are validated
+                if (valid()) {
+                    compact();
+                }
+
+                const auto& camera = renderContext.camera();
+                const auto frustum = camera.frustum();
+                const auto multiDraw = pref(Preferences::UseMultiDraw);
+
+                // in the 2D views, the edges of brushes that would shrink to less than the configured number of pixels
+                // are skipped, since they only add up to millions of overlapping lines when the view is zoomed out
+                const auto minEdgeSize = renderContext.render2D() ? pref(Preferences::MinBrushEdgeSize2D) / camera.zoom() : 0.0f;
+
+                OcclusionCuller* occlusionCuller = nullptr;
+                if (m_occlusionCulling && renderContext.render3D()) {
+                    occlusionCuller = &m_occlusionCuller;
+                    occlusionCuller->beginFrame(camera.position(), pref(Preferences::OcclusionCullingConservative));
+                }
+
+                for (auto& [key, chunk] : m_chunks) {
+                    if (!frustum.intersects(chunk->bounds)) {
+                        continue;
+                    }
+
+                    if (renderContext.showFaces()) {
+                        cull(*chunk->opaqueFaces, frustum, occlusionCuller, multiDraw);
+                        renderOpaqueFaces(*chunk, renderBatch);
+                    }
+                    if (renderContext.showEdges() || m_showEdges) {
+                        chunk->edgeIndices->cull(frustum, occlusionCuller, multiDraw, minEdgeSize);
+                        renderEdges(*chunk, renderBatch);
+                    }
                 }
-                if (renderContext.showEdges() || m_showEdges) {
-                    renderEdges(renderBatch);
+
+                // the occlusion queries must be issued after the opaque faces have been rendered
+                if (occlusionCuller != nullptr) {
+                    renderBatch.add(occlusionCuller);
                 }
             }
         }
 
         void BrushRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
+            // the opaque pass has already spent this frame's validation budget, so the transparent faces of the brushes
+            // that are still invalid are rendered once they have been validated in a later frame
             if (!m_allBrushes.empty()) {
-                if (!valid()) {
-                    validate();
-                }
                 if (renderContext.showFaces()) {
-                    renderTransparentFaces(renderBatch);
+                    const auto frustum = renderContext.camera().frustum();
+                    const auto multiDraw = pref(Preferences::UseMultiDraw);
+
+                    for (auto& [key, chunk] : m_chunks) {
+                        if (frustum.intersects(chunk->bounds)) {
+                            cull(*chunk->transparentFaces, frustum, nullptr, multiDraw);
+                            renderTransparentFaces(*chunk, renderBatch);
+                        }
+                    }
                 }
             }
         }
 
-        void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch) {
-            m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-            m_opaqueFaceRenderer.setTint(m_tint);
-            m_opaqueFaceRenderer.setTintColor(m_tintColor);
-            m_opaqueFaceRenderer.render(renderBatch);
+        void BrushRenderer::cull(TextureToBrushIndicesMap& faces, const Camera::Frustum& frustum, OcclusionCuller* occlusionCuller, const bool multiDraw) {
+            for (auto& entry : faces) {
+                entry.second->cull(frustum, occlusionCuller, multiDraw);
+            }
+        }
+
+        void BrushRenderer::renderOpaqueFaces(Chunk& chunk, RenderBatch& renderBatch) {
+            chunk.opaqueFaceRenderer.setGrayscale(m_grayscale);
+            chunk.opaqueFaceRenderer.setTint(m_tint);
+            chunk.opaqueFaceRenderer.setTintColor(m_tintColor);
+            chunk.opaqueFaceRenderer.render(renderBatch);
         }
 
-        void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch) {
-            m_transparentFaceRenderer.setGrayscale(m_grayscale);
-            m_transparentFaceRenderer.setTint(m_tint);
-            m_transparentFaceRenderer.setTintColor(m_tintColor);
-            m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-            m_transparentFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderTransparentFaces(Chunk& chunk, RenderBatch& renderBatch) {
+            chunk.transparentFaceRenderer.setGrayscale(m_grayscale);
+            chunk.transparentFaceRenderer.setTint(m_tint);
+            chunk.transparentFaceRenderer.setTintColor(m_tintColor);
+            chunk.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+            chunk.transparentFaceRenderer.render(renderBatch);
         }
 
-        void BrushRenderer::renderEdges(RenderBatch& renderBatch) {
+        void BrushRenderer::renderEdges(Chunk& chunk, RenderBatch& renderBatch) {
             if (m_showOccludedEdges) {
-                m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+                chunk.edgeRenderer.renderWithOccluded(renderBatch, true, m_edgeColor, m_occludedEdgeColor);
+            } else {
+                chunk.edgeRenderer.render(renderBatch, m_edgeColor);
             }
-            m_edgeRenderer.render(renderBatch, m_edgeColor);
         }
 
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
@@ -324,32 +395,221 @@ namespace TrenchBroom {
             }
         };
 
+        /**
+         * Below this number of invalid brushes, the brush caches are validated serially because starting the threads
+         * would take longer than validating the caches.
+         */
+        static constexpr size_t MinBrushesForParallelCacheValidation = 256u;
+
+        /**
+         * Builds the vertex caches of the given brushes in parallel. Each cache depends only on its brush, so this
+         * is the part of validation that can run concurrently, while the VBO allocations must be made serially.
+         */
+        static void validateVertexCaches(const std::vector<const Model::Brush*>& brushes) {
+            if (brushes.size() < MinBrushesForParallelCacheValidation) {
+                return;
+            }
+
+            kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                const auto* brush = brushes[i];
+                brush->brushRendererBrushCache().validateVertexCache(brush);
+            });
+        }
+
+        /**
+         * When validating incrementally, the invalid brushes are validated in batches of this size until the time
+         * budget is used up.
+         */
+        static constexpr size_t IncrementalValidationBatchSize = 2048u;
+
+        /**
+         * The time that incremental validation may take per frame. The remaining brushes are validated in the
+         * following frames, so that a large invalidation does not block the UI thread for its entire duration.
+         */
+        static constexpr auto IncrementalValidationBudget = std::chrono::milliseconds(12);
+
         void BrushRenderer::validate() {
             assert(!valid());
+            FrameProfiler::Scope scope("BrushRenderer::validate");
+
+            validateBrushes(m_invalidBrushes.size());
+            assert(valid());
+            assert(m_retainedVertices.empty());
+        }
+
+        void BrushRenderer::validateIncrementally() {
+            assert(!valid());
+            FrameProfiler::Scope scope("BrushRenderer::validate");
+
+            const auto start = std::chrono::steady_clock::now();
+            do {
+                validateBrushes(IncrementalValidationBatchSize);
+            } while (!valid() && std::chrono::steady_clock::now() - start < IncrementalValidationBudget);
+
+            assert(!valid() || m_retainedVertices.empty());
+        }
+
+        void BrushRenderer::validateBrushes(const size_t count) {
+            std::vector<const Model::Brush*> brushes;
+            brushes.reserve(std::min(count, m_invalidBrushes.size()));
+
+            for (auto it = std::begin(m_invalidBrushes); it != std::end(m_invalidBrushes) && brushes.size() < count; ++it) {
+                brushes.push_back(*it);
+            }
 
-            for (auto brush : m_invalidBrushes) {
+            validateVertexCaches(brushes);
+            for (auto brush : brushes) {
                 validateBrush(brush);
+                m_invalidBrushes.erase(brush);
             }
-            m_invalidBrushes.clear();
-            assert(valid());
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            for (auto& [key, chunk] : m_chunks) {
+                chunk->updateRenderers(m_faceColor);
+            }
         }
 
-        static size_t triIndicesCountForPolygon(const size_t vertexCount) {
+        AllocationTracker::FragmentationStats BrushRenderer::vertexFragmentationStats() const {
+            auto result = AllocationTracker::FragmentationStats{0, 0, 0u, 0};
+            for (const auto& [key, chunk] : m_chunks) {
+                const auto stats = chunk->vertexArray->fragmentationStats();
+                result.usedSize += stats.usedSize;
+                result.freeSize += stats.freeSize;
+                result.freeBlockCount += stats.freeBlockCount;
+                result.largestFreeBlock = std::max(result.largestFreeBlock, stats.largestFreeBlock);
+            }
+            return result;
+        }
+
+        /**
+         * The number of vertices or indices that compact() may move per buffer.
+         */
+        static constexpr size_t CompactionBudget = 1u << 16;
+
+        /**
+         * Compacting moves every allocation behind the first free block, so only do it if enough space is wasted.
+         */
+        static bool shouldCompact(const AllocationTracker::FragmentationStats& stats) {
+            const auto capacity = stats.usedSize + stats.freeSize;
+            return stats.freeBlockCount > 1u
+                && stats.freeSize * 4u >= capacity
+                && stats.largestFreeBlock * 2u < stats.freeSize;
+        }
+
+        void BrushRenderer::compact() {
+            for (auto& [key, chunk] : m_chunks) {
+                compact(*chunk);
+            }
+        }
+
+        void BrushRenderer::compact(Chunk& chunk) {
+            if (shouldCompact(chunk.vertexArray->fragmentationStats())) {
+                chunk.vertexArray->compact(CompactionBudget, [&](const AllocationTracker::Block* block, const size_t oldPos) {
+                    const auto* brush = chunk.vertexBlockBrushes.at(block);
+                    auto it = m_brushInfo.find(brush);
+                    if (it != std::end(m_brushInfo)) {
+                        rebaseIndices(it->second, static_cast<GLuint>(oldPos), static_cast<GLuint>(block->pos));
+                    }
+                });
+            }
+
+            if (shouldCompact(chunk.edgeIndices->fragmentationStats())) {
+                chunk.edgeIndices->compact(CompactionBudget);
+            }
+            compact(*chunk.opaqueFaces);
+            compact(*chunk.transparentFaces);
+        }
+
+        void BrushRenderer::compact(TextureToBrushIndicesMap& faces) {
+            for (auto& entry : faces) {
+                if (shouldCompact(entry.second->fragmentationStats())) {
+                    entry.second->compact(CompactionBudget);
+                }
+            }
+        }
+
+        void BrushRenderer::rebaseIndices(const BrushInfo& info, const GLuint oldBaseIndex, const GLuint newBaseIndex) {
+            if (info.edgeIndicesKey != nullptr) {
+                info.chunk->edgeIndices->rebaseElementsWithKey(info.edgeIndicesKey, oldBaseIndex, newBaseIndex);
+            }
+            for (const auto& [texture, key] : info.opaqueFaceIndicesKeys) {
+                info.chunk->opaqueFaces->at(texture)->rebaseElementsWithKey(key, oldBaseIndex, newBaseIndex);
+            }
+            for (const auto& [texture, key] : info.transparentFaceIndicesKeys) {
+                info.chunk->transparentFaces->at(texture)->rebaseElementsWithKey(key, oldBaseIndex, newBaseIndex);
+            }
+        }
+
+        /**
+         * The size of the grid cells that the brushes are grouped into chunks by.
+         */
+        static constexpr float ChunkSize = 2048.0f;
+
+        BrushRenderer::Chunk::Chunk(const bool i_compactVertices, const vm::bbox3f& i_bounds) :
+        vertexArray(std::make_shared<BrushVertexArray>(i_compactVertices)),
+        edgeIndices(std::make_shared<BrushIndexArray>()),
+        transparentFaces(std::make_shared<TextureToBrushIndicesMap>()),
+        opaqueFaces(std::make_shared<TextureToBrushIndicesMap>()),
+        bounds(i_bounds) {}
+
+        void BrushRenderer::Chunk::updateRenderers(const Color& faceColor) {
+            opaqueFaceRenderer = FaceRenderer(vertexArray, opaqueFaces, faceColor);
+            transparentFaceRenderer = FaceRenderer(vertexArray, transparentFaces, faceColor);
+            edgeRenderer = IndexedEdgeRenderer(vertexArray, edgeIndices);
+        }
+
+        BrushRenderer::Chunk& BrushRenderer::chunkFor(const vm::bbox3f& bounds) {
+            const auto cell = vm::floor(bounds.center() / ChunkSize);
+            const auto key = ChunkKey(static_cast<int>(cell.x()), static_cast<int>(cell.y()), static_cast<int>(cell.z()));
+
+            auto& chunk = m_chunks[key];
+            if (chunk == nullptr) {
+                chunk = std::make_unique<Chunk>(pref(Preferences::CompactBrushVertices), bounds);
+                chunk->updateRenderers(m_faceColor);
+            } else {
+                chunk->bounds = vm::merge(chunk->bounds, bounds);
+            }
+            return *chunk;
+        }
+
+        void BrushRenderer::deleteVertices(Chunk* chunk, AllocationTracker::Block* vertexHolderKey) {
+            chunk->vertexBlockBrushes.erase(vertexHolderKey);
+            chunk->vertexArray->deleteVerticesWithKey(vertexHolderKey);
+
+            if (chunk->vertexBlockBrushes.empty()) {
+                // the chunk has no brushes left, so release its buffers
+                for (auto it = std::begin(m_chunks); it != std::end(m_chunks); ++it) {
+                    if (it->second.get() == chunk) {
+                        m_chunks.erase(it);
+                        break;
+                    }
+                }
+            }
+        }
+
+        bool BrushRenderer::usePrimitiveRestart() {
+            return pref(Preferences::UsePrimitiveRestart) && GLEW_VERSION_3_1;
+        }
+
+        static size_t triIndicesCountForPolygon(const size_t vertexCount, const bool primitiveRestart) {
             assert(vertexCount >= 3);
-            const size_t indexCount = 3 * (vertexCount - 2);
+            // a triangle fan followed by the primitive restart index, or separate triangles
+            const size_t indexCount = primitiveRestart ? vertexCount + 1 : 3 * (vertexCount - 2);
             return indexCount;
         }
 
-        static void addTriIndicesForPolygon(GLuint* dest, const GLuint baseIndex, const size_t vertexCount) {
+        static void addTriIndicesForPolygon(GLuint* dest, const GLuint baseIndex, const size_t vertexCount, const bool primitiveRestart) {
             assert(vertexCount >= 3);
-            for (size_t i = 0; i < vertexCount - 2; ++i) {
-                *(dest++) = baseIndex;
-                *(dest++) = baseIndex + static_cast<GLuint>(i + 1);
-                *(dest++) = baseIndex + static_cast<GLuint>(i + 2);
+            if (primitiveRestart) {
+                for (size_t i = 0; i < vertexCount; ++i) {
+                    *(dest++) = baseIndex + static_cast<GLuint>(i);
+                }
+                *(dest++) = IndexHolder::PrimitiveRestartIndex;
+            } else {
+                for (size_t i = 0; i < vertexCount - 2; ++i) {
+                    *(dest++) = baseIndex;
+                    *(dest++) = baseIndex + static_cast<GLuint>(i + 1);
+                    *(dest++) = baseIndex + static_cast<GLuint>(i + 2);
+                }
             }
         }
 
@@ -438,6 +698,7 @@ namespace TrenchBroom {
             if (facePolicy == Filter::FaceRenderPolicy::RenderNone &&
                 edgePolicy == Filter::EdgeRenderPolicy::RenderNone) {
                 // NOTE: this skips inserting the brush into m_brushInfo
+                releaseRetainedVertices(brush);
                 return;
             }
 
@@ -449,10 +710,23 @@ namespace TrenchBroom {
             const auto& cachedVertices = brushCache.cachedVertices();
             ensure(!cachedVertices.empty(), "Brush must have cached vertices");
 
-            assert(m_vertexArray != nullptr);
-            auto [vertBlock, dest] = m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-            std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
-            info.vertexHolderKey = vertBlock;
+            const auto bounds = vm::bbox3f(brush->logicalBounds());
+
+            auto retained = m_retainedVertices.find(brush);
+            if (retained != std::end(m_retainedVertices) && retained->second.vertexGeneration == brushCache.generation()) {
+                info.chunk = retained->second.chunk;
+                info.vertexHolderKey = retained->second.vertexHolderKey;
+                m_retainedVertices.erase(retained);
+            } else {
+                releaseRetainedVertices(brush);
+                info.chunk = &chunkFor(bounds);
+                info.vertexHolderKey = info.chunk->vertexArray->insertVertices(cachedVertices);
+                info.chunk->vertexBlockBrushes[info.vertexHolderKey] = brush;
+            }
+            info.vertexGeneration = brushCache.generation();
+
+            auto& chunk = *info.chunk;
+            auto* vertBlock = info.vertexHolderKey;
 
             const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
 
@@ -460,7 +734,7 @@ namespace TrenchBroom {
             {
                 const size_t edgeIndexCount = countMarkedEdgeIndices(brush, edgePolicy);
                 if (edgeIndexCount > 0) {
-                    auto [key, insertDest] = m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+                    auto [key, insertDest] = chunk.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount, bounds);
                     info.edgeIndicesKey = key;
                     getMarkedEdgeIndices(brush, edgePolicy, brushVerticesStartIndex, insertDest);
                 } else {
@@ -492,22 +766,22 @@ namespace TrenchBroom {
                     if (cache.face->isMarked()) {
                         assert(cache.texture == texture);
                         if (shouldDrawFaceInTransparentPass(brush, cache.face)) {
-                            transparentIndexCount += triIndicesCountForPolygon(cache.vertexCount);
+                            transparentIndexCount += triIndicesCountForPolygon(cache.vertexCount, m_primitiveRestart);
                         } else {
-                            opaqueIndexCount += triIndicesCountForPolygon(cache.vertexCount);
+                            opaqueIndexCount += triIndicesCountForPolygon(cache.vertexCount, m_primitiveRestart);
                         }
                     }
                 }
 
                 if (transparentIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_transparentFaces;
+                    TextureToBrushIndicesMap& faceVboMap = *chunk.transparentFaces;
                     auto& holderPtr = faceVboMap[texture];
                     if (holderPtr == nullptr) {
                         // inserts into map!
-                        holderPtr = std::make_shared<BrushIndexArray>();
+                        holderPtr = std::make_shared<BrushIndexArray>(m_primitiveRestart);
                     }
 
-                    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(transparentIndexCount);
+                    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(transparentIndexCount, bounds);
                     info.transparentFaceIndicesKeys.push_back({texture, key});
 
                     // process all faces with this texture (they'll be consecutive)
@@ -518,23 +792,24 @@ namespace TrenchBroom {
                             addTriIndicesForPolygon(currentDest,
                                                     static_cast<GLuint>(brushVerticesStartIndex +
                                                                         cache.indexOfFirstVertexRelativeToBrush),
-                                                    cache.vertexCount);
+                                                    cache.vertexCount,
+                                                    m_primitiveRestart);
 
-                            currentDest += triIndicesCountForPolygon(cache.vertexCount);
+                            currentDest += triIndicesCountForPolygon(cache.vertexCount, m_primitiveRestart);
                         }
                     }
                     assert(currentDest == (insertDest + transparentIndexCount));
                 }
 
                 if (opaqueIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_opaqueFaces;
+                    TextureToBrushIndicesMap& faceVboMap = *chunk.opaqueFaces;
                     auto& holderPtr = faceVboMap[texture];
                     if (holderPtr == nullptr) {
                         // inserts into map!
-                        holderPtr = std::make_shared<BrushIndexArray>();
+                        holderPtr = std::make_shared<BrushIndexArray>(m_primitiveRestart);
                     }
 
-                    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount);
+                    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount, bounds);
                     info.opaqueFaceIndicesKeys.push_back({texture, key});
 
                     // process all faces with this texture (they'll be consecutive)
@@ -545,9 +820,10 @@ namespace TrenchBroom {
                             addTriIndicesForPolygon(currentDest,
                                                     static_cast<GLuint>(brushVerticesStartIndex +
                                                                         cache.indexOfFirstVertexRelativeToBrush),
-                                                    cache.vertexCount);
+                                                    cache.vertexCount,
+                                                    m_primitiveRestart);
 
-                            currentDest += triIndicesCountForPolygon(cache.vertexCount);
+                            currentDest += triIndicesCountForPolygon(cache.vertexCount, m_primitiveRestart);
                         }
                     }
                     assert(currentDest == (insertDest + opaqueIndexCount));
@@ -571,6 +847,7 @@ namespace TrenchBroom {
             if (m_invalidBrushes.erase(brush) > 0u) {
                 // invalid brushes are not in the VBO, so we can return  now.
                 assert(m_brushInfo.find(brush) == std::end(m_brushInfo));
+                releaseRetainedVertices(brush);
                 return;
             }
 
@@ -578,6 +855,8 @@ namespace TrenchBroom {
         }
 
         void BrushRenderer::removeBrushFromVbo(const Model::Brush* brush) {
+            releaseRetainedVertices(brush);
+
             auto it = m_brushInfo.find(brush);
 
             if (it == std::end(m_brushInfo)) {
@@ -589,31 +868,60 @@ namespace TrenchBroom {
             const BrushInfo& info = it->second;
 
             // update Vbo's
-            m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+            removeIndicesFromVbo(info);
+            deleteVertices(info.chunk, info.vertexHolderKey);
+
+            m_brushInfo.erase(it);
+        }
+
+        void BrushRenderer::removeBrushIndicesFromVbo(const Model::Brush* brush) {
+            auto it = m_brushInfo.find(brush);
+            if (it == std::end(m_brushInfo)) {
+                // either the brush was never uploaded, or its vertices are already retained
+                return;
+            }
+
+            const BrushInfo& info = it->second;
+            removeIndicesFromVbo(info);
+
+            assert(m_retainedVertices.find(brush) == std::end(m_retainedVertices));
+            m_retainedVertices[brush] = RetainedVertices{info.chunk, info.vertexHolderKey, info.vertexGeneration};
+
+            m_brushInfo.erase(it);
+        }
+
+        void BrushRenderer::releaseRetainedVertices(const Model::Brush* brush) {
+            auto it = m_retainedVertices.find(brush);
+            if (it != std::end(m_retainedVertices)) {
+                deleteVertices(it->second.chunk, it->second.vertexHolderKey);
+                m_retainedVertices.erase(it);
+            }
+        }
+
+        void BrushRenderer::removeIndicesFromVbo(const BrushInfo& info) {
+            auto& chunk = *info.chunk;
             if (info.edgeIndicesKey != nullptr) {
-                m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+                chunk.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
             }
 
             for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = chunk.opaqueFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_opaqueFaces->erase(texture);
+                    chunk.opaqueFaces->erase(texture);
                 }
             }
             for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = chunk.transparentFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(transparentKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_transparentFaces->erase(texture);
+                    chunk.transparentFaces->erase(texture);
                 }
             }
-
-            m_brushInfo.erase(it);
         }
     }
 }
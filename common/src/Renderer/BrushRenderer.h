@@ -23,9 +23,14 @@
 #include "Color.h"
 #include "Model/BrushGeometry.h"
 #include "Renderer/AllocationTracker.h"
+#include "Renderer/Camera.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
+#include "Renderer/OcclusionCuller.h"
 
+#include <vecmath/bbox.h>
+
+#include <map>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -118,8 +123,49 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<Filter> m_filter;
 
+            using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+
+            /**
+             * The brushes are grouped into chunks by the grid cell that contains the center of their bounds. Every chunk
+             * has its own vertex and index buffers, so that adding brushes to a chunk only grows and uploads that
+             * chunk's buffers, chunks outside of the view frustum are skipped as a whole, and the buffers of a chunk are
+             * released once its last brush is removed.
+             */
+            struct Chunk {
+                std::shared_ptr<BrushVertexArray> vertexArray;
+                std::shared_ptr<BrushIndexArray> edgeIndices;
+                std::shared_ptr<TextureToBrushIndicesMap> transparentFaces;
+                std::shared_ptr<TextureToBrushIndicesMap> opaqueFaces;
+
+                /**
+                 * Maps the vertex allocation of each brush in this chunk back to the brush, used to update the brush's
+                 * indices when compaction moves its vertices.
+                 */
+                std::unordered_map<const AllocationTracker::Block*, const Model::Brush*> vertexBlockBrushes;
+
+                FaceRenderer opaqueFaceRenderer;
+                FaceRenderer transparentFaceRenderer;
+                IndexedEdgeRenderer edgeRenderer;
+
+                /**
+                 * The union of the bounds of all brushes that were added to this chunk. It does not shrink when brushes
+                 * are removed, which only makes culling the chunk more conservative.
+                 */
+                vm::bbox3f bounds;
+
+                Chunk(bool compactVertices, const vm::bbox3f& bounds);
+                void updateRenderers(const Color& faceColor);
+            };
+            using ChunkKey = std::tuple<int, int, int>;
+            std::map<ChunkKey, std::unique_ptr<Chunk>> m_chunks;
+
             struct BrushInfo {
+                Chunk* chunk;
                 AllocationTracker::Block* vertexHolderKey;
+                /**
+                 * The generation of the brush's BrushRendererBrushCache that the vertices were copied from.
+                 */
+                size_t vertexGeneration;
                 AllocationTracker::Block* edgeIndicesKey;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> opaqueFaceIndicesKeys;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> transparentFaceIndicesKeys;
@@ -130,6 +176,18 @@ namespace TrenchBroom {
              */
             std::unordered_map<const Model::Brush*, BrushInfo> m_brushInfo;
 
+            struct RetainedVertices {
+                Chunk* chunk;
+                AllocationTracker::Block* vertexHolderKey;
+                size_t vertexGeneration;
+            };
+            /**
+             * Vertices of brushes that were invalidated by `invalidate()`. This only requires the filter to be
+             * evaluated again, so validateBrush() reuses these vertices unless the brush's cache was rebuilt in the
+             * meantime, and only the indices are generated again.
+             */
+            std::unordered_map<const Model::Brush*, RetainedVertices> m_retainedVertices;
+
             /**
              * If a brush is in the VBO, it's always valid.
              * If a brush is valid, it might not be in the VBO if it was hidden by the Filter.
@@ -139,16 +197,7 @@ namespace TrenchBroom {
             std::unordered_set<const Model::Brush*> m_allBrushes;
             std::unordered_set<const Model::Brush*> m_invalidBrushes;
 
-            std::shared_ptr<BrushVertexArray> m_vertexArray;
-            std::shared_ptr<BrushIndexArray> m_edgeIndices;
-
-            using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
-            std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
-            std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
-
-            FaceRenderer m_opaqueFaceRenderer;
-            FaceRenderer m_transparentFaceRenderer;
-            IndexedEdgeRenderer m_edgeRenderer;
+            OcclusionCuller m_occlusionCuller;
 
             Color m_faceColor;
             bool m_showEdges;
@@ -162,6 +211,12 @@ namespace TrenchBroom {
             float m_transparencyAlpha;
 
             bool m_showHiddenBrushes;
+            bool m_occlusionCulling;
+            /**
+             * Whether the faces are encoded as triangle fans separated by primitive restart indices instead of as
+             * separate triangles.
+             */
+            bool m_primitiveRestart;
         public:
             template <typename FilterT>
             explicit BrushRenderer(const FilterT& filter) :
@@ -172,7 +227,9 @@ namespace TrenchBroom {
             m_showOccludedEdges(false),
             m_forceTransparent(false),
             m_transparencyAlpha(1.0f),
-            m_showHiddenBrushes(false) {
+            m_showHiddenBrushes(false),
+            m_occlusionCulling(false),
+            m_primitiveRestart(false) {
                 clear();
             }
 
@@ -195,8 +252,8 @@ namespace TrenchBroom {
              *
              * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the Brush object for modification.
              *
-             * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces, and m_opaqueFaces
-             * maps will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
+             * Additionally, calling `invalidate()` guarantees the m_brushInfo map and the face maps of all chunks
+             * will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
              */
             void invalidate();
             void invalidateBrushes(const std::vector<Model::Brush*>& brushes);
@@ -266,21 +323,76 @@ namespace TrenchBroom {
              * Specifies whether or not brushes which are currently hidden should be rendered regardless.
              */
             void setShowHiddenBrushes(bool showHiddenBrushes);
+
+            /**
+             * Specifies whether or not opaque faces and edges of brushes that are hidden behind other geometry should be
+             * culled in the 3D view using occlusion queries.
+             */
+            void setOcclusionCulling(bool occlusionCulling);
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
-            void renderOpaqueFaces(RenderBatch& renderBatch);
-            void renderTransparentFaces(RenderBatch& renderBatch);
-            void renderEdges(RenderBatch& renderBatch);
+            /**
+             * Restricts the rendering of the given faces to the brushes that intersect the given frustum and that are not
+             * reported as occluded by the given occlusion culler, if any. If `multiDraw` is true, the remaining faces of
+             * each texture are submitted with a single draw call.
+             */
+            static void cull(TextureToBrushIndicesMap& faces, const Camera::Frustum& frustum, OcclusionCuller* occlusionCuller, bool multiDraw);
+
+            /**
+             * Returns whether faces should be encoded as triangle fans with primitive restart, which requires OpenGL 3.1.
+             */
+            static bool usePrimitiveRestart();
+            void renderOpaqueFaces(Chunk& chunk, RenderBatch& renderBatch);
+            void renderTransparentFaces(Chunk& chunk, RenderBatch& renderBatch);
+            void renderEdges(Chunk& chunk, RenderBatch& renderBatch);
 
         public:
             /**
-             * Only exposed for benchmarking.
+             * Validates all invalid brushes. Only exposed for benchmarking.
              */
             void validate();
+
+            /**
+             * Validates invalid brushes until a time budget is used up. The brushes that remain invalid are not rendered
+             * until a later call validates them, so callers should check valid() afterwards and render again if
+             * necessary.
+             */
+            void validateIncrementally();
+        private:
+            /**
+             * Validates up to the given number of invalid brushes.
+             */
+            void validateBrushes(size_t count);
+        public:
+
+            /**
+             * Returns the fragmentation statistics of the vertex buffers of all chunks combined for monitoring.
+             */
+            AllocationTracker::FragmentationStats vertexFragmentationStats() const;
         private:
+            /**
+             * Relocates a bounded number of vertices and indices to reduce the fragmentation of the buffers, so that
+             * they need to grow and be uploaded again less often. Moved vertices and indices are uploaded with the next
+             * render.
+             */
+            void compact();
+            void compact(Chunk& chunk);
+            static void compact(TextureToBrushIndicesMap& faces);
+            void rebaseIndices(const BrushInfo& info, GLuint oldBaseIndex, GLuint newBaseIndex);
+
+            /**
+             * Returns the chunk that a brush with the given bounds belongs to, creating it if necessary.
+             */
+            Chunk& chunkFor(const vm::bbox3f& bounds);
+
+            /**
+             * Removes the given vertex allocation from its chunk, and the chunk itself if it has no vertices left.
+             */
+            void deleteVertices(Chunk* chunk, AllocationTracker::Block* vertexHolderKey);
+
             bool shouldDrawFaceInTransparentPass(const Model::Brush* brush, const Model::BrushFace* face) const;
             void validateBrush(const Model::Brush* brush);
             void addBrush(const Model::Brush* brush);
@@ -292,6 +404,13 @@ namespace TrenchBroom {
              * The brush's "valid" state is not touched inside here, but the m_brushInfo is updated.
              */
             void removeBrushFromVbo(const Model::Brush* brush);
+
+            /**
+             * Like removeBrushFromVbo(), but keeps the brush's vertices in m_retainedVertices.
+             */
+            void removeBrushIndicesFromVbo(const Model::Brush* brush);
+            void removeIndicesFromVbo(const BrushInfo& info);
+            void releaseRetainedVertices(const Model::Brush* brush);
         private:
             BrushRenderer(const BrushRenderer& other);
             BrushRenderer& operator=(const BrushRenderer& other);
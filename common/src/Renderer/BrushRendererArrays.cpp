@@ -19,9 +19,11 @@
 
 #include "Renderer/BrushRendererArrays.h"
 
+#include "Renderer/OcclusionCuller.h"
+
 #include <cassert>
 #include <algorithm>
-#include <cstring>
+#include <cmath>
 
 namespace TrenchBroom {
     // BrushIndexArray
@@ -74,9 +76,9 @@ namespace TrenchBroom {
         IndexHolder::IndexHolder(std::vector<Index> &elements)
                 : VboHolder<Index>(elements) {}
 
-        void IndexHolder::zeroRange(const size_t offsetWithinBlock, const size_t count) {
+        void IndexHolder::fillRange(const size_t offsetWithinBlock, const size_t count, const Index value) {
             Index* dest = getPointerToWriteElementsTo(offsetWithinBlock, count);
-            std::memset(dest, 0, count * sizeof(Index));
+            std::fill_n(dest, count, value);
         }
 
         void IndexHolder::render(const PrimType primType, const size_t offset, size_t count) const {
@@ -86,6 +88,20 @@ namespace TrenchBroom {
             glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
         }
 
+        void IndexHolder::render(const PrimType primType, const std::vector<std::pair<size_t, size_t>>& ranges) const {
+            std::vector<GLsizei> renderCounts;
+            std::vector<const GLvoid*> renderOffsets;
+            renderCounts.reserve(ranges.size());
+            renderOffsets.reserve(ranges.size());
+
+            for (const auto& [offset, count] : ranges) {
+                renderCounts.push_back(static_cast<GLsizei>(count));
+                renderOffsets.push_back(reinterpret_cast<const GLvoid*>(m_vbo->offset() + sizeof(Index) * offset));
+            }
+
+            glAssert(glMultiDrawElements(toGL(primType), renderCounts.data(), glType<Index>(), renderOffsets.data(), static_cast<GLsizei>(renderCounts.size())));
+        }
+
         std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements) {
             return std::make_shared<IndexHolder>(elements);
         }
@@ -94,29 +110,45 @@ namespace TrenchBroom {
 
         // BrushIndexArray
 
-        BrushIndexArray::BrushIndexArray() : m_indexHolder(),
-                                             m_allocationTracker(0) {}
+        BrushIndexArray::BrushIndexArray(const bool primitiveRestart) : m_indexHolder(),
+                                                                        m_allocationTracker(0),
+                                                                        m_sortedBlocksValid(true),
+                                                                        m_culled(false),
+                                                                        m_multiDraw(false),
+                                                                        m_primitiveRestart(primitiveRestart) {}
+
+        bool BrushIndexArray::primitiveRestart() const {
+            return m_primitiveRestart;
+        }
+
+        IndexHolder::Index BrushIndexArray::clearIndex() const {
+            return m_primitiveRestart ? IndexHolder::PrimitiveRestartIndex : 0u;
+        }
 
         bool BrushIndexArray::hasValidIndices() const {
             return m_allocationTracker.hasAllocations();
         }
 
-        std::pair<AllocationTracker::Block*, GLuint*> BrushIndexArray::getPointerToInsertElementsAt(const size_t elementCount) {
+        std::pair<AllocationTracker::Block*, GLuint*> BrushIndexArray::getPointerToInsertElementsAt(const size_t elementCount, const vm::bbox3f& bounds) {
             auto block = m_allocationTracker.allocate(elementCount);
-            if (block != nullptr) {
-                GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(block->pos, elementCount);
-                return {block, dest};
+            if (block == nullptr) {
+                // retry
+                const size_t oldSize = m_allocationTracker.capacity();
+                const size_t newSize = std::max(2 * oldSize, oldSize + elementCount);
+                m_allocationTracker.expand(newSize);
+                m_indexHolder.resize(newSize);
+                if (m_primitiveRestart) {
+                    // unallocated indices must not join the primitives of the following allocations
+                    m_indexHolder.fillRange(oldSize, newSize - oldSize, IndexHolder::PrimitiveRestartIndex);
+                }
+
+                // insert again
+                block = m_allocationTracker.allocate(elementCount);
+                assert(block != nullptr);
             }
 
-            // retry
-            const size_t newSize = std::max(2 * m_allocationTracker.capacity(),
-                                            m_allocationTracker.capacity() + elementCount);
-            m_allocationTracker.expand(newSize);
-            m_indexHolder.resize(newSize);
-
-            // insert again
-            block = m_allocationTracker.allocate(elementCount);
-            assert(block != nullptr);
+            m_blockBounds[block] = bounds;
+            m_sortedBlocksValid = false;
 
             GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(block->pos, elementCount);
             return {block, dest};
@@ -125,14 +157,99 @@ namespace TrenchBroom {
         void BrushIndexArray::zeroElementsWithKey(AllocationTracker::Block* key) {
             const auto pos = key->pos;
             const auto size = key->size;
+            m_blockBounds.erase(key);
+            m_sortedBlocksValid = false;
             m_allocationTracker.free(key);
 
-            m_indexHolder.zeroRange(pos, size);
+            m_indexHolder.fillRange(pos, size, clearIndex());
+        }
+
+        void BrushIndexArray::rebaseElementsWithKey(const AllocationTracker::Block* key, const GLuint oldBaseIndex, const GLuint newBaseIndex) {
+            GLuint* indices = m_indexHolder.getPointerToWriteElementsTo(key->pos, key->size);
+            for (size_t i = 0; i < key->size; ++i) {
+                if (indices[i] != IndexHolder::PrimitiveRestartIndex) {
+                    indices[i] = indices[i] - oldBaseIndex + newBaseIndex;
+                }
+            }
+        }
+
+        size_t BrushIndexArray::compact(const size_t budget) {
+            // the relative order of the allocations is preserved, so m_sortedBlocks remains valid
+            return m_allocationTracker.compact(budget, [&](const AllocationTracker::Block* block, const size_t oldPos) {
+                m_indexHolder.moveElements(oldPos, block->pos, block->size);
+
+                // zero the part of the old range that the moved indices don't cover anymore
+                const auto vacatedPos = std::max(oldPos, block->pos + block->size);
+                m_indexHolder.fillRange(vacatedPos, oldPos + block->size - vacatedPos, clearIndex());
+            });
+        }
+
+        AllocationTracker::FragmentationStats BrushIndexArray::fragmentationStats() const {
+            return m_allocationTracker.fragmentationStats();
+        }
+
+        static bool smallerThan(const vm::bbox3f& bounds, const float minSize) {
+            if (minSize <= 0.0f) {
+                return false;
+            }
+            const auto size = bounds.size();
+            return std::max({ size.x(), size.y(), size.z() }) < minSize;
+        }
+
+        void BrushIndexArray::cull(const Camera::Frustum& frustum, OcclusionCuller* occlusionCuller, const bool multiDraw, const float minSize) {
+            if (!m_sortedBlocksValid) {
+                m_sortedBlocks.assign(std::begin(m_blockBounds), std::end(m_blockBounds));
+                std::sort(std::begin(m_sortedBlocks), std::end(m_sortedBlocks), [](const BlockBounds& lhs, const BlockBounds& rhs) {
+                    return lhs.first->pos < rhs.first->pos;
+                });
+                m_sortedBlocksValid = true;
+            }
+
+            m_renderRanges.clear();
+            m_culled = true;
+            m_multiDraw = multiDraw;
+
+            // Consecutive visible blocks are merged even if there is free space between them, since freed indices are
+            // zeroed or set to the primitive restart index and therefore only form degenerate primitives.
+            bool inRange = false;
+            for (const auto& [block, bounds] : m_sortedBlocks) {
+                if (!frustum.intersects(bounds) || (occlusionCuller != nullptr && !occlusionCuller->visible(bounds)) || smallerThan(bounds, minSize)) {
+                    inRange = false;
+                } else if (inRange) {
+                    auto& range = m_renderRanges.back();
+                    range.second = block->pos + block->size - range.first;
+                } else {
+                    m_renderRanges.emplace_back(block->pos, block->size);
+                    inRange = true;
+                }
+            }
+        }
+
+        void BrushIndexArray::resetCulling() {
+            m_renderRanges.clear();
+            m_culled = false;
         }
 
         void BrushIndexArray::render(const PrimType primType) const {
             assert(m_indexHolder.prepared());
-            m_indexHolder.render(primType, 0, m_indexHolder.size());
+            if (m_primitiveRestart) {
+                glAssert(glEnable(GL_PRIMITIVE_RESTART));
+                glAssert(glPrimitiveRestartIndex(IndexHolder::PrimitiveRestartIndex));
+            }
+
+            if (!m_culled) {
+                m_indexHolder.render(primType, 0, m_indexHolder.size());
+            } else if (m_multiDraw && m_renderRanges.size() > 1u) {
+                m_indexHolder.render(primType, m_renderRanges);
+            } else {
+                for (const auto& [offset, count] : m_renderRanges) {
+                    m_indexHolder.render(primType, offset, count);
+                }
+            }
+
+            if (m_primitiveRestart) {
+                glAssert(glDisable(GL_PRIMITIVE_RESTART));
+            }
         }
 
         bool BrushIndexArray::prepared() const {
@@ -154,28 +271,57 @@ namespace TrenchBroom {
 
         // BrushVertexArray
 
-        BrushVertexArray::BrushVertexArray() : m_vertexHolder(),
-                                               m_allocationTracker(0) {}
+        BrushVertexArray::BrushVertexArray(const bool compactVertices) : m_compactVertices(compactVertices),
+                                                                        m_vertexHolder(),
+                                                                        m_compactVertexHolder(),
+                                                                        m_allocationTracker(0) {}
+
+        bool BrushVertexArray::compactVertices() const {
+            return m_compactVertices;
+        }
+
+        static GLbyte packNormalComponent(const float value) {
+            return static_cast<GLbyte>(std::round(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+        }
+
+        AllocationTracker::Block* BrushVertexArray::insertVertices(const std::vector<Vertex>& vertices) {
+            const size_t vertexCount = vertices.size();
 
-        std::pair<AllocationTracker::Block*, BrushVertexArray::Vertex*> BrushVertexArray::getPointerToInsertVerticesAt(const size_t vertexCount) {
             auto block = m_allocationTracker.allocate(vertexCount);
-            if (block != nullptr) {
-                Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
-                return {block, dest};
+            if (block == nullptr) {
+                // retry
+                const size_t newSize = std::max(2 * m_allocationTracker.capacity(),
+                                                m_allocationTracker.capacity() + vertexCount);
+                m_allocationTracker.expand(newSize);
+                if (m_compactVertices) {
+                    m_compactVertexHolder.resize(newSize);
+                } else {
+                    m_vertexHolder.resize(newSize);
+                }
+
+                // insert again
+                block = m_allocationTracker.allocate(vertexCount);
+                assert(block != nullptr);
             }
 
-            // retry
-            const size_t newSize = std::max(2 * m_allocationTracker.capacity(),
-                                            m_allocationTracker.capacity() + vertexCount);
-            m_allocationTracker.expand(newSize);
-            m_vertexHolder.resize(newSize);
-
-            // insert again
-            block = m_allocationTracker.allocate(vertexCount);
-            assert(block != nullptr);
+            if (m_compactVertices) {
+                CompactVertex* dest = m_compactVertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
+                for (size_t i = 0; i < vertexCount; ++i) {
+                    const auto& position = getVertexComponent<0>(vertices[i]);
+                    const auto& normal = getVertexComponent<1>(vertices[i]);
+                    const auto& texCoords = getVertexComponent<2>(vertices[i]);
+
+                    const auto packedNormal = vm::vec<GLbyte, 3>(packNormalComponent(normal.x()),
+                                                                 packNormalComponent(normal.y()),
+                                                                 packNormalComponent(normal.z()));
+                    dest[i] = CompactVertex(position, texCoords, packedNormal);
+                }
+            } else {
+                Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
+                std::memcpy(dest, vertices.data(), vertexCount * sizeof(Vertex));
+            }
 
-            Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
-            return {block, dest};
+            return block;
         }
 
         void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key) {
@@ -187,21 +333,52 @@ namespace TrenchBroom {
             // us to re-use the space later
         }
 
+        size_t BrushVertexArray::compact(const size_t budget, const AllocationTracker::BlockMovedCallback& blockMoved) {
+            return m_allocationTracker.compact(budget, [&](const AllocationTracker::Block* block, const size_t oldPos) {
+                if (m_compactVertices) {
+                    m_compactVertexHolder.moveElements(oldPos, block->pos, block->size);
+                } else {
+                    m_vertexHolder.moveElements(oldPos, block->pos, block->size);
+                }
+                blockMoved(block, oldPos);
+            });
+        }
+
+        AllocationTracker::FragmentationStats BrushVertexArray::fragmentationStats() const {
+            return m_allocationTracker.fragmentationStats();
+        }
+
         bool BrushVertexArray::setupVertices() {
-            return m_vertexHolder.setupVertices();
+            if (m_compactVertices) {
+                return m_compactVertexHolder.setupVertices();
+            } else {
+                return m_vertexHolder.setupVertices();
+            }
         }
 
         void BrushVertexArray::cleanupVertices() {
-            m_vertexHolder.cleanupVertices();
+            if (m_compactVertices) {
+                m_compactVertexHolder.cleanupVertices();
+            } else {
+                m_vertexHolder.cleanupVertices();
+            }
         }
 
         bool BrushVertexArray::prepared() const {
-            return m_vertexHolder.prepared();
+            if (m_compactVertices) {
+                return m_compactVertexHolder.prepared();
+            } else {
+                return m_vertexHolder.prepared();
+            }
         }
 
         void BrushVertexArray::prepare(VboManager& vboManager) {
-            m_vertexHolder.prepare(vboManager);
-            assert(m_vertexHolder.prepared());
+            if (m_compactVertices) {
+                m_compactVertexHolder.prepare(vboManager);
+            } else {
+                m_vertexHolder.prepare(vboManager);
+            }
+            assert(prepared());
         }
     }
 }
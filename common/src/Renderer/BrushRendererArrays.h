@@ -22,21 +22,29 @@
 
 #include "Ensure.h"
 #include "Renderer/AllocationTracker.h"
+#include "Renderer/Camera.h"
 #include "Renderer/GL.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
 #include "Renderer/VboManager.h"
 #include "Renderer/Vbo.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
+        class OcclusionCuller;
+
         struct DirtyRangeTracker {
             size_t m_dirtyPos;
             size_t m_dirtySize;
@@ -63,8 +71,8 @@ namespace TrenchBroom {
          * Non-copyable; meant to be held in a std::shared_ptr.
          * Able to be resized, and handles copying edits made in the local std::vector to the VBO.
          *
-         * Currently uses a single range to track the modified region which might upload much more than necessary;
-         * it might be worth mapping the VBO and editing it directly.
+         * Currently uses a single range to track the modified region which might upload much more than necessary.
+         * The VBO is allocated with VboUsage::Streaming, so that the uploads do not wait for pending draw calls.
          */
         template<typename T>
         class VboHolder {
@@ -90,7 +98,7 @@ namespace TrenchBroom {
                 }
                 assert(m_vbo == nullptr);
 
-                m_vbo = m_vboManager->allocateVbo(m_type, m_snapshot.size() * sizeof(T), VboUsage::DynamicDraw);
+                m_vbo = m_vboManager->allocateVbo(m_type, m_snapshot.size() * sizeof(T), VboUsage::Streaming);
                 assert(m_vbo != nullptr);
 
                 m_vbo->writeElements(0, m_snapshot);
@@ -149,6 +157,21 @@ namespace TrenchBroom {
                 return m_snapshot.data() + offsetWithinBlock;
             }
 
+            /**
+             * Moves the given range of elements to a lower offset and marks the destination range dirty. The
+             * ranges may overlap.
+             */
+            void moveElements(const size_t fromOffset, const size_t toOffset, const size_t elementCount) {
+                assert(toOffset <= fromOffset);
+                assert(fromOffset + elementCount <= m_snapshot.size());
+
+                m_dirtyRange.markDirty(toOffset, elementCount);
+
+                const auto first = std::next(std::begin(m_snapshot), static_cast<std::ptrdiff_t>(fromOffset));
+                const auto last = std::next(first, static_cast<std::ptrdiff_t>(elementCount));
+                std::copy(first, last, std::next(std::begin(m_snapshot), static_cast<std::ptrdiff_t>(toOffset)));
+            }
+
             bool prepared() const {
                 // NOTE: this returns true if the capacity is 0
                 return m_dirtyRange.clean();
@@ -215,13 +238,22 @@ namespace TrenchBroom {
         public:
             using Index = GLuint;
 
+            /**
+             * The index that ends the current primitive if primitive restart is enabled.
+             */
+            static constexpr Index PrimitiveRestartIndex = 0xFFFFFFFFu;
+
             IndexHolder();
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
              */
             explicit IndexHolder(std::vector<Index>& elements);
-            void zeroRange(size_t offsetWithinBlock, size_t count);
+            void fillRange(size_t offsetWithinBlock, size_t count, Index value);
             void render(PrimType primType, size_t offset, size_t count) const;
+            /**
+             * Renders the given ranges of indices, given as pairs of offset and count, with a single draw call.
+             */
+            void render(PrimType primType, const std::vector<std::pair<size_t, size_t>>& ranges) const;
 
             static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
         };
@@ -229,13 +261,46 @@ namespace TrenchBroom {
         /**
          * VboBlock handle that supports dynamically allocating ranges of indices, grows as needed, and also
          * supports freeing allocations and zeroing the corresponding indicies so they become degenerate primitives.
+         *
+         * If primitive restart is enabled, the allocations may contain IndexHolder::PrimitiveRestartIndex to separate
+         * primitives such as triangle fans, and freed ranges are filled with it instead of zeroes, so that they never
+         * join the primitives of the adjacent allocations.
          */
         class BrushIndexArray {
         private:
+            using BlockBounds = std::pair<const AllocationTracker::Block*, vm::bbox3f>;
+
             IndexHolder m_indexHolder;
             AllocationTracker m_allocationTracker;
+
+            /**
+             * The bounds of the brush that each allocation belongs to.
+             */
+            std::unordered_map<const AllocationTracker::Block*, vm::bbox3f> m_blockBounds;
+            /**
+             * The allocations sorted by their position, rebuilt from m_blockBounds by cull() whenever allocations were
+             * made or freed since it was last built.
+             */
+            std::vector<BlockBounds> m_sortedBlocks;
+            bool m_sortedBlocksValid;
+
+            /**
+             * The ranges of indices to render as pairs of offset and count, only used if m_culled is true.
+             */
+            std::vector<std::pair<size_t, size_t>> m_renderRanges;
+            bool m_culled;
+            /**
+             * Whether the ranges are submitted with a single glMultiDrawElements call instead of one glDrawElements
+             * call per range.
+             */
+            bool m_multiDraw;
+            bool m_primitiveRestart;
+
+            IndexHolder::Index clearIndex() const;
         public:
-            BrushIndexArray();
+            explicit BrushIndexArray(bool primitiveRestart = false);
+
+            bool primitiveRestart() const;
 
             /**
              * Returns true if there are any valid indices to render. Ranges zeroed by zeroElementsWithKey() do not count.
@@ -249,14 +314,49 @@ namespace TrenchBroom {
              *
              * Returns a AllocationTracker::Block pointer which can be used later in a call to zeroElementsWithKey(),
              * and also a GLuint pointer where the caller should write `elementCount` GLuint's.
+             *
+             * The given bounds are the bounds of the primitives that the indices refer to, and are used for culling.
              */
-            std::pair<AllocationTracker::Block*, GLuint*> getPointerToInsertElementsAt(size_t elementCount);
+            std::pair<AllocationTracker::Block*, GLuint*> getPointerToInsertElementsAt(size_t elementCount, const vm::bbox3f& bounds);
 
             /**
              * Deletes indices for the given brush and marks the allocation as free.
              */
             void zeroElementsWithKey(AllocationTracker::Block* key);
 
+            /**
+             * Updates the indices for the given allocation after the vertices they refer to were moved from
+             * `oldBaseIndex` to `newBaseIndex`. Primitive restart indices are left unchanged.
+             */
+            void rebaseElementsWithKey(const AllocationTracker::Block* key, GLuint oldBaseIndex, GLuint newBaseIndex);
+
+            /**
+             * Moves allocations towards the start of the index buffer, see AllocationTracker::compact(). The vacated
+             * indices are zeroed.
+             *
+             * @return the number of indices that were moved
+             */
+            size_t compact(size_t budget);
+            AllocationTracker::FragmentationStats fragmentationStats() const;
+
+            /**
+             * Restricts the following calls to render() to the allocations whose bounds intersect the given frustum.
+             * Adjacent visible allocations are merged into a single range of indices.
+             *
+             * If an occlusion culler is given, allocations that it reports as occluded are skipped as well.
+             *
+             * If `minSize` is positive, allocations whose bounds are smaller than `minSize` along every axis are skipped.
+             *
+             * If `multiDraw` is true, the remaining ranges are submitted with a single draw call, otherwise, each range
+             * is drawn separately.
+             */
+            void cull(const Camera::Frustum& frustum, OcclusionCuller* occlusionCuller, bool multiDraw, float minSize = 0.0f);
+
+            /**
+             * Makes the following calls to render() render all indices again.
+             */
+            void resetCulling();
+
             void render(const PrimType primType) const;
             bool prepared() const;
             void prepare(VboManager& vboManager);
@@ -309,28 +409,45 @@ namespace TrenchBroom {
          * Same as BrushIndexArray but for vertices instead of indices.
          * The only difference is deleteVerticesWithKey() doesn't need to zero out
          * the deleted memory in the VBO, while BrushIndexArray's does.
+         *
+         * The vertices can optionally be stored in a compact format with the normals packed into bytes, which
+         * reduces the size of each vertex from 32 to 24 bytes.
          */
         class BrushVertexArray {
         private:
             using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
+            using CompactVertex = Renderer::GLVertexTypes::P3T2NB::Vertex;
 
+            bool m_compactVertices;
             VertexHolder<Vertex> m_vertexHolder;
+            VertexHolder<CompactVertex> m_compactVertexHolder;
             AllocationTracker m_allocationTracker;
         public:
-            BrushVertexArray();
+            explicit BrushVertexArray(bool compactVertices = false);
+
+            bool compactVertices() const;
 
             /**
-             * Call this to request writing the given number of vertices.
+             * Inserts the given vertices, converting them to the compact format if necessary.
              *
              * The VboBlock will be expanded if needed to accommodate the allocation.
              *
-             * Returns a AllocationTracker::Block pointer which can be used later in a call to deleteVerticesWithKey(),
-             * and also a Vertex pointer where the caller should write `elementCount` Vertex objects.
+             * Returns a AllocationTracker::Block pointer which can be used later in a call to deleteVerticesWithKey().
              */
-            std::pair<AllocationTracker::Block*, Vertex*> getPointerToInsertVerticesAt(size_t vertexCount);
+            AllocationTracker::Block* insertVertices(const std::vector<Vertex>& vertices);
 
             void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+            /**
+             * Moves allocations towards the start of the vertex buffer, see AllocationTracker::compact(). The given
+             * callback is called for every moved allocation so that the caller can update the indices that refer to
+             * the moved vertices.
+             *
+             * @return the number of vertices that were moved
+             */
+            size_t compact(size_t budget, const AllocationTracker::BlockMovedCallback& blockMoved);
+            AllocationTracker::FragmentationStats fragmentationStats() const;
+
             // setting up GL attributes
             bool setupVertices();
             void cleanupVertices();
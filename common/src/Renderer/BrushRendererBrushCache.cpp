@@ -25,6 +25,7 @@
 #include "Model/Polyhedron.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -45,7 +46,8 @@ namespace TrenchBroom {
                   vertexIndex2RelativeToBrush(i_vertexIndex2RelativeToBrush) {}
 
         BrushRendererBrushCache::BrushRendererBrushCache()
-                : m_rendererCacheValid(false) {}
+                : m_rendererCacheValid(false),
+                  m_generation(0u) {}
 
         void BrushRendererBrushCache::invalidateVertexCache() {
             m_rendererCacheValid = false;
@@ -67,12 +69,25 @@ namespace TrenchBroom {
             m_cachedFacesSortedByTexture.clear();
             m_cachedFacesSortedByTexture.reserve(brush->faceCount());
 
+            // reused for every face to compute the texture coordinates of all of its vertices at once
+            std::vector<vm::vec3> positions;
+            std::vector<vm::vec2f> texCoords;
+
             for (Model::BrushFace* face : brush->faces()) {
                 const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
 
                 // The boundary is in CCW order, but the renderer expects CW order:
                 auto& boundary = face->geometry()->boundary();
+
+                positions.clear();
                 for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it) {
+                    positions.push_back((*it)->origin()->position());
+                }
+                face->textureCoords(positions, texCoords);
+
+                const auto normal = vm::vec3f(face->boundary().normal);
+                size_t i = 0;
+                for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it, ++i) {
                     Model::BrushHalfEdge* current = *it;
                     Model::BrushVertex* vertex = current->origin();
 
@@ -83,10 +98,7 @@ namespace TrenchBroom {
                     const auto currentIndex = m_cachedVertices.size();
                     vertex->setPayload(static_cast<GLuint>(currentIndex));
 
-                    const auto& position = vertex->position();
-                    m_cachedVertices.emplace_back(vm::vec3f(position), vm::vec3f(face->boundary().normal), face->textureCoords(position));
-
-                    current = current->previous();
+                    m_cachedVertices.emplace_back(vm::vec3f(positions[i]), normal, texCoords[i]);
                 }
 
                 // face cache
@@ -115,6 +127,11 @@ namespace TrenchBroom {
             }
 
             m_rendererCacheValid = true;
+            ++m_generation;
+        }
+
+        size_t BrushRendererBrushCache::generation() const {
+            return m_generation;
         }
 
         const std::vector<BrushRendererBrushCache::Vertex>& BrushRendererBrushCache::cachedVertices() const {
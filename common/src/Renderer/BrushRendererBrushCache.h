@@ -67,6 +67,7 @@ namespace TrenchBroom {
             std::vector<CachedEdge> m_cachedEdges;
             std::vector<CachedFace> m_cachedFacesSortedByTexture;
             bool m_rendererCacheValid;
+            size_t m_generation;
 
         public:
             BrushRendererBrushCache();
@@ -85,6 +86,12 @@ namespace TrenchBroom {
              */
             void validateVertexCache(const Model::Brush* brush);
 
+            /**
+             * Returns a number that is incremented whenever the cache is rebuilt. BrushRenderer uses this to tell
+             * whether the vertices it has uploaded for the brush are still up to date.
+             */
+            size_t generation() const;
+
             /**
              * Returns all vertices for all faces of the brush.
              */
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/ray.h>
 #include <vecmath/distance.h>
 #include <vecmath/intersection.h>
@@ -47,6 +48,20 @@ namespace TrenchBroom {
             return !(*this == other);
         }
 
+        bool Camera::Frustum::intersects(const vm::bbox3f& bounds) const {
+            for (const auto& plane : planes) {
+                // the box is outside if even its corner that is farthest inside is in front of the plane
+                const auto corner = vm::vec3f(
+                    plane.normal.x() > 0.0f ? bounds.min.x() : bounds.max.x(),
+                    plane.normal.y() > 0.0f ? bounds.min.y() : bounds.max.y(),
+                    plane.normal.z() > 0.0f ? bounds.min.z() : bounds.max.z());
+                if (plane.point_distance(corner) > 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         const float Camera::DefaultPointDistance = 256.0f;
 
         Camera::~Camera() {}
@@ -149,7 +164,20 @@ namespace TrenchBroom {
         }
 
         void Camera::frustumPlanes(vm::plane3f& top, vm::plane3f& right, vm::plane3f& bottom, vm::plane3f& left) const {
-            doComputeFrustumPlanes(top, right, bottom, left);
+            if (!m_valid)
+                validateMatrices();
+
+            top = m_frustum.planes[0];
+            right = m_frustum.planes[1];
+            bottom = m_frustum.planes[2];
+            left = m_frustum.planes[3];
+        }
+
+        Camera::Frustum Camera::frustum() const {
+            if (!m_valid)
+                validateMatrices();
+
+            return m_frustum;
         }
 
         vm::ray3f Camera::viewRay() const {
@@ -200,6 +228,18 @@ namespace TrenchBroom {
             return win;
         }
 
+        std::vector<vm::vec3f> Camera::project(const std::vector<vm::vec3f>& points) const {
+            if (!m_valid)
+                validateMatrices();
+
+            std::vector<vm::vec3f> result;
+            result.reserve(points.size());
+            for (const auto& point : points) {
+                result.push_back(project(point));
+            }
+            return result;
+        }
+
         vm::vec3f Camera::unproject(const vm::vec3f& point) const {
             return unproject(point.x(), point.y(), point.z());
         }
@@ -403,6 +443,8 @@ namespace TrenchBroom {
             const auto [invertible, inverse] = vm::invert(m_matrix);
             assert(invertible); unused(invertible);
             m_inverseMatrix = inverse;
+
+            doComputeFrustumPlanes(m_frustum.planes[0], m_frustum.planes[1], m_frustum.planes[2], m_frustum.planes[3]);
             m_valid = true;
         }
 
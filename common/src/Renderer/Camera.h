@@ -26,8 +26,11 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 #include <vecmath/mat.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 
+#include <vector>
+
 namespace TrenchBroom {
     class Color;
 
@@ -63,6 +66,21 @@ namespace TrenchBroom {
                     return width < height ? width : height;
                 }
             };
+
+            /**
+             * The top, right, bottom and left planes of a camera's view frustum. The plane normals point out of the
+             * frustum.
+             */
+            struct Frustum {
+                vm::plane3f planes[4];
+
+                /**
+                 * Indicates whether the given box is at least partially inside of this frustum. The test is
+                 * conservative, that is, it may return true for some boxes that are outside of this frustum, but it
+                 * never returns false for a box that is at least partially inside of this frustum.
+                 */
+                bool intersects(const vm::bbox3f& bounds) const;
+            };
         public:
             static const float DefaultPointDistance;
         private:
@@ -79,6 +97,7 @@ namespace TrenchBroom {
             mutable vm::mat4x4f m_viewMatrix;
             mutable vm::mat4x4f m_matrix;
             mutable vm::mat4x4f m_inverseMatrix;
+            mutable Frustum m_frustum;
         protected:
             typedef enum {
                 Projection_Orthographic,
@@ -108,6 +127,7 @@ namespace TrenchBroom {
             const vm::mat4x4f orthogonalBillboardMatrix() const;
             const vm::mat4x4f verticalBillboardMatrix() const;
             void frustumPlanes(vm::plane3f& topPlane, vm::plane3f& rightPlane, vm::plane3f& bottomPlane, vm::plane3f& leftPlane) const;
+            Frustum frustum() const;
 
             vm::ray3f viewRay() const;
             vm::ray3f pickRay(int x, int y) const;
@@ -125,6 +145,12 @@ namespace TrenchBroom {
 
             float perspectiveScalingFactor(const vm::vec3f& position) const;
             vm::vec3f project(const vm::vec3f& point) const;
+
+            /**
+             * Projects each of the given points. This is equivalent to calling project for each point, but validates
+             * the camera matrices only once.
+             */
+            std::vector<vm::vec3f> project(const std::vector<vm::vec3f>& points) const;
             vm::vec3f unproject(const vm::vec3f& point) const;
             vm::vec3f unproject(float x, float y, float depth) const;
 
@@ -34,21 +34,33 @@ namespace TrenchBroom {
         width(i_width),
         offset(i_offset),
         onTop(i_onTop),
-        useColor(false) {}
+        useColor(false),
+        showOccluded(false) {}
 
         EdgeRenderer::Params::Params(const float i_width, const double i_offset,const  bool i_onTop, const Color& i_color) :
         width(i_width),
         offset(i_offset),
         onTop(i_onTop),
         useColor(true),
-        color(i_color) {}
+        color(i_color),
+        showOccluded(false) {}
 
         EdgeRenderer::Params::Params(const float i_width, const double i_offset, const bool i_onTop, const bool i_useColor, const Color& i_color) :
         width(i_width),
         offset(i_offset),
         onTop(i_onTop),
         useColor(i_useColor),
-        color(i_color) {}
+        color(i_color),
+        showOccluded(false) {}
+
+        EdgeRenderer::Params::Params(const float i_width, const double i_offset, const bool i_useColor, const Color& i_color, const Color& i_occludedColor) :
+        width(i_width),
+        offset(i_offset),
+        onTop(false),
+        useColor(i_useColor),
+        color(i_color),
+        showOccluded(true),
+        occludedColor(i_occludedColor) {}
 
         EdgeRenderer::RenderBase::RenderBase(const Params& params) :
         m_params(params) {}
@@ -65,13 +77,28 @@ namespace TrenchBroom {
             if (m_params.onTop)
                 glAssert(glDisable(GL_DEPTH_TEST))
 
-            if (m_params.useColor) {
-                ActiveShader shader(renderContext.shaderManager(), Shaders::VaryingPUniformCShader);
-                shader.set("Color", m_params.color);
-                doRenderVertices(renderContext);
-            } else {
-                ActiveShader shader(renderContext.shaderManager(), Shaders::VaryingPCShader);
+            {
+                ActiveShader shader(renderContext.shaderManager(), m_params.useColor ? Shaders::VaryingPUniformCShader : Shaders::VaryingPCShader);
+                doSetupVertices();
+
+                if (m_params.showOccluded) {
+                    // only the fragments behind the depth buffer pass, and they must not hide the visible edges
+                    glAssert(glDepthFunc(GL_GREATER))
+                    glAssert(glDepthMask(GL_FALSE))
+                    if (m_params.useColor) {
+                        shader.set("Color", m_params.occludedColor);
+                    }
+                    doRenderVertices(renderContext);
+                    glAssert(glDepthMask(GL_TRUE))
+                    glAssert(glDepthFunc(GL_LEQUAL))
+                }
+
+                if (m_params.useColor) {
+                    shader.set("Color", m_params.color);
+                }
                 doRenderVertices(renderContext);
+
+                doCleanupVertices();
             }
 
             if (m_params.onTop)
@@ -114,6 +141,10 @@ namespace TrenchBroom {
             doRender(renderBatch, Params(width, offset, onTop, useColor, color));
         }
 
+        void EdgeRenderer::renderWithOccluded(RenderBatch& renderBatch, const bool useColor, const Color& color, const Color& occludedColor, const float width, const double offset) {
+            doRender(renderBatch, Params(width, offset, useColor, color, occludedColor));
+        }
+
         DirectEdgeRenderer::Render::Render(const EdgeRenderer::Params& params, VertexArray& vertexArray, IndexRangeMap& indexRanges) :
         RenderBase(params),
         m_vertexArray(vertexArray),
@@ -129,10 +160,18 @@ namespace TrenchBroom {
             renderEdges(renderContext);
         }
 
+        void DirectEdgeRenderer::Render::doSetupVertices() {
+            m_vertexArray.setup();
+        }
+
         void DirectEdgeRenderer::Render::doRenderVertices(RenderContext&) {
             m_indexRanges.render(m_vertexArray);
         }
 
+        void DirectEdgeRenderer::Render::doCleanupVertices() {
+            m_vertexArray.cleanup();
+        }
+
         DirectEdgeRenderer::DirectEdgeRenderer() {}
 
         DirectEdgeRenderer::DirectEdgeRenderer(const VertexArray& vertexArray, const IndexRangeMap& indexRanges) :
@@ -182,10 +221,16 @@ namespace TrenchBroom {
             renderEdges(renderContext);
         }
 
-        void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&) {
+        void IndexedEdgeRenderer::Render::doSetupVertices() {
             m_vertexArray->setupVertices();
             m_indexArray->setupIndices();
+        }
+
+        void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&) {
             m_indexArray->render(PrimType::Lines);
+        }
+
+        void IndexedEdgeRenderer::Render::doCleanupVertices() {
             m_vertexArray->cleanupVertices();
             m_indexArray->cleanupIndices();
         }
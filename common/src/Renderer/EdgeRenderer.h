@@ -41,9 +41,12 @@ namespace TrenchBroom {
                 bool onTop;
                 bool useColor;
                 Color color;
+                bool showOccluded;
+                Color occludedColor;
                 Params(float i_width, double i_offset, bool i_onTop);
                 Params(float i_width, double i_offset, bool i_onTop, const Color& i_color);
                 Params(float i_width, double i_offset, bool i_onTop, bool i_useColor, const Color& i_color);
+                Params(float i_width, double i_offset, bool i_useColor, const Color& i_color, const Color& i_occludedColor);
             };
 
             class RenderBase {
@@ -55,7 +58,9 @@ namespace TrenchBroom {
             protected:
                 void renderEdges(RenderContext& renderContext);
             private:
+                virtual void doSetupVertices() = 0;
                 virtual void doRenderVertices(RenderContext& renderContext) = 0;
+                virtual void doCleanupVertices() = 0;
             };
         public:
             virtual ~EdgeRenderer();
@@ -67,6 +72,13 @@ namespace TrenchBroom {
             void renderOnTop(RenderBatch& renderBatch, const Color& color, float width = 1.0f, double offset = 0.2);
             void renderOnTop(RenderBatch& renderBatch, bool useColor, const Color& color, float width = 1.0f, double offset = 0.2);
             void render(RenderBatch& renderBatch, bool useColor, const Color& color, bool onTop, float width, double offset);
+
+            /**
+             * Renders the edges that are hidden by other geometry in the given occluded color and the remaining edges
+             * in the given color. Both are drawn from the same vertex setup, the hidden edges by inverting the depth
+             * test instead of rendering all edges on top first.
+             */
+            void renderWithOccluded(RenderBatch& renderBatch, bool useColor, const Color& color, const Color& occludedColor, float width = 1.0f, double offset = 0.0);
         private:
             virtual void doRender(RenderBatch& renderBatch, const Params& params) = 0;
         };
@@ -82,7 +94,9 @@ namespace TrenchBroom {
             private:
                 void doPrepareVertices(VboManager& vboManager) override;
                 void doRender(RenderContext& renderContext) override;
+                void doSetupVertices() override;
                 void doRenderVertices(RenderContext& renderContext) override;
+                void doCleanupVertices() override;
             };
         private:
             VertexArray m_vertexArray;
@@ -111,7 +125,9 @@ namespace TrenchBroom {
             private:
                 void prepareVerticesAndIndices(VboManager& vboManager) override;
                 void doRender(RenderContext& renderContext) override;
+                void doSetupVertices() override;
                 void doRenderVertices(RenderContext& renderContext) override;
+                void doCleanupVertices() override;
             };
         private:
             std::shared_ptr<BrushVertexArray> m_vertexArray;
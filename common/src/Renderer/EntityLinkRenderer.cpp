@@ -41,6 +41,7 @@
 
 #include <cassert>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -186,6 +187,7 @@ namespace TrenchBroom {
             const Color& m_defaultColor;
             const Color& m_selectedColor;
             std::vector<Vertex>& m_links;
+            std::unordered_map<const Model::Node*, bool> m_visible;
         protected:
             CollectLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, std::vector<Vertex>& links) :
             m_editorContext(editorContext),
@@ -198,7 +200,7 @@ namespace TrenchBroom {
             void doVisit(Model::Group*) override {}
             void doVisit(Model::Brush*) override {}
             void doVisit(Model::Entity* entity) override {
-                if (m_editorContext.visible(entity)) {
+                if (visible(entity)) {
                     visitEntity(entity);
                 }
                 stopRecursion();
@@ -206,6 +208,21 @@ namespace TrenchBroom {
 
             virtual void visitEntity(Model::Entity* entity) = 0;
         protected:
+            /**
+             * Checks whether the given node is visible. An entity is usually checked once as a link source and once
+             * for every link that targets it, and determining the visibility of a brush entity requires checking all
+             * of its brushes, so the results are cached while the links are collected.
+             */
+            bool visible(const Model::Node* node) {
+                const auto it = m_visible.find(node);
+                if (it != std::end(m_visible)) {
+                    return it->second;
+                }
+                const auto result = m_editorContext.visible(node);
+                m_visible.emplace(node, result);
+                return result;
+            }
+
             void addLink(const Model::AttributableNode* source, const Model::AttributableNode* target) {
                 const auto anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
                 const auto& sourceColor = anySelected ? m_selectedColor : m_defaultColor;
@@ -222,15 +239,13 @@ namespace TrenchBroom {
             CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
         private:
             void visitEntity(Model::Entity* entity) override {
-                if (m_editorContext.visible(entity)) {
-                    addTargets(entity, entity->linkTargets());
-                    addTargets(entity, entity->killTargets());
-                }
+                addTargets(entity, entity->linkTargets());
+                addTargets(entity, entity->killTargets());
             }
 
             void addTargets(Model::Entity* source, const std::vector<Model::AttributableNode*>& targets) {
                 for (const Model::AttributableNode* target : targets) {
-                    if (m_editorContext.visible(target))
+                    if (visible(target))
                         addLink(source, target);
                 }
             }
@@ -244,7 +259,7 @@ namespace TrenchBroom {
             CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
         private:
             void visitEntity(Model::Entity* entity) override {
-                if (m_editorContext.visible(entity)) {
+                if (visible(entity)) {
                     const bool visited = !m_visited.insert(entity).second;
                     if (!visited) {
                         addSources(entity->linkSources(), entity);
@@ -257,7 +272,7 @@ namespace TrenchBroom {
 
             void addSources(const std::vector<Model::AttributableNode*>& sources, Model::Entity* target) {
                 for (Model::AttributableNode* source : sources) {
-                    if (m_editorContext.visible(source)) {
+                    if (visible(source)) {
                         addLink(source, target);
                         source->accept(*this);
                     }
@@ -266,7 +281,7 @@ namespace TrenchBroom {
 
             void addTargets(Model::Entity* source, const std::vector<Model::AttributableNode*>& targets) {
                 for (Model::AttributableNode* target : targets) {
-                    if (m_editorContext.visible(target)) {
+                    if (visible(target)) {
                         addLink(source, target);
                         target->accept(*this);
                     }
@@ -290,14 +305,14 @@ namespace TrenchBroom {
 
             void addSources(const std::vector<Model::AttributableNode*>& sources, Model::Entity* target) {
                 for (const Model::AttributableNode* source : sources) {
-                    if (!source->selected() && !source->descendantSelected() && m_editorContext.visible(source))
+                    if (!source->selected() && !source->descendantSelected() && visible(source))
                         addLink(source, target);
                 }
             }
 
             void addTargets(Model::Entity* source, const std::vector<Model::AttributableNode*>& targets) {
                 for (const Model::AttributableNode* target : targets) {
-                    if (m_editorContext.visible(target))
+                    if (visible(target))
                         addLink(source, target);
                 }
             }
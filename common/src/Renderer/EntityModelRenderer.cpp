@@ -30,6 +30,7 @@
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Renderer/ActiveShader.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/Shaders.h"
@@ -37,6 +38,7 @@
 #include "Renderer/TexturedIndexRangeRenderer.h"
 #include "Renderer/Transformation.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/mat.h>
 
 namespace TrenchBroom {
@@ -88,6 +90,7 @@ namespace TrenchBroom {
 
         void EntityModelRenderer::clear() {
             m_entities.clear();
+            m_instances.clear();
         }
 
         bool EntityModelRenderer::applyTinting() const {
@@ -135,18 +138,42 @@ namespace TrenchBroom {
             glAssert(glEnable(GL_TEXTURE_2D));
             glAssert(glActiveTexture(GL_TEXTURE0));
 
+            const auto& camera = renderContext.camera();
+            const auto frustum = camera.frustum();
+
+            // Models farther away than this are not rendered at all; point entities are still shown by their bounds.
+            const auto maxDistance = prefs.get(Preferences::EntityModelMaxDistance);
+            const auto maxDistance2 = maxDistance * maxDistance;
+            const auto limitDistance = maxDistance > 0.0f && camera.perspectiveProjection();
+
+            for (auto& entry : m_instances) {
+                entry.second.clear();
+            }
+
             for (const auto& entry : m_entities) {
                 auto* entity = entry.first;
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity)) {
                     continue;
                 }
 
-                auto* renderer = entry.second;
+                const auto bounds = vm::bbox3f(entity->physicalBounds());
+                if (!frustum.intersects(bounds)) {
+                    continue;
+                }
+                if (limitDistance && vm::squared_distance(bounds.center(), camera.position()) > maxDistance2) {
+                    continue;
+                }
 
-                const auto transformation = entity->modelTransformation();
-                MultiplyModelMatrix multMatrix(renderContext.transformation(), vm::mat4x4f(transformation));
+                m_instances[entry.second].push_back(vm::mat4x4f(entity->modelTransformation()));
+            }
 
-                renderer->render();
+            // render all entities that share a model together to avoid setting up the same vertex array and textures
+            // for each of them
+            for (const auto& entry : m_instances) {
+                if (!entry.second.empty()) {
+                    auto* renderer = entry.first;
+                    renderer->render(renderContext.transformation(), entry.second);
+                }
             }
         }
     }
@@ -23,7 +23,12 @@
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include <vecmath/forward.h>
+#include <vecmath/mat.h>
+
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
@@ -52,6 +57,12 @@ namespace TrenchBroom {
 
             EntityMap m_entities;
 
+            /**
+             * The model matrices of the visible entities, grouped by the renderer of their model. Kept as a member so
+             * that the model matrix buffers are reused between frames.
+             */
+            std::unordered_map<TexturedRenderer*, std::vector<vm::mat4x4f>> m_instances;
+
             bool m_applyTinting;
             Color m_tintColor;
 
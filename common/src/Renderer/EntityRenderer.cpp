@@ -35,6 +35,7 @@
 #include "Renderer/TextAnchor.h"
 #include "Renderer/GLVertexType.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 #include <vecmath/mat.h>
@@ -178,16 +179,18 @@ namespace TrenchBroom {
 
         void EntityRenderer::renderPointEntityWireframeBounds(RenderBatch& renderBatch) {
             if (m_showOccludedBounds) {
-                m_pointEntityWireframeBoundsRenderer.renderOnTop(renderBatch, m_overrideBoundsColor, m_occludedBoundsColor);
+                m_pointEntityWireframeBoundsRenderer.renderWithOccluded(renderBatch, m_overrideBoundsColor, m_boundsColor, m_occludedBoundsColor);
+            } else {
+                m_pointEntityWireframeBoundsRenderer.render(renderBatch, m_overrideBoundsColor, m_boundsColor);
             }
-            m_pointEntityWireframeBoundsRenderer.render(renderBatch, m_overrideBoundsColor, m_boundsColor);
         }
 
         void EntityRenderer::renderBrushEntityWireframeBounds(RenderBatch& renderBatch) {
             if (m_showOccludedBounds) {
-                m_brushEntityWireframeBoundsRenderer.renderOnTop(renderBatch, m_overrideBoundsColor, m_occludedBoundsColor);
+                m_brushEntityWireframeBoundsRenderer.renderWithOccluded(renderBatch, m_overrideBoundsColor, m_boundsColor, m_occludedBoundsColor);
+            } else {
+                m_brushEntityWireframeBoundsRenderer.render(renderBatch, m_overrideBoundsColor, m_boundsColor);
             }
-            m_brushEntityWireframeBoundsRenderer.render(renderBatch, m_overrideBoundsColor, m_boundsColor);
         }
 
         void EntityRenderer::renderSolidBounds(RenderBatch& renderBatch) {
@@ -212,7 +215,11 @@ namespace TrenchBroom {
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
 
+                const auto frustum = renderContext.camera().frustum();
                 for (const Model::Entity* entity : m_entities) {
+                    if (!frustum.intersects(vm::bbox3f(entity->logicalBounds()))) {
+                        continue;
+                    }
                     if (m_showHiddenEntities || m_editorContext.visible(entity)) {
                         if (entity->group() == nullptr || entity->group() == m_editorContext.currentGroup()) {
                             if (m_showOccludedOverlays)
@@ -238,11 +245,16 @@ namespace TrenchBroom {
             renderService.setShowOccludedObjectsTransparent();
             renderService.setForegroundColor(m_angleColor);
 
+            const auto frustum = renderContext.camera().frustum();
+
             std::vector<vm::vec3f> vertices(3);
             for (const auto* entity : m_entities) {
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity)) {
                     continue;
                 }
+                if (!frustum.intersects(vm::bbox3f(entity->logicalBounds()))) {
+                    continue;
+                }
 
                 const auto rotation = vm::mat4x4f(entity->rotation());
                 const auto direction = rotation * vm::vec3f::pos_x();
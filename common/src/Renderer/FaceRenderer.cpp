@@ -194,7 +194,7 @@ namespace TrenchBroom {
 
                     func.before(texture);
                     brushIndexHolderPtr->setupIndices();
-                    brushIndexHolderPtr->render(PrimType::Triangles);
+                    brushIndexHolderPtr->render(brushIndexHolderPtr->primitiveRestart() ? PrimType::TriangleFan : PrimType::Triangles);
                     brushIndexHolderPtr->cleanupIndices();
                     func.after(texture);
                 }
@@ -22,6 +22,7 @@
 #include "Renderer/FreeTypeFontFactory.h"
 #include "Renderer/TextureFont.h"
 
+#include <algorithm>
 #include <string>
 
 namespace TrenchBroom {
@@ -47,6 +48,24 @@ namespace TrenchBroom {
         FontDescriptor FontManager::selectFontSize(const FontDescriptor& fontDescriptor, const std::string& string, const float maxWidth, const size_t minFontSize) {
             FontDescriptor actualDescriptor = fontDescriptor;
             vm::vec2f actualBounds = font(actualDescriptor).measure(string);
+            if (actualBounds.x() > maxWidth && actualDescriptor.size() > minFontSize) {
+                // The width of the string is roughly proportional to the font size, so jump to an estimate instead of
+                // building every intermediate font size. Hinting makes the estimate inexact, so correct it afterwards.
+                const auto estimate = static_cast<size_t>(static_cast<float>(actualDescriptor.size()) * maxWidth / actualBounds.x());
+                const auto estimatedSize = std::max(minFontSize, std::min(estimate, actualDescriptor.size() - 1u));
+                actualDescriptor = FontDescriptor(actualDescriptor.path(), estimatedSize);
+                actualBounds = font(actualDescriptor).measure(string);
+
+                while (actualBounds.x() <= maxWidth && actualDescriptor.size() + 1u < fontDescriptor.size()) {
+                    const FontDescriptor largerDescriptor(actualDescriptor.path(), actualDescriptor.size() + 1u);
+                    const vm::vec2f largerBounds = font(largerDescriptor).measure(string);
+                    if (largerBounds.x() > maxWidth) {
+                        break;
+                    }
+                    actualDescriptor = largerDescriptor;
+                    actualBounds = largerBounds;
+                }
+            }
             while (actualBounds.x() > maxWidth && actualDescriptor.size() > minFontSize) {
                 actualDescriptor = FontDescriptor(actualDescriptor.path(), actualDescriptor.size() - 1);
                 actualBounds = font(actualDescriptor).measure(string);
@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameProfiler.h"
+
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        FrameProfiler::Scope::Scope(const char* name) :
+        m_name(name),
+        m_enabled(FrameProfiler::instance().enabled()) {
+            if (m_enabled) {
+                m_start = Clock::now();
+            }
+        }
+
+        FrameProfiler::Scope::~Scope() {
+            if (m_enabled) {
+                FrameProfiler::instance().record(m_name, m_start, Clock::now());
+            }
+        }
+
+        FrameProfiler& FrameProfiler::instance() {
+            static FrameProfiler instance;
+            return instance;
+        }
+
+        FrameProfiler::FrameProfiler() :
+        m_enabled(false) {}
+
+        bool FrameProfiler::enabled() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_enabled;
+        }
+
+        void FrameProfiler::setEnabled(const bool enabled) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (enabled != m_enabled) {
+                m_enabled = enabled;
+                m_currentFrame.clear();
+                m_lastFrame.clear();
+            }
+        }
+
+        void FrameProfiler::record(const char* name, const Clock::time_point start, const Clock::time_point end) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_enabled) {
+                Profiler::instance().record(name, start, end);
+                m_currentFrame[name] += std::chrono::duration<double, std::milli>(end - start).count();
+            }
+        }
+
+        void FrameProfiler::recordGpu(const char* name, const std::uint64_t durationNanos) {
+            const auto end = Clock::now();
+            const auto start = end - std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(durationNanos));
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_enabled) {
+                Profiler::instance().record(name, start, end, Profiler::Track::Gpu);
+                m_currentFrame[std::string("GPU ") + name] += static_cast<double>(durationNanos) / 1000000.0;
+            }
+        }
+
+        void FrameProfiler::endFrame() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_enabled) {
+                m_lastFrame = std::move(m_currentFrame);
+                m_currentFrame.clear();
+            }
+        }
+
+        std::string FrameProfiler::summary() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            std::stringstream str;
+            str << std::fixed << std::setprecision(2);
+            for (const auto& [name, millis] : m_lastFrame) {
+                if (str.tellp() > 0) {
+                    str << " | ";
+                }
+                str << name << ": " << millis << "ms";
+            }
+            return str.str();
+        }
+
+        GpuTimer::GpuTimer(const char* name) :
+        m_name(name),
+        m_queries{},
+        m_pending{},
+        m_current(0),
+        m_initialized(false),
+        m_active(false) {}
+
+        void GpuTimer::begin() {
+            if (!FrameProfiler::instance().enabled() || !(GLEW_VERSION_3_3 || GLEW_ARB_timer_query)) {
+                return;
+            }
+
+            if (!m_initialized) {
+                glAssert(glGenQueries(static_cast<GLsizei>(QueryCount), m_queries));
+                m_initialized = true;
+            }
+
+            collectResults();
+
+            // if all queries are still waiting for their results, skip measuring this pass
+            if (!m_pending[m_current]) {
+                glAssert(glBeginQuery(GL_TIME_ELAPSED, m_queries[m_current]));
+                m_active = true;
+            }
+        }
+
+        void GpuTimer::end() {
+            if (m_active) {
+                glAssert(glEndQuery(GL_TIME_ELAPSED));
+                m_pending[m_current] = true;
+                m_current = (m_current + 1) % QueryCount;
+                m_active = false;
+            }
+        }
+
+        void GpuTimer::free() {
+            assert(!m_active);
+            if (m_initialized) {
+                glAssert(glDeleteQueries(static_cast<GLsizei>(QueryCount), m_queries));
+                for (std::size_t i = 0; i < QueryCount; ++i) {
+                    m_queries[i] = 0;
+                    m_pending[i] = false;
+                }
+                m_current = 0;
+                m_initialized = false;
+            }
+        }
+
+        void GpuTimer::collectResults() {
+            auto& profiler = FrameProfiler::instance();
+            for (std::size_t i = 0; i < QueryCount; ++i) {
+                if (m_pending[i]) {
+                    GLuint available = GL_FALSE;
+                    glAssert(glGetQueryObjectuiv(m_queries[i], GL_QUERY_RESULT_AVAILABLE, &available));
+                    if (available != GL_FALSE) {
+                        GLuint64 nanos = 0;
+                        glAssert(glGetQueryObjectui64v(m_queries[i], GL_QUERY_RESULT, &nanos));
+                        profiler.recordGpu(m_name, static_cast<std::uint64_t>(nanos));
+                        m_pending[i] = false;
+                    }
+                }
+            }
+        }
+    }
+}
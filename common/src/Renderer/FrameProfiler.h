@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_FrameProfiler
+#define TrenchBroom_FrameProfiler
+
+#include "Macros.h"
+#include "Profiler.h"
+#include "Renderer/GL.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * Collects timings of the phases of rendering a frame, such as committing pending changes, validating the
+         * renderers and rendering the batch.
+         *
+         * Timings are only recorded while the profiler is enabled. The totals of the last completed frame are kept for
+         * display, and the individual events are passed on to the Profiler, which keeps the most recent ones for
+         * export.
+         */
+        class FrameProfiler {
+        public:
+            using Clock = Profiler::Clock;
+
+            /**
+             * Records the time spent in the enclosing scope under the given name. The name must be a string literal
+             * or otherwise outlive the profiler.
+             */
+            class Scope {
+            private:
+                const char* m_name;
+                bool m_enabled;
+                Clock::time_point m_start;
+            public:
+                explicit Scope(const char* name);
+                ~Scope();
+
+                deleteCopyAndMove(Scope)
+            };
+        private:
+            mutable std::mutex m_mutex;
+            bool m_enabled;
+
+            std::map<std::string, double> m_currentFrame;
+            std::map<std::string, double> m_lastFrame;
+        public:
+            static FrameProfiler& instance();
+
+            bool enabled() const;
+            void setEnabled(bool enabled);
+
+            /**
+             * Records a CPU event with the given name that started and ended at the given times.
+             */
+            void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+            /**
+             * Records a GPU event with the given name and duration. GPU results become available some frames after
+             * the work was submitted, so the event is placed at the time at which it was recorded.
+             */
+            void recordGpu(const char* name, std::uint64_t durationNanos);
+
+            /**
+             * Completes the current frame and makes its totals available to summary().
+             */
+            void endFrame();
+
+            /**
+             * Returns a single line summary of the time spent in each phase of the last completed frame.
+             */
+            std::string summary() const;
+        private:
+            FrameProfiler();
+
+            deleteCopyAndMove(FrameProfiler)
+        };
+
+        /**
+         * Measures the GPU time of a render pass using timer queries. Results are read back without waiting for the
+         * GPU, so they are reported to the frame profiler a few frames late.
+         *
+         * Does nothing if timer queries are not supported by the current context.
+         */
+        class GpuTimer {
+        private:
+            static const std::size_t QueryCount = 4;
+
+            const char* m_name;
+            GLuint m_queries[QueryCount];
+            bool m_pending[QueryCount];
+            std::size_t m_current;
+            bool m_initialized;
+            bool m_active;
+        public:
+            explicit GpuTimer(const char* name);
+
+            void begin();
+            void end();
+
+            /**
+             * Deletes the timer queries. Must be called while the OpenGL context is current, otherwise the queries
+             * are leaked. The queries are created again when the timer is used again.
+             */
+            void free();
+
+            deleteCopyAndMove(GpuTimer)
+        private:
+            void collectResults();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_FrameProfiler) */
@@ -29,6 +29,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -72,49 +73,83 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<TextureFont> FreeTypeFontFactory::buildFont(FT_Face face, const unsigned char firstChar, const unsigned char charCount) {
-            const Metrics metrics = computeMetrics(face, firstChar, charCount);
+            const std::vector<RenderedGlyph> renderedGlyphs = renderGlyphs(face, firstChar, charCount);
+            const Metrics metrics = computeMetrics(renderedGlyphs);
 
             std::unique_ptr<FontTexture> texture = std::make_unique<FontTexture>(charCount, metrics.cellSize, metrics.lineHeight);
             FontGlyphBuilder glyphBuilder(metrics.maxAscend, metrics.cellSize, 3, *texture);
 
-            FT_GlyphSlot glyph = face->glyph;
             std::vector<FontGlyph> glyphs;
-            for (unsigned char c = firstChar; c < firstChar + charCount; ++c) {
-                FT_Error error = FT_Load_Char(face, static_cast<FT_ULong>(c), FT_LOAD_RENDER);
-                if (error != 0) {
+            glyphs.reserve(renderedGlyphs.size());
+            for (const RenderedGlyph& glyph : renderedGlyphs) {
+                if (!glyph.valid) {
                     glyphs.push_back(FontGlyph(0, 0, 0, 0, 0));
                 } else {
                     glyphs.push_back(glyphBuilder.createGlyph(
-                        static_cast<size_t>(glyph->bitmap_left),
-                        static_cast<size_t>(glyph->bitmap_top),
-                        static_cast<size_t>(glyph->bitmap.width), static_cast<size_t>(glyph->bitmap.rows),
-                        static_cast<size_t>(glyph->advance.x >> 6),
-                        reinterpret_cast<char*>(glyph->bitmap.buffer),
-                        static_cast<size_t>(glyph->bitmap.pitch)));
+                        static_cast<size_t>(glyph.left),
+                        static_cast<size_t>(glyph.top),
+                        glyph.width, glyph.rows,
+                        glyph.advance,
+                        glyph.bitmap.data(),
+                        glyph.width));
                 }
             }
 
             return std::make_unique<TextureFont>(std::move(texture), glyphs, static_cast<int>(metrics.lineHeight), firstChar, charCount);
         }
 
-        FreeTypeFontFactory::Metrics FreeTypeFontFactory::computeMetrics(FT_Face face, const unsigned char firstChar, const unsigned char charCount) const {
+        std::vector<FreeTypeFontFactory::RenderedGlyph> FreeTypeFontFactory::renderGlyphs(FT_Face face, const unsigned char firstChar, const unsigned char charCount) const {
             FT_GlyphSlot glyph = face->glyph;
 
+            std::vector<RenderedGlyph> result;
+            result.reserve(charCount);
+
+            for (unsigned char c = firstChar; c < firstChar + charCount; ++c) {
+                FT_Error error = FT_Load_Char(face, static_cast<FT_ULong>(c), FT_LOAD_RENDER);
+                if (error != 0) {
+                    result.push_back(RenderedGlyph{false, 0, 0, 0u, 0u, 0u, 0, {}});
+                    continue;
+                }
+
+                const auto width = static_cast<size_t>(glyph->bitmap.width);
+                const auto rows = static_cast<size_t>(glyph->bitmap.rows);
+                const auto pitch = static_cast<size_t>(glyph->bitmap.pitch);
+
+                // the slot's bitmap is overwritten by the next glyph, so copy it into a tightly packed buffer
+                std::vector<char> bitmap(width * rows);
+                for (size_t r = 0; r < rows; ++r) {
+                    std::copy_n(reinterpret_cast<const char*>(glyph->bitmap.buffer) + r * pitch, width, bitmap.data() + r * width);
+                }
+
+                result.push_back(RenderedGlyph{
+                    true,
+                    glyph->bitmap_left,
+                    glyph->bitmap_top,
+                    width, rows,
+                    static_cast<size_t>(glyph->advance.x >> 6),
+                    static_cast<int>(glyph->metrics.height >> 6),
+                    std::move(bitmap)
+                });
+            }
+
+            return result;
+        }
+
+        FreeTypeFontFactory::Metrics FreeTypeFontFactory::computeMetrics(const std::vector<RenderedGlyph>& renderedGlyphs) const {
             int maxWidth = 0;
             int maxAscend = 0;
             int maxDescend = 0;
             int lineHeight = 0;
 
-            for (unsigned char c = firstChar; c < firstChar + charCount; ++c) {
-                FT_Error error = FT_Load_Char(face, static_cast<FT_ULong>(c), FT_LOAD_RENDER);
-                if (error != 0) {
+            for (const RenderedGlyph& glyph : renderedGlyphs) {
+                if (!glyph.valid) {
                     continue;
                 }
 
-                maxWidth = std::max(maxWidth, glyph->bitmap_left + static_cast<FT_Int>(glyph->bitmap.width));
-                maxAscend = std::max(maxAscend, glyph->bitmap_top);
-                maxDescend = std::max(maxDescend, static_cast<FT_Int>(glyph->bitmap.rows) - glyph->bitmap_top);
-                lineHeight = std::max(lineHeight, static_cast<int>(glyph->metrics.height >> 6));
+                maxWidth = std::max(maxWidth, glyph.left + static_cast<int>(glyph.width));
+                maxAscend = std::max(maxAscend, glyph.top);
+                maxDescend = std::max(maxDescend, static_cast<int>(glyph.rows) - glyph.top);
+                lineHeight = std::max(lineHeight, glyph.lineHeight);
             }
 
             const int cellSize = std::max(maxWidth, maxAscend + maxDescend);
@@ -26,6 +26,7 @@
 #include "Renderer/FontFactory.h"
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -34,6 +35,21 @@ namespace TrenchBroom {
 
         class FreeTypeFontFactory : public FontFactory {
         private:
+            /**
+             * A copy of a glyph bitmap rendered by FreeType, kept so that every glyph is only rasterized once when
+             * building a font.
+             */
+            struct RenderedGlyph {
+                bool valid;
+                int left;
+                int top;
+                size_t width;
+                size_t rows;
+                size_t advance;
+                int lineHeight;
+                std::vector<char> bitmap;
+            };
+
             FT_Library m_library;
         public:
             FreeTypeFontFactory();
@@ -44,7 +60,8 @@ namespace TrenchBroom {
             FT_Face loadFont(const FontDescriptor& fontDescriptor);
             std::unique_ptr<TextureFont> buildFont(FT_Face face, unsigned char firstChar, unsigned char charCount);
 
-            Metrics computeMetrics(FT_Face face, unsigned char firstChar, unsigned char charCount) const;
+            std::vector<RenderedGlyph> renderGlyphs(FT_Face face, unsigned char firstChar, unsigned char charCount) const;
+            Metrics computeMetrics(const std::vector<RenderedGlyph>& renderedGlyphs) const;
         };
     }
 }
@@ -307,6 +307,10 @@ namespace TrenchBroom {
             using P2  = GLVertexAttributeType<GLVertexAttributeTypeTag::Position, GL_FLOAT, 2>;
             using P3  = GLVertexAttributeType<GLVertexAttributeTypeTag::Position, GL_FLOAT, 3>;
             using N   = GLVertexAttributeType<GLVertexAttributeTypeTag::Normal, GL_FLOAT, 3>;
+            /**
+             * Normal packed into signed bytes, which OpenGL maps to [-1, 1].
+             */
+            using NB  = GLVertexAttributeType<GLVertexAttributeTypeTag::Normal, GL_BYTE, 3>;
             using T02 = GLVertexAttributeType<GLVertexAttributeTypeTag::TexCoord0, GL_FLOAT, 2>;
             using T12 = GLVertexAttributeType<GLVertexAttributeTypeTag::TexCoord1, GL_FLOAT, 2>;
             using C4  = GLVertexAttributeType<GLVertexAttributeTypeTag::Color, GL_FLOAT, 4>;
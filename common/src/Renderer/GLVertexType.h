@@ -161,6 +161,8 @@ namespace TrenchBroom {
             using P3N    = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N>;
             using P3NC4  = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N, GLVertexAttributeTypes::C4>;
             using P3NT2  = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N, GLVertexAttributeTypes::T02>;
+            // the packed normal comes last so that the attribute offsets match the vertex layout
+            using P3T2NB = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::T02, GLVertexAttributeTypes::NB>;
         }
     }
 }
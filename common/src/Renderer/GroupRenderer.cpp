@@ -30,8 +30,9 @@
 #include "Renderer/RenderService.h"
 #include "Renderer/TextAnchor.h"
 
-#include <vector>
+#include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace TrenchBroom {
@@ -124,10 +125,10 @@ namespace TrenchBroom {
             }
 
             if (m_showOccludedBounds) {
-                m_boundsRenderer.renderOnTop(renderBatch, m_overrideBoundsColor, m_occludedBoundsColor);
+                m_boundsRenderer.renderWithOccluded(renderBatch, m_overrideBoundsColor, m_boundsColor, m_occludedBoundsColor);
+            } else {
+                m_boundsRenderer.render(renderBatch, m_overrideBoundsColor, m_boundsColor);
             }
-
-            m_boundsRenderer.render(renderBatch, m_overrideBoundsColor, m_boundsColor);
         }
 
         void GroupRenderer::renderNames(RenderContext& renderContext, RenderBatch& renderBatch) {
@@ -150,6 +151,25 @@ namespace TrenchBroom {
             }
         }
 
+        void GroupRenderer::addGroup(Model::Group* group) {
+            if (!kdl::vec_contains(m_groups, group)) {
+                m_groups.push_back(group);
+                invalidate();
+            }
+        }
+
+        void GroupRenderer::updateGroup(Model::Group* /* group */) {
+            invalidate();
+        }
+
+        void GroupRenderer::removeGroup(Model::Group* group) {
+            const auto it = std::find(std::begin(m_groups), std::end(m_groups), group);
+            if (it != std::end(m_groups)) {
+                m_groups.erase(it);
+                invalidate();
+            }
+        }
+
         void GroupRenderer::invalidateBounds() {
             m_boundsValid = false;
         }
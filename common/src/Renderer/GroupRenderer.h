@@ -103,6 +103,10 @@ namespace TrenchBroom {
             struct BuildColoredBoundsVertices;
             struct BuildBoundsVertices;
 
+            void addGroup(Model::Group* group);
+            void updateGroup(Model::Group* group);
+            void removeGroup(Model::Group* group);
+
             void invalidateBounds();
             void validateBounds();
 
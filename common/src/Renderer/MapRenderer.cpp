@@ -22,10 +22,12 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "Model/AssortNodesVisitor.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
+#include "Model/FindLayerVisitor.h"
 #include "Model/Group.h"
 #include "Model/Layer.h"
 #include "Model/Node.h"
@@ -33,6 +35,7 @@
 #include "Model/World.h"
 #include "Renderer/BrushRenderer.h"
 #include "Renderer/EntityLinkRenderer.h"
+#include "Renderer/FrameProfiler.h"
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
@@ -41,7 +44,9 @@
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/vector_utils.h>
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -121,9 +126,7 @@ namespace TrenchBroom {
 
         MapRenderer::MapRenderer(std::weak_ptr<View::MapDocument> document) :
         m_document(document),
-        m_defaultRenderer(createDefaultRenderer(m_document)),
         m_selectionRenderer(createSelectionRenderer(m_document)),
-        m_lockedRenderer(createLockRenderer(m_document)),
         m_entityLinkRenderer(std::make_unique<EntityLinkRenderer>(m_document)) {
             bindObservers();
             setupRenderers();
@@ -158,10 +161,29 @@ namespace TrenchBroom {
                 LockedBrushRendererFilter(kdl::mem_lock(document)->editorContext()));
         }
 
+        MapRenderer::LayerRenderers& MapRenderer::layerRenderers(Model::Layer* layer) {
+            auto it = m_layerRenderers.find(layer);
+            if (it == std::end(m_layerRenderers)) {
+                auto defaultRenderer = createDefaultRenderer(m_document);
+                auto lockedRenderer = createLockRenderer(m_document);
+                setupDefaultRenderer(*defaultRenderer);
+                setupLockedRenderer(*lockedRenderer);
+
+                auto document = kdl::mem_lock(m_document);
+                const bool skipped = document->world()->isLayerHidden(layer);
+                it = m_layerRenderers.emplace(layer, LayerRenderers{ std::move(defaultRenderer), std::move(lockedRenderer), skipped, true }).first;
+            }
+            return it->second;
+        }
+
         void MapRenderer::clear() {
-            m_defaultRenderer->clear();
+            // release the OpenGL resources of the renderers while the context is current
+            for (auto& entry : m_layerRenderers) {
+                entry.second.defaultRenderer->clear();
+                entry.second.lockedRenderer->clear();
+            }
+            m_layerRenderers.clear();
             m_selectionRenderer->clear();
-            m_lockedRenderer->clear();
             m_entityLinkRenderer->invalidate();
         }
 
@@ -194,7 +216,18 @@ namespace TrenchBroom {
             renderEntityLinks(renderContext, renderBatch);
         }
 
+        bool MapRenderer::valid() const {
+            for (const auto& entry : m_layerRenderers) {
+                const auto& renderers = entry.second;
+                if (!renderers.skipped && (!renderers.defaultRenderer->valid() || !renderers.lockedRenderer->valid())) {
+                    return false;
+                }
+            }
+            return m_selectionRenderer->valid();
+        }
+
         void MapRenderer::commitPendingChanges() {
+            FrameProfiler::Scope scope("MapRenderer::commitPendingChanges");
             auto document = kdl::mem_lock(m_document);
             document->commitPendingAssets();
         }
@@ -215,13 +248,23 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_defaultRenderer->setShowOverlays(renderContext.render3D());
-            m_defaultRenderer->renderOpaque(renderContext, renderBatch);
+            for (auto& entry : m_layerRenderers) {
+                auto& renderers = entry.second;
+                if (!renderers.skipped) {
+                    renderers.defaultRenderer->setShowOverlays(renderContext.render3D());
+                    renderers.defaultRenderer->renderOpaque(renderContext, renderBatch);
+                }
+            }
         }
 
         void MapRenderer::renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_defaultRenderer->setShowOverlays(renderContext.render3D());
-            m_defaultRenderer->renderTransparent(renderContext, renderBatch);
+            for (auto& entry : m_layerRenderers) {
+                auto& renderers = entry.second;
+                if (!renderers.skipped) {
+                    renderers.defaultRenderer->setShowOverlays(renderContext.render3D());
+                    renderers.defaultRenderer->renderTransparent(renderContext, renderBatch);
+                }
+            }
         }
 
         void MapRenderer::renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
@@ -237,13 +280,23 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_lockedRenderer->setShowOverlays(renderContext.render3D());
-            m_lockedRenderer->renderOpaque(renderContext, renderBatch);
+            for (auto& entry : m_layerRenderers) {
+                auto& renderers = entry.second;
+                if (!renderers.skipped) {
+                    renderers.lockedRenderer->setShowOverlays(renderContext.render3D());
+                    renderers.lockedRenderer->renderOpaque(renderContext, renderBatch);
+                }
+            }
         }
 
         void MapRenderer::renderLockedTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_lockedRenderer->setShowOverlays(renderContext.render3D());
-            m_lockedRenderer->renderTransparent(renderContext, renderBatch);
+            for (auto& entry : m_layerRenderers) {
+                auto& renderers = entry.second;
+                if (!renderers.skipped) {
+                    renderers.lockedRenderer->setShowOverlays(renderContext.render3D());
+                    renderers.lockedRenderer->renderTransparent(renderContext, renderBatch);
+                }
+            }
         }
 
         void MapRenderer::renderEntityLinks(RenderContext& renderContext, RenderBatch& renderBatch) {
@@ -251,9 +304,11 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::setupRenderers() {
-            setupDefaultRenderer(*m_defaultRenderer);
+            for (auto& entry : m_layerRenderers) {
+                setupDefaultRenderer(*entry.second.defaultRenderer);
+                setupLockedRenderer(*entry.second.lockedRenderer);
+            }
             setupSelectionRenderer(*m_selectionRenderer);
-            setupLockedRenderer(*m_lockedRenderer);
             setupEntityLinkRenderer();
         }
 
@@ -269,6 +324,7 @@ namespace TrenchBroom {
 
             renderer.setBrushFaceColor(pref(Preferences::FaceColor));
             renderer.setBrushEdgeColor(pref(Preferences::EdgeColor));
+            renderer.setOcclusionCulling(pref(Preferences::OcclusionCulling));
         }
 
         void MapRenderer::setupSelectionRenderer(ObjectRenderer& renderer) {
@@ -318,48 +374,59 @@ namespace TrenchBroom {
 
         class MapRenderer::CollectRenderableNodes : public Model::NodeVisitor {
         private:
+            using LayerNodes = std::map<Model::Layer*, Model::NodeCollection>;
+
             Renderer m_renderers;
-            Model::NodeCollection m_defaultNodes;
+            Model::Layer* m_layer;
+            LayerNodes m_defaultNodes;
             Model::NodeCollection m_selectedNodes;
-            Model::NodeCollection m_lockedNodes;
+            LayerNodes m_lockedNodes;
         public:
-            CollectRenderableNodes(const Renderer renderers) : m_renderers(renderers) {}
+            CollectRenderableNodes(const Renderer renderers, Model::Layer* layer = nullptr) :
+            m_renderers(renderers),
+            m_layer(layer) {}
 
-            const Model::NodeCollection& defaultNodes() const  { return m_defaultNodes;  }
-            const Model::NodeCollection& selectedNodes() const { return m_selectedNodes; }
-            const Model::NodeCollection& lockedNodes() const   { return m_lockedNodes;   }
+            const Model::NodeCollection& defaultNodes(Model::Layer* layer) const { return nodes(m_defaultNodes, layer); }
+            const Model::NodeCollection& selectedNodes() const                   { return m_selectedNodes; }
+            const Model::NodeCollection& lockedNodes(Model::Layer* layer) const  { return nodes(m_lockedNodes, layer); }
         private:
+            static const Model::NodeCollection& nodes(const LayerNodes& layerNodes, Model::Layer* layer) {
+                static const Model::NodeCollection empty;
+                const auto it = layerNodes.find(layer);
+                return it != std::end(layerNodes) ? it->second : empty;
+            }
+
             void doVisit(Model::World*) override   {}
-            void doVisit(Model::Layer*) override   {}
+            void doVisit(Model::Layer* layer) override   { m_layer = layer; }
 
             void doVisit(Model::Group* group) override   {
                 if (group->locked()) {
-                    if (collectLocked()) m_lockedNodes.addNode(group);
+                    if (collectLocked()) m_lockedNodes[m_layer].addNode(group);
                 } else if (selected(group) || group->opened()) {
                     if (collectSelection()) m_selectedNodes.addNode(group);
                 } else {
-                    if (collectDefault()) m_defaultNodes.addNode(group);
+                    if (collectDefault()) m_defaultNodes[m_layer].addNode(group);
                 }
             }
 
             void doVisit(Model::Entity* entity) override {
                 if (entity->locked()) {
-                    if (collectLocked()) m_lockedNodes.addNode(entity);
+                    if (collectLocked()) m_lockedNodes[m_layer].addNode(entity);
                 } else if (selected(entity)) {
                     if (collectSelection()) m_selectedNodes.addNode(entity);
                 } else {
-                    if (collectDefault()) m_defaultNodes.addNode(entity);
+                    if (collectDefault()) m_defaultNodes[m_layer].addNode(entity);
                 }
             }
 
             void doVisit(Model::Brush* brush) override   {
                 if (brush->locked()) {
-                    if (collectLocked()) m_lockedNodes.addNode(brush);
+                    if (collectLocked()) m_lockedNodes[m_layer].addNode(brush);
                 } else if (selected(brush)) {
                     if (collectSelection()) m_selectedNodes.addNode(brush);
                 }
                 if (!brush->selected() && !brush->parentSelected() && !brush->locked()) {
-                    if (collectDefault()) m_defaultNodes.addNode(brush);
+                    if (collectDefault()) m_defaultNodes[m_layer].addNode(brush);
                 }
             }
 
@@ -379,43 +446,117 @@ namespace TrenchBroom {
             CollectRenderableNodes collect(renderers);
             world->acceptAndRecurse(collect);
 
-            if ((renderers & Renderer_Default) != 0) {
-                m_defaultRenderer->setObjects(collect.defaultNodes().groups(),
-                                              collect.defaultNodes().entities(),
-                                              collect.defaultNodes().brushes());
+            // drop the renderers of layers that were removed
+            const auto layers = world->allLayers();
+            for (auto it = std::begin(m_layerRenderers); it != std::end(m_layerRenderers); ) {
+                if (kdl::vec_contains(layers, it->first)) {
+                    ++it;
+                } else {
+                    it->second.defaultRenderer->clear();
+                    it->second.lockedRenderer->clear();
+                    it = m_layerRenderers.erase(it);
+                }
+            }
+
+            for (auto* layer : layers) {
+                auto& layerRenderer = layerRenderers(layer);
+                if ((renderers & Renderer_Default) != 0) {
+                    const auto& nodes = collect.defaultNodes(layer);
+                    layerRenderer.defaultRenderer->setObjects(nodes.groups(), nodes.entities(), nodes.brushes());
+                }
+                if ((renderers & Renderer_Locked) != 0) {
+                    const auto& nodes = collect.lockedNodes(layer);
+                    layerRenderer.lockedRenderer->setObjects(nodes.groups(), nodes.entities(), nodes.brushes());
+                }
+                updateSkipped(layer, layerRenderer, false);
             }
             if ((renderers & Renderer_Selection) != 0) {
                 m_selectionRenderer->setObjects(collect.selectedNodes().groups(),
                                                 collect.selectedNodes().entities(),
                                                 collect.selectedNodes().brushes());
             }
-            if ((renderers& Renderer_Locked) != 0) {
-                m_lockedRenderer->setObjects(collect.lockedNodes().groups(),
-                                             collect.lockedNodes().entities(),
-                                             collect.lockedNodes().brushes());
+            invalidateEntityLinkRenderer();
+        }
+
+        void MapRenderer::updateLayerRenderers(const std::vector<Model::Layer*>& layers) {
+            CollectRenderableNodes collect(Renderer_Default_Locked);
+            Model::Node::acceptAndRecurse(std::begin(layers), std::end(layers), collect);
+
+            for (auto* layer : layers) {
+                auto& layerRenderer = layerRenderers(layer);
+                const auto& defaultNodes = collect.defaultNodes(layer);
+                const auto& lockedNodes = collect.lockedNodes(layer);
+                layerRenderer.defaultRenderer->setObjects(defaultNodes.groups(), defaultNodes.entities(), defaultNodes.brushes());
+                layerRenderer.lockedRenderer->setObjects(lockedNodes.groups(), lockedNodes.entities(), lockedNodes.brushes());
+            }
+            invalidateEntityLinkRenderer();
+        }
+
+        void MapRenderer::updateGroupInRenderers(Model::Group* group) {
+            // a group and the groups containing it always belong to the same layer
+            auto* layer = group->layer();
+            CollectRenderableNodes collect(Renderer_Default_Selection, layer);
+
+            std::vector<Model::Group*> groups;
+            for (auto* current = group; current != nullptr; current = current->group()) {
+                current->accept(collect);
+                groups.push_back(current);
             }
+
+            auto& defaultRenderer = *layerRenderers(layer).defaultRenderer;
+            defaultRenderer.removeGroups(groups);
+            m_selectionRenderer->removeGroups(groups);
+
+            defaultRenderer.addGroups(collect.defaultNodes(layer).groups());
+            m_selectionRenderer->addGroups(collect.selectedNodes().groups());
             invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::invalidateRenderers(Renderer renderers) {
-            if ((renderers & Renderer_Default) != 0)
-                m_defaultRenderer->invalidate();
+            for (auto& entry : m_layerRenderers) {
+                if ((renderers & Renderer_Default) != 0)
+                    entry.second.defaultRenderer->invalidate();
+                if ((renderers& Renderer_Locked) != 0)
+                    entry.second.lockedRenderer->invalidate();
+            }
             if ((renderers & Renderer_Selection) != 0)
                 m_selectionRenderer->invalidate();
-            if ((renderers& Renderer_Locked) != 0)
-                m_lockedRenderer->invalidate();
         }
 
         void MapRenderer::invalidateBrushesInRenderers(Renderer renderers, const std::vector<Model::Brush*>& brushes) {
-            if ((renderers & Renderer_Default) != 0) {
-                m_defaultRenderer->invalidateBrushes(brushes);
+            for (auto& entry : m_layerRenderers) {
+                if ((renderers & Renderer_Default) != 0) {
+                    entry.second.defaultRenderer->invalidateBrushes(brushes);
+                }
+                if ((renderers& Renderer_Locked) != 0) {
+                    entry.second.lockedRenderer->invalidateBrushes(brushes);
+                }
             }
             if ((renderers & Renderer_Selection) != 0) {
                 m_selectionRenderer->invalidateBrushes(brushes);
             }
-            if ((renderers& Renderer_Locked) != 0) {
-                m_lockedRenderer->invalidateBrushes(brushes);
+        }
+
+        void MapRenderer::invalidateEntityRenderers(Renderer renderers) {
+            for (auto& entry : m_layerRenderers) {
+                if ((renderers & Renderer_Default) != 0) {
+                    entry.second.defaultRenderer->invalidateEntities();
+                }
+                if ((renderers & Renderer_Locked) != 0) {
+                    entry.second.lockedRenderer->invalidateEntities();
+                }
+            }
+            if ((renderers & Renderer_Selection) != 0) {
+                m_selectionRenderer->invalidateEntities();
+            }
+        }
+
+        std::vector<Model::Brush*> MapRenderer::brushesOfFaces(const std::vector<Model::BrushFace*>& faces) {
+            std::set<Model::Brush*> brushes;
+            for (auto* face : faces) {
+                brushes.insert(face->brush());
             }
+            return std::vector<Model::Brush*>(std::begin(brushes), std::end(brushes));
         }
 
         void MapRenderer::invalidateEntityLinkRenderer() {
@@ -423,9 +564,27 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::reloadEntityModels() {
-            m_defaultRenderer->reloadModels();
+            for (auto& entry : m_layerRenderers) {
+                entry.second.defaultRenderer->reloadModels();
+                entry.second.lockedRenderer->reloadModels();
+            }
             m_selectionRenderer->reloadModels();
-            m_lockedRenderer->reloadModels();
+        }
+
+        void MapRenderer::updateSkipped(Model::Layer* layer, LayerRenderers& renderers, const bool layerOnly) {
+            auto document = kdl::mem_lock(m_document);
+            const bool wasSkipped = renderers.skipped;
+            renderers.skipped = document->world()->isLayerHidden(layer);
+
+            if (renderers.skipped && !wasSkipped) {
+                renderers.reusable = layerOnly;
+            } else if (!renderers.skipped && wasSkipped) {
+                // the objects were validated while the layer itself was visible
+                if (!renderers.reusable || !layer->visible()) {
+                    renderers.defaultRenderer->invalidate();
+                    renderers.lockedRenderer->invalidate();
+                }
+            }
         }
 
         void MapRenderer::bindObservers() {
@@ -496,29 +655,87 @@ namespace TrenchBroom {
             updateRenderers(Renderer_Default);
         }
 
-        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>&) {
-            invalidateRenderers(Renderer_Selection);
+        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes) {
+            // only the changed brushes must be rebuilt, so that editing a few brushes of a large selection does not
+            // upload the geometry of the entire selection again
+            Model::CollectBrushesVisitor collect;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collect);
+
+            invalidateEntityRenderers(Renderer_Selection);
+            invalidateBrushesInRenderers(Renderer_Selection, collect.brushes());
             invalidateEntityLinkRenderer();
         }
 
-        void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>&) {
-            invalidateRenderers(Renderer_All);
+        void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>& nodes) {
+            // maps every affected layer to whether only the layer itself has changed
+            std::map<Model::Layer*, bool> layers;
+            std::vector<Model::Node*> invalidNodes;
+            for (auto* node : nodes) {
+                Model::FindLayerVisitor findLayer;
+                node->acceptAndEscalate(findLayer);
+                if (findLayer.hasResult()) {
+                    auto* layer = findLayer.result();
+                    const auto it = layers.emplace(layer, true).first;
+                    if (node != layer) {
+                        it->second = false;
+                        invalidNodes.push_back(node);
+                    }
+                } else {
+                    invalidNodes.push_back(node);
+                }
+            }
+
+            // hiding or showing an entire layer only skips or resumes its renderers, but a layer that stays visible
+            // must filter its objects again
+            for (const auto& entry : layers) {
+                auto* layer = entry.first;
+                auto& renderers = layerRenderers(layer);
+                const bool wasSkipped = renderers.skipped;
+                updateSkipped(layer, renderers, entry.second);
+
+                if (!wasSkipped && !renderers.skipped && kdl::vec_contains(nodes, layer)) {
+                    invalidNodes.push_back(layer);
+                }
+            }
+
+            if (!invalidNodes.empty()) {
+                // the visibility of a node also affects its descendants, but only the brushes among them need to be
+                // filtered again
+                Model::CollectBrushesVisitor collect;
+                Model::Node::acceptAndRecurse(std::begin(invalidNodes), std::end(invalidNodes), collect);
+
+                invalidateEntityRenderers(Renderer_All);
+                invalidateBrushesInRenderers(Renderer_All, collect.brushes());
+            }
+            invalidateEntityLinkRenderer();
         }
 
-        void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>&) {
-            updateRenderers(Renderer_Default_Locked);
+        void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>& nodes) {
+            // locking or unlocking entire layers only moves their own objects between renderers
+            std::vector<Model::Layer*> layers;
+            for (auto* node : nodes) {
+                Model::FindLayerVisitor findLayer;
+                node->acceptAndEscalate(findLayer);
+                if (!findLayer.hasResult() || findLayer.result() != node) {
+                    updateRenderers(Renderer_Default_Locked);
+                    return;
+                }
+                layers.push_back(findLayer.result());
+            }
+
+            updateLayerRenderers(layers);
         }
 
-        void MapRenderer::groupWasOpened(Model::Group*) {
-            updateRenderers(Renderer_Default_Selection);
+        void MapRenderer::groupWasOpened(Model::Group* group) {
+            updateGroupInRenderers(group);
         }
 
-        void MapRenderer::groupWasClosed(Model::Group*) {
-            updateRenderers(Renderer_Default_Selection);
+        void MapRenderer::groupWasClosed(Model::Group* group) {
+            updateGroupInRenderers(group);
         }
 
-        void MapRenderer::brushFacesDidChange(const std::vector<Model::BrushFace*>&) {
-            invalidateRenderers(Renderer_Selection);
+        void MapRenderer::brushFacesDidChange(const std::vector<Model::BrushFace*>& faces) {
+            invalidateBrushesInRenderers(Renderer_Selection, brushesOfFaces(faces));
         }
 
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
@@ -528,21 +745,7 @@ namespace TrenchBroom {
             if (!selection.selectedBrushFaces().empty()
                 || !selection.deselectedBrushFaces().empty()) {
 
-                std::set<Model::Brush*> brushes;
-                for (auto& face : selection.selectedBrushFaces()) {
-                    brushes.insert(face->brush());
-                }
-                for (auto& face : selection.deselectedBrushFaces()) {
-                    brushes.insert(face->brush());
-                }
-
-                std::vector<Model::Brush*> brushesVec;
-                brushesVec.reserve(brushes.size());
-                for (auto& brush : brushes) {
-                    brushesVec.push_back(brush);
-                }
-
-                invalidateBrushesInRenderers(Renderer_All, brushesVec);
+                invalidateBrushesInRenderers(Renderer_All, brushesOfFaces(kdl::vec_concat(selection.selectedBrushFaces(), selection.deselectedBrushFaces())));
             }
         }
 
@@ -575,6 +778,10 @@ namespace TrenchBroom {
         void MapRenderer::preferenceDidChange(const IO::Path& path) {
             setupRenderers();
 
+            if (path == Preferences::CompactBrushVertices.path() || path == Preferences::UsePrimitiveRestart.path()) {
+                invalidateRenderers(Renderer_All);
+            }
+
             auto document = kdl::mem_lock(m_document);
             if (document->isGamePathPreference(path)) {
                 reloadEntityModels();
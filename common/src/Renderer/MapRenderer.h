@@ -59,13 +59,29 @@ namespace TrenchBroom {
             class LockedBrushRendererFilter;
             class UnselectedBrushRendererFilter;
 
-            using RendererMap = std::map<Model::Layer*, ObjectRenderer*>;
+            /**
+             * The unselected objects of every layer are rendered by their own renderers so that a layer can be hidden
+             * or shown without touching the renderers of the other layers.
+             */
+            struct LayerRenderers {
+                std::unique_ptr<ObjectRenderer> defaultRenderer;
+                std::unique_ptr<ObjectRenderer> lockedRenderer;
+                /**
+                 * Set while all objects of the layer are hidden. Skipped renderers are neither rendered nor validated.
+                 */
+                bool skipped;
+                /**
+                 * Whether the objects that were validated before the layer was skipped can be rendered as they are once
+                 * the layer is shown again. This holds if the layer was skipped because it was hidden itself.
+                 */
+                bool reusable;
+            };
+            using RendererMap = std::map<Model::Layer*, LayerRenderers>;
 
             std::weak_ptr<View::MapDocument> m_document;
 
-            std::unique_ptr<ObjectRenderer> m_defaultRenderer;
+            RendererMap m_layerRenderers;
             std::unique_ptr<ObjectRenderer> m_selectionRenderer;
-            std::unique_ptr<ObjectRenderer> m_lockedRenderer;
             std::unique_ptr<EntityLinkRenderer> m_entityLinkRenderer;
         public:
             explicit MapRenderer(std::weak_ptr<View::MapDocument> document);
@@ -76,12 +92,20 @@ namespace TrenchBroom {
             static std::unique_ptr<ObjectRenderer> createDefaultRenderer(std::weak_ptr<View::MapDocument> document);
             static std::unique_ptr<ObjectRenderer> createSelectionRenderer(std::weak_ptr<View::MapDocument> document);
             static std::unique_ptr<ObjectRenderer> createLockRenderer(std::weak_ptr<View::MapDocument> document);
+            LayerRenderers& layerRenderers(Model::Layer* layer);
             void clear();
         public: // color config
             void overrideSelectionColors(const Color& color, float mix);
             void restoreSelectionColors();
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
+
+            /**
+             * Returns whether the last call to render() rendered all objects. If large parts of the map were invalidated,
+             * their renderers are validated over several frames, and the view must be rendered again until this returns
+             * true.
+             */
+            bool valid() const;
         private:
             void commitPendingChanges();
             void setupGL(RenderBatch& renderBatch);
@@ -117,10 +141,29 @@ namespace TrenchBroom {
              * If brushes are modified, you need to call invalidateRenderers() or invalidateObjectsInRenderers()
              */
             void updateRenderers(Renderer renderers);
+            /**
+             * Like updateRenderers(), but only moves the objects of the given layers between their default and locked
+             * renderers.
+             */
+            void updateLayerRenderers(const std::vector<Model::Layer*>& layers);
+            /**
+             * Moves the given group and the groups containing it between the default and selection renderers. Opening
+             * or closing a group only changes which renderers these groups belong to, so their members are left alone.
+             */
+            void updateGroupInRenderers(Model::Group* group);
             void invalidateRenderers(Renderer renderers);
             void invalidateBrushesInRenderers(Renderer renderers, const std::vector<Model::Brush*>& brushes);
+            void invalidateEntityRenderers(Renderer renderers);
+            static std::vector<Model::Brush*> brushesOfFaces(const std::vector<Model::BrushFace*>& faces);
             void invalidateEntityLinkRenderer();
             void reloadEntityModels();
+
+            /**
+             * Updates whether the given renderers of the given layer are skipped. If `layerOnly` is true, only the
+             * visibility state of the layer itself has changed. If the renderers are resumed and their objects cannot
+             * be reused, they are invalidated.
+             */
+            void updateSkipped(Model::Layer* layer, LayerRenderers& renderers, bool layerOnly);
         private: // notification
             void bindObservers();
             void unbindObservers();
@@ -29,6 +29,14 @@ namespace TrenchBroom {
             m_brushRenderer.setBrushes(brushes);
         }
 
+        void ObjectRenderer::addGroups(const std::vector<Model::Group*>& groups) {
+            m_groupRenderer.addGroups(std::begin(groups), std::end(groups));
+        }
+
+        void ObjectRenderer::removeGroups(const std::vector<Model::Group*>& groups) {
+            m_groupRenderer.removeGroups(std::begin(groups), std::end(groups));
+        }
+
         void ObjectRenderer::invalidate() {
             m_groupRenderer.invalidate();
             m_entityRenderer.invalidate();
@@ -39,6 +47,15 @@ namespace TrenchBroom {
             m_brushRenderer.invalidateBrushes(brushes);
         }
 
+        bool ObjectRenderer::valid() const {
+            return m_brushRenderer.valid();
+        }
+
+        void ObjectRenderer::invalidateEntities() {
+            m_groupRenderer.invalidate();
+            m_entityRenderer.invalidate();
+        }
+
         void ObjectRenderer::clear() {
             m_groupRenderer.clear();
             m_entityRenderer.clear();
@@ -136,6 +153,10 @@ namespace TrenchBroom {
             m_brushRenderer.setShowHiddenBrushes(showHiddenObjects);
         }
 
+        void ObjectRenderer::setOcclusionCulling(const bool occlusionCulling) {
+            m_brushRenderer.setOcclusionCulling(occlusionCulling);
+        }
+
         void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             m_brushRenderer.renderOpaque(renderContext, renderBatch);
             m_entityRenderer.render(renderContext, renderBatch);
@@ -58,10 +58,25 @@ namespace TrenchBroom {
             m_brushRenderer(brushFilter) {}
         public: // object management
             void setObjects(const std::vector<Model::Group*>& groups, const std::vector<Model::Entity*>& entities, const std::vector<Model::Brush*>& brushes);
+            /**
+             * Adds or removes groups without touching the entities and brushes of this renderer.
+             */
+            void addGroups(const std::vector<Model::Group*>& groups);
+            void removeGroups(const std::vector<Model::Group*>& groups);
             void invalidate();
             void invalidateBrushes(const std::vector<Model::Brush*>& brushes);
+            /**
+             * Invalidates the group and entity renderers, but not the brush renderer.
+             */
+            void invalidateEntities();
             void clear();
             void reloadModels();
+
+            /**
+             * Returns whether all brushes have been validated. Brushes are validated incrementally while rendering,
+             * so if this returns false after rendering, another frame should be rendered.
+             */
+            bool valid() const;
         public: // configuration
             void setShowOverlays(bool showOverlays);
             void setEntityOverlayTextColor(const Color& overlayTextColor);
@@ -90,6 +105,7 @@ namespace TrenchBroom {
             void setBrushEdgeColor(const Color& brushEdgeColor);
 
             void setShowHiddenObjects(bool showHiddenObjects);
+            void setOcclusionCulling(bool occlusionCulling);
         public: // rendering
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
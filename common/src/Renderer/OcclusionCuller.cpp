@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OcclusionCuller.h"
+
+#include "Renderer/GLVertexType.h"
+#include "Renderer/PrimType.h"
+
+#include <cmath>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * Each cluster's bounds are rendered as six quads.
+         */
+        static constexpr size_t VerticesPerCluster = 24u;
+
+        OcclusionCuller::OcclusionCuller(const float cellSize, const float margin) :
+        m_cellSize(cellSize),
+        m_margin(margin) {}
+
+        void OcclusionCuller::clear() {
+            for (auto& entry : m_clusters) {
+                if (entry.second.query != 0) {
+                    glAssert(glDeleteQueries(1, &entry.second.query));
+                }
+            }
+            m_clusters.clear();
+            m_queriedClusters.clear();
+        }
+
+        void OcclusionCuller::beginFrame(const vm::vec3f& cameraPosition, const bool conservative) {
+            m_cameraPosition = cameraPosition;
+
+            for (auto& entry : m_clusters) {
+                auto& cluster = entry.second;
+                cluster.used = false;
+
+                if (cluster.queryPending) {
+                    GLuint available = GL_FALSE;
+                    glAssert(glGetQueryObjectuiv(cluster.query, GL_QUERY_RESULT_AVAILABLE, &available));
+                    if (available != GL_FALSE) {
+                        GLuint samples = 0;
+                        glAssert(glGetQueryObjectuiv(cluster.query, GL_QUERY_RESULT, &samples));
+                        cluster.occluded = samples == 0;
+                        cluster.queryPending = false;
+                    } else if (conservative) {
+                        cluster.occluded = false;
+                    }
+                }
+            }
+        }
+
+        bool OcclusionCuller::visible(const vm::bbox3f& bounds) {
+            auto& cluster = m_clusters[clusterKey(bounds.center())];
+            if (!cluster.used) {
+                cluster.bounds = bounds;
+                cluster.used = true;
+            } else {
+                cluster.bounds = vm::merge(cluster.bounds, bounds);
+            }
+            return !cluster.occluded;
+        }
+
+        std::uint64_t OcclusionCuller::clusterKey(const vm::vec3f& position) const {
+            // pack the cell coordinates into 21 bits each, which covers any sensible world size
+            std::uint64_t key = 0;
+            for (size_t i = 0; i < 3; ++i) {
+                const auto cell = static_cast<std::int64_t>(std::floor(position[i] / m_cellSize)) + (1 << 20);
+                key = (key << 21) | (static_cast<std::uint64_t>(cell) & 0x1FFFFF);
+            }
+            return key;
+        }
+
+        void OcclusionCuller::doPrepareVertices(VboManager& vboManager) {
+            using Vertex = GLVertexTypes::P3::Vertex;
+
+            std::vector<Vertex> vertices;
+            m_queriedClusters.clear();
+
+            for (auto& entry : m_clusters) {
+                auto& cluster = entry.second;
+                if (!cluster.used || cluster.queryPending) {
+                    continue;
+                }
+
+                const auto bounds = cluster.bounds.expand(m_margin);
+                if (bounds.contains(m_cameraPosition)) {
+                    // the clusters's proxy would be clipped by the near plane
+                    cluster.occluded = false;
+                    continue;
+                }
+
+                const auto& min = bounds.min;
+                const auto& max = bounds.max;
+                const vm::vec3f corners[8] = {
+                    vm::vec3f(min.x(), min.y(), min.z()),
+                    vm::vec3f(max.x(), min.y(), min.z()),
+                    vm::vec3f(max.x(), max.y(), min.z()),
+                    vm::vec3f(min.x(), max.y(), min.z()),
+                    vm::vec3f(min.x(), min.y(), max.z()),
+                    vm::vec3f(max.x(), min.y(), max.z()),
+                    vm::vec3f(max.x(), max.y(), max.z()),
+                    vm::vec3f(min.x(), max.y(), max.z())
+                };
+                static const size_t faces[VerticesPerCluster] = {
+                    0, 1, 2, 3, // bottom
+                    4, 5, 6, 7, // top
+                    0, 1, 5, 4, // front
+                    3, 2, 6, 7, // back
+                    0, 3, 7, 4, // left
+                    1, 2, 6, 5  // right
+                };
+                for (const auto index : faces) {
+                    vertices.emplace_back(corners[index]);
+                }
+
+                m_queriedClusters.push_back(&cluster);
+            }
+
+            m_vertexArray = VertexArray::move(std::move(vertices));
+            m_vertexArray.prepare(vboManager);
+        }
+
+        void OcclusionCuller::doRender(RenderContext&) {
+            if (m_queriedClusters.empty()) {
+                return;
+            }
+
+            glAssert(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+            glAssert(glDepthMask(GL_FALSE));
+            glAssert(glDisable(GL_CULL_FACE));
+
+            m_vertexArray.setup();
+            for (size_t i = 0; i < m_queriedClusters.size(); ++i) {
+                auto* cluster = m_queriedClusters[i];
+                if (cluster->query == 0) {
+                    glAssert(glGenQueries(1, &cluster->query));
+                }
+
+                glAssert(glBeginQuery(GL_SAMPLES_PASSED, cluster->query));
+                m_vertexArray.render(PrimType::Quads, static_cast<GLint>(i * VerticesPerCluster), static_cast<GLsizei>(VerticesPerCluster));
+                glAssert(glEndQuery(GL_SAMPLES_PASSED));
+
+                cluster->queryPending = true;
+            }
+            m_vertexArray.cleanup();
+
+            glAssert(glEnable(GL_CULL_FACE));
+            glAssert(glDepthMask(GL_TRUE));
+            glAssert(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+
+            m_queriedClusters.clear();
+        }
+    }
+}
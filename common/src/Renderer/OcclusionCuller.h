@@ -0,0 +1,102 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_OcclusionCuller
+#define TrenchBroom_OcclusionCuller
+
+#include "Macros.h"
+#include "Renderer/GL.h"
+#include "Renderer/Renderable.h"
+#include "Renderer/VertexArray.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class RenderContext;
+        class VboManager;
+
+        /**
+         * Culls objects that are hidden behind other geometry using hardware occlusion queries.
+         *
+         * Objects are grouped into clusters by the grid cell that contains the center of their bounds. When this
+         * renderable is rendered after the opaque geometry, the bounds of every cluster are drawn with an occlusion
+         * query, and if no samples pass, the objects of that cluster are culled in the following frames. Only
+         * results that are already available are used, so rendering never waits for a query, but objects that
+         * become visible may appear a frame late.
+         */
+        class OcclusionCuller : public DirectRenderable {
+        private:
+            struct Cluster {
+                vm::bbox3f bounds;
+                bool used;
+                GLuint query;
+                bool queryPending;
+                bool occluded;
+            };
+
+            float m_cellSize;
+            float m_margin;
+            vm::vec3f m_cameraPosition;
+            std::unordered_map<std::uint64_t, Cluster> m_clusters;
+
+            VertexArray m_vertexArray;
+            std::vector<Cluster*> m_queriedClusters;
+        public:
+            /**
+             * Creates a new occlusion culler that groups objects into cubic cells of the given size. The bounds of
+             * each cluster are expanded by the given margin when testing for occlusion.
+             */
+            explicit OcclusionCuller(float cellSize = 1024.0f, float margin = 8.0f);
+
+            /**
+             * Deletes the occlusion queries and forgets all clusters. Must be called while the OpenGL context is
+             * current, otherwise the queries are leaked.
+             */
+            void clear();
+
+            /**
+             * Starts a new frame and collects the results of the queries issued previously. Clusters whose results
+             * are not available yet are considered visible if `conservative` is true, otherwise their last known
+             * result is kept.
+             */
+            void beginFrame(const vm::vec3f& cameraPosition, bool conservative);
+
+            /**
+             * Returns whether an object with the given bounds may be visible, and adds the bounds to its cluster's
+             * occlusion test proxy for this frame.
+             */
+            bool visible(const vm::bbox3f& bounds);
+        private:
+            std::uint64_t clusterKey(const vm::vec3f& position) const;
+
+            void doPrepareVertices(VboManager& vboManager) override;
+            void doRender(RenderContext& renderContext) override;
+
+            deleteCopyAndMove(OcclusionCuller)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_OcclusionCuller) */
@@ -23,32 +23,105 @@
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
 #include "Renderer/Camera.h"
+#include "Renderer/PrimType.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderUtils.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/VboManager.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/constants.h>
 #include <vecmath/vec.h>
 #include <vecmath/mat_ext.h>
 
 namespace TrenchBroom {
     namespace Renderer {
+        namespace {
+            /**
+             * Returns the screen space position at which to render a handle at the given position.
+             */
+            vm::vec3f handleOffset(const Camera& camera, const vm::vec3f& position) {
+                // nudge  towards camera by the handle radius, to prevent lines (brush edges, etc.) from clipping into the handle
+                const vm::vec3f nudgeTowardsCamera = vm::normalize(camera.position() - position) * pref(Preferences::HandleRadius);
+                return camera.project(position + nudgeTowardsCamera) * vm::vec3f(1.0f, 1.0f, -1.0f);
+            }
+
+            /**
+             * Returns the screen space positions at which to render handles at the given positions.
+             */
+            std::vector<vm::vec3f> handleOffsets(const Camera& camera, const std::vector<vm::vec3f>& positions) {
+                const float handleRadius = pref(Preferences::HandleRadius);
+
+                std::vector<vm::vec3f> nudgedPositions;
+                nudgedPositions.reserve(positions.size());
+                for (const vm::vec3f& position : positions) {
+                    nudgedPositions.push_back(position + vm::normalize(camera.position() - position) * handleRadius);
+                }
+
+                auto result = camera.project(nudgedPositions);
+                for (vm::vec3f& offset : result) {
+                    offset[2] = -offset[2];
+                }
+                return result;
+            }
+
+            /**
+             * Creates a vertex array containing a circle with the given closed outline at each of the given offsets. The
+             * circles are made of triangles if filled is true and of lines otherwise.
+             */
+            template <typename Vertex>
+            VertexArray createCircles(const std::vector<vm::vec3f>& offsets, const std::vector<vm::vec2f>& outline, const bool filled) {
+                const size_t segments = outline.size() - 1u;
+
+                std::vector<Vertex> vertices;
+                vertices.reserve(offsets.size() * segments * (filled ? 3u : 2u));
+
+                for (const vm::vec3f& offset : offsets) {
+                    for (size_t i = 0; i < segments; ++i) {
+                        if (filled) {
+                            vertices.emplace_back(offset);
+                        }
+                        vertices.emplace_back(offset + vm::vec3f(outline[i], 0.0f));
+                        vertices.emplace_back(offset + vm::vec3f(outline[i + 1u], 0.0f));
+                    }
+                }
+
+                return VertexArray::move(std::move(vertices));
+            }
+        }
+
         PointHandleRenderer::PointHandleRenderer() :
-        m_handle(pref(Preferences::HandleRadius), 16, true),
-        m_highlight(2.0f * pref(Preferences::HandleRadius), 16, false) {}
+        m_handleOutline(circle2D(pref(Preferences::HandleRadius), 0.0f, vm::Cf::two_pi(), 16)),
+        m_highlightOutline(circle2D(2.0f * pref(Preferences::HandleRadius), 0.0f, vm::Cf::two_pi(), 16)) {}
+
+        void PointHandleRenderer::addPoint(const Camera& camera, const Color& color, const vm::vec3f& position) {
+            m_pointHandles[color].push_back(handleOffset(camera, position));
+        }
 
-        void PointHandleRenderer::addPoint(const Color& color, const vm::vec3f& position) {
-            m_pointHandles[color].push_back(position);
+        void PointHandleRenderer::addPoints(const Camera& camera, const Color& color, const std::vector<vm::vec3f>& positions) {
+            auto& offsets = m_pointHandles[color];
+            if (offsets.empty()) {
+                offsets = handleOffsets(camera, positions);
+            } else {
+                const auto newOffsets = handleOffsets(camera, positions);
+                offsets.insert(std::end(offsets), std::begin(newOffsets), std::end(newOffsets));
+            }
         }
 
-        void PointHandleRenderer::addHighlight(const Color& color, const vm::vec3f& position) {
-            m_highlights[color].push_back(position);
+        void PointHandleRenderer::addHighlight(const Camera& camera, const Color& color, const vm::vec3f& position) {
+            m_highlights[color].push_back(handleOffset(camera, position));
         }
 
         void PointHandleRenderer::doPrepareVertices(VboManager& vboManager) {
-            m_handle.prepare(vboManager);
-            m_highlight.prepare(vboManager);
+            for (const auto& [color, offsets] : m_pointHandles) {
+                auto& array = m_pointHandleArrays[color] = createCircles<Vertex>(offsets, m_handleOutline, true);
+                array.prepare(vboManager);
+            }
+            for (const auto& [color, offsets] : m_highlights) {
+                auto& array = m_highlightArrays[color] = createCircles<Vertex>(offsets, m_highlightOutline, false);
+                array.prepare(vboManager);
+            }
         }
 
         void PointHandleRenderer::doRender(RenderContext& renderContext) {
@@ -64,40 +137,32 @@ namespace TrenchBroom {
             ReplaceTransformation ortho(renderContext.transformation(), projection, view);
 
             // Un-occluded handles: use depth test, draw fully opaque
-            renderHandles(renderContext, m_pointHandles, m_handle, 1.0f);
-            renderHandles(renderContext, m_highlights, m_highlight, 1.0f);
+            renderHandles(renderContext, m_pointHandleArrays, PrimType::Triangles, 1.0f);
+            renderHandles(renderContext, m_highlightArrays, PrimType::Lines, 1.0f);
 
             // Occluded handles: don't use depth test, but draw translucent
             glAssert(glDisable(GL_DEPTH_TEST));
-            renderHandles(renderContext, m_pointHandles, m_handle, 0.33f);
-            renderHandles(renderContext, m_highlights, m_highlight, 0.33f);
+            renderHandles(renderContext, m_pointHandleArrays, PrimType::Triangles, 0.33f);
+            renderHandles(renderContext, m_highlightArrays, PrimType::Lines, 0.33f);
             glAssert(glEnable(GL_DEPTH_TEST));
 
             clear();
         }
 
-        void PointHandleRenderer::renderHandles(RenderContext& renderContext, const HandleMap& map, Circle& circle, const float opacity) {
-            const Camera& camera = renderContext.camera();
+        void PointHandleRenderer::renderHandles(RenderContext& renderContext, ArrayMap& arrays, const PrimType primType, const float opacity) {
             ActiveShader shader(renderContext.shaderManager(), Shaders::HandleShader);
 
-            for (const auto& entry : map) {
-                const Color color = mixAlpha(entry.first, opacity);
-                shader.set("Color", color);
-
-                for (const vm::vec3f& position : entry.second) {
-                    // nudge  towards camera by the handle radius, to prevent lines (brush edges, etc.) from clipping into the handle
-                    const vm::vec3f nudgeTowardsCamera = vm::normalize(camera.position() - position) * pref(Preferences::HandleRadius);
-
-                    const vm::vec3f offset = camera.project(position + nudgeTowardsCamera) * vm::vec3f(1.0f, 1.0f, -1.0f);
-                    MultiplyModelMatrix translate(renderContext.transformation(), vm::translation_matrix(offset));
-                    circle.render();
-                }
+            for (auto& [color, array] : arrays) {
+                shader.set("Color", mixAlpha(color, opacity));
+                array.render(primType);
             }
         }
 
         void PointHandleRenderer::clear() {
             m_pointHandles.clear();
             m_highlights.clear();
+            m_pointHandleArrays.clear();
+            m_highlightArrays.clear();
         }
     }
 }
@@ -21,37 +21,56 @@
 #define TrenchBroom_PointHandleRenderer
 
 #include "Color.h"
-#include "Renderer/Circle.h"
+#include "Renderer/GLVertexType.h"
+#include "Renderer/PrimType.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/VertexArray.h"
 
 #include <vecmath/forward.h>
 
 #include <map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
         class ActiveShader;
+        class Camera;
         class RenderContext;
         class VboManager;
 
+        /**
+         * Renders point handles as circles of a fixed size in screen space. The circles of all handles with the same
+         * color are combined into one vertex array, so that each color takes a single draw call regardless of the
+         * number of handles.
+         */
         class PointHandleRenderer : public DirectRenderable {
         private:
+            using Vertex = GLVertexTypes::P3::Vertex;
+
+            /**
+             * Maps a color to the screen space positions of the handles with that color.
+             */
             using HandleMap = std::map<Color, std::vector<vm::vec3f>>;
+            using ArrayMap = std::map<Color, VertexArray>;
 
             HandleMap m_pointHandles;
             HandleMap m_highlights;
 
-            Circle m_handle;
-            Circle m_highlight;
+            ArrayMap m_pointHandleArrays;
+            ArrayMap m_highlightArrays;
+
+            std::vector<vm::vec2f> m_handleOutline;
+            std::vector<vm::vec2f> m_highlightOutline;
         public:
             PointHandleRenderer();
 
-            void addPoint(const Color& color, const vm::vec3f& position);
-            void addHighlight(const Color& color, const vm::vec3f& position);
+            void addPoint(const Camera& camera, const Color& color, const vm::vec3f& position);
+            void addPoints(const Camera& camera, const Color& color, const std::vector<vm::vec3f>& positions);
+            void addHighlight(const Camera& camera, const Color& color, const vm::vec3f& position);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
-            void renderHandles(RenderContext& renderContext, const HandleMap& map, Circle& circle, float opacity);
+            void renderHandles(RenderContext& renderContext, ArrayMap& arrays, PrimType primType, float opacity);
 
             void clear();
         };
@@ -22,6 +22,7 @@
 #include "Color.h"
 #include "Renderer/ActiveShader.h"
 #include "Renderer/IndexRangeRenderer.h"
+#include "Renderer/IndexRangeMap.h"
 #include "Renderer/IndexRangeMapBuilder.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
@@ -33,6 +34,9 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/scalar.h>
 
+#include <map>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         PrimitiveRenderer::LineRenderAttributes::LineRenderAttributes(const Color& color, const float lineWidth, const PrimitiveRendererOcclusionPolicy occlusionPolicy) :
@@ -240,25 +244,55 @@ namespace TrenchBroom {
             m_triangleMeshes[TriangleRenderAttributes(color, occlusionPolicy, cullingPolicy)].addTriangleStrip(Vertex::toList(vertices.size(), std::begin(vertices)));
         }
 
-        void PrimitiveRenderer::doPrepareVertices(VboManager& vboManager) {
-            prepareLines(vboManager);
-            prepareTriangles(vboManager);
+        /**
+         * Appends the vertices of the given mesh to the given vertices and returns the mesh's primitives, offset to
+         * where its vertices were appended.
+         */
+        template <typename VertexSpec>
+        static IndexRangeMap appendMesh(IndexRangeMapBuilder<VertexSpec>& mesh, std::vector<typename VertexSpec::Vertex>& vertices) {
+            const auto offset = vertices.size();
+            const auto& meshVertices = mesh.vertices();
+            vertices.insert(std::end(vertices), std::begin(meshVertices), std::end(meshVertices));
+
+            IndexRangeMap indices(mesh.indices().size());
+            mesh.indices().forEachPrimitive([&](const PrimType primType, const size_t index, const size_t count) {
+                indices.add(primType, offset + index, count);
+            });
+            return indices;
         }
 
-        void PrimitiveRenderer::prepareLines(VboManager& vboManager) {
+        void PrimitiveRenderer::doPrepareVertices(VboManager& vboManager) {
+            // the meshes of all styles share one vertex array, so that their vertices are uploaded into a single buffer
+            size_t vertexCount = 0u;
+            for (const auto& entry : m_lineMeshes) {
+                vertexCount += entry.second.vertices().size();
+            }
+            for (const auto& entry : m_triangleMeshes) {
+                vertexCount += entry.second.vertices().size();
+            }
+
+            std::vector<Vertex> vertices;
+            vertices.reserve(vertexCount);
+
+            std::map<LineRenderAttributes, IndexRangeMap> lineIndices;
             for (auto& entry : m_lineMeshes) {
-                const LineRenderAttributes& attributes = entry.first;
-                IndexRangeMapBuilder<Vertex::Type>& mesh = entry.second;
-                IndexRangeRenderer& renderer = m_lineMeshRenderers.insert(std::make_pair(attributes, IndexRangeRenderer(mesh))).first->second;
-                renderer.prepare(vboManager);
+                lineIndices.emplace(entry.first, appendMesh(entry.second, vertices));
             }
-        }
 
-        void PrimitiveRenderer::prepareTriangles(VboManager& vboManager) {
+            std::map<TriangleRenderAttributes, IndexRangeMap> triangleIndices;
             for (auto& entry : m_triangleMeshes) {
-                const TriangleRenderAttributes& attributes = entry.first;
-                IndexRangeMapBuilder<Vertex::Type>& mesh = entry.second;
-                IndexRangeRenderer& renderer = m_triangleMeshRenderers.insert(std::make_pair(attributes, IndexRangeRenderer(mesh))).first->second;
+                triangleIndices.emplace(entry.first, appendMesh(entry.second, vertices));
+            }
+
+            const auto vertexArray = VertexArray::move(std::move(vertices));
+
+            for (const auto& entry : lineIndices) {
+                IndexRangeRenderer& renderer = m_lineMeshRenderers.insert(std::make_pair(entry.first, IndexRangeRenderer(vertexArray, entry.second))).first->second;
+                renderer.prepare(vboManager);
+            }
+
+            for (const auto& entry : triangleIndices) {
+                IndexRangeRenderer& renderer = m_triangleMeshRenderers.insert(std::make_pair(entry.first, IndexRangeRenderer(vertexArray, entry.second))).first->second;
                 renderer.prepare(vboManager);
             }
         }
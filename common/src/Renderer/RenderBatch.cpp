@@ -20,7 +20,10 @@
 #include "RenderBatch.h"
 
 #include "Ensure.h"
+#include "Renderer/FrameProfiler.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/ShaderManager.h"
 #include "Renderer/VboManager.h"
 
 #include <kdl/vector_utils.h>
@@ -45,6 +48,10 @@ namespace TrenchBroom {
             }
         };
 
+        RenderBatch::Statistics::Statistics() :
+        renderables(0),
+        programSwitches(0) {}
+
         RenderBatch::RenderBatch(VboManager& vboManager) :
         m_vboManager(vboManager) {}
 
@@ -88,8 +95,18 @@ namespace TrenchBroom {
         }
 
         void RenderBatch::render(RenderContext& renderContext) {
+            FrameProfiler::Scope scope("RenderBatch::render");
+            const auto programSwitches = renderContext.shaderManager().programSwitches();
+
             prepareRenderables();
             renderRenderables(renderContext);
+
+            m_statistics.renderables = m_batch.size();
+            m_statistics.programSwitches = renderContext.shaderManager().programSwitches() - programSwitches;
+        }
+
+        const RenderBatch::Statistics& RenderBatch::statistics() const {
+            return m_statistics;
         }
 
         void RenderBatch::doAdd(Renderable* renderable) {
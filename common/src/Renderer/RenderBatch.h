@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_RenderBatch
 #define TrenchBroom_RenderBatch
 
+#include <cstddef>
 #include <vector>
 
 namespace TrenchBroom {
@@ -31,6 +32,16 @@ namespace TrenchBroom {
         class VboManager;
 
         class RenderBatch {
+        public:
+            /**
+             * Counts the work done by the last call to render().
+             */
+            struct Statistics {
+                size_t renderables;
+                size_t programSwitches;
+
+                Statistics();
+            };
         private:
             VboManager& m_vboManager;
 
@@ -45,6 +56,8 @@ namespace TrenchBroom {
 
             RenderableList m_batch;
             RenderableList m_oneshots;
+
+            Statistics m_statistics;
         public:
             explicit RenderBatch(VboManager& vboManager);
             ~RenderBatch();
@@ -62,6 +75,8 @@ namespace TrenchBroom {
             void addOneShot(IndexedRenderable* renderable);
 
             void render(RenderContext& renderContext);
+
+            const Statistics& statistics() const;
         private:
             void doAdd(Renderable* renderable);
 
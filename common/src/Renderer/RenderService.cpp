@@ -142,16 +142,15 @@ namespace TrenchBroom {
         }
 
         void RenderService::renderHandles(const std::vector<vm::vec3f>& positions) {
-            for (const vm::vec3f& position : positions)
-                renderHandle(position);
+            m_pointHandleRenderer->addPoints(m_renderContext.camera(), m_foregroundColor, positions);
         }
 
         void RenderService::renderHandle(const vm::vec3f& position) {
-            m_pointHandleRenderer->addPoint(m_foregroundColor, position);
+            m_pointHandleRenderer->addPoint(m_renderContext.camera(), m_foregroundColor, position);
         }
 
         void RenderService::renderHandleHighlight(const vm::vec3f& position) {
-            m_pointHandleRenderer->addHighlight(m_foregroundColor, position);
+            m_pointHandleRenderer->addHighlight(m_renderContext.camera(), m_foregroundColor, position);
         }
 
         void RenderService::renderHandles(const std::vector<vm::segment3f>& positions) {
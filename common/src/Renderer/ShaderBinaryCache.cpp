@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ShaderBinaryCache.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/MapCache.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        namespace {
+            const char Magic[] = { 'T', 'B', 'S', 'C' };
+            const uint32_t Version = 1u;
+
+            template <typename T>
+            void writeValue(std::ostream& stream, const T value) {
+                stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+        }
+
+        ShaderBinaryCache::ShaderBinaryCache(const IO::Path& directory, const std::string& driver) :
+        m_directory(directory),
+        m_driver(driver) {
+            try {
+                IO::Disk::ensureDirectoryExists(m_directory);
+            } catch (const FileSystemException&) {
+                // writing the entries will fail, and so the cache is just never used
+            }
+        }
+
+        IO::Path ShaderBinaryCache::entryPath(const std::string& name, const std::string& source) const {
+            const auto key = m_driver + '\0' + name + '\0' + source;
+
+            std::stringstream entryName;
+            entryName << std::hex << IO::MapCache::hash(key.data(), key.data() + key.size()) << ".tbshader";
+            return m_directory + IO::Path(entryName.str());
+        }
+
+        bool ShaderBinaryCache::readBinary(const IO::Path& entryPath, GLenum& format, std::vector<char>& binary) const {
+            std::ifstream stream(entryPath.asString().c_str(), std::ios::in | std::ios::binary);
+            if (!stream.is_open()) {
+                return false;
+            }
+
+            const auto contents = std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            if (contents.size() < sizeof(Magic) || std::memcmp(contents.data(), Magic, sizeof(Magic)) != 0) {
+                return false;
+            }
+
+            try {
+                auto reader = IO::Reader::from(contents.data() + sizeof(Magic), contents.data() + contents.size());
+                if (reader.readUnsignedInt<uint32_t>() != Version) {
+                    return false;
+                }
+
+                format = static_cast<GLenum>(reader.readUnsignedInt<uint32_t>());
+                const auto size = reader.readSize<uint64_t>();
+                if (size == 0u || !reader.canRead(size)) {
+                    return false;
+                }
+
+                binary.resize(size);
+                reader.read(binary.data(), size);
+                return true;
+            } catch (const IO::ReaderException&) {
+                return false;
+            }
+        }
+
+        void ShaderBinaryCache::writeBinary(const IO::Path& entryPath, const GLenum format, const std::vector<char>& binary) const {
+            // the programs are only linked on the thread which owns the OpenGL context, so there is no concurrent writer
+            const auto tempPath = entryPath.addExtension("tmp");
+            {
+                std::ofstream stream(tempPath.asString().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!stream.is_open()) {
+                    return;
+                }
+
+                stream.write(Magic, sizeof(Magic));
+                writeValue(stream, Version);
+                writeValue(stream, static_cast<uint32_t>(format));
+                writeValue(stream, static_cast<uint64_t>(binary.size()));
+                stream.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+
+                if (!stream) {
+                    stream.close();
+                    std::remove(tempPath.asString().c_str());
+                    return;
+                }
+            }
+
+            std::remove(entryPath.asString().c_str());
+            if (std::rename(tempPath.asString().c_str(), entryPath.asString().c_str()) != 0) {
+                std::remove(tempPath.asString().c_str());
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ShaderBinaryCache
+#define TrenchBroom_ShaderBinaryCache
+
+#include "IO/Path.h"
+#include "Renderer/GL.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * A shader binary cache is a directory that stores linked shader program binaries as returned by the driver, so that
+         * a program which has been linked before can be loaded without compiling its shaders again.
+         *
+         * Every entry is a file named after a hash of the driver identification and the sources of the program's
+         * shaders, so an entry is only found for the same driver and identical shader sources. Since a driver may
+         * still reject a binary (e.g. after an update which did not change its version string), a program must be
+         * compiled from source if loading its cached binary fails.
+         */
+        class ShaderBinaryCache {
+        private:
+            IO::Path m_directory;
+            std::string m_driver;
+        public:
+            /**
+             * Creates a shader binary cache that stores its entries in the given directory, which is created if it does not
+             * exist.
+             *
+             * @param directory the cache directory
+             * @param driver a string that identifies the OpenGL driver, i.e. its vendor, renderer and version
+             */
+            ShaderBinaryCache(const IO::Path& directory, const std::string& driver);
+
+            /**
+             * Returns the path of the cache entry for a program with the given name and shader sources.
+             *
+             * @param name the name of the program
+             * @param source the concatenated sources of all shaders of the program
+             * @return the path of the cache entry
+             */
+            IO::Path entryPath(const std::string& name, const std::string& source) const;
+
+            /**
+             * Reads the program binary stored in the cache entry with the given path.
+             *
+             * @param entryPath the path of the cache entry
+             * @param format receives the binary format
+             * @param binary receives the binary
+             * @return true if the entry exists and is valid, and false otherwise
+             */
+            bool readBinary(const IO::Path& entryPath, GLenum& format, std::vector<char>& binary) const;
+
+            /**
+             * Writes the given program binary to the cache entry with the given path. Failing to write the entry is
+             * not an error, since the program is then just compiled again when it is needed the next time.
+             */
+            void writeBinary(const IO::Path& entryPath, GLenum format, const std::vector<char>& binary) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_ShaderBinaryCache) */
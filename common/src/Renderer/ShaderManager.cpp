@@ -19,19 +19,31 @@
 
 #include "ShaderManager.h"
 
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
 #include "IO/Path.h"
 #include "IO/SystemPaths.h"
 #include "Renderer/Shader.h"
+#include "Renderer/ShaderBinaryCache.h"
 #include "Renderer/ShaderProgram.h"
 #include "Renderer/ShaderConfig.h"
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
+        ShaderManager::ShaderManager() :
+        m_currentProgram(nullptr),
+        m_programSwitches(0) {}
+
         ShaderManager::~ShaderManager() = default;
 
+        void ShaderManager::setBinaryCache(std::unique_ptr<ShaderBinaryCache> binaryCache) {
+            m_binaryCache = std::move(binaryCache);
+        }
+
         ShaderProgram& ShaderManager::program(const ShaderConfig& config) {
             auto it = m_programs.find(&config);
             if (it != std::end(m_programs)) {
@@ -44,7 +56,66 @@ namespace TrenchBroom {
             return *(result.first->second);
         }
 
+        void ShaderManager::prewarm(const std::vector<const ShaderConfig*>& configs) {
+            m_pendingPrograms.insert(std::end(m_pendingPrograms), std::begin(configs), std::end(configs));
+        }
+
+        bool ShaderManager::prewarmNext() {
+            while (!m_pendingPrograms.empty()) {
+                const auto* config = m_pendingPrograms.front();
+                m_pendingPrograms.pop_front();
+
+                if (m_programs.count(config) == 0u) {
+                    try {
+                        program(*config).prepare();
+                    } catch (const Exception&) {
+                        // the error is reported when the program is used
+                    }
+                    break;
+                }
+            }
+            return !m_pendingPrograms.empty();
+        }
+
+        ShaderProgram* ShaderManager::currentProgram() const {
+            return m_currentProgram;
+        }
+
+        void ShaderManager::setCurrentProgram(ShaderProgram* program) {
+            if (program != m_currentProgram) {
+                m_currentProgram = program;
+                ++m_programSwitches;
+            }
+        }
+
+        size_t ShaderManager::programSwitches() const {
+            return m_programSwitches;
+        }
+
         std::unique_ptr<ShaderProgram> ShaderManager::createProgram(const ShaderConfig& config) {
+            if (!m_binaryCache) {
+                return compileProgram(config);
+            }
+
+            const auto entryPath = m_binaryCache->entryPath(config.name(), loadSource(config));
+
+            GLenum format;
+            std::vector<char> binary;
+            if (m_binaryCache->readBinary(entryPath, format, binary)) {
+                auto program = std::make_unique<ShaderProgram>(config.name());
+                if (program->loadBinary(format, binary)) {
+                    return program;
+                }
+            }
+
+            auto program = compileProgram(config);
+            if (program->retrieveBinary(format, binary)) {
+                m_binaryCache->writeBinary(entryPath, format, binary);
+            }
+            return program;
+        }
+
+        std::unique_ptr<ShaderProgram> ShaderManager::compileProgram(const ShaderConfig& config) {
             auto program = std::make_unique<ShaderProgram>(config.name());
 
             for (const auto& path : config.vertexShaders()) {
@@ -72,5 +143,16 @@ namespace TrenchBroom {
 
             return *(result.first->second);
         }
+
+        std::string ShaderManager::loadSource(const ShaderConfig& config) const {
+            std::string result;
+            for (const auto* names : { &config.vertexShaders(), &config.fragmentShaders() }) {
+                for (const auto& name : *names) {
+                    const auto shaderPath = IO::SystemPaths::findResourceFile(IO::Path("shader") + IO::Path(name));
+                    result += name + '\0' + IO::Disk::readFile(shaderPath) + '\0';
+                }
+            }
+            return result;
+        }
     }
 }
@@ -22,13 +22,16 @@
 
 #include "Renderer/GL.h"
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
         class Shader;
+        class ShaderBinaryCache;
         class ShaderConfig;
         class ShaderProgram;
 
@@ -39,13 +42,55 @@ namespace TrenchBroom {
 
             ShaderCache m_shaders;
             ShaderProgramCache m_programs;
+            std::unique_ptr<ShaderBinaryCache> m_binaryCache;
+            std::deque<const ShaderConfig*> m_pendingPrograms;
+
+            ShaderProgram* m_currentProgram;
+            size_t m_programSwitches;
         public:
+            ShaderManager();
             ~ShaderManager();
         public:
+            /**
+             * Stores the binaries of all programs linked from now on in the given cache, and loads programs from the
+             * cache instead of compiling their shaders where possible.
+             */
+            void setBinaryCache(std::unique_ptr<ShaderBinaryCache> binaryCache);
+
             ShaderProgram& program(const ShaderConfig& config);
+
+            /**
+             * Queues the given programs to be created and linked by subsequent calls to prewarmNext().
+             */
+            void prewarm(const std::vector<const ShaderConfig*>& configs);
+
+            /**
+             * Creates and links the next program that was queued by a call to prewarm() and has not been created yet.
+             * The OpenGL context must be current.
+             *
+             * @return true if there are more programs left to prewarm, and false otherwise
+             */
+            bool prewarmNext();
+
+            /**
+             * Returns the program that is currently in use, or null if no program is in use.
+             */
+            ShaderProgram* currentProgram() const;
+
+            /**
+             * Records that the given program is now in use. Pass null if no program is in use.
+             */
+            void setCurrentProgram(ShaderProgram* program);
+
+            /**
+             * Returns the number of times the program in use has changed since this shader manager was created.
+             */
+            size_t programSwitches() const;
         private:
             std::unique_ptr<ShaderProgram> createProgram(const ShaderConfig& config);
+            std::unique_ptr<ShaderProgram> compileProgram(const ShaderConfig& config);
             Shader& loadShader(const std::string& name, const GLenum type);
+            std::string loadSource(const ShaderConfig& config) const;
         };
     }
 }
@@ -28,7 +28,7 @@
 
 #include <memory>
 #include <string>
-#include <sstream>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -60,11 +60,60 @@ namespace TrenchBroom {
             m_needsLinking = true;
         }
 
-        void ShaderProgram::activate() {
+        void ShaderProgram::prepare() {
             assert(m_programId != 0);
 
             if (m_needsLinking)
                 link();
+        }
+
+        static bool supportsProgramBinaries() {
+            return GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary;
+        }
+
+        bool ShaderProgram::loadBinary(const GLenum format, const std::vector<char>& binary) {
+            assert(m_programId != 0);
+
+            if (!supportsProgramBinaries() || binary.empty()) {
+                return false;
+            }
+
+            glAssert(glProgramBinary(m_programId, format, binary.data(), static_cast<GLsizei>(binary.size())));
+
+            std::string infoLog;
+            if (!checkLinkStatus(infoLog)) {
+                m_needsLinking = true;
+                return false;
+            }
+
+            m_variableCache.clear();
+            m_needsLinking = false;
+            return true;
+        }
+
+        bool ShaderProgram::retrieveBinary(GLenum& format, std::vector<char>& binary) {
+            assert(m_programId != 0);
+
+            if (!supportsProgramBinaries()) {
+                return false;
+            }
+
+            prepare();
+
+            GLint length = 0;
+            glAssert(glGetProgramiv(m_programId, GL_PROGRAM_BINARY_LENGTH, &length));
+            if (length <= 0) {
+                return false;
+            }
+
+            binary.resize(static_cast<size_t>(length));
+            glAssert(glGetProgramBinary(m_programId, length, &length, &format, binary.data()));
+            binary.resize(static_cast<size_t>(length));
+            return length > 0;
+        }
+
+        void ShaderProgram::activate() {
+            prepare();
 
             glAssert(glUseProgram(m_programId));
             assert(checkActive());
@@ -129,32 +178,43 @@ namespace TrenchBroom {
         }
 
         void ShaderProgram::link() {
+            if (supportsProgramBinaries()) {
+                // the driver may only keep the binary of a program around if it is told so before linking
+                glAssert(glProgramParameteri(m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+            }
+
             glAssert(glLinkProgram(m_programId));
 
+            std::string infoLog;
+            if (!checkLinkStatus(infoLog)) {
+                throw RenderException("Could not link shader program " + m_name + ": " + infoLog);
+            }
+
+            m_variableCache.clear();
+            m_needsLinking = false;
+        }
+
+        bool ShaderProgram::checkLinkStatus(std::string& infoLog) const {
             GLint linkStatus = 0;
             glAssert(glGetProgramiv(m_programId, GL_LINK_STATUS, &linkStatus));
 
-            if (linkStatus == 0) {
-                auto str = std::stringstream();
-                str << "Could not link shader program " << m_name << ": ";
-
-                GLint infoLogLength = 0;
-                glAssert(glGetProgramiv(m_programId, GL_INFO_LOG_LENGTH, &infoLogLength));
-                if (infoLogLength > 0) {
-                    auto infoLog = std::make_unique<char[]>(static_cast<size_t>(infoLogLength));
-                    glAssert(glGetProgramInfoLog(m_programId, infoLogLength, &infoLogLength, infoLog.get()));
-                    infoLog[static_cast<size_t>(infoLogLength-1)] = 0;
+            if (linkStatus != 0) {
+                return true;
+            }
 
-                    str << infoLog.get();
-                } else {
-                    str << "Unknown error";
-                }
+            GLint infoLogLength = 0;
+            glAssert(glGetProgramiv(m_programId, GL_INFO_LOG_LENGTH, &infoLogLength));
+            if (infoLogLength > 0) {
+                auto buffer = std::make_unique<char[]>(static_cast<size_t>(infoLogLength));
+                glAssert(glGetProgramInfoLog(m_programId, infoLogLength, &infoLogLength, buffer.get()));
+                buffer[static_cast<size_t>(infoLogLength-1)] = 0;
 
-                throw RenderException(str.str());
+                infoLog = buffer.get();
+            } else {
+                infoLog = "Unknown error";
             }
 
-            m_variableCache.clear();
-            m_needsLinking = false;
+            return false;
         }
 
         GLint ShaderProgram::findUniformLocation(const std::string& name) const {
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -46,6 +47,27 @@ namespace TrenchBroom {
             void attach(Shader& shader);
             void detach(Shader& shader);
 
+            /**
+             * Links this program if it has not been linked since shaders were attached or detached.
+             */
+            void prepare();
+
+            /**
+             * Replaces the attached shaders by the given program binary, which must have been retrieved from a program
+             * with the same shaders by the same driver.
+             *
+             * @return true if the driver accepted the binary, and false otherwise, in which case shaders must be
+             * attached again
+             */
+            bool loadBinary(GLenum format, const std::vector<char>& binary);
+
+            /**
+             * Retrieves the binary of this program, linking it if necessary.
+             *
+             * @return true if the driver returned a binary, and false otherwise
+             */
+            bool retrieveBinary(GLenum& format, std::vector<char>& binary);
+
             void activate();
             void deactivate();
 
@@ -62,6 +84,7 @@ namespace TrenchBroom {
             void set(const std::string& name, const vm::mat4x4f& value);
         private:
             void link();
+            bool checkLinkStatus(std::string& infoLog) const;
             GLint findUniformLocation(const std::string& name) const;
             bool checkActive() const;
         };
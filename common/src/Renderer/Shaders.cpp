@@ -42,6 +42,28 @@ namespace TrenchBroom {
             const ShaderConfig EntityLinkArrowShader      = ShaderConfig("Entity Link Arrow",                { "EntityLinkArrow.vertsh" },      { "EntityLinkArrow.fragsh" });
             const ShaderConfig TriangleShader             = ShaderConfig("Shaded Triangles",                 { "Triangle.vertsh" },             { "Triangle.fragsh" });
             const ShaderConfig UVViewShader               = ShaderConfig("UV View",                          { "UVView.vertsh" },               { "UVView.fragsh" });
+
+            const std::vector<const ShaderConfig*> AllShaders = {
+                &Grid2DShader,
+                &VaryingPCShader,
+                &VaryingPUniformCShader,
+                &MiniMapEdgeShader,
+                &EntityModelShader,
+                &FaceShader,
+                &ColoredTextShader,
+                &TextBackgroundShader,
+                &TextureBrowserShader,
+                &TextureBrowserBorderShader,
+                &HandleShader,
+                &ColoredHandleShader,
+                &CompassShader,
+                &CompassOutlineShader,
+                &CompassBackgroundShader,
+                &EntityLinkShader,
+                &EntityLinkArrowShader,
+                &TriangleShader,
+                &UVViewShader
+            };
         }
     }
 }
@@ -22,6 +22,8 @@
 
 #include "Renderer/ShaderConfig.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         namespace Shaders {
@@ -44,6 +46,11 @@ namespace TrenchBroom {
             extern const ShaderConfig EntityLinkArrowShader;
             extern const ShaderConfig TriangleShader;
             extern const ShaderConfig UVViewShader;
+
+            /**
+             * All of the shaders above.
+             */
+            extern const std::vector<const ShaderConfig*> AllShaders;
         }
     }
 }
@@ -20,6 +20,7 @@
 #include "SpikeGuideRenderer.h"
 
 #include "Model/Hit.h"
+#include "Model/HitFilter.h"
 #include "Model/HitQuery.h"
 #include "Model/Brush.h"
 #include "Model/PickResult.h"
@@ -48,8 +49,15 @@ namespace TrenchBroom {
         }
 
         void SpikeGuideRenderer::add(const vm::ray3& ray, const FloatType length, std::shared_ptr<View::MapDocument> document) {
-            Model::PickResult pickResult = Model::PickResult::byDistance(document->editorContext());
-            document->pick(ray, pickResult);
+            const auto& editorContext = document->editorContext();
+            Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
+
+            const auto filter = Model::HitFilterChain(
+                std::make_unique<Model::TypedHitFilter>(Model::Brush::BrushHit),
+                std::make_unique<Model::HitFilterChain>(
+                    std::make_unique<Model::MinDistanceHitFilter>(1.0),
+                    std::make_unique<Model::ContextHitFilter>(editorContext)));
+            document->pickClosest(ray, filter, pickResult);
 
             const Model::Hit& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).occluded().minDistance(1.0).first();
             if (hit.isMatch()) {
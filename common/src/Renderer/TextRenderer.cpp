@@ -43,14 +43,11 @@ namespace TrenchBroom {
         const size_t TextRenderer::RectCornerSegments = 3;
         const float TextRenderer::RectCornerRadius = 3.0f;
 
-        TextRenderer::Entry::Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
-        size(i_size),
+        TextRenderer::Entry::Entry(std::shared_ptr<const TextureFont::StringLayout> i_layout, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
+        layout(std::move(i_layout)),
         offset(i_offset),
         textColor(i_textColor),
-        backgroundColor(i_backgroundColor) {
-            using std::swap;
-            swap(vertices, i_vertices);
-        }
+        backgroundColor(i_backgroundColor) {}
 
         TextRenderer::EntryCollection::EntryCollection() :
         textVertexCount(0),
@@ -77,28 +74,27 @@ namespace TrenchBroom {
             if (distance <= 0.0f)
                 return;
 
-            if (!isVisible(renderContext, string, position, distance, onTop))
-                return;
-
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
-            std::vector<vm::vec2f> vertices = font.quads(string, true);
+            auto layout = font.layout(string);
+            if (!isVisible(renderContext, layout->size, position, distance, onTop))
+                return;
+
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const vm::vec2f size = font.measure(string);
-            const vm::vec3f offset = position.offset(camera, size);
+            const vm::vec3f offset = position.offset(camera, layout->size);
 
             if (onTop)
-                addEntry(m_entriesOnTop, Entry(vertices, size, offset,
+                addEntry(m_entriesOnTop, Entry(std::move(layout), offset,
                                                Color(textColor, alphaFactor * textColor.a()),
                                                Color(backgroundColor, alphaFactor * backgroundColor.a())));
             else
-                addEntry(m_entries, Entry(vertices, size, offset,
+                addEntry(m_entries, Entry(std::move(layout), offset,
                                           Color(textColor, alphaFactor * textColor.a()),
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isVisible(RenderContext& renderContext, const vm::vec2f& stringSize, const TextAnchor& position, const float distance, const bool onTop) const {
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
@@ -109,7 +105,7 @@ namespace TrenchBroom {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.viewport();
 
-            const vm::vec2f size = stringSize(renderContext, string);
+            const vm::vec2f size = round(stringSize);
             const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
             const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -134,16 +130,10 @@ namespace TrenchBroom {
             }
         }
 
-        void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry) {
-            collection.entries.push_back(entry);
-            collection.textVertexCount += entry.vertices.size();
+        void TextRenderer::addEntry(EntryCollection& collection, Entry entry) {
+            collection.textVertexCount += entry.layout->vertices.size() / 2;
             collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
-        }
-
-        vm::vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
-            return round(font.measure(string));
+            collection.entries.push_back(std::move(entry));
         }
 
         void TextRenderer::doPrepareVertices(VboManager& vboManager) {
@@ -170,8 +160,8 @@ namespace TrenchBroom {
         }
 
         void TextRenderer::addEntry(const Entry& entry, const bool /* onTop */, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
-            const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-            const vm::vec2f& stringSize = entry.size;
+            const std::vector<vm::vec2f>& stringVertices = entry.layout->vertices;
+            const vm::vec2f& stringSize = entry.layout->size;
 
             const vm::vec3f& offset = entry.offset;
 
@@ -23,12 +23,14 @@
 #include "Color.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextureFont.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/GLVertexType.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -46,13 +48,12 @@ namespace TrenchBroom {
             static const float RectCornerRadius;
 
             struct Entry {
-                std::vector<vm::vec2f> vertices;
-                vm::vec2f size;
+                std::shared_ptr<const TextureFont::StringLayout> layout;
                 vm::vec3f offset;
                 Color textColor;
                 Color backgroundColor;
 
-                Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
+                Entry(std::shared_ptr<const TextureFont::StringLayout> i_layout, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
             };
 
             using EntryList = std::vector<Entry>;
@@ -86,11 +87,9 @@ namespace TrenchBroom {
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
 
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            bool isVisible(RenderContext& renderContext, const vm::vec2f& stringSize, const TextAnchor& position, float distance, bool onTop) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
-            void addEntry(EntryCollection& collection, const Entry& entry);
-
-            vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+            void addEntry(EntryCollection& collection, Entry entry);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void prepare(EntryCollection& collection, bool onTop, VboManager& vboManager);
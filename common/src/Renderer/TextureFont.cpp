@@ -32,6 +32,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedLayouts = 4096;
+
         TextureFont::TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, const int lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(std::move(texture)),
         m_glyphs(glyphs),
@@ -172,6 +174,25 @@ namespace TrenchBroom {
             return measureString.size();
         }
 
+        std::shared_ptr<const TextureFont::StringLayout> TextureFont::layout(const AttrString& string) const {
+            auto it = m_layoutCache.lower_bound(string);
+            if (it != std::end(m_layoutCache) && !(string < it->first)) {
+                return it->second;
+            }
+
+            if (m_layoutCache.size() >= MaxCachedLayouts) {
+                m_layoutCache.clear();
+                it = std::end(m_layoutCache);
+            }
+
+            auto layout = std::make_shared<StringLayout>();
+            layout->vertices = quads(string, true);
+            layout->size = measure(string);
+
+            m_layoutCache.insert(it, std::make_pair(string, layout));
+            return layout;
+        }
+
         std::vector<vm::vec2f> TextureFont::quads(const std::string& string, const bool clockwise, const vm::vec2f& offset) const {
             std::vector<vm::vec2f> result;
             result.reserve(string.length() * 4 * 2);
@@ -21,27 +21,44 @@
 #define TrenchBroom_Font
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <map>
 #include <memory>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class AttrString;
         class FontGlyph;
         class FontTexture;
 
         class TextureFont {
+        public:
+            /**
+             * The clockwise glyph quads of a string laid out at the origin, and the size of the string.
+             */
+            struct StringLayout {
+                std::vector<vm::vec2f> vertices;
+                vm::vec2f size;
+            };
         private:
+            static const size_t MaxCachedLayouts;
+
             std::unique_ptr<FontTexture> m_texture;
             std::vector<FontGlyph> m_glyphs;
             int m_lineHeight;
 
             unsigned char m_firstChar;
             unsigned char m_charCount;
+
+            /**
+             * Layouts of recently rendered strings. Labels are usually rendered with the same text for many frames, so
+             * their layouts are cached instead of being recomputed every frame.
+             */
+            mutable std::map<AttrString, std::shared_ptr<const StringLayout>> m_layoutCache;
         public:
             TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, int lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
@@ -51,6 +68,12 @@ namespace TrenchBroom {
             std::vector<vm::vec2f> quads(const AttrString& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const AttrString& string) const;
 
+            /**
+             * Returns the layout of the given string, computing and caching it if necessary. The returned layout
+             * remains valid even if it is evicted from the cache.
+             */
+            std::shared_ptr<const StringLayout> layout(const AttrString& string) const;
+
             std::vector<vm::vec2f> quads(const std::string& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const std::string& string) const;
 
@@ -20,6 +20,10 @@
 #include "TexturedIndexRangeMap.h"
 
 #include "Renderer/RenderUtils.h"
+#include "Renderer/Transformation.h"
+
+#include <vecmath/mat.h>
+
 
 #include <cassert>
 
@@ -124,6 +128,20 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeMap::render(VertexArray& vertexArray, TextureRenderFunc& func, Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices) {
+            for (const auto& entry : *m_data) {
+                const auto* texture = entry.first;
+                const auto& indexArray = entry.second;
+
+                func.before(texture);
+                for (const auto& modelMatrix : modelMatrices) {
+                    MultiplyModelMatrix multMatrix(transformation, modelMatrix);
+                    indexArray.render(vertexArray);
+                }
+                func.after(texture);
+            }
+        }
+
         void TexturedIndexRangeMap::forEachPrimitive(std::function<void(const Texture*, PrimType, size_t, size_t)> func) const {
             for (const auto& entry : *m_data) {
                 const auto* texture = entry.first;
@@ -22,7 +22,10 @@
 
 #include "Renderer/IndexRangeMap.h"
 
+#include <vecmath/forward.h>
+
 #include <map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -31,6 +34,7 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class TextureRenderFunc;
+        class Transformation;
         class VertexArray;
 
         /**
@@ -169,6 +173,18 @@ namespace TrenchBroom {
              */
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
 
+            /**
+             * Renders the primitives stored in this index range map once for each of the given model matrices, using
+             * the vertices in the given vertex array. The primitives are batched by their associated textures, so that
+             * each texture is only activated once for all instances.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param func the texture callbacks
+             * @param transformation the transformation to multiply the model matrices onto
+             * @param modelMatrices the model matrices of the instances to render
+             */
+            void render(VertexArray& vertexArray, TextureRenderFunc& func, Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices);
+
             /**
              * Invokes the given function for each primitive stored in this map.
              *
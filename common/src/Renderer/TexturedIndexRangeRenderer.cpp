@@ -19,6 +19,8 @@
 
 #include "TexturedIndexRangeRenderer.h"
 
+#include "Renderer/RenderUtils.h"
+
 namespace TrenchBroom {
     namespace Renderer {
         TexturedRenderer::~TexturedRenderer() = default;
@@ -57,6 +59,14 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeRenderer::render(Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices) {
+            if (m_vertexArray.setup()) {
+                DefaultTextureRenderFunc func;
+                m_indexRange.render(m_vertexArray, func, transformation, modelMatrices);
+                m_vertexArray.cleanup();
+            }
+        }
+
         MultiTexturedIndexRangeRenderer::MultiTexturedIndexRangeRenderer(std::vector<std::unique_ptr<TexturedIndexRangeRenderer>> renderers) :
         m_renderers(std::move(renderers)) {}
 
@@ -88,5 +98,11 @@ namespace TrenchBroom {
                 renderer->render(func);
             }
         }
+
+        void MultiTexturedIndexRangeRenderer::render(Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices) {
+            for (auto& renderer : m_renderers) {
+                renderer->render(transformation, modelMatrices);
+            }
+        }
     }
 }
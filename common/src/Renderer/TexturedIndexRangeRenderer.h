@@ -23,6 +23,8 @@
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/VertexArray.h"
 
+#include <vecmath/forward.h>
+
 #include <memory>
 #include <vector>
 
@@ -34,6 +36,7 @@ namespace TrenchBroom {
     namespace Renderer {
         class VboManager;
         class TextureRenderFunc;
+        class Transformation;
 
         class TexturedRenderer {
         public:
@@ -44,6 +47,12 @@ namespace TrenchBroom {
             virtual void prepare(VboManager& vboManager) = 0;
             virtual void render() = 0;
             virtual void render(TextureRenderFunc& func) = 0;
+
+            /**
+             * Renders one instance for each of the given model matrices. The vertex array is set up only once for all
+             * instances.
+             */
+            virtual void render(Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices) = 0;
         };
 
         class TexturedIndexRangeRenderer : public TexturedRenderer {
@@ -61,6 +70,7 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void render(Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices) override;
         };
 
         class MultiTexturedIndexRangeRenderer : public TexturedRenderer {
@@ -75,6 +85,7 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void render(Transformation& transformation, const std::vector<vm::mat4x4f>& modelMatrices) override;
         };
     }
 }
@@ -22,12 +22,15 @@
 #include "Ensure.h"
 
 #include <cassert>
+#include <cstring>
 
 namespace TrenchBroom {
     namespace Renderer {
-        Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage) :
+        Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage, const bool streaming) :
         m_type(type),
-        m_capacity(capacity) {
+        m_capacity(capacity),
+        m_streaming(streaming),
+        m_usage(VboUsage::StaticDraw) {
             assert(m_type == GL_ELEMENT_ARRAY_BUFFER
                    || m_type == GL_ARRAY_BUFFER);
 
@@ -42,10 +45,57 @@ namespace TrenchBroom {
             m_bufferId = 0;
         }
 
+        void Vbo::orphan(const GLenum usage) {
+            assert(m_bufferId != 0);
+            glAssert(glBindBuffer(m_type, m_bufferId));
+            glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_capacity), nullptr, usage));
+        }
+
         Vbo::~Vbo() {
             assert(m_bufferId == 0);
         }
 
+        void Vbo::writeBytes(const size_t address, const GLvoid* data, const size_t size) {
+            glAssert(glBindBuffer(m_type, m_bufferId));
+            if (m_streaming && writeMapped(address, data, size)) {
+                return;
+            }
+
+            const GLintptr offset = static_cast<GLintptr>(address);
+            const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
+            glAssert(glBufferSubData(m_type, offset, sizei, data));
+        }
+
+        /**
+         * Copies the given data into the buffer through a mapped range. Invalidating the range allows the driver to
+         * hand out fresh memory instead of waiting for draw calls that still read the old contents, which is what
+         * glBufferSubData stalls on.
+         *
+         * Returns false if the data could not be written through a mapped range.
+         */
+        bool Vbo::writeMapped(const size_t address, const GLvoid* data, const size_t size) {
+            if (!GLEW_VERSION_3_0 && !GLEW_ARB_map_buffer_range) {
+                return false;
+            }
+
+            const GLintptr offset = static_cast<GLintptr>(address);
+            const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
+            const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+
+            GLvoid* mapped = nullptr;
+            glAssert(mapped = glMapBufferRange(m_type, offset, sizei, access));
+            if (mapped == nullptr) {
+                return false;
+            }
+
+            std::memcpy(mapped, data, size);
+
+            // unmapping fails if the contents were lost while mapped, e.g. due to a display mode change
+            GLboolean unmapped = GL_FALSE;
+            glAssert(unmapped = glUnmapBuffer(m_type));
+            return unmapped == GL_TRUE;
+        }
+
         size_t Vbo::offset() const {
             return 0;
         }
@@ -41,12 +41,20 @@ namespace TrenchBroom {
             GLenum m_type;
             size_t m_capacity;
             GLuint m_bufferId;
+            /**
+             * If true, writes go through glMapBufferRange with an invalidated range if it is available.
+             */
+            bool m_streaming;
+            /**
+             * The usage this buffer was allocated with, used to return it to the matching pool.
+             */
+            VboUsage m_usage;
 
             /**
              * Immediately creates and binds to a buffer of the given type and capacity.
              * The contents are initially unspecified.
              */
-            Vbo(GLenum type, size_t capacity, GLenum usage);
+            Vbo(GLenum type, size_t capacity, GLenum usage, bool streaming);
             ~Vbo();
 
             /**
@@ -56,6 +64,15 @@ namespace TrenchBroom {
              */
             void free();
 
+            /**
+             * Replaces the storage of this buffer with new storage of the same capacity, so that a pooled buffer can be
+             * reused without waiting for draw calls that still read its previous contents.
+             */
+            void orphan(GLenum usage);
+
+            void writeBytes(size_t address, const GLvoid* data, size_t size);
+            bool writeMapped(size_t address, const GLvoid* data, size_t size);
+
         public:
             /**
              * Deprecated, always returns 0.
@@ -93,12 +110,7 @@ namespace TrenchBroom {
                 static_assert(std::is_trivially_copyable<T>::value);
                 static_assert(std::is_standard_layout<T>::value);
 
-                const GLvoid* ptr = static_cast<const GLvoid*>(array);
-                const GLintptr offset = static_cast<GLintptr>(address);
-                const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
-                glAssert(glBindBuffer(m_type, m_bufferId));
-                glAssert(glBufferSubData(m_type, offset, sizei, ptr));
-
+                writeBytes(address, static_cast<const GLvoid*>(array), size);
                 return size;
             }
         };
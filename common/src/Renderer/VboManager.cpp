@@ -24,6 +24,7 @@
 #include "Macros.h"
 
 #include <algorithm> // for std::max
+#include <cassert>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -45,20 +46,88 @@ namespace TrenchBroom {
                 case VboUsage::StaticDraw:
                     return GL_STATIC_DRAW;
                 case VboUsage::DynamicDraw:
+                case VboUsage::Streaming:
                     return GL_DYNAMIC_DRAW;
                 switchDefault()
             }
         }
 
+        /**
+         * Static buffers up to this capacity are pooled. Their capacities are rounded up to a power of two so that
+         * released buffers can be reused for similar requests. Dynamic and streaming buffers are long lived and expect
+         * their capacity to match the requested capacity, so they are never pooled.
+         */
+        static constexpr size_t MaxPooledVboCapacity = 64u * 1024u;
+        static constexpr size_t MinPooledVboCapacity = 256u;
+
+        /**
+         * The number of released buffers to keep per pool key.
+         */
+        static constexpr size_t MaxPooledVbosPerKey = 64u;
+
+        static bool pooled(const VboUsage usage, const size_t capacity) {
+            return usage == VboUsage::StaticDraw && capacity <= MaxPooledVboCapacity;
+        }
+
+        static size_t pooledCapacity(const size_t capacity) {
+            size_t result = MinPooledVboCapacity;
+            while (result < capacity) {
+                result *= 2u;
+            }
+            return result;
+        }
+
         // VboManager
 
         VboManager::VboManager() :
         m_peakVboCount(0u),
         m_currentVboCount(0u),
-        m_currentVboSize(0u) {}
+        m_currentVboSize(0u),
+        m_pooling(true),
+        m_pooledVboCount(0u),
+        m_pooledVboSize(0u) {}
+
+        VboManager::~VboManager() {
+            assert(m_pool.empty());
+        }
+
+        void VboManager::clear() {
+            for (auto& entry : m_pool) {
+                for (auto* vbo : entry.second) {
+                    vbo->free();
+                    delete vbo;
+                }
+            }
+            m_pool.clear();
+            m_pooling = false;
+            m_pooledVboCount = 0u;
+            m_pooledVboSize = 0u;
+        }
+
+        Vbo* VboManager::allocateVbo(VboType type, size_t capacity, const VboUsage usage) {
+            const auto glType = typeToOpenGL(type);
+            const auto glUsage = usageToOpenGL(usage);
+
+            Vbo* result = nullptr;
+            if (pooled(usage, capacity)) {
+                capacity = pooledCapacity(capacity);
 
-        Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage) {
-            auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
+                auto it = m_pool.find(PoolKey(glType, usage, capacity));
+                if (it != std::end(m_pool) && !it->second.empty()) {
+                    result = it->second.back();
+                    it->second.pop_back();
+
+                    m_pooledVboSize -= capacity;
+                    m_pooledVboCount--;
+
+                    result->orphan(glUsage);
+                }
+            }
+
+            if (result == nullptr) {
+                result = new Vbo(glType, capacity, glUsage, usage == VboUsage::Streaming);
+            }
+            result->m_usage = usage;
 
             m_currentVboSize += capacity;
             m_currentVboCount++;
@@ -68,9 +137,20 @@ namespace TrenchBroom {
         }
 
         void VboManager::destroyVbo(Vbo* vbo) {
-            m_currentVboSize -= vbo->capacity();
+            const auto capacity = vbo->capacity();
+            m_currentVboSize -= capacity;
             m_currentVboCount--;
 
+            if (m_pooling && pooled(vbo->m_usage, capacity)) {
+                auto& pool = m_pool[PoolKey(vbo->m_type, vbo->m_usage, capacity)];
+                if (pool.size() < MaxPooledVbosPerKey) {
+                    pool.push_back(vbo);
+                    m_pooledVboSize += capacity;
+                    m_pooledVboCount++;
+                    return;
+                }
+            }
+
             vbo->free();
             delete vbo;
         }
@@ -86,5 +166,13 @@ namespace TrenchBroom {
         size_t VboManager::currentVboSize() const {
             return m_currentVboSize;
         }
+
+        size_t VboManager::pooledVboCount() const {
+            return m_pooledVboCount;
+        }
+
+        size_t VboManager::pooledVboSize() const {
+            return m_pooledVboSize;
+        }
     }
 }
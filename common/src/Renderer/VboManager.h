@@ -23,6 +23,9 @@
 #include "Renderer/GL.h"
 
 #include <cstddef> // for size_t
+#include <map>
+#include <tuple>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -35,19 +38,54 @@ namespace TrenchBroom {
 
         enum class VboUsage {
             StaticDraw,
-            DynamicDraw
+            DynamicDraw,
+            /**
+             * For buffers that are partially rewritten while the GPU may still be reading from them. Writes
+             * invalidate the written range and copy into mapped memory so that the driver need not wait for pending
+             * draw calls.
+             */
+            Streaming
         };
 
+        /**
+         * Allocates OpenGL buffers. Since all map views share one context, this manager and its buffers are shared by
+         * all views.
+         *
+         * Small static buffers are pooled: when such a buffer is destroyed, it is kept for reuse instead of being deleted.
+         * Most small buffers hold one-shot geometry such as handles, guides and text that every view recreates in
+         * every frame, so pooling avoids creating and deleting many buffers per frame.
+         */
         class VboManager {
         private:
+            /**
+             * Released buffers by type, usage and capacity.
+             */
+            using PoolKey = std::tuple<GLenum, VboUsage, size_t>;
+            using VboPool = std::map<PoolKey, std::vector<Vbo*>>;
+
             size_t m_peakVboCount;
             size_t m_currentVboCount;
             size_t m_currentVboSize;
+
+            VboPool m_pool;
+            bool m_pooling;
+            size_t m_pooledVboCount;
+            size_t m_pooledVboSize;
         public:
             VboManager();
+            ~VboManager();
+
+            /**
+             * Deletes the pooled buffers and stops pooling, so that buffers destroyed afterwards are deleted right
+             * away. Must be called while the OpenGL context is current and before it is destroyed.
+             */
+            void clear();
+
             /**
             * Immediately creates and binds to an OpenGL buffer of the given type and capacity.
             * The contents are initially unspecified. See Vbo class.
+            *
+            * The capacity of the returned buffer may be larger than requested.
             */
             Vbo* allocateVbo(VboType type, size_t capacity, VboUsage usage = VboUsage::StaticDraw);
             void destroyVbo(Vbo* vbo);
@@ -55,6 +93,9 @@ namespace TrenchBroom {
             size_t peakVboCount() const;
             size_t currentVboCount() const;
             size_t currentVboSize() const;
+
+            size_t pooledVboCount() const;
+            size_t pooledVboSize() const;
         };
     }
 }
@@ -81,6 +81,9 @@ namespace TrenchBroom {
                 }
 
                 void setup() override {
+                    // The attribute pointers are set up on every call rather than cached in a vertex array object:
+                    // the same vertex array is rendered into several views with separate OpenGL contexts, and
+                    // vertex array objects, unlike buffer objects, are not shared between contexts.
                     ensure(m_vbo != nullptr, "block is null");
                     m_vbo->bind();
                     VertexSpec::setup(m_vbo->offset());
@@ -19,6 +19,7 @@
 
 #include "TrenchBroomApp.h"
 
+#include "Profiler.h"
 #include "RecoverableExceptions.h"
 #include "TrenchBroomStackWalker.h"
 #include "IO/Path.h"
@@ -47,6 +48,7 @@
 
 #include <kdl/set_temp.h>
 #include <kdl/string_utils.h>
+#include <kdl/thread_pool.h>
 
 #include <clocale>
 #include <csignal>
@@ -84,9 +86,12 @@ namespace TrenchBroom {
 
         TrenchBroomApp::TrenchBroomApp(int& argc, char** argv) :
         QApplication(argc, argv),
+        m_threadPool(std::make_unique<kdl::thread_pool>()),
         m_frameManager(nullptr),
         m_recentDocuments(nullptr),
-        m_welcomeWindow(nullptr) {
+        m_welcomeWindow(nullptr),
+        m_startTime(Clock::now()),
+        m_profileStartup(arguments().contains("--profile-startup")) {
             // When this flag is enabled, font and palette changes propagate as though the user had manually called the corresponding QWidget methods.
             setAttribute(Qt::AA_UseStyleSheetPropagationInWidgetStyles);
 
@@ -99,6 +104,8 @@ namespace TrenchBroom {
             signal(SIGSEGV, CrashHandler);
 #endif
 
+            kdl::set_default_thread_pool(m_threadPool.get());
+
             // always set this locale so that we can properly parse floats from text files regardless of the platforms locale
             std::setlocale(LC_NUMERIC, "C");
 
@@ -108,12 +115,14 @@ namespace TrenchBroom {
             setOrganizationName("");
             setOrganizationDomain("io.github.trenchbroom");
 
-            if (!initializeGameFactory()) {
+            auto initialized = false;
+            runStartupPhase("Load game configurations", [&]() { initialized = initializeGameFactory(); });
+            if (!initialized) {
                 QCoreApplication::exit(1);
                 return;
             }
 
-            loadStyleSheets();
+            runStartupPhase("Load style sheets", [&]() { loadStyleSheets(); });
 
             // these must be initialized here and not earlier
             m_frameManager = std::make_unique<FrameManager>(useSDI());
@@ -154,12 +163,19 @@ namespace TrenchBroom {
         }
 
         // must be implemented in cpp file in order to use std::unique_ptr with forward declared type as members
-        TrenchBroomApp::~TrenchBroomApp() = default;
+        TrenchBroomApp::~TrenchBroomApp() {
+            kdl::set_default_thread_pool(nullptr);
+        }
 
         void TrenchBroomApp::parseCommandLineAndShowFrame() {
             QCommandLineParser parser;
+            parser.addOption(QCommandLineOption("profile-startup", "Print the time spent in each phase of the startup."));
             parser.process(*this);
-            openFilesOrWelcomeFrame(parser.positionalArguments());
+
+            runStartupPhase("Open files or show welcome window", [&]() { openFilesOrWelcomeFrame(parser.positionalArguments()); });
+            if (m_profileStartup) {
+                printStartupProfile();
+            }
         }
 
         FrameManager* TrenchBroomApp::frameManager() {
@@ -591,6 +607,27 @@ namespace TrenchBroom {
             }
         }
 
+        void TrenchBroomApp::runStartupPhase(const char* name, const std::function<void()>& phase) {
+            const auto start = Clock::now();
+            phase();
+            const auto end = Clock::now();
+
+            if (m_profileStartup) {
+                Profiler::instance().record(name, start, end);
+                m_startupPhases.push_back(StartupPhase{name, end - start});
+            }
+        }
+
+        void TrenchBroomApp::printStartupProfile() const {
+            using Millis = std::chrono::duration<double, std::milli>;
+
+            std::cout << "Startup profile:" << std::endl;
+            for (const auto& phase : m_startupPhases) {
+                std::cout << "  " << phase.name << ": " << Millis(phase.duration).count() << " ms" << std::endl;
+            }
+            std::cout << "  Total: " << Millis(Clock::now() - m_startTime).count() << " ms" << std::endl;
+        }
+
         bool TrenchBroomApp::useSDI() {
 #ifdef _WIN32
             return true;
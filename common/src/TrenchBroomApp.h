@@ -22,6 +22,8 @@
 
 #include "Notifier.h"
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +33,10 @@
 class QMenu;
 class QSettings;
 
+namespace kdl {
+    class thread_pool;
+}
+
 namespace TrenchBroom {
     class Logger;
     class RecoverableException;
@@ -48,9 +54,25 @@ namespace TrenchBroom {
         class TrenchBroomApp : public QApplication {
             Q_OBJECT
         private:
+            using Clock = std::chrono::steady_clock;
+
+            struct StartupPhase {
+                const char* name;
+                Clock::duration duration;
+            };
+
+            /**
+             * Runs background work and the parallel algorithms of the whole application. Declared first so that it
+             * outlives every other member.
+             */
+            std::unique_ptr<kdl::thread_pool> m_threadPool;
             std::unique_ptr<FrameManager> m_frameManager;
             std::unique_ptr<RecentDocuments> m_recentDocuments;
             std::unique_ptr<WelcomeWindow> m_welcomeWindow;
+
+            Clock::time_point m_startTime;
+            bool m_profileStartup;
+            std::vector<StartupPhase> m_startupPhases;
         public:
             static TrenchBroomApp& instance();
 
@@ -93,6 +115,14 @@ namespace TrenchBroom {
             void closeWelcomeWindow();
         private:
             static bool useSDI();
+
+            /**
+             * Runs the given phase of the application startup. If the application was started with the
+             * --profile-startup option, the time spent in the phase is recorded and printed together with the other
+             * phases once the application has started.
+             */
+            void runStartupPhase(const char* name, const std::function<void()>& phase);
+            void printStartupProfile() const;
         signals:
             void recentDocumentsDidChange();
         };
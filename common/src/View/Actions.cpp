@@ -1341,6 +1341,13 @@ namespace TrenchBroom {
                     return context.hasDocument() && context.frame()->currentViewMaximized();
                 }));
             viewMenu.addSeparator();
+            viewMenu.addItem(createMenuAction(IO::Path("Menu/View/Log Memory Usage"), QObject::tr("Log Memory Usage"), 0,
+                [](ActionExecutionContext& context) {
+                    context.frame()->logMemoryUsage();
+                },
+                [](ActionExecutionContext& context) {
+                    return context.hasDocument();
+                }));
             viewMenu.addItem(createMenuAction(IO::Path("Menu/File/Preferences..."), QObject::tr("Preferences..."), QKeySequence::Preferences,
                 [](ActionExecutionContext&) {
                     auto& app = TrenchBroomApp::instance();
@@ -1429,6 +1436,13 @@ namespace TrenchBroom {
                 [](ActionExecutionContext& context) {
                     return context.hasDocument();
                 }));
+            debugMenu.addItem(createMenuAction(IO::Path("Menu/Debug/Export Profile..."), QObject::tr("Export Profile..."), 0,
+                [](ActionExecutionContext& context) {
+                    context.frame()->debugExportProfile();
+                },
+                [](ActionExecutionContext& context) {
+                    return context.hasDocument();
+                }));
 #endif
         }
 
@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AssetWatcher.h"
+
+#include "IO/Path.h"
+#include "IO/PathQt.h"
+#include "View/MapDocument.h"
+
+#include <kdl/memory_utils.h>
+#include <kdl/vector_utils.h>
+
+#include <utility>
+
+#include <QFileSystemWatcher>
+#include <QStringList>
+#include <QTimer>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * The time to wait after the last reported change before the changed assets are reloaded, in milliseconds.
+         */
+        static const int ReloadDelay = 500;
+
+        AssetWatcher::AssetWatcher(std::weak_ptr<MapDocument> document, QObject* parent) :
+        QObject(parent),
+        m_document(std::move(document)),
+        m_watcher(new QFileSystemWatcher(this)),
+        m_reloadTimer(new QTimer(this)) {
+            m_reloadTimer->setSingleShot(true);
+            m_reloadTimer->setInterval(ReloadDelay);
+
+            connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &AssetWatcher::pathDidChange);
+            connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &AssetWatcher::pathDidChange);
+            connect(m_reloadTimer, &QTimer::timeout, this, &AssetWatcher::reloadChangedAssets);
+
+            bindObservers();
+            updateWatchedPaths();
+        }
+
+        AssetWatcher::~AssetWatcher() {
+            unbindObservers();
+        }
+
+        void AssetWatcher::bindObservers() {
+            auto document = kdl::mem_lock(m_document);
+            document->documentWasNewedNotifier.addObserver(this, &AssetWatcher::documentDidChange);
+            document->documentWasLoadedNotifier.addObserver(this, &AssetWatcher::documentDidChange);
+            document->documentWasClearedNotifier.addObserver(this, &AssetWatcher::documentWasCleared);
+            document->textureCollectionsDidChangeNotifier.addObserver(this, &AssetWatcher::assetsDidChange);
+            document->entityDefinitionsDidChangeNotifier.addObserver(this, &AssetWatcher::assetsDidChange);
+            document->modsDidChangeNotifier.addObserver(this, &AssetWatcher::assetsDidChange);
+        }
+
+        void AssetWatcher::unbindObservers() {
+            if (!kdl::mem_expired(m_document)) {
+                auto document = kdl::mem_lock(m_document);
+                document->documentWasNewedNotifier.removeObserver(this, &AssetWatcher::documentDidChange);
+                document->documentWasLoadedNotifier.removeObserver(this, &AssetWatcher::documentDidChange);
+                document->documentWasClearedNotifier.removeObserver(this, &AssetWatcher::documentWasCleared);
+                document->textureCollectionsDidChangeNotifier.removeObserver(this, &AssetWatcher::assetsDidChange);
+                document->entityDefinitionsDidChangeNotifier.removeObserver(this, &AssetWatcher::assetsDidChange);
+                document->modsDidChangeNotifier.removeObserver(this, &AssetWatcher::assetsDidChange);
+            }
+        }
+
+        void AssetWatcher::documentDidChange(MapDocument*) {
+            updateWatchedPaths();
+        }
+
+        void AssetWatcher::documentWasCleared(MapDocument*) {
+            m_reloadTimer->stop();
+            m_changedPaths.clear();
+            updateWatchedPaths();
+        }
+
+        void AssetWatcher::assetsDidChange() {
+            updateWatchedPaths();
+        }
+
+        void AssetWatcher::updateWatchedPaths() {
+            auto watchedPaths = m_watcher->files() + m_watcher->directories();
+            if (!watchedPaths.isEmpty()) {
+                m_watcher->removePaths(watchedPaths);
+            }
+
+            if (kdl::mem_expired(m_document)) {
+                return;
+            }
+
+            QStringList paths;
+            for (const auto& path : kdl::mem_lock(m_document)->assetSourcePaths()) {
+                paths.append(IO::pathAsQString(path));
+            }
+            if (!paths.isEmpty()) {
+                // paths that do not exist anymore are skipped
+                m_watcher->addPaths(paths);
+            }
+        }
+
+        void AssetWatcher::pathDidChange(const QString& path) {
+            m_changedPaths.push_back(IO::pathFromQString(path));
+            m_reloadTimer->start();
+        }
+
+        void AssetWatcher::reloadChangedAssets() {
+            if (m_changedPaths.empty() || kdl::mem_expired(m_document)) {
+                return;
+            }
+
+            auto changedPaths = std::move(m_changedPaths);
+            m_changedPaths.clear();
+            kdl::vec_sort_and_remove_duplicates(changedPaths);
+
+            kdl::mem_lock(m_document)->reloadChangedAssets(changedPaths);
+
+            // a watched file is no longer watched once it has been replaced by another file, e.g. by an image editor
+            // that saves to a temporary file first
+            updateWatchedPaths();
+        }
+    }
+}
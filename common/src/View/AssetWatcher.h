@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_AssetWatcher
+#define TrenchBroom_AssetWatcher
+
+#include "Macros.h"
+
+#include <memory>
+#include <vector>
+
+#include <QObject>
+
+class QFileSystemWatcher;
+class QString;
+class QTimer;
+
+namespace TrenchBroom {
+    namespace IO {
+        class Path;
+    }
+
+    namespace View {
+        class MapDocument;
+
+        /**
+         * Watches the files and directories on disk from which the texture collections and the entity definitions of a
+         * document were loaded, and reloads only the affected assets when any of them change.
+         *
+         * Changes are collected until no further change has been reported for a short while, so that saving many
+         * textures at once results in a single reload and a single notification of the renderers.
+         */
+        class AssetWatcher : public QObject {
+            Q_OBJECT
+        private:
+            std::weak_ptr<MapDocument> m_document;
+            QFileSystemWatcher* m_watcher;
+            QTimer* m_reloadTimer;
+            std::vector<IO::Path> m_changedPaths;
+        public:
+            explicit AssetWatcher(std::weak_ptr<MapDocument> document, QObject* parent = nullptr);
+            ~AssetWatcher() override;
+        private:
+            void bindObservers();
+            void unbindObservers();
+
+            void documentDidChange(MapDocument* document);
+            void documentWasCleared(MapDocument* document);
+            void assetsDidChange();
+
+            void updateWatchedPaths();
+            void pathDidChange(const QString& path);
+            void reloadChangedAssets();
+
+            deleteCopyAndMove(AssetWatcher)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_AssetWatcher) */
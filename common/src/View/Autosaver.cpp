@@ -22,17 +22,23 @@
 #include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "View/CachingLogger.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
+#include <kdl/thread_pool.h>
 
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <chrono>
+#include <cstdio>
 #include <limits>
 #include <memory>
+#include <string>
 
 namespace TrenchBroom {
     namespace View {
@@ -75,9 +81,21 @@ namespace TrenchBroom {
 
         Autosaver::~Autosaver() {
             unbindObservers();
+
+            // a backup that is being written must not be abandoned
+            if (m_pendingAutosave.valid()) {
+                m_pendingAutosave.wait();
+            }
         }
 
         void Autosaver::triggerAutosave(Logger& logger) {
+            if (hasPendingAutosave()) {
+                if (m_pendingAutosave.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    return;
+                }
+                finishPendingAutosave(logger);
+            }
+
             if (kdl::mem_expired(m_document)) {
                 return;
             }
@@ -106,13 +124,50 @@ namespace TrenchBroom {
                 return;
             }
 
-            autosave(logger, document);
+            autosave(document);
+        }
+
+        void Autosaver::waitForPendingAutosave(Logger& logger) {
+            if (hasPendingAutosave()) {
+                finishPendingAutosave(logger);
+            }
+        }
+
+        bool Autosaver::hasPendingAutosave() const {
+            return m_pendingAutosave.valid();
+        }
+
+        void Autosaver::finishPendingAutosave(Logger& logger) {
+            assert(hasPendingAutosave());
+
+            // the background thread must not log anything once the cached messages are passed on
+            m_pendingAutosave.wait();
+
+            auto pendingLogger = std::move(m_pendingAutosaveLogger);
+            pendingLogger->setParentLogger(&logger);
+
+            // rethrows any exception that was not handled on the background thread
+            m_pendingAutosave.get();
         }
 
-        void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document) {
-            const auto& mapPath = document->path();
+        void Autosaver::autosave(std::shared_ptr<MapDocument> document) {
+            const auto mapPath = document->path();
             assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
 
+            // the serialized document is the snapshot that is written, so the document can be modified again while the
+            // backup is being written
+            auto contents = document->serializeDocument();
+
+            m_lastSaveTime = std::time(nullptr);
+            m_lastModificationCount = document->modificationCount();
+
+            m_pendingAutosaveLogger = std::make_unique<CachingLogger>();
+            m_pendingAutosave = kdl::run_async([this, mapPath, contents = std::move(contents), pendingLogger = m_pendingAutosaveLogger.get()]() {
+                writeBackup(*pendingLogger, mapPath, contents);
+            }, kdl::task_priority::background);
+        }
+
+        void Autosaver::writeBackup(Logger& logger, const IO::Path& mapPath, const std::string& contents) const {
             const auto mapFilename = mapPath.lastComponent();
             const auto mapBasename = mapFilename.deleteExtension();
 
@@ -121,16 +176,23 @@ namespace TrenchBroom {
                 auto backups = collectBackups(fs, mapBasename);
 
                 thinBackups(logger, fs, backups);
-                cleanBackups(fs, backups, mapBasename);
+
+                // renumbering renames every backup, which is slow on network drives, so the backups are only
+                // renumbered once their numbers have grown too large
+                auto backupNo = backups.empty() ? 1u : extractBackupNo(backups.back()) + 1u;
+                if (backupNo > 2u * m_maxBackups) {
+                    cleanBackups(fs, backups, mapBasename);
+                    backupNo = backups.size() + 1u;
+                }
 
                 assert(backups.size() < m_maxBackups);
-                const auto backupNo = backups.size() + 1;
 
                 const auto backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
 
-                m_lastSaveTime = std::time(nullptr);
-                m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
+                IO::OpenFile open(backupFilePath, true);
+                if (std::fwrite(contents.data(), 1u, contents.size(), open.file) != contents.size()) {
+                    throw FileSystemException("Cannot write file: " + backupFilePath.asString());
+                }
 
                 logger.info() << "Created autosave backup at " << backupFilePath;
             } catch (const FileSystemException& e) {
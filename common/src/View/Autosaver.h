@@ -23,7 +23,10 @@
 #include "IO/Path.h"
 
 #include <ctime>
+#include <future>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
@@ -33,9 +36,17 @@ namespace TrenchBroom {
     }
 
     namespace View {
+        class CachingLogger;
         class Command;
         class MapDocument;
 
+        /**
+         * Periodically creates backups of a map document.
+         *
+         * The document is serialized on the calling thread, but the backup is written on a background thread, which
+         * also deletes and renames old backups. Messages from the background thread are cached and passed on to the
+         * logger on the next call to triggerAutosave or waitForPendingAutosave.
+         */
         class Autosaver {
         public:
             class BackupFileMatcher {
@@ -78,13 +89,29 @@ namespace TrenchBroom {
              * The modification count that was last recorded.
              */
             size_t m_lastModificationCount;
+
+            /**
+             * The backup that is currently being written on a background thread, if any.
+             */
+            std::future<void> m_pendingAutosave;
+            std::unique_ptr<CachingLogger> m_pendingAutosaveLogger;
         public:
             explicit Autosaver(std::weak_ptr<MapDocument> document, std::time_t saveInterval = 10 * 60, std::time_t idleInterval = 3, size_t maxBackups = 50);
             ~Autosaver();
 
             void triggerAutosave(Logger& logger);
+
+            /**
+             * Blocks until the backup that is currently being written, if any, has been written, and passes the
+             * messages of the background thread on to the given logger.
+             */
+            void waitForPendingAutosave(Logger& logger);
         private:
-            void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+            bool hasPendingAutosave() const;
+            void finishPendingAutosave(Logger& logger);
+
+            void autosave(std::shared_ptr<View::MapDocument> document);
+            void writeBackup(Logger& logger, const IO::Path& mapPath, const std::string& contents) const;
             IO::WritableDiskFileSystem createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const;
             std::vector<IO::Path> collectBackups(const IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
             void thinBackups(Logger& logger, IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const;
@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <vector>
 
 #include <QVariant>
@@ -287,7 +288,11 @@ namespace TrenchBroom {
             }
 
             bool cellAt(const float x, const float y, const Cell** result) const {
-                for (size_t i = 0; i < m_cells.size(); ++i) {
+                // the cells are ordered from left to right, so the cells left of x can be skipped by a binary search
+                const auto first = std::lower_bound(std::begin(m_cells), std::end(m_cells), x, [](const Cell& cell, const float x_) {
+                    return cell.cellBounds().right() < x_;
+                });
+                for (size_t i = static_cast<size_t>(std::distance(std::begin(m_cells), first)); i < m_cells.size(); ++i) {
                     const Cell& cell = m_cells[i];
                     const LayoutBounds& cellBounds = cell.cellBounds();
                     if (x > cellBounds.right())
@@ -411,14 +416,11 @@ namespace TrenchBroom {
             }
 
             size_t indexOfRowAt(const float y) const {
-                for (size_t i = 0; i < m_rows.size(); ++i) {
-                    const Row& row = m_rows[i];
-                    const LayoutBounds& rowBounds = row.bounds();
-                    if (y < rowBounds.bottom())
-                        return i;
-                }
-
-                return m_rows.size();
+                // the rows are ordered from top to bottom
+                const auto it = std::upper_bound(std::begin(m_rows), std::end(m_rows), y, [](const float y_, const Row& row) {
+                    return y_ < row.bounds().bottom();
+                });
+                return static_cast<size_t>(std::distance(std::begin(m_rows), it));
             }
 
             bool rowAt(const float y, const Row** result) const {
@@ -431,7 +433,10 @@ namespace TrenchBroom {
             }
 
             bool cellAt(const float x, const float y, const LayoutCell** result) const {
-                for (size_t i = 0; i < m_rows.size(); ++i) {
+                const auto first = std::lower_bound(std::begin(m_rows), std::end(m_rows), y, [](const Row& row, const float y_) {
+                    return row.bounds().bottom() < y_;
+                });
+                for (size_t i = static_cast<size_t>(std::distance(std::begin(m_rows), first)); i < m_rows.size(); ++i) {
                     const Row& row = m_rows[i];
                     const LayoutBounds& rowBounds = row.bounds();
                     if (y > rowBounds.bottom())
@@ -513,7 +518,8 @@ namespace TrenchBroom {
                 m_height = 2.0f * m_outerMargin;
                 m_valid = true;
                 if (!m_groups.empty()) {
-                    auto copy = m_groups;
+                    // the old groups are only needed to re-add their items
+                    auto copy = std::move(m_groups);
                     m_groups.clear();
 
                     for (size_t i = 0; i < copy.size(); ++i) {
@@ -534,6 +540,18 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            /**
+             * Returns the index of the first group whose bottom is not above the given y coordinate. The groups are
+             * ordered from top to bottom, so all groups before the returned index can be skipped when looking for
+             * something at the given y coordinate.
+             */
+            size_t indexOfFirstGroupBelow(const float y) const {
+                const auto it = std::lower_bound(std::begin(m_groups), std::end(m_groups), y, [](const Group& group, const float y_) {
+                    return group.bounds().bottom() < y_;
+                });
+                return static_cast<size_t>(std::distance(std::begin(m_groups), it));
+            }
         public:
             const Group& operator[] (const size_t index) {
                 ensure(index < m_groups.size(), "index out of range");
@@ -639,7 +657,7 @@ namespace TrenchBroom {
                 if (!m_valid)
                     validate();
 
-                for (size_t i = 0; i < m_groups.size(); ++i) {
+                for (size_t i = indexOfFirstGroupBelow(y); i < m_groups.size(); ++i) {
                     const Group& group = m_groups[i];
                     const LayoutBounds groupBounds = group.bounds();
                     if (y > groupBounds.bottom())
@@ -657,7 +675,7 @@ namespace TrenchBroom {
                 if (!m_valid)
                     validate();
 
-                for (size_t i = 0; i < m_groups.size(); ++i) {
+                for (size_t i = indexOfFirstGroupBelow(y); i < m_groups.size(); ++i) {
                     Group* group = &m_groups[i];
                     const LayoutBounds groupBounds = group->bounds();
                     if (y > groupBounds.bottom())
@@ -681,16 +699,7 @@ namespace TrenchBroom {
                 if (!m_valid)
                     validate();
 
-                size_t groupIndex = m_groups.size();
-                for (size_t i = 0; i < m_groups.size(); ++i) {
-                    const Group& candidate = m_groups[i];
-                    const LayoutBounds groupBounds = candidate.bounds();
-                    if (y + m_rowMargin > groupBounds.bottom())
-                        continue;
-                    groupIndex = i;
-                    break;
-                }
-
+                size_t groupIndex = indexOfFirstGroupBelow(y + m_rowMargin);
                 if (groupIndex == m_groups.size())
                     return y;
 
@@ -21,9 +21,12 @@
 
 #include "Macros.h"
 #include "Model/EntityAttributeSnapshot.h"
+#include "Model/World.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include <kdl/invoke.h>
+
 namespace TrenchBroom {
     namespace View {
         const Command::CommandType ChangeEntityAttributesCommand::Type = Command::freeType();
@@ -81,6 +84,11 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<CommandResult> ChangeEntityAttributesCommand::doPerformDo(MapDocumentCommandFacade* document) {
+            // add the changed attributes of all nodes to the attribute index at once
+            Model::World* world = document->world();
+            world->deferAttributeIndexUpdates();
+            const kdl::invoke_later resume{[world]() { world->resumeAttributeIndexUpdates(); }};
+
             switch (m_action) {
                 case Action::Set:
                     m_snapshots = document->performSetAttribute(m_oldName, m_newValue);
@@ -96,6 +104,10 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<CommandResult> ChangeEntityAttributesCommand::doPerformUndo(MapDocumentCommandFacade* document) {
+            Model::World* world = document->world();
+            world->deferAttributeIndexUpdates();
+            const kdl::invoke_later resume{[world]() { world->resumeAttributeIndexUpdates(); }};
+
             document->restoreAttributes(m_snapshots);
             m_snapshots.clear();
             return std::make_unique<CommandResult>(true);
@@ -23,6 +23,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "FloatType.h"
+#include "Assets/Texture.h"
 #include "Model/AssortNodesVisitor.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
@@ -39,16 +40,20 @@
 
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/set_temp.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
 #include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -744,6 +749,34 @@ namespace TrenchBroom {
             kdl::map_clear_and_delete(m_backBrushes);
         }
 
+        namespace {
+            /**
+             * Returns -1 if the given bounds lie entirely below the given plane, 1 if they lie entirely above it, and 0
+             * if the plane intersects them.
+             */
+            int planeSide(const vm::plane3& plane, const vm::bbox3& bounds) {
+                vm::vec3 lowest, highest;
+                for (size_t i = 0; i < 3; ++i) {
+                    if (plane.normal[i] >= 0.0) {
+                        lowest[i] = bounds.min[i];
+                        highest[i] = bounds.max[i];
+                    } else {
+                        lowest[i] = bounds.max[i];
+                        highest[i] = bounds.min[i];
+                    }
+                }
+
+                const auto epsilon = vm::C::point_status_epsilon();
+                if (plane.point_distance(highest) < -epsilon) {
+                    return -1;
+                } else if (plane.point_distance(lowest) > epsilon) {
+                    return 1;
+                } else {
+                    return 0;
+                }
+            }
+        }
+
         void ClipTool::updateBrushes() {
             auto document = kdl::mem_lock(m_document);
             const auto& brushes = document->selectedNodes().brushes();
@@ -755,26 +788,70 @@ namespace TrenchBroom {
                 unused(numPoints);
                 ensure(numPoints == 3, "invalid number of points");
 
+                // the faces are created up front because they are cheap to create, and clipping the brushes, which
+                // is the expensive part, is then done in parallel
                 auto* world = document->world();
-                for (auto* brush : brushes) {
-                    auto* parent = brush->parent();
-
+                std::vector<std::pair<Model::BrushFace*, Model::BrushFace*>> faces;
+                faces.reserve(brushes.size());
+                for (const auto* brush : brushes) {
                     auto* frontFace = world->createFace(point1, point2, point3, document->currentTextureName());
                     auto* backFace = world->createFace(point1, point3, point2, document->currentTextureName());
                     setFaceAttributes(brush->faces(), frontFace, backFace);
+                    faces.emplace_back(frontFace, backFace);
+                }
 
-                    auto* frontBrush = brush->clone(worldBounds);
-                    if (frontBrush->clip(worldBounds, frontFace)) {
+                // cloning, clipping and deleting brushes and faces changes the usage counts of their textures, so
+                // these changes are recorded and applied afterwards
+                std::vector<std::pair<Model::Brush*, Model::Brush*>> clippedBrushes(brushes.size(), { nullptr, nullptr });
+                std::vector<Assets::TextureUsageCountChanges> usageCountChanges(brushes.size());
+                kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                    usageCountChanges[i].record([&]() {
+                        const auto* brush = brushes[i];
+                        auto [frontFace, backFace] = faces[i];
+
+                        // a brush that lies entirely on one side of the clip plane ends up in only one of the halves
+                        // and doesn't need to be clipped at all
+                        const auto side = planeSide(frontFace->boundary(), brush->logicalBounds());
+                        if (side != 0) {
+                            delete frontFace;
+                            delete backFace;
+                            auto* clone = brush->clone(worldBounds);
+                            if (side < 0) {
+                                clippedBrushes[i].first = clone;
+                            } else {
+                                clippedBrushes[i].second = clone;
+                            }
+                            return;
+                        }
+
+                        auto* frontBrush = brush->clone(worldBounds);
+                        if (frontBrush->clip(worldBounds, frontFace)) {
+                            clippedBrushes[i].first = frontBrush;
+                        } else {
+                            delete frontBrush;
+                        }
+
+                        auto* backBrush = brush->clone(worldBounds);
+                        if (backBrush->clip(worldBounds, backFace)) {
+                            clippedBrushes[i].second = backBrush;
+                        } else {
+                            delete backBrush;
+                        }
+                    });
+                });
+
+                for (auto& changes : usageCountChanges) {
+                    changes.apply();
+                }
+
+                for (size_t i = 0; i < brushes.size(); ++i) {
+                    auto* parent = brushes[i]->parent();
+                    const auto [frontBrush, backBrush] = clippedBrushes[i];
+                    if (frontBrush != nullptr) {
                         m_frontBrushes[parent].push_back(frontBrush);
-                    } else {
-                        delete frontBrush;
                     }
-
-                    auto* backBrush = brush->clone(worldBounds);
-                    if (backBrush->clip(worldBounds, backFace)) {
+                    if (backBrush != nullptr) {
                         m_backBrushes[parent].push_back(backBrush);
-                    } else {
-                        delete backBrush;
                     }
                 }
             } else {
@@ -21,6 +21,7 @@
 
 #include "Exceptions.h"
 #include "Notifier.h"
+#include "Profiler.h"
 #include "View/Command.h"
 #include "View/UndoableCommand.h"
 
@@ -29,6 +30,7 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <iterator>
 
 #include <QDateTime>
 
@@ -142,6 +144,14 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemoryUsage() const override {
+                size_t result = 0u;
+                for (const auto& command : m_commands) {
+                    result += command->memoryUsage();
+                }
+                return result;
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -149,6 +159,7 @@ namespace TrenchBroom {
         CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval) :
         m_document(document),
         m_collationInterval(collationInterval),
+        m_undoMemoryLimit(0u),
         m_lastCommandTimestamp(std::chrono::time_point<std::chrono::system_clock>()) {}
 
         CommandProcessor::~CommandProcessor() = default;
@@ -177,6 +188,21 @@ namespace TrenchBroom {
             }
         }
 
+        size_t CommandProcessor::undoMemoryUsage() const {
+            size_t result = 0u;
+            for (const auto& command : m_undoStack) {
+                result += command->memoryUsage();
+            }
+            return result;
+        }
+
+        void CommandProcessor::setUndoMemoryLimit(const size_t undoMemoryLimit) {
+            m_undoMemoryLimit = undoMemoryLimit;
+            if (m_transactionStack.empty()) {
+                trimUndoStack();
+            }
+        }
+
         void CommandProcessor::startTransaction(const std::string& name) {
             m_transactionStack.push_back(TransactionState(name));
         }
@@ -211,10 +237,14 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<CommandResult> CommandProcessor::executeAndStore(std::unique_ptr<UndoableCommand> command) {
+            TB_PROFILE_ZONE("CommandProcessor::executeAndStore");
+
             return executeAndStoreCommand(std::move(command), true, true).commandResult;
         }
 
         std::unique_ptr<CommandResult> CommandProcessor::undo() {
+            TB_PROFILE_ZONE("CommandProcessor::undo");
+
             if (!m_transactionStack.empty()) {
                 throw CommandProcessorException("Cannot undo individual commands of a transaction");
             } else if (m_undoStack.empty()) {
@@ -232,6 +262,8 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<CommandResult> CommandProcessor::redo() {
+            TB_PROFILE_ZONE("CommandProcessor::redo");
+
             if (!m_transactionStack.empty()) {
                 throw CommandProcessorException("Cannot redo while in a transaction");
             } else if (m_redoStack.empty()) {
@@ -285,6 +317,8 @@ namespace TrenchBroom {
         }
 
         CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(std::unique_ptr<UndoableCommand> command, const bool collate, const bool repeatable) {
+            prepareCollation(*command, collate);
+
             auto commandResult = executeCommand(command.get());
             if (!commandResult->success()) {
                 return SubmitAndStoreResult(std::move(commandResult), false);
@@ -295,6 +329,22 @@ namespace TrenchBroom {
             return SubmitAndStoreResult(std::move(commandResult), commandStored);
         }
 
+        void CommandProcessor::prepareCollation(UndoableCommand& command, const bool collate) {
+            const UndoableCommand* lastCommand = nullptr;
+            if (!m_transactionStack.empty()) {
+                const auto& transaction = m_transactionStack.back();
+                if (collate && !transaction.commands.empty()) {
+                    lastCommand = transaction.commands.back().get();
+                }
+            } else if (collatable(collate, std::chrono::system_clock::now())) {
+                lastCommand = m_undoStack.back().get();
+            }
+
+            if (lastCommand != nullptr && lastCommand->willCollateWith(command)) {
+                command.setWillBeCollated();
+            }
+        }
+
         std::unique_ptr<CommandResult> CommandProcessor::executeCommand(Command* command) {
             notifyCommandIfNotType(commandDoNotifier, TransactionCommand::Type, command);
             auto result = command->performDo(m_document);
@@ -338,6 +388,7 @@ namespace TrenchBroom {
                     return false;
                 }
             }
+            assert(!command->willBeCollated());
             transaction.commands.push_back(std::move(command));
             return true;
         }
@@ -376,18 +427,22 @@ namespace TrenchBroom {
             const auto timestamp = std::chrono::system_clock::now();
             const kdl::set_later setLastCommandTimestamp(m_lastCommandTimestamp, timestamp);
 
-            if (collatable(collate, timestamp)) {
+            // a command that was prepared for collation must be collated even if executing it took too long
+            if (command->willBeCollated() || collatable(collate, timestamp)) {
                 auto& lastCommand = m_undoStack.back();
                 if (lastCommand->collateWith(command.get())) {
+                    trimUndoStack();
                     return false;
                 }
             }
+            assert(!command->willBeCollated());
 
             if (repeatable) {
                 pushToRepeatStack(command.get());
             }
 
             m_undoStack.push_back(std::move(command));
+            trimUndoStack();
             return true;
         }
 
@@ -404,6 +459,32 @@ namespace TrenchBroom {
             return collate && !m_undoStack.empty() && timestamp - m_lastCommandTimestamp <= m_collationInterval;
         }
 
+        void CommandProcessor::trimUndoStack() {
+            if (m_undoMemoryLimit == 0u || m_undoStack.size() < 2u) {
+                return;
+            }
+
+            // find the oldest command that can be kept, always keeping the topmost command
+            auto first = std::prev(std::end(m_undoStack));
+            size_t memoryUsage = (*first)->memoryUsage();
+            while (first != std::begin(m_undoStack)) {
+                const auto previousMemoryUsage = (*std::prev(first))->memoryUsage();
+                if (memoryUsage + previousMemoryUsage > m_undoMemoryLimit) {
+                    break;
+                }
+                memoryUsage += previousMemoryUsage;
+                --first;
+            }
+
+            if (first != std::begin(m_undoStack)) {
+                // the repeat stack must not refer to any of the removed commands
+                kdl::vec_erase_if(m_repeatStack, [&](const UndoableCommand* command) {
+                    return std::find_if(std::begin(m_undoStack), first, [&](const auto& removed) { return removed.get() == command; }) != first;
+                });
+                m_undoStack.erase(std::begin(m_undoStack), first);
+            }
+        }
+
         void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command) {
             assert(m_transactionStack.empty());
             m_redoStack.push_back(std::move(command));
@@ -23,6 +23,7 @@
 #include "Notifier.h"
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -50,6 +51,9 @@ namespace TrenchBroom {
          *
          * The command processor supports nested transactions. Each transaction can be committed or rolled back
          * individually. Committing a nested transaction adds it as a command to the containing transaction.
+         *
+         * The memory held by the commands on the undo stack can be limited. If the limit is exceeded, the oldest
+         * commands are removed from the undo stack, but the most recently executed command is always kept.
          */
         class CommandProcessor {
         private:
@@ -63,6 +67,12 @@ namespace TrenchBroom {
              */
             std::chrono::milliseconds m_collationInterval;
 
+            /**
+             * The maximum number of bytes that the commands on the undo stack may hold, or 0 if the undo stack is not
+             * limited.
+             */
+            size_t m_undoMemoryLimit;
+
             /**
              * Holds the commands that were executed so far, with the most recently executed command at the
              * end of the vector.
@@ -167,6 +177,19 @@ namespace TrenchBroom {
              */
             const std::string& redoCommandName() const;
 
+            /**
+             * Returns an estimate of the number of bytes held by the commands on the undo stack.
+             */
+            size_t undoMemoryUsage() const;
+
+            /**
+             * Sets the maximum number of bytes that the commands on the undo stack may hold. If the given limit is
+             * exceeded, the oldest commands are removed from the undo stack immediately.
+             *
+             * @param undoMemoryLimit the limit in bytes, or 0 to disable the limit
+             */
+            void setUndoMemoryLimit(size_t undoMemoryLimit);
+
             /**
              * Starts a new transaction. If a transaction is currently executing, then the newly started transaction
              * becomes a nested transaction and will be added as a command to its parent transaction upon commit.
@@ -307,6 +330,16 @@ namespace TrenchBroom {
              */
             SubmitAndStoreResult executeAndStoreCommand(std::unique_ptr<UndoableCommand> command, bool collate, bool repeatable);
 
+            /**
+             * Checks whether the given command is certain to be collated with the command it would be stored after, and
+             * if so, marks the given command accordingly so that it does not take a snapshot when it is executed. Since
+             * a collated command is never undone on its own, its snapshot would be discarded immediately.
+             *
+             * @param command the command that is about to be executed
+             * @param collate whether or not the given command should be collated with its predecessor
+             */
+            void prepareCollation(UndoableCommand& command, bool collate);
+
             /**
              * Executes the given command by calling its `performDo` method and triggers the corresponding
              * notifications.
@@ -396,6 +429,12 @@ namespace TrenchBroom {
 
             bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
+            /**
+             * Removes the oldest commands from the undo stack until the commands on the undo stack do not exceed the
+             * undo memory limit anymore. The topmost command is never removed.
+             */
+            void trimUndoStack();
+
             /**
              * Pushes the given command onto the redo stack. Takes ownership of the given command.
              *
@@ -22,6 +22,7 @@
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/FileMatcher.h"
+#include "IO/IOUtils.h"
 #include "IO/Path.h"
 #include "Model/CompilationProfile.h"
 #include "Model/CompilationTask.h"
@@ -29,17 +30,28 @@
 #include "View/CompilationVariables.h"
 #include "View/MapDocument.h"
 
+#include <kdl/invoke.h>
+#include <kdl/thread_pool.h>
+
+#include <cassert>
+#include <cstdio>
 #include <string>
 
 #include <QtGlobal>
 #include <QProcess>
+#include <QTimer>
 
 namespace TrenchBroom {
     namespace View {
         CompilationTaskRunner::CompilationTaskRunner(CompilationContext& context) :
         m_context(context) {}
 
-        CompilationTaskRunner::~CompilationTaskRunner() = default;
+        CompilationTaskRunner::~CompilationTaskRunner() {
+            // a background task must not be abandoned, e.g. a file that is being written
+            if (m_backgroundTask.valid()) {
+                m_backgroundTask.wait();
+            }
+        }
 
         void CompilationTaskRunner::execute() {
             doExecute();
@@ -58,6 +70,33 @@ namespace TrenchBroom {
             }
         }
 
+        void CompilationTaskRunner::executeInBackground(std::function<void()> task, std::string errorMessage) {
+            assert(!m_backgroundTask.valid());
+
+            m_backgroundTaskErrorMessage = std::move(errorMessage);
+            // the compilation waits for this task, so it is run with the same priority as work that the user waits for
+            m_backgroundTask = kdl::run_async([this, task = std::move(task)]() {
+                // the task ends on the UI thread, which waits for the future to become ready
+                const kdl::invoke_later notify{[this]() {
+                    QMetaObject::invokeMethod(this, "backgroundTaskDidFinish", Qt::QueuedConnection);
+                }};
+                task();
+            }, kdl::task_priority::interactive);
+        }
+
+        void CompilationTaskRunner::backgroundTaskDidFinish() {
+            assert(m_backgroundTask.valid());
+
+            try {
+                // rethrows any exception that was thrown by the background task
+                m_backgroundTask.get();
+                emit end();
+            } catch (const Exception& e) {
+                m_context << "#### " << m_backgroundTaskErrorMessage << ": " << e.what() << "\n";
+                emit error();
+            }
+        }
+
         CompilationExportMapTaskRunner::CompilationExportMapTaskRunner(CompilationContext& context, const Model::CompilationExportMap& task) :
         CompilationTaskRunner(context),
         m_task(task.clone()) {}
@@ -73,15 +112,24 @@ namespace TrenchBroom {
                     m_context << "#### Exporting map file '" << targetPath.asString() << "'\n";
 
                     if (!m_context.test()) {
-                        const IO::Path directoryPath = targetPath.deleteLastComponent();
-                        if (!IO::Disk::directoryExists(directoryPath)) {
-                            IO::Disk::createDirectory(directoryPath);
-                        }
-
+                        // the serialized map is a snapshot, so the document can be modified while the file is written
                         const auto document = m_context.document();
-                        document->saveDocumentTo(targetPath);
+                        auto contents = document->serializeDocument();
+
+                        executeInBackground([targetPath, contents = std::move(contents)]() {
+                            const IO::Path directoryPath = targetPath.deleteLastComponent();
+                            if (!IO::Disk::directoryExists(directoryPath)) {
+                                IO::Disk::createDirectory(directoryPath);
+                            }
+
+                            IO::OpenFile open(targetPath, true);
+                            if (std::fwrite(contents.data(), 1u, contents.size(), open.file) != contents.size()) {
+                                throw FileSystemException("Cannot write file: " + targetPath.asString());
+                            }
+                        }, "Could not export map file '" + targetPath.asString() + "'");
+                    } else {
+                        emit end();
                     }
-                    emit end();
                 } catch (const Exception& e) {
                     m_context << "#### Could not export map file '" << targetPath.asString() << "': " << e.what() << "\n";
                     throw;
@@ -113,9 +161,12 @@ namespace TrenchBroom {
                 try {
                     m_context << "#### Copying '" << sourcePath.asString() << "' to '" << targetPath.asString() << "'\n";
                     if (!m_context.test()) {
-                        IO::Disk::copyFiles(sourceDirPath, IO::FileNameMatcher(sourcePattern), targetPath, true);
+                        executeInBackground([sourceDirPath, sourcePattern, targetPath]() {
+                            IO::Disk::copyFiles(sourceDirPath, IO::FileNameMatcher(sourcePattern), targetPath, true);
+                        }, "Could not copy '" + sourcePath.asString() + "' to '" + targetPath.asString() + "'");
+                    } else {
+                        emit end();
                     }
-                    emit end();
                 } catch (const Exception& e) {
                     m_context << "#### Could not copy '" << sourcePath.asString() << "' to '" << targetPath.asString() << "': " << e.what() << "\n";
                     throw;
@@ -131,7 +182,12 @@ namespace TrenchBroom {
         CompilationTaskRunner(context),
         m_task(task.clone()),
         m_process(nullptr),
-        m_terminated(false) {}
+        m_terminated(false),
+        m_flushTimer(new QTimer(this)) {
+            m_flushTimer->setSingleShot(true);
+            m_flushTimer->setInterval(50);
+            connect(m_flushTimer, &QTimer::timeout, this, &CompilationRunToolTaskRunner::flushOutput);
+        }
 
         CompilationRunToolTaskRunner::~CompilationRunToolTaskRunner() = default;
 
@@ -144,6 +200,7 @@ namespace TrenchBroom {
                 disconnect(m_process, &QProcess::errorOccurred, this, &CompilationRunToolTaskRunner::processErrorOccurred);
                 disconnect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &CompilationRunToolTaskRunner::processFinished);
                 m_process->kill();
+                flushOutput();
                 m_context << "\n\n#### Terminated\n";
             }
         }
@@ -190,27 +247,46 @@ namespace TrenchBroom {
             }
         }
 
+        void CompilationRunToolTaskRunner::appendOutput(const QString& output) {
+            m_pendingOutput.append(output);
+            if (!m_flushTimer->isActive()) {
+                m_flushTimer->start();
+            }
+        }
+
+        void CompilationRunToolTaskRunner::flushOutput() {
+            m_flushTimer->stop();
+            if (!m_pendingOutput.isEmpty()) {
+                m_context << m_pendingOutput.toStdString();
+                m_pendingOutput.clear();
+            }
+        }
+
         void CompilationRunToolTaskRunner::processErrorOccurred(const QProcess::ProcessError processError) {
+            flushOutput();
             m_context << "#### Error " << processError << " occurred when communicating with process\n\n";
             emit error();
         }
 
         void CompilationRunToolTaskRunner::processFinished(const int exitCode, const QProcess::ExitStatus /* exitStatus */) {
+            // the process may have written more output before it finished
+            processReadyReadStandardError();
+            processReadyReadStandardOutput();
+            flushOutput();
+
             m_context << "#### Finished with exit status " << exitCode << "\n\n";
             emit end();
         }
 
         void CompilationRunToolTaskRunner::processReadyReadStandardError() {
             if (m_process != nullptr) {
-                const auto str = QString::fromLocal8Bit(m_process->readAllStandardError());
-                m_context << str.toStdString();
+                appendOutput(QString::fromLocal8Bit(m_process->readAllStandardError()));
             }
         }
 
         void CompilationRunToolTaskRunner::processReadyReadStandardOutput() {
             if (m_process != nullptr) {
-                const auto str = QString::fromLocal8Bit(m_process->readAllStandardOutput());
-                m_context << str.toStdString();
+                appendOutput(QString::fromLocal8Bit(m_process->readAllStandardOutput()));
             }
         }
 
@@ -22,12 +22,17 @@
 
 #include "Macros.h"
 
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <QObject>
 #include <QProcess> // for QProcess::ProcessError
+#include <QString>
+
+class QTimer;
 
 namespace TrenchBroom {
     namespace Model {
@@ -44,6 +49,9 @@ namespace TrenchBroom {
             Q_OBJECT
         protected:
             CompilationContext& m_context;
+        private:
+            std::future<void> m_backgroundTask;
+            std::string m_backgroundTaskErrorMessage;
         protected:
             explicit CompilationTaskRunner(CompilationContext& context);
         public:
@@ -57,6 +65,17 @@ namespace TrenchBroom {
             void end();
         protected:
             std::string interpolate(const std::string& spec);
+
+            /**
+             * Runs the given task on a background thread and signals the end of this task once it has finished. If the
+             * background task throws an exception, the given error message and the exception's message are printed to
+             * the compilation output, and an error is signalled instead.
+             *
+             * Only one background task may be running at a time. The destructor waits for it to finish.
+             */
+            void executeInBackground(std::function<void()> task, std::string errorMessage);
+        private slots:
+            void backgroundTaskDidFinish();
         private:
             virtual void doExecute() = 0;
             virtual void doTerminate() = 0;
@@ -64,6 +83,10 @@ namespace TrenchBroom {
             deleteCopyAndMove(CompilationTaskRunner)
         };
 
+        /**
+         * Exports the map for compilation. The map is serialized on the calling thread, but the file is written on a
+         * background thread.
+         */
         class CompilationExportMapTaskRunner : public CompilationTaskRunner {
             Q_OBJECT
         private:
@@ -78,6 +101,9 @@ namespace TrenchBroom {
             deleteCopyAndMove(CompilationExportMapTaskRunner)
         };
 
+        /**
+         * Copies files on a background thread.
+         */
         class CompilationCopyFilesTaskRunner : public CompilationTaskRunner {
             Q_OBJECT
         private:
@@ -98,6 +124,14 @@ namespace TrenchBroom {
             std::unique_ptr<const Model::CompilationRunTool> m_task;
             QProcess* m_process;
             bool m_terminated;
+
+            /**
+             * The output of the process is collected here and appended to the compilation output at most once per
+             * flush interval, because appending every chunk the process writes makes the UI unresponsive for tools
+             * that produce a lot of output.
+             */
+            QString m_pendingOutput;
+            QTimer* m_flushTimer;
         public:
             CompilationRunToolTaskRunner(CompilationContext& context, const Model::CompilationRunTool& task);
             ~CompilationRunToolTaskRunner() override;
@@ -107,7 +141,9 @@ namespace TrenchBroom {
         private:
             void startProcess();
             std::string cmd();
+            void appendOutput(const QString& output);
         private slots:
+            void flushOutput();
             void processErrorOccurred(QProcess::ProcessError processError);
             void processFinished(int exitCode, QProcess::ExitStatus exitStatus);
             void processReadyReadStandardError();
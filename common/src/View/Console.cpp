@@ -25,17 +25,26 @@
 #include <string>
 
 #include <QDebug>
+#include <QPlainTextEdit>
 #include <QScrollBar>
-#include <QTextEdit>
+#include <QTimer>
 #include <QVBoxLayout>
 
 namespace TrenchBroom {
     namespace View {
         Console::Console(QWidget* parent) :
-        TabBookPage(parent) {
-            m_textView = new QTextEdit();
+        TabBookPage(parent),
+        m_textView(nullptr),
+        m_flushTimer(nullptr) {
+            m_textView = new QPlainTextEdit();
             m_textView->setReadOnly(true);
             m_textView->setWordWrapMode(QTextOption::NoWrap);
+            m_textView->setMaximumBlockCount(10000);
+
+            m_flushTimer = new QTimer(this);
+            m_flushTimer->setSingleShot(true);
+            m_flushTimer->setInterval(50);
+            connect(m_flushTimer, &QTimer::timeout, this, &Console::flushMessages);
 
             QVBoxLayout* sizer = new QVBoxLayout();
             sizer->setContentsMargins(0, 0, 0, 0);
@@ -60,26 +69,40 @@ namespace TrenchBroom {
         }
 
         void Console::logToConsole(const LogLevel level, const QString& message) {
-            QTextCharFormat format;
-            switch (level) {
-                case LogLevel::Debug:
-                    format.setForeground(QBrush(Colors::disabledText()));
-                    break;
-                case LogLevel::Info:
-                    break;
-                case LogLevel::Warn:
-                    format.setForeground(QBrush(Colors::defaultText()));
-                    break;
-                case LogLevel::Error:
-                    format.setForeground(QBrush(QColor(250, 30, 60)));
-                    break;
+            m_pendingMessages.emplace_back(level, message);
+            if (!m_flushTimer->isActive()) {
+                m_flushTimer->start();
             }
-            format.setFont(Fonts::fixedWidthFont());
+        }
 
+        void Console::flushMessages() {
             QTextCursor cursor(m_textView->document());
+            cursor.beginEditBlock();
             cursor.movePosition(QTextCursor::MoveOperation::End);
-            cursor.insertText(message, format);
-            cursor.insertText("\n");
+
+            for (const auto& [level, message] : m_pendingMessages) {
+                QTextCharFormat format;
+                switch (level) {
+                    case LogLevel::Debug:
+                        format.setForeground(QBrush(Colors::disabledText()));
+                        break;
+                    case LogLevel::Info:
+                        break;
+                    case LogLevel::Warn:
+                        format.setForeground(QBrush(Colors::defaultText()));
+                        break;
+                    case LogLevel::Error:
+                        format.setForeground(QBrush(QColor(250, 30, 60)));
+                        break;
+                }
+                format.setFont(Fonts::fixedWidthFont());
+
+                cursor.insertText(message, format);
+                cursor.insertText("\n");
+            }
+
+            cursor.endEditBlock();
+            m_pendingMessages.clear();
 
             m_textView->moveCursor(QTextCursor::MoveOperation::End);
         }
@@ -24,16 +24,29 @@
 #include "View/TabBook.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
-class QTextEdit;
-class QString;
+#include <QString>
+
+class QPlainTextEdit;
+class QTimer;
 class QWidget;
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * Shows the log messages in a text view.
+         *
+         * Messages are collected and appended to the text view at most once per flush interval, because appending
+         * every message individually makes the UI unresponsive when many messages are logged at once. The text view
+         * only keeps the most recent lines.
+         */
         class Console : public TabBookPage, public Logger {
         private:
-            QTextEdit* m_textView;
+            QPlainTextEdit* m_textView;
+            QTimer* m_flushTimer;
+            std::vector<std::pair<LogLevel, QString>> m_pendingMessages;
         public:
             explicit Console(QWidget* parent = nullptr);
         private:
@@ -41,6 +54,7 @@ namespace TrenchBroom {
             void doLog(LogLevel level, const QString& message) override;
             void logToDebugOut(LogLevel level, const QString& message);
             void logToConsole(LogLevel level, const QString& message);
+            void flushMessages();
         };
     }
 }
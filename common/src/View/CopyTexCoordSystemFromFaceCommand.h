@@ -61,6 +61,8 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            size_t doGetMemoryUsage() const override;
+
             deleteCopyAndMove(CopyTexCoordSystemFromFaceCommand)
         };
     }
@@ -46,6 +46,7 @@ namespace TrenchBroom {
         }
 
         void CreateBrushToolBase::createBrush() {
+            doBrushWillBeCreated();
             if (m_brush != nullptr) {
                 auto document = kdl::mem_lock(m_document);
                 const Transaction transaction(document, "Create Brush");
@@ -93,6 +94,7 @@ namespace TrenchBroom {
             m_brush = brush;
         }
 
+        void CreateBrushToolBase::doBrushWillBeCreated() {}
         void CreateBrushToolBase::doBrushWasCreated() {}
     }
 }
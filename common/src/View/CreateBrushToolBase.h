@@ -60,6 +60,7 @@ namespace TrenchBroom {
         protected:
             void updateBrush(Model::Brush* brush);
         private:
+            virtual void doBrushWillBeCreated();
             virtual void doBrushWasCreated();
         };
     }
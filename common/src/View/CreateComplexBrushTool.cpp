@@ -19,9 +19,11 @@
 
 #include "CreateComplexBrushTool.h"
 
+#include "Exceptions.h"
 #include "PreferenceManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFaceAttributes.h"
 #include "Model/Polyhedron.h"
 #include "Model/World.h"
 #include "Model/Game.h"
@@ -33,7 +35,13 @@ namespace TrenchBroom {
     namespace View {
         CreateComplexBrushTool::CreateComplexBrushTool(std::weak_ptr<MapDocument> document) :
         CreateBrushToolBase(false, document),
-        m_polyhedron(std::make_unique<Model::Polyhedron3>()){}
+        m_polyhedron(std::make_unique<Model::Polyhedron3>()),
+        m_brushPreview([this](std::unique_ptr<Model::Brush> brush) {
+            updateBrush(brush.release());
+            refreshViews();
+        }) {}
+
+        CreateComplexBrushTool::~CreateComplexBrushTool() = default;
 
         const Model::Polyhedron3& CreateComplexBrushTool::polyhedron() const {
             return *m_polyhedron;
@@ -44,10 +52,22 @@ namespace TrenchBroom {
             if (m_polyhedron->closed()) {
                 auto document = kdl::mem_lock(m_document);
                 const auto game = document->game();
-                const Model::BrushBuilder builder(document->world(), document->worldBounds(), game->defaultFaceAttribs());
-                Model::Brush* brush = builder.createBrush(*m_polyhedron, document->currentTextureName());
-                updateBrush(brush);
+
+                // everything the brush is built from is copied because the document may change in the meantime
+                auto* world = document->world();
+                const auto& worldBounds = document->worldBounds();
+                const auto& defaultFaceAttribs = game->defaultFaceAttribs();
+                const auto& textureName = document->currentTextureName();
+                m_brushPreview.request([world, worldBounds, defaultFaceAttribs, textureName, polyhedron = *m_polyhedron]() {
+                    try {
+                        const Model::BrushBuilder builder(world, worldBounds, defaultFaceAttribs);
+                        return std::unique_ptr<Model::Brush>(builder.createBrush(polyhedron, textureName));
+                    } catch (const GeometryException&) {
+                        return std::unique_ptr<Model::Brush>();
+                    }
+                });
             } else {
+                m_brushPreview.cancel();
                 updateBrush(nullptr);
             }
         }
@@ -62,6 +82,11 @@ namespace TrenchBroom {
             return true;
         }
 
+        void CreateComplexBrushTool::doBrushWillBeCreated() {
+            // the brush must match the current polyhedron
+            m_brushPreview.finish();
+        }
+
         void CreateComplexBrushTool::doBrushWasCreated() {
             update(Model::Polyhedron3());
         }
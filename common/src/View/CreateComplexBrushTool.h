@@ -22,22 +22,34 @@
 
 #include "Model/Polyhedron3.h"
 #include "View/CreateBrushToolBase.h"
+#include "View/SpeculativePreview.h"
 
 #include <memory>
 
 namespace TrenchBroom {
+    namespace Model {
+        class Brush;
+    }
+
     namespace View {
         class CreateComplexBrushTool : public CreateBrushToolBase {
         private:
             std::unique_ptr<Model::Polyhedron3> m_polyhedron;
+
+            /**
+             * Builds the brush from the polyhedron on a background thread while the polyhedron is being edited.
+             */
+            SpeculativePreview<std::unique_ptr<Model::Brush>> m_brushPreview;
         public:
             CreateComplexBrushTool(std::weak_ptr<MapDocument> document);
+            ~CreateComplexBrushTool() override;
 
             const Model::Polyhedron3& polyhedron() const;
             void update(const Model::Polyhedron3& polyhedron);
         private:
             bool doActivate() override;
             bool doDeactivate() override;
+            void doBrushWillBeCreated() override;
             void doBrushWasCreated() override;
         };
     }
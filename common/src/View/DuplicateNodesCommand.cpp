@@ -25,6 +25,8 @@
 
 #include <kdl/map_utils.h>
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace View {
         const Command::CommandType DuplicateNodesCommand::Type = Command::freeType();
@@ -50,8 +52,12 @@ namespace TrenchBroom {
                 const vm::bbox3& worldBounds = document->worldBounds();
                 m_previouslySelectedNodes = document->selectedNodes().nodes();
 
-                for (const Model::Node* original : m_previouslySelectedNodes) {
-                    Model::Node* clone = original->cloneRecursively(worldBounds);
+                // clone all nodes at once so that their brushes are cloned in parallel
+                const std::vector<Model::Node*> clones = Model::Node::cloneRecursively(worldBounds, m_previouslySelectedNodes);
+
+                for (size_t i = 0; i < m_previouslySelectedNodes.size(); ++i) {
+                    const Model::Node* original = m_previouslySelectedNodes[i];
+                    Model::Node* clone = clones[i];
 
                     Model::Node* parent = original->parent();
                     if (cloneParent(parent)) {
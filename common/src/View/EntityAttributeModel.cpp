@@ -38,6 +38,7 @@
 #include <kdl/vector_utils.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
 #include <iterator>
 #include <optional>
 #include <string>
@@ -221,20 +222,89 @@ namespace TrenchBroom {
             return result.release_data();
         }
 
+        namespace {
+            /**
+             * The values of one attribute collected from all nodes in a single pass over their attributes.
+             */
+            struct MergedAttribute {
+                const std::string* firstValue = nullptr;
+                size_t count = 0u;
+                bool multipleValues = false;
+            };
+        }
+
         std::map<std::string, AttributeRow> AttributeRow::rowsForAttributableNodes(const std::vector<Model::AttributableNode*>& attributables, const bool showDefaultRows) {
+            // Merging every node into the row of every key looks up each key in each node, which does not scale to
+            // large selections. Instead, the attributes of every node are visited once, and the value type of each row
+            // is derived from the number of nodes that have the attribute and whether their values differ.
+            std::map<std::string, MergedAttribute> merged;
+            const Model::AttributableNode* firstNode = nullptr;
+            size_t nodeCount = 0u;
+
+            for (const Model::AttributableNode* node : attributables) {
+                // this happens at startup when the world is still null
+                if (node == nullptr) {
+                    continue;
+                }
+
+                if (firstNode == nullptr) {
+                    firstNode = node;
+                }
+                ++nodeCount;
+
+                for (const Model::EntityAttribute& attribute : node->attributes()) {
+                    MergedAttribute& entry = merged[attribute.name()];
+                    if (entry.count == 0u) {
+                        entry.firstValue = &attribute.value();
+                    } else if (!entry.multipleValues && *entry.firstValue != attribute.value()) {
+                        entry.multipleValues = true;
+                    }
+                    ++entry.count;
+                }
+
+                if (showDefaultRows) {
+                    const Assets::EntityDefinition* entityDefinition = node->definition();
+                    if (entityDefinition != nullptr) {
+                        for (const auto& attributeDefinition : entityDefinition->attributeDefinitions()) {
+                            merged.try_emplace(attributeDefinition->name());
+                        }
+                    }
+                }
+            }
+
             std::map<std::string, AttributeRow> result;
-            for (const std::string& key : allKeys(attributables, showDefaultRows)) {
-                result[key] = rowForAttributableNodes(key, attributables);
+            for (const auto& [key, entry] : merged) {
+                AttributeRow row(key, firstNode);
+                if (entry.count > 0u) {
+                    row.m_value = *entry.firstValue;
+                    if (entry.multipleValues) {
+                        row.m_valueType = ValueType::MultipleValues;
+                    } else if (entry.count < nodeCount) {
+                        row.m_valueType = ValueType::SingleValueAndUnset;
+                    } else {
+                        row.m_valueType = ValueType::SingleValue;
+                    }
+                }
+
+                for (const Model::AttributableNode* node : attributables) {
+                    if (node != nullptr && node != firstNode) {
+                        row.m_nameMutable = (row.m_nameMutable && node->isAttributeNameMutable(key));
+                        row.m_valueMutable = (row.m_valueMutable && node->isAttributeValueMutable(key));
+                    }
+                }
+
+                result.emplace_hint(std::end(result), key, std::move(row));
             }
             return result;
         }
 
         std::string AttributeRow::newAttributeNameForAttributableNodes(const std::vector<Model::AttributableNode*>& attributables) {
-            const std::map<std::string, AttributeRow> rows = rowsForAttributableNodes(attributables, true);
+            // allKeys returns the keys in sorted order
+            const std::vector<std::string> keys = allKeys(attributables, true);
 
             for (int i = 1; ; ++i) {
                 const std::string newName = kdl::str_to_string("property ", i);
-                if (rows.find(newName) == rows.end()) {
+                if (!std::binary_search(std::begin(keys), std::end(keys), newName)) {
                     return newName;
                 }
             }
@@ -29,6 +29,7 @@
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModel.h"
 #include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
 #include "Renderer/GL.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/FontManager.h"
@@ -56,6 +57,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 // allow storing std::shared_ptr in QVariant
@@ -150,25 +152,50 @@ namespace TrenchBroom {
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
 
+            // collect the shown definitions first so that their models can be loaded in parallel rather than one by
+            // one while the definitions are added to the layout
+            using DefinitionGroup = std::pair<std::string, std::vector<const Assets::PointEntityDefinition*>>;
+            std::vector<DefinitionGroup> groups;
+
+            const auto collectDefinitions = [&](const std::vector<Assets::EntityDefinition*>& definitions, std::vector<const Assets::PointEntityDefinition*>& result) {
+                for (const auto* definition : definitions) {
+                    const auto* pointEntityDefinition = static_cast<const Assets::PointEntityDefinition*>(definition);
+                    if (shouldShow(pointEntityDefinition)) {
+                        result.push_back(pointEntityDefinition);
+                    }
+                }
+            };
+
             if (m_group) {
                 for (const auto& group : m_entityDefinitionManager.groups()) {
                     const auto& definitions = group.definitions(Assets::EntityDefinitionType::PointEntity, m_sortOrder);
-
                     if (!definitions.empty()) {
-                        const auto displayName = group.displayName();
-                        layout.addGroup(displayName, static_cast<float>(fontSize)+ 2.0f);
-
-                        for (const auto* definition : definitions) {
-                            const auto* pointEntityDefinition = static_cast<const Assets::PointEntityDefinition*>(definition);
-                            addEntityToLayout(layout, pointEntityDefinition, font);
-                        }
+                        groups.emplace_back(group.displayName(), std::vector<const Assets::PointEntityDefinition*>());
+                        collectDefinitions(definitions, groups.back().second);
                     }
                 }
             } else {
-                const auto& definitions = m_entityDefinitionManager.definitions(Assets::EntityDefinitionType::PointEntity, m_sortOrder);
-                for (const auto* definition : definitions) {
-                    const auto* pointEntityDefinition = static_cast<const Assets::PointEntityDefinition*>(definition);
-                    addEntityToLayout(layout, pointEntityDefinition, font);
+                groups.emplace_back(std::string(), std::vector<const Assets::PointEntityDefinition*>());
+                collectDefinitions(m_entityDefinitionManager.definitions(Assets::EntityDefinitionType::PointEntity, m_sortOrder), groups.back().second);
+            }
+
+            std::vector<Assets::ModelSpecification> specs;
+            for (const auto& group : groups) {
+                for (const auto* definition : group.second) {
+                    specs.push_back(Assets::safeGetModelSpecification(m_logger, definition->name(), [&]() {
+                        return definition->defaultModel();
+                    }));
+                }
+            }
+            m_entityModelManager.loadModels(specs);
+
+            auto spec = std::begin(specs);
+            for (const auto& group : groups) {
+                if (m_group) {
+                    layout.addGroup(group.first, static_cast<float>(fontSize)+ 2.0f);
+                }
+                for (const auto* definition : group.second) {
+                    addEntityToLayout(layout, definition, *spec++, font);
                 }
             }
         }
@@ -183,41 +210,39 @@ namespace TrenchBroom {
             return prefix + name;
         }
 
-        void EntityBrowserView::addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Renderer::FontDescriptor& font) {
-            if ((!m_hideUnused || definition->usageCount() > 0) &&
-                (m_filterText.empty() || kdl::ci::str_contains(definition->name(), m_filterText))) {
-
-                const auto maxCellWidth = layout.maxCellWidth();
-                const auto actualFont = fontManager().selectFontSize(font, definition->name(), maxCellWidth, 5);
-                const auto actualSize = fontManager().font(actualFont).measure(definition->name());
-                const auto spec = Assets::safeGetModelSpecification(m_logger, definition->name(), [&]() {
-                    return definition->defaultModel();
-                });
-
-                const auto* frame = m_entityModelManager.frame(spec);
-                Renderer::TexturedRenderer* modelRenderer = nullptr;
-
-                vm::bbox3f rotatedBounds;
-                if (frame != nullptr) {
-                    const auto bounds = frame->bounds();
-                    const auto center = bounds.center();
-                    const auto transform =vm::translation_matrix(center) * vm::rotation_matrix(m_rotation) *vm::translation_matrix(-center);
-                    rotatedBounds = bounds.transform(transform);
-                    modelRenderer = m_entityModelManager.renderer(spec);
-                } else {
-                    rotatedBounds = vm::bbox3f(definition->bounds());
-                    const auto center = rotatedBounds.center();
-                    const auto transform =vm::translation_matrix(-center) * vm::rotation_matrix(m_rotation) *vm::translation_matrix(center);
-                    rotatedBounds = rotatedBounds.transform(transform);
-                }
+        bool EntityBrowserView::shouldShow(const Assets::PointEntityDefinition* definition) const {
+            return (!m_hideUnused || definition->usageCount() > 0) &&
+                   (m_filterText.empty() || kdl::ci::str_contains(definition->name(), m_filterText));
+        }
 
-                const auto boundsSize = rotatedBounds.size();
-                layout.addItem(QVariant::fromValue(std::make_shared<EntityCellData>(definition, modelRenderer, actualFont, rotatedBounds)),
-                               boundsSize.y(),
-                               boundsSize.z(),
-                               actualSize.x(),
-                               static_cast<float>(font.size()) + 2.0f);
+        void EntityBrowserView::addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Assets::ModelSpecification& spec, const Renderer::FontDescriptor& font) {
+            const auto maxCellWidth = layout.maxCellWidth();
+            const auto actualFont = fontManager().selectFontSize(font, definition->name(), maxCellWidth, 5);
+            const auto actualSize = fontManager().font(actualFont).measure(definition->name());
+
+            const auto* frame = m_entityModelManager.frame(spec);
+            Renderer::TexturedRenderer* modelRenderer = nullptr;
+
+            vm::bbox3f rotatedBounds;
+            if (frame != nullptr) {
+                const auto bounds = frame->bounds();
+                const auto center = bounds.center();
+                const auto transform =vm::translation_matrix(center) * vm::rotation_matrix(m_rotation) *vm::translation_matrix(-center);
+                rotatedBounds = bounds.transform(transform);
+                modelRenderer = m_entityModelManager.renderer(spec);
+            } else {
+                rotatedBounds = vm::bbox3f(definition->bounds());
+                const auto center = rotatedBounds.center();
+                const auto transform =vm::translation_matrix(-center) * vm::rotation_matrix(m_rotation) *vm::translation_matrix(center);
+                rotatedBounds = rotatedBounds.transform(transform);
             }
+
+            const auto boundsSize = rotatedBounds.size();
+            layout.addItem(QVariant::fromValue(std::make_shared<EntityCellData>(definition, modelRenderer, actualFont, rotatedBounds)),
+                           boundsSize.y(),
+                           boundsSize.z(),
+                           actualSize.x(),
+                           static_cast<float>(font.size()) + 2.0f);
         }
 
         void EntityBrowserView::doClear() {}
@@ -39,6 +39,7 @@ namespace TrenchBroom {
         enum class EntityDefinitionSortOrder;
         class EntityModelManager;
         class PointEntityDefinition;
+        struct ModelSpecification;
     }
 
     namespace Renderer {
@@ -100,7 +101,8 @@ namespace TrenchBroom {
             bool dndEnabled() override;
             QString dndData(const Cell& cell) override;
 
-            void addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Renderer::FontDescriptor& font);
+            bool shouldShow(const Assets::PointEntityDefinition* definition) const;
+            void addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Assets::ModelSpecification& spec, const Renderer::FontDescriptor& font);
 
             void doClear() override;
             void doRender(Layout& layout, float y, float height) override;
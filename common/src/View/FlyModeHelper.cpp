@@ -30,10 +30,18 @@
 
 namespace TrenchBroom {
     namespace View {
-        static qint64 msecsSinceReference() {
-            QElapsedTimer timer;
-            timer.start();
-            return timer.msecsSinceReference();
+        /**
+         * Returns the time in nanoseconds from a monotonic clock. Millisecond resolution is too coarse for the frame times
+         * of fast displays and makes the camera movement stutter, since the time between two frames alternates between
+         * whole milliseconds.
+         */
+        static qint64 nsecsSinceReference() {
+            static const QElapsedTimer timer = []() {
+                QElapsedTimer result;
+                result.start();
+                return result;
+            }();
+            return timer.nsecsElapsed();
         }
 
         FlyModeHelper::FlyModeHelper(Renderer::Camera& camera) :
@@ -44,11 +52,11 @@ namespace TrenchBroom {
         m_right(false),
         m_up(false),
         m_down(false),
-        m_lastPollTime(msecsSinceReference()) {}
+        m_lastPollTime(nsecsSinceReference()) {}
 
         void FlyModeHelper::pollAndUpdate() {
-            const auto currentTime = msecsSinceReference();
-            const auto time = float(currentTime - m_lastPollTime);
+            const auto currentTime = nsecsSinceReference();
+            const auto time = float(currentTime - m_lastPollTime) / 1000000.0f;
             m_lastPollTime = currentTime;
 
             if (anyKeyDown()) {
@@ -102,7 +110,7 @@ namespace TrenchBroom {
 
             if (anyKeyDown() && !wasAnyKeyDown) {
                 // Reset the last polling time, otherwise the view will jump!
-                m_lastPollTime = msecsSinceReference();
+                m_lastPollTime = nsecsSinceReference();
             }
         }
 
@@ -43,6 +43,9 @@ namespace TrenchBroom {
             bool m_up;
             bool m_down;
 
+            /**
+             * The time of the last call to pollAndUpdate() in nanoseconds.
+             */
             int64_t m_lastPollTime;
         public:
             explicit FlyModeHelper(Renderer::Camera& camera);
@@ -20,8 +20,11 @@
 #include "GLContextManager.h"
 
 #include "Exceptions.h"
+#include "IO/Path.h"
+#include "IO/SystemPaths.h"
 #include "Renderer/FontManager.h"
 #include "Renderer/GL.h"
+#include "Renderer/ShaderBinaryCache.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderProgram.h"
@@ -66,6 +69,9 @@ namespace TrenchBroom {
                 GLRenderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
                 GLVersion  = reinterpret_cast<const char*>(glGetString(GL_VERSION));
 
+                const auto shaderCacheDirectory = IO::SystemPaths::userDataDirectory() + IO::Path("ShaderCache");
+                m_shaderManager->setBinaryCache(std::make_unique<Renderer::ShaderBinaryCache>(shaderCacheDirectory, GLVendor + "\n" + GLRenderer + "\n" + GLVersion));
+
                 m_initialized = true;
                 return true;
             }
@@ -26,6 +26,8 @@
 
 #include <vecmath/vec.h>
 
+#include <utility>
+
 #include <QCursor>
 
 namespace TrenchBroom {
@@ -204,5 +206,10 @@ namespace TrenchBroom {
         void InputState::setPickResult(Model::PickResult&& pickResult) {
             m_pickResult = std::move(pickResult);
         }
+
+        void InputState::swapPickResult(Model::PickResult& pickResult) {
+            using std::swap;
+            swap(m_pickResult, pickResult);
+        }
     }
 }
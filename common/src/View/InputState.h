@@ -109,6 +109,7 @@ namespace TrenchBroom {
 
             const Model::PickResult& pickResult() const;
             void setPickResult(Model::PickResult&& pickResult);
+            void swapPickResult(Model::PickResult& pickResult);
         };
     }
 }
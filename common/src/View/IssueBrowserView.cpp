@@ -29,6 +29,7 @@
 #include <kdl/memory_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <iterator>
 #include <vector>
 
 #include <QHBoxLayout>
@@ -132,6 +133,8 @@ namespace TrenchBroom {
             auto document = kdl::mem_lock(m_document);
             Model::World* world = document->world();
             if (world != nullptr) {
+                world->validateBrushIssues();
+
                 const std::vector<Model::IssueGenerator*>& issueGenerators = world->registeredIssueGenerators();
                 Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
                 world->acceptAndRecurse(visitor);
@@ -201,7 +204,8 @@ namespace TrenchBroom {
         }
 
         QList<QModelIndex> IssueBrowserView::getSelection() const {
-            return m_tableView->selectionModel()->selectedIndexes();
+            // only one index per row, otherwise every selected issue would be collected once per column
+            return m_tableView->selectionModel()->selectedRows();
         }
 
         void IssueBrowserView::bindEvents() {
@@ -274,9 +278,74 @@ namespace TrenchBroom {
           m_issues() {}
 
         void IssueBrowserModel::setIssues(std::vector<Model::Issue*> issues) {
-            beginResetModel();
+            struct Change {
+                bool insert;
+                size_t row;
+                size_t first;
+                size_t count;
+            };
+
+            static const size_t MaxIncrementalChanges = 64u;
+
+            // both lists are sorted by descending sequence ID, so the runs of removed and inserted issues are found in
+            // a single merge pass; the rows are given in the coordinates of the model after the preceding changes
+            std::vector<Change> changes;
+            size_t row = 0u, i = 0u, j = 0u;
+            while ((i < m_issueIds.size() || j < issues.size()) && changes.size() <= MaxIncrementalChanges) {
+                if (j == issues.size() || (i < m_issueIds.size() && m_issueIds[i] > issues[j]->seqId())) {
+                    const size_t first = i;
+                    while (i < m_issueIds.size() && (j == issues.size() || m_issueIds[i] > issues[j]->seqId())) {
+                        ++i;
+                    }
+                    changes.push_back(Change{false, row, first, i - first});
+                } else if (i == m_issueIds.size() || issues[j]->seqId() > m_issueIds[i]) {
+                    const size_t first = j;
+                    while (j < issues.size() && (i == m_issueIds.size() || issues[j]->seqId() > m_issueIds[i])) {
+                        ++j;
+                    }
+                    changes.push_back(Change{true, row, first, j - first});
+                    row += j - first;
+                } else {
+                    ++row; ++i; ++j;
+                }
+            }
+
+            if (changes.size() > MaxIncrementalChanges) {
+                beginResetModel();
+                m_issues = std::move(issues);
+                m_issueIds = kdl::vec_transform(m_issues, [](const Model::Issue* issue) { return issue->seqId(); });
+                endResetModel();
+                return;
+            }
+
+            for (const Change& change : changes) {
+                const auto firstRow = static_cast<int>(change.row);
+                const auto lastRow = static_cast<int>(change.row + change.count) - 1;
+                const auto begin = std::next(std::begin(m_issues), static_cast<std::ptrdiff_t>(change.row));
+                const auto beginId = std::next(std::begin(m_issueIds), static_cast<std::ptrdiff_t>(change.row));
+
+                if (change.insert) {
+                    const auto newBegin = std::next(std::begin(issues), static_cast<std::ptrdiff_t>(change.first));
+                    const auto newEnd = std::next(newBegin, static_cast<std::ptrdiff_t>(change.count));
+
+                    beginInsertRows(QModelIndex(), firstRow, lastRow);
+                    m_issueIds.insert(beginId, change.count, 0u);
+                    m_issues.insert(begin, newBegin, newEnd);
+                    endInsertRows();
+                } else {
+                    beginRemoveRows(QModelIndex(), firstRow, lastRow);
+                    m_issueIds.erase(beginId, std::next(beginId, static_cast<std::ptrdiff_t>(change.count)));
+                    m_issues.erase(begin, std::next(begin, static_cast<std::ptrdiff_t>(change.count)));
+                    endRemoveRows();
+                }
+            }
+
+            // the issues that remained may have been hidden or shown, and the IDs of the inserted issues are still unset
             m_issues = std::move(issues);
-            endResetModel();
+            m_issueIds = kdl::vec_transform(m_issues, [](const Model::Issue* issue) { return issue->seqId(); });
+            if (!m_issues.empty()) {
+                emit dataChanged(index(0, 0), index(static_cast<int>(m_issues.size()) - 1, 1));
+            }
         }
 
         const std::vector<Model::Issue*>& IssueBrowserModel::issues() {
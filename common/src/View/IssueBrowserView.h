@@ -98,9 +98,21 @@ namespace TrenchBroom {
             Q_OBJECT
         private:
             std::vector<Model::Issue*> m_issues;
+            /**
+             * The sequence IDs of the issues in m_issues. The issues of the previous call to setIssues() may have been
+             * deleted already, so the new issues are diffed against these IDs instead.
+             */
+            std::vector<size_t> m_issueIds;
         public:
             explicit IssueBrowserModel(QObject* parent);
 
+            /**
+             * Replaces the issues shown by this model. The given issues must be sorted by descending sequence ID.
+             *
+             * The new issues are diffed against the current issues, and runs of removed and inserted issues are reported
+             * as row removals and insertions, so that the view does not lose its selection and does not have to
+             * relayout all rows. If there are too many runs, the model is reset instead.
+             */
             void setIssues(std::vector<Model::Issue*> issues);
             const std::vector<Model::Issue*>& issues();
         public: // QAbstractTableModel overrides
@@ -28,6 +28,10 @@
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 #include <vecmath/intersection.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
 
 namespace TrenchBroom {
     namespace View {
@@ -57,6 +61,29 @@ namespace TrenchBroom {
             return selects(polygon.center(), plane, box);
         }
 
+        std::optional<std::pair<size_t, vm::bbox3>> Lasso::axisAlignedBounds() const {
+            if (!m_camera.orthographicProjection()) {
+                return std::nullopt;
+            }
+
+            const auto direction = vm::vec3(m_camera.direction());
+            const auto axis = vm::find_abs_max_component(direction);
+            if (!vm::is_equal(std::abs(direction[axis]), 1.0, vm::C::almost_zero())) {
+                return std::nullopt;
+            }
+
+            const auto [invertible, inverseTransform] = invert(m_transform);
+            if (!invertible) {
+                return std::nullopt;
+            }
+
+            // the lasso box is an axis aligned rectangle in the view plane, so its corners span the world bounds
+            const auto box = this->box();
+            const auto min = inverseTransform * vm::vec3(box.min.x(), box.min.y(), 0.0);
+            const auto max = inverseTransform * vm::vec3(box.max.x(), box.max.y(), 0.0);
+            return std::make_pair(axis, vm::bbox3(vm::min(min, max), vm::max(min, max)));
+        }
+
         vm::vec3 Lasso::project(const vm::vec3& point, const vm::plane3& plane) const {
             const auto ray = vm::ray3(m_camera.pickRay(vm::vec3f(point)));
             const auto hitDistance = vm::intersect_ray_plane(ray, plane);
@@ -25,6 +25,9 @@
 #include <vecmath/plane.h>
 #include <vecmath/bbox.h>
 
+#include <optional>
+#include <utility>
+
 namespace TrenchBroom {
     namespace Renderer {
         class Camera;
@@ -60,6 +63,14 @@ namespace TrenchBroom {
             bool selects(const H& h) const {
                 return selects(h, plane(), box());
             }
+
+            /**
+             * If the camera is an orthographic camera that looks along a coordinate axis, then this lasso selects
+             * exactly those points whose coordinates on the other two axes lie within a rectangle. In that case, this
+             * function returns the index of the axis and bounds whose other two coordinates span the rectangle.
+             * Otherwise, it returns std::nullopt.
+             */
+            std::optional<std::pair<size_t, vm::bbox3>> axisAlignedBounds() const;
         private:
             bool selects(const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const;
             bool selects(const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const;
@@ -27,14 +27,14 @@
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "EL/ELExceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
-#include "Model/AttributeNameWithDoubleQuotationMarksIssueGenerator.h"
-#include "Model/AttributeValueWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/AssortNodesVisitor.h"
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
 #include "Model/BrushGeometry.h"
@@ -49,32 +49,17 @@
 #include "Model/CollectSelectedNodesVisitor.h"
 #include "Model/CollectTouchingNodesVisitor.h"
 #include "Model/ComputeNodeBoundsVisitor.h"
+#include "Model/DefaultIssueGenerators.h"
 #include "Model/EditorContext.h"
-#include "Model/EmptyAttributeNameIssueGenerator.h"
-#include "Model/EmptyAttributeValueIssueGenerator.h"
-#include "Model/EmptyBrushEntityIssueGenerator.h"
-#include "Model/EmptyGroupIssueGenerator.h"
 #include "Model/Entity.h"
-#include "Model/LinkSourceIssueGenerator.h"
-#include "Model/LinkTargetIssueGenerator.h"
 #include "Model/Game.h"
 #include "Model/GameFactory.h"
 #include "Model/Group.h"
-#include "Model/InvalidTextureScaleIssueGenerator.h"
-#include "Model/LongAttributeNameIssueGenerator.h"
-#include "Model/LongAttributeValueIssueGenerator.h"
 #include "Model/MergeNodesIntoWorldVisitor.h"
-#include "Model/MissingClassnameIssueGenerator.h"
-#include "Model/MissingDefinitionIssueGenerator.h"
-#include "Model/MissingModIssueGenerator.h"
-#include "Model/MixedBrushContentsIssueGenerator.h"
 #include "Model/ModelUtils.h"
 #include "Model/Node.h"
+#include "Model/NodeTraversal.h"
 #include "Model/NodeVisitor.h"
-#include "Model/NonIntegerPlanePointsIssueGenerator.h"
-#include "Model/NonIntegerVerticesIssueGenerator.h"
-#include "Model/WorldBoundsIssueGenerator.h"
-#include "Model/PointEntityWithBrushesIssueGenerator.h"
 #include "Model/PointFile.h"
 #include "Model/Polyhedron.h"
 #include "Model/Polyhedron3.h"
@@ -120,6 +105,8 @@
 #include <kdl/collection_utils.h>
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
+#include <kdl/parallel.h>
+#include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/polygon.h>
@@ -127,11 +114,15 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -163,7 +154,10 @@ namespace TrenchBroom {
         m_currentTextureName(Model::BrushFaceAttributes::NoTextureName),
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
+        m_notificationBatchDepth(0),
         m_viewEffectsService(nullptr) {
+                m_textureManager->setCompressTextures(pref(Preferences::CompressTextures));
+                m_textureManager->setMaxTextureSize(static_cast<size_t>(std::max(0, pref(Preferences::MaxTextureSize))));
                 bindObservers();
         }
 
@@ -291,14 +285,44 @@ namespace TrenchBroom {
             clearDocument();
             loadWorld(mapFormat, worldBounds, game, path);
 
-            loadAssets();
             registerIssueGenerators();
             registerSmartTags();
             createTagActions();
 
+            // the document can be edited before the entity models are loaded, which may load models on demand
+            m_entityModelManager->setLoader(m_game.get());
+            m_pendingLoadStages = {
+                { "entity definitions", &MapDocument::loadEntityDefinitionsStage },
+                { "entity models", &MapDocument::loadEntityModelsStage },
+                { "textures", &MapDocument::loadTexturesStage }
+            };
+
             documentWasLoadedNotifier(this);
         }
 
+        bool MapDocument::hasPendingLoadStages() const {
+            return !m_pendingLoadStages.empty();
+        }
+
+        const std::string& MapDocument::nextLoadStage() const {
+            ensure(!m_pendingLoadStages.empty(), "no pending load stage");
+            return m_pendingLoadStages.front().description;
+        }
+
+        void MapDocument::runNextLoadStage() {
+            if (!m_pendingLoadStages.empty()) {
+                const auto stage = m_pendingLoadStages.front();
+                m_pendingLoadStages.pop_front();
+                (this->*stage.run)();
+            }
+        }
+
+        void MapDocument::finishLoading() {
+            while (!m_pendingLoadStages.empty()) {
+                runNextLoadStage();
+            }
+        }
+
         void MapDocument::saveDocument() {
             doSaveDocument(m_path);
         }
@@ -313,6 +337,12 @@ namespace TrenchBroom {
             m_game->writeMap(*m_world, path);
         }
 
+        std::string MapDocument::serializeDocument() {
+            ensure(m_game.get() != nullptr, "game is null");
+            ensure(m_world != nullptr, "world is null");
+            return m_game->serializeMap(*m_world);
+        }
+
         void MapDocument::exportDocumentAs(const Model::ExportFormat format, const IO::Path& path) {
             m_game->exportMap(*m_world, format, path);
         }
@@ -330,6 +360,7 @@ namespace TrenchBroom {
 
                 m_editorContext->reset();
                 clearSelection();
+                m_pendingLoadStages.clear();
                 unloadAssets();
                 clearWorld();
                 clearModificationCount();
@@ -368,6 +399,21 @@ namespace TrenchBroom {
             return PasteType::Failed;
         }
 
+        std::vector<Model::Node*> MapDocument::cloneSelectedNodes() {
+            const std::vector<Model::Node*> clones = Model::Node::cloneRecursively(m_worldBounds, m_selectedNodes.nodes());
+            unsetEntityModels(clones);
+            unsetEntityDefinitions(clones);
+            return clones;
+        }
+
+        PasteType MapDocument::paste(const std::vector<Model::Node*>& nodes) {
+            const std::vector<Model::Node*> clones = Model::Node::cloneRecursively(m_worldBounds, nodes);
+            if (!clones.empty() && pasteNodes(clones)) {
+                return PasteType::Node;
+            }
+            return PasteType::Failed;
+        }
+
         bool MapDocument::pasteNodes(const std::vector<Model::Node*>& nodes) {
             Model::MergeNodesIntoWorldVisitor mergeNodes(m_world.get(), currentParent());
             Model::Node::accept(std::begin(nodes), std::end(nodes), mergeNodes);
@@ -571,11 +617,24 @@ namespace TrenchBroom {
             select(visitor.nodes());
         }
 
+        /**
+         * Returns the nodes in the node tree of the given world whose bounds intersect the bounds of any of the given
+         * brushes. Only these nodes can touch or be contained in the brushes.
+         */
+        static std::vector<Model::Node*> findNodesIntersectingBrushes(Model::World& world, const std::vector<Model::Brush*>& brushes) {
+            std::vector<Model::Node*> result;
+            for (const auto* brush : brushes) {
+                kdl::vec_append(result, world.findNodesIntersecting(brush->logicalBounds()));
+            }
+            kdl::vec_sort_and_remove_duplicates(result);
+            return result;
+        }
+
         void MapDocument::selectTouching(const bool del) {
             const std::vector<Model::Brush*>& brushes = m_selectedNodes.brushes();
 
             Model::CollectTouchingNodesVisitor<std::vector<Model::Brush*>::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
+            Model::acceptCandidatesAndAncestors(m_world.get(), findNodesIntersectingBrushes(*m_world, brushes), visitor);
 
             const std::vector<Model::Node*> nodes = visitor.nodes();
 
@@ -591,7 +650,7 @@ namespace TrenchBroom {
             const std::vector<Model::Brush*>& brushes = m_selectedNodes.brushes();
 
             Model::CollectContainedNodesVisitor<std::vector<Model::Brush*>::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
+            Model::acceptCandidatesAndAncestors(m_world.get(), findNodesIntersectingBrushes(*m_world, brushes), visitor);
 
             const std::vector<Model::Node*> nodes = visitor.nodes();
 
@@ -641,7 +700,11 @@ namespace TrenchBroom {
                 }
                 return face->texture() == texture;
             });
-            m_world->acceptAndRecurse(visitor);
+
+            // an unused texture cannot be found on any face, so there is no need to visit the map
+            if (texture == nullptr || texture->usageCount() > 0u) {
+                m_world->acceptAndRecurse(visitor);
+            }
 
             Transaction transaction(this, "Select Faces with Texture");
             deselectAll();
@@ -673,6 +736,12 @@ namespace TrenchBroom {
             m_selectionBoundsValid = false;
         }
 
+        void MapDocument::mergeSelectionBounds(const std::vector<Model::Node*>& addedNodes) {
+            if (m_selectionBoundsValid && !addedNodes.empty()) {
+                m_selectionBounds = vm::merge(m_selectionBounds, Model::computeLogicalBounds(addedNodes));
+            }
+        }
+
         void MapDocument::validateSelectionBounds() const {
             Model::ComputeNodeBoundsVisitor visitor(Model::BoundsType::Logical);
             Model::Node::accept(std::begin(m_selectedNodes), std::end(m_selectedNodes), visitor);
@@ -1016,20 +1085,20 @@ namespace TrenchBroom {
             Model::CollectTransitivelyUnselectedNodesVisitor collectUnselected;
             Model::Node::recurse(std::begin(layers), std::end(layers), collectUnselected);
 
-            Model::CollectSelectedNodesVisitor collectSelected;
-            Model::Node::recurse(std::begin(layers), std::end(layers), collectSelected);
+            std::vector<Model::Node*> selectedNodes;
+            Model::collectSelectedNodesOfType<Model::Node>(std::begin(layers), std::end(layers), std::back_inserter(selectedNodes));
 
             Transaction transaction(this, "Isolate Objects");
             executeAndStore(SetVisibilityCommand::hide(collectUnselected.nodes()));
-            executeAndStore(SetVisibilityCommand::show(collectSelected.nodes()));
+            executeAndStore(SetVisibilityCommand::show(selectedNodes));
         }
 
         void MapDocument::hide(const std::vector<Model::Node*> nodes) {
-            Model::CollectSelectedNodesVisitor collect;
-            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collect);
+            std::vector<Model::Node*> selectedNodes;
+            Model::collectSelectedNodesOfType<Model::Node>(std::begin(nodes), std::end(nodes), std::back_inserter(selectedNodes));
 
             const Transaction transaction(this, "Hide Objects");
-            deselect(collect.nodes());
+            deselect(selectedNodes);
             executeAndStore(SetVisibilityCommand::hide(nodes));
         }
 
@@ -1057,12 +1126,12 @@ namespace TrenchBroom {
         }
 
         void MapDocument::lock(const std::vector<Model::Node*>& nodes) {
-            Model::CollectSelectedNodesVisitor collect;
-            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collect);
+            std::vector<Model::Node*> selectedNodes;
+            Model::collectSelectedNodesOfType<Model::Node>(std::begin(nodes), std::end(nodes), std::back_inserter(selectedNodes));
 
             const Transaction transaction(this, "Lock Objects");
             executeAndStore(SetLockStateCommand::lock(nodes));
-            deselect(collect.nodes());
+            deselect(selectedNodes);
         }
 
         void MapDocument::unlock(const std::vector<Model::Node*>& nodes) {
@@ -1123,22 +1192,25 @@ namespace TrenchBroom {
                 return false;
             }
 
-            Model::Polyhedron3 polyhedron;
+            std::vector<vm::vec3> points;
 
             if (hasSelectedBrushFaces()) {
                 for (const Model::BrushFace* face : selectedBrushFaces()) {
                     for (const Model::BrushVertex* vertex : face->vertices()) {
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                     }
                 }
             } else if (selectedNodes().hasOnlyBrushes()) {
                 for (const Model::Brush* brush : selectedNodes().brushes()) {
                     for (const Model::BrushVertex* vertex : brush->vertices()) {
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                     }
                 }
             }
 
+            // adding all points at once lets the polyhedron use conflict lists for large selections
+            const Model::Polyhedron3 polyhedron(points);
+
             if (!polyhedron.polyhedron() || !polyhedron.closed()) {
                 return false;
             }
@@ -1187,11 +1259,35 @@ namespace TrenchBroom {
                 toRemove.push_back(subtrahend);
             }
 
-            for (auto* minuend : minuends) {
-                const std::vector<Model::Brush*> result = minuend->subtract(*m_world, m_worldBounds, currentTextureName(), subtrahends);
+            // Every minuend is subtracted independently, so the fragments are computed in parallel. Only the
+            // subtrahends whose bounds intersect a minuend can affect it, so the others are skipped. Creating the
+            // fragments changes the usage counts of their textures, so these changes are recorded and applied
+            // afterwards.
+            const auto& textureName = currentTextureName();
+            auto results = std::vector<std::vector<Model::Brush*>>(minuends.size());
+            auto usageCountChanges = std::vector<Assets::TextureUsageCountChanges>(minuends.size());
+            kdl::parallel_for(minuends.size(), [&](const size_t i) {
+                usageCountChanges[i].record([&]() {
+                    const auto* minuend = minuends[i];
+                    const auto& minuendBounds = minuend->logicalBounds();
+                    auto intersectingSubtrahends = std::vector<Model::Brush*>();
+                    for (auto* subtrahend : subtrahends) {
+                        if (minuendBounds.intersects(subtrahend->logicalBounds())) {
+                            intersectingSubtrahends.push_back(subtrahend);
+                        }
+                    }
+                    results[i] = minuend->subtract(*m_world, m_worldBounds, textureName, intersectingSubtrahends);
+                });
+            });
+
+            for (auto& changes : usageCountChanges) {
+                changes.apply();
+            }
 
-                if (!result.empty()) {
-                    kdl::vec_append(toAdd[minuend->parent()], result);
+            for (size_t i = 0u; i < minuends.size(); ++i) {
+                auto* minuend = minuends[i];
+                if (!results[i].empty()) {
+                    kdl::vec_append(toAdd[minuend->parent()], results[i]);
                 }
                 toRemove.push_back(minuend);
             }
@@ -1248,18 +1344,38 @@ namespace TrenchBroom {
             std::map<Model::Node*, std::vector<Model::Node*>> toAdd;
             std::vector<Model::Node*> toRemove;
 
-            for (Model::Brush* brush : brushes) {
-                // make an shrunken copy of brush
-                Model::Brush* shrunken = brush->clone(m_worldBounds);
-                if (shrunken->expand(m_worldBounds, -1.0 * static_cast<FloatType>(m_grid->actualSize()), true)) {
-                    // shrinking gave us a valid brush, so subtract it from `brush`
-                    const std::vector<Model::Brush*> fragments = brush->subtract(*m_world, m_worldBounds, currentTextureName(), shrunken);
+            // Every brush is hollowed independently, so the fragments are computed in parallel. Creating and
+            // deleting brushes changes the usage counts of their textures, so these changes are recorded and applied
+            // afterwards.
+            const auto& textureName = currentTextureName();
+            const auto shrinkBy = -1.0 * static_cast<FloatType>(m_grid->actualSize());
+            auto results = std::vector<std::optional<std::vector<Model::Brush*>>>(brushes.size());
+            auto usageCountChanges = std::vector<Assets::TextureUsageCountChanges>(brushes.size());
+            kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                usageCountChanges[i].record([&]() {
+                    const auto* brush = brushes[i];
+
+                    // make an shrunken copy of brush
+                    Model::Brush* shrunken = brush->clone(m_worldBounds);
+                    if (shrunken->expand(m_worldBounds, shrinkBy, true)) {
+                        // shrinking gave us a valid brush, so subtract it from `brush`
+                        results[i] = brush->subtract(*m_world, m_worldBounds, textureName, shrunken);
+                    }
 
-                    kdl::vec_append(toAdd[brush->parent()], fragments);
+                    delete shrunken;
+                });
+            });
+
+            for (auto& changes : usageCountChanges) {
+                changes.apply();
+            }
+
+            for (size_t i = 0u; i < brushes.size(); ++i) {
+                if (results[i]) {
+                    Model::Brush* brush = brushes[i];
+                    kdl::vec_append(toAdd[brush->parent()], *results[i]);
                     toRemove.push_back(brush);
                 }
-
-                delete shrunken;
             }
 
             Transaction transaction(this, "CSG Hollow");
@@ -1542,8 +1658,16 @@ namespace TrenchBroom {
             doClearRepeatableCommands();
         }
 
+        size_t MapDocument::undoMemoryUsage() const {
+            return doGetUndoMemoryUsage();
+        }
+
         void MapDocument::startTransaction(const std::string& name) {
             debug("Starting transaction '" + name + "'");
+            if (m_world != nullptr) {
+                m_world->deferNodeTreeUpdates();
+                m_world->deferAttributeIndexUpdates();
+            }
             doStartTransaction(name);
         }
 
@@ -1555,12 +1679,153 @@ namespace TrenchBroom {
         void MapDocument::commitTransaction() {
             debug("Committing transaction");
             doCommitTransaction();
+            if (m_world != nullptr) {
+                m_world->resumeAttributeIndexUpdates();
+                m_world->resumeNodeTreeUpdates();
+            }
         }
 
         void MapDocument::cancelTransaction() {
             debug("Cancelling transaction");
             doRollbackTransaction();
             doCommitTransaction();
+            if (m_world != nullptr) {
+                m_world->resumeAttributeIndexUpdates();
+                m_world->resumeNodeTreeUpdates();
+            }
+        }
+
+        void MapDocument::beginNotificationBatch() {
+            ++m_notificationBatchDepth;
+        }
+
+        void MapDocument::endNotificationBatch() {
+            assert(m_notificationBatchDepth > 0);
+            if (--m_notificationBatchDepth == 0) {
+                flushNotificationBatch();
+            }
+        }
+
+        MapDocument::NotifyNodesChange::NotifyNodesChange(MapDocument& document, const std::vector<Model::Node*>& nodes) :
+        m_document(document),
+        m_nodes(nodes) {
+            m_document.nodesWillChange(m_nodes);
+        }
+
+        MapDocument::NotifyNodesChange::~NotifyNodesChange() {
+            m_document.nodesDidChange(m_nodes);
+        }
+
+        void MapDocument::nodesWillChange(const std::vector<Model::Node*>& nodes) {
+            if (m_notificationBatchDepth == 0) {
+                nodesWillChangeNotifier(nodes);
+            } else {
+                std::vector<Model::Node*> changingNodes;
+                for (auto* node : nodes) {
+                    if (m_changingNodes.insert(node).second) {
+                        changingNodes.push_back(node);
+                    }
+                }
+
+                if (!changingNodes.empty()) {
+                    nodesWillChangeNotifier(changingNodes);
+                }
+            }
+        }
+
+        void MapDocument::nodesDidChange(const std::vector<Model::Node*>& nodes) {
+            if (m_notificationBatchDepth == 0) {
+                nodesDidChangeNotifier(nodes);
+            } else {
+                kdl::vec_append(m_pendingChangedNodes, nodes);
+            }
+        }
+
+        void MapDocument::brushFacesDidChange(const std::vector<Model::BrushFace*>& faces) {
+            if (m_notificationBatchDepth == 0) {
+                brushFacesDidChangeNotifier(faces);
+            } else {
+                for (auto* face : faces) {
+                    m_pendingChangedBrushFaces.emplace_back(face->brush(), face);
+                }
+            }
+        }
+
+        void MapDocument::flushNotificationBatch() {
+            // observers might start another batch, so the pending changes are moved out first
+            auto pendingNodes = std::move(m_pendingChangedNodes);
+            auto pendingFaces = std::move(m_pendingChangedBrushFaces);
+            m_pendingChangedNodes.clear();
+            m_pendingChangedBrushFaces.clear();
+            m_changingNodes.clear();
+
+            if (!pendingNodes.empty()) {
+                std::vector<Model::Node*> nodes;
+                nodes.reserve(pendingNodes.size());
+
+                std::unordered_set<Model::Node*> visited;
+                for (auto* node : pendingNodes) {
+                    if (visited.insert(node).second) {
+                        nodes.push_back(node);
+                    }
+                }
+
+                nodesDidChangeNotifier(nodes);
+            }
+
+            if (!pendingFaces.empty()) {
+                std::vector<Model::BrushFace*> faces;
+                faces.reserve(pendingFaces.size());
+
+                // A brush may have replaced its faces since the face was recorded, so a face is only passed on if it
+                // still belongs to its brush. This check must not dereference the face.
+                std::unordered_set<Model::BrushFace*> visited;
+                for (const auto& [brush, face] : pendingFaces) {
+                    if (visited.insert(face).second && kdl::vec_contains(brush->faces(), face)) {
+                        faces.push_back(face);
+                    }
+                }
+
+                if (!faces.empty()) {
+                    brushFacesDidChangeNotifier(faces);
+                }
+            }
+        }
+
+        void MapDocument::flushPendingChanges(const std::vector<Model::Node*>& nodes) {
+            if (m_pendingChangedNodes.empty() && m_pendingChangedBrushFaces.empty()) {
+                return;
+            }
+
+            // the removed nodes are still attached to their parents, so a removed descendant is found by walking up
+            const std::unordered_set<const Model::Node*> removedNodes(std::begin(nodes), std::end(nodes));
+            const auto isRemoved = [&](const Model::Node* node) {
+                while (node != nullptr) {
+                    if (removedNodes.count(node) > 0) {
+                        return true;
+                    }
+                    node = node->parent();
+                }
+                return false;
+            };
+
+            // the observers were told that these nodes will change, so they must be told that they did change before
+            // the nodes are removed
+            std::vector<Model::Node*> removedChangedNodes;
+            std::unordered_set<Model::Node*> visited;
+            for (auto* node : m_pendingChangedNodes) {
+                if (isRemoved(node) && visited.insert(node).second) {
+                    removedChangedNodes.push_back(node);
+                    m_changingNodes.erase(node);
+                }
+            }
+
+            kdl::vec_erase_if(m_pendingChangedNodes, isRemoved);
+            kdl::vec_erase_if(m_pendingChangedBrushFaces, [&](const auto& entry) { return isRemoved(entry.first); });
+
+            if (!removedChangedNodes.empty()) {
+                nodesDidChangeNotifier(removedChangedNodes);
+            }
         }
 
         std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command) {
@@ -1580,6 +1845,11 @@ namespace TrenchBroom {
                 m_world->pick(pickRay, pickResult);
         }
 
+        void MapDocument::pickClosest(const vm::ray3& pickRay, const Model::HitFilter& filter, Model::PickResult& pickResult) const {
+            if (m_world != nullptr)
+                m_world->pickClosest(pickRay, filter, pickResult);
+        }
+
         std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const {
             std::vector<Model::Node*> result;
             if (m_world != nullptr) {
@@ -1601,7 +1871,7 @@ namespace TrenchBroom {
         void MapDocument::loadWorld(const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game, const IO::Path& path) {
             m_worldBounds = worldBounds;
             m_game = game;
-            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, logger());
+            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, pref(Preferences::UseMapCache), logger());
             setCurrentLayer(m_world->defaultLayer());
 
             updateGameSearchPaths();
@@ -1646,6 +1916,8 @@ namespace TrenchBroom {
         }
 
         void MapDocument::reloadTextureCollections() {
+            finishLoading();
+
             const std::vector<Model::Node*> nodes(1, m_world.get());
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
             Notifier<>::NotifyBeforeAndAfter notifyTextureCollections(textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
@@ -1661,6 +1933,68 @@ namespace TrenchBroom {
             setEntityDefinitionFile(oldSpec);
         }
 
+        std::vector<IO::Path> MapDocument::assetSourcePaths() const {
+            auto result = std::vector<IO::Path>();
+            for (const auto* collection : m_textureManager->collections()) {
+                kdl::vec_append(result, collection->sourcePaths());
+            }
+
+            const auto definitionFilePath = entityDefinitionFilePath();
+            if (!definitionFilePath.isEmpty()) {
+                result.push_back(definitionFilePath);
+            }
+
+            kdl::vec_sort_and_remove_duplicates(result);
+            return result;
+        }
+
+        void MapDocument::reloadChangedAssets(const std::vector<IO::Path>& changedPaths) {
+            if (m_world == nullptr) {
+                return;
+            }
+
+            finishLoading();
+            const auto collections = m_textureManager->collectionsLoadedFrom(changedPaths);
+            if (!collections.empty()) {
+                reloadTextureCollections(collections);
+            }
+
+            const auto definitionFilePath = entityDefinitionFilePath();
+            if (!definitionFilePath.isEmpty() && kdl::vec_contains(changedPaths, definitionFilePath)) {
+                info("Reloading entity definitions");
+                reloadEntityDefinitions();
+            }
+        }
+
+        void MapDocument::reloadTextureCollections(const std::vector<Assets::TextureCollection*>& collections) {
+            const std::vector<Model::Node*> nodes(1, m_world.get());
+            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            Notifier<>::NotifyBeforeAndAfter notifyTextureCollections(textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
+
+            for (const auto* collection : collections) {
+                info("Reloading texture collection " + collection->path().asString());
+            }
+
+            // the other collections are kept, only the unloaded ones are loaded again
+            unsetTextures();
+            m_textureManager->unloadTextureCollections(collections);
+            loadTextures();
+            setTextures();
+            initializeNodeTags(this);
+        }
+
+        IO::Path MapDocument::entityDefinitionFilePath() const {
+            if (m_world == nullptr) {
+                return IO::Path();
+            }
+
+            try {
+                return m_game->findEntityDefinitionFile(entityDefinitionFile(), externalSearchPaths());
+            } catch (const Exception&) {
+                return IO::Path();
+            }
+        }
+
         void MapDocument::loadAssets() {
             loadEntityDefinitions();
             setEntityDefinitions();
@@ -1669,6 +2003,32 @@ namespace TrenchBroom {
             setTextures();
         }
 
+        void MapDocument::loadEntityDefinitionsStage() {
+            const std::vector<Model::Node*> nodes(1, m_world.get());
+            NotifyNodesChange notifyNodes(*this, nodes);
+            Notifier<>::NotifyAfter notifyEntityDefinitions(entityDefinitionsDidChangeNotifier);
+
+            loadEntityDefinitions();
+            setEntityDefinitions();
+        }
+
+        void MapDocument::loadEntityModelsStage() {
+            const std::vector<Model::Node*> nodes(1, m_world.get());
+            NotifyNodesChange notifyNodes(*this, nodes);
+
+            loadEntityModels();
+        }
+
+        void MapDocument::loadTexturesStage() {
+            const std::vector<Model::Node*> nodes(1, m_world.get());
+            NotifyNodesChange notifyNodes(*this, nodes);
+            Notifier<>::NotifyBeforeAndAfter notifyTextureCollections(textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
+
+            loadTextures();
+            setTextures();
+            initializeNodeTags(this);
+        }
+
         void MapDocument::unloadAssets() {
             unloadEntityDefinitions();
             unloadEntityModels();
@@ -1718,7 +2078,7 @@ namespace TrenchBroom {
         void MapDocument::loadTextures() {
             try {
                 const IO::Path docDir = m_path.isEmpty() ? IO::Path() : m_path.deleteLastComponent();
-                m_game->loadTextureCollections(*m_world, docDir, *m_textureManager, logger());
+                m_game->loadTextureCollections(*m_world, docDir, *m_textureManager, pref(Preferences::UseTextureCache), logger());
             } catch (const Exception& e) {
                 error(e.what());
             }
@@ -1732,9 +2092,14 @@ namespace TrenchBroom {
         class MapDocument::SetTextures : public Model::NodeVisitor {
         private:
             Assets::TextureManager& m_manager;
+
+            // most faces of a brush and many neighbouring brushes share a texture, so the last lookup is remembered
+            std::string m_lastTextureName;
+            Assets::Texture* m_lastTexture;
         public:
             explicit SetTextures(Assets::TextureManager& manager) :
-                m_manager(manager) {}
+                m_manager(manager),
+                m_lastTexture(nullptr) {}
         private:
             void doVisit(Model::World*) override   {}
             void doVisit(Model::Layer*) override   {}
@@ -1742,7 +2107,11 @@ namespace TrenchBroom {
             void doVisit(Model::Entity*) override {}
             void doVisit(Model::Brush* brush) override   {
                 for (Model::BrushFace* face : brush->faces()) {
-                    face->updateTexture(m_manager);
+                    if (m_lastTexture == nullptr || face->textureName() != m_lastTextureName) {
+                        m_lastTextureName = face->textureName();
+                        m_lastTexture = m_manager.texture(m_lastTextureName);
+                    }
+                    face->setTexture(m_lastTexture);
                 }
             }
         };
@@ -1850,10 +2219,22 @@ namespace TrenchBroom {
         private:
             Logger& m_logger;
             Assets::EntityModelManager& m_manager;
+            std::vector<Model::Entity*> m_entities;
+            std::vector<Assets::ModelSpecification> m_modelSpecs;
         public:
             explicit SetEntityModels(Logger& logger, Assets::EntityModelManager& manager) :
             m_logger(logger),
             m_manager(manager) {}
+
+            /**
+             * Loads the models of all visited entities at once and sets their model frames.
+             */
+            void setModelFrames() {
+                m_manager.loadModels(m_modelSpecs);
+                for (size_t i = 0u; i < m_entities.size(); ++i) {
+                    m_entities[i]->setModelFrame(m_manager.frame(m_modelSpecs[i]));
+                }
+            }
         private:
             void doVisit(Model::World*) override         {}
             void doVisit(Model::Layer*) override         {}
@@ -1862,8 +2243,8 @@ namespace TrenchBroom {
                 const auto modelSpec = Assets::safeGetModelSpecification(m_logger, entity->classname(), [&]() {
                     return entity->modelSpecification();
                 });
-                const auto* frame = m_manager.frame(modelSpec);
-                entity->setModelFrame(frame);
+                m_entities.push_back(entity);
+                m_modelSpecs.push_back(modelSpec);
             }
             void doVisit(Model::Brush*) override         {}
         };
@@ -1878,13 +2259,18 @@ namespace TrenchBroom {
         };
 
         void MapDocument::setEntityModels() {
+            // share the models with other documents that load them from the same files
+            m_entityModelManager->setCacheKey(m_game->gameName() + "\n" + m_game->gamePath().asString() + "\n" + kdl::str_join(mods(), ";"));
+
             SetEntityModels visitor(*this, *m_entityModelManager);
             m_world->acceptAndRecurse(visitor);
+            visitor.setModelFrames();
         }
 
         void MapDocument::setEntityModels(const std::vector<Model::Node*>& nodes) {
             SetEntityModels visitor(*this, *m_entityModelManager);
             Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            visitor.setModelFrames();
         }
 
         void MapDocument::unsetEntityModels() {
@@ -1937,25 +2323,7 @@ namespace TrenchBroom {
             ensure(m_world != nullptr, "world is null");
             ensure(m_game.get() != nullptr, "game is null");
 
-            m_world->registerIssueGenerator(new Model::MissingClassnameIssueGenerator());
-            m_world->registerIssueGenerator(new Model::MissingDefinitionIssueGenerator());
-            m_world->registerIssueGenerator(new Model::MissingModIssueGenerator(m_game));
-            m_world->registerIssueGenerator(new Model::EmptyGroupIssueGenerator());
-            m_world->registerIssueGenerator(new Model::EmptyBrushEntityIssueGenerator());
-            m_world->registerIssueGenerator(new Model::PointEntityWithBrushesIssueGenerator());
-            m_world->registerIssueGenerator(new Model::LinkSourceIssueGenerator());
-            m_world->registerIssueGenerator(new Model::LinkTargetIssueGenerator());
-            m_world->registerIssueGenerator(new Model::NonIntegerPlanePointsIssueGenerator());
-            m_world->registerIssueGenerator(new Model::NonIntegerVerticesIssueGenerator());
-            m_world->registerIssueGenerator(new Model::MixedBrushContentsIssueGenerator());
-            m_world->registerIssueGenerator(new Model::WorldBoundsIssueGenerator(m_worldBounds));
-            m_world->registerIssueGenerator(new Model::EmptyAttributeNameIssueGenerator());
-            m_world->registerIssueGenerator(new Model::EmptyAttributeValueIssueGenerator());
-            m_world->registerIssueGenerator(new Model::LongAttributeNameIssueGenerator(m_game->maxPropertyLength()));
-            m_world->registerIssueGenerator(new Model::LongAttributeValueIssueGenerator(m_game->maxPropertyLength()));
-            m_world->registerIssueGenerator(new Model::AttributeNameWithDoubleQuotationMarksIssueGenerator());
-            m_world->registerIssueGenerator(new Model::AttributeValueWithDoubleQuotationMarksIssueGenerator());
-            m_world->registerIssueGenerator(new Model::InvalidTextureScaleIssueGenerator());
+            Model::registerDefaultIssueGenerators(*m_world, m_game, m_worldBounds);
         }
 
         void MapDocument::registerSmartTags() {
@@ -2044,24 +2412,16 @@ namespace TrenchBroom {
             }
         }
 
-
-        class MapDocument::InitializeFaceTagsVisitor : public Model::NodeVisitor {
-        private:
-            Model::TagManager& m_tagManager;
-        public:
-            explicit InitializeFaceTagsVisitor(Model::TagManager& tagManager) :
-                m_tagManager(tagManager) {}
-        private:
-            void doVisit(Model::World*) override         {}
-            void doVisit(Model::Layer*) override         {}
-            void doVisit(Model::Group*) override         {}
-            void doVisit(Model::Entity*) override        {}
-            void doVisit(Model::Brush* brush)   override { brush->initializeTags(m_tagManager); }
-        };
-
         void MapDocument::updateAllFaceTags() {
-            InitializeFaceTagsVisitor visitor(*m_tagManager);
+            // every brush and its faces are tagged independently, and the tag matchers only read the taggable they
+            // are given (or cache their results in a thread safe way), so the brushes can be tagged in parallel
+            Model::CollectBrushesVisitor visitor;
             m_world->acceptAndRecurse(visitor);
+
+            const auto& brushes = visitor.brushes();
+            kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                brushes[i]->initializeTags(*m_tagManager);
+            });
         }
 
         bool MapDocument::persistent() const {
@@ -2154,6 +2514,10 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::CompressTextures.path()) {
+                m_textureManager->setCompressTextures(pref(Preferences::CompressTextures));
+            } else if (path == Preferences::MaxTextureSize.path()) {
+                m_textureManager->setMaxTextureSize(static_cast<size_t>(std::max(0, pref(Preferences::MaxTextureSize))));
             }
         }
 
@@ -2186,6 +2550,7 @@ namespace TrenchBroom {
         Transaction::~Transaction() {
             if (!m_cancelled)
                 commit();
+            m_document->endNotificationBatch();
         }
 
         void Transaction::rollback() {
@@ -2198,6 +2563,7 @@ namespace TrenchBroom {
         }
 
         void Transaction::begin(const std::string& name) {
+            m_document->beginNotificationBatch();
             m_document->startTransaction(name);
         }
 
@@ -31,9 +31,12 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -45,6 +48,7 @@ namespace TrenchBroom {
         class EntityDefinitionManager;
         class EntityModelManager;
         class Texture;
+        class TextureCollection;
         class TextureManager;
     }
 
@@ -53,6 +57,7 @@ namespace TrenchBroom {
         class EditorContext;
         enum class ExportFormat;
         class Game;
+        class HitFilter;
         class Issue;
         enum class MapFormat;
         class PickResult;
@@ -117,6 +122,18 @@ namespace TrenchBroom {
             mutable vm::bbox3 m_selectionBounds;
             mutable bool m_selectionBoundsValid;
 
+            size_t m_notificationBatchDepth;
+            std::vector<Model::Node*> m_pendingChangedNodes;
+            // the nodes for which nodesWillChangeNotifier was notified in the open notification batch
+            std::unordered_set<Model::Node*> m_changingNodes;
+            std::vector<std::pair<Model::Brush*, Model::BrushFace*>> m_pendingChangedBrushFaces;
+
+            struct LoadStage {
+                std::string description;
+                void (MapDocument::*run)();
+            };
+            std::deque<LoadStage> m_pendingLoadStages;
+
             ViewEffectsService* m_viewEffectsService;
         public: // notification
             Notifier<Command*> commandDoNotifier;
@@ -222,10 +239,27 @@ namespace TrenchBroom {
             void createEntityDefinitionActions();
         public: // new, load, save document
             void newDocument(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game);
+            /**
+             * Loads the map at the given path. Only the world is built before this function returns, and the document
+             * is fully usable at that point. Entity definitions, entity models and textures are loaded by the pending
+             * load stages, which the caller should run one after another via runNextLoadStage().
+             */
             void loadDocument(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game, const IO::Path& path);
+
+            bool hasPendingLoadStages() const;
+            /**
+             * Returns a description of the next pending load stage, such as "textures".
+             */
+            const std::string& nextLoadStage() const;
+            void runNextLoadStage();
+            void finishLoading();
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
+            /**
+             * Returns the contents of the map file that saveDocumentTo would write.
+             */
+            std::string serializeDocument();
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
         private:
             void doSaveDocument(const IO::Path& path);
@@ -235,6 +269,19 @@ namespace TrenchBroom {
             std::string serializeSelectedBrushFaces();
 
             PasteType paste(const std::string& str);
+
+            /**
+             * Returns clones of the selected nodes that do not refer to any of this document's assets. The caller takes
+             * ownership of the returned nodes, which remain valid after this document has been closed.
+             */
+            std::vector<Model::Node*> cloneSelectedNodes();
+
+            /**
+             * Pastes clones of the given nodes, which must have been obtained by calling cloneSelectedNodes on a
+             * document with the same map format. Unlike pasting text, this does not parse the nodes or rebuild their
+             * brush geometry.
+             */
+            PasteType paste(const std::vector<Model::Node*>& nodes);
         private:
             bool pasteNodes(const std::vector<Model::Node*>& nodes);
             bool pasteBrushFaces(const std::vector<Model::BrushFace*>& faces);
@@ -288,6 +335,12 @@ namespace TrenchBroom {
         protected:
             void updateLastSelectionBounds();
             void invalidateSelectionBounds();
+            /**
+             * Updates the selection bounds after the given nodes were added to a selection that was not empty before.
+             * If the selection bounds are valid, the bounds of the added nodes are merged into them, otherwise they are
+             * recomputed lazily.
+             */
+            void mergeSelectionBounds(const std::vector<Model::Node*>& addedNodes);
         private:
             void validateSelectionBounds() const;
             void clearSelection();
@@ -405,11 +458,58 @@ namespace TrenchBroom {
             bool canRepeatCommands() const;
             std::unique_ptr<CommandResult> repeatCommands();
             void clearRepeatableCommands();
+
+            /**
+             * Returns an estimate of the number of bytes used by the snapshots of the commands on the undo stack.
+             */
+            size_t undoMemoryUsage() const;
         public: // transactions
             void startTransaction(const std::string& name = "");
             void rollbackTransaction();
             void commitTransaction();
             void cancelTransaction();
+        public: // notification batching
+            /**
+             * Starts a notification batch. While a batch is open, the notifications of nodesDidChangeNotifier and
+             * brushFacesDidChangeNotifier are collected instead of being sent. When the outermost batch ends, the
+             * collected nodes and faces are deduplicated and each notifier is notified once.
+             *
+             * nodesWillChangeNotifier is notified for a node only when the node changes for the first time in a
+             * batch, so that observers still receive exactly one will change and one did change notification per
+             * node.
+             *
+             * Before nodes are removed from the document while a batch is open, the collected did change
+             * notifications for them are sent, and their collected faces are dropped from the batch.
+             */
+            void beginNotificationBatch();
+            void endNotificationBatch();
+        protected:
+            /**
+             * RAII style helper that notifies nodesWillChangeNotifier (unless the nodes have already changed in the
+             * open notification batch) immediately and nodesDidChangeNotifier (or the open notification batch) when
+             * it is destroyed.
+             */
+            class NotifyNodesChange {
+            private:
+                MapDocument& m_document;
+                const std::vector<Model::Node*>& m_nodes;
+            public:
+                NotifyNodesChange(MapDocument& document, const std::vector<Model::Node*>& nodes);
+                ~NotifyNodesChange();
+            };
+
+            void nodesWillChange(const std::vector<Model::Node*>& nodes);
+            void nodesDidChange(const std::vector<Model::Node*>& nodes);
+            void brushFacesDidChange(const std::vector<Model::BrushFace*>& faces);
+
+            /**
+             * Sends the collected did change notifications for the given nodes and their descendants, which are
+             * about to be removed from the document, and drops their collected faces from the open notification
+             * batch.
+             */
+            void flushPendingChanges(const std::vector<Model::Node*>& nodes);
+        private:
+            void flushNotificationBatch();
         private:
             std::unique_ptr<CommandResult> execute(std::unique_ptr<Command>&& command);
             std::unique_ptr<CommandResult> executeAndStore(std::unique_ptr<UndoableCommand>&& command);
@@ -423,6 +523,7 @@ namespace TrenchBroom {
             virtual bool doCanRepeatCommands() const = 0;
             virtual std::unique_ptr<CommandResult> doRepeatCommands() = 0;
             virtual void doClearRepeatableCommands() = 0;
+            virtual size_t doGetUndoMemoryUsage() const = 0;
 
             virtual void doStartTransaction(const std::string& name) = 0;
             virtual void doCommitTransaction() = 0;
@@ -434,6 +535,7 @@ namespace TrenchBroom {
             void commitPendingAssets();
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
+            void pickClosest(const vm::ray3& pickRay, const Model::HitFilter& filter, Model::PickResult& pickResult) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
         private: // world management
             void createWorld(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game);
@@ -453,10 +555,31 @@ namespace TrenchBroom {
             void reloadTextureCollections();
 
             void reloadEntityDefinitions();
+
+            /**
+             * Returns the absolute paths of the files and directories on disk from which the texture collections and
+             * the entity definitions of this document were loaded.
+             */
+            std::vector<IO::Path> assetSourcePaths() const;
+
+            /**
+             * Reloads only the texture collections and entity definitions that were loaded from any of the given files
+             * or directories on disk.
+             *
+             * @see assetSourcePaths()
+             */
+            void reloadChangedAssets(const std::vector<IO::Path>& changedPaths);
         private:
+            void reloadTextureCollections(const std::vector<Assets::TextureCollection*>& collections);
+            IO::Path entityDefinitionFilePath() const;
+
             void loadAssets();
             void unloadAssets();
 
+            void loadEntityDefinitionsStage();
+            void loadEntityModelsStage();
+            void loadTexturesStage();
+
             void loadEntityDefinitions();
             void unloadEntityDefinitions();
 
@@ -519,7 +642,6 @@ namespace TrenchBroom {
             void clearNodeTags(const std::vector<Model::Node*>& nodes);
             void updateNodeTags(const std::vector<Model::Node*>& nodes);
 
-            class InitializeFaceTagsVisitor;
             void updateFaceTags(const std::vector<Model::BrushFace*>& faces);
             void updateAllFaceTags();
         public: // document path
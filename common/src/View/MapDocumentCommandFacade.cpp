@@ -37,6 +37,7 @@
 #include "Model/Group.h"
 #include "Model/Issue.h"
 #include "Model/ModelUtils.h"
+#include "Model/Polyhedron.h"
 #include "Model/Snapshot.h"
 #include "Model/TransformObjectVisitor.h"
 #include "Model/World.h"
@@ -46,6 +47,7 @@
 #include "View/Selection.h"
 
 #include <kdl/map_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
@@ -53,9 +55,11 @@
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -67,15 +71,20 @@ namespace TrenchBroom {
 
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
         m_commandProcessor(std::make_unique<CommandProcessor>(this)) {
+            updateUndoMemoryLimit();
             bindObservers();
         }
 
-        MapDocumentCommandFacade::~MapDocumentCommandFacade() = default;
+        MapDocumentCommandFacade::~MapDocumentCommandFacade() {
+            unbindObservers();
+        }
 
         void MapDocumentCommandFacade::performSelect(const std::vector<Model::Node*>& nodes) {
             selectionWillChangeNotifier();
             updateLastSelectionBounds();
 
+            const bool hadSelectedNodes = hasSelectedNodes();
+
             std::vector<Model::Node*> selected;
             selected.reserve(nodes.size());
 
@@ -106,8 +115,14 @@ namespace TrenchBroom {
             selection.addPartiallySelectedNodes(partiallySelected);
             selection.addRecursivelySelectedNodes(recursivelySelected);
 
+            // growing the selection only requires the bounds of the newly selected nodes
+            if (hadSelectedNodes) {
+                mergeSelectionBounds(selected);
+            } else {
+                invalidateSelectionBounds();
+            }
+
             selectionDidChangeNotifier(selection);
-            invalidateSelectionBounds();
         }
 
         void MapDocumentCommandFacade::performSelect(const std::vector<Model::BrushFace*>& faces) {
@@ -278,7 +293,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performAddNodes(const std::map<Model::Node*, std::vector<Model::Node*>>& nodes) {
             const std::vector<Model::Node*> parents = collectParents(nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+            NotifyNodesChange notifyParents(*this, parents);
 
             std::vector<Model::Node*> addedNodes;
             for (const auto& entry : nodes) {
@@ -298,9 +313,10 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performRemoveNodes(const std::map<Model::Node*, std::vector<Model::Node*>>& nodes) {
             const std::vector<Model::Node*> parents = collectParents(nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+            NotifyNodesChange notifyParents(*this, parents);
 
             const std::vector<Model::Node*> allChildren = collectChildren(nodes);
+            flushPendingChanges(allChildren);
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyChildren(nodesWillBeRemovedNotifier, nodesWereRemovedNotifier, allChildren);
 
             for (const auto& entry : nodes) {
@@ -436,8 +452,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             RenameGroupsVisitor visitor(newName);
             Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
@@ -448,8 +464,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             UndoRenameGroupsVisitor visitor(newNames);
             Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
@@ -498,15 +514,19 @@ namespace TrenchBroom {
           const std::vector<Model::Node*> &nodes = m_selectedNodes.nodes();
           const std::vector<Model::Node*> parents = collectParents(nodes);
 
-          Notifier<const std::vector<Model::Node*> &>::NotifyBeforeAndAfter
-              notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier,
-                            parents);
-          Notifier<const std::vector<Model::Node*> &>::NotifyBeforeAndAfter notifyNodes(
-              nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+          NotifyNodesChange notifyParents(*this, parents);
+          NotifyNodesChange notifyNodes(*this, nodes);
+
+          // the selected brushes are independent of each other and can be transformed in parallel, while groups and
+          // entities are transformed one by one
+          Model::Brush::transformBrushes(m_selectedNodes.brushes(), transform, lockTextures, m_worldBounds);
 
           Model::TransformObjectVisitor visitor(transform, lockTextures,
                                                 m_worldBounds);
-          Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
+          const auto& groups = m_selectedNodes.groups();
+          const auto& entities = m_selectedNodes.entities();
+          Model::Node::accept(std::begin(groups), std::end(groups), visitor);
+          Model::Node::accept(std::begin(entities), std::end(entities), visitor);
 
           invalidateSelectionBounds();
           return true;
@@ -518,9 +538,9 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(std::begin(nodes), std::end(nodes));
             const std::vector<Model::Node*> descendants = collectDescendants(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyDescendants(nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+            NotifyNodesChange notifyDescendants(*this, descendants);
 
             MapDocumentCommandFacade::EntityAttributeSnapshotMap snapshot;
 
@@ -541,9 +561,9 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(std::begin(nodes), std::end(nodes));
             const std::vector<Model::Node*> descendants = collectDescendants(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyDescendants(nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+            NotifyNodesChange notifyDescendants(*this, descendants);
 
             MapDocumentCommandFacade::EntityAttributeSnapshotMap snapshot;
 
@@ -564,9 +584,9 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(nodes.begin(), nodes.end());
             const std::vector<Model::Node*> descendants = collectDescendants(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyDescendants(nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+            NotifyNodesChange notifyDescendants(*this, descendants);
 
             MapDocumentCommandFacade::EntityAttributeSnapshotMap snapshot;
 
@@ -598,18 +618,25 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(std::begin(nodes), std::end(nodes));
             const std::vector<Model::Node*> descendants = collectDescendants(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyDescendants(nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+            NotifyNodesChange notifyDescendants(*this, descendants);
 
             static const std::string DefaultValue = "";
             MapDocumentCommandFacade::EntityAttributeSnapshotMap snapshot;
 
+            // many entities share the same color value, which only needs to be converted once
+            std::unordered_map<std::string, std::string> convertedValues;
             for (Model::AttributableNode* node : attributableNodes) {
                 const std::string& oldValue = node->attribute(name, DefaultValue);
                 if (oldValue != DefaultValue) {
                     snapshot[node].push_back(node->attributeSnapshot(name));
-                    node->addOrUpdateAttribute(name, Model::convertEntityColor(oldValue, colorRange));
+
+                    auto it = convertedValues.find(oldValue);
+                    if (it == std::end(convertedValues)) {
+                        it = convertedValues.emplace(oldValue, Model::convertEntityColor(oldValue, colorRange)).first;
+                    }
+                    node->addOrUpdateAttribute(name, it->second);
                 }
             }
 
@@ -622,9 +649,9 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(std::begin(nodes), std::end(nodes));
             const std::vector<Model::Node*> descendants = collectDescendants(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyDescendants(nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+            NotifyNodesChange notifyDescendants(*this, descendants);
 
             MapDocumentCommandFacade::EntityAttributeSnapshotMap snapshot;
             for (Model::AttributableNode* node : attributableNodes) {
@@ -645,9 +672,9 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(std::begin(nodes), std::end(nodes));
             const std::vector<Model::Node*> descendants = collectDescendants(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyDescendants(nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+            NotifyNodesChange notifyDescendants(*this, descendants);
 
             for (const auto& entry : attributes) {
                 auto* node = entry.first;
@@ -682,8 +709,8 @@ namespace TrenchBroom {
             }
 
             const auto parents = collectParents(std::begin(changedNodes), std::end(changedNodes));
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, changedNodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, changedNodes);
 
             for (auto* face : faces) {
                 auto* brush = face->brush();
@@ -697,39 +724,55 @@ namespace TrenchBroom {
             return result;
         }
 
+        namespace {
+            /**
+             * Applies the given function to the given faces in parallel. Changing a face also changes its brush, so
+             * the faces of each brush are processed together.
+             */
+            template <typename F>
+            void forEachFaceInParallel(const std::vector<Model::BrushFace*>& faces, const F& fun) {
+                const auto groups = Model::groupFacesByBrush(faces);
+                kdl::parallel_for(groups.size(), [&](const size_t i) {
+                    for (auto* face : groups[i]) {
+                        fun(face);
+                    }
+                });
+            }
+        }
+
         void MapDocumentCommandFacade::performMoveTextures(const vm::vec3f& cameraUp, const vm::vec3f& cameraRight, const vm::vec2f& delta) {
-            for (auto* face : m_selectedBrushFaces) {
+            forEachFaceInParallel(m_selectedBrushFaces, [&](Model::BrushFace* face) {
                 face->moveTexture(vm::vec3(cameraUp), vm::vec3(cameraRight), delta);
-            }
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            });
+            brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performRotateTextures(const float angle) {
-            for (auto* face : m_selectedBrushFaces) {
+            forEachFaceInParallel(m_selectedBrushFaces, [&](Model::BrushFace* face) {
                 face->rotateTexture(angle);
-            }
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            });
+            brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performShearTextures(const vm::vec2f& factors) {
-            for (auto* face : m_selectedBrushFaces) {
+            forEachFaceInParallel(m_selectedBrushFaces, [&](Model::BrushFace* face) {
                 face->shearTexture(factors);
-            }
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            });
+            brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performCopyTexCoordSystemFromFace(const Model::TexCoordSystemSnapshot& coordSystemSnapshot, const Model::BrushFaceAttributes& attribs, const vm::plane3& sourceFacePlane, const Model::WrapStyle wrapStyle) {
             for (auto* face : m_selectedBrushFaces) {
                 face->copyTexCoordSystemFromFace(coordSystemSnapshot, attribs, sourceFacePlane, wrapStyle);
             }
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performChangeBrushFaceAttributes(const Model::ChangeBrushFaceAttributesRequest& request) {
             const auto& faces = allSelectedBrushFaces();
             if (request.evaluate(faces)) {
                 setTextures(faces);
-                brushFacesDidChangeNotifier(faces);
+                brushFacesDidChange(faces);
             }
         }
 
@@ -739,11 +782,17 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> nodes(std::begin(brushes), std::end(brushes));
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+
+            // Searching the plane points is expensive and only reads the brushes, so it is done for all brushes in
+            // parallel. Changing the brushes notifies their parents and must be done on this thread.
+            const auto planePoints = kdl::vec_parallel_transform(brushes, [](const Model::Brush* brush) {
+                return brush->computeIntegerPlanePoints();
+            });
 
-            for (Model::Brush* brush : brushes) {
-                brush->findIntegerPlanePoints(m_worldBounds);
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                brushes[i]->setIntegerPlanePoints(m_worldBounds, planePoints[i]);
             }
 
             return true;
@@ -755,15 +804,23 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> nodes(std::begin(brushes), std::end(brushes));
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             size_t succeededBrushCount = 0;
             size_t failedBrushCount = 0;
 
-            for (Model::Brush* brush : brushes) {
-                if (brush->canSnapVertices(m_worldBounds, snapTo)) {
-                    brush->snapVertices(m_worldBounds, snapTo, pref(Preferences::UVLock));
+            // Building the snapped geometry of a brush is expensive, so it is done for all brushes in parallel, and
+            // the geometries are then applied to the brushes that can be snapped.
+            const std::vector<Model::BrushGeometry> snappedGeometries = kdl::vec_parallel_transform(brushes, [&](const Model::Brush* brush) {
+                return brush->snappedGeometry(snapTo);
+            });
+
+            const auto uvLock = pref(Preferences::UVLock);
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                Model::Brush* brush = brushes[i];
+                if (snappedGeometries[i].polyhedron()) {
+                    brush->snapVertices(m_worldBounds, snapTo, snappedGeometries[i], uvLock);
                     succeededBrushCount += 1;
                 } else {
                     failedBrushCount += 1;
@@ -786,8 +843,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             std::vector<vm::vec3> newVertexPositions;
             for (const auto& entry : vertices) {
@@ -807,8 +864,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             std::vector<vm::segment3> newEdgePositions;
             for (const auto& entry : edges) {
@@ -828,8 +885,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             std::vector<vm::polygon3> newFacePositions;
             for (const auto& entry : faces) {
@@ -849,8 +906,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             for (const auto& entry : vertices) {
                 const vm::vec3& position = entry.first;
@@ -866,8 +923,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             for (const auto& entry : vertices) {
                 Model::Brush* brush = entry.first;
@@ -882,8 +939,8 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> nodes = kdl::vec_element_cast<Model::Node*>(brushes);
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
 
             for (Model::Brush* brush : brushes)
                 brush->rebuildGeometry(m_worldBounds);
@@ -896,8 +953,8 @@ namespace TrenchBroom {
                 const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
                 const std::vector<Model::Node*> parents = collectParents(nodes);
 
-                Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-                Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+                NotifyNodesChange notifyParents(*this, parents);
+                NotifyNodesChange notifyNodes(*this, nodes);
 
                 snapshot->restoreNodes(m_worldBounds);
 
@@ -908,13 +965,37 @@ namespace TrenchBroom {
             if (!brushFaces.empty()) {
                 snapshot->restoreBrushFaces();
                 setTextures(brushFaces);
-                brushFacesDidChangeNotifier(brushFaces);
+                brushFacesDidChange(brushFaces);
+            }
+        }
+
+        void MapDocumentCommandFacade::restoreTransformedBrushes(const std::vector<Model::Brush*>& brushes, const vm::mat4x4& inverseTransform, Model::Snapshot* brushFaceSnapshot) {
+            const std::vector<Model::Node*> nodes(std::begin(brushes), std::end(brushes));
+            const std::vector<Model::Node*> parents = collectParents(nodes);
+
+            NotifyNodesChange notifyParents(*this, parents);
+            NotifyNodesChange notifyNodes(*this, nodes);
+
+            // the face snapshot references the faces by their planes, so the brushes must be transformed first
+            Model::Brush::transformBrushes(brushes, inverseTransform, false, m_worldBounds);
+
+            std::vector<Model::BrushFace*> faces;
+            for (auto* brush : brushes) {
+                kdl::vec_append(faces, brush->faces());
             }
+
+            brushFaceSnapshot->restoreBrushFaces();
+            setTextures(faces);
+
+            invalidateSelectionBounds();
         }
 
         void MapDocumentCommandFacade::performSetEntityDefinitionFile(const Assets::EntityDefinitionFileSpec& spec) {
+            // the assets are replaced below, so any that are still pending must be loaded first
+            finishLoading();
+
             const std::vector<Model::Node*> nodes(1, m_world.get());
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyNodes(*this, nodes);
             Notifier<>::NotifyAfter notifyEntityDefinitions(entityDefinitionsDidChangeNotifier);
 
             // to avoid backslashes being misinterpreted as escape sequences
@@ -924,8 +1005,11 @@ namespace TrenchBroom {
         }
 
         void MapDocumentCommandFacade::performSetTextureCollections(const std::vector<IO::Path>& paths) {
+            // the assets are replaced below, so any that are still pending must be loaded first
+            finishLoading();
+
             const std::vector<Model::Node*> nodes(1, m_world.get());
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyNodes(*this, nodes);
             Notifier<>::NotifyBeforeAndAfter notifyTextureCollections(textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
 
             m_game->updateTextureCollections(*m_world, paths);
@@ -935,8 +1019,11 @@ namespace TrenchBroom {
         }
 
         void MapDocumentCommandFacade::performSetMods(const std::vector<std::string>& mods) {
+            // the assets are replaced below, so any that are still pending must be loaded first
+            finishLoading();
+
             const std::vector<Model::Node*> nodes(1, m_world.get());
-            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            NotifyNodesChange notifyNodes(*this, nodes);
             Notifier<>::NotifyAfter notifyMods(modsDidChangeNotifier);
 
             unsetEntityModels();
@@ -984,6 +1071,25 @@ namespace TrenchBroom {
             m_commandProcessor->transactionUndoneNotifier.addObserver(transactionUndoneNotifier);
             documentWasNewedNotifier.addObserver(this, &MapDocumentCommandFacade::documentWasNewed);
             documentWasLoadedNotifier.addObserver(this, &MapDocumentCommandFacade::documentWasLoaded);
+
+            PreferenceManager& prefs = PreferenceManager::instance();
+            prefs.preferenceDidChangeNotifier.addObserver(this, &MapDocumentCommandFacade::preferenceDidChange);
+        }
+
+        void MapDocumentCommandFacade::unbindObservers() {
+            PreferenceManager& prefs = PreferenceManager::instance();
+            prefs.preferenceDidChangeNotifier.removeObserver(this, &MapDocumentCommandFacade::preferenceDidChange);
+        }
+
+        void MapDocumentCommandFacade::preferenceDidChange(const IO::Path& path) {
+            if (path == Preferences::UndoMemoryLimit.path()) {
+                updateUndoMemoryLimit();
+            }
+        }
+
+        void MapDocumentCommandFacade::updateUndoMemoryLimit() {
+            const auto limitInMiB = std::max(0, pref(Preferences::UndoMemoryLimit));
+            m_commandProcessor->setUndoMemoryLimit(static_cast<size_t>(limitInMiB) * 1024u * 1024u);
         }
 
         void MapDocumentCommandFacade::documentWasNewed(MapDocument*) {
@@ -1030,6 +1136,10 @@ namespace TrenchBroom {
             m_commandProcessor->clearRepeatStack();
         }
 
+        size_t MapDocumentCommandFacade::doGetUndoMemoryUsage() const {
+            return m_commandProcessor->undoMemoryUsage();
+        }
+
         void MapDocumentCommandFacade::doStartTransaction(const std::string& name) {
             m_commandProcessor->startTransaction(name);
         }
@@ -115,6 +115,7 @@ namespace TrenchBroom {
             void performRebuildBrushGeometry(const std::vector<Model::Brush*>& brushes) override;
         public: // snapshots and restoration
             void restoreSnapshot(Model::Snapshot* snapshot);
+            void restoreTransformedBrushes(const std::vector<Model::Brush*>& brushes, const vm::mat4x4& inverseTransform, Model::Snapshot* brushFaceSnapshot);
         public: // entity definition file management
             void performSetEntityDefinitionFile(const Assets::EntityDefinitionFileSpec& spec);
         public: // texture collection management
@@ -128,6 +129,9 @@ namespace TrenchBroom {
             void decModificationCount(size_t delta = 1);
         private: // notification
             void bindObservers();
+            void unbindObservers();
+            void preferenceDidChange(const IO::Path& path);
+            void updateUndoMemoryLimit();
             void documentWasNewed(MapDocument* document);
             void documentWasLoaded(MapDocument* document);
         private: // implement MapDocument interface
@@ -140,6 +144,7 @@ namespace TrenchBroom {
             bool doCanRepeatCommands() const override;
             std::unique_ptr<CommandResult> doRepeatCommands() override;
             void doClearRepeatableCommands() override;
+            size_t doGetUndoMemoryUsage() const override;
 
             void doStartTransaction(const std::string& name) override;
             void doCommitTransaction() override;
@@ -24,10 +24,14 @@
 #include "FileLogger.h"
 #include "Preferences.h"
 #include "PreferenceManager.h"
+#include "Profiler.h"
 #include "TrenchBroomApp.h"
+#include "Assets/EntityDefinitionManager.h"
+#include "Assets/TextureManager.h"
 #include "IO/PathQt.h"
 #include "Model/AttributableNode.h"
 #include "Model/Brush.h"
+#include "Model/BrushGeometry.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Model/ExportFormat.h"
@@ -35,8 +39,12 @@
 #include "Model/GameFactory.h"
 #include "Model/Group.h"
 #include "Model/Layer.h"
+#include "Model/MapFormat.h"
 #include "Model/Node.h"
+#include "Model/Polyhedron.h"
+#include "Renderer/VboManager.h"
 #include "View/Actions.h"
+#include "View/AssetWatcher.h"
 #include "View/Autosaver.h"
 #if !defined __APPLE__
 #include "View/BorderLine.h"
@@ -66,12 +74,16 @@
 
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
 #include <cassert>
+#include <fstream>
+#include <iomanip>
 #include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -81,6 +93,8 @@
 #include <QString>
 #include <QApplication>
 #include <QClipboard>
+#include <QMimeData>
+#include <QUuid>
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -91,12 +105,37 @@
 
 namespace TrenchBroom {
     namespace View {
+        namespace {
+            /**
+             * The nodes that were most recently copied to the clipboard by this process. As long as the clipboard still
+             * holds the copy they were stored with, pasting clones them instead of parsing the clipboard text, which
+             * would rebuild the geometry of every brush.
+             */
+            struct CopiedNodes {
+                QByteArray id;
+                Model::MapFormat format = Model::MapFormat::Unknown;
+                std::vector<Model::Node*> nodes;
+
+                ~CopiedNodes() {
+                    kdl::vec_clear_and_delete(nodes);
+                }
+            };
+
+            const QString CopiedNodesMimeType("application/x-trenchbroom-copied-nodes");
+
+            CopiedNodes& copiedNodes() {
+                static CopiedNodes instance;
+                return instance;
+            }
+        }
+
         MapFrame::MapFrame(FrameManager* frameManager, std::shared_ptr<MapDocument> document) :
         QMainWindow(),
         m_frameManager(frameManager),
         m_document(std::move(document)),
         m_autosaver(std::make_unique<Autosaver>(m_document)),
         m_autosaveTimer(nullptr),
+        m_assetWatcher(nullptr),
         m_toolBar(nullptr),
         m_hSplitter(nullptr),
         m_vSplitter(nullptr),
@@ -136,6 +175,8 @@ namespace TrenchBroom {
             m_autosaveTimer = new QTimer(this);
             m_autosaveTimer->start(1000);
 
+            m_assetWatcher = new AssetWatcher(m_document, this);
+
             bindObservers();
             bindEvents();
 
@@ -151,6 +192,10 @@ namespace TrenchBroom {
                 renderView->makeCurrent();
             }
 
+            // Delete the pooled VBOs while the context is current. The VBOs that are destroyed afterwards are deleted
+            // right away, while the views are destroyed and make their contexts current.
+            m_contextManager->vboManager().clear();
+
             // The MapDocument's CachingLogger has a pointer to m_console, which
             // is about to be destroyed (DestroyChildren()). Clear the pointer
             // so we don't try to log to a dangling pointer (#1885).
@@ -536,7 +581,21 @@ namespace TrenchBroom {
         }
 
         void MapFrame::updateStatusBar() {
-            m_statusBarLabel->setText(QString(describeSelection(m_document.get())));
+            auto text = describeSelection(m_document.get());
+            if (m_document->hasPendingLoadStages()) {
+                text += tr(" - loading %1...").arg(QString::fromStdString(m_document->nextLoadStage()));
+            }
+            m_statusBarLabel->setText(text);
+        }
+
+        void MapFrame::scheduleNextLoadStage() {
+            updateStatusBar();
+            if (m_document->hasPendingLoadStages()) {
+                QTimer::singleShot(0, this, [this]() {
+                    m_document->runNextLoadStage();
+                    scheduleNextLoadStage();
+                });
+            }
         }
 
         void MapFrame::bindObservers() {
@@ -687,6 +746,7 @@ namespace TrenchBroom {
                 return false;
             }
             m_document->loadDocument(mapFormat, MapDocument::DefaultWorldBounds, game, path);
+            scheduleNextLoadStage();
             return true;
         }
 
@@ -913,14 +973,23 @@ namespace TrenchBroom {
         void MapFrame::copyToClipboard() {
             QClipboard *clipboard = QApplication::clipboard();
 
-            std::string str;
+            auto* mimeData = new QMimeData();
             if (m_document->hasSelectedNodes()) {
-                str = m_document->serializeSelectedNodes();
+                CopiedNodes& copied = copiedNodes();
+                kdl::vec_clear_and_delete(copied.nodes);
+                copied.id = QUuid::createUuid().toByteArray();
+                copied.format = m_document->world()->format();
+                copied.nodes = m_document->cloneSelectedNodes();
+
+                mimeData->setText(QString::fromStdString(m_document->serializeSelectedNodes()));
+                mimeData->setData(CopiedNodesMimeType, copied.id);
             } else if (m_document->hasSelectedBrushFaces()) {
-                str = m_document->serializeSelectedBrushFaces();
+                mimeData->setText(QString::fromStdString(m_document->serializeSelectedBrushFaces()));
+            } else {
+                mimeData->setText(QString());
             }
 
-            clipboard->setText(QString::fromStdString(str));
+            clipboard->setMimeData(mimeData);
         }
 
         bool MapFrame::canCutSelection() const {
@@ -958,6 +1027,15 @@ namespace TrenchBroom {
 
         PasteType MapFrame::paste() {
             auto *clipboard = QApplication::clipboard();
+
+            const CopiedNodes& copied = copiedNodes();
+            const QMimeData* mimeData = clipboard->mimeData();
+            if (!copied.nodes.empty() && mimeData != nullptr &&
+                mimeData->data(CopiedNodesMimeType) == copied.id &&
+                m_document->world()->format() == copied.format) {
+                return m_document->paste(copied.nodes);
+            }
+
             const auto qtext = clipboard->text();
 
             if (qtext.isEmpty()) {
@@ -1490,6 +1568,24 @@ namespace TrenchBroom {
             gameFactory.saveConfigs(gameName);
         }
 
+        static std::string formatMemory(const size_t bytes) {
+            std::stringstream str;
+            str << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / (1024.0 * 1024.0) << " MiB";
+            return str.str();
+        }
+
+        void MapFrame::logMemoryUsage() {
+            const auto textureStats = m_document->textureManager().stats();
+            const auto definitionCount = m_document->entityDefinitionManager().definitions().size();
+
+            logger().info() << "Memory usage:";
+            logger().info() << "  Brush geometry: " << formatMemory(Model::BrushGeometry::allocatedMemory()) << " reserved";
+            logger().info() << "  Textures: " << formatMemory(textureStats.uploadedBytes) << " in " << textureStats.uploadedCount << " of " << textureStats.textureCount << " uploaded textures";
+            logger().info() << "  Vertex buffers: " << formatMemory(m_contextManager->vboManager().currentVboSize());
+            logger().info() << "  Undo history: " << formatMemory(m_document->undoMemoryUsage());
+            logger().info() << "  Entity definitions: " << definitionCount;
+        }
+
         void MapFrame::debugPrintVertices() {
             m_document->printVertices();
         }
@@ -1575,6 +1671,23 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::debugExportProfile() {
+            const QString fileName = QFileDialog::getSaveFileName(this, tr("Export Profile"), "", "Chrome trace files (*.json)");
+            if (fileName.isEmpty()) {
+                return;
+            }
+
+            const IO::Path path = IO::pathFromQString(fileName);
+            std::ofstream stream(path.asString().c_str());
+            if (!stream.good()) {
+                logger().error() << "Could not open " << path << " for writing";
+                return;
+            }
+
+            Profiler::instance().writeChromeTrace(stream);
+            logger().info() << "Exported profile to " << path;
+        }
+
         void MapFrame::focusChange(QWidget* /* oldFocus */, QWidget* newFocus) {
             auto newMapView = dynamic_cast<MapViewBase*>(newFocus);
             if (newMapView != nullptr) {
@@ -56,6 +56,7 @@ namespace TrenchBroom {
 
     namespace View {
         class Action;
+        class AssetWatcher;
         class Autosaver;
         class Console;
         class FrameManager;
@@ -77,6 +78,7 @@ namespace TrenchBroom {
 
             std::unique_ptr<Autosaver> m_autosaver;
             QTimer* m_autosaveTimer;
+            AssetWatcher* m_assetWatcher;
 
             QToolBar* m_toolBar;
 
@@ -133,6 +135,12 @@ namespace TrenchBroom {
         private: // status bar
             void createStatusBar();
             void updateStatusBar();
+        private: // progressive loading
+            /**
+             * Runs the document's pending load stages one per event loop iteration, so that the views can render the
+             * world and the user can interact with it while the assets are still being loaded.
+             */
+            void scheduleNextLoadStage();
         private: // gui creation
             void createGui();
         private: // notification handlers
@@ -337,6 +345,11 @@ namespace TrenchBroom {
 
             void showLaunchEngineDialog();
 
+            /**
+             * Writes the memory used by brush geometry, textures, vertex buffers and the undo history to the log.
+             */
+            void logMemoryUsage();
+
             void debugPrintVertices();
             void debugCreateBrush();
             void debugCreateCube();
@@ -344,6 +357,7 @@ namespace TrenchBroom {
             void debugCrash();
             void debugThrowExceptionDuringCommand();
             void debugSetWindowSize();
+            void debugExportProfile();
 
             void focusChange(QWidget* oldFocus, QWidget* newFocus);
 
@@ -143,15 +143,13 @@ namespace TrenchBroom {
             return PickRequest(vm::ray3(m_camera->pickRay(x, y)), *m_camera);
         }
 
-        Model::PickResult MapView2D::doPick(const vm::ray3& pickRay) const {
+        void MapView2D::doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
             auto document = kdl::mem_lock(m_document);
             const auto& editorContext = document->editorContext();
             const auto axis = vm::find_abs_max_component(pickRay.direction);
 
-            auto pickResult = Model::PickResult::bySize(editorContext, axis);
+            pickResult.resetBySize(editorContext, axis);
             document->pick(pickRay, pickResult);
-
-            return pickResult;
         }
 
         void MapView2D::initializeGL() {
@@ -328,9 +326,12 @@ namespace TrenchBroom {
             return *m_camera;
         }
 
-        void MapView2D::doRenderGrid(Renderer::RenderContext&, Renderer::RenderBatch& renderBatch) {
-            auto document = kdl::mem_lock(m_document);
-            renderBatch.addOneShot(new Renderer::GridRenderer(*m_camera, document->worldBounds()));
+        void MapView2D::doRenderGrid(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            // the grid is drawn by the shader, so there is nothing to upload if it is hidden
+            if (renderContext.showGrid()) {
+                auto document = kdl::mem_lock(m_document);
+                renderBatch.addOneShot(new Renderer::GridRenderer(*m_camera, document->worldBounds()));
+            }
         }
 
         void MapView2D::doRenderMap(Renderer::MapRenderer& renderer, Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
@@ -65,7 +65,7 @@ namespace TrenchBroom {
             void cameraDidChange(const Renderer::Camera* camera);
         private: // implement ToolBoxConnector interface
             PickRequest doGetPickRequest(int x, int y) const override;
-            Model::PickResult doPick(const vm::ray3& pickRay) const override;
+            void doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const override;
         protected: // QOpenGLWidget overrides
             void initializeGL() override;
         private: // implement RenderView interface
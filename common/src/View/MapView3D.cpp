@@ -28,6 +28,7 @@
 #include "Model/BrushGeometry.h"
 #include "Model/Entity.h"
 #include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
 #include "Model/HitQuery.h"
 #include "Model/PickResult.h"
 #include "Model/PointFile.h"
@@ -186,13 +187,12 @@ namespace TrenchBroom {
             return PickRequest(vm::ray3(m_camera->pickRay(x, y)), *m_camera);
         }
 
-        Model::PickResult MapView3D::doPick(const vm::ray3& pickRay) const {
+        void MapView3D::doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
-            Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
+            pickResult.resetByDistance(editorContext);
 
             document->pick(pickRay, pickResult);
-            return pickResult;
         }
 
         void MapView3D::doUpdateViewport(const int x, const int y, const int width, const int height) {
@@ -212,7 +212,11 @@ namespace TrenchBroom {
                 const auto& editorContext = document->editorContext();
                 auto pickResult = Model::PickResult::byDistance(editorContext);
 
-                document->pick(pickRay, pickResult);
+                // only the closest pickable brush face is of interest here
+                const auto filter = Model::HitFilterChain(
+                    std::make_unique<Model::TypedHitFilter>(Model::Brush::BrushHit),
+                    std::make_unique<Model::ContextHitFilter>(editorContext));
+                document->pickClosest(pickRay, filter, pickResult);
                 const auto& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).occluded().first();
 
                 if (hit.isMatch()) {
@@ -71,7 +71,7 @@ namespace TrenchBroom {
             void resetFlyModeKeys();
         private: // implement ToolBoxConnector interface
             PickRequest doGetPickRequest(int x, int y) const override;
-            Model::PickResult doPick(const vm::ray3& pickRay) const override;
+            void doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const override;
         private: // implement RenderView interface
             void doUpdateViewport(int x, int y, int width, int height) override;
         private: // implement MapView interface
@@ -43,6 +43,7 @@
 #include "Model/PortalFile.h"
 #include "Model/World.h"
 #include "Renderer/Camera.h"
+#include "Renderer/AttrString.h"
 #include "Renderer/Compass.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/FontManager.h"
@@ -218,12 +219,15 @@ namespace TrenchBroom {
         }
 
         void MapViewBase::entityDefinitionsDidChange() {
+            // entity definitions and models determine the bounds of point entities
+            invalidatePickCache();
             createActions();
             updateActionStates();
             update();
         }
 
         void MapViewBase::modsDidChange() {
+            invalidatePickCache();
             update();
         }
 
@@ -879,6 +883,11 @@ namespace TrenchBroom {
             renderFPS(renderContext, renderBatch);
 
             renderBatch.render(renderContext);
+
+            // keep rendering until the renderer has caught up with large invalidations
+            if (!m_renderer.valid()) {
+                update();
+            }
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
@@ -959,7 +968,14 @@ namespace TrenchBroom {
         void MapViewBase::renderFPS(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
             Renderer::RenderService renderService(renderContext, renderBatch);
 
-            renderService.renderHeadsUp(m_currentFPS);
+            if (pref(Preferences::ShowProfiler)) {
+                Renderer::AttrString string;
+                string.appendLeftJustified(m_currentFPS);
+                string.appendLeftJustified(Renderer::FrameProfiler::instance().summary());
+                renderService.renderHeadsUp(string);
+            } else {
+                renderService.renderHeadsUp(m_currentFPS);
+            }
         }
 
         void MapViewBase::processEvent(const KeyEvent& event) {
@@ -86,6 +86,11 @@ namespace TrenchBroom {
             return true;
         }
 
+        bool MoveBrushEdgesCommand::doWillCollateWith(const UndoableCommand& command) const {
+            const auto& other = static_cast<const MoveBrushEdgesCommand&>(command);
+            return canCollateWith(other) && m_newEdgePositions == other.m_oldEdgePositions;
+        }
+
         void MoveBrushEdgesCommand::doSelectNewHandlePositions(VertexHandleManagerBaseT<vm::segment3>& manager) const {
             manager.select(std::begin(m_newEdgePositions), std::end(m_newEdgePositions));
         }
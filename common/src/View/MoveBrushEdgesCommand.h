@@ -48,6 +48,7 @@ namespace TrenchBroom {
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
+            bool doWillCollateWith(const UndoableCommand& command) const override;
 
             void doSelectNewHandlePositions(VertexHandleManagerBaseT<vm::segment3>& manager) const override;
             void doSelectOldHandlePositions(VertexHandleManagerBaseT<vm::segment3>& manager) const override;
@@ -85,6 +85,11 @@ namespace TrenchBroom {
             return true;
         }
 
+        bool MoveBrushFacesCommand::doWillCollateWith(const UndoableCommand& command) const {
+            const auto& other = static_cast<const MoveBrushFacesCommand&>(command);
+            return canCollateWith(other) && m_newFacePositions == other.m_oldFacePositions;
+        }
+
 
         void MoveBrushFacesCommand::doSelectNewHandlePositions(VertexHandleManagerBaseT<vm::polygon3>& manager) const {
             manager.select(std::begin(m_newFacePositions), std::end(m_newFacePositions));
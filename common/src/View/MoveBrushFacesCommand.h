@@ -46,6 +46,7 @@ namespace TrenchBroom {
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
+            bool doWillCollateWith(const UndoableCommand& command) const override;
 
             void doSelectNewHandlePositions(VertexHandleManagerBaseT<vm::polygon3>& manager) const override;
             void doSelectOldHandlePositions(VertexHandleManagerBaseT<vm::polygon3>& manager) const override;
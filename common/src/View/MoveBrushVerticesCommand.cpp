@@ -96,6 +96,11 @@ namespace TrenchBroom {
             return true;
         }
 
+        bool MoveBrushVerticesCommand::doWillCollateWith(const UndoableCommand& command) const {
+            const auto& other = static_cast<const MoveBrushVerticesCommand&>(command);
+            return canCollateWith(other) && m_newVertexPositions == other.m_oldVertexPositions;
+        }
+
         void MoveBrushVerticesCommand::doSelectNewHandlePositions(VertexHandleManagerBaseT<vm::vec3>& manager) const {
             manager.select(std::begin(m_newVertexPositions), std::end(m_newVertexPositions));
         }
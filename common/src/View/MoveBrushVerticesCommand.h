@@ -55,6 +55,7 @@ namespace TrenchBroom {
             std::unique_ptr<CommandResult> doCreateCommandResult(bool success) override;
 
             bool doCollateWith(UndoableCommand* command) override;
+            bool doWillCollateWith(const UndoableCommand& command) const override;
 
             void doSelectNewHandlePositions(VertexHandleManagerBaseT<vm::vec3>& manager) const override;
             void doSelectOldHandlePositions(VertexHandleManagerBaseT<vm::vec3>& manager) const override;
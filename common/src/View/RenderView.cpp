@@ -24,6 +24,8 @@
 #include "Preferences.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
+#include "Renderer/ShaderManager.h"
+#include "Renderer/Shaders.h"
 #include "Renderer/Transformation.h"
 #include "Renderer/Vbo.h"
 #include "Renderer/VboManager.h"
@@ -84,7 +86,8 @@ namespace TrenchBroom {
         m_glContext(&contextManager),
         m_framesRendered(0),
         m_maxFrameTimeMsecs(0),
-        m_lastFPSCounterUpdate(0) {
+        m_lastFPSCounterUpdate(0),
+        m_gpuTimer("Render view") {
             QPalette pal;
             const QColor color = pal.color(QPalette::Highlight);
             m_focusColor = fromQColor(color);
@@ -107,7 +110,8 @@ namespace TrenchBroom {
                     std::to_string(maxFrameTime) + "ms. " +
                     std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs (" +
                     std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling " +
-                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB, " +
+                    std::to_string(m_glContext->vboManager().pooledVboCount()) + " pooled";
 
 
             });
@@ -118,7 +122,11 @@ namespace TrenchBroom {
             setFocusPolicy(Qt::StrongFocus); // accept focus by clicking or tab
         }
 
-        RenderView::~RenderView() = default;
+        RenderView::~RenderView() {
+            // release the timer queries while our context is current
+            makeCurrent();
+            m_gpuTimer.free();
+        }
 
         void RenderView::keyPressEvent(QKeyEvent* event) {
             m_eventRecorder.recordEvent(event);
@@ -205,10 +213,22 @@ namespace TrenchBroom {
         }
 
         void RenderView::render() {
-            processInput();
-            clearBackground();
-            doRender();
-            renderFocusIndicator();
+            auto& profiler = Renderer::FrameProfiler::instance();
+            profiler.setEnabled(pref(Preferences::ShowProfiler));
+
+            {
+                Renderer::FrameProfiler::Scope scope("RenderView::render");
+                m_gpuTimer.begin();
+
+                processInput();
+                clearBackground();
+                doRender();
+                renderFocusIndicator();
+
+                m_gpuTimer.end();
+            }
+
+            profiler.endFrame();
         }
 
         void RenderView::processInput() {
@@ -275,7 +295,24 @@ namespace TrenchBroom {
         }
 
         bool RenderView::doInitializeGL() {
-            return m_glContext->initialize();
+            if (m_glContext->initialize()) {
+                // link all shader programs after the first frame so that their first use does not stall rendering
+                shaderManager().prewarm(Renderer::Shaders::AllShaders);
+                QTimer::singleShot(0, this, &RenderView::prewarmNextShader);
+                return true;
+            }
+            return false;
+        }
+
+        void RenderView::prewarmNextShader() {
+            // link one program at a time so that pending events are handled in between
+            makeCurrent();
+            const auto morePending = shaderManager().prewarmNext();
+            doneCurrent();
+
+            if (morePending) {
+                QTimer::singleShot(0, this, &RenderView::prewarmNextShader);
+            }
         }
 
         void RenderView::doUpdateViewport(const int /* x */, const int /* y */, const int /* width */, const int /* height */) {}
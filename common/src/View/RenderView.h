@@ -22,6 +22,7 @@
 
 #include "Color.h"
 #include "Renderer/GL.h" // must be included here, before QOpenGLWidget, because it includes glew
+#include "Renderer/FrameProfiler.h"
 #include "View/InputEvent.h"
 
 #include <string>
@@ -56,6 +57,7 @@ namespace TrenchBroom {
             // other
             int64_t m_lastFPSCounterUpdate;
             QElapsedTimer m_timeSinceLastFrame;
+            Renderer::GpuTimer m_gpuTimer;
         protected:
             std::string m_currentFPS;
         protected:
@@ -86,6 +88,7 @@ namespace TrenchBroom {
             void processInput();
             void clearBackground();
             void renderFocusIndicator();
+            void prewarmNextShader();
         protected:
             // called by initializeGL by default
             virtual bool doInitializeGL();
@@ -75,20 +75,28 @@ namespace TrenchBroom {
         }
 
         std::vector<Model::BrushFace*> ReplaceTextureDialog::getApplicableFaces() const {
+            const Assets::Texture* subject = m_subjectBrowser->selectedTexture();
+            ensure(subject != nullptr, "subject is null");
+
+            // the usage count includes every face that uses the texture, so if it is zero, no face can match
+            if (subject->usageCount() == 0u) {
+                return {};
+            }
+
+            const Model::BrushFacePredicates::HasTexture hasSubject(subject);
+
             auto document = kdl::mem_lock(m_document);
-            std::vector<Model::BrushFace*> faces = document->allSelectedBrushFaces();
-            if (faces.empty()) {
-                Model::CollectBrushFacesVisitor collect;
+            const std::vector<Model::BrushFace*> selectedFaces = document->allSelectedBrushFaces();
+            if (selectedFaces.empty()) {
+                // filter while traversing so that we don't have to collect every face of the map first
+                Model::CollectMatchingBrushFacesVisitor<Model::BrushFacePredicates::HasTexture> collect(hasSubject);
                 document->world()->acceptAndRecurse(collect);
-                faces = collect.faces();
+                return collect.faces();
             }
 
-            const Assets::Texture* subject = m_subjectBrowser->selectedTexture();
-            ensure(subject != nullptr, "subject is null");
-
             std::vector<Model::BrushFace*> result;
-            for (auto* face : faces) {
-                if (face->texture() == subject) {
+            for (auto* face : selectedFaces) {
+                if (hasSubject(face)) {
                     result.push_back(face);
                 }
             }
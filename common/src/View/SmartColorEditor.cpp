@@ -35,6 +35,9 @@
 
 #include <kdl/vector_set.h>
 
+#include <string>
+#include <unordered_set>
+
 #include <QColor>
 #include <QLabel>
 #include <QHBoxLayout>
@@ -151,6 +154,8 @@ namespace TrenchBroom {
         class SmartColorEditor::CollectColorsVisitor : public Model::ConstNodeVisitor {
         private:
             const std::string& m_name;
+            // many entities share the same color value, which only needs to be parsed once
+            std::unordered_set<std::string> m_values;
             kdl::vector_set<QColor, ColorCmp> m_colors;
         public:
             explicit CollectColorsVisitor(const std::string& name) :
@@ -167,7 +172,7 @@ namespace TrenchBroom {
             void visitAttributableNode(const Model::AttributableNode* attributable) {
                 static const auto NullValue("");
                 const auto& value = attributable->attribute(m_name, NullValue);
-                if (value != NullValue)
+                if (value != NullValue && m_values.insert(value).second)
                     addColor(Model::parseEntityColor(value));
             }
 
@@ -45,6 +45,10 @@ namespace TrenchBroom {
             return restoreSnapshot(document);
         }
 
+        size_t SnapshotCommand::doGetMemoryUsage() const {
+            return m_snapshot != nullptr ? m_snapshot->memoryUsage() : 0u;
+        }
+
         void SnapshotCommand::takeSnapshot(MapDocumentCommandFacade *document) {
             assert(m_snapshot == nullptr);
             m_snapshot = doTakeSnapshot(document);
@@ -62,7 +66,7 @@ namespace TrenchBroom {
             m_snapshot.reset();
         }
 
-        std::unique_ptr<Model::Snapshot> SnapshotCommand::doTakeSnapshot(MapDocumentCommandFacade *document) const {
+        std::unique_ptr<Model::Snapshot> SnapshotCommand::doTakeSnapshot(MapDocumentCommandFacade *document) {
             const auto& nodes = document->selectedNodes().nodes();
             return std::make_unique<Model::Snapshot>(std::begin(nodes), std::end(nodes));
         }
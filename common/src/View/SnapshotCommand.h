@@ -41,12 +41,14 @@ namespace TrenchBroom {
         public:
             std::unique_ptr<CommandResult> performDo(MapDocumentCommandFacade* document) override;
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
+        protected:
+            size_t doGetMemoryUsage() const override;
         private:
             void takeSnapshot(MapDocumentCommandFacade* document);
             std::unique_ptr<CommandResult> restoreSnapshot(MapDocumentCommandFacade* document);
             void deleteSnapshot();
         private:
-            virtual std::unique_ptr<Model::Snapshot> doTakeSnapshot(MapDocumentCommandFacade* document) const;
+            virtual std::unique_ptr<Model::Snapshot> doTakeSnapshot(MapDocumentCommandFacade* document);
 
             deleteCopyAndMove(SnapshotCommand)
         };
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpeculativePreview.h"
+
+#include <kdl/invoke.h>
+#include <kdl/thread_pool.h>
+
+namespace TrenchBroom {
+    namespace View {
+        PreviewWorker::PreviewWorker() :
+        m_runningTaskId(0) {}
+
+        PreviewWorker::~PreviewWorker() {
+            cancel();
+        }
+
+        void PreviewWorker::submit(std::function<void()> task) {
+            if (m_runningTask.valid()) {
+                m_waitingTask = std::move(task);
+            } else {
+                start(std::move(task));
+            }
+        }
+
+        void PreviewWorker::finish() {
+            waitForRunningTask();
+            if (m_waitingTask) {
+                auto task = std::move(m_waitingTask);
+                m_waitingTask = nullptr;
+                task();
+            }
+        }
+
+        void PreviewWorker::cancel() {
+            m_waitingTask = nullptr;
+
+            // the running task is discarded if it has not been started yet
+            m_runningTaskToken.cancel();
+            waitForRunningTask();
+        }
+
+        void PreviewWorker::start(std::function<void()> task) {
+            const auto taskId = ++m_runningTaskId;
+            m_runningTaskToken = kdl::cancellation_token();
+            m_runningTask = kdl::run_async([this, taskId, task = std::move(task)]() {
+                // the notification is handled on the thread that owns this object, which waits for the future to
+                // become ready
+                const kdl::invoke_later notify{[this, taskId]() {
+                    QMetaObject::invokeMethod(this, "taskDidFinish", Qt::QueuedConnection, Q_ARG(quint64, taskId));
+                }};
+                task();
+            }, m_runningTaskToken, kdl::task_priority::interactive);
+        }
+
+        void PreviewWorker::waitForRunningTask() {
+            if (m_runningTask.valid()) {
+                try {
+                    m_runningTask.get();
+                } catch (const kdl::task_cancelled&) {}
+
+                // ignore the pending notification of this task
+                ++m_runningTaskId;
+            }
+        }
+
+        void PreviewWorker::taskDidFinish(const quint64 taskId) {
+            if (taskId != m_runningTaskId || !m_runningTask.valid()) {
+                return;
+            }
+
+            m_runningTask.get();
+            emit taskFinished();
+
+            if (m_waitingTask) {
+                auto task = std::move(m_waitingTask);
+                m_waitingTask = nullptr;
+                start(std::move(task));
+            }
+        }
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_SPECULATIVEPREVIEW_H
+#define TRENCHBROOM_SPECULATIVEPREVIEW_H
+
+#include "Macros.h"
+
+#include <kdl/thread_pool.h>
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <QObject>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * Runs tasks on a background thread, one at a time. A task that is submitted while another task is running
+         * waits until the running task has finished, and it replaces any other task that is still waiting, so only the
+         * most recently submitted task is run next.
+         *
+         * The taskFinished signal is emitted on the thread that owns this object whenever a task has finished.
+         */
+        class PreviewWorker : public QObject {
+            Q_OBJECT
+        private:
+            std::future<void> m_runningTask;
+            kdl::cancellation_token m_runningTaskToken;
+            quint64 m_runningTaskId;
+            std::function<void()> m_waitingTask;
+        public:
+            PreviewWorker();
+            ~PreviewWorker() override;
+
+            /**
+             * Submits the given task. The task must not throw any exceptions.
+             */
+            void submit(std::function<void()> task);
+
+            /**
+             * Blocks until the running task, if any, has finished, and then runs the waiting task, if any, on the
+             * calling thread. The taskFinished signal is not emitted for these tasks.
+             */
+            void finish();
+
+            /**
+             * Discards the waiting task, if any, and blocks until the running task, if any, has finished. If the running
+             * task has not been started yet, it is discarded, too. The taskFinished signal is not emitted for the
+             * running task.
+             */
+            void cancel();
+        private:
+            void start(std::function<void()> task);
+            void waitForRunningTask();
+        private slots:
+            void taskDidFinish(quint64 taskId);
+        signals:
+            void taskFinished();
+
+            deleteCopyAndMove(PreviewWorker)
+        };
+
+        /**
+         * Computes a preview, such as the geometry shown by a tool while the user drags the mouse, on a background
+         * thread so that the tool stays responsive even if the preview takes longer to compute than the time between
+         * two input events.
+         *
+         * Every request is a function from the current input to the preview. Requests that are superseded by a newer
+         * request before they are started are dropped, and the result of the latest completed request is passed to the
+         * publish function on the thread that owns this object.
+         *
+         * @tparam R the type of the preview, must be movable
+         */
+        template <typename R>
+        class SpeculativePreview {
+        public:
+            using Publish = std::function<void(R)>;
+        private:
+            PreviewWorker m_worker;
+            Publish m_publish;
+
+            std::mutex m_mutex;
+            std::optional<R> m_result;
+        public:
+            explicit SpeculativePreview(Publish publish) :
+            m_publish(std::move(publish)) {
+                QObject::connect(&m_worker, &PreviewWorker::taskFinished, [this]() { publishResult(); });
+            }
+
+            ~SpeculativePreview() {
+                // the running request accesses the members of this object
+                m_worker.cancel();
+            }
+
+            /**
+             * Requests a preview to be computed by the given function on a background thread. The function must not
+             * throw any exceptions, and it must not access any state that may be modified in the meantime.
+             */
+            template <typename F>
+            void request(F compute) {
+                m_worker.submit([this, compute = std::move(compute)]() {
+                    auto result = compute();
+                    const std::lock_guard<std::mutex> lock(m_mutex);
+                    m_result = std::move(result);
+                });
+            }
+
+            /**
+             * Completes the latest request on the calling thread if necessary and publishes its result immediately,
+             * so that the preview matches the latest request.
+             */
+            void finish() {
+                m_worker.finish();
+                publishResult();
+            }
+
+            /**
+             * Drops all requests and their results.
+             */
+            void cancel() {
+                m_worker.cancel();
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_result = std::nullopt;
+            }
+        private:
+            void publishResult() {
+                std::optional<R> result;
+                {
+                    const std::lock_guard<std::mutex> lock(m_mutex);
+                    std::swap(result, m_result);
+                }
+                if (result.has_value()) {
+                    m_publish(std::move(*result));
+                }
+            }
+
+            deleteCopyAndMove(SpeculativePreview)
+        };
+    }
+}
+
+#endif //TRENCHBROOM_SPECULATIVEPREVIEW_H
@@ -33,8 +33,10 @@
 #include <QtGlobal>
 #include <QPushButton>
 #include <QComboBox>
+#include <QLabel>
 #include <QLineEdit>
 #include <QScrollBar>
+#include <QTimer>
 #include <QVBoxLayout>
 
 // for use in QVariant
@@ -49,6 +51,7 @@ namespace TrenchBroom {
         m_groupButton(nullptr),
         m_usedButton(nullptr),
         m_filterBox(nullptr),
+        m_memoryLabel(nullptr),
         m_scrollBar(nullptr),
         m_view(nullptr) {
             createGui(contextManager);
@@ -144,6 +147,15 @@ namespace TrenchBroom {
                 m_view->setFilterText(m_filterBox->text().toStdString());
             });
 
+            m_memoryLabel = new QLabel();
+            m_memoryLabel->setToolTip(tr("Number of textures uploaded to the graphics card and the video memory they occupy"));
+            makeInfo(m_memoryLabel);
+
+            // textures are uploaded when they are first rendered, so we poll the texture manager periodically
+            auto* memoryTimer = new QTimer(this);
+            connect(memoryTimer, &QTimer::timeout, this, &TextureBrowser::updateMemoryLabel);
+            memoryTimer->start(1000);
+
             auto* controlSizer = new QHBoxLayout();
             controlSizer->setContentsMargins(LayoutConstants::NarrowHMargin, LayoutConstants::NarrowVMargin, LayoutConstants::NarrowHMargin, LayoutConstants::NarrowVMargin);
             controlSizer->setSpacing(LayoutConstants::NarrowHMargin);
@@ -151,6 +163,7 @@ namespace TrenchBroom {
             controlSizer->addWidget(m_groupButton);
             controlSizer->addWidget(m_usedButton);
             controlSizer->addWidget(m_filterBox, 1);
+            controlSizer->addWidget(m_memoryLabel);
 
             auto* outerSizer = new QVBoxLayout();
             outerSizer->setContentsMargins(0, 0, 0, 0);
@@ -256,5 +269,19 @@ namespace TrenchBroom {
             Assets::Texture* texture = document->textureManager().texture(textureName);
             m_view->setSelectedTexture(texture);
         }
+
+        void TextureBrowser::updateMemoryLabel() {
+            if (kdl::mem_expired(m_document)) {
+                return;
+            }
+
+            auto document = kdl::mem_lock(m_document);
+            const auto stats = document->textureManager().stats();
+            const auto megaBytes = static_cast<double>(stats.uploadedBytes) / (1024.0 * 1024.0);
+            m_memoryLabel->setText(tr("%1/%2 textures, %3 MiB")
+                .arg(stats.uploadedCount)
+                .arg(stats.textureCount)
+                .arg(megaBytes, 0, 'f', 1));
+        }
     }
 }
@@ -28,6 +28,7 @@
 
 class QPushButton;
 class QComboBox;
+class QLabel;
 class QLineEdit;
 class QScrollBar;
 
@@ -59,6 +60,7 @@ namespace TrenchBroom {
             QPushButton* m_groupButton;
             QPushButton* m_usedButton;
             QLineEdit* m_filterBox;
+            QLabel* m_memoryLabel;
             QScrollBar* m_scrollBar;
             TextureBrowserView* m_view;
         public:
@@ -93,6 +95,7 @@ namespace TrenchBroom {
 
             void reload();
             void updateSelectedTexture();
+            void updateMemoryLabel();
         };
     }
 }
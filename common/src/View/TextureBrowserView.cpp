@@ -44,6 +44,7 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -63,7 +64,8 @@ namespace TrenchBroom {
         m_group(false),
         m_hideUnused(false),
         m_sortOrder(TextureSortOrder::Name),
-        m_selectedTexture(nullptr) {
+        m_selectedTexture(nullptr),
+        m_textureTitleCellWidth(0.0f) {
             auto doc = kdl::mem_lock(m_document);
             doc->textureManager().usageCountDidChange.addObserver(this, &TextureBrowserView::usageCountDidChange);
         }
@@ -125,7 +127,11 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::usageCountDidChange() {
-            invalidate();
+            // the texture colors are determined from the usage counts when rendering, so the layout only changes if
+            // the usage counts determine which textures are shown or in what order
+            if (m_hideUnused || m_sortOrder == TextureSortOrder::Usage) {
+                invalidate();
+            }
             update();
         }
 
@@ -147,31 +153,74 @@ namespace TrenchBroom {
             assert(fontSize > 0);
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
+            const float maxCellWidth = layout.maxCellWidth();
+
+            // the cached texture titles are only valid if neither the font nor the cell width have changed
+            if (!m_textureTitleFont || *m_textureTitleFont < font || font < *m_textureTitleFont || m_textureTitleCellWidth != maxCellWidth) {
+                m_textureTitles.clear();
+                m_textureTitleFont = font;
+                m_textureTitleCellWidth = maxCellWidth;
+            }
+
+            // only keep the titles of the textures that are shown so that the cache doesn't grow indefinitely
+            std::map<std::string, TitleLayout> textureTitles;
+            const auto textureTitle = [&](const Assets::Texture* texture) -> const TitleLayout& {
+                auto textureName = IO::Path(texture->name()).lastComponent().asString();
+                auto it = textureTitles.find(textureName);
+                if (it == std::end(textureTitles)) {
+                    auto cachedIt = m_textureTitles.find(textureName);
+                    if (cachedIt != std::end(m_textureTitles)) {
+                        it = textureTitles.emplace(std::move(textureName), cachedIt->second).first;
+                    } else {
+                        auto title = measureTitle(textureName, font, maxCellWidth);
+                        it = textureTitles.emplace(std::move(textureName), std::move(title)).first;
+                    }
+                }
+                return it->second;
+            };
+
+            // every texture of a collection shows the collection name with the same font, so measure it only once
+            std::map<const Assets::TextureCollection*, TitleLayout> groupTitles;
+            const auto groupTitle = [&](const Assets::TextureCollection* collection) -> const TitleLayout& {
+                auto it = groupTitles.find(collection);
+                if (it == std::end(groupTitles)) {
+                    it = groupTitles.emplace(collection, measureTitle(collection->name(), font, maxCellWidth)).first;
+                }
+                return it->second;
+            };
 
             if (m_group) {
                 for (const Assets::TextureCollection* collection : getCollections()) {
                     layout.addGroup(collection->name(), static_cast<float>(fontSize) + 2.0f);
                     for (Assets::Texture* texture : getTextures(collection))
-                        addTextureToLayout(layout, texture, font);
+                        addTextureToLayout(layout, texture, font, textureTitle(texture), groupTitle(collection));
                 }
             } else {
                 for (Assets::Texture* texture : getTextures())
-                    addTextureToLayout(layout, texture, font);
+                    addTextureToLayout(layout, texture, font, textureTitle(texture), groupTitle(texture->collection()));
             }
+
+            m_textureTitles = std::move(textureTitles);
+        }
+
+        TextureBrowserView::TitleLayout TextureBrowserView::measureTitle(const std::string& title, const Renderer::FontDescriptor& font, const float maxCellWidth) {
+            const auto titleFont = fontManager().selectFontSize(font, title, maxCellWidth, 6);
+            return TitleLayout{ titleFont, fontManager().font(titleFont).measure(title) };
         }
 
-        void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font) {
+        void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font, const TitleLayout& textureTitle, const TitleLayout& groupTitle) {
             const float maxCellWidth = layout.maxCellWidth();
 
             const auto& groupName   = texture->collection()->name();
             const auto  textureName = IO::Path(texture->name()).lastComponent().asString();
 
-            const auto textureFont = fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
-            const auto groupFont   = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
+            const auto& textureFont = textureTitle.font;
+            const auto& groupFont   = groupTitle.font;
 
-            const auto defaultTextHeight = fontManager().font(font).measure(groupName + textureName).y();
-            const auto textureNameSize   = fontManager().font(textureFont).measure(textureName);
-            const auto groupNameSize     = fontManager().font(groupFont).measure(groupName);
+            // the titles have no line breaks, so their height is the line height of the font
+            const auto defaultTextHeight = fontManager().font(font).measure("").y();
+            const auto& textureNameSize  = textureTitle.size;
+            const auto& groupNameSize    = groupTitle.size;
 
             const auto totalSize = vm::vec2f(vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
 
@@ -186,7 +235,9 @@ namespace TrenchBroom {
                 vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
                 vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
                 textureFont,
-                groupFont
+                groupFont,
+                {},
+                {}
             });
 
             layout.addItem(QVariant::fromValue(cellData),
@@ -356,7 +407,9 @@ namespace TrenchBroom {
             shader.set("Texture", 0);
             shader.set("Brightness", pref(Preferences::Brightness));
 
-            size_t num = 0;
+            // upload the quads of all visible cells at once, and then draw each quad with its own texture
+            std::vector<TextureVertex> vertices;
+            std::vector<const Assets::Texture*> textures;
 
             for (size_t i = 0; i < layout.size(); ++i) {
                 const Group& group = layout[i];
@@ -367,29 +420,28 @@ namespace TrenchBroom {
                             for (size_t k = 0; k < row.size(); ++k) {
                                 const Cell& cell = row[k];
                                 const LayoutBounds& bounds = cell.itemBounds();
-                                const Assets::Texture* texture = cellData(cell).texture;
-
-                                Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>({
-                                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f)),
-                                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.bottom() - y)), vm::vec2f(0.0f, 1.0f)),
-                                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.bottom() - y)), vm::vec2f(1.0f, 1.0f)),
-                                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.top() - y)),    vm::vec2f(1.0f, 0.0f))
-                                }));
-
-                                shader.set("GrayScale", texture->overridden());
-                                texture->activate();
 
-                                vertexArray.prepare(vboManager());
-                                vertexArray.render(Renderer::PrimType::Quads);
-
-                                texture->deactivate();
-
-                                ++num;
+                                vertices.emplace_back(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f));
+                                vertices.emplace_back(vm::vec2f(bounds.left(),  height - (bounds.bottom() - y)), vm::vec2f(0.0f, 1.0f));
+                                vertices.emplace_back(vm::vec2f(bounds.right(), height - (bounds.bottom() - y)), vm::vec2f(1.0f, 1.0f));
+                                vertices.emplace_back(vm::vec2f(bounds.right(), height - (bounds.top() - y)),    vm::vec2f(1.0f, 0.0f));
+                                textures.push_back(cellData(cell).texture);
                             }
                         }
                     }
                 }
             }
+
+            Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::move(vertices));
+            vertexArray.prepare(vboManager());
+
+            for (size_t i = 0; i < textures.size(); ++i) {
+                const Assets::Texture* texture = textures[i];
+                shader.set("GrayScale", texture->overridden());
+                texture->activate();
+                vertexArray.render(Renderer::PrimType::Quads, static_cast<GLint>(4u * i), 4);
+                texture->deactivate();
+            }
         }
 
         void TextureBrowserView::renderNames(Layout& layout, const float y, const float height) {
@@ -446,6 +498,20 @@ namespace TrenchBroom {
             }
         }
 
+        namespace {
+            /**
+             * Appends vertices for the given glyph quads, which consist of alternating positions and texture
+             * coordinates, moved by the given offset.
+             */
+            template <typename Vertex>
+            void appendStringVertices(std::vector<Vertex>& vertices, const std::vector<vm::vec2f>& quads, const vm::vec2f& offset, const Color& color) {
+                vertices.reserve(vertices.size() + quads.size() / 2);
+                for (size_t i = 0; i + 1 < quads.size(); i += 2) {
+                    vertices.emplace_back(quads[i] + offset, quads[i + 1], color);
+                }
+            }
+        }
+
         TextureBrowserView::StringMap TextureBrowserView::collectStringVertices(Layout& layout, const float y, const float height) {
             Renderer::FontDescriptor defaultDescriptor(pref(Preferences::RendererFontPath()),
                                                        static_cast<size_t>(pref(Preferences::BrowserFontSize)));
@@ -491,23 +557,19 @@ namespace TrenchBroom {
                                 const auto& textureName = cellData(cell).mainTitle;
                                 const auto& groupName   = cellData(cell).subTitle;
 
-                                const auto textureNameQuads = textureFont.quads(textureName, false, textureNameOffset);
-                                const auto groupNameQuads   = groupFont.quads(groupName, false, groupNameOffset);
-
-                                const auto textureNameVertices = TextVertex::toList(
-                                    textureNameQuads.size() / 2,
-                                    kdl::skip_iterator(std::begin(textureNameQuads), std::end(textureNameQuads), 0, 2),
-                                    kdl::skip_iterator(std::begin(textureNameQuads), std::end(textureNameQuads), 1, 2),
-                                    kdl::skip_iterator(std::begin(textColor), std::end(textColor), 0, 0));
-
-                                const auto groupNameVertices = TextVertex::toList(
-                                    groupNameQuads.size() / 2,
-                                    kdl::skip_iterator(std::begin(groupNameQuads), std::end(groupNameQuads), 0, 2),
-                                    kdl::skip_iterator(std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2),
-                                    kdl::skip_iterator(std::begin(subTextColor), std::end(subTextColor), 0, 0));
-
-                                kdl::vec_append(stringVertices[cellData(cell).mainTitleFont], textureNameVertices);
-                                kdl::vec_append(stringVertices[cellData(cell).subTitleFont], groupNameVertices);
+                                // the quads are laid out once at offset zero and then moved to the rounded offset, which
+                                // yields the same vertices as laying them out at the offset
+                                auto& textureNameQuads = cellData(cell).mainTitleQuads;
+                                if (textureNameQuads.empty()) {
+                                    textureNameQuads = textureFont.quads(textureName, false, vm::vec2f::zero());
+                                }
+                                auto& groupNameQuads = cellData(cell).subTitleQuads;
+                                if (groupNameQuads.empty()) {
+                                    groupNameQuads = groupFont.quads(groupName, false, vm::vec2f::zero());
+                                }
+
+                                appendStringVertices(stringVertices[cellData(cell).mainTitleFont], textureNameQuads, vm::round(textureNameOffset), textColor.front());
+                                appendStringVertices(stringVertices[cellData(cell).subTitleFont], groupNameQuads, vm::round(groupNameOffset), subTextColor.front());
                             }
                         }
                     }
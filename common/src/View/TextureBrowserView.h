@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,12 @@ namespace TrenchBroom {
             vm::vec2f subTitleOffset;
             Renderer::FontDescriptor mainTitleFont;
             Renderer::FontDescriptor subTitleFont;
+
+            /**
+             * The glyph quads of the titles at offset zero, computed when the cell is first rendered.
+             */
+            mutable std::vector<vm::vec2f> mainTitleQuads;
+            mutable std::vector<vm::vec2f> subTitleQuads;
         };
 
         enum class TextureSortOrder {
@@ -70,6 +77,24 @@ namespace TrenchBroom {
             std::string m_filterText;
 
             Assets::Texture* m_selectedTexture;
+
+            /**
+             * The font and size of a title, which are expensive to determine because selecting a font size that fits
+             * the cell measures the title several times.
+             */
+            struct TitleLayout {
+                Renderer::FontDescriptor font;
+                vm::vec2f size;
+            };
+
+            /**
+             * The title layouts of the texture names shown in the last layout, which are reused when the layout is
+             * reloaded, e.g. after changing the filter text or the sort order. They are only valid for the given base
+             * font and cell width.
+             */
+            std::map<std::string, TitleLayout> m_textureTitles;
+            std::optional<Renderer::FontDescriptor> m_textureTitleFont;
+            float m_textureTitleCellWidth;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
                                GLContextManager& contextManager,
@@ -88,7 +113,8 @@ namespace TrenchBroom {
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
-            void addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font);
+            void addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font, const TitleLayout& textureTitle, const TitleLayout& groupTitle);
+            TitleLayout measureTitle(const std::string& title, const Renderer::FontDescriptor& font, float maxCellWidth);
 
             struct CompareByUsageCount;
             struct CompareByName;
@@ -20,6 +20,7 @@
 #include "ToolBox.h"
 
 #include "Ensure.h"
+#include "Profiler.h"
 #include "View/InputState.h"
 #include "View/Tool.h"
 #include "View/ToolController.h"
@@ -46,6 +47,8 @@ namespace TrenchBroom {
         }
 
         void ToolBox::pick(ToolChain* chain, const InputState& inputState, Model::PickResult& pickResult) {
+            TB_PROFILE_ZONE("ToolBox::pick");
+
             chain->pick(inputState, pickResult);
         }
 
@@ -99,6 +102,8 @@ namespace TrenchBroom {
         }
 
         void ToolBox::mouseDown(ToolChain* chain, const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::mouseDown");
+
             if (!m_enabled) {
                 return;
             }
@@ -106,6 +111,8 @@ namespace TrenchBroom {
         }
 
         void ToolBox::mouseUp(ToolChain* chain, const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::mouseUp");
+
             if (!m_enabled) {
                 return;
             }
@@ -113,6 +120,8 @@ namespace TrenchBroom {
         }
 
         bool ToolBox::mouseClick(ToolChain* chain, const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::mouseClick");
+
             if (!m_enabled) {
                 return false;
             }
@@ -127,6 +136,8 @@ namespace TrenchBroom {
         }
 
         void ToolBox::mouseMove(ToolChain* chain, const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::mouseMove");
+
             if (!m_enabled) {
                 return;
             }
@@ -138,6 +149,8 @@ namespace TrenchBroom {
         }
 
         bool ToolBox::startMouseDrag(ToolChain* chain, const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::startMouseDrag");
+
             if (!m_enabled) {
                 return false;
             }
@@ -146,11 +159,15 @@ namespace TrenchBroom {
         }
 
         bool ToolBox::mouseDrag(const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::mouseDrag");
+
             assert(enabled() && dragging());
             return m_dragReceiver->mouseDrag(inputState);
         }
 
         void ToolBox::endMouseDrag(const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::endMouseDrag");
+
             assert(enabled() && dragging());
             m_dragReceiver->endMouseDrag(inputState);
             m_dragReceiver = nullptr;
@@ -163,6 +180,8 @@ namespace TrenchBroom {
         }
 
         void ToolBox::mouseScroll(ToolChain* chain, const InputState& inputState) {
+            TB_PROFILE_ZONE("ToolBox::mouseScroll");
+
             if (!m_enabled) {
                 return;
             }
@@ -34,6 +34,7 @@ namespace TrenchBroom {
         ToolBoxConnector::ToolBoxConnector() :
         m_toolBox(nullptr),
         m_toolChain(new ToolChain()),
+        m_pickCacheValid(false),
         m_lastMouseX(0),
         m_lastMouseY(0),
         m_ignoreNextDrag(false) {}
@@ -51,12 +52,30 @@ namespace TrenchBroom {
         }
 
         void ToolBoxConnector::updatePickResult() {
+            invalidatePickCache();
+            refreshPickResult();
+        }
+
+        void ToolBoxConnector::invalidatePickCache() {
+            m_pickCacheValid = false;
+        }
+
+        void ToolBoxConnector::refreshPickResult() {
             ensure(m_toolBox != nullptr, "toolBox is null");
 
             m_inputState.setPickRequest(doGetPickRequest(m_inputState.mouseX(),  m_inputState.mouseY()));
-            Model::PickResult pickResult = doPick(m_inputState.pickRay());
-            m_toolBox->pick(m_toolChain, m_inputState, pickResult);
-            m_inputState.setPickResult(std::move(pickResult));
+
+            const auto& pickRay = m_inputState.pickRay();
+            if (!m_pickCacheValid || pickRay.origin != m_cachedPickRay.origin || pickRay.direction != m_cachedPickRay.direction) {
+                doPick(pickRay, m_cachedPickResult);
+                m_cachedPickRay = pickRay;
+                m_pickCacheValid = true;
+            }
+
+            // the tools' hits depend on their state, so they are always picked anew
+            m_previousPickResult = m_cachedPickResult;
+            m_toolBox->pick(m_toolChain, m_inputState, m_previousPickResult);
+            m_inputState.swapPickResult(m_previousPickResult);
         }
 
         void ToolBoxConnector::setToolBox(ToolBox& toolBox) {
@@ -72,7 +91,7 @@ namespace TrenchBroom {
             ensure(m_toolBox != nullptr, "toolBox is null");
 
             mouseMoved(x, y);
-            updatePickResult();
+            refreshPickResult();
 
             return m_toolBox->dragEnter(m_toolChain, m_inputState, text);
         }
@@ -81,7 +100,7 @@ namespace TrenchBroom {
             ensure(m_toolBox != nullptr, "toolBox is null");
 
             mouseMoved(x, y);
-            updatePickResult();
+            refreshPickResult();
 
             return m_toolBox->dragMove(m_toolChain, m_inputState, text);
         }
@@ -95,7 +114,7 @@ namespace TrenchBroom {
         bool ToolBoxConnector::dragDrop(const int /* x */, const int /* y */, const std::string& text) {
             ensure(m_toolBox != nullptr, "toolBox is null");
 
-            updatePickResult();
+            refreshPickResult();
 
             return m_toolBox->dragDrop(m_toolChain, m_inputState, text);
         }
@@ -153,7 +172,7 @@ namespace TrenchBroom {
         bool ToolBoxConnector::clearModifierKeys() {
             if (m_inputState.modifierKeys() != ModifierKeys::MKNone) {
                 m_inputState.setModifierKeys(ModifierKeys::MKNone);
-                updatePickResult();
+                refreshPickResult();
                 m_toolBox->modifierKeyChange(m_toolChain, m_inputState);
                 return true;
             } else {
@@ -163,7 +182,7 @@ namespace TrenchBroom {
 
         void ToolBoxConnector::updateModifierKeys() {
             if (setModifierKeys()) {
-                updatePickResult();
+                refreshPickResult();
                 m_toolBox->modifierKeyChange(m_toolChain, m_inputState);
             }
         }
@@ -220,7 +239,7 @@ namespace TrenchBroom {
             m_inputState.mouseDown(mouseButton(event));
             m_toolBox->mouseDown(m_toolChain, m_inputState);
 
-            updatePickResult();
+            refreshPickResult();
             m_ignoreNextDrag = false;
         }
 
@@ -229,7 +248,7 @@ namespace TrenchBroom {
             m_toolBox->mouseUp(m_toolChain, m_inputState);
             m_inputState.mouseUp(mouseButton(event));
 
-            updatePickResult();
+            refreshPickResult();
             m_ignoreNextDrag = false;
         }
 
@@ -239,7 +258,7 @@ namespace TrenchBroom {
                 // We miss mouse events when a popup menu is already open, so we must make sure that the input
                 // state is up to date.
                 mouseMoved(event.posX, event.posY);
-                updatePickResult();
+                refreshPickResult();
                 showPopupMenu();
             }
         }
@@ -249,12 +268,12 @@ namespace TrenchBroom {
             m_inputState.mouseDown(mouseButton(event));
             m_toolBox->mouseDoubleClick(m_toolChain, m_inputState);
             m_inputState.mouseUp(mouseButton(event));
-            updatePickResult();
+            refreshPickResult();
         }
 
         void ToolBoxConnector::processMouseMotion(const MouseEvent& event) {
             mouseMoved(event.posX, event.posY);
-            updatePickResult();
+            refreshPickResult();
             m_toolBox->mouseMove(m_toolChain, m_inputState);
         }
 
@@ -267,7 +286,7 @@ namespace TrenchBroom {
             }
             m_toolBox->mouseScroll(m_toolChain, m_inputState);
 
-            updatePickResult();
+            refreshPickResult();
         }
 
         void ToolBoxConnector::processDragStart(const MouseEvent& event) {
@@ -276,7 +295,7 @@ namespace TrenchBroom {
             // what was under the pixel they clicked.
             // See: https://github.com/kduske/TrenchBroom/issues/2808
             mouseMoved(event.posX, event.posY);
-            updatePickResult();
+            refreshPickResult();
 
             if (m_toolBox->startMouseDrag(m_toolChain, m_inputState)) {
                 m_inputState.setAnyToolDragging(true);
@@ -285,7 +304,7 @@ namespace TrenchBroom {
 
         void ToolBoxConnector::processDrag(const MouseEvent& event) {
             mouseMoved(event.posX, event.posY);
-            updatePickResult();
+            refreshPickResult();
             if (m_toolBox->dragging()) {
                 if (!m_toolBox->mouseDrag(m_inputState)) {
                         processDragEnd(event);
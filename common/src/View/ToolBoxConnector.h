@@ -48,6 +48,20 @@ namespace TrenchBroom {
             ToolChain* m_toolChain;
 
             InputState m_inputState;
+            /**
+             * The pick result that was replaced by the most recent pick. It is refilled by the next pick and then
+             * swapped into the input state, so that picking on every mouse move does not reallocate the hits.
+             */
+            Model::PickResult m_previousPickResult;
+
+            /**
+             * The hits of the most recent document pick, without any tool hits, and the ray they were picked with.
+             * Events that don't change the pick ray, such as key presses and mouse button events, reuse these hits
+             * instead of picking the document again.
+             */
+            Model::PickResult m_cachedPickResult;
+            vm::ray3 m_cachedPickRay;
+            bool m_pickCacheValid;
 
             int m_lastMouseX;
             int m_lastMouseY;
@@ -60,7 +74,18 @@ namespace TrenchBroom {
             const vm::ray3& pickRay() const;
             const Model::PickResult& pickResult() const;
 
+            /**
+             * Picks the document and the tools anew. Call this whenever the document has changed in a way that may
+             * affect the pick result.
+             */
             void updatePickResult();
+        protected:
+            /**
+             * Discards the cached document pick so that the next pick result update picks the document again.
+             */
+            void invalidatePickCache();
+        private:
+            void refreshPickResult();
         protected:
             void setToolBox(ToolBox& toolBox);
             void addTool(ToolController* tool);
@@ -103,7 +128,11 @@ namespace TrenchBroom {
             bool cancelDrag();
         private:
             virtual PickRequest doGetPickRequest(int x, int y) const = 0;
-            virtual Model::PickResult doPick(const vm::ray3& pickRay) const = 0;
+            /**
+             * Picks the objects hit by the given ray. The given pick result holds the result of an earlier pick. It
+             * must be reset before it is filled so that its storage can be reused.
+             */
+            virtual void doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const = 0;
             virtual void doShowPopupMenu();
         };
     }
@@ -20,14 +20,36 @@
 #include "TransformObjectsCommand.h"
 
 #include "FloatType.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/NodeCollection.h"
+#include "Model/Snapshot.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include <kdl/vector_utils.h>
+
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/util.h>
+#include <vecmath/vec.h>
+
+#include <iterator>
 
 namespace TrenchBroom {
     namespace View {
+        namespace {
+            bool hasIntegerPlanePoints(const Model::Brush* brush) {
+                for (const auto* face : brush->faces()) {
+                    for (const auto& point : face->points()) {
+                        if (!vm::is_integral(point, 0.0)) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+        }
+
         const Command::CommandType TransformObjectsCommand::Type = Command::freeType();
 
         std::unique_ptr<TransformObjectsCommand> TransformObjectsCommand::translate(const vm::vec3& delta, const bool lockTextures) {
@@ -66,11 +88,25 @@ namespace TrenchBroom {
         m_transform(transform),
         m_lockTextures(lockTextures) {}
 
+        TransformObjectsCommand::~TransformObjectsCommand() = default;
+
         std::unique_ptr<CommandResult> TransformObjectsCommand::doPerformDo(MapDocumentCommandFacade* document) {
             const bool success = document->performTransform(m_transform, m_lockTextures);
             return std::make_unique<CommandResult>(success);
         }
 
+        std::unique_ptr<CommandResult> TransformObjectsCommand::doPerformUndo(MapDocumentCommandFacade* document) {
+            auto result = SnapshotCommand::doPerformUndo(document);
+            if (result->success() && !m_translatedBrushes.empty()) {
+                // m_transform is a pure integer translation, so its inverse is built directly to make it exact
+                const auto inverseTransform = vm::translation_matrix(-(m_transform * vm::vec3::zero()));
+                document->restoreTransformedBrushes(m_translatedBrushes, inverseTransform, m_brushFaceSnapshot.get());
+            }
+            m_translatedBrushes.clear();
+            m_brushFaceSnapshot.reset();
+            return result;
+        }
+
         bool TransformObjectsCommand::doIsRepeatable(MapDocumentCommandFacade* document) const {
             return document->hasSelectedNodes();
         }
@@ -85,10 +121,53 @@ namespace TrenchBroom {
                 return false;
             } else if (other->m_action != m_action) {
                 return false;
+            } else if (!m_translatedBrushes.empty() && !other->isIntegerTranslation()) {
+                // the translated brushes could not be restored exactly anymore
+                return false;
             } else {
-                m_transform = m_transform * other->m_transform;
+                m_transform = other->m_transform * m_transform;
                 return true;
             }
         }
+
+        bool TransformObjectsCommand::isIntegerTranslation() const {
+            return m_action == Action::Translate && vm::is_integral(m_transform * vm::vec3::zero(), 0.0);
+        }
+
+        std::unique_ptr<Model::Snapshot> TransformObjectsCommand::doTakeSnapshot(MapDocumentCommandFacade* document) {
+            m_translatedBrushes.clear();
+            m_brushFaceSnapshot.reset();
+
+            const auto& selectedNodes = document->selectedNodes();
+            if (!isIntegerTranslation() || !selectedNodes.hasBrushes()) {
+                return SnapshotCommand::doTakeSnapshot(document);
+            }
+
+            std::vector<Model::Node*> snapshotNodes;
+            snapshotNodes.reserve(selectedNodes.nodeCount());
+            kdl::vec_append(snapshotNodes, selectedNodes.groups());
+            kdl::vec_append(snapshotNodes, selectedNodes.entities());
+
+            std::vector<Model::BrushFace*> translatedFaces;
+            for (auto* brush : selectedNodes.brushes()) {
+                if (hasIntegerPlanePoints(brush)) {
+                    m_translatedBrushes.push_back(brush);
+                    kdl::vec_append(translatedFaces, brush->faces());
+                } else {
+                    snapshotNodes.push_back(brush);
+                }
+            }
+
+            m_brushFaceSnapshot = std::make_unique<Model::Snapshot>(std::begin(translatedFaces), std::end(translatedFaces));
+            return std::make_unique<Model::Snapshot>(std::begin(snapshotNodes), std::end(snapshotNodes));
+        }
+
+        size_t TransformObjectsCommand::doGetMemoryUsage() const {
+            size_t result = SnapshotCommand::doGetMemoryUsage() + m_translatedBrushes.capacity() * sizeof(Model::Brush*);
+            if (m_brushFaceSnapshot != nullptr) {
+                result += m_brushFaceSnapshot->memoryUsage();
+            }
+            return result;
+        }
     }
 }
@@ -27,9 +27,16 @@
 #include <vecmath/mat.h>
 #include <vecmath/util.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
+    namespace Model {
+        class Brush;
+        class Snapshot;
+    }
+
     namespace View {
         class TransformObjectsCommand : public SnapshotCommand {
         public:
@@ -46,6 +53,14 @@ namespace TrenchBroom {
             Action m_action;
             vm::mat4x4 m_transform;
             bool m_lockTextures;
+
+            /**
+             * Brushes with integer plane points that are moved by an integer offset are not snapshotted. Instead, they
+             * are restored by applying the inverse translation, which is exact for them, and only the texturing of their
+             * faces is stored in m_brushFaceSnapshot.
+             */
+            std::vector<Model::Brush*> m_translatedBrushes;
+            std::unique_ptr<Model::Snapshot> m_brushFaceSnapshot;
         public:
             static std::unique_ptr<TransformObjectsCommand> translate(const vm::vec3& delta, bool lockTextures);
             static std::unique_ptr<TransformObjectsCommand> rotate(const vm::vec3& center, const vm::vec3& axis, FloatType angle, bool lockTextures);
@@ -55,12 +70,19 @@ namespace TrenchBroom {
             static std::unique_ptr<TransformObjectsCommand> flip(const vm::vec3& center, vm::axis::type axis, bool lockTextures);
 
             TransformObjectsCommand(Action action, const std::string& name, const vm::mat4x4& transform, bool lockTextures);
+            ~TransformObjectsCommand() override;
+
             std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade* document) override;
+            std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
 
             bool doIsRepeatable(MapDocumentCommandFacade* document) const override;
             std::unique_ptr<UndoableCommand> doRepeat(MapDocumentCommandFacade* document) const override;
 
             bool doCollateWith(UndoableCommand* command) override;
+        private:
+            bool isIntegerTranslation() const;
+            std::unique_ptr<Model::Snapshot> doTakeSnapshot(MapDocumentCommandFacade* document) override;
+            size_t doGetMemoryUsage() const override;
 
             deleteCopyAndMove(TransformObjectsCommand)
         };
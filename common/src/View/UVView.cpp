@@ -122,6 +122,7 @@ namespace TrenchBroom {
             } else {
                 m_helper.setFace(faces.back());
             }
+            invalidatePickCache();
 
             if (m_helper.valid()) {
                 m_toolBox.enable();
@@ -129,20 +130,27 @@ namespace TrenchBroom {
                 m_toolBox.disable();
             }
 
+            invalidateGeometry();
             update();
         }
 
         void UVView::documentWasCleared(MapDocument*) {
             m_helper.setFace(nullptr);
             m_toolBox.disable();
+            invalidatePickCache();
+            invalidateGeometry();
             update();
         }
 
         void UVView::nodesDidChange(const std::vector<Model::Node*>&) {
+            invalidatePickCache();
+            invalidateGeometry();
             update();
         }
 
         void UVView::brushFacesDidChange(const std::vector<Model::BrushFace*>&) {
+            invalidatePickCache();
+            invalidateGeometry();
             update();
         }
 
@@ -155,12 +163,65 @@ namespace TrenchBroom {
         }
 
         void UVView::cameraDidChange(const Renderer::Camera*) {
+            // the face outline does not depend on the camera
+            m_textureVertices.clear();
             update();
         }
 
+        void UVView::invalidateGeometry() {
+            m_textureVertices.clear();
+            m_faceVertices.clear();
+        }
+
+        const std::vector<UVView::TextureVertex>& UVView::textureVertices() {
+            assert(m_helper.valid());
+
+            if (m_textureVertices.empty()) {
+                const auto* face = m_helper.face();
+                const auto normal = vm::vec3f(face->boundary().normal);
+
+                const auto& v = m_camera.zoomedViewport();
+                const auto w2 = static_cast<float>(v.width) / 2.0f;
+                const auto h2 = static_cast<float>(v.height) / 2.0f;
+
+                const auto& p = m_camera.position();
+                const auto& r = m_camera.right();
+                const auto& u = m_camera.up();
+
+                const auto pos1 = -w2 * r +h2 * u + p;
+                const auto pos2 = +w2 * r +h2 * u + p;
+                const auto pos3 = +w2 * r -h2 * u + p;
+                const auto pos4 = -w2 * r -h2 * u + p;
+
+                m_textureVertices = {
+                    TextureVertex(pos1, normal, face->textureCoords(vm::vec3(pos1))),
+                    TextureVertex(pos2, normal, face->textureCoords(vm::vec3(pos2))),
+                    TextureVertex(pos3, normal, face->textureCoords(vm::vec3(pos3))),
+                    TextureVertex(pos4, normal, face->textureCoords(vm::vec3(pos4)))
+                };
+            }
+            return m_textureVertices;
+        }
+
+        const std::vector<UVView::EdgeVertex>& UVView::faceVertices() {
+            assert(m_helper.valid());
+
+            if (m_faceVertices.empty()) {
+                const auto* face = m_helper.face();
+                const auto vertices = face->vertices();
+                m_faceVertices.reserve(vertices.size());
+
+                for (const auto* vertex : vertices) {
+                    m_faceVertices.push_back(EdgeVertex(vm::vec3f(vertex->position())));
+                }
+            }
+            return m_faceVertices;
+        }
+
         void UVView::doUpdateViewport(int x, int y, int width, int height) {
             if (m_camera.setViewport(Renderer::Camera::Viewport(x, y, width, height))) {
                 m_helper.cameraViewportChanged();
+                m_textureVertices.clear();
             }
         }
 
@@ -205,40 +266,12 @@ namespace TrenchBroom {
 
         class UVView::RenderTexture : public Renderer::DirectRenderable {
         private:
-            using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
-
             const UVViewHelper& m_helper;
             Renderer::VertexArray m_vertexArray;
         public:
-            RenderTexture(const UVViewHelper& helper) :
+            RenderTexture(const UVViewHelper& helper, const std::vector<TextureVertex>& vertices) :
             m_helper(helper),
-            m_vertexArray(Renderer::VertexArray::move(getVertices())) {}
-        private:
-            std::vector<Vertex> getVertices() const {
-                const auto* face = m_helper.face();
-                const auto normal = vm::vec3f(face->boundary().normal);
-
-                const auto& camera = m_helper.camera();
-                const auto& v = camera.zoomedViewport();
-                const auto w2 = static_cast<float>(v.width) / 2.0f;
-                const auto h2 = static_cast<float>(v.height) / 2.0f;
-
-                const auto& p = camera.position();
-                const auto& r = camera.right();
-                const auto& u = camera.up();
-
-                const auto pos1 = -w2 * r +h2 * u + p;
-                const auto pos2 = +w2 * r +h2 * u + p;
-                const auto pos3 = +w2 * r -h2 * u + p;
-                const auto pos4 = -w2 * r -h2 * u + p;
-
-                return {
-                    Vertex(pos1, normal, face->textureCoords(vm::vec3(pos1))),
-                    Vertex(pos2, normal, face->textureCoords(vm::vec3(pos2))),
-                    Vertex(pos3, normal, face->textureCoords(vm::vec3(pos3))),
-                    Vertex(pos4, normal, face->textureCoords(vm::vec3(pos4)))
-                };
-            }
+            m_vertexArray(Renderer::VertexArray::ref(vertices)) {}
         private:
             void doPrepareVertices(Renderer::VboManager& vboManager) override {
                 m_vertexArray.prepare(vboManager);
@@ -280,26 +313,16 @@ namespace TrenchBroom {
             if (texture == nullptr)
                 return;
 
-            renderBatch.addOneShot(new RenderTexture(m_helper));
+            // the cached vertices remain unchanged until the batch has been rendered
+            renderBatch.addOneShot(new RenderTexture(m_helper, textureVertices()));
         }
 
         void UVView::renderFace(Renderer::RenderContext&, Renderer::RenderBatch& renderBatch) {
             assert(m_helper.valid());
 
-            const auto* face = m_helper.face();
-            const auto faceVertices = face->vertices();
-
-            using Vertex = Renderer::GLVertexTypes::P3::Vertex;
-            std::vector<Vertex> edgeVertices;
-            edgeVertices.reserve(faceVertices.size());
-
-            for (const auto* vertex : faceVertices) {
-                edgeVertices.push_back(Vertex(vm::vec3f(vertex->position())));
-            }
-
             const Color edgeColor(1.0f, 1.0f, 1.0f, 1.0f); // TODO: make this a preference
 
-            Renderer::DirectEdgeRenderer edgeRenderer(Renderer::VertexArray::move(std::move(edgeVertices)), Renderer::PrimType::LineLoop);
+            Renderer::DirectEdgeRenderer edgeRenderer(Renderer::VertexArray::ref(faceVertices()), Renderer::PrimType::LineLoop);
             edgeRenderer.renderOnTop(renderBatch, edgeColor, 2.5f);
         }
 
@@ -345,10 +368,10 @@ namespace TrenchBroom {
             return PickRequest(vm::ray3(m_camera.pickRay(x, y)), m_camera);
         }
 
-        Model::PickResult UVView::doPick(const vm::ray3& pickRay) const {
-            Model::PickResult pickResult = Model::PickResult::byDistance(kdl::mem_lock(m_document)->editorContext());
+        void UVView::doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
+            pickResult.resetByDistance(kdl::mem_lock(m_document)->editorContext());
             if (!m_helper.valid())
-                return pickResult;
+                return;
 
             Model::BrushFace* face = m_helper.face();
             const FloatType distance = face->intersectWithRay(pickRay);
@@ -356,7 +379,6 @@ namespace TrenchBroom {
                 const vm::vec3 hitPoint = vm::point_at_distance(pickRay, distance);
                 pickResult.addHit(Model::Hit(UVView::FaceHit, distance, hitPoint, face));
             }
-            return pickResult;
         }
     }
 }
@@ -23,6 +23,7 @@
 #include "FloatType.h"
 #include "Model/HitType.h"
 #include "Model/PickResult.h"
+#include "Renderer/GLVertexType.h"
 #include "Renderer/OrthographicCamera.h"
 #include "View/RenderView.h"
 #include "View/ToolBox.h"
@@ -69,12 +70,23 @@ namespace TrenchBroom {
         public:
             static const Model::HitType::Type FaceHit;
         private:
+            using TextureVertex = Renderer::GLVertexTypes::P3NT2::Vertex;
+            using EdgeVertex = Renderer::GLVertexTypes::P3::Vertex;
+
             std::weak_ptr<MapDocument> m_document;
 
             Renderer::OrthographicCamera m_camera;
             UVViewHelper m_helper;
 
             ToolBox m_toolBox;
+
+            /**
+             * The geometry of the texture quad and of the face outline is cached between frames. The texture quad
+             * depends on the face and on the camera, while the face outline only depends on the face. An empty vector
+             * indicates that the geometry must be rebuilt.
+             */
+            std::vector<TextureVertex> m_textureVertices;
+            std::vector<EdgeVertex> m_faceVertices;
         public:
             UVView(std::weak_ptr<MapDocument> document, GLContextManager& contextManager);
             ~UVView() override;
@@ -94,6 +106,10 @@ namespace TrenchBroom {
             void cameraDidChange(const Renderer::Camera* camera);
             void preferenceDidChange(const IO::Path& path);
 
+            void invalidateGeometry();
+            const std::vector<TextureVertex>& textureVertices();
+            const std::vector<EdgeVertex>& faceVertices();
+
             void doUpdateViewport(int x, int y, int width, int height) override;
             void doRender() override;
             bool doShouldRenderFocusIndicator() const override;
@@ -112,7 +128,7 @@ namespace TrenchBroom {
             void processEvent(const CancelEvent& event) override;
         private:
             PickRequest doGetPickRequest(int x, int y) const override;
-            Model::PickResult doPick(const vm::ray3& pickRay) const override;
+            void doPick(const vm::ray3& pickRay, Model::PickResult& pickResult) const override;
         };
     }
 }
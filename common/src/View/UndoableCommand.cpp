@@ -26,7 +26,8 @@
 namespace TrenchBroom {
     namespace View {
         UndoableCommand::UndoableCommand(const CommandType type, const std::string& name) :
-        Command(type, name) {}
+        Command(type, name),
+        m_willBeCollated(false) {}
 
         UndoableCommand::~UndoableCommand() {}
 
@@ -60,6 +61,25 @@ namespace TrenchBroom {
             return doCollateWith(command);
         }
 
+        bool UndoableCommand::willCollateWith(const UndoableCommand& command) const {
+            assert(&command != this);
+            if (command.type() != m_type)
+                return false;
+            return doWillCollateWith(command);
+        }
+
+        void UndoableCommand::setWillBeCollated() {
+            m_willBeCollated = true;
+        }
+
+        bool UndoableCommand::willBeCollated() const {
+            return m_willBeCollated;
+        }
+
+        size_t UndoableCommand::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
+
         bool UndoableCommand::doIsRepeatDelimiter() const {
             return false;
         }
@@ -68,6 +88,14 @@ namespace TrenchBroom {
             throw CommandProcessorException("Command is not repeatable");
         }
 
+        bool UndoableCommand::doWillCollateWith(const UndoableCommand&) const {
+            return false;
+        }
+
+        size_t UndoableCommand::doGetMemoryUsage() const {
+            return 0u;
+        }
+
         size_t UndoableCommand::documentModificationCount() const {
             throw CommandProcessorException("Command does not modify the document");
         }
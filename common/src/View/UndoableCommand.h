@@ -23,6 +23,7 @@
 #include "Macros.h"
 #include "View/Command.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -31,6 +32,8 @@ namespace TrenchBroom {
         class MapDocumentCommandFacade;
 
         class UndoableCommand : public Command {
+        private:
+            bool m_willBeCollated;
         protected:
             UndoableCommand(CommandType type, const std::string& name);
         public:
@@ -43,6 +46,25 @@ namespace TrenchBroom {
             std::unique_ptr<UndoableCommand> repeat(MapDocumentCommandFacade* document) const;
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns true if this command is certain to collate with the given command once the given command has
+             * been executed. This is checked before the given command is executed.
+             */
+            bool willCollateWith(const UndoableCommand& command) const;
+
+            /**
+             * Marks this command as one that will be collated with its predecessor after it has been executed. Such a
+             * command will never be undone on its own, so it need not record how to undo itself, e.g. in a snapshot.
+             */
+            void setWillBeCollated();
+            bool willBeCollated() const;
+
+            /**
+             * Returns an estimate of the number of bytes this command holds in order to be undone, e.g. for snapshots.
+             * The command object itself is not accounted for.
+             */
+            size_t memoryUsage() const;
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
@@ -51,6 +73,9 @@ namespace TrenchBroom {
             virtual std::unique_ptr<UndoableCommand> doRepeat(MapDocumentCommandFacade* document) const;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
+            virtual bool doWillCollateWith(const UndoableCommand& command) const;
+
+            virtual size_t doGetMemoryUsage() const;
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
 
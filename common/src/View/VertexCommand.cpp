@@ -134,7 +134,10 @@ namespace TrenchBroom {
                     return doCreateCommandResult(false);
                 }
 
-                takeSnapshot();
+                // a command that is collated with its predecessor is never undone, so its snapshot would be discarded
+                if (!willBeCollated()) {
+                    takeSnapshot();
+                }
                 const auto success = doVertexOperation(document);
                 return doCreateCommandResult(success);
             }
@@ -157,6 +160,10 @@ namespace TrenchBroom {
             return false;
         }
 
+        size_t VertexCommand::doGetMemoryUsage() const {
+            return m_snapshot != nullptr ? m_snapshot->memoryUsage() : 0u;
+        }
+
         void VertexCommand::takeSnapshot() {
             assert(m_snapshot == nullptr);
             m_snapshot = std::make_unique<Model::Snapshot>(std::begin(m_brushes), std::end(m_brushes));
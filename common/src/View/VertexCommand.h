@@ -94,6 +94,7 @@ namespace TrenchBroom {
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
             void restoreAndTakeNewSnapshot(MapDocumentCommandFacade* document);
             bool doIsRepeatable(MapDocumentCommandFacade* document) const override;
+            size_t doGetMemoryUsage() const override;
         private:
             void takeSnapshot();
             void deleteSnapshot();
@@ -38,15 +38,15 @@ namespace TrenchBroom {
         const Model::HitType::Type VertexHandleManager::HandleHit = Model::HitType::freeType();
 
         void VertexHandleManager::pick(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
-                const auto distance = camera.pickPointHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickableHandle(pickRay, camera, handleRadius, [&](const vm::vec3& position) {
+                const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(distance)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, distance);
                     const auto error = vm::squared_distance(pickRay, position).distance;
                     pickResult.addHit(Model::Hit::hit(HandleHit, distance, hitPoint, position, error));
                 }
-            }
+            });
         }
 
         void VertexHandleManager::addHandles(const Model::Brush* brush) {
@@ -87,16 +87,16 @@ namespace TrenchBroom {
         }
 
         void EdgeHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickableHandle(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
                 const vm::vec3 pointHandle = position.center();
 
-                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHit, pointDist, hitPoint, position));
                 }
-            }
+            });
         }
 
         void EdgeHandleManager::addHandles(const Model::Brush* brush) {
@@ -144,16 +144,16 @@ namespace TrenchBroom {
         }
 
         void FaceHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const auto& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickableHandle(pickRay, camera, handleRadius, [&](const vm::polygon3& position) {
                 const auto pointHandle = position.center();
 
-                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHit, pointDist, hitPoint, position));
                 }
-            }
+            });
         }
 
         void FaceHandleManager::addHandles(const Model::Brush* brush) {
@@ -21,6 +21,8 @@
 #define VertexHandleManager_h
 
 #include "FloatType.h"
+#include "Macros.h"
+#include "ProjectedGrid.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/HitType.h"
@@ -29,8 +31,15 @@
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/polygon.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
 #include <vecmath/segment.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <map>
 #include <vector>
@@ -107,9 +116,15 @@ namespace TrenchBroom {
                 size_t count;
                 bool selected;
 
+                /**
+                 * The index of this handle in the list of selected handles, only valid if this handle is selected.
+                 */
+                size_t selectionIndex;
+
                 HandleInfo() :
                 count(0),
-                selected(false) {}
+                selected(false),
+                selectionIndex(0) {}
 
                 /**
                  * Sets this handle to selected.
@@ -167,14 +182,23 @@ namespace TrenchBroom {
             HandleMap m_handles;
 
             /**
-             * The total number of selected handles, not counting duplicates.
+             * Indexes the entries of m_handles by the handle positions so that the handles near a point or within a
+             * lasso can be found quickly. The entries of a map remain valid until they are erased.
+             */
+            ProjectedGrid<HandleEntry*> m_grid;
+
+            /**
+             * The entries of all selected handles in no particular order, so that selection queries do not need to
+             * look at every handle.
              */
-            size_t m_selectedHandleCount;
+            std::vector<HandleEntry*> m_selectedHandles;
         public:
-            VertexHandleManagerBaseT() :
-            m_selectedHandleCount(0) {}
+            VertexHandleManagerBaseT() = default;
 
             virtual ~VertexHandleManagerBaseT() {}
+
+            // the grid and the selected handles refer to the entries of m_handles
+            deleteCopy(VertexHandleManagerBaseT)
         public:
             /**
              * Returns the hit type value of the picking hits reported by this manager.
@@ -189,7 +213,7 @@ namespace TrenchBroom {
              * @return the total number of selected handles
              */
             size_t selectedHandleCount() const {
-                return m_selectedHandleCount;
+                return m_selectedHandles.size();
             }
 
             /**
@@ -230,7 +254,12 @@ namespace TrenchBroom {
             HandleList selectedHandles() const {
                 HandleList result;
                 result.reserve(selectedHandleCount());
-                collectHandles([](const HandleInfo& info) { return info.selected; }, std::back_inserter(result));
+                for (const HandleEntry* entry : m_selectedHandles) {
+                    result.push_back(entry->first);
+                }
+
+                // return the handles in the same order as the other queries
+                std::sort(std::begin(result), std::end(result), m_handles.key_comp());
                 return result;
             }
 
@@ -245,7 +274,71 @@ namespace TrenchBroom {
                 collectHandles([](const HandleInfo& info) { return !info.selected; }, std::back_inserter(result));
                 return result;
             }
+
+            /**
+             * Finds all handles whose positions, projected along the given axis, lie within the given bounds. The
+             * result may also contain some handles close to the bounds, so the caller must test the handles again.
+             * The position of an edge or face handle is its center.
+             *
+             * @tparam O the type of the output iterator
+             * @param axis the axis along which the handle positions are projected
+             * @param bounds the bounds, whose coordinates on the given axis are ignored
+             * @param out the output iterator to which the handles are written
+             */
+            template <typename O>
+            void findHandles(const size_t axis, const vm::bbox3& bounds, O out) const {
+                std::vector<HandleEntry*> entries;
+                m_grid.find(axis, bounds, std::back_inserter(entries));
+                for (const HandleEntry* entry : entries) {
+                    out++ = entry->first;
+                }
+            }
+        protected:
+            /**
+             * Calls the given function for each handle whose position may be hit by the given pick ray when it is
+             * picked as a point handle with the given radius, see Renderer::Camera::pickPointHandle. In an
+             * orthographic view that looks along a coordinate axis, only the handles near the pick ray are visited,
+             * and otherwise, all handles are visited.
+             *
+             * @tparam F the type of the function, must accept a handle
+             * @param pickRay the pick ray
+             * @param camera the camera
+             * @param handleRadius the handle radius
+             * @param fun the function to call
+             */
+            template <typename F>
+            void forEachPickableHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius, F fun) const {
+                const auto axis = vm::find_abs_max_component(pickRay.direction);
+                if (camera.orthographicProjection() && vm::is_equal(std::abs(pickRay.direction[axis]), FloatType(1.0), vm::C::almost_zero())) {
+                    // the perspective scaling factor does not depend on the position in an orthographic view
+                    const auto scaling = static_cast<FloatType>(camera.perspectiveScalingFactor(vm::vec3f(pickRay.origin)));
+                    const auto radius = FloatType(2.0) * handleRadius * scaling;
+                    const auto offset = vm::vec3(radius, radius, radius);
+
+                    std::vector<HandleEntry*> entries;
+                    m_grid.find(axis, vm::bbox3(pickRay.origin - offset, pickRay.origin + offset), std::back_inserter(entries));
+                    for (const HandleEntry* entry : entries) {
+                        fun(entry->first);
+                    }
+                } else {
+                    for (const HandleEntry& entry : m_handles) {
+                        fun(entry.first);
+                    }
+                }
+            }
         private:
+            static vm::vec3 position(const vm::vec3& handle) {
+                return handle;
+            }
+
+            static vm::vec3 position(const vm::segment3& handle) {
+                return handle.center();
+            }
+
+            static vm::vec3 position(const vm::polygon3& handle) {
+                return handle.center();
+            }
+
             template <typename T, typename O>
             void collectHandles(const T& test, O out) const {
                 for (const HandleEntry& entry : m_handles) {
@@ -303,7 +396,12 @@ namespace TrenchBroom {
              * @param handle the handle to add
              */
             void add(const Handle& handle) {
-                m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+                // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+                const auto [it, inserted] = m_handles.try_emplace(handle);
+                if (inserted) {
+                    m_grid.insert(position(it->first), &*it);
+                }
+                it->second.inc();
             }
 
             /**
@@ -319,7 +417,8 @@ namespace TrenchBroom {
                     info.dec();
 
                     if (info.count == 0) {
-                        deselect(info);
+                        deselect(*it);
+                        m_grid.remove(position(it->first), &*it);
                         m_handles.erase(it);
                     }
                     return true;
@@ -332,8 +431,9 @@ namespace TrenchBroom {
              * Removes all handles from this manager.
              */
             void clear() {
+                m_grid.clear();
+                m_selectedHandles.clear();
                 m_handles.clear();
-                m_selectedHandleCount = 0;
             }
 
             /**
@@ -358,7 +458,7 @@ namespace TrenchBroom {
              * @param handle the handle to select
              */
             void select(const Handle& handle) {
-                forEachCloseHandle(handle, [this](HandleInfo& info){ select(info); });
+                forEachCloseHandle(handle, [this](HandleEntry& entry){ select(entry); });
             }
 
             /**
@@ -383,16 +483,17 @@ namespace TrenchBroom {
              * @param handle the handle to deselect
              */
             void deselect(const Handle& handle) {
-                forEachCloseHandle(handle, [this](HandleInfo& info){ deselect(info); });
+                forEachCloseHandle(handle, [this](HandleEntry& entry){ deselect(entry); });
             }
 
             /**
              * Deselects all currently selected handles
              */
             void deselectAll() {
-                for (auto& entry : m_handles) {
-                    deselect(entry.second);
+                for (HandleEntry* entry : m_selectedHandles) {
+                    entry->second.deselect();
                 }
+                m_selectedHandles.clear();
             }
 
             /**
@@ -423,34 +524,41 @@ namespace TrenchBroom {
             template <typename F>
             void forEachCloseHandle(const H& handle, F fun) {
                 static const auto epsilon = 0.001 * 0.001;
-                for (auto& entry : m_handles) {
-                    if (compare(handle, entry.first, epsilon) == 0) {
-                        fun(entry.second);
+
+                // handles that are close to the given handle have close positions, so only look at the grid cells
+                // around the handle's position
+                const auto center = position(handle);
+                const auto offset = vm::vec3(0.001, 0.001, 0.001);
+
+                std::vector<HandleEntry*> entries;
+                m_grid.find(2, vm::bbox3(center - offset, center + offset), std::back_inserter(entries));
+                for (HandleEntry* entry : entries) {
+                    if (compare(handle, entry->first, epsilon) == 0) {
+                        fun(*entry);
                     }
                 }
             }
 
-            void select(HandleInfo& info) {
+            void select(HandleEntry& entry) {
+                HandleInfo& info = entry.second;
                 if (info.select()) {
                     assert(selectedHandleCount() < totalHandleCount());
-                    ++m_selectedHandleCount;
+                    info.selectionIndex = m_selectedHandles.size();
+                    m_selectedHandles.push_back(&entry);
                 }
             }
 
-            void deselect(HandleInfo& info) {
+            void deselect(HandleEntry& entry) {
+                HandleInfo& info = entry.second;
                 if (info.deselect()) {
-                    assert(m_selectedHandleCount > 0);
-                    --m_selectedHandleCount;
-                }
-            }
-
-            void toggle(HandleInfo& info) {
-                if (info.toggle()) {
-                    assert(selectedHandleCount() < totalHandleCount());
-                    ++m_selectedHandleCount;
-                } else {
-                    assert(m_selectedHandleCount > 0);
-                    --m_selectedHandleCount;
+                    assert(info.selectionIndex < m_selectedHandles.size());
+                    assert(m_selectedHandles[info.selectionIndex] == &entry);
+
+                    // move the last selected handle into the vacated slot
+                    HandleEntry* last = m_selectedHandles.back();
+                    m_selectedHandles[info.selectionIndex] = last;
+                    last->second.selectionIndex = info.selectionIndex;
+                    m_selectedHandles.pop_back();
                 }
             }
         public:
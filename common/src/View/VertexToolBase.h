@@ -182,10 +182,16 @@ namespace TrenchBroom {
             void select(const Lasso& lasso, const bool modifySelection) {
                 using HandleList = std::vector<H>;
 
-                const HandleList allHandles = handleManager().allHandles();
-                HandleList selectedHandles;
+                // in an axis aligned orthographic view, only test the handles near the lasso
+                HandleList candidates;
+                if (const auto bounds = lasso.axisAlignedBounds()) {
+                    handleManager().findHandles(bounds->first, bounds->second, std::back_inserter(candidates));
+                } else {
+                    candidates = handleManager().allHandles();
+                }
 
-                lasso.selected(std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+                HandleList selectedHandles;
+                lasso.selected(std::begin(candidates), std::end(candidates), std::back_inserter(selectedHandles));
                 if (!modifySelection) {
                     handleManager().deselectAll();
                 }
@@ -105,6 +105,15 @@ namespace TrenchBroom {
             m_showAxes = new QCheckBox();
             m_showAxes->setToolTip("Toggle showing the coordinate system axes in the 3D editing view.");
 
+            m_compactBrushVertices = new QCheckBox();
+            m_compactBrushVertices->setToolTip("Store brush normals in a compact format to reduce the video memory used by large maps, at a slight cost in shading precision.");
+
+            m_showProfiler = new QCheckBox();
+            m_showProfiler->setToolTip("Show the time spent in each phase of rendering a frame in the editing views. The recorded frames can be exported from the Debug menu.");
+
+            m_occlusionCulling = new QCheckBox();
+            m_occlusionCulling->setToolTip("Skip rendering brushes in the 3D view that are hidden behind other geometry. Brushes that come into view may appear one frame late.");
+
             m_textureModeCombo = new QComboBox();
             m_textureModeCombo->setToolTip("Sets the texture filtering mode in the editing views.");
             for (const auto& textureMode : TextureModes) {
@@ -146,6 +155,9 @@ namespace TrenchBroom {
             layout->addRow("Grid", m_gridAlphaSlider);
             layout->addRow("FOV", m_fovSlider);
             layout->addRow("Show axes", m_showAxes);
+            layout->addRow("Compact brush vertices", m_compactBrushVertices);
+            layout->addRow("Occlusion culling", m_occlusionCulling);
+            layout->addRow("Show profiler", m_showProfiler);
             layout->addRow("Texture mode", m_textureModeCombo);
 
             layout->addSection("Colors");
@@ -171,6 +183,9 @@ namespace TrenchBroom {
             connect(m_gridAlphaSlider, &SliderWithLabel::valueChanged, this, &ViewPreferencePane::gridAlphaChanged);
             connect(m_fovSlider, &SliderWithLabel::valueChanged, this, &ViewPreferencePane::fovChanged);
             connect(m_showAxes, &QCheckBox::stateChanged, this, &ViewPreferencePane::showAxesChanged);
+            connect(m_compactBrushVertices, &QCheckBox::stateChanged, this, &ViewPreferencePane::compactBrushVerticesChanged);
+            connect(m_occlusionCulling, &QCheckBox::stateChanged, this, &ViewPreferencePane::occlusionCullingChanged);
+            connect(m_showProfiler, &QCheckBox::stateChanged, this, &ViewPreferencePane::showProfilerChanged);
             connect(m_backgroundColorButton, &ColorButton::colorChanged, this, &ViewPreferencePane::backgroundColorChanged);
             connect(m_gridColorButton, &ColorButton::colorChanged, this, &ViewPreferencePane::gridColorChanged);
             connect(m_edgeColorButton, &ColorButton::colorChanged, this, &ViewPreferencePane::edgeColorChanged);
@@ -190,6 +205,9 @@ namespace TrenchBroom {
             prefs.resetToDefault(Preferences::GridAlpha);
             prefs.resetToDefault(Preferences::CameraFov);
             prefs.resetToDefault(Preferences::ShowAxes);
+            prefs.resetToDefault(Preferences::CompactBrushVertices);
+            prefs.resetToDefault(Preferences::OcclusionCulling);
+            prefs.resetToDefault(Preferences::ShowProfiler);
             prefs.resetToDefault(Preferences::TextureMinFilter);
             prefs.resetToDefault(Preferences::TextureMagFilter);
             prefs.resetToDefault(Preferences::BackgroundColor);
@@ -209,6 +227,9 @@ namespace TrenchBroom {
             m_textureModeCombo->setCurrentIndex(int(textureModeIndex));
 
             m_showAxes->setChecked(pref(Preferences::ShowAxes));
+            m_compactBrushVertices->setChecked(pref(Preferences::CompactBrushVertices));
+            m_occlusionCulling->setChecked(pref(Preferences::OcclusionCulling));
+            m_showProfiler->setChecked(pref(Preferences::ShowProfiler));
 
             m_backgroundColorButton->setColor(toQColor(pref(Preferences::BackgroundColor)));
             m_gridColorButton->setColor(toQColor(pref(Preferences::GridColor2D)));
@@ -278,6 +299,24 @@ namespace TrenchBroom {
             prefs.set(Preferences::ShowAxes, value);
         }
 
+        void ViewPreferencePane::compactBrushVerticesChanged(const int state) {
+            const auto value = state == Qt::Checked;
+            auto& prefs = PreferenceManager::instance();
+            prefs.set(Preferences::CompactBrushVertices, value);
+        }
+
+        void ViewPreferencePane::occlusionCullingChanged(const int state) {
+            const auto value = state == Qt::Checked;
+            auto& prefs = PreferenceManager::instance();
+            prefs.set(Preferences::OcclusionCulling, value);
+        }
+
+        void ViewPreferencePane::showProfilerChanged(const int state) {
+            const auto value = state == Qt::Checked;
+            auto& prefs = PreferenceManager::instance();
+            prefs.set(Preferences::ShowProfiler, value);
+        }
+
         void ViewPreferencePane::textureModeChanged(const int value) {
             const auto index = static_cast<size_t>(value);
             assert(index < TextureModes.size());
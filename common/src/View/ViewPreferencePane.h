@@ -38,6 +38,9 @@ namespace TrenchBroom {
             SliderWithLabel* m_gridAlphaSlider;
             SliderWithLabel* m_fovSlider;
             QCheckBox* m_showAxes;
+            QCheckBox* m_compactBrushVertices;
+            QCheckBox* m_occlusionCulling;
+            QCheckBox* m_showProfiler;
             QComboBox* m_textureModeCombo;
             ColorButton* m_backgroundColorButton;
             ColorButton* m_gridColorButton;
@@ -64,6 +67,9 @@ namespace TrenchBroom {
             void gridAlphaChanged(int value);
             void fovChanged(int value);
             void showAxesChanged(int state);
+            void compactBrushVerticesChanged(int state);
+            void occlusionCullingChanged(int state);
+            void showProfilerChanged(int state);
             void textureModeChanged(int index);
             void backgroundColorChanged(const QColor& color);
             void gridColorChanged(const QColor& color);
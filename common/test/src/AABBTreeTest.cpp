@@ -484,6 +484,164 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST(AABBTreeTest, findIntersectorsOfParallelRayOnBoundary) {
+        AABB tree;
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+3.0, +1.0, +1.0)), 2u);
+
+        assertIntersectors(tree, RAY(VEC(-2.0, +1.0, 0.0), VEC::pos_x()), { 1u, 2u });
+        assertIntersectors(tree, RAY(VEC(-2.0, -1.0, 0.0), VEC::pos_x()), { 1u, 2u });
+        assertIntersectors(tree, RAY(VEC(-2.0, +1.5, 0.0), VEC::pos_x()), {});
+        assertIntersectors(tree, RAY(VEC(+3.0, 0.0, 0.0), VEC::neg_x()), { 1u, 2u });
+    }
+
+    TEST(AABBTreeTest, visitIntersectorsByDistance) {
+        AABB tree;
+        tree.insert(BOX(VEC(+5.0, -1.0, -1.0), VEC(+6.0, +1.0, +1.0)), 3u);
+        tree.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+1.0, +2.0, -1.0), VEC(+2.0, +3.0, +1.0)), 4u);
+
+        const auto ray = RAY(VEC(-3.0, 0.0, 0.0), VEC::pos_x());
+
+        std::vector<AABB::DataType> visited;
+        std::vector<double> distances;
+        tree.visitIntersectorsByDistance(ray, [&](const AABB::DataType data, const double distance) {
+            visited.push_back(data);
+            distances.push_back(distance);
+            return std::numeric_limits<double>::max();
+        });
+
+        ASSERT_EQ(std::vector<AABB::DataType>({ 1u, 2u, 3u }), visited);
+        ASSERT_EQ(std::vector<double>({ 1.0, 4.0, 8.0 }), distances);
+
+        // stop once the first box is visited
+        visited.clear();
+        tree.visitIntersectorsByDistance(ray, [&](const AABB::DataType data, const double distance) {
+            visited.push_back(data);
+            return distance + 0.5;
+        });
+
+        ASSERT_EQ(std::vector<AABB::DataType>({ 1u }), visited);
+    }
+
+    void assertBoxIntersectors(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectors(box, std::inserter(actual, std::end(actual)));
+
+        ASSERT_EQ(expected, actual);
+    }
+
+    TEST(AABBTreeTest, findBoxIntersectors) {
+        AABB tree;
+        assertBoxIntersectors(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), {});
+
+        tree.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+3.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 3u);
+
+        assertBoxIntersectors(tree, BOX(VEC(-0.5, -0.5, -0.5), VEC(+0.5, +0.5, +0.5)), {});
+        assertBoxIntersectors(tree, BOX(VEC(-1.0, -0.5, -0.5), VEC(+0.5, +0.5, +0.5)), { 1u });
+        assertBoxIntersectors(tree, BOX(VEC(-1.5, -0.5, -0.5), VEC(+1.5, +0.5, +0.5)), { 1u, 2u });
+        assertBoxIntersectors(tree, BOX(VEC(-5.0, -5.0, -5.0), VEC(+5.0, +5.0, +5.0)), { 1u, 2u, 3u });
+        assertBoxIntersectors(tree, BOX(VEC(+3.5, +1.5, -0.5), VEC(+3.6, +1.6, +0.5)), {});
+    }
+
+    TEST(AABBTreeTest, findBounds) {
+        const BOX bounds1(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0));
+        const BOX bounds2(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0));
+
+        AABB tree;
+        ASSERT_EQ(std::nullopt, tree.findBounds(1u));
+
+        tree.insert(bounds1, 1u);
+        tree.insert(bounds2, 2u);
+        ASSERT_EQ(bounds1, tree.findBounds(1u));
+        ASSERT_EQ(bounds2, tree.findBounds(2u));
+        ASSERT_EQ(std::nullopt, tree.findBounds(3u));
+
+        tree.update(bounds1, 2u);
+        ASSERT_EQ(bounds1, tree.findBounds(2u));
+
+        tree.remove(1u);
+        ASSERT_EQ(std::nullopt, tree.findBounds(1u));
+    }
+
+    TEST(AABBTreeTest, clearAndBuildEmpty) {
+        AABB tree;
+        tree.insert(makeBounds(0, 1), 1u);
+
+        tree.clearAndBuild(std::vector<size_t>{}, [](const size_t i) { return makeBounds(i, i + 1u); });
+        ASSERT_TRUE(tree.empty());
+        ASSERT_FALSE(tree.contains(1u));
+    }
+
+    TEST(AABBTreeTest, clearAndBuildSingleNode) {
+        AABB tree;
+        tree.clearAndBuild(std::vector<size_t>{ 1u }, [](const size_t i) { return makeBounds(i, i + 1u); });
+
+        assertTree(R"(
+L [ ( 1 -1 -1 ) ( 2 1 1 ) ]: 1
+)" , tree);
+
+        assertTreeContains(tree, makeBounds(1, 2), 1u);
+    }
+
+    TEST(AABBTreeTest, clearAndBuildManyNodes) {
+        std::vector<size_t> objects;
+        for (size_t i = 0u; i < 1000u; ++i) {
+            objects.push_back(i);
+        }
+
+        const auto getBounds = [](const size_t i) { return makeBounds(2u * i, 2u * i + 1u); };
+
+        AABB tree;
+        tree.insert(makeBounds(0, 1), 5000u);
+        tree.clearAndBuild(objects, getBounds);
+
+        ASSERT_FALSE(tree.contains(5000u));
+        ASSERT_EQ(merge(getBounds(0u), getBounds(999u)), tree.bounds());
+        ASSERT_LE(tree.height(), 12u);
+
+        for (const auto i : objects) {
+            assertTreeContains(tree, getBounds(i), i);
+        }
+
+        assertIntersectors(tree, RAY(VEC(3.5, -2.0, 0.0), VEC::pos_y()), {});
+        assertIntersectors(tree, RAY(VEC(4.5, -2.0, 0.0), VEC::pos_y()), { 2u });
+        assertIntersectors(tree, RAY(VEC(1995.0, 0.0, 0.0), VEC::pos_x()), { 997u, 998u, 999u });
+
+        // the tree must remain valid for incremental updates
+        tree.remove(500u);
+        assertTreeDoesNotContain(tree, getBounds(500u), 500u);
+        tree.insert(getBounds(500u), 500u);
+        assertTreeContains(tree, getBounds(500u), 500u);
+    }
+
+    TEST(AABBTreeTest, clearAndBuildIdenticalBounds) {
+        std::vector<size_t> objects;
+        for (size_t i = 0u; i < 100u; ++i) {
+            objects.push_back(i);
+        }
+
+        AABB tree;
+        tree.clearAndBuild(objects, [](const size_t) { return makeBounds(0, 1); });
+
+        ASSERT_LE(tree.height(), 8u);
+        for (const auto i : objects) {
+            assertTreeContains(tree, makeBounds(0, 1), i);
+        }
+    }
+
+    TEST(AABBTreeTest, clearAndBuildDuplicateNode) {
+        AABB tree;
+        ASSERT_THROW(tree.clearAndBuild(std::vector<size_t>{ 1u, 2u, 1u }, [](const size_t i) { return makeBounds(i, i + 1u); }), NodeTreeException);
+        ASSERT_TRUE(tree.empty());
+        ASSERT_FALSE(tree.contains(1u));
+    }
+
     void assertTree(const std::string& exp, const AABB& actual) {
         std::stringstream str;
         actual.print(str);
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Allocator.h"
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    struct AllocatedObject : public Allocator<AllocatedObject, 4, 16> {
+        double value;
+        size_t index;
+
+        AllocatedObject(const double i_value, const size_t i_index) :
+        value(i_value),
+        index(i_index) {}
+    };
+
+    TEST(AllocatorTest, allocateDistinctAlignedObjects) {
+        std::vector<AllocatedObject*> objects;
+        std::set<AllocatedObject*> distinct;
+        for (size_t i = 0; i < 100; ++i) {
+            auto* object = new AllocatedObject(static_cast<double>(i), i);
+            ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(object) % alignof(AllocatedObject));
+            ASSERT_TRUE(distinct.insert(object).second);
+            objects.push_back(object);
+        }
+
+        for (size_t i = 0; i < objects.size(); ++i) {
+            ASSERT_EQ(i, objects[i]->index);
+            ASSERT_EQ(static_cast<double>(i), objects[i]->value);
+            delete objects[i];
+        }
+    }
+
+    TEST(AllocatorTest, reuseDeallocatedObjects) {
+        auto* first = new AllocatedObject(1.0, 1u);
+        delete first;
+
+        auto* second = new AllocatedObject(2.0, 2u);
+        ASSERT_EQ(first, second);
+        delete second;
+    }
+
+    TEST(AllocatorTest, allocateOnMultipleThreads) {
+        constexpr size_t ThreadCount = 4;
+        constexpr size_t ObjectCount = 1000;
+
+        std::vector<std::vector<AllocatedObject*>> objects(ThreadCount);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < ThreadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                for (size_t i = 0; i < ObjectCount; ++i) {
+                    objects[t].push_back(new AllocatedObject(static_cast<double>(t), i));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::set<AllocatedObject*> distinct;
+        for (size_t t = 0; t < ThreadCount; ++t) {
+            for (size_t i = 0; i < ObjectCount; ++i) {
+                ASSERT_TRUE(distinct.insert(objects[t][i]).second);
+                ASSERT_EQ(static_cast<double>(t), objects[t][i]->value);
+                ASSERT_EQ(i, objects[t][i]->index);
+            }
+        }
+
+        // deallocate on different threads than the ones that allocated the objects
+        threads.clear();
+        for (size_t t = 0; t < ThreadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                for (auto* object : objects[(t + 1) % ThreadCount]) {
+                    delete object;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
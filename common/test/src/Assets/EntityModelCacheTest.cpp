@@ -0,0 +1,49 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelCache.h"
+#include "IO/Path.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(EntityModelCacheTest, shareModel) {
+            auto& cache = EntityModelCache::instance();
+            const auto path = IO::Path("progs/EntityModelCacheTest_shareModel.mdl");
+
+            ASSERT_EQ(nullptr, cache.model("quake", path));
+
+            auto* model = new EntityModel("model");
+            auto shared = cache.insert("quake", path, std::unique_ptr<EntityModel>(model));
+            ASSERT_EQ(model, shared.get());
+            ASSERT_EQ(shared, cache.model("quake", path));
+            ASSERT_EQ(nullptr, cache.model("hexen2", path));
+
+            // the model that is already in the cache is kept
+            ASSERT_EQ(shared, cache.insert("quake", path, std::make_unique<EntityModel>("other")));
+
+            shared.reset();
+            ASSERT_EQ(nullptr, cache.model("quake", path));
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Color.h"
+#include "Assets/Palette.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(PaletteTest, indexedToRgba) {
+            std::vector<unsigned char> data(256 * 3, 0);
+            data[3] = 255; data[4] = 0;   data[5] = 0;   // index 1 is red
+            data[6] = 0;   data[7] = 255; data[8] = 0;   // index 2 is green
+            data[765] = 0; data[766] = 0; data[767] = 255; // index 255 is blue
+            const Palette palette(data);
+
+            const std::vector<unsigned char> indices{ 1, 2, 255, 1 };
+            std::vector<unsigned char> rgba(indices.size() * 4);
+            Color averageColor;
+
+            ASSERT_FALSE(palette.indexedToRgba(indices, indices.size(), rgba, PaletteTransparency::Opaque, averageColor));
+            EXPECT_EQ((std::vector<unsigned char>{ 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 0, 0, 255 }), rgba);
+            EXPECT_FLOAT_EQ(0.5f, averageColor.r());
+            EXPECT_FLOAT_EQ(0.25f, averageColor.g());
+            EXPECT_FLOAT_EQ(0.25f, averageColor.b());
+            EXPECT_FLOAT_EQ(1.0f, averageColor.a());
+
+            ASSERT_TRUE(palette.indexedToRgba(indices, indices.size(), rgba, PaletteTransparency::Index255Transparent, averageColor));
+            EXPECT_EQ(0u, rgba[2 * 4 + 3]);
+            EXPECT_EQ(255u, rgba[3 * 4 + 3]);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/TextureBuffer.h"
+
+#include <vecmath/vec.h>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(TextureBufferTest, mipLevelCount) {
+            EXPECT_EQ(1u, mipLevelCount(1u, 1u));
+            EXPECT_EQ(7u, mipLevelCount(64u, 64u));
+            EXPECT_EQ(5u, mipLevelCount(16u, 3u));
+            EXPECT_EQ(5u, mipLevelCount(25u, 10u));
+        }
+
+        TEST(TextureBufferTest, generateMips) {
+            // a 4x2 RGB image whose left half is black and whose right half is white
+            TextureBufferList buffers(1u);
+            buffers[0] = TextureBuffer{
+                0, 0, 0,  0, 0, 0,  255, 255, 255,  255, 255, 255,
+                0, 0, 0,  0, 0, 0,  255, 255, 255,  255, 255, 255
+            };
+
+            generateMips(buffers, 4u, 2u, GL_RGB);
+
+            ASSERT_EQ(3u, buffers.size());
+            EXPECT_EQ((TextureBuffer{ 0, 0, 0,  255, 255, 255 }), buffers[1]);
+            EXPECT_EQ((TextureBuffer{ 128, 128, 128 }), buffers[2]);
+        }
+    }
+}
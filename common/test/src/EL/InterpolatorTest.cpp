@@ -65,5 +65,17 @@ namespace TrenchBroom {
             context.declareVariable("TEST", Value("interesting"));
             ASSERT_EL(" an \\interesting expression", " an \\${TEST} expression", context);
         }
+
+        TEST(ELInterpolatorTest, interpolateRepeatedlyWithDifferentContexts) {
+            const Interpolator interpolator(" an ${TEST} expression");
+
+            EvaluationContext context1;
+            context1.declareVariable("TEST", Value("interesting"));
+            ASSERT_EQ(" an interesting expression", interpolator.interpolate(context1));
+
+            EvaluationContext context2;
+            context2.declareVariable("TEST", Value("boring"));
+            ASSERT_EQ(" an boring expression", interpolator.interpolate(context2));
+        }
     }
 }
@@ -21,14 +21,17 @@
 
 #include "Exceptions.h"
 #include "Macros.h"
+#include "IO/DirectoryEntry.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/Path.h"
 #include "IO/PathQt.h"
 #include "IO/TestEnvironment.h"
 
 #include <algorithm>
+#include <vector>
 
 #include <QFileInfo>
 
@@ -113,6 +116,38 @@ namespace TrenchBroom {
             ASSERT_TRUE(std::find(std::begin(contents), std::end(contents), Path("test2.map")) != std::end(contents));
         }
 
+        static bool hasEntry(const std::vector<DirectoryEntry>& entries, const Path& path, const bool directory) {
+            return std::any_of(std::begin(entries), std::end(entries), [&](const DirectoryEntry& entry) {
+                return entry.path == path && entry.directory == directory;
+            });
+        }
+
+        TEST(DiskTest, getDirectoryEntries) {
+            FSTestEnvironment env;
+
+            ASSERT_THROW(Disk::getDirectoryEntries(Path("asdf/bleh"), false), FileSystemException);
+            ASSERT_THROW(Disk::getDirectoryEntries(env.dir() + Path("does/not/exist"), true), FileSystemException);
+
+            const auto entries = Disk::getDirectoryEntries(env.dir(), false);
+            ASSERT_EQ(5u, entries.size());
+            ASSERT_TRUE(hasEntry(entries, Path("dir1"), true));
+            ASSERT_TRUE(hasEntry(entries, Path("dir2"), true));
+            ASSERT_TRUE(hasEntry(entries, Path("anotherDir"), true));
+            ASSERT_TRUE(hasEntry(entries, Path("test.txt"), false));
+            ASSERT_TRUE(hasEntry(entries, Path("test2.map"), false));
+
+            const auto allEntries = Disk::getDirectoryEntries(env.dir(), true);
+            ASSERT_EQ(8u, allEntries.size());
+            ASSERT_TRUE(hasEntry(allEntries, Path("dir1"), true));
+            ASSERT_TRUE(hasEntry(allEntries, Path("dir2"), true));
+            ASSERT_TRUE(hasEntry(allEntries, Path("anotherDir"), true));
+            ASSERT_TRUE(hasEntry(allEntries, Path("anotherDir/subDirTest"), true));
+            ASSERT_TRUE(hasEntry(allEntries, Path("anotherDir/subDirTest/test2.map"), false));
+            ASSERT_TRUE(hasEntry(allEntries, Path("anotherDir/test3.map"), false));
+            ASSERT_TRUE(hasEntry(allEntries, Path("test.txt"), false));
+            ASSERT_TRUE(hasEntry(allEntries, Path("test2.map"), false));
+        }
+
         TEST(DiskTest, openFile) {
             FSTestEnvironment env;
 
@@ -124,6 +159,26 @@ namespace TrenchBroom {
             ASSERT_TRUE(Disk::openFile(env.dir() + Path("anotherDir/subDirTest/test2.map")) != nullptr);
         }
 
+        TEST(DiskTest, openMappedFile) {
+            FSTestEnvironment env;
+
+            const auto file = Disk::openFile(env.dir() + Path("test.txt"));
+            ASSERT_TRUE(dynamic_cast<MappedFile*>(file.get()) != nullptr);
+            ASSERT_EQ(12u, file->size());
+
+            const auto reader = file->reader().buffer();
+            ASSERT_EQ(std::string("some content"), std::string(std::begin(reader), std::end(reader)));
+
+            const auto view = FileView(Path("view"), file, 5u, 7u);
+            const auto viewReader = view.reader().buffer();
+            ASSERT_EQ(std::string("content"), std::string(std::begin(viewReader), std::end(viewReader)));
+
+            env.createFile(Path("empty.txt"), "");
+            const auto emptyFile = Disk::openFile(env.dir() + Path("empty.txt"));
+            ASSERT_EQ(0u, emptyFile->size());
+            ASSERT_EQ(0u, emptyFile->reader().size());
+        }
+
         TEST(DiskTest, resolvePath) {
             FSTestEnvironment env;
 
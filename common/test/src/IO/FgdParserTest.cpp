@@ -850,6 +850,12 @@ decor_goddess_statue : "Goddess Statue" [])";
             ASSERT_TRUE(std::any_of(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "info_player_start"; }));
             ASSERT_TRUE(std::any_of(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "info_player_coop"; }));
 
+            const auto folder = path.deleteLastComponent();
+            ASSERT_EQ((std::vector<Path>{
+                folder + Path("nested/include.fgd"),
+                folder + Path("nested/nested.fgd")
+            }), parser.includedFiles());
+
             kdl::vec_clear_and_delete(defs);
         }
 
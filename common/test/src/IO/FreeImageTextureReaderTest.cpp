@@ -128,7 +128,9 @@ namespace TrenchBroom {
             ASSERT_TRUE(texture != nullptr);
             ASSERT_EQ(w, texture->width());
             ASSERT_EQ(h, texture->height());
-            ASSERT_EQ(1u, texture->buffersIfUnprepared().size());
+            // opaque textures come with a complete mip chain: 64x64 down to 1x1
+            ASSERT_EQ(7u, texture->buffersIfUnprepared().size());
+            ASSERT_EQ(4u, texture->buffersIfUnprepared().back().size());
             ASSERT_TRUE(GL_BGRA == texture->format() || GL_RGBA == texture->format());
             ASSERT_EQ(Assets::TextureType::Opaque, texture->type());
 
@@ -49,6 +49,8 @@ namespace TrenchBroom {
 
             ASSERT_TRUE(fs.fileExists(Path("gfx/palette.lmp")));
             ASSERT_TRUE(fs.fileExists(Path("GFX/Palette.LMP")));
+            ASSERT_TRUE(fs.fileExists(Path("pics/../GFX/Palette.LMP")));
+            ASSERT_FALSE(fs.fileExists(Path("gfx")));
         }
 
         TEST(IdPakFileSystemTest, findItems) {
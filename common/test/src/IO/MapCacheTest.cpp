@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/MapCache.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::string serialize(Model::World& world) {
+            std::stringstream str;
+            NodeWriter writer(world, str);
+            writer.writeMap();
+            return str.str();
+        }
+
+        TEST(MapCacheTest, readCachedMap) {
+            const std::string data(R"(
+// entity 0
+{
+"classname" "worldspawn"
+"message" "yay"
+// brush 0
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) [ 0 -1 0 0 ] [ 0 0 -1 0 ] none 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) [ 1 0 0 0 ] [ 0 0 -1 0 ] none 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) [ -1 0 0 0 ] [ 0 -1 0 0 ] none 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) [ 1 0 0 0 ] [ 0 -1 0 0 ] none 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) [ -1 0 0 0.333333 ] [ 0 0 -1 0 ] none 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) [ 0 1 0 0 ] [ 0 0 -1 0 ] none 0 1 1
+}
+}
+// entity 1
+{
+"classname" "light"
+"origin" "0 0 32"
+"_tb_group" "1"
+}
+// entity 2
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "group"
+"_tb_id" "1"
+}
+)");
+
+            const vm::bbox3 worldBounds(8192.0);
+            const auto format = Model::MapFormat::Valve;
+
+            TestEnvironment env("mapcachetest");
+            const auto cachePath = MapCache::cachePath(env.dir() + Path("test.map"));
+
+            TestParserStatus status;
+            WorldReader reader(data);
+            MapCacheWriter cacheWriter(format, data.data(), data.data() + data.size());
+            reader.setCacheWriter(&cacheWriter);
+
+            auto world = reader.read(format, worldBounds, status);
+            ASSERT_TRUE(world != nullptr);
+
+            cacheWriter.write(cachePath);
+            ASSERT_TRUE(env.fileExists(cachePath.lastComponent()));
+
+            const auto cacheFile = Disk::openFile(cachePath);
+            const auto cacheBuffer = cacheFile->reader().buffer();
+            const MapCacheReader cache(std::begin(cacheBuffer), std::end(cacheBuffer));
+
+            const std::string changedData = data + "\n";
+            ASSERT_TRUE(cache.matches(format, data.data(), data.data() + data.size()));
+            ASSERT_FALSE(cache.matches(Model::MapFormat::Standard, data.data(), data.data() + data.size()));
+            ASSERT_FALSE(cache.matches(format, changedData.data(), changedData.data() + changedData.size()));
+
+            auto cachedWorld = WorldReader::readCached(cache, worldBounds, status);
+            ASSERT_TRUE(cachedWorld != nullptr);
+
+            ASSERT_EQ(world->childCount(), cachedWorld->childCount());
+            ASSERT_EQ(world->defaultLayer()->childCount(), cachedWorld->defaultLayer()->childCount());
+            ASSERT_EQ(world->lineNumber(), cachedWorld->lineNumber());
+            ASSERT_EQ(serialize(*world), serialize(*cachedWorld));
+        }
+
+        TEST(MapCacheTest, rejectCorruptCache) {
+            const std::string data("garbage");
+            const MapCacheReader cache(data.data(), data.data() + data.size());
+            ASSERT_FALSE(cache.matches(Model::MapFormat::Standard, data.data(), data.data() + data.size()));
+        }
+    }
+}
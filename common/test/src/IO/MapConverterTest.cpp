@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "IO/MapConverter.h"
+#include "IO/MapFileSerializer.h"
+#include "IO/NodeWriter.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const std::string StandardMap(R"(
+// entity 0
+{
+"classname" "worldspawn"
+"message" "yay"
+// brush 0
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) wall 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) wall 16 0 30 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) floor 0 8 0 0.5 2
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) floor 0 0 45 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) wall 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) wall 0 0 0 1 1
+}
+}
+// entity 1
+{
+"classname" "light"
+"origin" "0 0 32"
+}
+)");
+
+        TEST(MapConverterTest, convertStandardToValve) {
+            TestParserStatus status;
+            WorldReader reader(StandardMap);
+            auto world = reader.read(Model::MapFormat::Standard, vm::bbox3(8192.0), status);
+
+            // the converter must produce the same output as writing the loaded world in the target format
+            std::string expected;
+            NodeWriter writer(*world, MapFileSerializer::create(Model::MapFormat::Valve, expected).release());
+            writer.writeMap();
+
+            std::string actual;
+            MapConverter converter(StandardMap, Model::MapFormat::Valve, actual);
+            converter.convert(Model::MapFormat::Unknown, status);
+
+            ASSERT_EQ(expected, actual);
+        }
+
+        TEST(MapConverterTest, rejectValveToStandard) {
+            ASSERT_TRUE(MapConverter::canConvert(Model::MapFormat::Standard, Model::MapFormat::Valve));
+            ASSERT_TRUE(MapConverter::canConvert(Model::MapFormat::Quake2, Model::MapFormat::Quake2_Valve));
+            ASSERT_FALSE(MapConverter::canConvert(Model::MapFormat::Valve, Model::MapFormat::Standard));
+
+            TestParserStatus status;
+            std::string output;
+            MapConverter converter(StandardMap, Model::MapFormat::Standard, output);
+            converter.convert(Model::MapFormat::Standard, status);
+
+            std::string valveOutput;
+            MapConverter valveConverter(output, Model::MapFormat::Valve, valveOutput);
+            valveConverter.convert(Model::MapFormat::Standard, status);
+
+            std::string standardOutput;
+            MapConverter standardConverter(valveOutput, Model::MapFormat::Standard, standardOutput);
+            ASSERT_THROW(standardConverter.convert(Model::MapFormat::Valve, status), FileFormatException);
+        }
+    }
+}
@@ -31,6 +31,8 @@
 
 #include <kdl/string_compare.h>
 
+#include <cstdio>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -187,6 +189,63 @@ R"(// entity 0
             ASSERT_EQ(expected, actual);
         }
 
+        TEST(NodeWriterTest, writeWorldspawnWithManyBrushesToFile) {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::World map(Model::MapFormat::Standard);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            // enough brushes to be formatted in several chunks
+            const size_t brushCount = 200u;
+            Model::BrushBuilder builder(&map, worldBounds);
+            std::vector<Model::Brush*> brushes;
+            for (size_t i = 0u; i < brushCount; ++i) {
+                Model::Brush* brush = builder.createCube(64.0, "none");
+                map.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            FILE* file = std::tmpfile();
+            ASSERT_TRUE(file != nullptr);
+
+            NodeWriter writer(map, file);
+            writer.writeMap();
+
+            std::string actual(static_cast<size_t>(std::ftell(file)), '\0');
+            std::rewind(file);
+            ASSERT_EQ(actual.size(), std::fread(&actual[0], 1u, actual.size(), file));
+            std::fclose(file);
+
+            std::string expected =
+R"(// entity 0
+{
+"classname" "worldspawn"
+)";
+            for (size_t i = 0u; i < brushCount; ++i) {
+                expected += "// brush " + std::to_string(i) + "\n";
+                expected +=
+R"({
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1
+}
+)";
+            }
+            expected += "}\n";
+
+            ASSERT_EQ(expected, actual);
+
+            for (size_t i = 0u; i < brushCount; ++i) {
+                ASSERT_EQ(5u + 9u * i, brushes[i]->lineNumber());
+                ASSERT_TRUE(brushes[i]->containsLine(12u + 9u * i));
+                ASSERT_FALSE(brushes[i]->containsLine(13u + 9u * i));
+                ASSERT_EQ(6u + 9u * i, brushes[i]->faces().front()->lineNumber());
+            }
+        }
+
         TEST(NodeWriterTest, writeWorldspawnWithBrushInCustomLayer) {
             const vm::bbox3 worldBounds(8192.0);
 
@@ -23,7 +23,10 @@
 #include "IO/Path.h"
 #include "IO/PathQt.h"
 
+#include <kdl/string_compare.h>
+
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -327,6 +330,23 @@ namespace TrenchBroom {
             ASSERT_FALSE(Path("dir/dir2/dir3") < Path("dir/dir2"));
         }
 
+        TEST(PathTest, components) {
+            ASSERT_EQ(std::vector<std::string>({}), Path("").components());
+            ASSERT_EQ(std::vector<std::string>({}), Path("/").components());
+            ASSERT_EQ(std::vector<std::string>({ "dir" }), Path("/dir").components());
+            ASSERT_EQ(std::vector<std::string>({ "dir", "dir2", "file.txt" }), Path("dir//dir2/ file.txt").components());
+        }
+
+        TEST(PathTest, caseInsensitiveLess) {
+            const auto less = Path::Less<kdl::ci::string_less>();
+            ASSERT_FALSE(less(Path("DIR/File"), Path("dir/file")));
+            ASSERT_FALSE(less(Path("dir/file"), Path("DIR/File")));
+            ASSERT_TRUE(less(Path("dir"), Path("DIR/file")));
+            ASSERT_TRUE(less(Path("dir/a"), Path("DIR/B")));
+            ASSERT_TRUE(less(Path("dir/file"), Path("dir-2")));
+            ASSERT_FALSE(less(Path("DIR/B"), Path("dir/a")));
+        }
+
         TEST(PathTest, pathAsQString) {
             ASSERT_EQ(QString::fromLatin1("/asdf/test"), pathAsQString(Path("/asdf/test")));
             ASSERT_EQ(QString::fromLatin1("asdf/test"), pathAsQString(Path("asdf/test")));
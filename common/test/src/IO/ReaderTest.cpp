@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -37,6 +38,7 @@ namespace TrenchBroom {
         void seekFromEnd(Reader&& r);
         void seekForward(Reader&& r);
         void subReader(Reader&& r);
+        void buffer(Reader&& r);
 
         const char* buff() {
             static const auto* result = "abcdefghij_";
@@ -191,5 +193,64 @@ namespace TrenchBroom {
         TEST(FileReaderTest, testSubReader) {
             subReader(file()->reader());
         }
+
+        void buffer(Reader&& r) {
+            r.seekFromBegin(3U);
+
+            const auto buffered = r.buffer();
+            EXPECT_EQ(10U, buffered.size());
+            EXPECT_EQ(0U, buffered.position());
+            EXPECT_EQ(std::string("abcdefghij"), std::string(buffered.begin(), buffered.end()));
+
+            // buffering must not change the position of the original reader
+            EXPECT_EQ(3U, r.position());
+            EXPECT_EQ('d', r.readChar<char>());
+        }
+
+        TEST(BufferReaderTest, testBuffer) {
+            buffer(Reader::from(buff(), buff() + 10));
+
+            // buffering a memory region does not copy it
+            const auto buffered = Reader::from(buff(), buff() + 10).buffer();
+            EXPECT_EQ(buff(), buffered.begin());
+            EXPECT_EQ(buff() + 10, buffered.end());
+
+            const auto subBuffered = Reader::from(buff(), buff() + 10).subReaderFromBegin(2U, 3U).buffer();
+            EXPECT_EQ(buff() + 2, subBuffered.begin());
+            EXPECT_EQ(buff() + 5, subBuffered.end());
+        }
+
+        TEST(FileReaderTest, testBuffer) {
+            buffer(file()->reader());
+
+            // files opened from disk are mapped into memory, buffering their readers does not copy the contents
+            const auto mappedFile = std::dynamic_pointer_cast<MappedFile>(file());
+            ASSERT_NE(nullptr, mappedFile);
+
+            const auto buffered = mappedFile->reader().buffer();
+            EXPECT_EQ(mappedFile->begin(), buffered.begin());
+            EXPECT_EQ(mappedFile->end(), buffered.end());
+        }
+
+        TEST(CFileReaderTest, testBuffer) {
+            const auto cFile = std::make_shared<CFile>(Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Reader/10byte"));
+            buffer(cFile->reader());
+            buffer(cFile->reader());
+        }
+
+        TEST(BufferReaderTest, testReadArray) {
+            auto r = Reader::from(buff(), buff() + 10);
+
+            std::vector<int> values;
+            r.readArray<char, int>(values, 3U);
+            EXPECT_EQ((std::vector<int>{ 'a', 'b', 'c' }), values);
+            EXPECT_EQ(3U, r.position());
+
+            r.readArray<char, int>(values, 2U);
+            EXPECT_EQ((std::vector<int>{ 'a', 'b', 'c', 'd', 'e' }), values);
+            EXPECT_EQ(5U, r.position());
+
+            EXPECT_THROW(r.readArray<char, int>(values, 6U), ReaderException);
+        }
     }
 }
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Color.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureCache.h"
+
+#include <memory>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST(TextureCacheTest, readWrittenTexture) {
+            TestEnvironment env("texturecachetest");
+            const auto cache = TextureCache(env.dir() + Path("cache"));
+
+            const std::string image("some image file contents");
+            const auto entryPath = cache.entryPath(image.data(), image.data() + image.size());
+            ASSERT_EQ(nullptr, cache.readTexture(entryPath, "texture"));
+
+            Assets::TextureBufferList buffers(1u);
+            Assets::setMipBufferSize(buffers, 1u, 2u, 2u, GL_RGBA);
+            for (size_t i = 0u; i < buffers[0].size(); ++i) {
+                buffers[0][i] = static_cast<unsigned char>(i);
+            }
+
+            const auto averageColor = Color(0.25f, 0.5f, 0.75f, 1.0f);
+            cache.writeTexture(entryPath, 2u, 2u, averageColor, buffers, GL_RGBA, Assets::TextureType::Masked);
+
+            const auto texture = std::unique_ptr<Assets::Texture>(cache.readTexture(entryPath, "texture"));
+            ASSERT_NE(nullptr, texture);
+            EXPECT_EQ("texture", texture->name());
+            EXPECT_EQ(2u, texture->width());
+            EXPECT_EQ(2u, texture->height());
+            EXPECT_EQ(averageColor, texture->averageColor());
+            EXPECT_EQ(Assets::TextureType::Masked, texture->type());
+        }
+
+        TEST(TextureCacheTest, entryPathDependsOnContents) {
+            TestEnvironment env("texturecachetest");
+            const auto cache = TextureCache(env.dir() + Path("cache"));
+
+            const std::string image1("some image file contents");
+            const std::string image2("other image file contents");
+            EXPECT_EQ(cache.entryPath(image1.data(), image1.data() + image1.size()), cache.entryPath(image1.data(), image1.data() + image1.size()));
+            EXPECT_NE(cache.entryPath(image1.data(), image1.data() + image1.size()), cache.entryPath(image2.data(), image2.data() + image2.size()));
+        }
+    }
+}
@@ -21,6 +21,7 @@
 
 #include "Logger.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
@@ -29,6 +30,7 @@
 #include "Model/GameConfig.h"
 
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -138,5 +140,86 @@ namespace TrenchBroom {
             assertTexture("blowjob_machine", 128, 128, textureManager);
             assertTexture("lasthopeofhuman", 128, 128, textureManager);
         }
+
+        TEST(TextureLoaderTest, testLoadDecodesOnDemand) {
+            const std::vector<IO::Path> paths({ Path("fixture/test/IO/Wad/cr8_czg.wad") });
+
+            const IO::Path root = IO::Disk::getCurrentWorkingDir();
+            const std::vector<IO::Path> fileSearchPaths{ root };
+            const IO::DiskFileSystem fileSystem(root, true);
+
+            const Model::TextureConfig textureConfig(
+                Model::TexturePackageConfig(
+                    Model::PackageFormatConfig("wad", "idmip")),
+                    Model::PackageFormatConfig("D", "idmip"),
+                    IO::Path("fixture/test/palette.lmp"),
+                    "wad",
+                    IO::Path(),
+                    {});
+
+            auto logger = NullLogger();
+            auto textureManager = Assets::TextureManager(0, 0, logger);
+
+            {
+                // the textures must remain usable after the loader has been destroyed
+                IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
+                textureLoader.loadTextures(paths, textureManager);
+            }
+
+            const auto* texture = textureManager.texture("cr8_czg_3");
+            ASSERT_NE(nullptr, texture);
+            EXPECT_FALSE(texture->isLoaded());
+            EXPECT_EQ(64u, texture->width());
+            EXPECT_EQ(128u, texture->height());
+
+            ASSERT_EQ(4u, texture->buffersIfUnprepared().size());
+            EXPECT_TRUE(texture->isLoaded());
+            EXPECT_EQ(64u * 128u * 4u, texture->buffersIfUnprepared().front().size());
+            EXPECT_EQ(Assets::TextureType::Opaque, texture->type());
+
+            EXPECT_FALSE(textureManager.texture("cr8_czg_1")->isLoaded());
+        }
+
+        TEST(TextureLoaderTest, testReloadChangedCollection) {
+            const std::vector<IO::Path> paths({ Path("fixture/test/IO/Wad/cr8_czg.wad"), Path("fixture/test/IO/Wad/q1_masked.wad") });
+
+            const IO::Path root = IO::Disk::getCurrentWorkingDir();
+            const std::vector<IO::Path> fileSearchPaths{ root };
+            const IO::DiskFileSystem fileSystem(root, true);
+
+            const Model::TextureConfig textureConfig(
+                Model::TexturePackageConfig(
+                    Model::PackageFormatConfig("wad", "idmip")),
+                    Model::PackageFormatConfig("D", "idmip"),
+                    IO::Path("fixture/test/palette.lmp"),
+                    "wad",
+                    IO::Path(),
+                    {});
+
+            auto logger = NullLogger();
+            auto textureManager = Assets::TextureManager(0, 0, logger);
+
+            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
+            textureLoader.loadTextures(paths, textureManager);
+            ASSERT_EQ(2u, textureManager.collections().size());
+
+            auto* changedCollection = textureManager.collections()[0];
+            auto* unchangedCollection = textureManager.collections()[1];
+            ASSERT_EQ(std::vector<Path>({ root + paths[0] }), changedCollection->sourcePaths());
+            ASSERT_EQ(std::vector<Path>({ root + paths[1] }), unchangedCollection->sourcePaths());
+
+            const auto collections = textureManager.collectionsLoadedFrom({ root + paths[0], root + Path("some/other/file.wad") });
+            ASSERT_EQ(std::vector<Assets::TextureCollection*>({ changedCollection }), collections);
+
+            textureManager.unloadTextureCollections(collections);
+            ASSERT_EQ(std::vector<Assets::TextureCollection*>({ unchangedCollection }), textureManager.collections());
+            assertTextureMissing("cr8_czg_1", textureManager);
+
+            // only the unloaded collection is loaded again
+            textureLoader.loadTextures(paths, textureManager);
+            ASSERT_EQ(2u, textureManager.collections().size());
+            EXPECT_EQ(unchangedCollection, textureManager.collections()[1]);
+            assertTexture("cr8_czg_1", 64, 64, textureManager);
+        }
     }
 }
@@ -245,6 +245,67 @@ namespace TrenchBroom {
             ASSERT_FLOAT_EQ(-0.55f, face->yScale());
         }
 
+        TEST(WorldReaderTest, parseBrushWithIrregularFaceLayout) {
+            // the faces in this brush cannot be handled by the tokenizer's fast path for standard faces
+            const std::string data(R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 )
+( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1 // comment
+( -0 -0 -16 ) ( 64 -0 -16 ) // comment
+( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 1e1 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1
+1
+}
+})");
+            const vm::bbox3 worldBounds(8192.0);
+
+            IO::TestParserStatus status;
+            WorldReader reader(data);
+
+            auto world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+
+            ASSERT_EQ(1u, world->childCount());
+            Model::Node* defaultLayer = world->children().front();
+            ASSERT_EQ(1u, defaultLayer->childCount());
+
+            Model::Brush* brush = static_cast<Model::Brush*>(defaultLayer->children().front());
+            const std::vector<Model::BrushFace*>& faces = brush->faces();
+            ASSERT_EQ(6u, faces.size());
+
+            const Model::BrushFace* face1 = findFaceByPoints(faces, vm::vec3(0.0, 0.0, -16.0), vm::vec3(0.0, 0.0, 0.0),
+                                                             vm::vec3(64.0, 0.0, -16.0));
+            ASSERT_TRUE(face1 != nullptr);
+            ASSERT_STREQ("tex1", face1->textureName().c_str());
+            ASSERT_FLOAT_EQ(1.0, face1->xOffset());
+            ASSERT_FLOAT_EQ(2.0, face1->yOffset());
+            ASSERT_FLOAT_EQ(3.0, face1->rotation());
+            ASSERT_FLOAT_EQ(4.0, face1->xScale());
+            ASSERT_FLOAT_EQ(5.0, face1->yScale());
+
+            const Model::BrushFace* face2 = findFaceByPoints(faces, vm::vec3(0.0, 0.0, -16.0), vm::vec3(0.0, 64.0, -16.0),
+                                                             vm::vec3(0.0, 0.0, 0.0));
+            ASSERT_TRUE(face2 != nullptr);
+            ASSERT_STREQ("tex2", face2->textureName().c_str());
+
+            ASSERT_TRUE(findFaceByPoints(faces, vm::vec3(0.0, 0.0, -16.0), vm::vec3(64.0, 0.0, -16.0),
+                                         vm::vec3(0.0, 64.0, -16.0)) != nullptr);
+
+            const Model::BrushFace* face4 = findFaceByPoints(faces, vm::vec3(64.0, 64.0, 0.0), vm::vec3(0.0, 64.0, 0.0),
+                                                             vm::vec3(64.0, 64.0, -16.0));
+            ASSERT_TRUE(face4 != nullptr);
+            ASSERT_FLOAT_EQ(10.0, face4->xOffset());
+
+            ASSERT_TRUE(findFaceByPoints(faces, vm::vec3(64.0, 64.0, 0.0), vm::vec3(64.0, 64.0, -16.0),
+                                         vm::vec3(64.0, 0.0, 0.0)) != nullptr);
+            ASSERT_TRUE(findFaceByPoints(faces, vm::vec3(64.0, 64.0, 0.0), vm::vec3(64.0, 0.0, 0.0),
+                                         vm::vec3(0.0, 64.0, 0.0)) != nullptr);
+        }
+
         TEST(WorldReaderTest, parseBrushWithCurlyBraceInTextureName) {
             const std::string data(R"(
 {
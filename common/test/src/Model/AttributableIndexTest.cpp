@@ -146,6 +146,58 @@ namespace TrenchBroom {
             delete entity2;
         }
 
+        TEST(EntityAttributeIndexTest, removeMissingAttribute) {
+            AttributableNodeIndex index;
+
+            Entity* entity = new Entity();
+            entity->addOrUpdateAttribute("test", "somevalue");
+            index.addAttributableNode(entity);
+
+            ASSERT_FALSE(index.removeAttribute(entity, "test", "othervalue"));
+            ASSERT_FALSE(index.removeAttribute(entity, "other", "somevalue"));
+            ASSERT_TRUE(index.removeAttribute(entity, "test", "somevalue"));
+            ASSERT_FALSE(index.removeAttribute(entity, "test", "somevalue"));
+
+            delete entity;
+        }
+
+        TEST(EntityAttributeIndexTest, addAttributes) {
+            AttributableNodeIndex index;
+
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("test", "somevalue");
+            entity1->addOrUpdateAttribute("target1", "sometarget");
+
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("test", "somevalue");
+            entity2->addOrUpdateAttribute("target2", "sometarget");
+
+            Entity* entity3 = new Entity();
+            entity3->addOrUpdateAttribute("test", "somevalue");
+            entity3->addOrUpdateAttribute("other", "somevalue");
+
+            index.addAttribute(entity1, "test", "somevalue");
+            index.addAttributes({
+                { entity2, "test", "somevalue" },
+                { entity3, "other", "somevalue" },
+                { entity1, "target1", "sometarget" },
+                { entity3, "test", "somevalue" },
+                { entity2, "target2", "sometarget" },
+            });
+
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1, entity2, entity3 }, findExactExact(index, "test", "somevalue"));
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity3 }, findExactExact(index, "other", "somevalue"));
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1, entity2 }, findNumberedExact(index, "target", "sometarget"));
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<std::string>{ "test", "other", "target1", "target2" }, index.allNames());
+
+            ASSERT_TRUE(index.removeAttribute(entity2, "test", "somevalue"));
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1, entity3 }, findExactExact(index, "test", "somevalue"));
+
+            delete entity1;
+            delete entity2;
+            delete entity3;
+        }
+
         TEST(EntityAttributeIndexTest, addNumberedEntityAttribute) {
             AttributableNodeIndex index;
 
@@ -165,6 +217,33 @@ namespace TrenchBroom {
         }
 
 
+        TEST(EntityAttributeIndexTest, findValuesLiterally) {
+            AttributableNodeIndex index;
+
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("target", "door*");
+
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("target", "door1");
+            entity2->addOrUpdateAttribute("target2", "door*");
+
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+
+            ASSERT_EQ(std::vector<AttributableNode*>{ entity1 }, findExactExact(index, "target", "door*"));
+            ASSERT_EQ(std::vector<AttributableNode*>{ entity2 }, findExactExact(index, "target", "door1"));
+            ASSERT_EQ(std::vector<AttributableNode*>{ entity2 }, findNumberedExact(index, "target", "door1"));
+            ASSERT_TRUE(findExactExact(index, "target", "door").empty());
+
+            std::vector<AttributableNode*> attributables = findNumberedExact(index, "target", "door*");
+            ASSERT_EQ(2u, attributables.size());
+            ASSERT_TRUE(kdl::vec_contains(attributables, entity1));
+            ASSERT_TRUE(kdl::vec_contains(attributables, entity2));
+
+            delete entity1;
+            delete entity2;
+        }
+
         TEST(EntityAttributeIndexTest, addRemoveFloatProperty) {
             AttributableNodeIndex index;
 
@@ -129,6 +129,40 @@ namespace TrenchBroom {
             ASSERT_EQ(source, sources.front());
         }
 
+        TEST(AttributableNodeLinkTest, testLoadLinkWithDeferredIndexUpdates) {
+            World world(MapFormat::Standard);
+            world.deferAttributeIndexUpdates();
+
+            Entity* source = world.createEntity();
+            Entity* target = world.createEntity();
+            Entity* removed = world.createEntity();
+
+            source->addOrUpdateAttribute(AttributeNames::Target, "target_name");
+            target->addOrUpdateAttribute(AttributeNames::Targetname, "target_name");
+            removed->addOrUpdateAttribute(AttributeNames::Targetname, "removed_name");
+
+            world.defaultLayer()->addChild(source);
+            world.defaultLayer()->addChild(removed);
+            world.defaultLayer()->addChild(target);
+            world.defaultLayer()->removeChild(removed);
+
+            world.resumeAttributeIndexUpdates();
+
+            const std::vector<AttributableNode*>& targets = source->linkTargets();
+            ASSERT_EQ(1u, targets.size());
+            ASSERT_EQ(target, targets.front());
+
+            const std::vector<AttributableNode*>& sources = target->linkSources();
+            ASSERT_EQ(1u, sources.size());
+            ASSERT_EQ(source, sources.front());
+
+            std::vector<AttributableNode*> found;
+            world.findAttributableNodesWithAttribute(AttributeNames::Targetname, "removed_name", found);
+            ASSERT_TRUE(found.empty());
+
+            delete removed;
+        }
+
         TEST(AttributableNodeLinkTest, testRemoveLinkByChangingSource) {
             World world(MapFormat::Standard);
             Entity* source = world.createEntity();
@@ -72,6 +72,42 @@ namespace TrenchBroom {
             ASSERT_THROW(new BrushFace(p0, p1, p2, attribs, std::make_unique<ParaxialTexCoordSystem>(p0, p1, p2, attribs)), GeometryException);
         }
 
+        static void assertBatchedTextureCoords(const BrushFace& face) {
+            const std::vector<vm::vec3> points {
+                vm::vec3(0.0, 0.0, 4.0),
+                vm::vec3(33.0, -17.0, 4.0),
+                vm::vec3(-128.0, 64.0, 4.0),
+                vm::vec3(1.5, 2.5, 4.0)
+            };
+
+            std::vector<vm::vec2f> texCoords;
+            face.textureCoords(points, texCoords);
+
+            ASSERT_EQ(points.size(), texCoords.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                ASSERT_VEC_EQ(face.textureCoords(points[i]), texCoords[i]);
+            }
+        }
+
+        TEST(BrushFaceTest, batchedTextureCoords) {
+            const vm::vec3 p0(0.0,  0.0, 4.0);
+            const vm::vec3 p1(1.0,  0.0, 4.0);
+            const vm::vec3 p2(0.0, -1.0, 4.0);
+            Assets::Texture texture("testTexture", 64, 32);
+
+            BrushFaceAttributes attribs("");
+            attribs.setTexture(&texture);
+            attribs.setXOffset(12.0f);
+            attribs.setScale(vm::vec2f(0.5f, 2.0f));
+            attribs.setRotation(30.0f);
+
+            const BrushFace paraxialFace(p0, p1, p2, attribs, std::make_unique<ParaxialTexCoordSystem>(p0, p1, p2, attribs));
+            assertBatchedTextureCoords(paraxialFace);
+
+            const BrushFace parallelFace(p0, p1, p2, attribs, std::make_unique<ParallelTexCoordSystem>(p0, p1, p2, attribs));
+            assertBatchedTextureCoords(parallelFace);
+        }
+
         TEST(BrushFaceTest, textureUsageCount) {
             const vm::vec3 p0(0.0,  0.0, 4.0);
             const vm::vec3 p1(1.0,  0.0, 4.0);
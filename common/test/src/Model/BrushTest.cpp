@@ -40,6 +40,8 @@
 #include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 #include <vecmath/ray.h>
@@ -768,6 +770,69 @@ namespace TrenchBroom {
             delete clone;
         }
 
+        TEST(BrushTest, cloneCopiesGeometry) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* original = builder.createBrush(std::vector<vm::vec3>{
+                vm::vec3(-32.0, -32.0, -32.0),
+                vm::vec3(+32.0, -32.0, -32.0),
+                vm::vec3(-32.0, +32.0, -32.0),
+                vm::vec3(+32.0, +32.0, -32.0),
+                vm::vec3(0.0, 0.0, +32.0),
+            }, "texture");
+
+            Brush* clone = original->clone(worldBounds);
+            EXPECT_EQ(original->logicalBounds(), clone->logicalBounds());
+            EXPECT_EQ(original->vertexCount(), clone->vertexCount());
+            for (const auto& position : original->vertexPositions()) {
+                EXPECT_TRUE(clone->hasVertex(position));
+            }
+
+            ASSERT_EQ(original->faceCount(), clone->faceCount());
+            for (const auto* face : clone->faces()) {
+                EXPECT_EQ(clone, face->brush());
+                ASSERT_NE(nullptr, face->geometry());
+                EXPECT_EQ(face, face->geometry()->payload());
+            }
+
+            delete clone;
+            delete original;
+        }
+
+        TEST(BrushTest, rigidTransformKeepsGeometryConsistent) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCube(64.0, "texture");
+            const auto transformation = vm::translation_matrix(vm::vec3(16.0, 32.0, -8.0)) * vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0));
+
+            std::vector<vm::vec3> expectedPositions;
+            for (const auto& position : brush->vertexPositions()) {
+                expectedPositions.push_back(transformation * position);
+            }
+
+            brush->transform(transformation, false, worldBounds);
+
+            EXPECT_EQ(expectedPositions.size(), brush->vertexCount());
+            for (const auto& position : expectedPositions) {
+                EXPECT_TRUE(brush->hasVertex(position, 0.0001));
+            }
+            EXPECT_TRUE(vm::is_equal(vm::bbox3(vm::vec3(-16.0, 0.0, -40.0), vm::vec3(48.0, 64.0, 24.0)), brush->logicalBounds(), 0.0001));
+
+            // the transformed geometry must match a geometry rebuilt from the transformed face planes
+            Brush* rebuilt = brush->clone(worldBounds);
+            EXPECT_EQ(rebuilt->vertexCount(), brush->vertexCount());
+            for (const auto& position : rebuilt->vertexPositions()) {
+                EXPECT_TRUE(brush->hasVertex(position, 0.0001));
+            }
+
+            delete rebuilt;
+            delete brush;
+        }
+
         TEST(BrushTest, clip) {
             const vm::bbox3 worldBounds(4096.0);
 
@@ -903,6 +968,40 @@ namespace TrenchBroom {
             delete brush;
         }
 
+        TEST(BrushTest, moveVertexAfterCheckingOtherMoves) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCube(64.0, "left", "right", "front", "back", "top", "bottom");
+
+            const vm::vec3 p8(+32.0, +32.0, +32.0);
+            const vm::vec3 p9(+16.0, +16.0, +32.0);
+            const vm::vec3 p10(+48.0, +48.0, +48.0);
+
+            // checking a move caches its result, which must not be used for a different move
+            ASSERT_TRUE(brush->canMoveVertices(worldBounds, std::vector<vm::vec3>(1, p8), p10 - p8));
+            ASSERT_TRUE(brush->canMoveVertices(worldBounds, std::vector<vm::vec3>(1, p8), p9 - p8));
+            ASSERT_TRUE(brush->canMoveVertices(worldBounds, std::vector<vm::vec3>(1, p8), p9 - p8));
+
+            std::vector<vm::vec3> newVertexPositions = brush->moveVertices(worldBounds, std::vector<vm::vec3>(1, p8), p9 - p8);
+            ASSERT_EQ(1u, newVertexPositions.size());
+            ASSERT_VEC_EQ(p9, newVertexPositions[0]);
+            ASSERT_EQ(8u, brush->vertexCount());
+            ASSERT_TRUE(brush->hasVertex(p9));
+
+            // the cached result of the previous check must not be used once the brush has changed
+            ASSERT_TRUE(brush->canMoveVertices(worldBounds, newVertexPositions, p8 - p9));
+
+            newVertexPositions = brush->moveVertices(worldBounds, newVertexPositions, p8 - p9);
+            ASSERT_EQ(1u, newVertexPositions.size());
+            ASSERT_VEC_EQ(p8, newVertexPositions[0]);
+            ASSERT_EQ(8u, brush->vertexCount());
+            ASSERT_TRUE(brush->hasVertex(p8));
+
+            delete brush;
+        }
+
         TEST(BrushTest, moveTetrahedronVertexToOpposideSide) {
             const vm::bbox3 worldBounds(4096.0);
             World world(MapFormat::Standard);
@@ -3458,6 +3557,34 @@ namespace TrenchBroom {
             EXPECT_FALSE(brush1->canMoveVertices(worldBounds, allVertexPositions, vm::vec3(8192, 0, 0)));
         }
 
+        TEST(BrushTest, intersectsAndContainsBrush) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* outer = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "texture");
+            Brush* inner = builder.createCuboid(vm::bbox3(vm::vec3(16, 16, 16), vm::vec3(48, 48, 48)), "texture");
+            Brush* overlapping = builder.createCuboid(vm::bbox3(vm::vec3(32, 32, 32), vm::vec3(96, 96, 96)), "texture");
+            Brush* distant = builder.createCuboid(vm::bbox3(vm::vec3(128, 128, 128), vm::vec3(192, 192, 192)), "texture");
+
+            EXPECT_TRUE(outer->contains(inner));
+            EXPECT_FALSE(inner->contains(outer));
+            EXPECT_FALSE(outer->contains(overlapping));
+            EXPECT_FALSE(outer->contains(distant));
+
+            EXPECT_TRUE(outer->intersects(inner));
+            EXPECT_TRUE(inner->intersects(outer));
+            EXPECT_TRUE(outer->intersects(overlapping));
+            EXPECT_TRUE(overlapping->intersects(outer));
+            EXPECT_FALSE(outer->intersects(distant));
+            EXPECT_FALSE(distant->intersects(outer));
+
+            delete outer;
+            delete inner;
+            delete overlapping;
+            delete distant;
+        }
+
         // https://github.com/kduske/TrenchBroom/issues/1893
         TEST(BrushTest, intersectsIssue1893) {
             const std::string data("{\n"
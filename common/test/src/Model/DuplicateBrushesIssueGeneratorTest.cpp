@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/DuplicateBrushesIssueGenerator.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static size_t countIssues(World& world, Brush* brush) {
+            return brush->issues(world.registeredIssueGenerators()).size();
+        }
+
+        TEST(DuplicateBrushesIssueGeneratorTest, findDuplicateBrushes) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            world.registerIssueGenerator(new DuplicateBrushesIssueGenerator());
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush1 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(32, 32, 32)), "texture");
+            Brush* brush2 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(32, 32, 32)), "other");
+            // intersects the other brushes, but has a different shape
+            Brush* brush3 = builder.createCuboid(vm::bbox3(vm::vec3(16, 0, 0), vm::vec3(48, 32, 32)), "texture");
+            // has the same shape as brush3, but is in a different place
+            Brush* brush4 = builder.createCuboid(vm::bbox3(vm::vec3(128, 0, 0), vm::vec3(160, 32, 32)), "texture");
+            world.defaultLayer()->addChildren(std::vector<Node*>{ brush1, brush2, brush3, brush4 });
+
+            ASSERT_EQ(1u, countIssues(world, brush1));
+            ASSERT_EQ(1u, countIssues(world, brush2));
+            ASSERT_EQ(0u, countIssues(world, brush3));
+            ASSERT_EQ(0u, countIssues(world, brush4));
+        }
+
+        TEST(DuplicateBrushesIssueGeneratorTest, updateIssuesWhenNeighbourMoves) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            world.registerIssueGenerator(new DuplicateBrushesIssueGenerator());
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(32, 32, 32)), "texture");
+            Brush* neighbour = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(32, 32, 32)), "texture");
+            world.defaultLayer()->addChildren(std::vector<Node*>{ brush, neighbour });
+            ASSERT_EQ(1u, countIssues(world, brush));
+
+            // moving the neighbour away invalidates the issues of the brush at the neighbour's old position
+            neighbour->transform(vm::translation_matrix(vm::vec3(64, 0, 0)), false, worldBounds);
+            ASSERT_EQ(0u, countIssues(world, brush));
+            ASSERT_EQ(0u, countIssues(world, neighbour));
+
+            // moving it back invalidates the issues of the brush at the neighbour's new position
+            neighbour->transform(vm::translation_matrix(vm::vec3(-64, 0, 0)), false, worldBounds);
+            ASSERT_EQ(1u, countIssues(world, brush));
+            ASSERT_EQ(1u, countIssues(world, neighbour));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/EntityAttributes.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static std::vector<std::string> attributeValues(const EntityAttributes& attributes) {
+            std::vector<std::string> result;
+            for (const auto& attribute : attributes.attributes()) {
+                result.push_back(attribute.value());
+            }
+            return result;
+        }
+
+        TEST(EntityAttributesTest, setAttributesKeepsFirstOfDuplicates) {
+            EntityAttributes attributes;
+            attributes.setAttributes({
+                EntityAttribute("origin", "1"),
+                EntityAttribute("classname", "2"),
+                EntityAttribute("origin", "3"),
+                EntityAttribute("angle", "4"),
+                EntityAttribute("classname", "5")
+            });
+
+            ASSERT_EQ(std::vector<std::string>({ "origin", "classname", "angle" }), attributes.names());
+            ASSERT_EQ(std::vector<std::string>({ "1", "2", "4" }), attributeValues(attributes));
+
+            ASSERT_EQ("1", *attributes.attribute("origin"));
+            ASSERT_EQ("2", *attributes.attribute("classname"));
+            ASSERT_EQ("4", *attributes.attribute("angle"));
+            ASSERT_EQ(nullptr, attributes.attribute("target"));
+        }
+
+        TEST(EntityAttributesTest, addOrUpdateAttribute) {
+            EntityAttributes attributes;
+            attributes.addOrUpdateAttribute("target", "a", nullptr);
+            attributes.addOrUpdateAttribute("classname", "b", nullptr);
+            attributes.addOrUpdateAttribute("origin", "c", nullptr);
+            attributes.addOrUpdateAttribute("classname", "d", nullptr);
+
+            // attributes keep the order in which they were added
+            ASSERT_EQ(std::vector<std::string>({ "target", "classname", "origin" }), attributes.names());
+            ASSERT_EQ(std::vector<std::string>({ "a", "d", "c" }), attributeValues(attributes));
+
+            ASSERT_TRUE(attributes.hasAttribute("classname"));
+            ASSERT_TRUE(attributes.hasAttribute("classname", "d"));
+            ASSERT_FALSE(attributes.hasAttribute("classname", "b"));
+            ASSERT_FALSE(attributes.hasAttribute("angle"));
+        }
+
+        TEST(EntityAttributesTest, removeAttribute) {
+            EntityAttributes attributes;
+            attributes.addOrUpdateAttribute("target", "a", nullptr);
+            attributes.addOrUpdateAttribute("classname", "b", nullptr);
+            attributes.addOrUpdateAttribute("origin", "c", nullptr);
+            attributes.addOrUpdateAttribute("angle", "d", nullptr);
+
+            attributes.removeAttribute("classname");
+            attributes.removeAttribute("spawnflags");
+
+            ASSERT_EQ(std::vector<std::string>({ "target", "origin", "angle" }), attributes.names());
+            ASSERT_EQ(nullptr, attributes.attribute("classname"));
+            ASSERT_EQ("a", *attributes.attribute("target"));
+            ASSERT_EQ("c", *attributes.attribute("origin"));
+            ASSERT_EQ("d", *attributes.attribute("angle"));
+
+            attributes.removeAttribute("target");
+            attributes.addOrUpdateAttribute("classname", "e", nullptr);
+
+            ASSERT_EQ(std::vector<std::string>({ "origin", "angle", "classname" }), attributes.names());
+            ASSERT_EQ("c", *attributes.attribute("origin"));
+            ASSERT_EQ("d", *attributes.attribute("angle"));
+            ASSERT_EQ("e", *attributes.attribute("classname"));
+        }
+
+        TEST(EntityAttributesTest, renameAttribute) {
+            EntityAttributes attributes;
+            attributes.addOrUpdateAttribute("target", "a", nullptr);
+            attributes.addOrUpdateAttribute("classname", "b", nullptr);
+
+            attributes.renameAttribute("target", "targetname", nullptr);
+
+            ASSERT_EQ(std::vector<std::string>({ "classname", "targetname" }), attributes.names());
+            ASSERT_EQ(nullptr, attributes.attribute("target"));
+            ASSERT_EQ("a", *attributes.attribute("targetname"));
+            ASSERT_EQ(1u, attributes.attributeWithName("targetname").size());
+        }
+    }
+}
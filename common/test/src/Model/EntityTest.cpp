@@ -21,6 +21,10 @@
 
 #include <memory>
 
+#include "Assets/EntityDefinition.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/ELParser.h"
+#include "IO/Path.h"
 #include "Model/Entity.h"
 #include "Model/EntityAttributes.h"
 #include "Model/MapFormat.h"
@@ -98,6 +102,26 @@ namespace TrenchBroom {
             EXPECT_EQ(newBounds, m_entity->logicalBounds());
         }
 
+        TEST_F(EntityTest, modelSpecificationFollowsReferencedAttributes) {
+            auto definition = Assets::PointEntityDefinition(TestClassname, Color(), vm::bbox3(8.0), "", {},
+                Assets::ModelDefinition(IO::ELParser::parseStrict(R"({{ spawnflags == 1 -> "maps/b_shell1.bsp", "maps/b_shell0.bsp" }})")));
+            m_entity->setDefinition(&definition);
+
+            EXPECT_EQ(Assets::ModelSpecification(IO::Path("maps/b_shell0.bsp")), m_entity->modelSpecification());
+
+            m_entity->addOrUpdateAttribute("targetname", "something");
+            EXPECT_EQ(Assets::ModelSpecification(IO::Path("maps/b_shell0.bsp")), m_entity->modelSpecification());
+
+            m_entity->addOrUpdateAttribute("spawnflags", "1");
+            EXPECT_EQ(Assets::ModelSpecification(IO::Path("maps/b_shell1.bsp")), m_entity->modelSpecification());
+
+            m_entity->removeAttribute("spawnflags");
+            EXPECT_EQ(Assets::ModelSpecification(IO::Path("maps/b_shell0.bsp")), m_entity->modelSpecification());
+
+            m_entity->setDefinition(nullptr);
+            EXPECT_EQ(Assets::ModelSpecification(), m_entity->modelSpecification());
+        }
+
         TEST_F(EntityTest, requiresClassnameForRotation) {
             m_world->defaultLayer()->addChild(m_entity);
             m_entity->removeAttribute(AttributeNames::Classname);
@@ -75,7 +75,7 @@ namespace TrenchBroom {
             worldspawn.addOrUpdateAttribute("_tb_textures", textureCollections.front().asString());
 
             auto textureManager = Assets::TextureManager(0, 0, logger);
-            game.loadTextureCollections(worldspawn, IO::Path(), textureManager, logger);
+            game.loadTextureCollections(worldspawn, IO::Path(), textureManager, false, logger);
 
             ASSERT_EQ(1u, textureManager.collections().size());
 
@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Group.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(GroupTest, updateBoundsWhenAddingAndRemovingChildren) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            Group group("group");
+            Brush* inner = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)), "texture");
+            Brush* outer = builder.createCuboid(vm::bbox3(vm::vec3(-32, -32, -32), vm::vec3(64, 64, 64)), "texture");
+
+            group.addChild(inner);
+            EXPECT_EQ(inner->logicalBounds(), group.logicalBounds());
+
+            group.addChild(outer);
+            EXPECT_EQ(outer->logicalBounds(), group.logicalBounds());
+            EXPECT_EQ(outer->physicalBounds(), group.physicalBounds());
+
+            // removing a child that does not touch the group's bounds does not change them
+            group.removeChild(inner);
+            EXPECT_EQ(outer->logicalBounds(), group.logicalBounds());
+
+            group.addChild(inner);
+            group.removeChild(outer);
+            EXPECT_EQ(inner->logicalBounds(), group.logicalBounds());
+            EXPECT_EQ(inner->physicalBounds(), group.physicalBounds());
+
+            delete outer;
+        }
+
+        TEST(GroupTest, updateBoundsWhenDescendantChanges) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            Group outerGroup("outer");
+            Group* innerGroup = new Group("inner");
+            Brush* movedBrush = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)), "texture");
+            Brush* otherBrush = builder.createCuboid(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(0, 0, 0)), "texture");
+
+            innerGroup->addChild(movedBrush);
+            innerGroup->addChild(otherBrush);
+            outerGroup.addChild(innerGroup);
+            ASSERT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(16, 16, 16)), outerGroup.logicalBounds());
+
+            // growing the bounds
+            movedBrush->transform(vm::translation_matrix(vm::vec3(32, 0, 0)), false, worldBounds);
+            EXPECT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(48, 16, 16)), innerGroup->logicalBounds());
+            EXPECT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(48, 16, 16)), outerGroup.logicalBounds());
+            EXPECT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(48, 16, 16)), outerGroup.physicalBounds());
+
+            // shrinking the bounds
+            movedBrush->transform(vm::translation_matrix(vm::vec3(-40, 0, 0)), false, worldBounds);
+            EXPECT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(8, 16, 16)), innerGroup->logicalBounds());
+            EXPECT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(8, 16, 16)), outerGroup.logicalBounds());
+            EXPECT_EQ(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(8, 16, 16)), outerGroup.physicalBounds());
+        }
+    }
+}
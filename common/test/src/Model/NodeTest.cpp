@@ -20,9 +20,12 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "Model/IssueGenerator.h"
+#include "Model/LockState.h"
 #include "Model/Node.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PickResult.h"
+#include "Model/VisibilityState.h"
 
 #include <kdl/vector_utils.h>
 
@@ -197,6 +200,27 @@ namespace TrenchBroom {
             }
         };
 
+        class TestIssueGenerator : public IssueGenerator {
+        public:
+            TestIssueGenerator() :
+            IssueGenerator(0, "Test") {}
+        };
+
+        /**
+         * Invalidates its issues while they are generated for the first time, like a node whose neighbour changes
+         * while its issues are generated.
+         */
+        class SelfInvalidatingNode : public TestNode {
+        public:
+            size_t generateCount = 0u;
+        private:
+            void doGenerateIssues(const IssueGenerator* /* generator */, std::vector<Issue*>& /* issues */) override {
+                if (generateCount++ == 0u) {
+                    invalidateIssues();
+                }
+            }
+        };
+
         TEST(NodeTest, destroyChild) {
             using namespace ::testing;
 
@@ -440,5 +464,58 @@ namespace TrenchBroom {
             ASSERT_TRUE(grandChild1_1->isDescendantOf(std::vector<Node*>{ &root, child1, child2, grandChild1_1, grandChild1_2 }));
             ASSERT_TRUE(grandChild1_1->isDescendantOf(std::vector<Node*>{ &root, child1, child2, grandChild1_1, grandChild1_2 }));
         }
+
+        TEST(NodeTest, inheritVisibilityAndLockState) {
+            TestNode root;
+            TestNode* child = new TestNode();
+            TestNode* grandChild = new TestNode();
+
+            root.addChild(child);
+            child->addChild(grandChild);
+            ASSERT_TRUE(grandChild->visible());
+            ASSERT_TRUE(grandChild->editable());
+
+            root.setVisibilityState(VisibilityState::Visibility_Hidden);
+            root.setLockState(LockState::Lock_Locked);
+            ASSERT_FALSE(child->visible());
+            ASSERT_FALSE(grandChild->visible());
+            ASSERT_FALSE(child->editable());
+            ASSERT_FALSE(grandChild->editable());
+
+            child->setVisibilityState(VisibilityState::Visibility_Shown);
+            child->setLockState(LockState::Lock_Unlocked);
+            ASSERT_TRUE(grandChild->visible());
+            ASSERT_TRUE(grandChild->editable());
+
+            grandChild->setVisibilityState(VisibilityState::Visibility_Hidden);
+            ASSERT_FALSE(grandChild->visible());
+            ASSERT_TRUE(child->visible());
+
+            TestNode* orphan = new TestNode();
+            root.addChild(orphan);
+            ASSERT_FALSE(orphan->visible());
+            ASSERT_FALSE(orphan->editable());
+
+            root.removeChild(orphan);
+            ASSERT_TRUE(orphan->visible());
+            ASSERT_TRUE(orphan->editable());
+            delete orphan;
+        }
+
+        TEST(NodeTest, keepIssuesInvalidatedWhileGenerating) {
+            TestIssueGenerator generator;
+            const std::vector<IssueGenerator*> generators{ &generator };
+
+            SelfInvalidatingNode node;
+            node.issues(generators);
+            ASSERT_EQ(1u, node.generateCount);
+
+            // the invalidation while the issues were generated is not lost
+            node.issues(generators);
+            ASSERT_EQ(2u, node.generateCount);
+
+            node.issues(generators);
+            ASSERT_EQ(2u, node.generateCount);
+        }
     }
 }
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeTraversal.h"
+#include "Model/World.h"
+
+#include <iterator>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(NodeTraversalTest, forEachNodeOfType) {
+            World world(MapFormat::Standard);
+            auto* layer = world.defaultLayer();
+            auto* group = new Group("group");
+            auto* entity1 = new Entity();
+            auto* entity2 = new Entity();
+            layer->addChild(group);
+            layer->addChild(entity1);
+            group->addChild(entity2);
+
+            std::vector<Entity*> entities;
+            ASSERT_TRUE(forEachNodeOfType<Entity>(&world, [&](Entity* entity) {
+                entities.push_back(entity);
+                return true;
+            }));
+            ASSERT_EQ((std::vector<Entity*>{ entity2, entity1 }), entities);
+
+            std::vector<Node*> nodes;
+            ASSERT_TRUE(forEachNodeOfType<Node>(layer, [&](Node* node) {
+                nodes.push_back(node);
+                return true;
+            }));
+            ASSERT_EQ((std::vector<Node*>{ layer, group, entity2, entity1 }), nodes);
+
+            entities.clear();
+            ASSERT_FALSE(forEachNodeOfType<Entity>(&world, [&](Entity* entity) {
+                entities.push_back(entity);
+                return false;
+            }));
+            ASSERT_EQ((std::vector<Entity*>{ entity2 }), entities);
+        }
+
+        TEST(NodeTraversalTest, collectSelectedNodesOfType) {
+            World world(MapFormat::Standard);
+            auto* layer = world.defaultLayer();
+            auto* group = new Group("group");
+            auto* entity1 = new Entity();
+            auto* entity2 = new Entity();
+            auto* entity3 = new Entity();
+            layer->addChild(group);
+            layer->addChild(entity1);
+            layer->addChild(entity3);
+            group->addChild(entity2);
+
+            entity1->select();
+            entity2->select();
+
+            const std::vector<Node*> roots{ layer };
+
+            std::vector<Entity*> entities;
+            collectSelectedNodesOfType<Entity>(std::begin(roots), std::end(roots), std::back_inserter(entities));
+            ASSERT_EQ((std::vector<Entity*>{ entity2, entity1 }), entities);
+
+            group->select();
+            std::vector<Node*> nodes;
+            collectSelectedNodesOfType<Node>(std::begin(roots), std::end(roots), std::back_inserter(nodes));
+            ASSERT_EQ((std::vector<Node*>{ group, entity2, entity1 }), nodes);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/OrientationPredicates.h"
+
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <random>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(OrientationPredicatesTest, orientation) {
+            const vm::vec3d a(0.0, 0.0, 0.0);
+            const vm::vec3d b(1.0, 0.0, 0.0);
+            const vm::vec3d c(0.0, 1.0, 0.0);
+
+            ASSERT_EQ(+1, orientation(a, b, c, vm::vec3d(0.0, 0.0, +1.0)));
+            ASSERT_EQ(-1, orientation(a, b, c, vm::vec3d(0.0, 0.0, -1.0)));
+            ASSERT_EQ( 0, orientation(a, b, c, vm::vec3d(3.0, 7.0, 0.0)));
+
+            // a degenerate plane
+            ASSERT_EQ( 0, orientation(a, b, vm::vec3d(2.0, 0.0, 0.0), vm::vec3d(0.0, 0.0, 1.0)));
+        }
+
+        TEST(OrientationPredicatesTest, orientationOfNearlyCoplanarPoints) {
+            // Points with large integer coordinates on the plane x + 3y - 7z = 123456789. Evaluating the orientation
+            // naively in floating point gives a nonzero result for most of these because the products are not exact.
+            std::mt19937_64 rng(0);
+            std::uniform_int_distribution<int64_t> dist(-(int64_t(1) << 30), int64_t(1) << 30);
+            const auto makePoint = [&]() {
+                const auto y = dist(rng);
+                const auto z = dist(rng);
+                const auto x = 123456789 - 3 * y + 7 * z;
+                return vm::vec3d(static_cast<double>(x), static_cast<double>(y), static_cast<double>(z));
+            };
+
+            for (size_t i = 0; i < 1000; ++i) {
+                const auto a = makePoint();
+                const auto b = makePoint();
+                const auto c = makePoint();
+                const auto d = makePoint();
+
+                ASSERT_EQ(0, orientation(a, b, c, d));
+
+                // moving the point off the plane by one unit must be detected, and both directions must differ
+                const auto above = orientation(a, b, c, d + vm::vec3d(1.0, 0.0, 0.0));
+                const auto below = orientation(a, b, c, d - vm::vec3d(1.0, 0.0, 0.0));
+                ASSERT_NE(0, above);
+                ASSERT_EQ(-above, below);
+                ASSERT_EQ(above, orientation(a, b, c, d + vm::vec3d(1000000.0, 0.0, 0.0)));
+            }
+        }
+    }
+}
@@ -32,6 +32,7 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <cmath>
 #include <iterator>
 #include <tuple>
 
@@ -1406,6 +1407,137 @@ TEST(PolyhedronTest, testWeaveSimpleCap) {
             }
         };
 
+        TEST(PolyhedronTest, convexHullOfManyPointsInCube) {
+            std::vector<vm::vec3d> points;
+            for (int x = -4; x <= 4; ++x) {
+                for (int y = -4; y <= 4; ++y) {
+                    for (int z = -4; z <= 4; ++z) {
+                        points.push_back(vm::vec3d(x, y, z) * 16.0);
+                    }
+                }
+            }
+
+            const Polyhedron3d p(points);
+            ASSERT_TRUE(p.checkInvariant());
+            ASSERT_EQ(Polyhedron3d(vm::bbox3d(64.0)), p);
+        }
+
+        TEST(PolyhedronTest, convexHullOfManyPointsOnSphere) {
+            // points on a Fibonacci sphere are all vertices of the convex hull
+            const size_t count = 200u;
+            const double goldenAngle = vm::C::pi() * (3.0 - std::sqrt(5.0));
+
+            std::vector<vm::vec3d> points;
+            for (size_t i = 0u; i < count; ++i) {
+                const double z = 1.0 - 2.0 * (static_cast<double>(i) + 0.5) / static_cast<double>(count);
+                const double r = std::sqrt(1.0 - z * z);
+                const double phi = goldenAngle * static_cast<double>(i);
+                points.push_back(vm::vec3d(r * std::cos(phi), r * std::sin(phi), z) * 256.0);
+            }
+
+            const Polyhedron3d p(points);
+            ASSERT_TRUE(p.checkInvariant());
+            ASSERT_EQ(count, p.vertexCount());
+
+            Polyhedron3d sequential;
+            for (const auto& point : points) {
+                sequential.addPoint(point);
+            }
+            ASSERT_EQ(sequential, p);
+        }
+
+        TEST(PolyhedronTest, buildCubeFromPlanes) {
+            const std::vector<vm::plane3d> planes {
+                vm::plane3d(64.0, vm::vec3d::pos_x()),
+                vm::plane3d(64.0, vm::vec3d::neg_x()),
+                vm::plane3d(64.0, vm::vec3d::pos_y()),
+                vm::plane3d(64.0, vm::vec3d::neg_y()),
+                vm::plane3d(64.0, vm::vec3d::pos_z()),
+                vm::plane3d(64.0, vm::vec3d::neg_z()),
+            };
+
+            Polyhedron3d p;
+            std::vector<PFace*> faces;
+            ASSERT_TRUE(p.buildFromPlanes(planes, faces));
+            ASSERT_TRUE(p.checkInvariant());
+
+            ASSERT_EQ(8u, p.vertexCount());
+            ASSERT_EQ(12u, p.edgeCount());
+            ASSERT_EQ(6u, p.faceCount());
+            ASSERT_EQ(vm::bbox3d(64.0), p.bounds());
+
+            ASSERT_EQ(planes.size(), faces.size());
+            for (size_t i = 0; i < planes.size(); ++i) {
+                ASSERT_NE(nullptr, faces[i]);
+                ASSERT_EQ(planes[i].normal, faces[i]->normal());
+            }
+
+            const Polyhedron3d clipped(vm::bbox3d(64.0));
+            ASSERT_EQ(clipped, p);
+        }
+
+        TEST(PolyhedronTest, buildPyramidFromPlanes) {
+            // the apex is incident to four planes
+            const std::vector<vm::plane3d> planes {
+                vm::plane3d(vm::vec3d::zero(), vm::vec3d::neg_z()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 32.0), vm::normalize(vm::vec3d(+1.0, 0.0, 1.0))),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 32.0), vm::normalize(vm::vec3d(-1.0, 0.0, 1.0))),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 32.0), vm::normalize(vm::vec3d(0.0, +1.0, 1.0))),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 32.0), vm::normalize(vm::vec3d(0.0, -1.0, 1.0))),
+            };
+
+            Polyhedron3d p;
+            std::vector<PFace*> faces;
+            ASSERT_TRUE(p.buildFromPlanes(planes, faces));
+            ASSERT_TRUE(p.checkInvariant());
+
+            ASSERT_EQ(5u, p.vertexCount());
+            ASSERT_EQ(8u, p.edgeCount());
+            ASSERT_EQ(5u, p.faceCount());
+            ASSERT_TRUE(hasVertex(p, vm::vec3d(0.0, 0.0, 32.0), 0.001));
+            ASSERT_TRUE(hasQuadOf(p,
+                                  vm::vec3d(-32.0, -32.0, 0.0),
+                                  vm::vec3d(-32.0, +32.0, 0.0),
+                                  vm::vec3d(+32.0, +32.0, 0.0),
+                                  vm::vec3d(+32.0, -32.0, 0.0), 0.001));
+        }
+
+        TEST(PolyhedronTest, buildFromPlanesIgnoresDuplicateAndRedundantPlanes) {
+            const std::vector<vm::plane3d> planes {
+                vm::plane3d(64.0, vm::vec3d::pos_x()),
+                vm::plane3d(64.0, vm::vec3d::neg_x()),
+                vm::plane3d(64.0, vm::vec3d::pos_y()),
+                vm::plane3d(64.0, vm::vec3d::neg_y()),
+                vm::plane3d(64.0, vm::vec3d::pos_z()),
+                vm::plane3d(64.0, vm::vec3d::neg_z()),
+                vm::plane3d(64.0, vm::vec3d::pos_z()),
+                vm::plane3d(128.0, vm::vec3d::pos_z()),
+            };
+
+            Polyhedron3d p;
+            std::vector<PFace*> faces;
+            ASSERT_TRUE(p.buildFromPlanes(planes, faces));
+            ASSERT_EQ(6u, p.faceCount());
+            ASSERT_NE(nullptr, faces[4]);
+            ASSERT_EQ(nullptr, faces[6]);
+            ASSERT_EQ(nullptr, faces[7]);
+        }
+
+        TEST(PolyhedronTest, buildFromPlanesFailsIfUnbounded) {
+            const std::vector<vm::plane3d> planes {
+                vm::plane3d(64.0, vm::vec3d::pos_x()),
+                vm::plane3d(64.0, vm::vec3d::neg_x()),
+                vm::plane3d(64.0, vm::vec3d::pos_y()),
+                vm::plane3d(64.0, vm::vec3d::neg_y()),
+                vm::plane3d(64.0, vm::vec3d::pos_z()),
+            };
+
+            Polyhedron3d p;
+            std::vector<PFace*> faces;
+            ASSERT_FALSE(p.buildFromPlanes(planes, faces));
+            ASSERT_TRUE(p.empty());
+        }
+
         TEST(PolyhedronTest, clipCubeWithHorizontalPlane) {
             const vm::vec3d p1(-64.0, -64.0, -64.0);
             const vm::vec3d p2(-64.0, -64.0, +64.0);
@@ -76,7 +76,7 @@ namespace TrenchBroom {
             return std::make_unique<World>(format);
         }
 
-        std::unique_ptr<World> TestGame::doLoadMap(const MapFormat format, const vm::bbox3& /* worldBounds */, const IO::Path& /* path */, Logger& /* logger */) const {
+        std::unique_ptr<World> TestGame::doLoadMap(const MapFormat format, const vm::bbox3& /* worldBounds */, const IO::Path& /* path */, const bool /* useMapCache */, Logger& /* logger */) const {
             return std::make_unique<World>(format);
         }
 
@@ -90,6 +90,17 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        std::string TestGame::doSerializeMap(World& world) const {
+            const auto mapFormatName = formatName(world.format());
+
+            std::string result;
+            IO::writeGameComment(result, gameName(), mapFormatName);
+
+            IO::NodeWriter writer(world, result);
+            writer.writeMap();
+            return result;
+        }
+
         void TestGame::doExportMap(World& /* world */, const Model::ExportFormat /* format */, const IO::Path& /* path */) const {}
 
         std::vector<Node*> TestGame::doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& /* logger */) const {
@@ -118,7 +129,7 @@ namespace TrenchBroom {
             return TexturePackageType::File;
         }
 
-        void TestGame::doLoadTextureCollections(AttributableNode& node, const IO::Path& /* documentPath */, Assets::TextureManager& textureManager, Logger& logger) const {
+        void TestGame::doLoadTextureCollections(AttributableNode& node, const IO::Path& /* documentPath */, Assets::TextureManager& textureManager, const bool /* useTextureCache */, Logger& logger) const {
             const std::vector<IO::Path> paths = extractTextureCollections(node);
 
             const IO::Path root = IO::Disk::getCurrentWorkingDir();
@@ -54,8 +54,9 @@ namespace TrenchBroom {
             const std::vector<SmartTag>& doSmartTags() const override;
 
             std::unique_ptr<World> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const override;
-            std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const override;
+            std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const override;
             void doWriteMap(World& world, const IO::Path& path) const override;
+            std::string doSerializeMap(World& world) const override;
             void doExportMap(World& world, Model::ExportFormat format, const IO::Path& path) const override;
 
             std::vector<Node*> doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const override;
@@ -64,7 +65,7 @@ namespace TrenchBroom {
             void doWriteBrushFacesToStream(World& world, const std::vector<BrushFace*>& faces, std::ostream& stream) const override;
 
             TexturePackageType doTexturePackageType() const override;
-            void doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const override;
+            void doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, bool useTextureCache, Logger& logger) const override;
             bool doIsTextureCollection(const IO::Path& path) const override;
             std::vector<IO::Path> doFindTextureCollections() const override;
             std::vector<IO::Path> doExtractTextureCollections(const AttributableNode& node) const override;
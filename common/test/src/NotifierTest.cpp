@@ -22,6 +22,9 @@
 
 #include "Notifier.h"
 
+#include <thread>
+#include <vector>
+
 namespace TrenchBroom {
     class Observed {
     public:
@@ -114,4 +117,37 @@ namespace TrenchBroom {
         obs.notify1(2);
         obs.notify2(1, 2);
     }
+
+    TEST(NotifierTest, testPostFromOtherThreads) {
+        Observer o;
+
+        QueuedNotifier<const int&> notifier;
+        notifier.addObserver(&o, &Observer::notify1);
+
+        size_t wakeups = 0u;
+        notifier.setWakeup([&]() { ++wakeups; });
+
+        EXPECT_CALL(o, notify1(1)).Times(400);
+        EXPECT_CALL(o, notify1(2));
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0u; i < 4u; ++i) {
+            threads.emplace_back([&]() {
+                for (size_t j = 0u; j < 100u; ++j) {
+                    notifier.post(1);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(1u, wakeups);
+        ASSERT_EQ(400u, notifier.dispatch());
+        ASSERT_EQ(0u, notifier.dispatch());
+
+        // synchronous notification bypasses the queue
+        notifier.notify(2);
+        ASSERT_EQ(0u, notifier.dispatch());
+    }
 }
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ProjectedGrid.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace TrenchBroom {
+    static std::vector<int> find(const ProjectedGrid<int>& grid, const size_t axis, const vm::bbox3& bounds) {
+        std::vector<int> result;
+        grid.find(axis, bounds, std::back_inserter(result));
+        std::sort(std::begin(result), std::end(result));
+        return result;
+    }
+
+    TEST(ProjectedGridTest, findIgnoresProjectionAxis) {
+        ProjectedGrid<int> grid(16.0);
+        grid.insert(vm::vec3(0, 0, 0), 1);
+        grid.insert(vm::vec3(0, 0, 1000), 2);
+        grid.insert(vm::vec3(100, 0, 0), 3);
+
+        const auto bounds = vm::bbox3(vm::vec3(-8, -8, 0), vm::vec3(8, 8, 0));
+        ASSERT_EQ(std::vector<int>({ 1, 2 }), find(grid, 2, bounds));
+        ASSERT_EQ(std::vector<int>({ 1 }), find(grid, 1, bounds));
+        ASSERT_EQ(std::vector<int>({ 1, 3 }), find(grid, 0, bounds));
+    }
+
+    TEST(ProjectedGridTest, findSkipsCellsOutsideBounds) {
+        ProjectedGrid<int> grid(16.0);
+        int value = 0;
+        for (int x = -4; x <= 4; ++x) {
+            for (int y = -4; y <= 4; ++y) {
+                grid.insert(vm::vec3(x * 32 + 1, y * 32 + 1, 0), value++);
+            }
+        }
+
+        // a box covering the nine points with x and y in [-32, 32]
+        const auto result = find(grid, 2, vm::bbox3(vm::vec3(-33, -33, 0), vm::vec3(34, 34, 0)));
+        ASSERT_EQ(std::vector<int>({ 30, 31, 32, 39, 40, 41, 48, 49, 50 }), result);
+    }
+
+    TEST(ProjectedGridTest, removeAndClear) {
+        ProjectedGrid<int> grid;
+        const auto bounds = vm::bbox3(vm::vec3(-1, -1, -1), vm::vec3(1, 1, 1));
+
+        grid.insert(vm::vec3(0, 0, 0), 1);
+        grid.insert(vm::vec3(0, 0, 0), 1);
+        grid.insert(vm::vec3(0, 0, 0), 2);
+
+        grid.remove(vm::vec3(0, 0, 0), 1);
+        ASSERT_EQ(std::vector<int>({ 1, 2 }), find(grid, 0, bounds));
+
+        grid.remove(vm::vec3(0, 0, 0), 1);
+        ASSERT_EQ(std::vector<int>({ 2 }), find(grid, 1, bounds));
+
+        grid.clear();
+        ASSERT_TRUE(find(grid, 2, bounds).empty());
+    }
+
+    TEST(ProjectedGridTest, ignoresNonFinitePositions) {
+        ProjectedGrid<int> grid;
+        grid.insert(vm::vec3::nan(), 1);
+        ASSERT_TRUE(find(grid, 2, vm::bbox3(1.0e10)).empty());
+    }
+}
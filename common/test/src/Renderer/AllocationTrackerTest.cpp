@@ -20,6 +20,8 @@
 #include <gtest/gtest.h>
 #include <random>
 #include <algorithm>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "Renderer/AllocationTracker.h"
@@ -244,6 +246,118 @@ namespace TrenchBroom {
             }
         }
 
+        TEST(AllocationTrackerTest, compact) {
+            AllocationTracker t(500);
+
+            AllocationTracker::Block* blocks[5];
+            for (size_t i = 0; i < 5; ++i) {
+                blocks[i] = t.allocate(100);
+                ASSERT_NE(nullptr, blocks[i]);
+            }
+
+            t.free(blocks[0]);
+            t.free(blocks[2]);
+
+            std::vector<std::pair<AllocationTracker::Range, AllocationTracker::Index>> moves;
+            const auto moved = t.compact(1000, [&](const AllocationTracker::Block* block, const AllocationTracker::Index oldPos) {
+                moves.push_back({AllocationTracker::Range{block->pos, block->size}, oldPos});
+            });
+
+            EXPECT_EQ(300u, moved);
+            EXPECT_EQ((std::vector<std::pair<AllocationTracker::Range, AllocationTracker::Index>>{
+                {{0, 100}, 100},
+                {{100, 100}, 300},
+                {{200, 100}, 400}
+            }), moves);
+
+            EXPECT_EQ(0u, blocks[1]->pos);
+            EXPECT_EQ(100u, blocks[3]->pos);
+            EXPECT_EQ(200u, blocks[4]->pos);
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 100}, {100, 100}, {200, 100}}), t.usedBlocks());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{300, 200}}), t.freeBlocks());
+            EXPECT_EQ(200u, t.largestPossibleAllocation());
+
+            // nothing left to compact
+            EXPECT_EQ(0u, t.compact(1000, [](const AllocationTracker::Block*, const AllocationTracker::Index) {}));
+        }
+
+        TEST(AllocationTrackerTest, compactWithBudget) {
+            AllocationTracker t(400);
+
+            AllocationTracker::Block* blocks[4];
+            for (size_t i = 0; i < 4; ++i) {
+                blocks[i] = t.allocate(100);
+                ASSERT_NE(nullptr, blocks[i]);
+            }
+
+            t.free(blocks[0]);
+
+            const auto noop = [](const AllocationTracker::Block*, const AllocationTracker::Index) {};
+            EXPECT_EQ(100u, t.compact(50, noop));
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 100}, {200, 100}, {300, 100}}), t.usedBlocks());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{100, 100}}), t.freeBlocks());
+
+            EXPECT_EQ(200u, t.compact(1000, noop));
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 100}, {100, 100}, {200, 100}}), t.usedBlocks());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{300, 100}}), t.freeBlocks());
+
+            // the tracker is still usable after compacting
+            t.free(blocks[2]);
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{100, 100}, {300, 100}}), t.freeBlocks());
+            ASSERT_NE(nullptr, t.allocate(100));
+        }
+
+        TEST(AllocationTrackerTest, compactBlocksWithoutIndices) {
+            // a brush renderer may retain vertex blocks for brushes whose indices have not been created yet; such
+            // blocks are moved like all others, and their new position is used once the indices are created
+            AllocationTracker t(400);
+
+            AllocationTracker::Block* blocks[4];
+            for (size_t i = 0; i < 4; ++i) {
+                blocks[i] = t.allocate(100);
+                ASSERT_NE(nullptr, blocks[i]);
+            }
+
+            t.free(blocks[0]);
+
+            std::map<const AllocationTracker::Block*, AllocationTracker::Index> indexBases = {
+                { blocks[1], blocks[1]->pos },
+                { blocks[3], blocks[3]->pos }
+            };
+
+            EXPECT_EQ(300u, t.compact(1000, [&](const AllocationTracker::Block* block, const AllocationTracker::Index oldPos) {
+                auto it = indexBases.find(block);
+                if (it != std::end(indexBases)) {
+                    EXPECT_EQ(it->second, oldPos);
+                    it->second = block->pos;
+                }
+            }));
+
+            EXPECT_EQ(0u, indexBases[blocks[1]]);
+            EXPECT_EQ(100u, blocks[2]->pos);
+            EXPECT_EQ(200u, indexBases[blocks[3]]);
+        }
+
+        TEST(AllocationTrackerTest, fragmentationStats) {
+            AllocationTracker t(500);
+
+            AllocationTracker::Block* blocks[5];
+            for (size_t i = 0; i < 5; ++i) {
+                blocks[i] = t.allocate(100);
+                ASSERT_NE(nullptr, blocks[i]);
+            }
+
+            t.free(blocks[1]);
+            t.free(blocks[3]);
+            t.free(blocks[4]);
+
+            const auto stats = t.fragmentationStats();
+            EXPECT_EQ(200u, stats.usedSize);
+            EXPECT_EQ(300u, stats.freeSize);
+            EXPECT_EQ(2u, stats.freeBlockCount);
+            EXPECT_EQ(200u, stats.largestFreeBlock);
+        }
+
         static constexpr size_t NumBrushes = 64'000;
 
         // between 12 and 140, inclusive.
@@ -23,6 +23,10 @@
 #include "Renderer/Camera.h"
 #include "Renderer/PerspectiveCamera.h"
 
+#include <vecmath/bbox.h>
+
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         TEST(CameraTest, testInvalidUp) {
@@ -66,5 +70,45 @@ namespace TrenchBroom {
             ASSERT_FALSE(vm::is_nan(c.right()));
             ASSERT_FALSE(vm::is_nan(c.up()));
         }
+
+        TEST(CameraTest, testFrustumIntersects) {
+            const PerspectiveCamera c(90.0f, 1.0f, 8000.0f, Camera::Viewport(0, 0, 800, 600), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+            const auto frustum = c.frustum();
+
+            ASSERT_TRUE(frustum.intersects(vm::bbox3f(vm::vec3f(92, -8, -8), vm::vec3f(108, 8, 8))));
+            ASSERT_TRUE(frustum.intersects(vm::bbox3f(vm::vec3f(-8, -8, -8), vm::vec3f(8, 8, 8))));
+            ASSERT_TRUE(frustum.intersects(vm::bbox3f(vm::vec3f(-1000, -1000, -1000), vm::vec3f(1000, 1000, 1000))));
+
+            // behind the camera
+            ASSERT_FALSE(frustum.intersects(vm::bbox3f(vm::vec3f(-108, -8, -8), vm::vec3f(-92, 8, 8))));
+            // to the left and to the right of the camera
+            ASSERT_FALSE(frustum.intersects(vm::bbox3f(vm::vec3f(92, 492, -8), vm::vec3f(108, 508, 8))));
+            ASSERT_FALSE(frustum.intersects(vm::bbox3f(vm::vec3f(92, -508, -8), vm::vec3f(108, -492, 8))));
+            // above the camera
+            ASSERT_FALSE(frustum.intersects(vm::bbox3f(vm::vec3f(92, -8, 492), vm::vec3f(108, 8, 508))));
+        }
+
+        TEST(CameraTest, testFrustumAfterMove) {
+            PerspectiveCamera c(90.0f, 1.0f, 8000.0f, Camera::Viewport(0, 0, 800, 600), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+            ASSERT_TRUE(c.frustum().intersects(vm::bbox3f(vm::vec3f(92, -8, -8), vm::vec3f(108, 8, 8))));
+
+            c.moveTo(vm::vec3f(200, 0, 0));
+            ASSERT_FALSE(c.frustum().intersects(vm::bbox3f(vm::vec3f(92, -8, -8), vm::vec3f(108, 8, 8))));
+        }
+
+        TEST(CameraTest, testProjectPoints) {
+            const PerspectiveCamera c(90.0f, 1.0f, 8000.0f, Camera::Viewport(0, 0, 800, 600), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+            const auto points = std::vector<vm::vec3f>{
+                vm::vec3f(100, 0, 0),
+                vm::vec3f(100, 20, -10),
+                vm::vec3f(500, -64, 32)
+            };
+
+            const auto projected = c.project(points);
+            ASSERT_EQ(points.size(), projected.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                ASSERT_EQ(c.project(points[i]), projected[i]);
+            }
+        }
     }
 }
@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "Renderer/GL.h"
+#include "Renderer/ShaderBinaryCache.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST(ShaderBinaryCacheTest, readWrittenBinary) {
+            IO::TestEnvironment env("shaderbinarycachetest");
+            const auto cache = ShaderBinaryCache(env.dir() + IO::Path("cache"), "driver");
+
+            const auto entryPath = cache.entryPath("program", "shader source");
+
+            GLenum format = 0;
+            std::vector<char> binary;
+            ASSERT_FALSE(cache.readBinary(entryPath, format, binary));
+
+            const auto written = std::vector<char>({ 'a', '\0', 'b', 'c' });
+            cache.writeBinary(entryPath, 17u, written);
+
+            ASSERT_TRUE(cache.readBinary(entryPath, format, binary));
+            EXPECT_EQ(17u, format);
+            EXPECT_EQ(written, binary);
+        }
+
+        TEST(ShaderBinaryCacheTest, entryPathDependsOnDriverAndSource) {
+            IO::TestEnvironment env("shaderbinarycachetest");
+            const auto cache = ShaderBinaryCache(env.dir() + IO::Path("cache"), "driver");
+            const auto otherCache = ShaderBinaryCache(env.dir() + IO::Path("cache"), "other driver");
+
+            EXPECT_EQ(cache.entryPath("program", "shader source"), cache.entryPath("program", "shader source"));
+            EXPECT_NE(cache.entryPath("program", "shader source"), cache.entryPath("program", "other shader source"));
+            EXPECT_NE(cache.entryPath("program", "shader source"), cache.entryPath("other program", "shader source"));
+            EXPECT_NE(cache.entryPath("program", "shader source"), otherCache.entryPath("program", "shader source"));
+        }
+    }
+}
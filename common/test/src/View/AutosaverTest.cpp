@@ -57,6 +57,7 @@ namespace TrenchBroom {
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -71,6 +72,7 @@ namespace TrenchBroom {
 
             Autosaver autosaver(document, 0, 0);
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -93,6 +95,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -111,6 +114,7 @@ namespace TrenchBroom {
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -134,6 +138,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -156,6 +161,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -165,12 +171,14 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
             // modify the map
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
         }
 
@@ -193,8 +201,61 @@ namespace TrenchBroom {
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
         }
+
+        TEST_F(MapDocumentTest, autosaverDoesNotRenumberBackups) {
+            IO::TestEnvironment env("autosaver_test");
+            env.createDirectory(IO::Path("autosave"));
+            env.createFile(IO::Path("autosave/test.1.map"), "some content");
+            env.createFile(IO::Path("autosave/test.2.map"), "some content");
+            env.createFile(IO::Path("autosave/test.3.map"), "some content");
+
+            NullLogger logger;
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            Autosaver autosaver(document, 0, 0, 3);
+
+            // modify the map
+            document->addNode(createBrush("some_texture"), document->currentLayer());
+
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
+
+            ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.3.map")));
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.4.map")));
+        }
+
+        TEST_F(MapDocumentTest, autosaverRenumbersBackupsWithLargeNumbers) {
+            IO::TestEnvironment env("autosaver_test");
+            env.createDirectory(IO::Path("autosave"));
+            env.createFile(IO::Path("autosave/test.5.map"), "some content");
+            env.createFile(IO::Path("autosave/test.6.map"), "some content");
+
+            NullLogger logger;
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            Autosaver autosaver(document, 0, 0, 3);
+
+            // modify the map
+            document->addNode(createBrush("some_texture"), document->currentLayer());
+
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingAutosave(logger);
+
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.3.map")));
+            ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.5.map")));
+            ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.6.map")));
+        }
     }
 }
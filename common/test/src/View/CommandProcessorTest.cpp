@@ -64,16 +64,18 @@ namespace TrenchBroom {
         class TestCommand : public UndoableCommand {
         private:
             bool m_isRepeatDelimiter;
+            size_t m_memoryUsage;
         public:
             static const CommandType Type;
 
-            static std::unique_ptr<TestCommand> create(const std::string& name, const bool isRepeatDelimiter) {
-                return std::make_unique<TestCommand>(name, isRepeatDelimiter);
+            static std::unique_ptr<TestCommand> create(const std::string& name, const bool isRepeatDelimiter, const size_t memoryUsage = 0u) {
+                return std::make_unique<TestCommand>(name, isRepeatDelimiter, memoryUsage);
             }
 
-            explicit TestCommand(const std::string& name, const bool isRepeatDelimiter) :
+            explicit TestCommand(const std::string& name, const bool isRepeatDelimiter, const size_t memoryUsage = 0u) :
             UndoableCommand(Type, name),
-            m_isRepeatDelimiter(isRepeatDelimiter) {}
+            m_isRepeatDelimiter(isRepeatDelimiter),
+            m_memoryUsage(memoryUsage) {}
         private:
             std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade* document) override {
                 return std::make_unique<CommandResult>(doPerformDoProxy(document));
@@ -90,6 +92,10 @@ namespace TrenchBroom {
             std::unique_ptr<UndoableCommand> doRepeat(MapDocumentCommandFacade* document) const override {
                 return std::unique_ptr<UndoableCommand>(doRepeatProxy(document));
             }
+
+            size_t doGetMemoryUsage() const override {
+                return m_memoryUsage;
+            }
         public:
             MOCK_METHOD1(doPerformDoProxy, bool(MapDocumentCommandFacade*));
             MOCK_METHOD1(doPerformUndoProxy, bool(MapDocumentCommandFacade*));
@@ -606,5 +612,55 @@ namespace TrenchBroom {
             ASSERT_EQ(commandName1, commandProcessor.undoCommandName());
             ASSERT_EQ(commandName2, commandProcessor.redoCommandName());
         }
+
+        TEST(CommandProcessorTest, undoMemoryLimit) {
+            /*
+             * Execute three commands whose memory usage exceeds the undo memory limit, then undo the remaining commands.
+             */
+
+            CommandProcessor commandProcessor(nullptr);
+            commandProcessor.setUndoMemoryLimit(250u);
+            TestObserver observer(commandProcessor);
+
+            const auto commandName1 = "test command 1";
+            auto command1 = TestCommand::create(commandName1, false, 100u);
+
+            const auto commandName2 = "test command 2";
+            auto command2 = TestCommand::create(commandName2, false, 100u);
+
+            const auto commandName3 = "test command 3";
+            auto command3 = TestCommand::create(commandName3, false, 100u);
+
+            command1->expectDo(true, observer);
+            observer.expectTransactionDone(commandName1);
+            command1->expectCollate(command2.get(), false);
+
+            command2->expectDo(true, observer);
+            observer.expectTransactionDone(commandName2);
+            command2->expectCollate(command3.get(), false);
+
+            command3->expectDo(true, observer);
+            observer.expectTransactionDone(commandName3);
+
+            command3->expectUndo(true, observer);
+            observer.expectTransactionUndone(commandName3);
+
+            command2->expectUndo(true, observer);
+            observer.expectTransactionUndone(commandName2);
+
+            commandProcessor.executeAndStore(std::move(command1));
+            commandProcessor.executeAndStore(std::move(command2));
+            ASSERT_EQ(200u, commandProcessor.undoMemoryUsage());
+
+            commandProcessor.executeAndStore(std::move(command3));
+            ASSERT_EQ(200u, commandProcessor.undoMemoryUsage());
+
+            ASSERT_TRUE(commandProcessor.undo()->success());
+            ASSERT_TRUE(commandProcessor.canUndo());
+            ASSERT_EQ(commandName2, commandProcessor.undoCommandName());
+
+            ASSERT_TRUE(commandProcessor.undo()->success());
+            ASSERT_FALSE(commandProcessor.canUndo());
+        }
     }
 }
@@ -22,6 +22,10 @@
 #include "Exceptions.h"
 #include "TestUtils.h"
 #include "Assets/EntityDefinition.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "Assets/TextureManager.h"
+#include "IO/Path.h"
 #include "Model/Brush.h"
 #include "Model/Entity.h"
 #include "Model/Group.h"
@@ -40,10 +44,16 @@
 #include "View/PasteType.h"
 #include "View/SelectionTool.h"
 
+#include <kdl/vector_utils.h>
+
 #include <vecmath/bbox.h>
 #include <vecmath/scalar.h>
 #include <vecmath/ray.h>
 
+#include <map>
+#include <memory>
+#include <vector>
+
 namespace TrenchBroom {
     namespace View {
         MapDocumentTest::MapDocumentTest() :
@@ -269,6 +279,32 @@ namespace TrenchBroom {
             ASSERT_EQ(vm::plane3(200.0, vm::vec3::pos_z()), brush1->findFace(vm::vec3::pos_z())->boundary());
         }
 
+        TEST_F(MapDocumentTest, scaleObjectsKeepsTextureUsageCounts) {
+            document->setEnabledTextureCollections(std::vector<IO::Path>{ IO::Path("fixture/test/IO/Wad/cr8_czg.wad") });
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            std::vector<Model::Node*> nodes;
+            for (size_t i = 0; i < 8u; ++i) {
+                const auto min = vm::vec3(64.0 * static_cast<double>(i), 0.0, 0.0);
+                auto* brush = builder.createCuboid(vm::bbox3(min, min + vm::vec3(32, 32, 32)), "coffin1");
+                document->addNode(brush, document->currentParent());
+                nodes.push_back(brush);
+            }
+
+            const Assets::Texture* texture = document->textureManager().texture("coffin1");
+            ASSERT_NE(nullptr, texture);
+            ASSERT_EQ(8u * 6u, texture->usageCount());
+
+            // scaling is not a rigid transformation, so the brush geometries are rebuilt
+            document->select(nodes);
+            const auto bounds = document->selectionBounds();
+            ASSERT_TRUE(document->scaleObjects(bounds, vm::bbox3(bounds.min, bounds.max + vm::vec3(0, 32, 16))));
+            ASSERT_EQ(8u * 6u, texture->usageCount());
+
+            document->undoCommand();
+            ASSERT_EQ(8u * 6u, texture->usageCount());
+        }
+
         TEST_F(MapDocumentTest, scaleObjectsInGroup) {
             const vm::bbox3 initialBBox(vm::vec3(-100, -100, -100), vm::vec3(100, 100, 100));
             const vm::bbox3 doubleBBox(2.0 * initialBBox.min, 2.0 * initialBBox.max);
@@ -465,6 +501,88 @@ namespace TrenchBroom {
             EXPECT_EQ(expectedBBox2, remainder2->logicalBounds());
         }
 
+        static size_t countFacesWithTexture(const Model::Node* parent, const Assets::Texture* texture) {
+            size_t result = 0u;
+            for (const auto* child : parent->children()) {
+                if (const auto* brush = dynamic_cast<const Model::Brush*>(child)) {
+                    for (const auto* face : brush->faces()) {
+                        if (face->texture() == texture) {
+                            ++result;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        TEST_F(MapDocumentTest, csgSubtractAndHollowUpdateTextureUsageCounts) {
+            document->setEnabledTextureCollections(std::vector<IO::Path>{ IO::Path("fixture/test/IO/Wad/cr8_czg.wad") });
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            auto* entity = new Model::Entity();
+            document->addNode(entity, document->currentParent());
+
+            Model::Brush* minuend1 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "coffin1");
+            Model::Brush* minuend2 = builder.createCuboid(vm::bbox3(vm::vec3(64, 0, 0), vm::vec3(128, 64, 64)), "coffin1");
+            Model::Brush* subtrahend = builder.createCuboid(vm::bbox3(vm::vec3(32, 16, 16), vm::vec3(96, 48, 48)), "coffin1");
+            document->addNodes(std::vector<Model::Node*>{minuend1, minuend2, subtrahend}, entity);
+
+            const Assets::Texture* texture = document->textureManager().texture("coffin1");
+            ASSERT_NE(nullptr, texture);
+            ASSERT_EQ(3u * 6u, texture->usageCount());
+
+            document->select(subtrahend);
+            ASSERT_TRUE(document->csgSubtract());
+            ASSERT_LT(2u, entity->children().size());
+            ASSERT_EQ(countFacesWithTexture(entity, texture), texture->usageCount());
+
+            document->undoCommand();
+            ASSERT_EQ(3u * 6u, texture->usageCount());
+
+            document->deselectAll();
+            document->select(std::vector<Model::Node*>{minuend1, minuend2});
+            ASSERT_TRUE(document->csgHollow());
+            ASSERT_LT(3u, entity->children().size());
+            ASSERT_EQ(countFacesWithTexture(entity, texture), texture->usageCount());
+
+            document->undoCommand();
+            ASSERT_EQ(3u * 6u, texture->usageCount());
+        }
+
+        TEST_F(MapDocumentTest, reloadChangedAssetsKeepsUnchangedTextureCollections) {
+            auto* brush = createBrush("coffin1");
+            document->addNode(brush, document->currentParent());
+
+            document->setEnabledTextureCollections(std::vector<IO::Path>{
+                IO::Path("fixture/test/IO/Wad/cr8_czg.wad"),
+                IO::Path("fixture/test/IO/Wad/q1_masked.wad")
+            });
+
+            auto& textureManager = document->textureManager();
+            ASSERT_EQ(2u, textureManager.collections().size());
+            auto* changedCollection = textureManager.collections()[0];
+            auto* keptCollection = textureManager.collections()[1];
+            const auto keptTextures = keptCollection->textures();
+
+            const auto changedPaths = changedCollection->sourcePaths();
+            ASSERT_FALSE(changedPaths.empty());
+            ASSERT_EQ(std::vector<Assets::TextureCollection*>{ changedCollection }, textureManager.collectionsLoadedFrom(changedPaths));
+
+            document->reloadChangedAssets(changedPaths);
+
+            // the unchanged collection and its textures are kept, and the collection order is unchanged
+            ASSERT_EQ(2u, textureManager.collections().size());
+            ASSERT_EQ(keptCollection, textureManager.collections()[1]);
+            ASSERT_EQ(keptTextures, keptCollection->textures());
+            ASSERT_EQ(IO::Path("fixture/test/IO/Wad/cr8_czg.wad"), textureManager.collections()[0]->path());
+
+            // the faces use the texture from the reloaded collection
+            const auto* texture = textureManager.texture("coffin1");
+            ASSERT_NE(nullptr, texture);
+            ASSERT_EQ(6u, texture->usageCount());
+            ASSERT_EQ(6u, countFacesWithTexture(document->world(), texture));
+        }
+
         TEST_F(MapDocumentTest, csgSubtractAndUndoRestoresSelection) {
             const Model::BrushBuilder builder(document->world(), document->worldBounds());
 
@@ -632,6 +750,130 @@ namespace TrenchBroom {
             ASSERT_TRUE(pickResult.query().all().empty());
         }
 
+        TEST_F(MapDocumentTest, pickTranslatedBrushInTransaction) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            auto* brush1 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "texture");
+            document->addNode(brush1, document->currentParent());
+            document->select(brush1);
+
+            Model::PickResult pickResult;
+            {
+                Transaction transaction(document, "Translate");
+                document->translateObjects(vm::vec3(0, 128, 0));
+
+                // the node tree must reflect the new brush bounds even though the transaction is still running
+                document->pick(vm::ray3(vm::vec3(-32, 160, 32), vm::vec3::pos_x()), pickResult);
+                ASSERT_EQ(1u, pickResult.query().all().size());
+
+                pickResult.clear();
+                document->pick(vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::pos_x()), pickResult);
+                ASSERT_TRUE(pickResult.query().all().empty());
+
+                document->translateObjects(vm::vec3(0, 128, 0));
+            }
+
+            pickResult.clear();
+            document->pick(vm::ray3(vm::vec3(-32, 288, 32), vm::vec3::pos_x()), pickResult);
+            ASSERT_EQ(1u, pickResult.query().all().size());
+            ASSERT_EQ(brush1->findFace(vm::vec3::neg_x()), pickResult.query().all().front().target<Model::BrushFace*>());
+
+            document->undoCommand();
+
+            pickResult.clear();
+            document->pick(vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::pos_x()), pickResult);
+            ASSERT_EQ(1u, pickResult.query().all().size());
+        }
+
+        class NodeChangeObserver {
+        private:
+            std::weak_ptr<MapDocument> m_document;
+        public:
+            std::map<Model::Node*, size_t> willChangeCounts;
+            std::map<Model::Node*, size_t> didChangeCounts;
+            std::vector<Model::Node*> changingWhenRemoved;
+        private:
+            std::map<Model::Node*, int> m_changing;
+        public:
+            explicit NodeChangeObserver(std::shared_ptr<MapDocument> document) :
+            m_document(document) {
+                document->nodesWillChangeNotifier.addObserver(this, &NodeChangeObserver::nodesWillChange);
+                document->nodesDidChangeNotifier.addObserver(this, &NodeChangeObserver::nodesDidChange);
+                document->nodesWillBeRemovedNotifier.addObserver(this, &NodeChangeObserver::nodesWillBeRemoved);
+            }
+
+            ~NodeChangeObserver() {
+                if (auto document = m_document.lock()) {
+                    document->nodesWillChangeNotifier.removeObserver(this, &NodeChangeObserver::nodesWillChange);
+                    document->nodesDidChangeNotifier.removeObserver(this, &NodeChangeObserver::nodesDidChange);
+                    document->nodesWillBeRemovedNotifier.removeObserver(this, &NodeChangeObserver::nodesWillBeRemoved);
+                }
+            }
+        private:
+            void nodesWillChange(const std::vector<Model::Node*>& nodes) {
+                for (auto* node : nodes) {
+                    ++willChangeCounts[node];
+                    ++m_changing[node];
+                }
+            }
+
+            void nodesDidChange(const std::vector<Model::Node*>& nodes) {
+                for (auto* node : nodes) {
+                    ++didChangeCounts[node];
+                    --m_changing[node];
+                }
+            }
+
+            void nodesWillBeRemoved(const std::vector<Model::Node*>& nodes) {
+                for (auto* node : nodes) {
+                    if (m_changing[node] != 0) {
+                        changingWhenRemoved.push_back(node);
+                    }
+                }
+            }
+        };
+
+        TEST_F(MapDocumentTest, notifyNodeChangesOnceInTransaction) {
+            auto* brush = createBrush("texture");
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            NodeChangeObserver observer(document);
+            {
+                Transaction transaction(document, "Translate twice");
+                document->translateObjects(vm::vec3(0, 16, 0));
+                document->translateObjects(vm::vec3(0, 16, 0));
+
+                // the did change notification is sent when the transaction ends
+                ASSERT_EQ(1u, observer.willChangeCounts[brush]);
+                ASSERT_EQ(0u, observer.didChangeCounts[brush]);
+            }
+
+            ASSERT_EQ(1u, observer.willChangeCounts[brush]);
+            ASSERT_EQ(1u, observer.didChangeCounts[brush]);
+        }
+
+        TEST_F(MapDocumentTest, notifyNodeChangesBeforeRemovalInTransaction) {
+            auto* brush = createBrush("texture");
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            NodeChangeObserver observer(document);
+            {
+                Transaction transaction(document, "Translate and delete");
+                document->translateObjects(vm::vec3(0, 16, 0));
+                document->deleteObjects();
+            }
+
+            ASSERT_EQ(1u, observer.willChangeCounts[brush]);
+            ASSERT_EQ(1u, observer.didChangeCounts[brush]);
+            ASSERT_TRUE(observer.changingWhenRemoved.empty());
+        }
+
         TEST_F(MapDocumentTest, pickSingleEntity) {
             // delete default brush
             document->selectAllNodes();
@@ -921,6 +1163,29 @@ namespace TrenchBroom {
             EXPECT_EQ(nullptr, brush2->parent());
         }
 
+        TEST_F(MapDocumentTest, selectTouchingIgnoresDistantBrushes) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            const auto box = vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64));
+
+            auto* brush1 = builder.createCuboid(box, "texture");
+            document->addNode(brush1, document->currentParent());
+
+            auto* brush2 = builder.createCuboid(box.translate(vm::vec3(32, 32, 32)), "texture");
+            document->addNode(brush2, document->currentParent());
+
+            auto* brush3 = builder.createCuboid(box.translate(vm::vec3(256, 256, 256)), "texture");
+            document->addNode(brush3, document->currentParent());
+
+            document->select(brush1);
+            document->selectTouching(false);
+
+            EXPECT_EQ(std::vector<Model::Brush*>{brush2}, document->selectedNodes().brushes());
+        }
+
         // https://github.com/kduske/TrenchBroom/issues/2776
         TEST_F(MapDocumentTest, pasteAndTranslateGroup) {
             // delete default brush
@@ -949,5 +1214,115 @@ namespace TrenchBroom {
             ASSERT_TRUE(document->translateObjects(delta));
             ASSERT_EQ(box.translate(delta), document->selectionBounds());
         }
+
+        TEST_F(MapDocumentTest, duplicateObjects) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            auto* entity = new Model::Entity();
+            entity->addOrUpdateAttribute("classname", "brush_entity");
+            document->addNode(entity, document->currentParent());
+
+            std::vector<Model::Node*> nodes;
+            for (size_t i = 0; i < 16u; ++i) {
+                const auto min = vm::vec3(64.0 * static_cast<double>(i), 0.0, 0.0);
+                auto* brush = builder.createCuboid(vm::bbox3(min, min + vm::vec3(32, 32, 32)), "texture");
+                document->addNode(brush, i % 2u == 0u ? entity : document->currentParent());
+                nodes.push_back(brush);
+            }
+
+            document->select(nodes);
+            const vm::bbox3 bounds = document->selectionBounds();
+            ASSERT_TRUE(document->duplicateObjects());
+
+            // the duplicated brushes are selected in the original order, and the entity brushes got a new entity
+            const std::vector<Model::Brush*> duplicates = document->selectedNodes().brushes();
+            ASSERT_EQ(nodes.size(), duplicates.size());
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                ASSERT_NE(nodes[i], duplicates[i]);
+                ASSERT_EQ(nodes[i]->logicalBounds(), duplicates[i]->logicalBounds());
+            }
+            ASSERT_EQ(bounds, document->selectionBounds());
+            ASSERT_EQ(8u, entity->childCount());
+            ASSERT_NE(entity, duplicates[0]->parent());
+            ASSERT_EQ(8u, duplicates[0]->parent()->childCount());
+        }
+
+        TEST_F(MapDocumentTest, duplicateObjectsUpdatesTextureUsageCounts) {
+            document->setEnabledTextureCollections(std::vector<IO::Path>{ IO::Path("fixture/test/IO/Wad/cr8_czg.wad") });
+
+            std::vector<Model::Node*> nodes;
+            for (size_t i = 0; i < 16u; ++i) {
+                auto* brush = createBrush("coffin1");
+                document->addNode(brush, document->currentParent());
+                nodes.push_back(brush);
+            }
+
+            const Assets::Texture* texture = document->textureManager().texture("coffin1");
+            ASSERT_NE(nullptr, texture);
+            ASSERT_EQ(16u * 6u, texture->usageCount());
+
+            document->select(nodes);
+            ASSERT_TRUE(document->duplicateObjects());
+            ASSERT_EQ(2u * 16u * 6u, texture->usageCount());
+
+            document->undoCommand();
+            ASSERT_EQ(16u * 6u, texture->usageCount());
+        }
+
+        TEST_F(MapDocumentTest, pasteClonedNodes) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            const auto box = vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64));
+
+            auto* entity = new Model::Entity();
+            entity->addOrUpdateAttribute("classname", "point_entity");
+            document->addNode(entity, document->currentParent());
+            ASSERT_EQ(m_pointEntityDef, entity->definition());
+
+            auto* brush = builder.createCuboid(box, "texture");
+            document->addNode(brush, document->currentParent());
+
+            document->select(std::vector<Model::Node*>{ entity, brush });
+            std::vector<Model::Node*> copied = document->cloneSelectedNodes();
+            ASSERT_EQ(2u, copied.size());
+            ASSERT_EQ(nullptr, static_cast<Model::Entity*>(copied[0])->definition());
+
+            document->deleteObjects();
+            ASSERT_EQ(PasteType::Node, document->paste(copied));
+            ASSERT_EQ(1u, document->selectedNodes().entityCount());
+            ASSERT_EQ(1u, document->selectedNodes().brushCount());
+            ASSERT_EQ(m_pointEntityDef, document->selectedNodes().entities().front()->definition());
+            ASSERT_EQ(box, document->selectedNodes().brushes().front()->logicalBounds());
+
+            // the pasted nodes are clones, so the copied nodes can be pasted again
+            ASSERT_EQ(PasteType::Node, document->paste(copied));
+            ASSERT_EQ(4u, document->world()->defaultLayer()->childCount());
+
+            kdl::vec_clear_and_delete(copied);
+        }
+
+        TEST_F(MapDocumentTest, editWithPendingLoadStages) {
+            document->loadDocument(Model::MapFormat::Standard, vm::bbox3(8192.0), game, IO::Path("test.map"));
+            ASSERT_TRUE(document->hasPendingLoadStages());
+
+            auto* entity = new Model::Entity();
+            entity->addOrUpdateAttribute("classname", "point_entity");
+            document->addNode(entity, document->currentParent());
+
+            document->select(entity);
+            ASSERT_TRUE(document->setAttribute("model", "progs/test.mdl"));
+            ASSERT_TRUE(document->removeAttribute("model"));
+            ASSERT_TRUE(document->hasPendingLoadStages());
+
+            document->finishLoading();
+            ASSERT_FALSE(document->hasPendingLoadStages());
+        }
     }
 }
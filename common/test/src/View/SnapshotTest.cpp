@@ -32,6 +32,7 @@
 #include "View/MapDocument.h"
 
 #include <cassert>
+#include <vector>
 
 namespace TrenchBroom {
     namespace View {
@@ -59,5 +60,31 @@ namespace TrenchBroom {
             for (Model::BrushFace* face : brush->faces())
                 ASSERT_EQ(texture, face->texture());
         }
+
+        TEST_F(SnapshotTest, restoreAfterIntegerTranslation) {
+            // brushes with integer plane points are restored by translating them back, which must be exact
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            std::vector<vm::vec3> points;
+            std::vector<vm::vec2f> offsets;
+            for (const Model::BrushFace* face : brush->faces()) {
+                points.insert(std::end(points), std::begin(face->points()), std::end(face->points()));
+                offsets.push_back(face->offset());
+            }
+
+            ASSERT_TRUE(document->translateObjects(vm::vec3(16, 8, 1)));
+            document->undoCommand();
+
+            ASSERT_EQ(offsets.size(), brush->faces().size());
+            for (size_t i = 0; i < brush->faces().size(); ++i) {
+                const Model::BrushFace* face = brush->faces()[i];
+                for (size_t j = 0; j < 3u; ++j) {
+                    ASSERT_EQ(points[3u * i + j], face->points()[j]);
+                }
+                ASSERT_EQ(offsets[i], face->offset());
+            }
+        }
     }
 }
@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "View/VertexHandleManager.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        TEST(VertexHandleManagerTest, selectAndDeselect) {
+            VertexHandleManager manager;
+            const auto h1 = vm::vec3(0, 0, 0);
+            const auto h2 = vm::vec3(64, 0, 0);
+            const auto h3 = vm::vec3(0, 128, 0);
+
+            manager.add(h3);
+            manager.add(h1);
+            manager.add(h2);
+            manager.add(h2);
+            ASSERT_EQ(3u, manager.totalHandleCount());
+
+            manager.select(h3);
+            manager.select(h1);
+            ASSERT_EQ(2u, manager.selectedHandleCount());
+            ASSERT_EQ(std::vector<vm::vec3>({ h1, h3 }), manager.selectedHandles());
+            ASSERT_EQ(std::vector<vm::vec3>({ h2 }), manager.unselectedHandles());
+
+            manager.deselect(h1);
+            ASSERT_EQ(std::vector<vm::vec3>({ h3 }), manager.selectedHandles());
+
+            const auto toggled = std::vector<vm::vec3>({ h2, h3 });
+            manager.toggle(std::begin(toggled), std::end(toggled));
+            ASSERT_EQ(std::vector<vm::vec3>({ h2 }), manager.selectedHandles());
+
+            manager.deselectAll();
+            ASSERT_FALSE(manager.anySelected());
+            ASSERT_EQ(3u, manager.unselectedHandleCount());
+        }
+
+        TEST(VertexHandleManagerTest, selectCloseHandles) {
+            VertexHandleManager manager;
+            const auto h1 = vm::vec3(32, 32, 32);
+            const auto h2 = vm::vec3(32.0000001, 32, 32);
+            const auto h3 = vm::vec3(32.1, 32, 32);
+
+            manager.add(h1);
+            manager.add(h2);
+            manager.add(h3);
+
+            manager.select(h1);
+            ASSERT_EQ(std::vector<vm::vec3>({ h1, h2 }), manager.selectedHandles());
+        }
+
+        TEST(VertexHandleManagerTest, removeSelectedHandle) {
+            VertexHandleManager manager;
+            const auto h1 = vm::vec3(0, 0, 0);
+            const auto h2 = vm::vec3(64, 0, 0);
+
+            manager.add(h1);
+            manager.add(h1);
+            manager.add(h2);
+            manager.select(h1);
+            manager.select(h2);
+
+            // the first removal only decrements the duplicate count
+            ASSERT_TRUE(manager.remove(h1));
+            ASSERT_TRUE(manager.selected(h1));
+
+            ASSERT_TRUE(manager.remove(h1));
+            ASSERT_FALSE(manager.contains(h1));
+            ASSERT_EQ(std::vector<vm::vec3>({ h2 }), manager.selectedHandles());
+            ASSERT_FALSE(manager.remove(h1));
+
+            manager.clear();
+            ASSERT_EQ(0u, manager.totalHandleCount());
+            ASSERT_EQ(0u, manager.selectedHandleCount());
+        }
+
+        TEST(VertexHandleManagerTest, findHandles) {
+            VertexHandleManager manager;
+            for (int x = 0; x < 10; ++x) {
+                for (int y = 0; y < 10; ++y) {
+                    manager.add(vm::vec3(x * 100, y * 100, x * y));
+                }
+            }
+
+            std::vector<vm::vec3> handles;
+            manager.findHandles(2, vm::bbox3(vm::vec3(150, 150, 0), vm::vec3(350, 250, 0)), std::back_inserter(handles));
+
+            // the result may contain handles in nearby cells, but it must contain the handles within the bounds
+            ASSERT_LT(handles.size(), manager.totalHandleCount());
+            for (const auto& expected : { vm::vec3(200, 200, 4), vm::vec3(300, 200, 6) }) {
+                ASSERT_NE(std::end(handles), std::find(std::begin(handles), std::end(handles), expected));
+            }
+        }
+    }
+}
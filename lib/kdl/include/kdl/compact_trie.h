@@ -15,19 +15,21 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+
 #ifndef KDL_GLOB_INDEX_H
 #define KDL_GLOB_INDEX_H
 
 #include <kdl/string_compare.h>
-#include <kdl/string_format.h>
-#include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <cassert>
-#include <exception>
-#include <set>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace kdl {
@@ -59,16 +61,62 @@ namespace kdl {
      * - { key: "test, values: { "test value" } }
      *   - { key: "ing, values: { "testing testing" } }
      *
+     * The nodes are stored in a single vector and refer to their children by index, and the partial keys of all nodes
+     * are stored in a single string pool, where each node only records the offset and the length of its partial key.
+     * Splitting a node splits its range in the pool, so that inserting a key allocates at most one new node and appends
+     * at most the key itself to the pool. Removed nodes are reused by later insertions, and the pool is compacted once
+     * more than half of it is no longer used by any node.
+     *
      * @tparam V the type of the values associated with each node
      */
     template <typename V>
     class compact_trie {
     private:
-        struct node_cmp;
-        class node;
+        using node_index = std::size_t;
+
+        static constexpr node_index no_node = std::numeric_limits<node_index>::max();
+        static constexpr node_index root_node = 0u;
 
         /**
-         * To avoid matching the same node multiple times using different partial patterns, we store tsome state for
+         * A trie node. The children of a node are ordered by the first characters of their partial keys, which are
+         * unique among siblings since siblings never share a non-empty prefix. These first characters are stored
+         * separately in the same order, which allows selecting a child by searching a short string instead of visiting
+         * the children. This string is usually short enough to be stored without a heap allocation, and searching it
+         * uses the vectorized character search of the standard library.
+         */
+        struct node {
+            /**
+             * The offset of the partial key of this node in the key pool.
+             */
+            std::size_t key_offset;
+
+            /**
+             * The length of the partial key of this node.
+             */
+            std::size_t key_length;
+
+            /**
+             * Maps a value to the number of times it was stored in this node.
+             */
+            std::unordered_map<V, std::size_t> values;
+
+            /**
+             * The first characters of the partial keys of the children, in ascending order.
+             */
+            std::string child_chars;
+
+            /**
+             * The indices of the children, in the same order as their first characters.
+             */
+            std::vector<node_index> children;
+
+            node(const std::size_t i_key_offset, const std::size_t i_key_length) :
+            key_offset(i_key_offset),
+            key_length(i_key_length) {}
+        };
+
+        /**
+         * To avoid matching the same node multiple times using different partial patterns, we store some state for
          * each node that is encountered during matching. For each node, we remember its parent node, whether or not the
          * node was previously matched by a partial pattern, and whether or not all children of the node are already
          * fully matched.
@@ -81,7 +129,7 @@ namespace kdl {
                 /**
                  * The parent of a node.
                  */
-                const node* parent;
+                node_index parent;
 
                 /**
                  * Indicates whether a node was matched by a pattern.
@@ -97,24 +145,32 @@ namespace kdl {
                  * Creates a new state with the given parent. `node_matched` is initialized to `false` and
                  * `fully_matched_children` to 0.
                  *
-                 * @param i_parent the parent, can be null
+                 * @param i_parent the parent, can be `no_node`
                  */
-                explicit node_match_state(const node* i_parent) :
+                explicit node_match_state(const node_index i_parent) :
                 parent(i_parent),
                 node_matched(false),
                 fully_matched_children(0u) {}
             };
 
-            std::unordered_map<const node*, node_match_state> m_state;
+            const std::vector<node>& m_nodes;
+            std::unordered_map<node_index, node_match_state> m_state;
         public:
+            /**
+             * Creates a new match state for the given nodes.
+             *
+             * @param nodes the nodes of the trie to match
+             */
+            explicit match_state(const std::vector<node>& nodes) :
+            m_nodes(nodes) {}
+
             /**
              * Inserts a match state for the given node and its parent.
              *
-             * @param n the node, must not be null
-             * @param parent the parent, may be null
+             * @param n the node
+             * @param parent the parent, may be `no_node`
              */
-            void insert(const node* n, const node* parent) {
-                assert(n != nullptr);
+            void insert(const node_index n, const node_index parent) {
                 m_state.try_emplace(n, parent);
             }
 
@@ -126,11 +182,11 @@ namespace kdl {
              * @param n the node to check
              * @return true if the given node is fully matched and false otherwise
              */
-            bool is_fully_matched(const node* n) {
+            bool is_fully_matched(const node_index n) {
                 auto it = m_state.find(n);
                 assert(it != std::end(m_state));
                 const auto& state = it->second;
-                return state.node_matched && state.fully_matched_children == n->m_children.size();
+                return state.node_matched && state.fully_matched_children == m_nodes[n].children.size();
             }
 
             /**
@@ -142,13 +198,13 @@ namespace kdl {
              *
              * @param n the node to set to fully matched
              */
-            void set_fully_matched(const node* n) {
+            void set_fully_matched(const node_index n) {
                 auto it = m_state.find(n);
                 assert(it != std::end(m_state));
 
                 auto& state = it->second;
                 state.node_matched = true;
-                state.fully_matched_children = n->m_children.size();
+                state.fully_matched_children = m_nodes[n].children.size();
                 update_parent_states(state.parent);
             }
 
@@ -163,7 +219,7 @@ namespace kdl {
              * @param n the node to set to matched
              * @return `false` if the given node is already matched, and `true` otherwise
              */
-            bool set_matched(const node* n) {
+            bool set_matched(const node_index n) {
                 auto it = m_state.find(n);
                 assert(it != std::end(m_state));
 
@@ -173,7 +229,7 @@ namespace kdl {
                 }
 
                 state.node_matched = true;
-                if (state.fully_matched_children == n->m_children.size()) {
+                if (state.fully_matched_children == m_nodes[n].children.size()) {
                     // update the subtree match counts of all nodes on the path to the given node
                     update_parent_states(state.parent);
                 }
@@ -181,14 +237,14 @@ namespace kdl {
                 return true;
             }
         private:
-            void update_parent_states(const node* n) {
-                while (n != nullptr) {
+            void update_parent_states(node_index n) {
+                while (n != no_node) {
                     auto it = m_state.find(n);
                     assert(it != std::end(m_state));
 
                     auto& state = it->second;
                     state.fully_matched_children += 1u;
-                    if (!state.node_matched || state.fully_matched_children < n->m_children.size()) {
+                    if (!state.node_matched || state.fully_matched_children < m_nodes[n].children.size()) {
                         // parent is not fully matched, so it cannot contribute to its parents' subtree match count yet
                         break;
                     }
@@ -199,511 +255,589 @@ namespace kdl {
         };
 
         /**
-         * A trie node. Children are stored in a set ordered by `node_cmp`. Each node can store a given value multiple
-         * times.
-         *
-         * A trie node has only const methods and therefore appears to be immutable, but this is not the case. All of
-         * its members are actually declared as mutable and may be modified by the `insert` or `remove` member
-         * functions. The reason for this peculiar design choice is that trie nodes are stored by value in a `std::set`,
-         * and `std::set` does not allow its contents to be modified, since that might affect the position of the value
-         * in the set.
-         *
-         * But in this particular case, the position of a node in the containing set depends only on the node's key, and
-         * the node's key is changed only in ways that does not affect its position. The key can only become shorter
-         * or longer, that is, key "abc" might be changed to "ab" or "abcd", and neither of these changes affects how
-         * the key compares to other keys due to the order introduce by `node_cmp`, which consideres two keys equivalent
-         * if they share a non-empty prefix.
-         *
-         * This implies that the following two conditions hold for a node with key "abc":
-         * - There is no sibling node with a key that is a prefix of "abc".
-         * - There is no sibling node with a key that that has "abc" as a prefix.
-         *
-         * Therefore, shortening or extending a node's key does not affect its position in the containing set, and we
-         * can update a node's key without violating any invariants of the containing set.
+         * All nodes of this trie, the root node is at index 0. The nodes at the indices in `m_free_nodes` are unused.
          */
-        class node {
-        private:
-            friend struct node_cmp;
-            friend class match_state;
+        std::vector<node> m_nodes;
 
-            using value_container = std::unordered_map<V, std::size_t>;
-            using node_set = std::set<node, node_cmp>;
+        /**
+         * The indices of unused nodes, which are reused when new nodes are created.
+         */
+        std::vector<node_index> m_free_nodes;
 
-            /**
-             * The partical key of this node.
-             */
-            mutable std::string m_key;
+        /**
+         * Stores the partial keys of all nodes.
+         */
+        std::string m_key_pool;
 
-            /**
-             * Maps a value to the number of times it was stored in this node.
-             */
-            mutable value_container m_values;
+        /**
+         * The number of characters in the key pool which are part of the partial key of a node.
+         */
+        std::size_t m_used_key_chars;
+    public:
+        /**
+         * Creates a new empty trie.
+         */
+        compact_trie() :
+        m_used_key_chars(0u) {
+            m_nodes.emplace_back(0u, 0u);
+        }
 
-            /**
-             * The children of this node.
-             */
-            mutable node_set m_children;
-        public:
-            /**
-             * Creates a new node with the given key.
-             *
-             * @param key the key
+        /**
+         * Inserts the given value under the given key.
+         *
+         * @param key the key to insert
+         * @param value the value to insert
+         */
+        void insert(const std::string_view key, const V& value) {
+            /*
+             Possible cases for insertion at a node:
+              index: 01234567 |   | #n_key: 6
+              n_key: target   | ^ | #key | conditions              | todo
+             =================|===|======|=========================|======
+              case:  key:     |   |      |                         |
+                 0:  blah     | 0 | 4    | ^ = 0                   | this is the root node, find or create child 'blah' and insert there;
+                     ^        |   |      |                         |
+                 1:  targetli | 6 | 8    | ^ < #key AND ^ = #n_key | find or create child 'li' and insert there;
+                           ^  |   |      |                         |
+                 2:  tarus    | 3 | 5    | ^ < #key AND ^ < #n_key | split this node in 'tar' and 'get'; create child 'us' and insert there;
+                        ^     |   |      |                         |
+                 3:  tar      | 3 | 3    | ^ = #key AND ^ < #n_key | split this node in 'tar' and 'get'; insert here;
+                        ^     |   |      |                         |
+                 4:  target   | 6 | 6    | ^ = #key AND ^ = #n_key | insert here;
+                           ^  |   |      |                         |
+             ==================================================================================
+              ^ indicates where key and n_key first differ
              */
-            explicit node(std::string key) :
-            m_key(std::move(key)) {}
 
-            /**
-             * Inserts the given value into this node's subtree. If this node's key is empty, then it is the root node.
-             *
-             * Precondition: Unless this node is the root node, the given key must share a non-empty prefix with this
-             * node's key.
-             *
-             * @param key the key to insert
-             * @param value the value to insert
-             */
-            void insert(const std::string_view key, const V& value) const {
-                /*
-                 Possible cases for insertion:
-                  index: 01234567 |   | #m_key: 6
-                  m_key: target   | ^ | #key | conditions              | todo
-                 =================|===|======|=========================|======
-                  case:  key:     |   |      |                         |
-                     0:  blah     | 0 | 4    | ^ = 0                   | this is the root node, find or create child 'blah' and insert there;
-                         ^        |   |      |                         |
-                     1:  targetli | 6 | 8    | ^ < #key AND ^ = #m_key | try insert in all children, if none match, create child 'li' and insert there;
-                               ^  |   |      |                         |
-                     2:  tarus    | 3 | 5    | ^ < #key AND ^ < #m_key | split this node in 'tar' and 'get'; create child 'us' and insert there;
-                            ^     |   |      |                         |
-                     3:  tar      | 3 | 3    | ^ = #key AND ^ < #m_key | split this node in 'tar' and 'get'; insert here; return true;
-                            ^     |   |      |                         |
-                     4:  target   | 6 | 6    | ^ = #key AND ^ = #m_key | insert here; return true;
-                               ^  |   |      |                         |
-                 ==================================================================================
-                  ^ indicates where key and m_key first differ
-                 */
+            auto n = root_node;
+            auto remainder = key;
+            while (true) {
+                // find the index of the first character where the remainder of the key and this node's key differ
+                const std::size_t mismatch = kdl::cs::str_mismatch(remainder, node_key(n));
+                assert(mismatch > 0u || n == root_node);
 
-                // find the index of the first character where the given key and this node's key differ
-                const std::size_t mismatch = kdl::cs::str_mismatch(key, m_key);
-                assert(mismatch > 0u || m_key.empty());
-
-                if (mismatch < key.size()) {
-                    // cases 0, 1, 2: key and m_key have a common prefix, or m_key is a prefix of key
-                    if (mismatch == m_key.size()) {
-                        // case 0, 1: m_key is a prefix of key, find or create a child that has a common prefix with
-                        // the remainder of key and insert there
-                        const auto remainder = key.substr(mismatch);
-                        const auto& child = *m_children.insert(node(std::string(remainder))).first;
-                        child.insert(remainder, value);
-                    } else { // mismatch == m_key.size()
-                        // case 2: key and m_key have a common prefix, split this node and insert again
-                        split_node(mismatch);
-                        insert(key, value);
-                    }
-                } else if (mismatch == key.size()) {
-                    // cases 3, 4: key is a prefix of m_key, or key == m_key
-                    if (mismatch < m_key.size()) {
-                        // case 3: key is a prefix of m_key, split this node
-                        split_node(mismatch);
-                    }
-                    insert_value(value);
+                if (mismatch < m_nodes[n].key_length) {
+                    // cases 2, 3: split this node so that its key becomes a prefix of the remainder
+                    split_node(n, mismatch);
                 }
-            }
 
-            /**
-             * Removes the given value from this node's subtree.
-             *
-             * @param key the key to remove
-             * @param value the value to remove
-             * @return true if the given key and value were removed from this node's subtree
-             */
-            bool remove(const std::string_view key, const V& value) const {
-                bool result = false;
-
-                const std::size_t mismatch = kdl::cs::str_mismatch(key, m_key);
-                if (m_key.size() <= key.length() && mismatch == m_key.length()) {
-                    // m_key is a prefix of key or m_key == key
-                    if (mismatch < key.length()) {
-                        // m_key is a true prefix of key, continue at the corresponding child node
-                        const auto remainder = key.substr(mismatch);
-                        const auto it = m_children.find(remainder);
-                        assert(it != std::end(m_children));
-
-                        result = it->remove(remainder, value);
-                        if (!it->m_key.empty() && it->m_values.empty() && it->m_children.empty()) {
-                            m_children.erase(it);
-                        }
-                    } else {
-                        // m_key == key
-                        result = remove_value(value);
-                    }
+                if (mismatch == remainder.size()) {
+                    // cases 3, 4: the remainder is the node's key
+                    insert_value(n, value);
+                    return;
+                }
 
-                    if (!m_key.empty() && m_values.empty() && m_children.size() == 1u) {
-                        merge_node();
-                    }
+                // cases 0, 1, 2: the node's key is a prefix of the remainder, continue at the child that has a common
+                // prefix with the rest of the remainder, or create such a child
+                remainder = remainder.substr(mismatch);
+                const auto child = find_child(n, remainder.front());
+                if (child == no_node) {
+                    insert_value(add_child(n, remainder), value);
+                    return;
                 }
 
-                return result;
+                n = child;
             }
+        }
 
-            /**
-             * Finds every node in this node's subtree whose keys match a pattern, and adds the values to the given
-             * output iterator.
-             *
-             * The keys are matched against a suffix of the given pattern starting at the given position. The matching
-             * algorithm uses an auxiliary `match_State` to prevent matching unnecessarily matching nodes. This state
-             * is updated in the following situations:
-             *
-             * - a node is visited for the first time
-             * - a node is matches the given pattern (this might also update the node's parent's states)
-             * - an entire subtree matches the given pattern (due to a trailing wildcard in the pattern)
-             *
-             * Using this information, the algorithm will stop matching a node if every node in its subtree was already
-             * matched against the pattern. Furthermore, it will not add a node's values multiple times if the node's key
-             * matches the pattern in more than one way. The latter situation can arise due to wildcards in the pattern.
-             *
-             * @tparam O the type of the given output iterator
-             * @param pattern the pattern to match
-             * @param pattern_position where to start matching the pattern
-             * @param parent this node's parent (used to update the match_state)
-             * @param match_state the match state
-             * @param out the output iterator to which the values of matched nodes are added
-             *
-             * @throws std::invalid_argument if the given pattern contains an invalid escape sequence
-             */
-            template <typename O>
-            void find_matches(const std::string_view pattern, const std::size_t pattern_position, const node* parent, match_state& match_state, O out) const {
-                using match_task = std::pair<std::size_t, std::size_t>;
-
-                match_state.insert(this, parent);
-
-                std::vector<match_task> match_tasks({{ 0u, pattern_position }});
-                while (!match_tasks.empty()) {
-                    if (match_state.is_fully_matched(this)) {
-                        // this node and all of its subtrees have been fully matched, so we are done here
-                        return;
-                    }
-
-                    const auto [k_i, p_i] = match_tasks.back();
-                    match_tasks.pop_back();
-
-                    if (k_i == m_key.length() && p_i == pattern.length()) {
-                        if (match_state.set_matched(this)) {
-                            // this node was not matched yet, so fetch the results
-                            get_values(out);
-                        }
-
-                        // there might still be children of this node that could be matched by a pending match task,
-                        // so continue matching
-                        continue;
-                    }
-
-                    if (p_i == pattern.length()) {
-                        // the pattern is consumed by the key isn't, we cannot have a match here
-                        continue;
-                    }
-
-                    // after this point, we can assume that the pattern is not consumed, but the key might be
-                    if (pattern[p_i] == '\\' && p_i < pattern.length() - 1u) {
-                        // handle escaped characters in the pattern
-                        const auto& n = pattern[p_i + 1u];
-
-                        if (k_i < m_key.length()) {
-                            // check the next character in the pattern against the next character in the key
-                            if (n == '*' || n == '?' || n == '%' || n == '\\') {
-                                if (m_key[k_i] == n) {
-                                    // the key matches the escaped character, continue
-                                    match_tasks.emplace_back(k_i + 1u, p_i + 2u);
-                                }
-                            } else {
-                                throw std::invalid_argument("invalid escape sequence in pattern");
-                            }
-                        } else {
-                            // the key is consumed, so continue matching at the children
-                            for (const auto& c : { "*", "?", "%", "\\" }) {
-                                const auto it = m_children.find(c);
-                                if (it != std::end(m_children)) {
-                                    it->find_matches(pattern, p_i, this, match_state, out);
-                                }
-                            }
-                        }
-                    } else if (pattern[p_i] == '*') {
-                        // handle '*' in the pattern
-                        if (p_i == pattern.length() - 1u) {
-                            // the pattern is consumed after the '*', so it matches all keys in this node's subtree
-                            match_state.set_fully_matched(this);
-                            get_values_and_recurse(out);
-                            return;
-                        }
-
-                        if (k_i < m_key.length()) {
-                            // '*' matches any character
-                            // consume the '*' and continue matching at the current character of the key
-                            match_tasks.emplace_back(k_i, p_i + 1u);
-                            // consume the current character of the key and continue matching at '*'
-                            match_tasks.emplace_back(k_i + 1u, p_i);
-                        } else {
-                            // the key is consumed, so continue matching at the children
-                            for (const auto& child : m_children) {
-                                child.find_matches(pattern, p_i, this, match_state, out);
-                            }
-                        }
-                    } else if (pattern[p_i] == '?') {
-                        // handle '?' in the pattern
-                        if (k_i < m_key.length()) {
-                            // '?' matches any character, continue at the next chars in both the pattern and the key
-                            match_tasks.emplace_back(k_i + 1u, p_i + 1u);
-                        } else {
-                            // the key is consumed, so continue matching at the children
-                            for (const auto& child : m_children) {
-                                child.find_matches(pattern, p_i, this, match_state, out);
-                            }
-                        }
-                    } else if (pattern[p_i] == '%') {
-                        // handle '%' in the pattern
-                        if (p_i < pattern.length() - 1u && pattern[p_i + 1u] == '*') {
-                            // handle "%*" in the pattern
-                            // try to continue matching after "%*"
-                            match_tasks.emplace_back(k_i, p_i + 2u);
-                            if (k_i < m_key.length()) {
-                                if (m_key[k_i] >= '0' && m_key[k_i] <= '9') {
-                                    // try to match more digits
-                                    match_tasks.emplace_back(k_i + 1u, p_i);
-                                }
-                            } else {
-                                // the key is consumed, so continue matching at the children
-                                for (auto it = m_children.lower_bound("0"), end = m_children.upper_bound("9"); it != end; ++it) {
-                                    it->find_matches(pattern, p_i, this, match_state, out);
-                                }
-                            }
-                        } else {
-                            if (k_i < m_key.length()) {
-                                // handle '%' in the pattern (not followed by '*')
-                                if (m_key[k_i] >= '0' && m_key[k_i] <= '9') {
-                                    // continue matching after the digit
-                                    match_tasks.emplace_back(k_i + 1u, p_i + 1u);
-                                }
-                            } else {
-                                // the key is consumed, so continue matching at the children
-                                for (auto it = m_children.lower_bound("0"), end = m_children.upper_bound("9"); it != end; ++it) {
-                                    it->find_matches(pattern, p_i, this, match_state, out);
-                                }
-                            }
-                        }
-                    } else {
-                        if (k_i < m_key.length()) {
-                            if (pattern[p_i] == m_key[k_i]) {
-                                // handle a regular character in the pattern
-                                match_tasks.emplace_back(k_i + 1u, p_i + 1u);
-                            }
-                        } else {
-                            // the key is consumed, so continue matching at the children
-                            for (auto [it, end] = m_children.equal_range(pattern.substr(p_i, 1u)); it != end; ++it) {
-                                it->find_matches(pattern, p_i, this, match_state, out);
-                            }
-                        }
-                    }
+        /**
+         * Removes the given value using the given key.
+         *
+         * @param key the key to remove
+         * @param value the value to remove
+         * @return `true` if the given value was found under the given key, and `false` otherwise
+         */
+        bool remove(const std::string_view key, const V& value) {
+            // find the path to the node with the given key
+            auto path = std::vector<node_index>({ root_node });
+            auto remainder = key;
+            while (true) {
+                const auto n_key = node_key(path.back());
+                if (remainder.size() < n_key.size() || kdl::cs::str_mismatch(remainder, n_key) < n_key.size()) {
+                    return false;
                 }
-            }
 
-            /**
-             * Adds the keys of all nodes in this subtree to the given output iterator.
-             *
-             * @tparam O the type of the output iterator
-             * @param prefix the prefix of all keys in this subtree
-             * @param out the output iterator
-             */
-            template <typename O>
-            void get_keys(const std::string& prefix, O out) const {
-                const auto key = prefix + m_key;
-                if (!m_values.empty()) {
-                    out++ = key;
+                remainder = remainder.substr(n_key.size());
+                if (remainder.empty()) {
+                    break;
                 }
 
-                for (const auto& child : m_children) {
-                    child.get_keys(key, out);
+                const auto child = find_child(path.back(), remainder.front());
+                if (child == no_node) {
+                    return false;
                 }
+                path.push_back(child);
             }
-        private:
-            void insert_value(const V& value) const {
-                m_values[value]++;
+
+            if (!remove_value(path.back(), value)) {
+                return false;
             }
 
-            bool remove_value(const V& value) const {
-                auto it = m_values.find(value);
-                if (it == std::end(m_values)) {
-                    return false;
-                } else {
-                    if (--(it->second) == 0u) {
-                        m_values.erase(it);
+            // clean up the path bottom up: remove nodes which have neither values nor children, and merge nodes which
+            // have no values and a single child with that child
+            for (std::size_t i = path.size(); i > 0u; --i) {
+                const auto n = path[i - 1u];
+                if (i < path.size()) {
+                    const auto child = path[i];
+                    if (m_nodes[child].values.empty() && m_nodes[child].children.empty()) {
+                        remove_child(n, child);
                     }
-                    return true;
+                }
+
+                if (n != root_node && m_nodes[n].values.empty() && m_nodes[n].children.size() == 1u) {
+                    merge_node(n);
                 }
             }
 
-            /**
-             * Splits this node into two nodes at the given index of its key. For example, given a node n with key
-             * "abcd" and index 2, the following will happen:
-             * - n's key will be shortened to "ab"
-             * - a new node c will be created to n with key "cd"
-             * - all of n's children and values will be moved to c
-             * - c will be added to n's children
-             *
-             * Precondition: This node's key has at least two characters, and the index is chosen in such a way that
-             * neither of the resulting keys is empty.
-             *
-             * @param index the index at which to split the node's key
-             */
-            void split_node(const std::size_t index) const {
-                assert(m_key.length() > 1u);
+            compact_key_pool_if_necessary();
+            return true;
+        }
 
-                auto new_key = m_key.substr(0u, index);
-                auto remainder = m_key.substr(index);
+        /**
+         * Clears this trie.
+         */
+        void clear() {
+            m_nodes.clear();
+            m_nodes.emplace_back(0u, 0u);
+            m_free_nodes.clear();
+            m_key_pool.clear();
+            m_used_key_chars = 0u;
+        }
 
-                assert(!new_key.empty());
-                assert(!remainder.empty());
+        /**
+         * Finds all values whose keys match the given glob pattern. See `kdl::str_matches_glob` for the definition and
+         * semantics of glob patterns and adds the values to the given output iterator.
+         *
+         * @tparam O the type of the output iterator
+         * @param pattern the pattern to match
+         * @param out the output iterator
+         */
+        template <typename O>
+        void find_matches(const std::string_view pattern, O out) const {
+            match_state match_state(m_nodes);
+            find_matches(root_node, pattern, 0u, no_node, match_state, out);
+        }
 
-                using std::swap;
-                node_set new_children;
-                swap(new_children, m_children);
+        /**
+         * Adds the keys of all nodes in this trie to the give output iterator.
+         *
+         * @tparam O the type of the output iterator
+         * @param out the output iterator
+         */
+        template <typename O>
+        void get_keys(O out) const {
+            get_keys(root_node, "", out);
+        }
+    private:
+        /**
+         * Returns the partial key of the given node. The returned view is invalidated when the key pool changes.
+         */
+        std::string_view node_key(const node_index n) const {
+            return std::string_view(m_key_pool).substr(m_nodes[n].key_offset, m_nodes[n].key_length);
+        }
 
-                const node& new_child = *m_children.insert(node(std::move(remainder))).first;
-                swap(new_child.m_children, new_children);
-                swap(new_child.m_values, m_values);
+        /**
+         * Returns the child of the given node whose partial key starts with the given character, or `no_node` if no
+         * such child exists.
+         */
+        node_index find_child(const node_index n, const char c) const {
+            const auto& node = m_nodes[n];
+            const auto i = node.child_chars.find(c);
+            return i != std::string::npos ? node.children[i] : no_node;
+        }
 
-                m_key = std::move(new_key);
+        /**
+         * Creates a node with the given range of the key pool as its key, reusing an unused node if possible. Note
+         * that this may invalidate any references to nodes.
+         */
+        node_index create_node(const std::size_t key_offset, const std::size_t key_length) {
+            if (!m_free_nodes.empty()) {
+                const auto n = m_free_nodes.back();
+                m_free_nodes.pop_back();
+                m_nodes[n].key_offset = key_offset;
+                m_nodes[n].key_length = key_length;
+                return n;
+            } else {
+                m_nodes.emplace_back(key_offset, key_length);
+                return m_nodes.size() - 1u;
             }
+        }
 
-            /**
-             * Merges this node with its only child. Thereby, this child node's key is appended to this node's key, the
-             * child's children and values are moved to this node, and the child is removed.
-             *
-             * Precondition: This node has only one child, and this node has no values of its own.
-             */
-            void merge_node() const {
-                assert(m_children.size() == 1u);
-                assert(m_values.empty());
+        /**
+         * Marks the given node as unused so that it can be reused by create_node.
+         */
+        void free_node(const node_index n) {
+            auto& node = m_nodes[n];
+            m_used_key_chars -= node.key_length;
+
+            node.key_length = 0u;
+            node.values.clear();
+            node.child_chars.clear();
+            node.children.clear();
+            m_free_nodes.push_back(n);
+        }
 
-                using std::swap;
-                node_set old_children;
-                swap(old_children, m_children);
+        /**
+         * Creates a new child of the given node with the given key and returns it.
+         *
+         * Precondition: the key is not empty and the given node has no child with a key that starts with the same
+         * character.
+         */
+        node_index add_child(const node_index parent, const std::string_view key) {
+            assert(!key.empty());
+            assert(find_child(parent, key.front()) == no_node);
 
-                const node& child = *std::begin(old_children);
-                swap(m_children, child.m_children);
-                swap(m_values, child.m_values);
+            const auto child = create_node(m_key_pool.size(), key.size());
+            m_key_pool.append(key);
+            m_used_key_chars += key.size();
 
-                m_key += child.m_key;
-            }
+            auto& node = m_nodes[parent];
+            const auto pos = std::lower_bound(std::begin(node.child_chars), std::end(node.child_chars), key.front());
+            const auto i = std::distance(std::begin(node.child_chars), pos);
+            node.child_chars.insert(pos, key.front());
+            node.children.insert(std::next(std::begin(node.children), i), child);
 
-            template <typename O>
-            void get_values(O out) const {
-                for (const auto& [value, count] : m_values) {
-                    for (std::size_t i = 0u; i < count; ++i) {
-                        out++ = value;
-                    }
-                }
-            }
+            return child;
+        }
 
-            template <typename O>
-            void get_values_and_recurse(O out) const {
-                get_values(out);
-                for (const auto& child : m_children) {
-                    child.get_values_and_recurse(out);
+        /**
+         * Removes the given child from the given node and marks it as unused.
+         */
+        void remove_child(const node_index parent, const node_index child) {
+            auto& node = m_nodes[parent];
+            const auto it = std::find(std::begin(node.children), std::end(node.children), child);
+            assert(it != std::end(node.children));
+
+            const auto i = std::distance(std::begin(node.children), it);
+            node.child_chars.erase(std::next(std::begin(node.child_chars), i));
+            node.children.erase(it);
+            free_node(child);
+        }
+
+        void insert_value(const node_index n, const V& value) {
+            m_nodes[n].values[value]++;
+        }
+
+        bool remove_value(const node_index n, const V& value) {
+            auto& values = m_nodes[n].values;
+            auto it = values.find(value);
+            if (it == std::end(values)) {
+                return false;
+            } else {
+                if (--(it->second) == 0u) {
+                    values.erase(it);
                 }
+                return true;
             }
-        };
+        }
 
         /**
-         * Compares nodes against each other or nodes against strings.
+         * Splits the given node into two nodes at the given index of its key. For example, given a node n with key
+         * "abcd" and index 2, the following will happen:
+         * - n's key will be shortened to "ab"
+         * - a new node c will be created with key "cd"
+         * - all of n's children and values will be moved to c
+         * - c will be added to n's children
          *
-         * Two nodes are compared by their keys.
-         * A node is compared to a string by comparing its key to the string.
+         * Both keys share the range of the key pool that was previously used by n's key.
          *
-         * Two strings are compared by their first character only, soif two nodes share a non-empty prefix, they are
-         * considered equivalent. Therefore, the keys "ab" and "abc" are equivalent. Conversely, the keys "ab" and "bc"
-         * are not equivalent because they do not share a prefix, more specifically, "ab" is considered less than "bc".
+         * Precondition: The index is chosen in such a way that neither of the resulting keys is empty.
          *
-         * Precondition: the strings to copmare are not empty.
+         * @param n the node to split
+         * @param index the index at which to split the node's key
          */
-        struct node_cmp {
-            using is_transparent = void;
+        void split_node(const node_index n, const std::size_t index) {
+            assert(index > 0u && index < m_nodes[n].key_length);
 
-            bool operator()(const node& lhs, const node& rhs) const {
-                return compare(lhs.m_key, rhs.m_key);
-            }
+            const auto child = create_node(m_nodes[n].key_offset + index, m_nodes[n].key_length - index);
+            auto& node = m_nodes[n];
+            auto& new_child = m_nodes[child];
 
-            bool operator()(const std::string_view lhs, const node& rhs) const {
-                return compare(lhs, rhs.m_key);
-            }
+            using std::swap;
+            swap(node.values, new_child.values);
+            swap(node.child_chars, new_child.child_chars);
+            swap(node.children, new_child.children);
 
-            bool operator()(const node& lhs, const std::string_view rhs) const {
-                return compare(lhs.m_key, rhs);
-            }
+            node.key_length = index;
+            node.child_chars.push_back(m_key_pool[new_child.key_offset]);
+            node.children.push_back(child);
+        }
 
-            bool compare(const std::string_view lhs, const std::string_view& rhs) const {
-                assert(!lhs.empty() && !rhs.empty());
-                return lhs[0] < rhs[0];
-            }
-        };
-    private:
-        node m_root;
-    public:
         /**
-         * Creates a new empty trie.
+         * Merges the given node with its only child. Thereby, this child node's key is appended to the given node's
+         * key, the child's children and values are moved to the given node, and the child is removed.
+         *
+         * If the keys of both nodes are adjacent in the key pool, which is the case if they were created by splitting
+         * a node, then the range of the given node's key is extended. Otherwise, the merged key is appended to the
+         * pool.
+         *
+         * Precondition: The given node has only one child, and it has no values of its own.
+         *
+         * @param n the node to merge with its child
          */
-        compact_trie() :
-        m_root(node("")) {}
+        void merge_node(const node_index n) {
+            assert(m_nodes[n].children.size() == 1u);
+            assert(m_nodes[n].values.empty());
+
+            const auto child = m_nodes[n].children.front();
+            if (m_nodes[n].key_offset + m_nodes[n].key_length != m_nodes[child].key_offset) {
+                auto key = std::string(node_key(n));
+                key.append(node_key(child));
+
+                m_nodes[n].key_offset = m_key_pool.size();
+                m_key_pool.append(key);
+            }
+
+            auto& node = m_nodes[n];
+            auto& old_child = m_nodes[child];
+
+            using std::swap;
+            swap(node.values, old_child.values);
+            swap(node.child_chars, old_child.child_chars);
+            swap(node.children, old_child.children);
+
+            node.key_length += old_child.key_length;
+            m_used_key_chars += old_child.key_length;
+            free_node(child);
+        }
 
         /**
-         * Inserts the given value under the given key.
-         *
-         * @param key the key to insert
-         * @param value the value to insert
+         * Rebuilds the key pool if more than half of its characters are no longer used by any node. The keys are added
+         * to the new pool in depth first order, so that the keys on a path from the root are close to each other.
          */
-        void insert(const std::string_view key, const V& value) {
-            m_root.insert(key, value);
+        void compact_key_pool_if_necessary() {
+            if (m_key_pool.size() - m_used_key_chars <= m_used_key_chars) {
+                return;
+            }
+
+            auto key_pool = std::string();
+            key_pool.reserve(m_used_key_chars);
+
+            auto stack = std::vector<node_index>({ root_node });
+            while (!stack.empty()) {
+                auto& node = m_nodes[stack.back()];
+                stack.pop_back();
+
+                const auto key_offset = key_pool.size();
+                key_pool.append(m_key_pool, node.key_offset, node.key_length);
+                node.key_offset = key_offset;
+
+                stack.insert(std::end(stack), node.children.rbegin(), node.children.rend());
+            }
+
+            assert(key_pool.size() == m_used_key_chars);
+            m_key_pool = std::move(key_pool);
         }
 
         /**
-         * Removes the given value using the given key.
+         * Finds every node in the subtree of the given node whose keys match a pattern, and adds the values to the
+         * given output iterator.
          *
-         * @param key the key to remove
-         * @param value the value to remove
-         * @return `true` if the given value was found under the given key, and `false` otherwise
+         * The keys are matched against a suffix of the given pattern starting at the given position. The matching
+         * algorithm uses an auxiliary `match_state` to prevent matching unnecessarily matching nodes. This state
+         * is updated in the following situations:
+         *
+         * - a node is visited for the first time
+         * - a node is matches the given pattern (this might also update the node's parent's states)
+         * - an entire subtree matches the given pattern (due to a trailing wildcard in the pattern)
+         *
+         * Using this information, the algorithm will stop matching a node if every node in its subtree was already
+         * matched against the pattern. Furthermore, it will not add a node's values multiple times if the node's key
+         * matches the pattern in more than one way. The latter situation can arise due to wildcards in the pattern.
+         *
+         * @tparam O the type of the given output iterator
+         * @param n the node to match
+         * @param pattern the pattern to match
+         * @param pattern_position where to start matching the pattern
+         * @param parent the node's parent (used to update the match_state)
+         * @param match_state the match state
+         * @param out the output iterator to which the values of matched nodes are added
+         *
+         * @throws std::invalid_argument if the given pattern contains an invalid escape sequence
          */
-        bool remove(const std::string_view key, const V& value) {
-            return m_root.remove(key, value);
+        template <typename O>
+        void find_matches(const node_index n, const std::string_view pattern, const std::size_t pattern_position, const node_index parent, match_state& match_state, O out) const {
+            using match_task = std::pair<std::size_t, std::size_t>;
+
+            match_state.insert(n, parent);
+
+            const auto& node = m_nodes[n];
+            const auto key = node_key(n);
+
+            std::vector<match_task> match_tasks({{ 0u, pattern_position }});
+            while (!match_tasks.empty()) {
+                if (match_state.is_fully_matched(n)) {
+                    // this node and all of its subtrees have been fully matched, so we are done here
+                    return;
+                }
+
+                const auto [k_i, p_i] = match_tasks.back();
+                match_tasks.pop_back();
+
+                if (k_i == key.length() && p_i == pattern.length()) {
+                    if (match_state.set_matched(n)) {
+                        // this node was not matched yet, so fetch the results
+                        get_values(n, out);
+                    }
+
+                    // there might still be children of this node that could be matched by a pending match task,
+                    // so continue matching
+                    continue;
+                }
+
+                if (p_i == pattern.length()) {
+                    // the pattern is consumed by the key isn't, we cannot have a match here
+                    continue;
+                }
+
+                // after this point, we can assume that the pattern is not consumed, but the key might be
+                if (pattern[p_i] == '\\' && p_i < pattern.length() - 1u) {
+                    // handle escaped characters in the pattern
+                    const auto& c = pattern[p_i + 1u];
+
+                    if (k_i < key.length()) {
+                        // check the next character in the pattern against the next character in the key
+                        if (c == '*' || c == '?' || c == '%' || c == '\\') {
+                            if (key[k_i] == c) {
+                                // the key matches the escaped character, continue
+                                match_tasks.emplace_back(k_i + 1u, p_i + 2u);
+                            }
+                        } else {
+                            throw std::invalid_argument("invalid escape sequence in pattern");
+                        }
+                    } else {
+                        // the key is consumed, so continue matching at the children
+                        for (const auto e : { '*', '?', '%', '\\' }) {
+                            const auto child = find_child(n, e);
+                            if (child != no_node) {
+                                find_matches(child, pattern, p_i, n, match_state, out);
+                            }
+                        }
+                    }
+                } else if (pattern[p_i] == '*') {
+                    // handle '*' in the pattern
+                    if (p_i == pattern.length() - 1u) {
+                        // the pattern is consumed after the '*', so it matches all keys in this node's subtree
+                        match_state.set_fully_matched(n);
+                        get_values_and_recurse(n, out);
+                        return;
+                    }
+
+                    if (k_i < key.length()) {
+                        // '*' matches any character
+                        // consume the '*' and continue matching at the current character of the key
+                        match_tasks.emplace_back(k_i, p_i + 1u);
+                        // consume the current character of the key and continue matching at '*'
+                        match_tasks.emplace_back(k_i + 1u, p_i);
+                    } else {
+                        // the key is consumed, so continue matching at the children
+                        for (const auto child : node.children) {
+                            find_matches(child, pattern, p_i, n, match_state, out);
+                        }
+                    }
+                } else if (pattern[p_i] == '?') {
+                    // handle '?' in the pattern
+                    if (k_i < key.length()) {
+                        // '?' matches any character, continue at the next chars in both the pattern and the key
+                        match_tasks.emplace_back(k_i + 1u, p_i + 1u);
+                    } else {
+                        // the key is consumed, so continue matching at the children
+                        for (const auto child : node.children) {
+                            find_matches(child, pattern, p_i, n, match_state, out);
+                        }
+                    }
+                } else if (pattern[p_i] == '%') {
+                    // handle '%' in the pattern
+                    if (p_i < pattern.length() - 1u && pattern[p_i + 1u] == '*') {
+                        // handle "%*" in the pattern
+                        // try to continue matching after "%*"
+                        match_tasks.emplace_back(k_i, p_i + 2u);
+                        if (k_i < key.length()) {
+                            if (key[k_i] >= '0' && key[k_i] <= '9') {
+                                // try to match more digits
+                                match_tasks.emplace_back(k_i + 1u, p_i);
+                            }
+                        } else {
+                            // the key is consumed, so continue matching at the children
+                            find_matches_in_digit_children(n, pattern, p_i, match_state, out);
+                        }
+                    } else {
+                        if (k_i < key.length()) {
+                            // handle '%' in the pattern (not followed by '*')
+                            if (key[k_i] >= '0' && key[k_i] <= '9') {
+                                // continue matching after the digit
+                                match_tasks.emplace_back(k_i + 1u, p_i + 1u);
+                            }
+                        } else {
+                            // the key is consumed, so continue matching at the children
+                            find_matches_in_digit_children(n, pattern, p_i, match_state, out);
+                        }
+                    }
+                } else {
+                    if (k_i < key.length()) {
+                        if (pattern[p_i] == key[k_i]) {
+                            // handle a regular character in the pattern
+                            match_tasks.emplace_back(k_i + 1u, p_i + 1u);
+                        }
+                    } else {
+                        // the key is consumed, so continue matching at the child whose key starts with the character
+                        const auto child = find_child(n, pattern[p_i]);
+                        if (child != no_node) {
+                            find_matches(child, pattern, p_i, n, match_state, out);
+                        }
+                    }
+                }
+            }
         }
 
         /**
-         * Clears this trie.
+         * Continues matching the given pattern at the children of the given node whose keys start with a digit.
          */
-        void clear() {
-            m_root = node("");
+        template <typename O>
+        void find_matches_in_digit_children(const node_index n, const std::string_view pattern, const std::size_t pattern_position, match_state& match_state, O out) const {
+            const auto& node = m_nodes[n];
+            const auto first = std::lower_bound(std::begin(node.child_chars), std::end(node.child_chars), '0');
+            for (auto it = first; it != std::end(node.child_chars) && *it <= '9'; ++it) {
+                const auto child = node.children[static_cast<std::size_t>(std::distance(std::begin(node.child_chars), it))];
+                find_matches(child, pattern, pattern_position, n, match_state, out);
+            }
         }
 
         /**
-         * Finds all values whose keys match the given glob pattern. See `kdl::str_matches_glob` for the definition and
-         * semantics of glob patterns and adds the values to the given output iterator.
+         * Adds the keys of all nodes in the subtree of the given node to the given output iterator.
          *
          * @tparam O the type of the output iterator
-         * @param pattern the pattern to match
+         * @param n the node
+         * @param prefix the prefix of all keys in the subtree
          * @param out the output iterator
          */
         template <typename O>
-        void find_matches(const std::string_view pattern, O out) const {
-            match_state match_state;
-            m_root.find_matches(pattern, { 0u }, nullptr, match_state, out);
+        void get_keys(const node_index n, const std::string& prefix, O out) const {
+            const auto key = prefix + std::string(node_key(n));
+            if (!m_nodes[n].values.empty()) {
+                out++ = key;
+            }
+
+            for (const auto child : m_nodes[n].children) {
+                get_keys(child, key, out);
+            }
         }
 
-        /**
-         * Adds the keys of all nodes in this trie to the give output iterator.
-         *
-         * @tparam O the type of the output iterator
-         * @param out the output iterator
-         */
         template <typename O>
-        void get_keys(O out) const {
-            m_root.get_keys("", out);
+        void get_values(const node_index n, O out) const {
+            for (const auto& [value, count] : m_nodes[n].values) {
+                for (std::size_t i = 0u; i < count; ++i) {
+                    out++ = value;
+                }
+            }
+        }
+
+        template <typename O>
+        void get_values_and_recurse(const node_index n, O out) const {
+            get_values(n, out);
+            for (const auto child : m_nodes[n].children) {
+                get_values_and_recurse(child, out);
+            }
         }
     };
 }
@@ -30,11 +30,12 @@ namespace kdl {
      *
      * @tparam K the key type
      * @tparam V the value type
+     * @tparam C the key comparator type
      * @param m the map
      * @return a vector containing the keys
      */
-    template<typename K, typename V>
-    std::vector<K> map_keys(const std::map<K, V>& m) {
+    template<typename K, typename V, typename C>
+    std::vector<K> map_keys(const std::map<K, V, C>& m) {
         std::vector<K> result;
         result.reserve(m.size());
         for (const auto& e : m) {
@@ -49,11 +50,12 @@ namespace kdl {
      *
      * @tparam K the key type
      * @tparam V the value type
+     * @tparam C the key comparator type
      * @param m the map
      * @return a vector containing the values
      */
-    template<typename K, typename V>
-    std::vector<V> map_values(const std::map<K, V>& m) {
+    template<typename K, typename V, typename C>
+    std::vector<V> map_values(const std::map<K, V, C>& m) {
         std::vector<V> result;
         result.reserve(m.size());
         for (const auto& e : m) {
@@ -0,0 +1,178 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef KDL_PARALLEL_H
+#define KDL_PARALLEL_H
+
+#include "kdl/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kdl {
+    /**
+     * Returns the number of threads to use for parallel algorithms, which is the number of hardware threads, but at
+     * least 1.
+     */
+    inline std::size_t parallel_thread_count() {
+        return std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(1u));
+    }
+
+    /**
+     * Calls the given lambda once for every index in [0, count) using up to the given number of threads. The calling
+     * thread takes part in the work, and the function returns once all indices have been processed.
+     *
+     * Indices are handed out to the threads one at a time, so the work need not be evenly distributed among the indices.
+     * The lambda is called concurrently and must therefore be safe to call from multiple threads. Calls for different
+     * indices must not depend on each other.
+     *
+     * If the lambda throws an exception, no further indices are handed out, and the first exception thrown is rethrown
+     * once all threads have finished.
+     *
+     * If a default thread pool is set, the other threads are taken from that pool instead of being started for this
+     * call. Since the calling thread takes part in the work, this does not deadlock if the pool is busy or if this
+     * function is called from one of the pool's worker threads.
+     *
+     * @tparam L the type of the lambda, must be callable as void(std::size_t)
+     * @param count the number of indices
+     * @param lambda the lambda to call
+     * @param num_threads the maximum number of threads to use
+     */
+    template <typename L>
+    void parallel_for(const std::size_t count, L&& lambda, const std::size_t num_threads = parallel_thread_count()) {
+        const auto thread_count = std::min(count, std::max(num_threads, static_cast<std::size_t>(1u)));
+        if (thread_count <= 1u) {
+            for (std::size_t i = 0u; i < count; ++i) {
+                lambda(i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next_index(0u);
+        std::atomic<bool> failed(false);
+        std::exception_ptr exception;
+        std::mutex exception_mutex;
+
+        const auto work = [&]() {
+            try {
+                for (auto i = next_index++; i < count && !failed; i = next_index++) {
+                    lambda(i);
+                }
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!failed.exchange(true)) {
+                    exception = std::current_exception();
+                }
+            }
+        };
+
+        if (auto* pool = default_thread_pool()) {
+            // Helpers may start late, e.g. if the pool is busy, and possibly after this function has returned. They
+            // only touch the work function if they register before the calling thread closes the shared state.
+            struct helper_state {
+                std::mutex mutex;
+                std::condition_variable condition;
+                std::size_t active = 0u;
+                bool closed = false;
+                const std::function<void()>* work = nullptr;
+            };
+
+            const std::function<void()> pool_work = work;
+            auto state = std::make_shared<helper_state>();
+            state->work = &pool_work;
+
+            const auto helper_count = std::min(thread_count - 1u, pool->thread_count());
+            for (std::size_t i = 0u; i < helper_count; ++i) {
+                pool->submit([state]() {
+                    {
+                        const std::lock_guard<std::mutex> lock(state->mutex);
+                        if (state->closed) {
+                            return;
+                        }
+                        ++state->active;
+                    }
+
+                    (*state->work)();
+
+                    {
+                        const std::lock_guard<std::mutex> lock(state->mutex);
+                        --state->active;
+                    }
+                    state->condition.notify_all();
+                }, task_priority::interactive);
+            }
+
+            work();
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->closed = true;
+            state->condition.wait(lock, [&]() { return state->active == 0u; });
+        } else {
+            std::vector<std::thread> threads;
+            threads.reserve(thread_count - 1u);
+            for (std::size_t i = 0u; i < thread_count - 1u; ++i) {
+                threads.emplace_back(work);
+            }
+
+            work();
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    /**
+     * Applies the given lambda to each element of the given vector using up to the given number of threads, and returns
+     * a vector containing the results in the order of the corresponding input elements.
+     *
+     * The result type must be default constructible. See parallel_for for the requirements on the lambda.
+     *
+     * @tparam T the type of the vector elements
+     * @tparam L the type of the lambda, must be callable as R(const T&)
+     * @param v the vector
+     * @param lambda the lambda to apply
+     * @param num_threads the maximum number of threads to use
+     * @return a vector containing the results
+     */
+    template <typename T, typename L>
+    auto vec_parallel_transform(const std::vector<T>& v, L&& lambda, const std::size_t num_threads = parallel_thread_count()) {
+        using R = std::decay_t<decltype(lambda(std::declval<const T&>()))>;
+
+        auto result = std::vector<R>(v.size());
+        parallel_for(v.size(), [&](const std::size_t i) {
+            result[i] = lambda(v[i]);
+        }, num_threads);
+        return result;
+    }
+}
+
+#endif //KDL_PARALLEL_H
@@ -22,9 +22,11 @@
 
 #include <algorithm> // for std::sort, std::unique, std::lower_bound, std::upper_bound
 #include <cassert>
+#include <cstddef> // for std::size_t
 #include <functional> // for std::less
 #include <iterator> // for std::distance
 #include <memory> // for std::allocator
+#include <type_traits> // for std::is_scalar
 
 // uncomment this to enable checking the invariant in debug builds
 // #define KDL_SET_ADAPTER_DEBUG 1
@@ -37,6 +39,62 @@ namespace kdl {
             std::sort(std::begin(vec), std::end(vec), cmp);
             vec.erase(std::unique(std::begin(vec), std::end(vec), eq), std::end(vec));
         }
+
+        /**
+         * The maximum number of values for which the bounds of a key are found by a linear search instead of a binary
+         * search.
+         */
+        static constexpr std::size_t linear_search_max_size = 32u;
+
+        /**
+         * Determines whether a linear search should be used to find a key in the given sorted range. This is the case
+         * for small ranges of scalar values such as pointers or numbers: comparing these is cheap, and the linear
+         * search visits the values in memory order without any unpredictable branches, so the compiler can vectorize
+         * it. For other value types, comparisons are too expensive to compare every value in the range.
+         */
+        template <typename I>
+        bool use_linear_search(I first, I last) {
+            using value_type = typename std::iterator_traits<I>::value_type;
+            if constexpr (std::is_scalar_v<value_type>) {
+                return static_cast<std::size_t>(std::distance(first, last)) <= linear_search_max_size;
+            } else {
+                return false;
+            }
+        }
+
+        /**
+         * Returns the position of the first value in the given sorted range that is not less than the given key.
+         */
+        template <typename I, typename K, typename Compare>
+        I set_lower_bound(I first, I last, const K& k, const Compare& cmp) {
+            if (use_linear_search(first, last)) {
+                // since the range is sorted, the number of values less than the key is the offset of the lower bound
+                std::size_t offset = 0u;
+                for (auto it = first; it != last; ++it) {
+                    offset += cmp(*it, k) ? 1u : 0u;
+                }
+                return std::next(first, static_cast<typename std::iterator_traits<I>::difference_type>(offset));
+            } else {
+                return std::lower_bound(first, last, k, cmp);
+            }
+        }
+
+        /**
+         * Returns the position of the first value in the given sorted range that is greater than the given key.
+         */
+        template <typename I, typename K, typename Compare>
+        I set_upper_bound(I first, I last, const K& k, const Compare& cmp) {
+            if (use_linear_search(first, last)) {
+                // since the range is sorted, the number of values not greater than the key is the offset of the upper bound
+                std::size_t offset = 0u;
+                for (auto it = first; it != last; ++it) {
+                    offset += cmp(k, *it) ? 0u : 1u;
+                }
+                return std::next(first, static_cast<typename std::iterator_traits<I>::difference_type>(offset));
+            } else {
+                return std::upper_bound(first, last, k, cmp);
+            }
+        }
     }
 
     /**
@@ -234,7 +292,7 @@ namespace kdl {
          */
         template <typename K>
         const_iterator lower_bound(const K& x) const {
-            return std::lower_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
+            return detail::set_lower_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
         }
 
         /**
@@ -247,7 +305,7 @@ namespace kdl {
          */
         template <typename K>
         const_iterator upper_bound(const K& x) const {
-            return std::upper_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
+            return detail::set_upper_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
         }
 
         /**
@@ -814,7 +872,7 @@ namespace kdl {
          */
         template <typename K>
         iterator lower_bound(const K& x) {
-            return std::lower_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
+            return detail::set_lower_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
         }
 
         /**
@@ -827,7 +885,7 @@ namespace kdl {
          */
         template <typename K>
         iterator upper_bound(const K& x) {
-            return std::upper_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
+            return detail::set_upper_bound(std::begin(m_data), std::end(m_data), x, m_cmp);
         }
 
         /**
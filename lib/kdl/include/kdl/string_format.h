@@ -19,6 +19,10 @@
 #define KDL_STRING_FORMAT_H
 
 #include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -325,6 +329,126 @@ namespace kdl {
         }
         return true;
     }
+
+    namespace detail {
+        /**
+         * If the given value is an integer whose magnitude is less than the given limit, appends its decimal
+         * representation to the given string. Negative zero is appended as "-0", like printf does.
+         *
+         * @return true if the value was appended and false otherwise
+         */
+        inline bool str_append_integral(std::string& str, const double value, const double limit) {
+            // this is false for NaN and infinite values
+            if (!(std::abs(value) < limit) || value != std::trunc(value)) {
+                return false;
+            }
+
+            if (value == 0.0 && std::signbit(value)) {
+                str.append("-0");
+            } else {
+                char buffer[24];
+                const auto result = std::to_chars(std::begin(buffer), std::end(buffer), static_cast<long long>(value));
+                str.append(buffer, result.ptr);
+            }
+            return true;
+        }
+
+        /**
+         * Appends the given value to the given string using printf with the given format and precision.
+         */
+        inline void str_append_printf(std::string& str, const char* format, const double value, const int precision) {
+            char buffer[512];
+            const auto length = std::snprintf(buffer, sizeof(buffer), format, precision, value);
+            if (length > 0 && static_cast<std::size_t>(length) < sizeof(buffer)) {
+                str.append(buffer, static_cast<std::size_t>(length));
+            } else if (length > 0) {
+                const auto offset = str.size();
+                str.resize(offset + static_cast<std::size_t>(length) + 1u);
+                std::snprintf(&str[offset], static_cast<std::size_t>(length) + 1u, format, precision, value);
+                str.resize(offset + static_cast<std::size_t>(length));
+            }
+        }
+
+        /**
+         * The largest magnitude for which the conversion of an integral double to long long is exact.
+         */
+        constexpr double max_exact_integral = 9.0e18;
+    }
+
+    /**
+     * Appends the given value to the given string, formatted exactly like printf's "%.*g" with the given precision.
+     *
+     * Integral values that printf would write without an exponent, such as grid aligned coordinates, are converted
+     * using std::to_chars, which is much faster than printf. All other values are passed to printf.
+     *
+     * @param str the string to append to
+     * @param value the value to format
+     * @param precision the maximum number of significant digits
+     */
+    inline void str_append_general(std::string& str, const double value, const int precision) {
+        // printf uses scientific notation if the decimal exponent is not less than the precision
+        static constexpr double limits[] = {
+            1e1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+        };
+        const auto limit = precision >= 0 && precision < static_cast<int>(std::size(limits))
+            ? limits[precision]
+            : detail::max_exact_integral;
+        if (!detail::str_append_integral(str, value, limit)) {
+            detail::str_append_printf(str, "%.*g", value, precision);
+        }
+    }
+
+    /**
+     * Appends the given value to the given string in fixed notation with the given number of decimals, like printf's
+     * "%.*f", but removes any trailing zeros after the decimal point, and the decimal point itself if no decimals
+     * remain.
+     *
+     * Integral values are converted using std::to_chars, which is much faster than printf. All other values are
+     * passed to printf.
+     *
+     * @param str the string to append to
+     * @param value the value to format
+     * @param precision the maximum number of decimals
+     */
+    inline void str_append_fixed(std::string& str, const double value, const int precision) {
+        if (detail::str_append_integral(str, value, detail::max_exact_integral)) {
+            return;
+        }
+
+        const auto offset = str.size();
+        detail::str_append_printf(str, "%.*f", value, precision);
+
+        const auto point = str.find('.', offset);
+        if (point != std::string::npos) {
+            auto end = str.find_last_not_of('0');
+            if (end == point) {
+                --end;
+            }
+            str.erase(end + 1u);
+        }
+    }
+
+    /**
+     * Formats the given value like printf's "%.*g" with the given precision.
+     *
+     * @see str_append_general
+     */
+    inline std::string str_format_general(const double value, const int precision) {
+        std::string result;
+        str_append_general(result, value, precision);
+        return result;
+    }
+
+    /**
+     * Formats the given value in fixed notation with the given maximum number of decimals.
+     *
+     * @see str_append_fixed
+     */
+    inline std::string str_format_fixed(const double value, const int precision) {
+        std::string result;
+        str_append_fixed(result, value, precision);
+        return result;
+    }
 }
 
 #endif //KDL_STRING_FORMAT_H
@@ -23,6 +23,8 @@
 #include <algorithm> // for std::search
 #include <iterator>
 #include <cassert>
+#include <cerrno>
+#include <cstdlib>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -380,6 +382,85 @@ namespace kdl {
             return std::nullopt;
         }
     }
+
+    namespace detail {
+        /**
+         * The maximum length of a character range that is converted to a number using a stack buffer. Longer ranges
+         * are converted by way of a temporary std::string.
+         */
+        constexpr std::size_t MaxStackNumberLength = 64u;
+
+        /**
+         * Copies the given character range into a null terminated stack buffer and passes it to the given conversion
+         * function, which must have the signature of std::strtod. Mirrors the error handling of std::stod and friends:
+         * if no characters could be converted or the value is out of range, an empty optional is returned.
+         */
+        template <typename T, typename F>
+        std::optional<T> range_to_number(const char* begin, const char* end, F convert) {
+            assert(begin <= end);
+
+            char buffer[MaxStackNumberLength];
+            const auto length = static_cast<std::size_t>(end - begin);
+            std::copy(begin, end, buffer);
+            buffer[length] = 0;
+
+            const auto savedErrno = errno;
+            errno = 0;
+
+            char* parsedEnd = nullptr;
+            const auto value = convert(buffer, &parsedEnd);
+
+            const auto outOfRange = errno == ERANGE;
+            errno = savedErrno;
+
+            if (parsedEnd == buffer || outOfRange) {
+                return std::nullopt;
+            }
+            return static_cast<T>(value);
+        }
+    }
+
+    /**
+     * Interprets the characters in the given range as a signed long integer and returns it. If the given range cannot
+     * be parsed, returns an empty optional.
+     *
+     * Unlike str_to_long(const std::string&), this function does not allocate memory unless the given range is very
+     * long.
+     *
+     * @param begin the beginning of the range
+     * @param end the end of the range
+     * @return the signed long integer value or an empty optional if the given range cannot be interpreted as a signed
+     * long integer
+     */
+    inline std::optional<long> str_to_long(const char* begin, const char* end) {
+        if (static_cast<std::size_t>(end - begin) >= detail::MaxStackNumberLength) {
+            return str_to_long(std::string(begin, end));
+        }
+        return detail::range_to_number<long>(begin, end, [](const char* str, char** strEnd) {
+            return std::strtol(str, strEnd, 10);
+        });
+    }
+
+    /**
+     * Interprets the characters in the given range as a 64 bit floating point value and returns it. If the given range
+     * cannot be parsed, returns an empty optional.
+     *
+     * Unlike str_to_double(const std::string&), this function does not allocate memory unless the given range is very
+     * long.
+     *
+     * @param begin the beginning of the range
+     * @param end the end of the range
+     * @return the 64 bit floating point value value or an empty optional if the given range cannot be interpreted as a
+     * 64 bit floating point value
+     */
+    inline std::optional<double> str_to_double(const char* begin, const char* end) {
+        if (static_cast<std::size_t>(end - begin) >= detail::MaxStackNumberLength) {
+            return str_to_double(std::string(begin, end));
+        }
+        return detail::range_to_number<double>(begin, end, [](const char* str, char** strEnd) {
+            return std::strtod(str, strEnd);
+        });
+    }
 }
 
 #endif //KDL_STRING_UTILS_H
@@ -0,0 +1,278 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef KDL_THREAD_POOL_H
+#define KDL_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kdl {
+    /**
+     * The priority of a task submitted to a thread pool. Queued tasks of a higher priority are always started before
+     * queued tasks of a lower priority.
+     */
+    enum class task_priority {
+        /** Work that the user is waiting for. */
+        interactive = 0,
+        /** Work whose result will likely be needed soon. */
+        prefetch = 1,
+        /** Work that can be done whenever there is nothing else to do. */
+        background = 2
+    };
+
+    /**
+     * Thrown by the future of a task that was cancelled before it was started.
+     */
+    class task_cancelled : public std::exception {
+    public:
+        const char* what() const noexcept override {
+            return "task cancelled";
+        }
+    };
+
+    /**
+     * Allows cancelling a number of tasks. Copies of a token share their state, so cancelling any copy cancels all
+     * tasks that were submitted with any of the copies.
+     *
+     * A task that has already started is not interrupted. Long running tasks can check cancelled() periodically and
+     * return early.
+     */
+    class cancellation_token {
+    private:
+        std::shared_ptr<std::atomic<bool>> m_cancelled;
+    public:
+        cancellation_token() :
+        m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+        void cancel() const {
+            *m_cancelled = true;
+        }
+
+        bool cancelled() const {
+            return *m_cancelled;
+        }
+    };
+
+    namespace detail {
+        /**
+         * Wraps the given task so that it throws task_cancelled instead of running if the given token was cancelled.
+         */
+        template <typename F>
+        auto make_cancellable(F task, cancellation_token token) {
+            return [task = std::move(task), token = std::move(token)]() mutable {
+                if (token.cancelled()) {
+                    throw task_cancelled();
+                }
+                return task();
+            };
+        }
+    }
+
+    /**
+     * A fixed number of worker threads that execute submitted tasks in the order of their priority, and in the order of
+     * their submission within the same priority.
+     *
+     * Tasks that are still queued when the pool is destroyed are discarded; their futures report a broken promise.
+     */
+    class thread_pool {
+    private:
+        static constexpr std::size_t priority_count = 3u;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<std::function<void()>> m_queues[priority_count];
+        std::vector<std::thread> m_threads;
+        bool m_stopping;
+    public:
+        /**
+         * Creates a thread pool with the given number of worker threads, but at least one.
+         */
+        explicit thread_pool(const std::size_t thread_count = std::thread::hardware_concurrency()) :
+        m_stopping(false) {
+            const auto count = std::max(thread_count, static_cast<std::size_t>(1u));
+            m_threads.reserve(count);
+            for (std::size_t i = 0u; i < count; ++i) {
+                m_threads.emplace_back([this]() { run(); });
+            }
+        }
+
+        ~thread_pool() {
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+                for (auto& queue : m_queues) {
+                    queue.clear();
+                }
+            }
+            m_condition.notify_all();
+
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        std::size_t thread_count() const {
+            return m_threads.size();
+        }
+
+        /**
+         * Indicates whether the calling thread is one of this pool's worker threads.
+         */
+        bool is_worker_thread() const {
+            const auto id = std::this_thread::get_id();
+            return std::any_of(std::begin(m_threads), std::end(m_threads), [&](const auto& thread) { return thread.get_id() == id; });
+        }
+
+        /**
+         * Queues the given task for execution.
+         *
+         * @tparam F the type of the task, a function from () -> R
+         * @param task the task
+         * @param priority the priority of the task
+         * @return a future that holds the result of the task or the exception it threw
+         */
+        template <typename F>
+        auto submit(F task, const task_priority priority = task_priority::background) {
+            using R = std::invoke_result_t<F>;
+
+            auto packaged = std::make_shared<std::packaged_task<R()>>(std::move(task));
+            auto result = packaged->get_future();
+            enqueue([packaged]() { (*packaged)(); }, priority);
+            return result;
+        }
+
+        /**
+         * Queues the given task for execution. If the given token is cancelled before the task is started, the task is
+         * not run and its future throws task_cancelled.
+         *
+         * @tparam F the type of the task, a function from () -> R
+         * @param task the task
+         * @param token the cancellation token
+         * @param priority the priority of the task
+         * @return a future that holds the result of the task or the exception it threw
+         */
+        template <typename F>
+        auto submit(F task, cancellation_token token, const task_priority priority = task_priority::background) {
+            return submit(detail::make_cancellable(std::move(task), std::move(token)), priority);
+        }
+    private:
+        void enqueue(std::function<void()> task, const task_priority priority) {
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_queues[static_cast<std::size_t>(priority)].push_back(std::move(task));
+            }
+            m_condition.notify_one();
+        }
+
+        void run() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [&]() { return m_stopping || has_queued_task(); });
+                    if (m_stopping) {
+                        return;
+                    }
+
+                    for (auto& queue : m_queues) {
+                        if (!queue.empty()) {
+                            task = std::move(queue.front());
+                            queue.pop_front();
+                            break;
+                        }
+                    }
+                }
+
+                task();
+            }
+        }
+
+        bool has_queued_task() const {
+            return std::any_of(std::begin(m_queues), std::end(m_queues), [](const auto& queue) { return !queue.empty(); });
+        }
+    };
+
+    namespace detail {
+        inline std::atomic<thread_pool*>& default_thread_pool_instance() {
+            static std::atomic<thread_pool*> instance(nullptr);
+            return instance;
+        }
+    }
+
+    /**
+     * Returns the thread pool used by the parallel algorithms, or nullptr if none was set.
+     */
+    inline thread_pool* default_thread_pool() {
+        return detail::default_thread_pool_instance();
+    }
+
+    /**
+     * Sets the thread pool used by the parallel algorithms. The application owns the pool and must reset this to nullptr
+     * before destroying it. If no pool is set, the parallel algorithms start their own threads.
+     */
+    inline void set_default_thread_pool(thread_pool* pool) {
+        detail::default_thread_pool_instance() = pool;
+    }
+
+    /**
+     * Runs the given task asynchronously on the default thread pool with the given priority, or on a new thread if no
+     * default thread pool was set.
+     *
+     * Unlike a future returned by std::async, a future returned by a thread pool does not wait for the task when it is
+     * destroyed, so callers must wait for tasks that access state which may be destroyed.
+     *
+     * @tparam F the type of the task, a function from () -> R
+     * @param task the task
+     * @param priority the priority of the task
+     * @return a future that holds the result of the task or the exception it threw
+     */
+    template <typename F>
+    auto run_async(F task, const task_priority priority = task_priority::background) {
+        if (auto* pool = default_thread_pool()) {
+            return pool->submit(std::move(task), priority);
+        }
+        return std::async(std::launch::async, std::move(task));
+    }
+
+    /**
+     * Runs the given task asynchronously like run_async(F, task_priority). If the given token is cancelled before the
+     * task is started, the task is not run and its future throws task_cancelled.
+     */
+    template <typename F>
+    auto run_async(F task, cancellation_token token, const task_priority priority = task_priority::background) {
+        return run_async(detail::make_cancellable(std::move(task), std::move(token)), priority);
+    }
+}
+
+#endif //KDL_THREAD_POOL_H
@@ -18,9 +18,14 @@
 #include <gtest/gtest.h>
 
 #include "kdl/compact_trie.h"
+#include "kdl/string_compare.h"
 #include "kdl/vector_utils.h"
 
 #include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace kdl {
     using test_index = compact_trie<std::string>;
@@ -197,4 +202,74 @@ namespace kdl {
 
         ASSERT_EQ(expected, actual);
     }
+    TEST(compact_trie_test, insert_and_remove_many) {
+        // insert and remove many keys in random order so that nodes are split, merged and reused, and check the
+        // matches against a plain glob match of all keys
+        using entry = std::pair<std::string, std::string>;
+
+        auto engine = std::mt19937(42u);
+        auto entries = std::vector<entry>();
+        for (std::size_t i = 0u; i < 500u; ++i) {
+            auto key = std::string();
+            const auto length = std::uniform_int_distribution<std::size_t>(1u, 8u)(engine);
+            for (std::size_t j = 0u; j < length; ++j) {
+                key.push_back("ab1_"[std::uniform_int_distribution<std::size_t>(0u, 3u)(engine)]);
+            }
+            entries.emplace_back(std::move(key), std::to_string(i % 7u));
+        }
+
+        const auto assert_matches = [](const std::vector<entry>& inserted, const test_index& index, const std::string& pattern) {
+            auto expected = std::vector<std::string>();
+            for (const auto& [key, value] : inserted) {
+                if (kdl::cs::str_matches_glob(key, pattern)) {
+                    expected.push_back(value);
+                }
+            }
+            ASSERT_MATCHES(expected, index, pattern)
+        };
+
+        const auto patterns = std::vector<std::string>({ "*", "a*", "*1", "?b*", "a%*", "*_%", "ab", "b??" });
+
+        test_index index;
+        auto inserted = std::vector<entry>();
+        for (const auto& e : entries) {
+            index.insert(e.first, e.second);
+            inserted.push_back(e);
+        }
+
+        for (const auto& pattern : patterns) {
+            assert_matches(inserted, index, pattern);
+        }
+
+        std::shuffle(std::begin(entries), std::end(entries), engine);
+        for (std::size_t i = 0u; i < entries.size(); ++i) {
+            const auto& e = entries[i];
+            ASSERT_TRUE(index.remove(e.first, e.second));
+            inserted.erase(std::find(std::begin(inserted), std::end(inserted), e));
+
+            if (i % 50u == 0u) {
+                for (const auto& pattern : patterns) {
+                    assert_matches(inserted, index, pattern);
+                }
+            }
+        }
+
+        ASSERT_MATCHES(std::vector<std::string>({}), index, "*")
+
+        std::vector<std::string> keys;
+        index.get_keys(std::back_inserter(keys));
+        ASSERT_TRUE(keys.empty());
+    }
+
+    TEST(compact_trie_test, clear) {
+        test_index index;
+        index.insert("key", "value");
+        index.insert("key2", "value");
+
+        index.clear();
+        ASSERT_MATCHES(std::vector<std::string>({}), index, "*")
+
+        index.insert("key", "value3");
+        ASSERT_MATCHES(std::vector<std::string>({ "value3" }), index, "k*")
+    }
 }
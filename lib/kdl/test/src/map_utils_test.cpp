@@ -21,6 +21,7 @@
 
 #include "kdl/map_utils.h"
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -52,6 +53,13 @@ namespace kdl {
             { 2, "two" },
             { 3, "three" }
         });
+
+        const auto reversed = std::map<int, std::string, std::greater<int>>{
+            { 1, "one" },
+            { 2, "two" },
+            { 3, "three" }
+        };
+        ASSERT_EQ((std::vector<std::string>{ "three", "two", "one" }), map_values(reversed));
     }
 
     template<typename K, typename V>
@@ -0,0 +1,87 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kdl/parallel.h"
+#include "kdl/thread_pool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace kdl {
+    TEST(parallel_test, parallel_for) {
+        for (const std::size_t num_threads : { 1u, 2u, 8u }) {
+            std::vector<std::atomic<int>> counts(1000u);
+            parallel_for(counts.size(), [&](const std::size_t i) { ++counts[i]; }, num_threads);
+
+            for (const auto& count : counts) {
+                ASSERT_EQ(1, count);
+            }
+        }
+    }
+
+    TEST(parallel_test, parallel_for_empty) {
+        std::atomic<int> calls(0);
+        parallel_for(0u, [&](const std::size_t) { ++calls; }, 4u);
+        ASSERT_EQ(0, calls);
+    }
+
+    TEST(parallel_test, parallel_for_rethrows) {
+        ASSERT_THROW(parallel_for(100u, [](const std::size_t i) {
+            if (i == 50u) {
+                throw std::runtime_error("test");
+            }
+        }, 4u), std::runtime_error);
+    }
+
+    TEST(parallel_test, parallel_for_with_default_thread_pool) {
+        thread_pool pool(2u);
+        set_default_thread_pool(&pool);
+
+        std::vector<std::atomic<int>> counts(1000u);
+        parallel_for(counts.size(), [&](const std::size_t i) {
+            // nested calls run on the pool's worker threads, too
+            std::atomic<int> nested(0);
+            parallel_for(4u, [&](const std::size_t) { ++nested; }, 4u);
+            counts[i] += nested;
+        }, 4u);
+
+        set_default_thread_pool(nullptr);
+
+        for (const auto& count : counts) {
+            ASSERT_EQ(4, count);
+        }
+    }
+
+    TEST(parallel_test, vec_parallel_transform) {
+        std::vector<int> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+
+        const auto result = vec_parallel_transform(v, [](const int i) { return 2 * i; }, 4u);
+        ASSERT_EQ(v.size(), result.size());
+        for (std::size_t i = 0u; i < v.size(); ++i) {
+            ASSERT_EQ(2 * v[i], result[i]);
+        }
+
+        ASSERT_TRUE(vec_parallel_transform(std::vector<int>{}, [](const int i) { return i; }).empty());
+    }
+}
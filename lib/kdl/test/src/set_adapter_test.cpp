@@ -19,6 +19,9 @@
 
 #include "kdl/set_adapter.h"
 
+#include <algorithm>
+#include <functional>
+#include <string>
 #include <vector>
 
 namespace kdl {
@@ -143,6 +146,45 @@ namespace kdl {
         ASSERT_EQ(std::next(std::begin(s2), 3), s2.upper_bound(4));
     }
 
+    template <typename T, typename Compare = std::less<T>>
+    static void assert_bounds(const std::vector<T>& v, const std::vector<T>& keys, const Compare& cmp = Compare()) {
+        const auto s = wrap_set(v, cmp);
+        for (const auto& key : keys) {
+            ASSERT_EQ(std::lower_bound(std::begin(v), std::end(v), key, cmp), s.lower_bound(key));
+            ASSERT_EQ(std::upper_bound(std::begin(v), std::end(v), key, cmp), s.upper_bound(key));
+        }
+    }
+
+    TEST(const_set_adapter_test, bounds_for_all_sizes) {
+        // cover sets which are searched linearly as well as sets which are searched with a binary search
+        for (int size = 0; size <= 100; ++size) {
+            auto v = std::vector<int>();
+            auto keys = std::vector<int>({ -1 });
+            for (int i = 0; i < size; ++i) {
+                v.push_back(2 * i);
+                keys.push_back(2 * i);
+                keys.push_back(2 * i + 1);
+            }
+            assert_bounds(v, keys);
+            assert_bounds(std::vector<int>(v.rbegin(), v.rend()), keys, std::greater<int>());
+        }
+    }
+
+    TEST(const_set_adapter_test, bounds_for_pointers) {
+        int values[40];
+        auto v = std::vector<const int*>();
+        for (const auto& value : values) {
+            v.push_back(&value);
+        }
+
+        assert_bounds(std::vector<const int*>(std::begin(v), std::next(std::begin(v), 8)), v);
+        assert_bounds(v, v);
+    }
+
+    TEST(const_set_adapter_test, bounds_for_strings) {
+        assert_bounds(std::vector<std::string>({ "a", "c", "e" }), std::vector<std::string>({ "", "a", "b", "c", "d", "e", "f" }));
+    }
+
     TEST(const_set_adapter_test, capacity) {
         const auto v1 = std::vector<int>();
         const auto s1 = wrap_set(v1);
@@ -19,6 +19,11 @@
 
 #include <kdl/string_format.h>
 
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
 namespace kdl {
     TEST(string_format_test, str_select) {
         ASSERT_EQ("yes", str_select(true, "yes", "no"));
@@ -132,4 +137,62 @@ namespace kdl {
         ASSERT_TRUE(str_is_numeric("1"));
         ASSERT_TRUE(str_is_numeric("1234567890"));
     }
+
+    static std::string printf_format(const char* format, const double value, const int precision) {
+        char buffer[512];
+        std::snprintf(buffer, sizeof(buffer), format, precision, value);
+        return buffer;
+    }
+
+    static std::string printf_fixed(const double value, const int precision) {
+        auto str = printf_format("%.*f", value, precision);
+        if (str.find('.') != std::string::npos) {
+            auto end = str.find_last_not_of('0');
+            if (str[end] == '.') {
+                --end;
+            }
+            str.erase(end + 1u);
+        }
+        return str;
+    }
+
+    static std::vector<double> format_test_values() {
+        return {
+            0.0, -0.0, 1.0, -1.0, 16.0, -64.0, 0.5, -0.25, 0.1, 1.0 / 3.0, 123456.0, 999999.0, 1000000.0, 1234567.0,
+            -1234567.0, 123456.5, 1e16, 1e17, 99999999999999999.0, 1e18, 1e19, 1e300, 1e-300, 3.0e-7,
+            std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+            std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+            static_cast<double>(0.1f), static_cast<double>(-8192.125f)
+        };
+    }
+
+    TEST(string_format_test, str_format_general) {
+        for (const auto precision : { 0, 1, 6, 17, 20 }) {
+            for (const auto value : format_test_values()) {
+                ASSERT_EQ(printf_format("%.*g", value, precision), str_format_general(value, precision)) << value << " " << precision;
+            }
+        }
+        ASSERT_EQ(printf_format("%.*g", std::numeric_limits<double>::quiet_NaN(), 17), str_format_general(std::numeric_limits<double>::quiet_NaN(), 17));
+    }
+
+    TEST(string_format_test, str_format_fixed) {
+        for (const auto precision : { 0, 1, 6, 17 }) {
+            for (const auto value : format_test_values()) {
+                ASSERT_EQ(printf_fixed(value, precision), str_format_fixed(value, precision)) << value << " " << precision;
+            }
+        }
+
+        ASSERT_EQ("64", str_format_fixed(64.0, 17));
+        ASSERT_EQ("-0.5", str_format_fixed(-0.5, 17));
+        ASSERT_EQ("100", str_format_fixed(100.25, 0));
+        ASSERT_EQ("0.10000000000000001", str_format_fixed(0.1, 17));
+    }
+
+    TEST(string_format_test, str_append_general) {
+        std::string str = "( ";
+        str_append_general(str, 64.0, 17);
+        str.append(" ");
+        str_append_general(str, -0.5, 17);
+        ASSERT_EQ("( 64 -0.5", str);
+    }
 }
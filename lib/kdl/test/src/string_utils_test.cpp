@@ -105,6 +105,27 @@ namespace kdl {
         ASSERT_EQ(std::nullopt, str_to_long(""));
     }
 
+    TEST(string_format_test, str_to_long_range) {
+        const auto str_to_long_range = [](const std::string& str) {
+            return str_to_long(str.data(), str.data() + str.size());
+        };
+
+        ASSERT_EQ(std::optional<long>{0l}, str_to_long_range("0"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("123231"));
+        ASSERT_EQ(std::optional<long>{-123231l}, str_to_long_range("-123231"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("+123231"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("123231b"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("   123231   "));
+        ASSERT_EQ(std::optional<long>{123l}, str_to_long_range(std::string(100u, ' ') + "123"));
+        ASSERT_EQ(std::nullopt, str_to_long_range("a123231"));
+        ASSERT_EQ(std::nullopt, str_to_long_range("99999999999999999999999"));
+        ASSERT_EQ(std::nullopt, str_to_long_range(" "));
+        ASSERT_EQ(std::nullopt, str_to_long_range(""));
+
+        const std::string str = "12345";
+        ASSERT_EQ(std::optional<long>{123l}, str_to_long(str.data(), str.data() + 3));
+    }
+
     TEST(string_format_test, str_to_long_long) {
         ASSERT_EQ(std::optional<long long>{0ll}, str_to_long_long("0"));
         ASSERT_EQ(std::optional<long long>{1ll}, str_to_long_long("1"));
@@ -175,6 +196,25 @@ namespace kdl {
         ASSERT_EQ(std::nullopt, str_to_double(""));
     }
 
+    TEST(string_format_test, str_to_double_range) {
+        const auto str_to_double_range = [](const std::string& str) {
+            return str_to_double(str.data(), str.data() + str.size());
+        };
+
+        ASSERT_EQ(std::optional<double>{0.0}, str_to_double_range("0"));
+        ASSERT_EQ(std::optional<double>{1.0}, str_to_double_range("1.0"));
+        ASSERT_EQ(std::optional<double>{-0.5}, str_to_double_range("-.5"));
+        ASSERT_EQ(std::optional<double>{1.0e5}, str_to_double_range("1e5"));
+        ASSERT_EQ(std::optional<double>{2.0}, str_to_double_range(std::string(100u, ' ') + "2.0"));
+        ASSERT_EQ(std::nullopt, str_to_double_range("a123231.0"));
+        ASSERT_EQ(std::nullopt, str_to_double_range("1e999"));
+        ASSERT_EQ(std::nullopt, str_to_double_range(" "));
+        ASSERT_EQ(std::nullopt, str_to_double_range(""));
+
+        const std::string str = "1.2345";
+        ASSERT_EQ(std::optional<double>{1.2}, str_to_double(str.data(), str.data() + 3));
+    }
+
     TEST(string_format_test, str_to_long_double) {
         ASSERT_EQ(std::optional<long double>{0.0L}, str_to_long_double("0"));
         ASSERT_EQ(std::optional<long double>{1.0L}, str_to_long_double("1.0"));
@@ -0,0 +1,114 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kdl/thread_pool.h"
+
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace kdl {
+    TEST(thread_pool_test, submit) {
+        thread_pool pool(2u);
+        ASSERT_EQ(2u, pool.thread_count());
+
+        auto result = pool.submit([]() { return 42; });
+        ASSERT_EQ(42, result.get());
+    }
+
+    TEST(thread_pool_test, submit_rethrows) {
+        thread_pool pool(1u);
+
+        auto result = pool.submit([]() -> int { throw std::runtime_error("test"); });
+        ASSERT_THROW(result.get(), std::runtime_error);
+    }
+
+    TEST(thread_pool_test, priorities) {
+        thread_pool pool(1u);
+
+        // block the only worker until all tasks are queued
+        std::promise<void> release;
+        auto blocker = pool.submit([gate = release.get_future().share()]() { gate.wait(); });
+
+        std::mutex mutex;
+        std::vector<int> order;
+        const auto record = [&](const int i) {
+            return [&, i]() {
+                const std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+            };
+        };
+
+        auto background = pool.submit(record(3), task_priority::background);
+        auto prefetch = pool.submit(record(2), task_priority::prefetch);
+        auto interactive = pool.submit(record(1), task_priority::interactive);
+
+        release.set_value();
+        background.get();
+        prefetch.get();
+        interactive.get();
+
+        ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), order);
+    }
+
+    TEST(thread_pool_test, cancel) {
+        thread_pool pool(1u);
+
+        std::promise<void> release;
+        auto blocker = pool.submit([gate = release.get_future().share()]() { gate.wait(); });
+
+        cancellation_token token;
+        auto cancelled = pool.submit([]() { return 1; }, token);
+        auto notCancelled = pool.submit([]() { return 2; }, cancellation_token());
+        token.cancel();
+
+        release.set_value();
+        ASSERT_THROW(cancelled.get(), task_cancelled);
+        ASSERT_EQ(2, notCancelled.get());
+    }
+
+    TEST(thread_pool_test, is_worker_thread) {
+        thread_pool pool(1u);
+        ASSERT_FALSE(pool.is_worker_thread());
+        ASSERT_TRUE(pool.submit([&]() { return pool.is_worker_thread(); }).get());
+    }
+    TEST(thread_pool_test, run_async) {
+        ASSERT_EQ(nullptr, default_thread_pool());
+        ASSERT_EQ(1, run_async([]() { return 1; }).get());
+
+        thread_pool pool(1u);
+        set_default_thread_pool(&pool);
+        ASSERT_TRUE(run_async([&]() { return pool.is_worker_thread(); }, task_priority::interactive).get());
+        set_default_thread_pool(nullptr);
+    }
+
+    TEST(thread_pool_test, run_async_cancel) {
+        cancellation_token token;
+        token.cancel();
+        ASSERT_THROW(run_async([]() { return 1; }, token).get(), task_cancelled);
+
+        thread_pool pool(1u);
+        set_default_thread_pool(&pool);
+        ASSERT_THROW(run_async([]() { return 1; }, token).get(), task_cancelled);
+        ASSERT_EQ(2, run_async([]() { return 2; }, cancellation_token()).get());
+        set_default_thread_pool(nullptr);
+    }
+}